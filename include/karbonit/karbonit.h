@@ -0,0 +1,13772 @@
+/*
+ * archive - Carbon archive implementation
+ *
+ * Copyright 2018 Marcus Pinnecke
+ */
+
+#ifndef HAD_ARCHIVE_H
+#define HAD_ARCHIVE_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/forwdecl.h>
+#include <karbonit/stdinc.h>
+#include <karbonit/mem/memblock.h>
+#include <karbonit/mem/memfile.h>
+#include <karbonit/archive/pack.h>
+#include <karbonit/archive/column_doc.h>
+#include <karbonit/archive/io.h>
+#include <karbonit/archive/internal.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct archive {
+        archive_info info;
+        char *disk_file_path;
+        string_table string_table;
+        record_table record_table;
+        struct sid_to_offset *query_index_string_id_to_offset;
+        struct string_cache *string_id_cache;
+        query *default_query;
+} archive;
+
+typedef struct archive_callback {
+        void (*begin_create_from_model)();
+        void (*end_create_from_model)();
+        void (*begin_create_from_json)();
+        void (*end_create_from_json)();
+        void (*begin_archive_stream_from_json)();
+        void (*end_archive_stream_from_json)();
+        void (*begin_write_archive_file_to_disk)();
+        void (*end_write_archive_file_to_disk)();
+        void (*begin_load_archive)();
+        void (*end_load_archive)();
+        void (*begin_setup_string_dict_ionary)();
+        void (*end_setup_string_dict_ionary)();
+        void (*begin_parse_json)();
+        void (*end_parse_json)();
+        void (*begin_test_json)();
+        void (*end_test_json)();
+        void (*begin_import_json)();
+        void (*end_import_json)();
+        void (*begin_cleanup)();
+        void (*end_cleanup)();
+        void (*begin_write_string_table)();
+        void (*end_write_string_table)();
+        void (*begin_write_record_table)();
+        void (*end_write_record_table)();
+        void (*skip_string_id_index_baking)();
+        void (*begin_string_id_index_baking)();
+        void (*end_string_id_index_baking)();
+} archive_callback;
+
+bool archive_from_json(archive *out, const char *file, const char *json_string, packer_e compressor, str_dict_tag_e dictionary, size_t num_async_dic_threads, bool read_optimized, bool bake_string_id_index, archive_callback *callback);
+bool archive_stream_from_json(memblock **stream, const char *json_string, packer_e compressor, str_dict_tag_e dictionary, size_t num_async_dic_threads, bool read_optimized, bool bake_id_index, archive_callback *callback);
+bool archive_from_model(memblock **stream, column_doc *model, packer_e compressor, bool bake_string_id_index, archive_callback *callback);
+bool archive_write(FILE *file, const memblock *stream);
+bool archive_load(memblock **stream, FILE *file);
+bool archive_print(FILE *file, memblock *stream);
+bool archive_open(archive *out, const char *file_path);
+bool archive_get_info(archive_info *info, const archive *archive);
+bool archive_close(archive *archive);
+bool archive_drop_indexes(archive *archive);
+bool archive_query_run(query *query, archive *archive);
+bool archive_has_query_index_string_id_to_offset(bool *state, archive *archive);
+bool archive_hash_query_string_id_cache(bool *has_cache, archive *archive);
+bool archive_drop_query_string_id_cache(archive *archive);
+struct string_cache *archive_get_query_string_id_cache(archive *archive);
+query *archive_query_default(archive *archive);
+
+/**
+ * Creates a new <code>archive_io_context</code> to access the archives underlying file for unsafe operations.
+ *
+ * An unsafe operation directly seeks randomly in the underlying file. To avoid creation of multiple file
+ * descriptors while at the same time allow to access unsafe operations in a multi-threading environment, an
+ * <code>archive_io_context</code> is used. Roughly, such a context is a regular FILE that is protected by a lock.
+ *
+ * @param archive The archive
+ * @return a heap-allocated instance of <code>archive_io_context</code>, or NULL if not successful
+ */
+archive_io_context *archive_io_context_create(archive *archive);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif/**
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef CACHE_H
+#define CACHE_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/types.h>
+#include <karbonit/archive/query.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct sid_cache_stats {
+        size_t num_hits;
+        size_t num_misses;
+        size_t num_evicted;
+} sid_cache_stats;
+
+bool string_id_cache_create_lru(struct string_cache **cache, archive *archive);
+bool string_id_cache_create_lru_ex(struct string_cache **cache, archive *archive, size_t capacity);
+bool string_id_cache_get_size(size_t *size, const struct string_cache *cache);
+char *string_id_cache_get(struct string_cache *cache, archive_field_sid_t id);
+bool string_id_cache_get_statistics(sid_cache_stats *statistics, struct string_cache *cache);
+bool string_id_cache_reset_statistics(struct string_cache *cache);
+bool string_id_cache_drop(struct string_cache *cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef COLUMNDOC_H
+#define COLUMNDOC_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/std/vec.h>
+#include <karbonit/std/bloom.h>
+#include <karbonit/std/string_dict.h>
+#include <karbonit/archive/doc.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Transformation of an JSON-like array of objects to a columnar representation of key values.
+ *
+ * The assumption is that an array of objects is LIKELY to have elements of the same (well yet unknown) schema. The
+ * following structure captures a particular key (with its data type) found in one or more elements inside this array,
+ * and stores the value assigned to this key along with with the object position in the array in which this mapping
+ * occurs. Note that a keys name might have different data types inside objects embedded in arrays, and a key is not
+ * guaranteed to occur in all objects embedded in the array.
+ */
+typedef struct column_doc_column {
+        /** Key name */
+        archive_field_sid_t key_name;
+        /** Particular key type */
+        archive_field_e type;
+        /** Positions of objects in the parent array that has this particular key name with this particular value type */
+        vec ofType(u32) array_positions;
+        /** Values stored in objects assigned to this key-type mapping. The i-th element in `values` (which hold the
+         * i-th value) is associated to the i-th element in `arrayPosition` which holds the position of the object inside
+         * the array from which this pair was taken. */
+        vec ofType(Vector ofType( < T >)) values;
+} column_doc_column;
+
+typedef struct column_doc_group {
+        /** Key name */
+        archive_field_sid_t key;
+        /** Key columns as a decomposition of objects stored in that JSON-like array */
+        vec ofType(column_doc_column) columns;
+} column_doc_group;
+
+typedef struct column_doc_obj {
+        /** Parent document meta doc */
+        column_doc *parent;
+        /** Key in parent document meta doc that maps to this one, or "/" if this is the top-level meta doc */
+        archive_field_sid_t parent_key;
+        /** Index inside the array of this doc in its parents property, or 0 if this is not an array type or top-level */
+        size_t index;
+
+        /** Inverted index of keys mapping to primitive boolean types (sorted by key) */
+        vec ofType(archive_field_sid_t) bool_prop_keys;
+        /** Inverted index of keys mapping to primitive int8 number types (sorted by key) */
+        vec ofType(archive_field_sid_t) int8_prop_keys;
+        /** Inverted index of keys mapping to primitive int16 number types (sorted by key) */
+        vec ofType(archive_field_sid_t) int16_prop_keys;
+        /** Inverted index of keys mapping to primitive int32 number types (sorted by key) */
+        vec ofType(archive_field_sid_t) int32_prop_keys;
+        /** Inverted index of keys mapping to primitive int64 number types (sorted by key) */
+        vec ofType(archive_field_sid_t) int64_prop_keys;
+        /** Inverted index of keys mapping to primitive uint8 number types (sorted by key) */
+        vec ofType(archive_field_sid_t) uint8_prop_keys;
+        /** Inverted index of keys mapping to primitive uint16 number types (sorted by key) */
+        vec ofType(archive_field_sid_t) uint16_prop_keys;
+        /** Inverted index of keys mapping to primitive uint32 number types (sorted by key) */
+        vec ofType(archive_field_sid_t) uin32_prop_keys;
+        /** Inverted index of keys mapping to primitive uint64 number types (sorted by key) */
+        vec ofType(archive_field_sid_t) uint64_prop_keys;
+        /** Inverted index of keys mapping to primitive string types (sorted by key) */
+        vec ofType(archive_field_sid_t) string_prop_keys;
+        /** Inverted index of keys mapping to primitive real types (sorted by key) */
+        vec ofType(archive_field_sid_t) float_prop_keys;
+        /** Inverted index of keys mapping to primitive null values (sorted by key) */
+        vec ofType(archive_field_sid_t) null_prop_keys;
+        /** Inverted index of keys mapping to exactly one nested object value (sorted by key) */
+        vec ofType(archive_field_sid_t) obj_prop_keys;
+
+        /** Inverted index of keys mapping to array of boolean types (sorted by key)*/
+        vec ofType(archive_field_sid_t) bool_array_prop_keys;
+        /** Inverted index of keys mapping to array of int8 number types (sorted by key)*/
+        vec ofType(archive_field_sid_t) int8_array_prop_keys;
+        /** Inverted index of keys mapping to array of int16 number types (sorted by key) */
+        vec ofType(archive_field_sid_t) int16_array_prop_keys;
+        /** Inverted index of keys mapping to array of int32 number types (sorted by key) */
+        vec ofType(archive_field_sid_t) int32_array_prop_keys;
+        /** Inverted index of keys mapping to array of int64 number types (sorted by key) */
+        vec ofType(archive_field_sid_t) int64_array_prop_keys;
+        /** Inverted index of keys mapping to array of uint8 number types (sorted by key) */
+        vec ofType(archive_field_sid_t) uint8_array_prop_keys;
+        /** Inverted index of keys mapping to array of uint16 number types (sorted by key) */
+        vec ofType(archive_field_sid_t) uint16_array_prop_keys;
+        /** Inverted index of keys mapping to array of uint32 number types (sorted by key) */
+        vec ofType(archive_field_sid_t) uint32_array_prop_keys;
+        /** Inverted index of keys mapping to array of uint64 number types (sorted by key) */
+        vec ofType(archive_field_sid_t) uint64_array_prop_keys;
+        /** Inverted index of keys mapping array of string types (sorted by key) */
+        vec ofType(archive_field_sid_t) string_array_prop_keys;
+        /** Inverted index of keys mapping array of real types (sorted by key) */
+        vec ofType(archive_field_sid_t) float_array_prop_keys;
+        /** Inverted index of keys mapping array of null value (sorted by key)s */
+        vec ofType(archive_field_sid_t) null_array_prop_keys;
+
+        /** Primitive boolean values associated to keys stored above (sorted by key) */
+        vec ofType(FIELD_BOOLEANean_t) bool_prop_vals;
+        /** Primitive int8 number values associated to keys stored above (sorted by key) */
+        vec ofType(archive_field_i8_t) int8_prop_vals;
+        /** Primitive int16 number values associated to keys stored above (sorted by key) */
+        vec ofType(archive_field_i16_t) int16_prop_vals;
+        /** Primitive int32 number values associated to keys stored above (sorted by key) */
+        vec ofType(archive_field_i32_t) int32_prop_vals;
+        /** Primitive int64 number values associated to keys stored above (sorted by key) */
+        vec ofType(archive_field_i64_t) int64_prop_vals;
+        /** Primitive uint8 number values associated to keys stored above (sorted by key) */
+        vec ofType(archive_field_u8_t) uint8_prop_vals;
+        /** Primitive uint16 number values associated to keys stored above (sorted by key) */
+        vec ofType(archive_field_u16_t) uint16_prop_vals;
+        /** Primitive uint32 number values associated to keys stored above (sorted by key) */
+        vec ofType(archive_field_u32_t) uint32_prop_vals;
+        /** Primitive uint64 number values associated to keys stored above (sorted by key) */
+        vec ofType(archive_field_u64_t) uint64_prop_vals;
+        /** Primitive real number values associated to keys stored above (sorted by key) */
+        vec ofType(archive_field_number_t) float_prop_vals;
+        /** Primitive string number values associated to keys stored above (sorted by key) */
+        vec ofType(archive_field_sid_t) string_prop_vals;
+
+        /** Array of boolean values associated to keys stored above (sorted by key) */
+        vec ofType(Vector) bool_array_prop_vals;
+        /** Array of int8 number values associated to keys stored above (sorted by key) */
+        vec ofType(Vector) int8_array_prop_vals;
+        /** Array of int16 number values associated to keys stored above (sorted by key) */
+        vec ofType(Vector) int16_array_prop_vals;
+        /** Array of int32 number values associated to keys stored above (sorted by key) */
+        vec ofType(Vector) int32_array_prop_vals;
+        /** Array of int64 number values associated to keys stored above (sorted by key) */
+        vec ofType(Vector) int64_array_prop_vals;
+        /** Array of uint8 number values associated to keys stored above (sorted by key) */
+        vec ofType(Vector) uint8_array_prop_vals;
+        /** Array of uint16 number values associated to keys stored above (sorted by key) */
+        vec ofType(Vector) uint16_array_prop_vals;
+        /** Array of uint32 number values associated to keys stored above (sorted by key) */
+        vec ofType(Vector) uint32_array_prop_vals;
+        /** Array of uint64 number values associated to keys stored above (sorted by key) */
+        vec ofType(Vector) ui64_array_prop_vals;
+        /** Array of real number values associated to keys stored above (sorted by key) */
+        vec ofType(Vector) float_array_prop_vals;
+        /** Array of string number values associated to keys stored above (sorted by key) */
+        vec ofType(Vector) string_array_prop_vals;
+        /** Array of null values associated to keys stored above (sorted by key). The number represents the
+         * multiplicity of nulls for the associated key. */
+        vec ofType(u16) null_array_prop_vals;
+        /** Primitive objects associated to keys stored above (sorted by key) */
+        vec ofType(column_doc_obj) obj_prop_vals;
+
+        /** Index of primitive boolean values associated to keys stored above (sorted by value) */
+        vec ofType(u32) bool_val_idxs;
+        /** Index of primitive int8 number values associated to keys stored above (sorted by value) */
+        vec ofType(u32) int8_val_idxs;
+        /** Index of primitive int16 number values associated to keys stored above (sorted by value) */
+        vec ofType(u32) int16_val_idxs;
+        /** Index of primitive int32 number values associated to keys stored above (sorted by value) */
+        vec ofType(u32) int32_val_idxs;
+        /** Index of primitive int64 number values associated to keys stored above (sorted by value) */
+        vec ofType(u32) int64_val_idxs;
+        /** Index of primitive uint8 number values associated to keys stored above (sorted by value) */
+        vec ofType(u32) uint8_val_idxs;
+        /** Index of primitive uint16 number values associated to keys stored above (sorted by value) */
+        vec ofType(u32) uint16_val_idxs;
+        /** Index of primitive uint32 number values associated to keys stored above (sorted by value) */
+        vec ofType(u32) uint32_val_idxs;
+        /** Index of primitive uint64 number values associated to keys stored above (sorted by value) */
+        vec ofType(u32) uint64_val_idxs;
+        /** Index of primitive real number values associated to keys stored above (sorted by value) */
+        vec ofType(u32) float_val_idxs;
+        /** Index of primitive string number values associated to keys stored above (sorted by value) */
+        vec ofType(u32) string_val_idxs;
+
+        /** Index of array of boolean values associated to keys stored above (sorted by value) */
+        vec ofType(Vector) bool_array_idxs;
+        /** Index of array of int8 number values associated to keys stored above (sorted by value) */
+        vec ofType(Vector) int8_array_idxs;
+        /** Index of array of int16 number values associated to keys stored above (sorted by value) */
+        vec ofType(Vector) int16_array_idxs;
+        /** Index of array of int32 number values associated to keys stored above (sorted by value) */
+        vec ofType(Vector) int32_array_idxs;
+        /** Index of array of int64 number values associated to keys stored above (sorted by value) */
+        vec ofType(Vector) int64_array_idxs;
+        /** Index of array of uint8 number values associated to keys stored above (sorted by value) */
+        vec ofType(Vector) uint8_array_idxs;
+        /** Index of array of uint16 number values associated to keys stored above (sorted by value) */
+        vec ofType(Vector) uint16_array_idxs;
+        /** Index of array of uint32 number values associated to keys stored above (sorted by value) */
+        vec ofType(Vector) uint32_array_idxs;
+        /** Index of array of uint64 number values associated to keys stored above (sorted by value) */
+        vec ofType(Vector) uint64_array_idxs;
+        /** Index of array of real number values associated to keys stored above (sorted by value) */
+        vec ofType(Vector) float_array_idxs;
+        /** Index of array of string number values associated to keys stored above (sorted by value) */
+        vec ofType(Vector) string_array_idxs;
+
+        /** Array of objects associated to keys stored above (sorted by key) */
+        vec ofType(column_doc_group) obj_array_props;
+} column_doc_obj;
+
+typedef struct column_doc {
+        const doc *doc;
+        string_dict *dic;
+        column_doc_obj columndoc;
+        const doc_bulk *bulk;
+        bool read_optimized;
+} column_doc;
+
+bool columndoc_create(column_doc *columndoc, const doc *doc,  const doc_bulk *bulk, const doc_entries *entries, string_dict *dic);
+bool columndoc_drop(column_doc *doc);
+
+bool columndoc_free(column_doc *doc);
+
+bool columndoc_print(FILE *file, column_doc *doc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif/**
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ARCHIVE_DOC_CONVERTER_H
+#define ARCHIVE_DOC_CONVERTER_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/archive/encoded_doc.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool archive_converter(encoded_doc_list *collection, archive *archive);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef DOC_H
+#define DOC_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/std/vec.h>
+#include <karbonit/std/string_dict.h>
+#include <karbonit/json/json-parser.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct doc_entries {
+        doc_obj *context;
+        const char *key;
+        archive_field_e type;
+        vec ofType(<T>) values;
+} doc_entries;
+
+typedef struct doc_bulk {
+        string_dict *dic;
+        vec ofType(char *) keys, values;
+        vec ofType(doc) models;
+} doc_bulk;
+
+typedef struct doc {
+        doc_bulk *context;
+        vec ofType(doc_obj) obj_model;
+        archive_field_e type;
+} doc;
+
+typedef struct doc_obj {
+        vec ofType(doc_entries) entries;
+        doc *doc;
+} doc_obj;
+
+bool doc_bulk_create(doc_bulk *bulk, string_dict *dic);
+bool doc_bulk_drop(doc_bulk *bulk);
+
+bool doc_bulk_shrink(doc_bulk *bulk);
+bool doc_bulk_print(FILE *file, doc_bulk *bulk);
+
+doc *doc_bulk_new_doc(doc_bulk *context, archive_field_e type);
+doc_obj *doc_bulk_new_obj(doc *model);
+bool doc_bulk_get_dic_contents(vec ofType (const char *) **strings, vec ofType(archive_field_sid_t) **string_ids, const doc_bulk *context);
+
+bool doc_print(FILE *file, const doc *doc);
+const vec ofType(doc_entries) *doc_get_entries(const doc_obj *model);
+void doc_print_entries(FILE *file, const doc_entries *entries);
+void doc_drop(doc_obj *model);
+
+bool doc_obj_add_key(doc_entries **out, doc_obj *obj, const char *key, archive_field_e type);
+bool doc_obj_push_primtive(doc_entries *entry, const void *value);
+bool doc_obj_push_object(doc_obj **out, doc_entries *entry);
+
+doc_entries *doc_bulk_new_entries(doc_bulk *dst);
+doc_obj *doc_bulk_add_json(doc_entries *partition, json *json);
+doc_obj *doc_entries_get_root(const doc_entries *partition);
+column_doc *doc_entries_columndoc(const doc_bulk *bulk, const doc_entries *partition, bool read_optimized);
+bool doc_entries_drop(doc_entries *partition);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef STRDIC_ASYNC_H
+#define STRDIC_ASYNC_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/std/string_dict.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int encode_async_create(string_dict *dic, size_t capacity, size_t num_index_buckets, size_t approx_num_unique_strs, size_t num_threads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef STRDIC_SYNC_H
+#define STRDIC_SYNC_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/std/string_dict.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int encode_sync_create(string_dict *dic, size_t capacity, size_t num_indx_buckets, size_t num_index_bucket_cap, size_t num_threads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif/**
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ENCODED_DOC_H
+#define ENCODED_DOC_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/std/hash/table.h>
+#include <karbonit/stdx/unique_id.h>
+#include <karbonit/types.h>
+#include <karbonit/archive.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef union encoded_doc_value {
+        archive_field_i8_t int8;
+        archive_field_i16_t int16;
+        archive_field_i32_t int32;
+        archive_field_i64_t int64;
+        archive_field_u8_t uint8;
+        archive_field_u16_t uint16;
+        archive_field_u32_t uint32;
+        archive_field_u64_t uint64;
+        archive_field_number_t number;
+        archive_field_boolean_t boolean;
+        archive_field_sid_t string;
+        unique_id_t object;
+        u32 null;
+} encoded_doc_value_u;
+
+typedef enum encoded_doc_string {
+        STRING_ENCODED, STRING_DECODED,
+} encoded_doc_string_e;
+
+typedef enum encoded_doc_value_e {
+        VALUE_BUILTIN, VALUE_DECODED_STRING,
+} encoded_doc_value_e;
+
+typedef struct encoded_doc_prop_header {
+        encoded_doc *context;
+
+        encoded_doc_string_e rec_key_type;
+        union {
+                archive_field_sid_t key_id;
+                char *key_str;
+        } key;
+
+        encoded_doc_value_e value_type;
+        enum archive_field_type type;
+} encoded_doc_prop_header;
+
+typedef struct encoded_doc_prop {
+        encoded_doc_prop_header header;
+        union {
+                encoded_doc_value_u builtin;
+                char *string;
+        } value;
+} encoded_doc_prop;
+
+typedef struct encoded_doc_prop_array {
+        encoded_doc_prop_header header;
+        vec ofType(encoded_doc_value_u) values;
+} encoded_doc_prop_array;
+
+typedef struct encoded_doc {
+        encoded_doc_list *context;
+        unique_id_t object_id;
+        vec ofType(encoded_doc_prop) props;
+        vec ofType(encoded_doc_prop_array) props_arrays;
+        hashtable ofMapping(archive_field_sid_t,
+                                   u32) prop_array_index; /** maps key to index in prop arrays */
+} encoded_doc;
+
+typedef struct encoded_doc_list {
+        archive *archive;
+        vec ofType(
+                encoded_doc) flat_object_collection;   /** list of objects; also nested ones */
+        hashtable ofMapping(object_id_t, u32) index;   /** maps oid to index in collection */
+} encoded_doc_list;
+
+bool encoded_doc_collection_create(encoded_doc_list *collection, archive *archive);
+bool encoded_doc_collection_drop(encoded_doc_list *collection);
+encoded_doc *encoded_doc_collection_get_or_append(encoded_doc_list *collection, unique_id_t id);
+bool encoded_doc_collection_print(FILE *file, encoded_doc_list *collection);
+
+bool encoded_doc_drop(encoded_doc *doc);
+
+#define DEFINE_ENCODED_DOC_ADD_PROP_BASIC(name, built_in_type)                                                  \
+bool encoded_doc_add_prop_##name(encoded_doc *doc, archive_field_sid_t key, built_in_type value);
+
+#define DEFINE_ENCODED_DOC_ADD_PROP_BASIC_DECODED(name, built_in_type)                                          \
+bool encoded_doc_add_prop_##name##_decoded(encoded_doc *doc, const char *key, built_in_type value);
+
+DEFINE_ENCODED_DOC_ADD_PROP_BASIC(int8, archive_field_i8_t)
+DEFINE_ENCODED_DOC_ADD_PROP_BASIC(int16, archive_field_i16_t)
+DEFINE_ENCODED_DOC_ADD_PROP_BASIC(int32, archive_field_i32_t)
+DEFINE_ENCODED_DOC_ADD_PROP_BASIC(int64, archive_field_i64_t)
+DEFINE_ENCODED_DOC_ADD_PROP_BASIC(uint8, archive_field_u8_t)
+DEFINE_ENCODED_DOC_ADD_PROP_BASIC(uint16, archive_field_u16_t)
+DEFINE_ENCODED_DOC_ADD_PROP_BASIC(uint32, archive_field_u32_t)
+DEFINE_ENCODED_DOC_ADD_PROP_BASIC(uint64, archive_field_u64_t)
+DEFINE_ENCODED_DOC_ADD_PROP_BASIC(number, archive_field_number_t)
+DEFINE_ENCODED_DOC_ADD_PROP_BASIC(boolean, archive_field_boolean_t)
+DEFINE_ENCODED_DOC_ADD_PROP_BASIC(string, archive_field_sid_t)
+DEFINE_ENCODED_DOC_ADD_PROP_BASIC_DECODED(int8, archive_field_i8_t)
+DEFINE_ENCODED_DOC_ADD_PROP_BASIC_DECODED(int16, archive_field_i16_t)
+DEFINE_ENCODED_DOC_ADD_PROP_BASIC_DECODED(int32, archive_field_i32_t)
+DEFINE_ENCODED_DOC_ADD_PROP_BASIC_DECODED(int64, archive_field_i64_t)
+DEFINE_ENCODED_DOC_ADD_PROP_BASIC_DECODED(uint8, archive_field_u8_t)
+DEFINE_ENCODED_DOC_ADD_PROP_BASIC_DECODED(uint16, archive_field_u16_t)
+DEFINE_ENCODED_DOC_ADD_PROP_BASIC_DECODED(uint32, archive_field_u32_t)
+DEFINE_ENCODED_DOC_ADD_PROP_BASIC_DECODED(uint64, archive_field_u64_t)
+DEFINE_ENCODED_DOC_ADD_PROP_BASIC_DECODED(number, archive_field_number_t)
+DEFINE_ENCODED_DOC_ADD_PROP_BASIC_DECODED(boolean, archive_field_boolean_t)
+DEFINE_ENCODED_DOC_ADD_PROP_BASIC_DECODED(string, archive_field_sid_t)
+
+bool encoded_doc_add_prop_string_decoded_string_value_decoded(encoded_doc *doc, const char *key, const char *value);
+bool encoded_doc_add_prop_null(encoded_doc *doc, archive_field_sid_t key);
+bool encoded_doc_add_prop_null_decoded(encoded_doc *doc, const char *key);
+bool encoded_doc_add_prop_object(encoded_doc *doc, archive_field_sid_t key, encoded_doc *value);
+bool encoded_doc_add_prop_object_decoded(encoded_doc *doc, const char *key, encoded_doc *value);
+
+#define DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE(name)                                                            \
+bool encoded_doc_add_prop_array_##name(encoded_doc *doc, archive_field_sid_t key);
+
+#define DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE_DECODED(name)                                                    \
+bool encoded_doc_add_prop_array_##name##_decoded(encoded_doc *doc, const char *key);
+
+DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE(int8)
+DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE(int16)
+DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE(int32)
+DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE(int64)
+DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE(uint8)
+DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE(uint16)
+DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE(uint32)
+DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE(uint64)
+DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE(number)
+DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE(boolean)
+DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE(string)
+DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE(null)
+DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE(object)
+DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE_DECODED(int8)
+DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE_DECODED(int16)
+DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE_DECODED(int32)
+DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE_DECODED(int64)
+DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE_DECODED(uint8)
+DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE_DECODED(uint16)
+DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE_DECODED(uint32)
+DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE_DECODED(uint64)
+DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE_DECODED(number)
+DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE_DECODED(boolean)
+DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE_DECODED(string)
+DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE_DECODED(null)
+DEFINE_ENCODED_DOC_ADD_PROP_ARRAY_TYPE_DECODED(object)
+
+#define DEFINE_ENCODED_DOC_ARRAY_PUSH_TYPE(name, built_in_type)                                                    \
+bool encoded_doc_array_push_##name(encoded_doc *doc, archive_field_sid_t key, const built_in_type *array, u32 array_length);
+
+#define DEFINE_ENCODED_DOC_ARRAY_PUSH_TYPE_DECODED(name, built_in_type)                                            \
+bool encoded_doc_array_push_##name##_decoded(encoded_doc *doc, const char *key, const built_in_type *array, u32 array_length);
+
+DEFINE_ENCODED_DOC_ARRAY_PUSH_TYPE(int8, archive_field_i8_t)
+DEFINE_ENCODED_DOC_ARRAY_PUSH_TYPE(int16, archive_field_i16_t)
+DEFINE_ENCODED_DOC_ARRAY_PUSH_TYPE(int32, archive_field_i32_t)
+DEFINE_ENCODED_DOC_ARRAY_PUSH_TYPE(int64, archive_field_i64_t)
+DEFINE_ENCODED_DOC_ARRAY_PUSH_TYPE(uint8, archive_field_u8_t)
+DEFINE_ENCODED_DOC_ARRAY_PUSH_TYPE(uint16, archive_field_u16_t)
+DEFINE_ENCODED_DOC_ARRAY_PUSH_TYPE(uint32, archive_field_u32_t)
+DEFINE_ENCODED_DOC_ARRAY_PUSH_TYPE(uint64, archive_field_u64_t)
+DEFINE_ENCODED_DOC_ARRAY_PUSH_TYPE(number, archive_field_number_t)
+DEFINE_ENCODED_DOC_ARRAY_PUSH_TYPE(boolean, archive_field_boolean_t)
+DEFINE_ENCODED_DOC_ARRAY_PUSH_TYPE(string, archive_field_sid_t)
+DEFINE_ENCODED_DOC_ARRAY_PUSH_TYPE(null, archive_field_u32_t)
+DEFINE_ENCODED_DOC_ARRAY_PUSH_TYPE_DECODED(int8, archive_field_i8_t)
+DEFINE_ENCODED_DOC_ARRAY_PUSH_TYPE_DECODED(int16, archive_field_i16_t)
+DEFINE_ENCODED_DOC_ARRAY_PUSH_TYPE_DECODED(int32, archive_field_i32_t)
+DEFINE_ENCODED_DOC_ARRAY_PUSH_TYPE_DECODED(int64, archive_field_i64_t)
+DEFINE_ENCODED_DOC_ARRAY_PUSH_TYPE_DECODED(uint8, archive_field_u8_t)
+DEFINE_ENCODED_DOC_ARRAY_PUSH_TYPE_DECODED(uint16, archive_field_u16_t)
+DEFINE_ENCODED_DOC_ARRAY_PUSH_TYPE_DECODED(uint32, archive_field_u32_t)
+DEFINE_ENCODED_DOC_ARRAY_PUSH_TYPE_DECODED(uint64, archive_field_u64_t)
+DEFINE_ENCODED_DOC_ARRAY_PUSH_TYPE_DECODED(number, archive_field_number_t)
+DEFINE_ENCODED_DOC_ARRAY_PUSH_TYPE_DECODED(boolean, archive_field_boolean_t)
+DEFINE_ENCODED_DOC_ARRAY_PUSH_TYPE_DECODED(string, archive_field_sid_t)
+DEFINE_ENCODED_DOC_ARRAY_PUSH_TYPE_DECODED(null, archive_field_u32_t)
+
+bool encoded_doc_array_push_object(encoded_doc *doc, archive_field_sid_t key, unique_id_t id);
+bool encoded_doc_array_push_object_decoded(encoded_doc *doc, const char *key, unique_id_t id);
+bool encoded_doc_print(FILE *file, encoded_doc *doc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef HUFFMAN_H
+#define HUFFMAN_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/std/vec.h>
+#include <karbonit/mem/memfile.h>
+#include <karbonit/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct huffman {
+        vec ofType(pack_huffman_entry) table;
+} huffman;
+
+typedef struct pack_huffman_entry {
+        unsigned char letter;
+        u32 *blocks;
+        u16 nblocks;
+} pack_huffman_entry;
+
+typedef struct pack_huffman_info {
+        unsigned char letter;
+        u8 nbytes_prefix;
+        char *prefix_code;
+} pack_huffman_info;
+
+typedef struct pack_huffman_str_info {
+        u32 nbytes_encoded;
+        const char *encoded_bytes;
+} pack_huffman_str_info;
+
+bool coding_huffman_create(huffman *dic);
+bool coding_huffman_cpy(huffman *dst, huffman *src);
+bool coding_huffman_drop(huffman *dic);
+
+bool coding_huffman_build(huffman *encoder, const string_vec_t *strings);
+bool coding_huffman_encode(memfile *file, huffman *dic, const char *string);
+bool coding_huffman_read_string(pack_huffman_str_info *info, memfile *src);
+bool coding_huffman_serialize(memfile *file, const huffman *dic, char marker_symbol);
+bool coding_huffman_read_entry(pack_huffman_info *info, memfile *file, char marker_symbol);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef INTERNALS_ARCHIVE_H
+#define INTERNALS_ARCHIVE_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/mem/memfile.h>
+#include <karbonit/types.h>
+#include <karbonit/stdx/unique_id.h>
+#include <karbonit/archive/pack.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct __attribute__((packed)) archive_header {
+        char magic[9];
+        u8 version;
+        offset_t root_object_header_offset;
+        offset_t string_id_to_offset_index_offset;
+} archive_header;
+
+typedef struct __attribute__((packed)) record_header {
+        char marker;
+        u8 flags;
+        u64 record_size;
+} record_header;
+
+typedef struct __attribute__((packed)) object_header {
+        char marker;
+        unique_id_t oid;
+        u32 flags;
+} object_header;
+
+typedef struct __attribute__((packed)) prop_header {
+        char marker;
+        u32 num_entries;
+} prop_header;
+
+typedef union __attribute__((packed)) string_tab_flags {
+        struct {
+                u8 compressor_none
+                        : 1;
+                u8 compressed_huffman
+                        : 1;
+        } bits;
+        u8 value;
+} string_tab_flags_u;
+
+typedef struct __attribute__((packed)) string_table_header {
+        char marker;
+        u32 num_entries;
+        u8 flags;
+        offset_t first_entry;
+        offset_t compressor_extra_size;
+} string_table_header;
+
+typedef struct __attribute__((packed)) object_array_header {
+        char marker;
+        u8 num_entries;
+} object_array_header;
+
+typedef struct __attribute__((packed)) column_group_header {
+        char marker;
+        u32 num_columns;
+        u32 num_objects;
+} column_group_header;
+
+typedef struct __attribute__((packed)) column_header {
+        char marker;
+        archive_field_sid_t column_name;
+        char value_type;
+        u32 num_entries;
+} column_header;
+
+typedef union object_flags {
+        struct {
+                u32 has_null_props
+                        : 1;
+                u32 has_bool_props
+                        : 1;
+                u32 has_int8_props
+                        : 1;
+                u32 has_int16_props
+                        : 1;
+                u32 has_int32_props
+                        : 1;
+                u32 has_int64_props
+                        : 1;
+                u32 has_uint8_props
+                        : 1;
+                u32 has_uint16_props
+                        : 1;
+                u32 has_uint32_props
+                        : 1;
+                u32 has_uint64_props
+                        : 1;
+                u32 has_float_props
+                        : 1;
+                u32 has_string_props
+                        : 1;
+                u32 has_object_props
+                        : 1;
+                u32 has_null_array_props
+                        : 1;
+                u32 has_bool_array_props
+                        : 1;
+                u32 has_int8_array_props
+                        : 1;
+                u32 has_int16_array_props
+                        : 1;
+                u32 has_int32_array_props
+                        : 1;
+                u32 has_int64_array_props
+                        : 1;
+                u32 has_uint8_array_props
+                        : 1;
+                u32 has_uint16_array_props
+                        : 1;
+                u32 has_uint32_array_props
+                        : 1;
+                u32 has_uint64_array_props
+                        : 1;
+                u32 has_float_array_props
+                        : 1;
+                u32 has_string_array_props
+                        : 1;
+                u32 has_object_array_props
+                        : 1;
+                u32 RESERVED_27
+                        : 1;
+                u32 RESERVED_28
+                        : 1;
+                u32 RESERVED_29
+                        : 1;
+                u32 RESERVED_30
+                        : 1;
+                u32 RESERVED_31
+                        : 1;
+                u32 RESERVED_32
+                        : 1;
+        } bits;
+        u32 value;
+} object_flags_u;
+
+typedef struct archive_prop_offs {
+        offset_t nulls;
+        offset_t bools;
+        offset_t int8s;
+        offset_t int16s;
+        offset_t int32s;
+        offset_t int64s;
+        offset_t uint8s;
+        offset_t uint16s;
+        offset_t uint32s;
+        offset_t uint64s;
+        offset_t floats;
+        offset_t strings;
+        offset_t objects;
+        offset_t null_arrays;
+        offset_t bool_arrays;
+        offset_t int8_arrays;
+        offset_t int16_arrays;
+        offset_t int32_arrays;
+        offset_t int64_arrays;
+        offset_t uint8_arrays;
+        offset_t uint16_arrays;
+        offset_t uint32_arrays;
+        offset_t uint64_arrays;
+        offset_t float_arrays;
+        offset_t string_arrays;
+        offset_t object_arrays;
+} archive_prop_offs;
+
+typedef struct fixed_prop {
+        prop_header *header;
+        const archive_field_sid_t *keys;
+        const void *values;
+} fixed_prop;
+
+typedef struct table_prop {
+        prop_header *header;
+        const archive_field_sid_t *keys;
+        const offset_t *group_offs;
+} table_prop;
+
+typedef struct var_prop {
+        prop_header *header;
+        const archive_field_sid_t *keys;
+        const offset_t *offsets;
+        const void *values;
+} var_prop;
+
+typedef struct array_prop {
+        prop_header *header;
+        const archive_field_sid_t *keys;
+        const u32 *lengths;
+        offset_t values_begin;
+} array_prop;
+
+typedef struct null_prop {
+        prop_header *header;
+        const archive_field_sid_t *keys;
+} null_prop;
+
+typedef enum archive_marker {
+        MARKER_TYPE_OBJECT_BEGIN = 0,
+        MARKER_TYPE_OBJECT_END = 1,
+        MARKER_TYPE_PROP_NULL = 2,
+        MARKER_TYPE_PROP_BOOLEAN = 3,
+        MARKER_TYPE_PROP_INT8 = 4,
+        MARKER_TYPE_PROP_INT16 = 5,
+        MARKER_TYPE_PROP_INT32 = 6,
+        MARKER_TYPE_PROP_INT64 = 7,
+        MARKER_TYPE_PROP_UINT8 = 8,
+        MARKER_TYPE_PROP_UINT16 = 9,
+        MARKER_TYPE_PROP_UINT32 = 10,
+        MARKER_TYPE_PROP_UINT64 = 11,
+        MARKER_TYPE_PROP_REAL = 12,
+        MARKER_TYPE_PROP_TEXT = 13,
+        MARKER_TYPE_PROP_OBJECT = 14,
+        MARKER_TYPE_PROP_NULL_ARRAY = 15,
+        MARKER_TYPE_PROP_BOOLEAN_ARRAY = 16,
+        MARKER_TYPE_PROP_INT8_ARRAY = 17,
+        MARKER_TYPE_PROP_INT16_ARRAY = 18,
+        MARKER_TYPE_PROP_INT32_ARRAY = 19,
+        MARKER_TYPE_PROP_INT64_ARRAY = 20,
+        MARKER_TYPE_PROP_UINT8_ARRAY = 21,
+        MARKER_TYPE_PROP_UINT16_ARRAY = 22,
+        MARKER_TYPE_PROP_UINT32_ARRAY = 23,
+        MARKER_TYPE_PROP_UINT64_ARRAY = 24,
+        MARKER_TYPE_PROP_REAL_ARRAY = 25,
+        MARKER_TYPE_PROP_TEXT_ARRAY = 26,
+        MARKER_TYPE_PROP_OBJECT_ARRAY = 27,
+        MARKER_TYPE_EMBEDDED_STR_DIC = 28,
+        MARKER_TYPE_EMBEDDED_UNCOMP_STR = 29,
+        MARKER_TYPE_COLUMN_GROUP = 30,
+        MARKER_TYPE_COLUMN = 31,
+        MARKER_TYPE_HUFFMAN_DIC_ENTRY = 32,
+        MARKER_TYPE_RECORD_HEADER = 33,
+} archive_marker_e;
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-variable"
+
+static archive_header this_file_header = {.version = CARBON_ARCHIVE_VERSION, .root_object_header_offset = 0};
+
+static struct {
+        archive_marker_e type;
+        char symbol;
+} global_marker_symbols[] =
+        {{MARKER_TYPE_OBJECT_BEGIN,        MARKER_SYMBOL_OBJECT_BEGIN},
+         {MARKER_TYPE_OBJECT_END,          MARKER_SYMBOL_OBJECT_END},
+         {MARKER_TYPE_PROP_NULL,           MARKER_SYMBOL_PROP_NULL},
+         {MARKER_TYPE_PROP_BOOLEAN,        MARKER_SYMBOL_PROP_BOOLEAN},
+         {MARKER_TYPE_PROP_INT8,           MARKER_SYMBOL_PROP_INT8},
+         {MARKER_TYPE_PROP_INT16,          MARKER_SYMBOL_PROP_INT16},
+         {MARKER_TYPE_PROP_INT32,          MARKER_SYMBOL_PROP_INT32},
+         {MARKER_TYPE_PROP_INT64,          MARKER_SYMBOL_PROP_INT64},
+         {MARKER_TYPE_PROP_UINT8,          MARKER_SYMBOL_PROP_UINT8},
+         {MARKER_TYPE_PROP_UINT16,         MARKER_SYMBOL_PROP_UINT16},
+         {MARKER_TYPE_PROP_UINT32,         MARKER_SYMBOL_PROP_UINT32},
+         {MARKER_TYPE_PROP_UINT64,         MARKER_SYMBOL_PROP_UINT64},
+         {MARKER_TYPE_PROP_REAL,           MARKER_SYMBOL_PROP_REAL},
+         {MARKER_TYPE_PROP_TEXT,           MARKER_SYMBOL_PROP_TEXT},
+         {MARKER_TYPE_PROP_OBJECT,         MARKER_SYMBOL_PROP_OBJECT},
+         {MARKER_TYPE_PROP_NULL_ARRAY,     MARKER_SYMBOL_PROP_NULL_ARRAY},
+         {MARKER_TYPE_PROP_BOOLEAN_ARRAY,  MARKER_SYMBOL_PROP_BOOLEAN_ARRAY},
+         {MARKER_TYPE_PROP_INT8_ARRAY,     MARKER_SYMBOL_PROP_INT8_ARRAY},
+         {MARKER_TYPE_PROP_INT16_ARRAY,    MARKER_SYMBOL_PROP_INT16_ARRAY},
+         {MARKER_TYPE_PROP_INT32_ARRAY,    MARKER_SYMBOL_PROP_INT32_ARRAY},
+         {MARKER_TYPE_PROP_INT64_ARRAY,    MARKER_SYMBOL_PROP_INT64_ARRAY},
+         {MARKER_TYPE_PROP_UINT8_ARRAY,    MARKER_SYMBOL_PROP_UINT8_ARRAY},
+         {MARKER_TYPE_PROP_UINT16_ARRAY,   MARKER_SYMBOL_PROP_UINT16_ARRAY},
+         {MARKER_TYPE_PROP_UINT32_ARRAY,   MARKER_SYMBOL_PROP_UINT32_ARRAY},
+         {MARKER_TYPE_PROP_UINT64_ARRAY,   MARKER_SYMBOL_PROP_UINT64_ARRAY},
+         {MARKER_TYPE_PROP_REAL_ARRAY,     MARKER_SYMBOL_PROP_REAL_ARRAY},
+         {MARKER_TYPE_PROP_TEXT_ARRAY,     MARKER_SYMBOL_PROP_TEXT_ARRAY},
+         {MARKER_TYPE_PROP_OBJECT_ARRAY,   MARKER_SYMBOL_PROP_OBJECT_ARRAY},
+         {MARKER_TYPE_EMBEDDED_STR_DIC,    MARKER_SYMBOL_EMBEDDED_STR_DIC},
+         {MARKER_TYPE_EMBEDDED_UNCOMP_STR, MARKER_SYMBOL_EMBEDDED_STR},
+         {MARKER_TYPE_COLUMN_GROUP,        MARKER_SYMBOL_COLUMN_GROUP},
+         {MARKER_TYPE_COLUMN,              MARKER_SYMBOL_COLUMN},
+         {MARKER_TYPE_HUFFMAN_DIC_ENTRY,   MARKER_SYMBOL_HUFFMAN_DIC_ENTRY},
+         {MARKER_TYPE_RECORD_HEADER,       MARKER_SYMBOL_RECORD_HEADER}};
+
+static struct {
+        archive_field_e value_type;
+        archive_marker_e marker;
+} global_value_array_marker_mapping[] =
+        {{ARCHIVE_FIELD_NULL,    MARKER_TYPE_PROP_NULL_ARRAY},
+         {ARCHIVE_FIELD_BOOLEAN, MARKER_TYPE_PROP_BOOLEAN_ARRAY},
+         {ARCHIVE_FIELD_INT8,    MARKER_TYPE_PROP_INT8_ARRAY},
+         {ARCHIVE_FIELD_INT16,   MARKER_TYPE_PROP_INT16_ARRAY},
+         {ARCHIVE_FIELD_INT32,   MARKER_TYPE_PROP_INT32_ARRAY},
+         {ARCHIVE_FIELD_INT64,   MARKER_TYPE_PROP_INT64_ARRAY},
+         {ARCHIVE_FIELD_UINT8,   MARKER_TYPE_PROP_UINT8_ARRAY},
+         {ARCHIVE_FIELD_UINT16,  MARKER_TYPE_PROP_UINT16_ARRAY},
+         {ARCHIVE_FIELD_UINT32,  MARKER_TYPE_PROP_UINT32_ARRAY},
+         {ARCHIVE_FIELD_UINT64,  MARKER_TYPE_PROP_UINT64_ARRAY},
+         {ARCHIVE_FIELD_FLOAT,   MARKER_TYPE_PROP_REAL_ARRAY},
+         {ARCHIVE_FIELD_STRING,  MARKER_TYPE_PROP_TEXT_ARRAY},
+         {ARCHIVE_FIELD_OBJECT,  MARKER_TYPE_PROP_OBJECT_ARRAY}}, valueMarkerMapping[] =
+        {{ARCHIVE_FIELD_NULL,    MARKER_TYPE_PROP_NULL},
+         {ARCHIVE_FIELD_BOOLEAN, MARKER_TYPE_PROP_BOOLEAN},
+         {ARCHIVE_FIELD_INT8,    MARKER_TYPE_PROP_INT8},
+         {ARCHIVE_FIELD_INT16,   MARKER_TYPE_PROP_INT16},
+         {ARCHIVE_FIELD_INT32,   MARKER_TYPE_PROP_INT32},
+         {ARCHIVE_FIELD_INT64,   MARKER_TYPE_PROP_INT64},
+         {ARCHIVE_FIELD_UINT8,   MARKER_TYPE_PROP_UINT8},
+         {ARCHIVE_FIELD_UINT16,  MARKER_TYPE_PROP_UINT16},
+         {ARCHIVE_FIELD_UINT32,  MARKER_TYPE_PROP_UINT32},
+         {ARCHIVE_FIELD_UINT64,  MARKER_TYPE_PROP_UINT64},
+         {ARCHIVE_FIELD_FLOAT,   MARKER_TYPE_PROP_REAL},
+         {ARCHIVE_FIELD_STRING,  MARKER_TYPE_PROP_TEXT},
+         {ARCHIVE_FIELD_OBJECT,  MARKER_TYPE_PROP_OBJECT}};
+
+#pragma GCC diagnostic pop
+
+typedef struct record_flags {
+        struct {
+                u8 is_sorted
+                        : 1;
+                u8 RESERVED_2
+                        : 1;
+                u8 RESERVED_3
+                        : 1;
+                u8 RESERVED_4
+                        : 1;
+                u8 RESERVED_5
+                        : 1;
+                u8 RESERVED_6
+                        : 1;
+                u8 RESERVED_7
+                        : 1;
+                u8 RESERVED_8
+                        : 1;
+        } bits;
+        u8 value;
+} record_flags;
+
+typedef struct string_table {
+        packer compressor;
+        offset_t first_entry_off;
+        u32 num_embeddded_strings;
+} string_table;
+
+typedef struct record_table {
+        record_flags flags;
+        memblock *record_db;
+} record_table;
+
+typedef struct archive_info {
+        size_t string_table_size;
+        size_t record_table_size;
+        size_t string_id_index_size;
+        u32 num_embeddded_strings;
+} archive_info;
+
+typedef struct __attribute__((packed)) string_entry_header {
+        char marker;
+        offset_t next_entry_off;
+        archive_field_sid_t string_id;
+        u32 string_len;
+} string_entry_header;
+
+void int_read_prop_offsets(archive_prop_offs *prop_offsets, memfile *memfile, const object_flags_u *flags);
+void int_embedded_fixed_props_read(fixed_prop *prop, memfile *memfile);
+void int_embedded_var_props_read(var_prop *prop, memfile *memfile);
+void int_embedded_null_props_read(null_prop *prop, memfile *memfile);
+void int_embedded_array_props_read(array_prop *prop, memfile *memfile);
+void int_embedded_table_props_read(table_prop *prop, memfile *memfile);
+archive_field_e int_get_value_type_of_char(char c);
+archive_field_e int_marker_to_field_type(char symbol);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef IO_CONTEXT_H
+#define IO_CONTEXT_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool io_context_create(archive_io_context **context, const char *file_path);
+FILE *io_context_lock_and_access(archive_io_context *context);
+bool io_context_unlock(archive_io_context *context);
+bool io_context_drop(archive_io_context *context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ARCHIVE_ITER_H
+#define ARCHIVE_ITER_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/archive.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum prop_iter_state {
+        PROP_ITER_INIT,
+        PROP_ITER_NULLS,
+        PROP_ITER_BOOLS,
+        PROP_ITER_INT8S,
+        PROP_ITER_INT16S,
+        PROP_ITER_INT32S,
+        PROP_ITER_INT64S,
+        PROP_ITER_UINT8S,
+        PROP_ITER_UINT16S,
+        PROP_ITER_UINT32S,
+        PROP_ITER_UINT64S,
+        PROP_ITER_FLOATS,
+        PROP_ITER_STRINGS,
+        PROP_ITER_OBJECTS,
+        PROP_ITER_NULL_ARRAYS,
+        PROP_ITER_BOOL_ARRAYS,
+        PROP_ITER_INT8_ARRAYS,
+        PROP_ITER_INT16_ARRAYS,
+        PROP_ITER_INT32_ARRAYS,
+        PROP_ITER_INT64_ARRAYS,
+        PROP_ITER_UINT8_ARRAYS,
+        PROP_ITER_UINT16_ARRAYS,
+        PROP_ITER_UINT32_ARRAYS,
+        PROP_ITER_UINT64_ARRAYS,
+        PROP_ITER_FLOAT_ARRAYS,
+        PROP_ITER_STRING_ARRAYS,
+        PROP_ITER_OBJECT_ARRAYS,
+        PROP_ITER_DONE,
+        PROP_ITER_ERR
+} prop_iter_state_e;
+
+typedef struct archive_object {
+        unique_id_t object_id;                  /** unique object id */
+        offset_t offset;                        /** this objects header offset */
+        archive_prop_offs prop_offsets;  /** per-property type offset in the record table byte stream */
+        offset_t next_obj_off;                  /** offset to next object in list, or NULL if no such exists */
+        memfile memfile;
+} archive_object;
+
+typedef enum prop_iter_mode {
+        PROP_ITER_MODE_OBJECT,
+        PROP_ITER_MODE_COLLECTION,
+} prop_iter_mode_e;
+
+typedef struct object_iter_state {
+        fixed_prop prop_group_header;    /** type, num props and keys */
+        offset_t current_prop_group_off;
+        offset_t prop_data_off;
+        const archive_field_sid_t *keys;                /** current property key in this iteration */
+        enum archive_field_type type;                   /** property basic value type (e.g., int8, or object) */
+        bool is_array;                          /** flag indicating that property is an array type */
+} object_iter_state;
+
+typedef struct collection_iter_state {
+        offset_t collection_start_off;
+        u32 num_column_groups;
+        u32 current_column_group_idx;
+        const archive_field_sid_t *column_group_keys;
+        const offset_t *column_group_offsets;
+
+        struct {
+                u32 num_columns;
+                u32 num_objects;
+                const unique_id_t *object_ids;
+                const offset_t *column_offs;
+                struct {
+                        u32 idx;
+                        archive_field_sid_t name;
+                        enum archive_field_type type;
+                        u32 num_elem;
+                        const offset_t *elem_offsets;
+                        const u32 *elem_positions;
+                        struct {
+                                u32 idx;
+                                u32 array_length;
+                                const void *array_base;
+                        } current_entry;
+                } current_column;
+        } current_column_group;
+} collection_iter_state;
+
+typedef struct archive_value_vector {
+        prop_iter *prop_iter;            /** pointer to property iterator that created this iterator */
+        memfile record_table_memfile;    /** iterator-local read-only mem on archive record table */
+        enum archive_field_type prop_type;              /** property basic value type (e.g., int8, or object) */
+        bool is_array;                          /** flag indicating whether value type is an array or not */
+        offset_t data_off;                      /** offset in mem where type-dependent data begins */
+        u32 value_max_idx;                      /** maximum index of a value callable by 'at' functions */
+        unique_id_t object_id;                  /** current object id */
+        const archive_field_sid_t *keys;
+        union {
+                struct {
+                        const offset_t *offsets;
+                        archive_object object;
+                } object;
+                struct {
+                        union {
+                                const archive_field_i8_t *int8s;
+                                const archive_field_i16_t *int16s;
+                                const archive_field_i32_t *int32s;
+                                const archive_field_i64_t *int64s;
+                                const archive_field_u8_t *uint8s;
+                                const archive_field_u16_t *uint16s;
+                                const archive_field_u32_t *uint32s;
+                                const archive_field_u64_t *uint64s;
+                                const archive_field_number_t *numbers;
+                                const archive_field_sid_t *strings;
+                                const archive_field_boolean_t *booleans;
+                        } values;
+                } basic;
+                struct {
+                        union {
+                                const u32 *array_lengths;
+                                const u32 *num_nulls_contained;
+                        } meta;
+
+                        union {
+                                const archive_field_i8_t *int8s_base;
+                                const archive_field_i16_t *int16s_base;
+                                const archive_field_i32_t *int32s_base;
+                                const archive_field_i64_t *int64s_base;
+                                const archive_field_u8_t *uint8s_base;
+                                const archive_field_u16_t *uint16s_base;
+                                const archive_field_u32_t *uint32s_base;
+                                const archive_field_u64_t *uint64s_base;
+                                const archive_field_number_t *numbers_base;
+                                const archive_field_sid_t *strings_base;
+                                const archive_field_boolean_t *booleans_base;
+                        } values;
+                } arrays;
+        } data;
+} archive_value_vector;
+
+typedef struct prop_iter {
+        archive_object object;                 /** current object */
+        memfile record_table_memfile;          /** iterator-local read-only mem on archive record table */
+        u16 mask;                                     /** user-defined mask which properties to include */
+        prop_iter_mode_e mode;                     /** determines whether to iterating over object or collection */
+        prop_iter_state_e prop_cursor;             /** current property type in iteration */
+        object_iter_state mode_object;
+        collection_iter_state mode_collection;
+} prop_iter;
+
+typedef struct independent_iter_state {
+        memfile record_table_memfile;           /** iterator-local read-only mem on archive record table */
+        collection_iter_state state;            /** iterator-local state */
+} independent_iter_state;
+
+typedef struct column_object_iter {
+        memfile memfile;
+        collection_iter_state entry_state;
+        archive_object obj;
+        offset_t next_obj_off;
+} column_object_iter;
+
+#define ARCHIVE_ITER_MASK_PRIMITIVES             (1 << 1)
+#define ARCHIVE_ITER_MASK_ARRAYS                 (1 << 2)
+
+#define ARCHIVE_ITER_MASK_INT8                   (1 << 3)
+#define ARCHIVE_ITER_MASK_INT16                  (1 << 4)
+#define ARCHIVE_ITER_MASK_INT32                  (1 << 5)
+#define ARCHIVE_ITER_MASK_INT64                  (1 << 6)
+#define ARCHIVE_ITER_MASK_UINT8                  (1 << 7)
+#define ARCHIVE_ITER_MASK_UINT16                 (1 << 8)
+#define ARCHIVE_ITER_MASK_UINT32                 (1 << 9)
+#define ARCHIVE_ITER_MASK_UINT64                 (1 << 10)
+#define ARCHIVE_ITER_MASK_NUMBER                 (1 << 11)
+#define ARCHIVE_ITER_MASK_STRING                 (1 << 12)
+#define ARCHIVE_ITER_MASK_BOOLEAN                (1 << 13)
+#define ARCHIVE_ITER_MASK_NULL                   (1 << 14)
+#define ARCHIVE_ITER_MASK_OBJECT                 (1 << 15)
+
+#define ARCHIVE_ITER_MASK_INTEGER               ARCHIVE_ITER_MASK_INT8       |                                 \
+                                                    ARCHIVE_ITER_MASK_INT16      |                                 \
+                                                    ARCHIVE_ITER_MASK_INT32      |                                 \
+                                                    ARCHIVE_ITER_MASK_INT64      |                                 \
+                                                    ARCHIVE_ITER_MASK_UINT8      |                                 \
+                                                    ARCHIVE_ITER_MASK_UINT16     |                                 \
+                                                    ARCHIVE_ITER_MASK_UINT32     |                                 \
+                                                    ARCHIVE_ITER_MASK_UINT64
+
+#define ARCHIVE_ITER_MASK_ANY                   ARCHIVE_ITER_MASK_PRIMITIVES |                                 \
+                                                    ARCHIVE_ITER_MASK_ARRAYS     |                                 \
+                                                    ARCHIVE_ITER_MASK_INTEGER    |                                 \
+                                                    ARCHIVE_ITER_MASK_NUMBER     |                                 \
+                                                    ARCHIVE_ITER_MASK_STRING     |                                 \
+                                                    ARCHIVE_ITER_MASK_BOOLEAN    |                                 \
+                                                    ARCHIVE_ITER_MASK_NULL       |                                 \
+                                                    ARCHIVE_ITER_MASK_OBJECT
+
+bool archive_prop_iter_from_archive(prop_iter *iter, u16 mask, archive *archive);
+bool archive_prop_iter_from_object(prop_iter *iter, u16 mask, const archive_object *obj);
+bool archive_value_vec_from_prop_iter(archive_value_vector *value, prop_iter *prop_iter);
+bool archive_prop_iter_next(prop_iter_mode_e *type, archive_value_vector *value_vector, independent_iter_state *collection_iter, prop_iter *prop_iter);
+const archive_field_sid_t *archive_collection_iter_get_keys(u32 *num_keys, independent_iter_state *iter);
+bool archive_collection_next_column_group(independent_iter_state *group_iter, independent_iter_state *iter);
+const unique_id_t *archive_column_group_get_object_ids(u32 *num_objects, independent_iter_state *iter);
+bool archive_column_group_next_column(independent_iter_state *column_iter, independent_iter_state *iter);
+bool archive_column_get_name(archive_field_sid_t *name, enum archive_field_type *type, independent_iter_state *column_iter);
+const u32 * archive_column_get_entry_positions(u32 *num_entry, independent_iter_state *column_iter);
+bool archive_column_next_entry(independent_iter_state *entry_iter, independent_iter_state *iter);
+bool archive_column_entry_get_type(enum archive_field_type *type, independent_iter_state *entry);
+
+#define DEFINE_ARCHIVE_COLUMN_ENTRY_GET_BASIC_TYPE(built_in_type, name)                                            \
+const built_in_type *                                                                                      \
+archive_column_entry_get_##name(u32 *array_length, independent_iter_state *entry);
+
+DEFINE_ARCHIVE_COLUMN_ENTRY_GET_BASIC_TYPE(archive_field_i8_t, int8s);
+DEFINE_ARCHIVE_COLUMN_ENTRY_GET_BASIC_TYPE(archive_field_i16_t, int16s);
+DEFINE_ARCHIVE_COLUMN_ENTRY_GET_BASIC_TYPE(archive_field_i32_t, int32s);
+DEFINE_ARCHIVE_COLUMN_ENTRY_GET_BASIC_TYPE(archive_field_i64_t, int64s);
+DEFINE_ARCHIVE_COLUMN_ENTRY_GET_BASIC_TYPE(archive_field_u8_t, uint8s);
+DEFINE_ARCHIVE_COLUMN_ENTRY_GET_BASIC_TYPE(archive_field_u16_t, uint16s);
+DEFINE_ARCHIVE_COLUMN_ENTRY_GET_BASIC_TYPE(archive_field_u32_t, uint32s);
+DEFINE_ARCHIVE_COLUMN_ENTRY_GET_BASIC_TYPE(archive_field_u64_t, uint64s);
+DEFINE_ARCHIVE_COLUMN_ENTRY_GET_BASIC_TYPE(archive_field_sid_t, strings);
+DEFINE_ARCHIVE_COLUMN_ENTRY_GET_BASIC_TYPE(archive_field_number_t, numbers);
+DEFINE_ARCHIVE_COLUMN_ENTRY_GET_BASIC_TYPE(archive_field_boolean_t, booleans);
+DEFINE_ARCHIVE_COLUMN_ENTRY_GET_BASIC_TYPE(archive_field_u32_t, nulls);
+
+bool archive_column_entry_get_objects(column_object_iter *iter, independent_iter_state *entry);
+const archive_object *archive_column_entry_object_iter_next_object(column_object_iter *iter);
+bool archive_object_get_object_id(unique_id_t *id, const archive_object *object);
+bool archive_object_get_prop_iter(prop_iter *iter, const archive_object *object);
+bool archive_value_vec_get_object_id(unique_id_t *id, const archive_value_vector *iter);
+const archive_field_sid_t *archive_value_vec_get_keys(u32 *num_keys, archive_value_vector *iter);
+bool archive_value_vec_get_basic_type(enum archive_field_type *type, const archive_value_vector *value);
+bool archive_value_vec_is_array_type(bool *is_array, const archive_value_vector *value);
+bool archive_value_vec_get_length(u32 *length, const archive_value_vector *value);
+bool archive_value_vec_is_of_objects(bool *is_object, archive_value_vector *value);
+bool archive_value_vec_get_object_at(archive_object *object, u32 idx, archive_value_vector *value);
+
+#define DEFINE_ARCHIVE_VALUE_VEC_IS_BASIC_TYPE(name)                                                            \
+bool                                                                                                       \
+archive_value_vec_is_##name(bool *type_match, archive_value_vector *value);
+
+DEFINE_ARCHIVE_VALUE_VEC_IS_BASIC_TYPE(int8);
+DEFINE_ARCHIVE_VALUE_VEC_IS_BASIC_TYPE(int16);
+DEFINE_ARCHIVE_VALUE_VEC_IS_BASIC_TYPE(int32);
+DEFINE_ARCHIVE_VALUE_VEC_IS_BASIC_TYPE(int64);
+DEFINE_ARCHIVE_VALUE_VEC_IS_BASIC_TYPE(uint8);
+DEFINE_ARCHIVE_VALUE_VEC_IS_BASIC_TYPE(uint16);
+DEFINE_ARCHIVE_VALUE_VEC_IS_BASIC_TYPE(uint32);
+DEFINE_ARCHIVE_VALUE_VEC_IS_BASIC_TYPE(uint64);
+DEFINE_ARCHIVE_VALUE_VEC_IS_BASIC_TYPE(string);
+DEFINE_ARCHIVE_VALUE_VEC_IS_BASIC_TYPE(number);
+DEFINE_ARCHIVE_VALUE_VEC_IS_BASIC_TYPE(boolean);
+DEFINE_ARCHIVE_VALUE_VEC_IS_BASIC_TYPE(null);
+
+#define DEFINE_ARCHIVE_VALUE_VEC_GET_BASIC_TYPE(name, built_in_type)                                            \
+const built_in_type *                                                                                      \
+archive_value_vec_get_##name(u32 *num_values, archive_value_vector *value);
+
+DEFINE_ARCHIVE_VALUE_VEC_GET_BASIC_TYPE(int8s, archive_field_i8_t)
+DEFINE_ARCHIVE_VALUE_VEC_GET_BASIC_TYPE(int16s, archive_field_i16_t)
+DEFINE_ARCHIVE_VALUE_VEC_GET_BASIC_TYPE(int32s, archive_field_i32_t)
+DEFINE_ARCHIVE_VALUE_VEC_GET_BASIC_TYPE(int64s, archive_field_i64_t)
+DEFINE_ARCHIVE_VALUE_VEC_GET_BASIC_TYPE(uint8s, archive_field_u8_t)
+DEFINE_ARCHIVE_VALUE_VEC_GET_BASIC_TYPE(uint16s, archive_field_u16_t)
+DEFINE_ARCHIVE_VALUE_VEC_GET_BASIC_TYPE(uint32s, archive_field_u32_t)
+DEFINE_ARCHIVE_VALUE_VEC_GET_BASIC_TYPE(uint64s, archive_field_u64_t)
+DEFINE_ARCHIVE_VALUE_VEC_GET_BASIC_TYPE(strings, archive_field_sid_t)
+DEFINE_ARCHIVE_VALUE_VEC_GET_BASIC_TYPE(numbers, archive_field_number_t)
+DEFINE_ARCHIVE_VALUE_VEC_GET_BASIC_TYPE(booleans, archive_field_boolean_t)
+
+const archive_field_u32_t *archive_value_vec_get_null_arrays(u32 *num_values, archive_value_vector *value);
+
+#define DEFINE_ARCHIVE_VALUE_VEC_GET_ARRAY_TYPE_AT(name, built_in_type)                                         \
+const built_in_type *                                                                                      \
+archive_value_vec_get_##name##_arrays_at(u32 *array_length, u32 idx,                                                \
+                                               archive_value_vector *value);                                    \
+
+
+DEFINE_ARCHIVE_VALUE_VEC_GET_ARRAY_TYPE_AT(int8, archive_field_i8_t);
+DEFINE_ARCHIVE_VALUE_VEC_GET_ARRAY_TYPE_AT(int16, archive_field_i16_t);
+DEFINE_ARCHIVE_VALUE_VEC_GET_ARRAY_TYPE_AT(int32, archive_field_i32_t);
+DEFINE_ARCHIVE_VALUE_VEC_GET_ARRAY_TYPE_AT(int64, archive_field_i64_t);
+DEFINE_ARCHIVE_VALUE_VEC_GET_ARRAY_TYPE_AT(uint8, archive_field_u8_t);
+DEFINE_ARCHIVE_VALUE_VEC_GET_ARRAY_TYPE_AT(uint16, archive_field_u16_t);
+DEFINE_ARCHIVE_VALUE_VEC_GET_ARRAY_TYPE_AT(uint32, archive_field_u32_t);
+DEFINE_ARCHIVE_VALUE_VEC_GET_ARRAY_TYPE_AT(uint64, archive_field_u64_t);
+DEFINE_ARCHIVE_VALUE_VEC_GET_ARRAY_TYPE_AT(string, archive_field_sid_t);
+DEFINE_ARCHIVE_VALUE_VEC_GET_ARRAY_TYPE_AT(number, archive_field_number_t);
+DEFINE_ARCHIVE_VALUE_VEC_GET_ARRAY_TYPE_AT(boolean, archive_field_boolean_t);
+
+void archive_int_reset_obj_it_mem_file(archive_object *object);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PACK_H
+#define PACK_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/archive/pack/none.h>
+#include <karbonit/archive/pack/huffman.h>
+#include <karbonit/archive/huffman.h>
+#include <karbonit/stdinc.h>
+#include <karbonit/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Unique tag identifying a specific implementation for compressing/decompressing string in a CARBON archives
+ * string table.
+ */
+typedef enum packer_e {
+        PACK_NONE, PACK_HUFFMAN
+} packer_e;
+
+/**
+ * Main interface for the compressor framework. A compressor is used to encode/decode strings stored in a
+ * CARBON archive.
+ */
+typedef struct packer {
+        /** Tag identifying the implementation of this compressor */
+        packer_e tag;
+
+        /** Implementation-specific storage */
+        void *extra;
+
+        /**
+         * Constructor for implementation-dependent initialization of the compressor at hand.
+         *
+         * Depending on the implementation, the compressor might allocate dynamic memory for
+         * <code>extra</code> for book-keeping purposes.
+         *
+         * @param self A pointer to itself
+         * @return <b>true</b> in case of success, or <b>false</b> otherwise.
+         *
+         * @author Marcus Pinnecke
+         * @since 0.1.00.05
+         */
+        bool (*create)(packer *self);
+
+        /**
+         * Destructor for implementation-dependent deinitialization of the compressor at hand.
+         *
+         * If the implementation acquired dynamic memory during a call to <code>create</code>,
+         * a call to this function frees up this memory.
+         *
+         * @param self A pointer to itself
+         * @return <b>true</b> in case of success, or <b>false</b> otherwise.
+         *
+         * @author Marcus Pinnecke
+         * @since 0.1.00.05
+         */
+        bool (*drop)(packer *self);
+
+        /**
+         * Perform a hard-copy of this compressor to dst
+         *
+         * @param self  A pointer to itself
+         * @param dst   A pointer to the copy target
+         *
+         * @return <b>true</b> in case of success, or <b>false</b> otherwise.
+         *
+         * @author Marcus Pinnecke
+         * @since 0.1.00.05
+         */
+        bool (*cpy)(const packer *self, packer *dst);
+
+        /**
+         * Function to construct and serialize an implementation-specific dictionary, book-keeping data, or extra data
+         * (e.g., a code table)
+         *
+         * Depending on the implementation, a set of book-keeping data must be managed for a compressor. For instance,
+         * in case of a huffman encoded this book-keeping is the code table that maps letters to prefix codes. This
+         * function is invoked before any string gets encoded, and implements a compressor-specific management and
+         * serialization of that book-keeping data. After internal construction of this book-keeping data,
+         * this data is serialized into the <code>dst</code> parameter.
+         *
+         * Reverse function of <code>read_extra</code>.
+         *
+         * @note single strings must not be encoded; this is is done when the framework invokes <code>encode_string</code>
+         *
+         * @param self A pointer to the compressor that is used; maybe accesses <code>extra</code>
+         * @param dst A memory file in which the book-keeping data (<code>extra</code>) for this compressor is serialized
+         * @param strings The set of all strings that should be encoded. Used for tweaking the compressor;
+         *                 <b>not</b> for serialization into <code>dst</code>
+         *
+         * @note strings in <code>strings</code> are unique (but not sorted)
+         *
+         * @author Marcus Pinnecke
+         * @since 0.1.00.05
+         * */
+        bool (*write_extra)(packer *self, memfile *dst,
+                            const vec ofType (const char *) *strings);
+
+        /**
+         * Function to reconstruct implementation-specific dictionary, book-keeping or extra data by deserialization (
+         * e.g., a code table)
+         *
+         * Reverse function of <code>write_extra</code>.
+         *
+         * @param self A pointer to the compressor that is used; maybe accesses <code>extra</code>
+         * @param src A file where the cursor is moved to the first byte of the extra field previously serialized with 'write_extra'
+         * @param nbytes Number of bytes written when 'write_extra' was called. Intended to read read to restore the extra field.
+         * @return The implementer must return <code>true</code> on success, and <code>false</code> otherwise.
+         */
+        bool (*read_extra)(packer *self, FILE *src, size_t nbytes);
+
+        /**
+         * Encodes an input string and writes its encoded version into a memory file.
+         *
+         * @param self A pointer to the compressor that is used; maybe accesses <code>extra</code>
+         * @param dst A memory file in which the encoded string should be stored
+         * @param err An ERROR information
+         * @param string The string that should be encoded
+         *
+         * @return <b>true</b> in case of success, or <b>false</b> otherwise.
+         *
+         * @author Marcus Pinnecke
+         * @since 0.1.00.05
+         */
+        bool
+        (*encode_string)(packer *self, memfile *dst, const char *string);
+
+        bool (*decode_string)(packer *self, char *dst, size_t strlen, FILE *src);
+
+        /**
+         * Reads implementation-specific book-keeping, meta or extra data from the input memory file and
+         * prints its contents in a human-readable version to <code>file</code>
+         *
+         * @param self A pointer to the compressor that is used; potentially accessing <code>extra</code>
+         * @param file A file to which a human-readable version of <code>extra</code> is printed (if any)
+         * @param src A memory file which cursor is positioned at the begin of the serialized extra field. After
+         *            a call to this function, the memory file cursor must be positioned after the serialized extra
+         *            field (i.e., the entire entry must be read (if any))
+         *
+         * @return <b>true</b> in case of success, or <b>false</b> otherwise.
+         *
+         * @author Marcus Pinnecke
+         * @since 0.1.00.05
+         */
+        bool (*print_extra)(packer *self, FILE *file, memfile *src);
+
+        /**
+         * Reads an implementation-specific encoded string from a memory file <code>src</code>, and prints
+         * the encoded string in a human-readable version to <code>file</code>
+         *
+         * @param self A pointer to the compressor that is used; potentially accessing <code>extra</code>
+         * @param file A file to which a human-readable version of the encoded string is printed.
+         * @param src A memory file which cursor is positioned at the begin of the encoded string. After a call
+         *            to this function, the memory file cursor must be positioned after the encoded string (i.e.,
+         *            the entire encoded string must be read)
+         * @param decompressed_strlen The length of the decoded string in number of characters
+         *
+         * @return <b>true</b> in case of success, or <b>false</b> otherwise.
+         *
+         * @author Marcus Pinnecke
+         * @since 0.1.00.05
+         */
+        bool
+        (*print_encoded)(packer *self, FILE *file, memfile *src, u32 decompressed_strlen);
+} packer;
+
+static void pack_none_create(packer *strategy)
+{
+        strategy->tag = PACK_NONE;
+        strategy->create = pack_none_init;
+        strategy->cpy = pack_none_cpy;
+        strategy->drop = pack_none_drop;
+        strategy->write_extra = pack_none_write_extra;
+        strategy->read_extra = pack_none_read_extra;
+        strategy->encode_string = pack_none_encode_string;
+        strategy->decode_string = pack_none_decode_string;
+        strategy->print_extra = pack_none_print_extra;
+        strategy->print_encoded = pack_none_print_encoded_string;
+}
+
+static void pack_huffman_create(packer *strategy)
+{
+        strategy->tag = PACK_HUFFMAN;
+        strategy->create = pack_huffman_init;
+        strategy->cpy = pack_coding_huffman_cpy;
+        strategy->drop = pack_coding_huffman_drop;
+        strategy->write_extra = pack_huffman_write_extra;
+        strategy->read_extra = pack_huffman_read_extra;
+        strategy->encode_string = pack_huffman_encode_string;
+        strategy->decode_string = pack_huffman_decode_string;
+        strategy->print_extra = pack_huffman_print_extra;
+        strategy->print_encoded = pack_huffman_print_encoded;
+}
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-variable"
+
+static struct {
+        packer_e type;
+        const char *name;
+        void (*create)(packer *strategy);
+        u8 flag_bit;
+} global_pack_strategy_register[] =
+        {{.type = PACK_NONE, .name = "none", .create = pack_none_create, .flag_bit = 1 << 0},
+         {.type = PACK_HUFFMAN, .name = "huffman", .create = pack_huffman_create, .flag_bit = 1 << 1}};
+
+#pragma GCC diagnostic pop
+
+bool pack_cpy(packer *dst, const packer *src);
+bool pack_drop(packer *self);
+
+bool pack_by_type(packer *strategy, packer_e type);
+u8 pack_flagbit_by_type(packer_e type);
+bool pack_by_flags(packer *strategy, u8 flags);
+bool pack_by_name(packer_e *type, const char *name);
+
+bool pack_write_extra(packer *self, memfile *dst, const vec ofType (const char *) *strings);
+bool pack_read_extra(packer *self, FILE *src, size_t nbytes);
+bool pack_encode(packer *self, memfile *dst, const char *string);
+bool pack_decode(packer *self, char *dst, size_t strlen, FILE *src);
+bool pack_print_extra(packer *self, FILE *file, memfile *src);
+bool pack_print_encoded(packer *self, FILE *file, memfile *src, u32 decompressed_strlen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef COMPRESSOR_HUFFMAN_H
+#define COMPRESSOR_HUFFMAN_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/std/vec.h>
+#include <karbonit/mem/memfile.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool pack_huffman_init(packer *self);
+bool pack_coding_huffman_cpy(const packer *self, packer *dst);
+bool pack_coding_huffman_drop(packer *self);
+bool pack_huffman_write_extra(packer *self, memfile *dst, const vec ofType (const char *) *strings);
+bool pack_huffman_read_extra(packer *self, FILE *src, size_t nbytes);
+bool pack_huffman_print_extra(packer *self, FILE *file, memfile *src);
+bool pack_huffman_print_encoded(packer *self, FILE *file, memfile *src, u32 decompressed_strlen);
+bool pack_huffman_encode_string(packer *self, memfile *dst, const char *string);
+bool pack_huffman_decode_string(packer *self, char *dst, size_t strlen, FILE *src);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef COMPRESSOR_NONE_H
+#define COMPRESSOR_NONE_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/types.h>
+#include <karbonit/stdinc.h>
+#include <karbonit/std/vec.h>
+#include <karbonit/mem/memfile.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool pack_none_init(packer *self);
+bool pack_none_cpy(const packer *self, packer *dst);
+bool pack_none_drop(packer *self);
+bool pack_none_write_extra(packer *self, memfile *dst, const vec ofType (const char *) *strings);
+bool pack_none_read_extra(packer *self, FILE *src, size_t nbytes);
+bool pack_none_print_extra(packer *self, FILE *file, memfile *src);
+bool pack_none_print_encoded_string(packer *self, FILE *file, memfile *src, u32 decompressed_strlen);
+bool pack_none_encode_string(packer *self, memfile *dst, const char *string);
+bool pack_none_decode_string(packer *self, char *dst, size_t strlen, FILE *src);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef STRING_PRED_H
+#define STRING_PRED_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef bool (*string_pred_func_t)(size_t *idxs_matching, size_t *num_matching, char **strings, size_t num_strings, void *capture);
+
+typedef struct string_pred {
+        string_pred_func_t func;
+        i64 limit;
+} string_pred;
+
+BUILT_IN(static bool) string_pred_validate(const string_pred *pred)
+{
+        ERROR_IF_NOT_IMPLEMENTED(err, pred, func)
+        return true;
+}
+
+BUILT_IN(static bool) string_pred_eval(const string_pred *pred, size_t *idxs_matching,
+                                               size_t *num_matching, char **strings, size_t num_strings, void *capture)
+{
+        assert(pred);
+        assert(idxs_matching);
+        assert(num_matching);
+        assert(strings);
+        assert(pred->func);
+        return pred->func(idxs_matching, num_matching, strings, num_strings, capture);
+}
+
+BUILT_IN(static bool) string_pred_get_limit(i64 *limit, const string_pred *pred)
+{
+        *limit = pred->limit;
+        return true;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef STRING_PRED_CONTAINS_H
+#define STRING_PRED_CONTAINS_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/archive/pred.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+BUILT_IN(static bool) __string_pred_contains_func(size_t *idxs_matching, size_t *num_matching, char **strings, size_t num_strings, void *capture)
+{
+        size_t result_size = 0;
+        const char *needle = (const char *) capture;
+
+        for (size_t i = 0; i < num_strings; i++) {
+                if (strstr(strings[i], needle) != NULL) {
+                        idxs_matching[result_size++] = i;
+                }
+        }
+
+        *num_matching = result_size;
+
+        return true;
+}
+
+BUILT_IN(static bool)
+
+string_pred_contains_init(string_pred *pred)
+{
+        pred->limit = QUERY_LIMIT_NONE;
+        pred->func = __string_pred_contains_func;
+        return true;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef STRING_PRED_EQUALS_H
+#define STRING_PRED_EQUALS_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/archive/pred.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+BUILT_IN(static bool) __string_pred_equals_func(size_t *idxs_matching, size_t *num_matching, char **strings, size_t num_strings, void *capture)
+{
+        size_t result_size = 0;
+        const char *needle = (const char *) capture;
+
+        for (size_t i = 0; i < num_strings; i++) {
+                if (strstr(strings[i], needle) != NULL) {
+                        idxs_matching[result_size++] = i;
+                }
+        }
+
+        *num_matching = result_size;
+        return true;
+}
+
+BUILT_IN(static bool)
+
+string_pred_equals_init(string_pred *pred)
+{
+        pred->limit = QUERY_LIMIT_1;
+        pred->func = __string_pred_equals_func;
+        return true;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef QUERY_H
+#define QUERY_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/archive.h>
+#include <karbonit/archive/strid_it.h>
+#include <karbonit/archive/pred.h>
+#include <karbonit/std/hash/table.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct query {
+        archive *archive;
+        archive_io_context *context;
+} archive_query;
+
+bool query_create(query *query, archive *archive);
+bool query_drop(query *query);
+bool query_scan_strids(strid_iter *it, query *query);
+bool query_create_index_string_id_to_offset(struct sid_to_offset **index, query *query);
+void query_drop_index_string_id_to_offset(struct sid_to_offset *index);
+bool query_index_id_to_offset_serialize(FILE *file, struct sid_to_offset *index);
+bool query_index_id_to_offset_deserialize(struct sid_to_offset **index, const char *file_path, offset_t offset);
+char *query_fetch_string_by_id(query *query, archive_field_sid_t id);
+char *query_fetch_string_by_id_nocache(query *query, archive_field_sid_t id);
+char **query_fetch_strings_by_offset(query *query, offset_t *offs, u32 *strlens, size_t num_offs);
+archive_field_sid_t *query_find_ids(size_t *num_found, query *query, const string_pred *pred, void *capture, i64 limit);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef STRID_ITER_H
+#define STRID_ITER_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/types.h>
+#include <karbonit/archive.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct strid_info {
+        archive_field_sid_t id;
+        u32 strlen;
+        offset_t offset;
+} strid_info;
+
+typedef struct strid_iter {
+        FILE *disk_file;
+        bool is_open;
+        offset_t disk_offset;
+        strid_info vec[100000];
+} strid_iter;
+
+bool strid_iter_open(strid_iter *it, archive *archive);
+bool strid_iter_next(bool *success, strid_info **info, size_t *info_length, strid_iter *it);
+bool strid_iter_close(strid_iter *it);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ARCHIVE_VISITOR_H
+#define ARCHIVE_VISITOR_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/archive/it.h>
+
+typedef struct path_entry {
+        archive_field_sid_t key;
+        u32 idx;
+} path_entry;
+
+typedef struct archive_visitor_desc {
+        int visit_mask;                 /** bitmask of 'ARCHIVE_ITER_MASK_XXX' */
+} archive_visitor_desc;
+
+typedef enum visit_policy {
+        VISIT_INCLUDE, VISIT_EXCLUDE,
+} visit_policy_e;
+
+typedef const vec ofType(path_entry) *path_stack_t;
+
+#define DEFINE_VISIT_BASIC_TYPE_PAIRS(name, built_in_type)                                                             \
+void (*visit_##name##_pairs) (archive *archive, path_stack_t path, unique_id_t id,                              \
+                              const archive_field_sid_t *keys, const built_in_type *values, u32 num_pairs,                     \
+                              void *capture);
+
+#define DEFINE_VISIT_ARRAY_TYPE_PAIRS(name, built_in_type)                                                             \
+visit_policy_e (*visit_enter_##name##_array_pairs)(archive *archive, path_stack_t path,                      \
+                                                        unique_id_t id, const archive_field_sid_t *keys,                       \
+                                                        u32 num_pairs,                                                 \
+                                                        void *capture);                                                \
+                                                                                                                       \
+void (*visit_enter_##name##_array_pair)(archive *archive, path_stack_t path, unique_id_t id,                    \
+                                        archive_field_sid_t key, u32 entry_idx, u32 num_elems,                                 \
+                                        void *capture);                                                                \
+                                                                                                                       \
+void (*visit_##name##_array_pair) (archive *archive, path_stack_t path, unique_id_t id,                         \
+                                   archive_field_sid_t key, u32 entry_idx, u32 max_entries,                                    \
+                                   const built_in_type *array, u32 array_length, void *capture);                       \
+                                                                                                                       \
+void (*visit_leave_##name##_array_pair)(archive *archive, path_stack_t path, unique_id_t id,                    \
+                                        u32 pair_idx, u32 num_pairs, void *capture);                                   \
+                                                                                                                       \
+void (*visit_leave_##name##_array_pairs)(archive *archive, path_stack_t path, unique_id_t id,                   \
+                                         void *capture);
+
+#define DEFINE_VISIT_OBJECT_ARRAY_OBJECT_PROP(name, built_in_type)                                                     \
+    void (*visit_object_array_object_property_##name)(archive *archive, path_stack_t path,                      \
+                                               unique_id_t parent_id,                                                  \
+                                               archive_field_sid_t key,                                                        \
+                                               unique_id_t nested_object_id,                                           \
+                                               archive_field_sid_t nested_key,                                                 \
+                                               const built_in_type *nested_values,                                     \
+                                               u32 num_nested_values, void *capture);
+
+typedef struct visitor {
+        void (*visit_root_object)(archive *archive, unique_id_t id, void *capture);
+        void (*before_visit_starts)(archive *archive, void *capture);
+        void (*after_visit_ends)(archive *archive, void *capture);
+        visit_policy_e (*before_object_visit)(archive *archive, path_stack_t path, unique_id_t parent_id, unique_id_t value_id, u32 object_idx, u32 num_objects, archive_field_sid_t key, void *capture);
+        void (*after_object_visit)(archive *archive, path_stack_t path, unique_id_t id, u32 object_idx, u32 num_objects, void *capture);
+        void (*first_prop_type_group)(archive *archive, path_stack_t path, unique_id_t id, const archive_field_sid_t *keys, enum archive_field_type type, bool is_array, u32 num_pairs, void *capture);
+        void (*next_prop_type_group)(archive *archive, path_stack_t path, unique_id_t id, const archive_field_sid_t *keys, enum archive_field_type type, bool is_array, u32 num_pairs, void *capture);
+        void (*visit_null_pairs)(archive *archive, path_stack_t path, unique_id_t id, const archive_field_sid_t *keys, u32 num_pairs, void *capture);
+
+        DEFINE_VISIT_BASIC_TYPE_PAIRS(int8, archive_field_i8_t);
+        DEFINE_VISIT_BASIC_TYPE_PAIRS(int16, archive_field_i16_t);
+        DEFINE_VISIT_BASIC_TYPE_PAIRS(int32, archive_field_i32_t);
+        DEFINE_VISIT_BASIC_TYPE_PAIRS(int64, archive_field_i64_t);
+        DEFINE_VISIT_BASIC_TYPE_PAIRS(uint8, archive_field_u8_t);
+        DEFINE_VISIT_BASIC_TYPE_PAIRS(uint16, archive_field_u16_t);
+        DEFINE_VISIT_BASIC_TYPE_PAIRS(uint32, archive_field_u32_t);
+        DEFINE_VISIT_BASIC_TYPE_PAIRS(uint64, archive_field_u64_t);
+        DEFINE_VISIT_BASIC_TYPE_PAIRS(number, archive_field_number_t);
+        DEFINE_VISIT_BASIC_TYPE_PAIRS(string, archive_field_sid_t);
+        DEFINE_VISIT_BASIC_TYPE_PAIRS(boolean, archive_field_boolean_t);
+        DEFINE_VISIT_ARRAY_TYPE_PAIRS(int8, archive_field_i8_t);
+        DEFINE_VISIT_ARRAY_TYPE_PAIRS(int16, archive_field_i16_t);
+        DEFINE_VISIT_ARRAY_TYPE_PAIRS(int32, archive_field_i32_t);
+        DEFINE_VISIT_ARRAY_TYPE_PAIRS(int64, archive_field_i64_t);
+        DEFINE_VISIT_ARRAY_TYPE_PAIRS(uint8, archive_field_u8_t);
+        DEFINE_VISIT_ARRAY_TYPE_PAIRS(uint16, archive_field_u16_t);
+        DEFINE_VISIT_ARRAY_TYPE_PAIRS(uint32, archive_field_u32_t);
+        DEFINE_VISIT_ARRAY_TYPE_PAIRS(uint64, archive_field_u64_t);
+        DEFINE_VISIT_ARRAY_TYPE_PAIRS(number, archive_field_number_t);
+        DEFINE_VISIT_ARRAY_TYPE_PAIRS(string, archive_field_sid_t);
+        DEFINE_VISIT_ARRAY_TYPE_PAIRS(boolean, archive_field_boolean_t);
+
+        visit_policy_e (*visit_enter_null_array_pairs)(archive *archive, path_stack_t path, unique_id_t id, const archive_field_sid_t *keys, u32 num_pairs, void *capture);
+        void (*visit_enter_null_array_pair)(archive *archive, path_stack_t path, unique_id_t id, archive_field_sid_t key, u32 entry_idx, u32 num_elems, void *capture);
+        void (*visit_null_array_pair)(archive *archive, path_stack_t path, unique_id_t id, archive_field_sid_t key, u32 entry_idx, u32 max_entries, archive_field_u32_t num_nulls, void *capture);
+        void (*visit_leave_null_array_pair)(archive *archive, path_stack_t path, unique_id_t id, u32 pair_idx, u32 num_pairs, void *capture);
+        void (*visit_leave_null_array_pairs)(archive *archive, path_stack_t path, unique_id_t id, void *capture);
+        visit_policy_e (*before_visit_object_array)(archive *archive, path_stack_t path, unique_id_t parent_id, archive_field_sid_t key, void *capture);
+        void (*before_visit_object_array_objects)(bool *skip_group_object_ids, archive *archive, path_stack_t path, unique_id_t parent_id, archive_field_sid_t key, const unique_id_t *group_object_ids, u32 num_group_object_ids, void *capture);
+        visit_policy_e (*before_visit_object_array_object_property)(archive *archive, path_stack_t path, unique_id_t parent_id, archive_field_sid_t key, archive_field_sid_t nested_key, enum archive_field_type nested_value_type, void *capture);
+
+        DEFINE_VISIT_OBJECT_ARRAY_OBJECT_PROP(int8s, archive_field_i8_t);
+        DEFINE_VISIT_OBJECT_ARRAY_OBJECT_PROP(int16s, archive_field_i16_t);
+        DEFINE_VISIT_OBJECT_ARRAY_OBJECT_PROP(int32s, archive_field_i32_t);
+        DEFINE_VISIT_OBJECT_ARRAY_OBJECT_PROP(int64s, archive_field_i64_t);
+        DEFINE_VISIT_OBJECT_ARRAY_OBJECT_PROP(uint8s, archive_field_u8_t);
+        DEFINE_VISIT_OBJECT_ARRAY_OBJECT_PROP(uint16s, archive_field_u16_t);
+        DEFINE_VISIT_OBJECT_ARRAY_OBJECT_PROP(uint32s, archive_field_u32_t);
+        DEFINE_VISIT_OBJECT_ARRAY_OBJECT_PROP(uint64s, archive_field_u64_t);
+        DEFINE_VISIT_OBJECT_ARRAY_OBJECT_PROP(numbers, archive_field_number_t);
+        DEFINE_VISIT_OBJECT_ARRAY_OBJECT_PROP(strings, archive_field_sid_t);
+        DEFINE_VISIT_OBJECT_ARRAY_OBJECT_PROP(booleans, archive_field_boolean_t);
+        DEFINE_VISIT_OBJECT_ARRAY_OBJECT_PROP(nulls, archive_field_u32_t);
+
+        visit_policy_e (*before_object_array_object_property_object)(archive *archive, path_stack_t path, unique_id_t parent_id, archive_field_sid_t key, unique_id_t nested_object_id, archive_field_sid_t nested_key, u32 nested_value_object_id, void *capture);
+        void (*visit_object_property)(archive *archive, path_stack_t path, unique_id_t parent_id, archive_field_sid_t key, enum archive_field_type type, bool is_array_type, void *capture);
+        void (*visit_object_array_prop)(archive *archive, path_stack_t path, unique_id_t parent_id, archive_field_sid_t key, enum archive_field_type type, void *capture);
+        bool (*get_column_entry_count)(archive *archive, path_stack_t path, archive_field_sid_t key, enum archive_field_type type, u32 count, void *capture);
+} archive_visitor;
+
+bool archive_visit_archive(archive *archive, const archive_visitor_desc *desc, visitor *visitor, void *capture);
+bool archive_visitor_print_path(FILE *file, archive *archive, const vec ofType(path_entry) *path_stack);
+void archive_visitor_path_to_string(char path_buffer[2048], archive *archive, const vec ofType(path_entry) *path_stack);
+bool archive_visitor_path_compare(const vec ofType(path_entry) *path, archive_field_sid_t *group_name, const char *path_str, archive *archive);
+
+#endif
+/*
+ * abstract - abstract container implementations
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_ABSTRACT_H
+#define HAD_ABSTRACT_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/types.h>
+#include <karbonit/carbon/markers.h>
+#include <karbonit/carbon/container.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  abstract type class (base or derived)
+// ---------------------------------------------------------------------------------------------------------------------
+
+/** derivation type of any abstract type */
+typedef enum abstract {
+        /** Does not need further treatment to guarantee properties (unsorted, and not duplicate-free) */
+        ABSTRACT_BASE,
+        /** particular abstract type with further properties (such as uniqueness of contained elements), enabling the
+        * application to check certain promises and guarantees */
+        ABSTRACT_DERIVED,
+        ABSTRACT_ERR
+} abstract_e;
+
+
+
+#define __abstract_is_instanceof(marker, T)                             \
+        (abstract_get_container_subtype((marker)) == (T))
+
+#define abstract_type(marker)                                                                                           \
+({                                                                                          \
+        derived_e abstract_type_derived = abstract_get_derived_type(marker);                                                                                          \
+        abstract_e abstract_type_ret;                                                                                          \
+        switch (abstract_type_derived) {                                                                                          \
+                case UNSORTED_MULTIMAP:                                                                                          \
+                case UNSORTED_MULTISET_ARRAY:                                                                                          \
+                case UNSORTED_MULTISET_COL_U8:                                                                                          \
+                case UNSORTED_MULTISET_COL_U16:                                                                                          \
+                case UNSORTED_MULTISET_COL_U32:                                                                                          \
+                case UNSORTED_MULTISET_COL_U64:                                                                                          \
+                case UNSORTED_MULTISET_COL_I8:                                                                                          \
+                case UNSORTED_MULTISET_COL_I16:                                                                                          \
+                case UNSORTED_MULTISET_COL_I32:                                                                                          \
+                case UNSORTED_MULTISET_COL_I64:                                                                                          \
+                case UNSORTED_MULTISET_COL_FLOAT:                                                                                          \
+                case UNSORTED_MULTISET_COL_BOOLEAN:                                                                                          \
+                        abstract_type_ret = ABSTRACT_BASE;                                                                                          \
+                        break;                                                                                          \
+                case SORTED_MULTIMAP:                                                                                          \
+                case UNSORTED_MAP:                                                                                          \
+                case SORTED_MAP:                                                                                          \
+                case SORTED_MULTISET_ARRAY:                                                                                          \
+                case UNSORTED_SET_ARRAY:                                                                                          \
+                case SORTED_SET_ARRAY:                                                                                          \
+                case SORTED_MULTISET_COL_U8:                                                                                          \
+                case UNSORTED_SET_COL_U8:                                                                                          \
+                case SORTED_SET_COL_U8:                                                                                          \
+                case SORTED_MULTISET_COL_U16:                                                                                          \
+                case UNSORTED_SET_COL_U16:                                                                                          \
+                case SORTED_SET_COL_U16:                                                                                          \
+                case SORTED_MULTISET_COL_U32:                                                                                          \
+                case UNSORTED_SET_COL_U32:                                                                                          \
+                case SORTED_SET_COL_U32:                                                                                          \
+                case SORTED_MULTISET_COL_U64:                                                                                          \
+                case UNSORTED_SET_COL_U64:                                                                                          \
+                case SORTED_SET_COL_U64:                                                                                          \
+                case SORTED_MULTISET_COL_I8:                                                                                          \
+                case UNSORTED_SET_COL_I8:                                                                                          \
+                case SORTED_SET_COL_I8:                                                                                          \
+                case SORTED_MULTISET_COL_I16:                                                                                          \
+                case UNSORTED_SET_COL_I16:                                                                                          \
+                case SORTED_SET_COL_I16:                                                                                          \
+                case SORTED_MULTISET_COL_I32:                                                                                          \
+                case UNSORTED_SET_COL_I32:                                                                                          \
+                case SORTED_SET_COL_I32:                                                                                          \
+                case SORTED_MULTISET_COL_I64:                                                                                          \
+                case UNSORTED_SET_COL_I64:                                                                                          \
+                case SORTED_SET_COL_I64:                                                                                          \
+                case SORTED_MULTISET_COL_FLOAT:                                                                                          \
+                case UNSORTED_SET_COL_FLOAT:                                                                                          \
+                case SORTED_SET_COL_FLOAT:                                                                                          \
+                case SORTED_MULTISET_COL_BOOLEAN:                                                                                          \
+                case UNSORTED_SET_COL_BOOLEAN:                                                                                          \
+                case SORTED_SET_COL_BOOLEAN:                                                                                          \
+                        abstract_type_ret = ABSTRACT_DERIVED;                                                                                          \
+                        break;                                                                                          \
+                default: PANIC(ERR_MARKERMAPPING);                                                                                          \
+                        abstract_type_ret = ABSTRACT_ERR;                                                                                          \
+                        break;                                                                  \
+        }                                                                                          \
+        abstract_type_ret;                                                                                          \
+})
+
+#define abstract_is_multiset(type)                                                                                     \
+        (type == TYPE_UNSORTED_MULTISET || type == TYPE_SORTED_MULTISET)
+
+#define abstract_is_base(marker)                                                        \
+({                                                        \
+        abstract_e abstract_is_type = abstract_type(marker);                                                        \
+        (abstract_is_type == ABSTRACT_BASE);                                                        \
+})
+
+
+
+#define abstract_is_derived(marker)                                                             \
+        (!abstract_is_base(marker));
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  abstract type (multiset, set, sorted or unsorted)
+// ---------------------------------------------------------------------------------------------------------------------
+
+/** class of an abstract type independent of a particular abstract derived container */
+typedef enum abstract_type_class {
+        /** abstract base types */
+        TYPE_UNSORTED_MULTISET,     /** element type: values, distinct elements: no, sorted: no */
+        TYPE_UNSORTED_MULTIMAP,     /** element type: pairs, distinct elements: no, sorted: no */
+
+        /** derived abstract types */
+        TYPE_SORTED_MULTISET,       /** element type: values, distinct elements: no, sorted: yes */
+        TYPE_UNSORTED_SET,          /** element type: values, distinct elements: yes, sorted: no */
+        TYPE_SORTED_SET,            /** element type: values, distinct elements: yes, sorted: yes */
+        TYPE_SORTED_MAP,            /** element type: pairs, distinct elements: yes, sorted: yes */
+        TYPE_SORTED_MULTIMAP,       /** element type: pairs, distinct elements: no, sorted: yes */
+        TYPE_UNSORTED_MAP,          /** element type: pairs, distinct elements: yes, sorted: no */
+
+        TYPE_ERR
+} abstract_type_class_e;
+
+#define abstract_get_class(marker)                                                                              \
+({                                                                              \
+        abstract_type_class_e abstract_get_class_ret;                                                                              \
+        derived_e derived = abstract_get_derived_type(marker);                                                                              \
+        switch (derived) {                                                                              \
+                case SORTED_MAP:                                                                              \
+                        abstract_get_class_ret = TYPE_SORTED_MAP;                                                                              \
+                        break;                                                                              \
+                case SORTED_MULTIMAP:                                                                              \
+                        abstract_get_class_ret = TYPE_SORTED_MULTIMAP;                                                                              \
+                        break;                                                                              \
+                case SORTED_MULTISET_ARRAY:                                                                              \
+                case SORTED_MULTISET_COL_BOOLEAN:                                                                              \
+                case SORTED_MULTISET_COL_FLOAT:                                                                              \
+                case SORTED_MULTISET_COL_I16:                                                                              \
+                case SORTED_MULTISET_COL_I32:                                                                              \
+                case SORTED_MULTISET_COL_I64:                                                                              \
+                case SORTED_MULTISET_COL_I8:                                                                              \
+                case SORTED_MULTISET_COL_U16:                                                                              \
+                case SORTED_MULTISET_COL_U32:                                                                              \
+                case SORTED_MULTISET_COL_U64:                                                                              \
+                case SORTED_MULTISET_COL_U8:                                                                              \
+                        abstract_get_class_ret = TYPE_SORTED_MULTISET;                                                                              \
+                        break;                                                                              \
+                case SORTED_SET_ARRAY:                                                                              \
+                case SORTED_SET_COL_BOOLEAN:                                                                              \
+                case SORTED_SET_COL_FLOAT:                                                                              \
+                case SORTED_SET_COL_I16:                                                                              \
+                case SORTED_SET_COL_I32:                                                                              \
+                case SORTED_SET_COL_I64:                                                                              \
+                case SORTED_SET_COL_I8:                                                                              \
+                case SORTED_SET_COL_U16:                                                                              \
+                case SORTED_SET_COL_U32:                                                                              \
+                case SORTED_SET_COL_U64:                                                                              \
+                case SORTED_SET_COL_U8:                                                                              \
+                        abstract_get_class_ret = TYPE_SORTED_SET;                                                                              \
+                        break;                                                                              \
+                case UNSORTED_MAP:                                                                              \
+                        abstract_get_class_ret = TYPE_UNSORTED_MAP;                                                                              \
+                        break;                                                                              \
+                case UNSORTED_MULTIMAP:                                                                              \
+                        abstract_get_class_ret = TYPE_UNSORTED_MULTIMAP;                                                                              \
+                        break;                                                                              \
+                case UNSORTED_MULTISET_ARRAY:                                                                              \
+                case UNSORTED_MULTISET_COL_BOOLEAN:                                                                              \
+                case UNSORTED_MULTISET_COL_FLOAT:                                                                              \
+                case UNSORTED_MULTISET_COL_I16:                                                                              \
+                case UNSORTED_MULTISET_COL_I32:                                                                              \
+                case UNSORTED_MULTISET_COL_I64:                                                                              \
+                case UNSORTED_MULTISET_COL_I8:                                                                              \
+                case UNSORTED_MULTISET_COL_U16:                                                                              \
+                case UNSORTED_MULTISET_COL_U32:                                                                              \
+                case UNSORTED_MULTISET_COL_U64:                                                                              \
+                case UNSORTED_MULTISET_COL_U8:                                                                              \
+                        abstract_get_class_ret = TYPE_UNSORTED_MULTISET;                                                                              \
+                        break;                                                                              \
+                case UNSORTED_SET_ARRAY:                                                                              \
+                case UNSORTED_SET_COL_BOOLEAN:                                                                              \
+                case UNSORTED_SET_COL_FLOAT:                                                                              \
+                case UNSORTED_SET_COL_I16:                                                                              \
+                case UNSORTED_SET_COL_I32:                                                                              \
+                case UNSORTED_SET_COL_I64:                                                                              \
+                case UNSORTED_SET_COL_I8:                                                                              \
+                case UNSORTED_SET_COL_U16:                                                                              \
+                case UNSORTED_SET_COL_U32:                                                                              \
+                case UNSORTED_SET_COL_U64:                                                                              \
+                case UNSORTED_SET_COL_U8:                                                                              \
+                        abstract_get_class_ret = TYPE_UNSORTED_SET;                                                                              \
+                        break;                                                                              \
+                default: PANIC(ERR_MARKERMAPPING);                                                                              \
+        }                                                                              \
+        abstract_get_class_ret;                                 \
+})
+
+#define abstract_is_set(type)                                           \
+        (type == TYPE_UNSORTED_SET || type == TYPE_SORTED_SET)
+
+
+#define abstract_is_multimap(type)                                           \
+        (type == TYPE_UNSORTED_MULTIMAP || type == TYPE_SORTED_MULTIMAP)
+
+#define abstract_is_map(type)                                           \
+        (type == TYPE_SORTED_MAP || type == TYPE_UNSORTED_MAP)
+
+
+#define abstract_is_sorted(type)                                           \
+        (type == TYPE_SORTED_MULTISET || type == TYPE_SORTED_SET ||                                            \
+         type == TYPE_SORTED_MAP || type == TYPE_SORTED_MULTIMAP)
+
+#define abstract_is_distinct(type)                                                                                     \
+        (type == TYPE_UNSORTED_SET || type == TYPE_SORTED_SET || type == TYPE_SORTED_MAP || type == TYPE_UNSORTED_MAP)
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  derived type (actual abstract type and which container is used)
+// ---------------------------------------------------------------------------------------------------------------------
+
+/** particular abstract derived type container (with marker) */
+typedef enum {
+        /** abstract types for object containers */
+        UNSORTED_MULTIMAP = MUNSORTED_MULTIMAP,
+        SORTED_MULTIMAP = MSORTED_MULTIMAP,
+        UNSORTED_MAP = MUNSORTED_MAP,
+        SORTED_MAP = MSORTED_MAP,
+
+        /** abstract types for array containers */
+        UNSORTED_MULTISET_ARRAY = MUNSORTED_MULTISET_ARR,
+        SORTED_MULTISET_ARRAY = MSORTED_MULTISET_ARR,
+        UNSORTED_SET_ARRAY = MUNSORTED_SET_ARR,
+        SORTED_SET_ARRAY = MSORTED_SET_ARR,
+
+        /** abstract types for column-u8 containers */
+        UNSORTED_MULTISET_COL_U8 = MUNSORTED_MULTISET_U8,
+        SORTED_MULTISET_COL_U8 = MSORTED_MULTISET_U8,
+        UNSORTED_SET_COL_U8 = MUNSORTED_SET_U8,
+        SORTED_SET_COL_U8 = MSORTED_SET_U8,
+
+        /** abstract types for column-u16 containers */
+        UNSORTED_MULTISET_COL_U16 = MUNSORTED_MULTISET_U16,
+        SORTED_MULTISET_COL_U16 = MSORTED_MULTISET_U16,
+        UNSORTED_SET_COL_U16 = MUNSORTED_SET_U16,
+        SORTED_SET_COL_U16 = MSORTED_SET_U16,
+
+        /** abstract types for column-u32 containers */
+        UNSORTED_MULTISET_COL_U32 = MUNSORTED_MULTISET_U32,
+        SORTED_MULTISET_COL_U32 = MSORTED_MULTISET_U32,
+        UNSORTED_SET_COL_U32 = MUNSORTED_SET_U32,
+        SORTED_SET_COL_U32 = MSORTED_SET_U32,
+
+        /** abstract types for column-u64 containers */
+        UNSORTED_MULTISET_COL_U64 = MUNSORTED_MULTISET_U64,
+        SORTED_MULTISET_COL_U64 = MSORTED_MULTISET_U64,
+        UNSORTED_SET_COL_U64 = MUNSORTED_SET_U64,
+        SORTED_SET_COL_U64 = MSORTED_SET_U64,
+
+        /** abstract types for column-i8 containers */
+        UNSORTED_MULTISET_COL_I8 = MUNSORTED_MULTISET_I8,
+        SORTED_MULTISET_COL_I8 = MSORTED_MULTISET_I8,
+        UNSORTED_SET_COL_I8 = MUNSORTED_SET_I8,
+        SORTED_SET_COL_I8 = MSORTED_SET_I8,
+
+        /** abstract types for column-i16 containers */
+        UNSORTED_MULTISET_COL_I16 = MUNSORTED_MULTISET_I16,
+        SORTED_MULTISET_COL_I16 = MSORTED_MULTISET_I16,
+        UNSORTED_SET_COL_I16 = MUNSORTED_SET_I16,
+        SORTED_SET_COL_I16 = MSORTED_SET_I16,
+
+        /** abstract types for column-i32 containers */
+        UNSORTED_MULTISET_COL_I32 = MUNSORTED_MULTISET_I32,
+        SORTED_MULTISET_COL_I32 = MSORTED_MULTISET_I32,
+        UNSORTED_SET_COL_I32 = MUNSORTED_SET_I32,
+        SORTED_SET_COL_I32 = MSORTED_SET_I32,
+
+        /** abstract types for column-i64 containers */
+        UNSORTED_MULTISET_COL_I64 = MUNSORTED_MULTISET_I64,
+        SORTED_MULTISET_COL_I64 = MSORTED_MULTISET_I64,
+        UNSORTED_SET_COL_I64 = MUNSORTED_SET_I64,
+        SORTED_SET_COL_I64 = MSORTED_SET_I64,
+
+        /** abstract types for column-float containers */
+        UNSORTED_MULTISET_COL_FLOAT = MUNSORTED_MULTISET_FLOAT,
+        SORTED_MULTISET_COL_FLOAT = MSORTED_MULTISET_FLOAT,
+        UNSORTED_SET_COL_FLOAT = MUNSORTED_SET_FLOAT,
+        SORTED_SET_COL_FLOAT = MSORTED_SET_FLOAT,
+
+        /** abstract types for column-boolean containers */
+        UNSORTED_MULTISET_COL_BOOLEAN = MUNSORTED_MULTISET_BOOLEAN,
+        SORTED_MULTISET_COL_BOOLEAN = MSORTED_MULTISET_BOOLEAN,
+        UNSORTED_SET_COL_BOOLEAN = MUNSORTED_SET_BOOLEAN,
+        SORTED_SET_COL_BOOLEAN = MSORTED_SET_BOOLEAN,
+
+        DERIVED_ERR
+} derived_e;
+
+/** derivable types for a list container (column or array) */
+typedef enum list_type
+{
+        /** the container type that implements the list */
+        LIST_UNSORTED_MULTISET,
+        /** mark list as sorted */
+        LIST_SORTED_MULTISET,
+        /** mark list as non-distinct */
+        LIST_UNSORTED_SET,
+        /** mark list as sorted and distinct */
+        LIST_SORTED_SET,
+        LIST_ERR
+} list_type_e;
+
+/** derivable types for a map container (object) */
+typedef enum map_type
+{
+        /** the container type that implements the map */
+        MAP_UNSORTED_MULTIMAP = MUNSORTED_MULTIMAP,
+        /** mark map as sorted */
+        MAP_SORTED_MULTIMAP = MSORTED_MULTIMAP,
+        /** mark map as non-distinct */
+        MAP_UNSORTED_MAP = MUNSORTED_MAP,
+        /** mark map as sorted and non-distinct */
+        MAP_SORTED_MAP = MSORTED_MAP
+} map_type_e;
+
+#define abstract_class_to_list_derivable(in)                                                            \
+({                                                            \
+        list_type_e abstract_class_to_list_derivable_ret;                                                            \
+        switch (in) {                                                            \
+                case TYPE_UNSORTED_MULTISET:                                                            \
+                        abstract_class_to_list_derivable_ret = LIST_UNSORTED_MULTISET;                                                            \
+                        break;                                                            \
+                case TYPE_SORTED_MULTISET:                                                            \
+                        abstract_class_to_list_derivable_ret = LIST_SORTED_MULTISET;                                                            \
+                        break;                                                            \
+                case TYPE_UNSORTED_SET:                                                            \
+                        abstract_class_to_list_derivable_ret = LIST_UNSORTED_SET;                                                            \
+                        break;                                                            \
+                case TYPE_SORTED_SET:                                                            \
+                        abstract_class_to_list_derivable_ret = LIST_SORTED_SET;                                                            \
+                        break;                                                            \
+                default:                                                            \
+                        ERROR(ERR_TYPEMISMATCH, "abstract class type does not encode a list type");                                                            \
+                        abstract_class_to_list_derivable_ret = LIST_ERR;                                                            \
+                        break;                                                            \
+        }                                                            \
+        abstract_class_to_list_derivable_ret;                                                            \
+})
+
+#define abstract_list_derivable_to_class(in)                                                            \
+({                                                            \
+        abstract_type_class_e abstract_list_derivable_to_class_ret;                                                            \
+        switch (in) {                                                            \
+                case LIST_UNSORTED_MULTISET:                                                            \
+                        abstract_list_derivable_to_class_ret = TYPE_UNSORTED_MULTISET;                                                            \
+                        break;                                                            \
+                case LIST_SORTED_MULTISET:                                                            \
+                        abstract_list_derivable_to_class_ret = TYPE_SORTED_MULTISET;                                                            \
+                        break;                                                            \
+                case LIST_UNSORTED_SET:                                                            \
+                        abstract_list_derivable_to_class_ret = TYPE_UNSORTED_SET;                                                            \
+                        break;                                                            \
+                case LIST_SORTED_SET:                                                            \
+                        abstract_list_derivable_to_class_ret = TYPE_SORTED_SET;                                                            \
+                        break;                                                            \
+                default:                                                            \
+                        ERROR(ERR_TYPEMISMATCH, "abstract class type does not encode a list type");                                                            \
+                        abstract_list_derivable_to_class_ret = TYPE_ERR;                                                            \
+                        break;                                                            \
+        }                                                            \
+        abstract_list_derivable_to_class_ret;                                                            \
+})
+
+#define abstract_map_derivable_to_class(in)                                                            \
+({                                                            \
+        abstract_type_class_e abstract_map_derivable_to_class_ret;                                                            \
+        switch (in) {                                                            \
+                case MAP_UNSORTED_MULTIMAP:                                                            \
+                        abstract_map_derivable_to_class_ret = TYPE_UNSORTED_MULTIMAP;                                                            \
+                        break;                                                            \
+                case MAP_SORTED_MULTIMAP:                                                            \
+                        abstract_map_derivable_to_class_ret = TYPE_SORTED_MULTIMAP;                                                            \
+                        break;                                                            \
+                case MAP_UNSORTED_MAP:                                                            \
+                        abstract_map_derivable_to_class_ret = TYPE_UNSORTED_MAP;                                                            \
+                        break;                                                            \
+                case MAP_SORTED_MAP:                                                            \
+                        abstract_map_derivable_to_class_ret = TYPE_SORTED_MAP;                                                            \
+                        break;                                                            \
+                default:                                                            \
+                        ERROR(ERR_TYPEMISMATCH, "abstract class type does not encode a map type");                                                            \
+                        abstract_map_derivable_to_class_ret = TYPE_ERR;                                                            \
+                        break;                                                            \
+        }                                                            \
+        abstract_map_derivable_to_class_ret;                                                            \
+})
+
+#define abstract_write_base_type(memfile, type)                                                                        \
+{                                                                        \
+        sub_type_e abstract_write_base_type_type = type;                                                                        \
+        MEMFILE_WRITE((memfile), &abstract_write_base_type_type, sizeof(u8));                                                                        \
+}
+
+#define abstract_write_derived_type(memfile, type)                      \
+{                                                               \
+        derived_e abstract_write_derived_type_type = (type);                                                            \
+        MEMFILE_WRITE((memfile), &abstract_write_derived_type_type, sizeof(u8));                  \
+}
+
+#define abstract_get_container_subtype(marker)                                                              \
+({                                                              \
+        sub_type_e abstract_get_container_subtype_ret;                                                              \
+        switch (marker) {                                                              \
+                /** abstract types for object containers */                                                              \
+                case UNSORTED_MULTIMAP:                                                              \
+                case SORTED_MULTIMAP:                                                              \
+                case UNSORTED_MAP:                                                              \
+                case SORTED_MAP:                                                              \
+                        abstract_get_container_subtype_ret = CONTAINER_OBJECT;                                                              \
+                        break;                                                              \
+                        /** abstract types for array containers */                                                              \
+                case UNSORTED_MULTISET_ARRAY:                                                              \
+                case SORTED_MULTISET_ARRAY:                                                              \
+                case UNSORTED_SET_ARRAY:                                                              \
+                case SORTED_SET_ARRAY:                                                              \
+                        abstract_get_container_subtype_ret = CONTAINER_ARRAY;                                                              \
+                        break;                                                              \
+                        /** abstract types for column-u8 containers */                                                              \
+                case UNSORTED_MULTISET_COL_U8:                                                              \
+                case SORTED_MULTISET_COL_U8:                                                              \
+                case UNSORTED_SET_COL_U8:                                                              \
+                case SORTED_SET_COL_U8:                                                              \
+                        abstract_get_container_subtype_ret = CONTAINER_COLUMN_U8;                                                              \
+                        break;                                                              \
+                        /** abstract types for column-u16 containers */                                                              \
+                case UNSORTED_MULTISET_COL_U16:                                                              \
+                case SORTED_MULTISET_COL_U16:                                                              \
+                case UNSORTED_SET_COL_U16:                                                              \
+                case SORTED_SET_COL_U16:                                                              \
+                        abstract_get_container_subtype_ret = CONTAINER_COLUMN_U16;                                                              \
+                        break;                                                              \
+                        /** abstract types for column-u32 containers */                                                              \
+                case UNSORTED_MULTISET_COL_U32:                                                              \
+                case SORTED_MULTISET_COL_U32:                                                              \
+                case UNSORTED_SET_COL_U32:                                                              \
+                case SORTED_SET_COL_U32:                                                              \
+                        abstract_get_container_subtype_ret = CONTAINER_COLUMN_U32;                                                              \
+                        break;                                                              \
+                        /** abstract types for column-u64 containers */                                                              \
+                case UNSORTED_MULTISET_COL_U64:                                                              \
+                case SORTED_MULTISET_COL_U64:                                                              \
+                case UNSORTED_SET_COL_U64:                                                              \
+                case SORTED_SET_COL_U64:                                                              \
+                        abstract_get_container_subtype_ret = CONTAINER_COLUMN_U64;                                                              \
+                        break;                                                              \
+                        /** abstract types for column-i8 containers */                                                              \
+                case UNSORTED_MULTISET_COL_I8:                                                              \
+                case SORTED_MULTISET_COL_I8:                                                              \
+                case UNSORTED_SET_COL_I8:                                                              \
+                case SORTED_SET_COL_I8:                                                              \
+                        abstract_get_container_subtype_ret = CONTAINER_COLUMN_I8;                                                              \
+                        break;                                                              \
+                        /** abstract types for column-i16 containers */                                                              \
+                case UNSORTED_MULTISET_COL_I16:                                                              \
+                case SORTED_MULTISET_COL_I16:                                                              \
+                case UNSORTED_SET_COL_I16:                                                              \
+                case SORTED_SET_COL_I16:                                                              \
+                        abstract_get_container_subtype_ret = CONTAINER_COLUMN_I16;                                                              \
+                        break;                                                              \
+                        /** abstract types for column-i32 containers */                                                              \
+                case UNSORTED_MULTISET_COL_I32:                                                              \
+                case SORTED_MULTISET_COL_I32:                                                              \
+                case UNSORTED_SET_COL_I32:                                                              \
+                case SORTED_SET_COL_I32:                                                              \
+                        abstract_get_container_subtype_ret = CONTAINER_COLUMN_I32;                                                              \
+                        break;                                                              \
+                        /** abstract types for column-i64 containers */                                                              \
+                case UNSORTED_MULTISET_COL_I64:                                                              \
+                case SORTED_MULTISET_COL_I64:                                                              \
+                case UNSORTED_SET_COL_I64:                                                              \
+                case SORTED_SET_COL_I64:                                                              \
+                        abstract_get_container_subtype_ret = CONTAINER_COLUMN_I64;                                                              \
+                        break;                                                              \
+                        /** abstract types for column-float containers */                                                              \
+                case UNSORTED_MULTISET_COL_FLOAT:                                                              \
+                case SORTED_MULTISET_COL_FLOAT:                                                              \
+                case UNSORTED_SET_COL_FLOAT:                                                              \
+                case SORTED_SET_COL_FLOAT:                                                              \
+                        abstract_get_container_subtype_ret = CONTAINER_COLUMN_FLOAT;                                                              \
+                        break;                                                              \
+                        /** abstract types for column-boolean containers */                                                              \
+                case UNSORTED_MULTISET_COL_BOOLEAN:                                                              \
+                case SORTED_MULTISET_COL_BOOLEAN:                                                              \
+                case UNSORTED_SET_COL_BOOLEAN:                                                              \
+                case SORTED_SET_COL_BOOLEAN:                                                              \
+                        abstract_get_container_subtype_ret = CONTAINER_COLUMN_BOOLEAN;                                                              \
+                        break;                                                              \
+                default:                                                              \
+                        ERROR(ERR_MARKERMAPPING, "unknown marker encoding an abstract type");                                                              \
+                        abstract_get_container_subtype_ret = CONTAINER_ERR;                                                              \
+                        break;                                                              \
+        }                                                              \
+        abstract_get_container_subtype_ret;                                                              \
+})
+
+
+
+#define abstract_is_instanceof_object(marker)                                           \
+        __abstract_is_instanceof(marker, CONTAINER_OBJECT)
+
+#define abstract_is_instanceof_array(marker)                                           \
+        __abstract_is_instanceof(marker, CONTAINER_ARRAY)
+
+#define abstract_is_instanceof_column_u8(marker)                                           \
+        __abstract_is_instanceof(marker, CONTAINER_COLUMN_U8)
+
+#define abstract_is_instanceof_column_u16(marker)                                           \
+        __abstract_is_instanceof(marker, CONTAINER_COLUMN_U16)
+
+#define abstract_is_instanceof_column_u32(marker)                                           \
+        __abstract_is_instanceof(marker, CONTAINER_COLUMN_U32)
+
+#define abstract_is_instanceof_column_u64(marker)                                           \
+        __abstract_is_instanceof(marker, CONTAINER_COLUMN_U64)
+
+#define abstract_is_instanceof_column_i8(marker)                                           \
+        __abstract_is_instanceof(marker, CONTAINER_COLUMN_I8)
+
+#define abstract_is_instanceof_column_i16(marker)                                           \
+        __abstract_is_instanceof(marker, CONTAINER_COLUMN_I16)
+
+#define abstract_is_instanceof_column_i32(marker)                                           \
+        __abstract_is_instanceof(marker, CONTAINER_COLUMN_I32)
+
+#define abstract_is_instanceof_column_i64(marker)                                           \
+        __abstract_is_instanceof(marker, CONTAINER_COLUMN_I64)
+
+#define abstract_is_instanceof_column_float(marker)                                           \
+        __abstract_is_instanceof(marker, CONTAINER_COLUMN_FLOAT)
+
+#define abstract_is_instanceof_column_boolean(marker)                                           \
+        __abstract_is_instanceof(marker, CONTAINER_COLUMN_BOOLEAN)
+
+#define abstract_is_instanceof_column(marker)                                           \
+        (abstract_is_instanceof_column_u8(marker) ||                                           \
+         abstract_is_instanceof_column_u16(marker) ||                                           \
+         abstract_is_instanceof_column_u32(marker) ||                                           \
+         abstract_is_instanceof_column_u64(marker) ||                                           \
+         abstract_is_instanceof_column_i8(marker) ||                                           \
+         abstract_is_instanceof_column_i16(marker) ||                                           \
+         abstract_is_instanceof_column_i32(marker) ||                                           \
+         abstract_is_instanceof_column_i64(marker) ||                                           \
+         abstract_is_instanceof_column_float(marker) ||                                           \
+         abstract_is_instanceof_column_boolean(marker))
+
+#define abstract_is_instanceof_list(marker)                                                             \
+        (abstract_is_instanceof_array(marker) ||                                                                \
+         abstract_is_instanceof_column(marker))
+
+
+#define abstract_derive_list_to(is, should)                                                                \
+({                                                                \
+        derived_e abstract_derive_list_to_ret;                                                                \
+        switch (is) {                                                                \
+                case LIST_ARRAY:                                                                \
+                        switch (should) {                                                                \
+                                case LIST_UNSORTED_MULTISET:                                                                \
+                                        abstract_derive_list_to_ret = UNSORTED_MULTISET_ARRAY;                                                                \
+                                        break;                                                                \
+                                case LIST_SORTED_MULTISET:                                                                \
+                                        abstract_derive_list_to_ret = SORTED_MULTISET_ARRAY;                                                                \
+                                        break;                                                                \
+                                case LIST_UNSORTED_SET:                                                                \
+                                        abstract_derive_list_to_ret = UNSORTED_SET_ARRAY;                                                                \
+                                        break;                                                                \
+                                case LIST_SORTED_SET:                                                                \
+                                        abstract_derive_list_to_ret = SORTED_SET_ARRAY;                                                                \
+                                        break;                                                                \
+                                default:                                                                \
+                                        abstract_derive_list_to_ret = DERIVED_ERR;                                                                \
+                                        ERROR(ERR_INTERNALERR, "unhandled switch case");                                                                \
+                                        break;                                                                \
+                        } break;                                                                \
+                case LIST_COLUMN_U8:                                                                \
+                        switch (should) {                                                                \
+                                case LIST_UNSORTED_MULTISET:                                                                \
+                                        abstract_derive_list_to_ret = UNSORTED_MULTISET_COL_U8;                                                                \
+                                        break;                                                                \
+                                case LIST_SORTED_MULTISET:                                                                \
+                                        abstract_derive_list_to_ret = SORTED_MULTISET_COL_U8;                                                                \
+                                        break;                                                                \
+                                case LIST_UNSORTED_SET:                                                                \
+                                        abstract_derive_list_to_ret = UNSORTED_SET_COL_U8;                                                                \
+                                        break;                                                                \
+                                case LIST_SORTED_SET:                                                                \
+                                        abstract_derive_list_to_ret = SORTED_SET_COL_U8;                                                                \
+                                        break;                                                                \
+                                default:                                                                \
+                                        abstract_derive_list_to_ret = DERIVED_ERR;                                                                \
+                                        ERROR(ERR_INTERNALERR, "unhandled switch case");                                                                \
+                                        break;                                                                \
+                        } break;                                                                \
+                case LIST_COLUMN_U16:                                                                \
+                        switch (should) {                                                                \
+                                case LIST_UNSORTED_MULTISET:                                                                \
+                                        abstract_derive_list_to_ret = UNSORTED_MULTISET_COL_U16;                                                                \
+                                        break;                                                                \
+                                case LIST_SORTED_MULTISET:                                                                \
+                                        abstract_derive_list_to_ret = SORTED_MULTISET_COL_U16;                                                                \
+                                        break;                                                                \
+                                case LIST_UNSORTED_SET:                                                                \
+                                        abstract_derive_list_to_ret = UNSORTED_SET_COL_U16;                                                                \
+                                        break;                                                                \
+                                case LIST_SORTED_SET:                                                                \
+                                        abstract_derive_list_to_ret = SORTED_SET_COL_U16;                                                                \
+                                        break;                                                                \
+                                default:                                                                \
+                                        abstract_derive_list_to_ret = DERIVED_ERR;                                                                \
+                                        ERROR(ERR_INTERNALERR, "unhandled switch case");                                                                \
+                                        break;                                                                \
+                        } break;                                                                \
+                case LIST_COLUMN_U32:                                                                \
+                        switch (should) {                                                                \
+                                case LIST_UNSORTED_MULTISET:                                                                \
+                                        abstract_derive_list_to_ret = UNSORTED_MULTISET_COL_U32;                                                                \
+                                        break;                                                                \
+                                case LIST_SORTED_MULTISET:                                                                \
+                                        abstract_derive_list_to_ret = SORTED_MULTISET_COL_U32;                                                                \
+                                        break;                                                                \
+                                case LIST_UNSORTED_SET:                                                                \
+                                        abstract_derive_list_to_ret = UNSORTED_SET_COL_U32;                                                                \
+                                        break;                                                                \
+                                case LIST_SORTED_SET:                                                                \
+                                        abstract_derive_list_to_ret = SORTED_SET_COL_U32;                                                                \
+                                        break;                                                                \
+                                default:                                                                \
+                                        abstract_derive_list_to_ret = DERIVED_ERR;                                                                \
+                                        ERROR(ERR_INTERNALERR, "unhandled switch case");                                                                \
+                                        break;                                                                \
+                        } break;                                                                \
+                case LIST_COLUMN_U64:                                                                \
+                        switch (should) {                                                                \
+                                case LIST_UNSORTED_MULTISET:                                                                \
+                                        abstract_derive_list_to_ret = UNSORTED_MULTISET_COL_U64;                                                                \
+                                        break;                                                                \
+                                case LIST_SORTED_MULTISET:                                                                \
+                                        abstract_derive_list_to_ret = SORTED_MULTISET_COL_U64;                                                                \
+                                        break;                                                                \
+                                case LIST_UNSORTED_SET:                                                                \
+                                        abstract_derive_list_to_ret = UNSORTED_SET_COL_U64;                                                                \
+                                        break;                                                                \
+                                case LIST_SORTED_SET:                                                                \
+                                        abstract_derive_list_to_ret = SORTED_SET_COL_U64;                                                                \
+                                        break;                                                                \
+                                default:                                                                \
+                                        abstract_derive_list_to_ret = DERIVED_ERR;                                                                \
+                                        ERROR(ERR_INTERNALERR, "unhandled switch case");                                                                \
+                                        break;                                                                \
+                        } break;                                                                \
+                case LIST_COLUMN_I8:                                                                \
+                        switch (should) {                                                                \
+                                case LIST_UNSORTED_MULTISET:                                                                \
+                                        abstract_derive_list_to_ret = UNSORTED_MULTISET_COL_I8;                                                                \
+                                        break;                                                                \
+                                case LIST_SORTED_MULTISET:                                                                \
+                                        abstract_derive_list_to_ret = SORTED_MULTISET_COL_I8;                                                                \
+                                        break;                                                                \
+                                case LIST_UNSORTED_SET:                                                                \
+                                        abstract_derive_list_to_ret = UNSORTED_SET_COL_I8;                                                                \
+                                        break;                                                                \
+                                case LIST_SORTED_SET:                                                                \
+                                        abstract_derive_list_to_ret = SORTED_SET_COL_I8;                                                                \
+                                        break;                                                                \
+                                default:                                                                \
+                                        abstract_derive_list_to_ret = DERIVED_ERR;                                                                \
+                                        ERROR(ERR_INTERNALERR, "unhandled switch case");                                                                \
+                                        break;                                                                \
+                        } break;                                                                \
+                case LIST_COLUMN_I16:                                                                \
+                        switch (should) {                                                                \
+                                case LIST_UNSORTED_MULTISET:                                                                \
+                                        abstract_derive_list_to_ret = UNSORTED_MULTISET_COL_I16;                                                                \
+                                        break;                                                                \
+                                case LIST_SORTED_MULTISET:                                                                \
+                                        abstract_derive_list_to_ret = SORTED_MULTISET_COL_I16;                                                                \
+                                        break;                                                                \
+                                case LIST_UNSORTED_SET:                                                                \
+                                        abstract_derive_list_to_ret = UNSORTED_SET_COL_I16;                                                                \
+                                        break;                                                                \
+                                case LIST_SORTED_SET:                                                                \
+                                        abstract_derive_list_to_ret = SORTED_SET_COL_I16;                                                                \
+                                        break;                                                                \
+                                default:                                                                \
+                                        abstract_derive_list_to_ret = DERIVED_ERR;                                                                \
+                                        ERROR(ERR_INTERNALERR, "unhandled switch case");                                                                \
+                                        break;                                                                \
+                        } break;                                                                \
+                case LIST_COLUMN_I32:                                                                \
+                        switch (should) {                                                                \
+                                case LIST_UNSORTED_MULTISET:                                                                \
+                                        abstract_derive_list_to_ret = UNSORTED_MULTISET_COL_I32;                                                                \
+                                        break;                                                                \
+                                case LIST_SORTED_MULTISET:                                                                \
+                                        abstract_derive_list_to_ret = SORTED_MULTISET_COL_I32;                                                                \
+                                        break;                                                                \
+                                case LIST_UNSORTED_SET:                                                                \
+                                        abstract_derive_list_to_ret = UNSORTED_SET_COL_I32;                                                                \
+                                        break;                                                                \
+                                case LIST_SORTED_SET:                                                                \
+                                        abstract_derive_list_to_ret = SORTED_SET_COL_I32;                                                                \
+                                        break;                                                                \
+                                default:                                                                \
+                                        abstract_derive_list_to_ret = DERIVED_ERR;                                                                \
+                                        ERROR(ERR_INTERNALERR, "unhandled switch case");                                                                \
+                                        break;                                                                \
+                        } break;                                                                \
+                case LIST_COLUMN_I64:                                                                \
+                        switch (should) {                                                                \
+                                case LIST_UNSORTED_MULTISET:                                                                \
+                                        abstract_derive_list_to_ret = UNSORTED_MULTISET_COL_I64;                                                                \
+                                        break;                                                                \
+                                case LIST_SORTED_MULTISET:                                                                \
+                                        abstract_derive_list_to_ret = SORTED_MULTISET_COL_I64;                                                                \
+                                        break;                                                                \
+                                case LIST_UNSORTED_SET:                                                                \
+                                        abstract_derive_list_to_ret = UNSORTED_SET_COL_I64;                                                                \
+                                        break;                                                                \
+                                case LIST_SORTED_SET:                                                                \
+                                        abstract_derive_list_to_ret = SORTED_SET_COL_I64;                                                                \
+                                        break;                                                                \
+                                default:                                                                \
+                                        abstract_derive_list_to_ret = DERIVED_ERR;                                                                \
+                                        ERROR(ERR_INTERNALERR, "unhandled switch case");                                                                \
+                                        break;                                                                \
+                        } break;                                                                \
+                case LIST_COLUMN_BOOLEAN:                                                                \
+                        switch (should) {                                                                \
+                                case LIST_UNSORTED_MULTISET:                                                                \
+                                        abstract_derive_list_to_ret = UNSORTED_MULTISET_COL_BOOLEAN;                                                                \
+                                        break;                                                                \
+                                case LIST_SORTED_MULTISET:                                                                \
+                                        abstract_derive_list_to_ret = SORTED_MULTISET_COL_BOOLEAN;                                                                \
+                                        break;                                                                \
+                                case LIST_UNSORTED_SET:                                                                \
+                                        abstract_derive_list_to_ret = UNSORTED_SET_COL_BOOLEAN;                                                                \
+                                        break;                                                                \
+                                case LIST_SORTED_SET:                                                                \
+                                        abstract_derive_list_to_ret = SORTED_SET_COL_BOOLEAN;                                                                \
+                                        break;                                                                \
+                                default:                                                                \
+                                        abstract_derive_list_to_ret = DERIVED_ERR;                                                                \
+                                        ERROR(ERR_INTERNALERR, "unhandled switch case");                                                                \
+                                        break;                                                                \
+                        } break;                                                                \
+                case LIST_COLUMN_FLOAT:                                                                \
+                        switch (should) {                                                                \
+                                case LIST_UNSORTED_MULTISET:                                                                \
+                                        abstract_derive_list_to_ret = UNSORTED_MULTISET_COL_FLOAT;                                                                \
+                                        break;                                                                \
+                                case LIST_SORTED_MULTISET:                                                                \
+                                        abstract_derive_list_to_ret = SORTED_MULTISET_COL_FLOAT;                                                                \
+                                        break;                                                                \
+                                case LIST_UNSORTED_SET:                                                                \
+                                        abstract_derive_list_to_ret = UNSORTED_SET_COL_FLOAT;                                                                \
+                                        break;                                                                \
+                                case LIST_SORTED_SET:                                                                \
+                                        abstract_derive_list_to_ret = SORTED_SET_COL_FLOAT;                                                                \
+                                        break;                                                                \
+                                default:                                                                \
+                                        abstract_derive_list_to_ret = DERIVED_ERR;                                                                \
+                                        ERROR(ERR_INTERNALERR, "unhandled switch case");                                                                \
+                                        break;                                                                \
+                        } break;                                                                \
+                default:                                                                \
+                        abstract_derive_list_to_ret = DERIVED_ERR;                                                                \
+                        ERROR(ERR_INTERNALERR, "unhandled switch case");                                                                \
+                        break;                                                                \
+        }                                                                \
+        abstract_derive_list_to_ret;                                                                \
+})                                                                \
+
+#define abstract_derive_map_to(should)                                                                \
+({                                                                \
+        derived_e abstract_derive_map_to_ret;                                                                \
+        switch (should) {                                                                \
+                case MAP_UNSORTED_MULTIMAP:                                                                \
+                        abstract_derive_map_to_ret = UNSORTED_MULTIMAP;                                                                \
+                        break;                                                                \
+                case MAP_SORTED_MULTIMAP:                                                                \
+                        abstract_derive_map_to_ret = SORTED_MULTIMAP;                                                                \
+                        break;                                                                \
+                case MAP_UNSORTED_MAP:                                                                \
+                        abstract_derive_map_to_ret = UNSORTED_MAP;                                                                \
+                        break;                                                                \
+                case MAP_SORTED_MAP:                                                                \
+                        abstract_derive_map_to_ret = SORTED_MAP;                                                                \
+                        break;                                                                \
+                default:                                                                \
+                        ERROR(ERR_INTERNALERR, "unknown list container type");                                                                \
+                        abstract_derive_map_to_ret = DERIVED_ERR;                                                                \
+                        break;                                                                \
+        }                                                                \
+        abstract_derive_map_to_ret;                                                                \
+})
+
+
+
+#define abstract_get_derived_type(marker)                                                                \
+({                                                                \
+        if (!(marker == MUNSORTED_MULTIMAP || marker == MSORTED_MULTIMAP || marker == MUNSORTED_MAP ||                                                                \
+              marker == MSORTED_MAP || marker == MUNSORTED_MULTISET_ARR ||                                                                \
+              marker == MSORTED_MULTISET_ARR || marker == MUNSORTED_SET_ARR ||                                                                \
+              marker == MSORTED_SET_ARR || marker == MUNSORTED_MULTISET_U8 ||                                                                \
+              marker == MSORTED_MULTISET_U8 || marker == MUNSORTED_SET_U8 ||                                                                \
+              marker == MSORTED_SET_U8 || marker == MUNSORTED_MULTISET_U16 ||                                                                \
+              marker == MSORTED_MULTISET_U16 || marker == MUNSORTED_SET_U16 ||                                                                \
+              marker == MSORTED_SET_U16 || marker == MUNSORTED_MULTISET_U32 ||                                                                \
+              marker == MSORTED_MULTISET_U32 || marker == MUNSORTED_SET_U32 ||                                                                \
+              marker == MSORTED_SET_U32 || marker == MUNSORTED_MULTISET_U64 ||                                                                \
+              marker == MSORTED_MULTISET_U64 || marker == MUNSORTED_SET_U64 ||                                                                \
+              marker == MSORTED_SET_U64 || marker == MUNSORTED_MULTISET_I8 ||                                                                \
+              marker == MSORTED_MULTISET_I8 || marker == MUNSORTED_SET_I8 ||                                                                \
+              marker == MSORTED_SET_I8 || marker == MUNSORTED_MULTISET_I16 ||                                                                \
+              marker == MSORTED_MULTISET_I16 || marker == MUNSORTED_SET_I16 ||                                                                \
+              marker == MSORTED_SET_I16 || marker == MUNSORTED_MULTISET_I32 ||                                                                \
+              marker == MSORTED_MULTISET_I32 || marker == MUNSORTED_SET_I32 ||                                                                \
+              marker == MSORTED_SET_I32 || marker == MUNSORTED_MULTISET_I64 ||                                                                \
+              marker == MSORTED_MULTISET_I64 || marker == MUNSORTED_SET_I64 ||                                                                \
+              marker == MSORTED_SET_I64 || marker == MUNSORTED_MULTISET_FLOAT ||                                                                \
+              marker == MSORTED_MULTISET_FLOAT || marker == MUNSORTED_SET_FLOAT ||                                                                \
+              marker == MSORTED_SET_FLOAT || marker == MUNSORTED_MULTISET_BOOLEAN ||                                                                \
+              marker == MSORTED_MULTISET_BOOLEAN || marker == MUNSORTED_SET_BOOLEAN ||                                                                \
+              marker == MSORTED_SET_BOOLEAN)) {                                                                \
+                ERROR(ERR_MARKERMAPPING, "unknown marker for abstract derived type");                                                                \
+                marker = MERR;                                                                \
+        }                                                                \
+        (derived_e) marker;                                                                \
+})
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif/*
+ * arr-it - array iterator implementation
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_ARR_IT_H
+#define HAD_ARR_IT_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/forwdecl.h>
+#include <karbonit/error.h>
+#include <karbonit/std/vec.h>
+#include <karbonit/rec.h>
+#include <karbonit/carbon/field.h>
+#include <karbonit/carbon/item.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  public structures
+// ---------------------------------------------------------------------------------------------------------------------
+
+typedef struct field {
+        field_e type;
+        const void *data;
+        u64 len;
+        const char *mime;
+        u64 mime_len;
+} field;
+
+typedef struct arr_it {
+        memfile file;
+        offset_t begin;
+        list_type_e list_type;
+        u64 pos;
+        item item;
+        /** in case of modifications (updates, inserts, deletes), the number of bytes that are added resp. removed */
+        i64 mod_size;
+        bool eof;
+        offset_t last_off;
+        field field;
+        offset_t field_offset;
+        void *data;
+} arr_it;
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  public interface
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Positions the iterator at the beginning of this array.
+ */
+#define ARR_IT_REWIND(it)                                                                       \
+{                                                                       \
+        it->pos = 0;                                                                       \
+        MEMFILE_SEEK__UNSAFE(&it->file, it->begin + sizeof(u8));                                                                       \
+}
+
+bool arr_it_length(u64 *len, arr_it *it);
+bool arr_it_is_empty(arr_it *it);
+
+/**
+ * Positions the iterator to the slot after the current element, potentially pointing to next element.
+ * The function returns true, if the slot is non-empty, and false otherwise.
+ */
+item *arr_it_next(arr_it *it);
+bool arr_it_has_next(arr_it *it);
+bool arr_it_is_unit(arr_it *it);
+
+/**
+ * Inserts a new element at the current position of the iterator.
+ */
+void arr_it_insert_begin(insert *in, arr_it *it);
+void arr_it_insert_end(insert *in);
+
+/** Checks if this array is annotated as a multi set abstract type. Returns true if it is is a multi set, and false if
+ * it is a set. In case of any ERROR, a failure is returned. */
+bool arr_it_is_multiset(arr_it *it);
+
+/** Checks if this array is annotated as a sorted abstract type. Returns true if this is the case,
+ * otherwise false. In case of any ERROR, a failure is returned. */
+bool arr_it_is_sorted(arr_it *it);
+
+/** Updates this arrays abstract type to the given abstract type */
+void arr_it_update_type(arr_it *it, list_type_e derivation);
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  for internal usage
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Constructs a new array iterator in a carbon document, where <code>payload_start</code> is a memory offset
+ * that starts with the first (potentially empty) array entry. If there is some data before the array contents
+ * (e.g., a header), <code>payload_start</code> must not include this data.
+ */
+bool internal_arr_it_create(arr_it *it, memfile *memfile, offset_t payload_start);
+bool internal_arr_it_copy(arr_it *dst, arr_it *src);
+bool internal_arr_it_clone(arr_it *dst, arr_it *src);
+void internal_arr_it_adjust(arr_it *it);
+
+#define INTERNAL_ARR_IT_SET_MODE(it, access_mode_e)                                                                    \
+        (it)->file.mode = (access_mode_e)
+
+
+
+bool internal_arr_it_remove(arr_it *it);
+
+#define DECLARE_IN_PLACE_UPDATE_FUNCTION(type_name)                                                                    \
+bool internal_arr_it_update_##type_name(arr_it *it, type_name value);
+
+DECLARE_IN_PLACE_UPDATE_FUNCTION(u8)
+DECLARE_IN_PLACE_UPDATE_FUNCTION(u16)
+DECLARE_IN_PLACE_UPDATE_FUNCTION(u32)
+DECLARE_IN_PLACE_UPDATE_FUNCTION(u64)
+DECLARE_IN_PLACE_UPDATE_FUNCTION(i8)
+DECLARE_IN_PLACE_UPDATE_FUNCTION(i16)
+DECLARE_IN_PLACE_UPDATE_FUNCTION(i32)
+DECLARE_IN_PLACE_UPDATE_FUNCTION(i64)
+DECLARE_IN_PLACE_UPDATE_FUNCTION(float)
+
+bool internal_arr_it_update_true(arr_it *it);
+bool internal_arr_it_update_false(arr_it *it);
+bool internal_arr_it_update_null(arr_it *it);
+bool internal_arr_it_update_string(arr_it *it, const char *str);
+bool internal_arr_it_update_binary(arr_it *it, const void *base, size_t nbytes, const char *file_ext, const char *type);
+insert *internal_arr_it_update_array_begin(arr_state *state, arr_it *it);
+bool internal_arr_it_update_array_end(arr_state *state);
+
+insert *internal_arr_it_update_column_begin(col_state *state, arr_it *it);
+bool internal_arr_it_update_column_end(col_state *state);
+
+insert *internal_arr_it_update_object_begin(obj_state *state, arr_it *it);
+bool internal_arr_it_update_object_end(obj_state *state);
+
+bool internal_arr_it_update_from_carbon(arr_it *it, const rec *src);
+bool internal_arr_it_update_from_array(arr_it *it, const arr_it *src);
+bool internal_arr_it_update_from_object(arr_it *it, const obj_it *src);
+bool internal_arr_it_update_from_column(arr_it *it, const col_it *src);
+
+
+bool arr_it_field_type(field_e *type, arr_it *it);
+
+void *internal_arr_it_memfile(arr_it *it);
+offset_t internal_arr_it_memfilepos(arr_it *it);
+offset_t internal_arr_it_tell(arr_it *it);
+bool internal_arr_it_offset(offset_t *off, arr_it *it);
+bool internal_arr_it_fast_forward(arr_it *it);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/*
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_BINARY_H
+#define HAD_BINARY_H
+
+#include <karbonit/types.h>
+#include <karbonit/std/string.h>
+
+typedef struct binary_field {
+    const char *mime;
+    u64 mime_len;
+    const void *blob;
+    u64 blob_len;
+} binary_field;
+
+static binary_field NULL_BINARY = {
+        .mime = NULL,
+        .mime_len = 0,
+        .blob = 0,
+        .blob_len = 0
+};
+
+void binary_field_print(str_buf *dst, const binary_field *field);
+void binary_field_value_print(str_buf *dst, const binary_field *field);
+
+#endif
+
+/*
+ * col_it - column iterator implementation
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_COL_IT_H
+#define HAD_COL_IT_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/carbon/field.h>
+#include <karbonit/carbon/internal.h>
+#include <karbonit/rec.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CAST_COL_VALUES(builtin_type, __nvalues__, iterator, field_expr)                                                   \
+        ((const builtin_type *) (COL_IT_VALUES(NULL, __nvalues__, iterator)))
+
+typedef struct col_it {
+        memfile file;
+        offset_t header_begin;
+        offset_t begin;
+        field_e field_type;
+        list_type_e list_type;
+        i64 mod_size; /* in case of modifications, the number of bytes that are added resp. removed */
+        u32 cap;
+        u32 num;
+} col_it;
+
+bool col_it_create(col_it *it, memfile *memfile, offset_t begin);
+void internal_col_it_skip__fast(col_it *col);
+bool col_it_clone(col_it *dst, col_it *src);
+bool col_it_insert(insert *in, col_it *it);
+bool col_it_fast_forward(col_it *it);
+offset_t col_it_memfilepos(col_it *it);
+void *col_it_memfile_raw(col_it *it);
+offset_t col_it_tell(col_it *it, u32 elem_idx);
+
+
+#define COL_IT_VALUES(field_e_ptr, _nvalues_u32_ptr_, _col_it_ptr_it_)                                                        \
+({                                                                                                                     \
+        const char *col_it_values_result = NULL;                                                                                     \
+        {                                                                                                                       \
+                col_it *it_ptr = (_col_it_ptr_it_);                                                                                 \
+                MEMFILE_SEEK(&it_ptr->file, it_ptr->header_begin);                                                                     \
+                u32 num_elements = (u32) MEMFILE_READ_UINTVAR_STREAM(NULL, &it_ptr->file); UNUSED(num_elements);                                     \
+                u32 cap_elements = (u32) MEMFILE_READ_UINTVAR_STREAM(NULL, &it_ptr->file); UNUSED(cap_elements);                                     \
+                offset_t payload_start = MEMFILE_TELL(&it_ptr->file);                                                          \
+                u32 skip = cap_elements * INTERNAL_GET_TYPE_VALUE_SIZE(it_ptr->field_type);                                    \
+                col_it_values_result = MEMFILE_PEEK(&it_ptr->file, JAK_MAX(sizeof(char), skip));                               \
+                field_e *ptr_type = (field_e_ptr); UNUSED(ptr_type);                                                                            \
+                u32 *ptr_nvalues = (_nvalues_u32_ptr_); UNUSED(ptr_nvalues);                                                                          \
+                OPTIONAL_SET(ptr_type, it_ptr->field_type);                                                                    \
+                OPTIONAL_SET(ptr_nvalues, num_elements);                                                                       \
+                MEMFILE_SEEK(&it_ptr->file, payload_start + skip);                                                             \
+        }                                                                                                                       \
+        col_it_values_result;                                                                                                        \
+})
+
+#define COL_IT_VALUES_INFO(_field_e_, _col_it_)                                                                        \
+({                                                                                                                     \
+        u32 ___nvalues = 0; UNUSED(___nvalues);                                                                       \
+        {                                                                                                              \
+                MEMFILE_SEEK(&(_col_it_)->file, (_col_it_)->header_begin);                                             \
+                ___nvalues = (u32) MEMFILE_READ_UINTVAR_STREAM(NULL, &(_col_it_)->file);                           \
+                OPTIONAL_SET((_field_e_), (_col_it_)->field_type);                                                     \
+        }                                                                                                              \
+        ___nvalues;                                                                                                    \
+})
+
+bool col_it_is_null(col_it *it, u32 pos);
+
+bool col_it_is_boolean(col_it *it);
+bool col_it_is_u8(col_it *it);
+bool col_it_is_u16(col_it *it);
+bool col_it_is_u32(col_it *it);
+bool col_it_is_u64(col_it *it);
+bool col_it_is_i8(col_it *it);
+bool col_it_is_i16(col_it *it);
+bool col_it_is_i32(col_it *it);
+bool col_it_is_i64(col_it *it);
+bool col_it_is_float(col_it *it);
+
+const boolean *internal_col_it_boolean_values(u32 *nvalues, col_it *it);
+const u8 *internal_col_it_u8_values(u32 *nvalues, col_it *it);
+const u16 *internal_col_it_u16_values(u32 *nvalues, col_it *it);
+const u32 *internal_col_it_u32_values(u32 *nvalues, col_it *it);
+const u64 *internal_col_it_u64_values(u32 *nvalues, col_it *it);
+const i8 *internal_col_it_i8_values(u32 *nvalues, col_it *it);
+const i16 *internal_col_it_i16_values(u32 *nvalues, col_it *it);
+const i32 *internal_col_it_i32_values(u32 *nvalues, col_it *it);
+const i64 *internal_col_it_i64_values(u32 *nvalues, col_it *it);
+const float *internal_col_it_float_values(u32 *nvalues, col_it *it);
+
+#define COL_IT_BOOLEAN_VALUES(_nvalues_u32_ptr_, _col_it_ptr_it_)                                                             \
+        (CAST_COL_VALUES(boolean, _nvalues_u32_ptr_, _col_it_ptr_it_, FIELD_IS_COLUMN_BOOL_OR_SUBTYPE(type)))
+
+#define COL_IT_U8_VALUES(_nvalues_u32_ptr_, _col_it_ptr_it_)                                                          \
+        (CAST_COL_VALUES(u8, _nvalues_u32_ptr_, _col_it_ptr_it_, FIELD_IS_COLUMN_U8_OR_SUBTYPE(type)))
+
+#define COL_IT_U16_VALUES(_nvalues_u32_ptr_, _col_it_ptr_it_)                                                         \
+        (CAST_COL_VALUES(u16, _nvalues_u32_ptr_, _col_it_ptr_it_, FIELD_IS_COLUMN_U16_OR_SUBTYPE(type)))
+
+#define COL_IT_U32_VALUES(_nvalues_u32_ptr_, _col_it_ptr_it_)                                                         \
+        (CAST_COL_VALUES(u32, _nvalues_u32_ptr_, _col_it_ptr_it_, FIELD_IS_COLUMN_U32_OR_SUBTYPE(type)))
+
+#define COL_IT_U64_VALUES(_nvalues_u32_ptr_, _col_it_ptr_it_)                                                         \
+        (CAST_COL_VALUES(u64, _nvalues_u32_ptr_, _col_it_ptr_it_, FIELD_IS_COLUMN_U64_OR_SUBTYPE(type)))
+
+#define COL_IT_I8_VALUES(_nvalues_u32_ptr_, _col_it_ptr_it_)                                                          \
+        (CAST_COL_VALUES(i8, _nvalues_u32_ptr_, _col_it_ptr_it_, FIELD_IS_COLUMN_I8_OR_SUBTYPE(type)))
+
+#define COL_IT_I16_VALUES(_nvalues_u32_ptr_, _col_it_ptr_it_)                                                         \
+        (CAST_COL_VALUES(i16, _nvalues_u32_ptr_, _col_it_ptr_it_, FIELD_IS_COLUMN_I16_OR_SUBTYPE(type)))
+
+#define COL_IT_I32_VALUES(_nvalues_u32_ptr_, _col_it_ptr_it_)                                                         \
+        (CAST_COL_VALUES(i32, _nvalues_u32_ptr_, _col_it_ptr_it_, FIELD_IS_COLUMN_I32_OR_SUBTYPE(type)))
+
+#define COL_IT_I64_VALUES(_nvalues_u32_ptr_, _col_it_ptr_it_)                                                         \
+        (CAST_COL_VALUES(i64, _nvalues_u32_ptr_, _col_it_ptr_it_, FIELD_IS_COLUMN_I64_OR_SUBTYPE(type)))
+
+#define COL_IT_FLOAT_VALUES(_nvalues_u32_ptr_, _col_it_ptr_it_)                                                       \
+        (CAST_COL_VALUES(float, _nvalues_u32_ptr_, _col_it_ptr_it_, FIELD_IS_COLUMN_FLOAT_OR_SUBTYPE(type)))
+
+bool col_it_remove(col_it *it, u32 pos);
+bool col_it_is_multiset(col_it *it);
+bool col_it_is_sorted(col_it *it);
+
+/**
+ * Changes the abstract type of the column. If the column becomes sorted, its values are sorted in place, and if it
+ * becomes a sorted set, repeated values are dropped. Values of sorted columns are kept in ascending order by inserts
+ * and updates, where null values are greater than all other values, and sorted sets drop values that an insert or
+ * update would repeat.
+ */
+bool col_it_update_type(col_it *it, list_type_e derivation);
+
+/**
+ * Searches for <code>value</code>, which points to a value of the column's element type (for boolean columns, one of
+ * the <code>CARBON_BOOLEAN_COLUMN_*</code> bytes). Returns true if the value is contained, and sets <code>pos</code>
+ * (if non-null) to the position of its first occurrence. Sorted columns are binary searched, and <code>pos</code> is
+ * set to the position at which the value would be inserted if it is not contained. Unsorted columns are scanned, and
+ * <code>pos</code> is set to the number of values if the value is not contained.
+ */
+bool col_it_find(u32 *pos, col_it *it, const void *value);
+bool col_it_find_u8(u32 *pos, col_it *it, u8 value);
+bool col_it_find_u16(u32 *pos, col_it *it, u16 value);
+bool col_it_find_u32(u32 *pos, col_it *it, u32 value);
+bool col_it_find_u64(u32 *pos, col_it *it, u64 value);
+bool col_it_find_i8(u32 *pos, col_it *it, i8 value);
+bool col_it_find_i16(u32 *pos, col_it *it, i16 value);
+bool col_it_find_i32(u32 *pos, col_it *it, i32 value);
+bool col_it_find_i64(u32 *pos, col_it *it, i64 value);
+bool col_it_find_float(u32 *pos, col_it *it, float value);
+
+/**
+ * Compares two values of a column of the given type in the order of sorted columns
+ */
+int internal_col_it_value_cmp(field_e type, const void *lhs, const void *rhs);
+
+/**
+ * Returns the position of the first of the sorted <code>values</code> that is greater than (if <code>upper</code>),
+ * or not less than (otherwise), <code>value</code>.
+ */
+u32 internal_col_it_bound(field_e type, const void *values, u32 num_values, const void *value, bool upper);
+bool col_it_update_set_null(col_it *it, u32 pos);
+bool col_it_update_set_true(col_it *it, u32 pos);
+bool col_it_update_set_false(col_it *it, u32 pos);
+bool col_it_update_set_u8(col_it *it, u32 pos, u8 value);
+bool col_it_update_set_u16(col_it *it, u32 pos, u16 value);
+bool col_it_update_set_u32(col_it *it, u32 pos, u32 value);
+bool col_it_update_set_u64(col_it *it, u32 pos, u64 value);
+bool col_it_update_set_i8(col_it *it, u32 pos, i8 value);
+bool col_it_update_set_i16(col_it *it, u32 pos, i16 value);
+bool col_it_update_set_i32(col_it *it, u32 pos, i32 value);
+bool col_it_update_set_i64(col_it *it, u32 pos, i64 value);
+bool col_it_update_set_float(col_it *it, u32 pos, float value);
+bool col_it_rewind(col_it *it);
+bool col_it_print(str_buf *dst, col_it *it);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/*
+ * col-kernels - aggregates and filters over the values of columns
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_COL_KERNELS_H
+#define HAD_COL_KERNELS_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/carbon/col-it.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Number of words of a selection bitmap for a column of <code>num_values</code> values. The value at position
+ * <code>i</code> is selected if bit <code>i % 64</code> of word <code>i / 64</code> is set.
+ */
+#define COL_KERNELS_SEL_WORDS(num_values)       (((num_values) + 63) / 64)
+
+/**
+ * The kernels operate on the values of the column on which <code>it</code> operates, and skip null values unless
+ * said otherwise. On x86-64 processors that support AVX2, columns of 32 and 64 bit integers and floats are processed
+ * in vector registers; all other columns, and all other processors, use a scalar loop. Kernels do not modify the
+ * column, and do not move the iterator.
+ */
+
+/**
+ * Sets <code>count</code> to the number of values in the column, null values included
+ */
+bool col_kernels_count(u32 *count, col_it *it);
+
+/**
+ * Sets <code>count</code> to the number of non-null values in the column
+ */
+bool col_kernels_count_non_null(u32 *count, col_it *it);
+
+/**
+ * Sums up the non-null values of the column, which is 0 for a column without non-null values. Columns of unsigned
+ * integers are summed up with <code>col_kernels_sum_unsigned</code> (for boolean columns, the sum is the number of
+ * true values), columns of signed integers with <code>col_kernels_sum_signed</code>, and columns of floats with
+ * <code>col_kernels_sum_float</code>, which adds up in double precision. Integer sums wrap around on overflow.
+ */
+bool col_kernels_sum_unsigned(u64 *sum, col_it *it);
+bool col_kernels_sum_signed(i64 *sum, col_it *it);
+bool col_kernels_sum_float(double *sum, col_it *it);
+
+/**
+ * Stores the least, resp. greatest, non-null value of the column in <code>value</code>, which points to a value of
+ * the column's element type (for boolean columns, one of the <code>CARBON_BOOLEAN_COLUMN_*</code> bytes). Returns
+ * false if the column contains no non-null value. Sorted columns are not scanned.
+ */
+bool col_kernels_min(void *value, col_it *it);
+bool col_kernels_max(void *value, col_it *it);
+
+/**
+ * Selects the values of the column that are not less than <code>lower</code> and not greater than
+ * <code>upper</code>, both of which point to a value of the column's element type, or are <code>NULL</code> for
+ * an unbounded range. The caller provides <code>COL_KERNELS_SEL_WORDS(count)</code> words in <code>sel</code>, all
+ * of which are overwritten. Null values are never selected.
+ */
+bool col_kernels_filter_range(u64 *sel, col_it *it, const void *lower, const void *upper);
+bool col_kernels_filter_range_u8(u64 *sel, col_it *it, u8 lower, u8 upper);
+bool col_kernels_filter_range_u16(u64 *sel, col_it *it, u16 lower, u16 upper);
+bool col_kernels_filter_range_u32(u64 *sel, col_it *it, u32 lower, u32 upper);
+bool col_kernels_filter_range_u64(u64 *sel, col_it *it, u64 lower, u64 upper);
+bool col_kernels_filter_range_i8(u64 *sel, col_it *it, i8 lower, i8 upper);
+bool col_kernels_filter_range_i16(u64 *sel, col_it *it, i16 lower, i16 upper);
+bool col_kernels_filter_range_i32(u64 *sel, col_it *it, i32 lower, i32 upper);
+bool col_kernels_filter_range_i64(u64 *sel, col_it *it, i64 lower, i64 upper);
+bool col_kernels_filter_range_float(u64 *sel, col_it *it, float lower, float upper);
+
+/**
+ * Selects the values of the column that are equal to <code>value</code> (see <code>col_kernels_filter_range</code>)
+ */
+bool col_kernels_filter_eq(u64 *sel, col_it *it, const void *value);
+bool col_kernels_filter_eq_u8(u64 *sel, col_it *it, u8 value);
+bool col_kernels_filter_eq_u16(u64 *sel, col_it *it, u16 value);
+bool col_kernels_filter_eq_u32(u64 *sel, col_it *it, u32 value);
+bool col_kernels_filter_eq_u64(u64 *sel, col_it *it, u64 value);
+bool col_kernels_filter_eq_i8(u64 *sel, col_it *it, i8 value);
+bool col_kernels_filter_eq_i16(u64 *sel, col_it *it, i16 value);
+bool col_kernels_filter_eq_i32(u64 *sel, col_it *it, i32 value);
+bool col_kernels_filter_eq_i64(u64 *sel, col_it *it, i64 value);
+bool col_kernels_filter_eq_float(u64 *sel, col_it *it, float value);
+
+/**
+ * Returns the number of values that are selected in the selection bitmap of a column of <code>num_values</code>
+ * values
+ */
+u32 col_kernels_sel_count(const u64 *sel, u32 num_values);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/*
+ * commit - commit hash functions
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_COMMIT_H
+#define HAD_COMMIT_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/mem/memfile.h>
+#include <karbonit/std/string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool commit_create(memfile *file);
+bool commit_skip(memfile *file);
+bool commit_read(u64 *commit_hash, memfile *file);
+bool commit_peek(u64 *commit_hash, memfile *file);
+bool commit_update(memfile *file, const char *base, u64 len);
+/* as commit_update for the files entire memory block, rehashing only chunks modified since the last update */
+bool commit_update_incremental(memfile *file);
+bool commit_compute(u64 *commit_hash, const void *base, u64 len);
+const char *commit_to_str(str_buf *dst, u64 commit_hash);
+bool commit_append_to_str(str_buf *dst, u64 commit_hash);
+u64 commit_from_str(const char *commit_str);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/*
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_CONTAINERS_H
+#define HAD_CONTAINERS_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/carbon/markers.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  container types (lists/maps)
+// ---------------------------------------------------------------------------------------------------------------------
+
+typedef enum container {
+    OBJECT, ARRAY, COLUMN
+} container_e;
+
+typedef enum untyped_e
+{
+    UNTYPED_ARRAY,
+    UNTYPED_OBJECT
+} untyped_e;
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  implementation types (and marker) for list/map container types
+// ---------------------------------------------------------------------------------------------------------------------
+
+typedef enum sub_type {
+    CONTAINER_OBJECT = MOBJECT_BEGIN,
+    CONTAINER_ARRAY = MARRAY_BEGIN,
+    CONTAINER_COLUMN_U8 = MCOLUMN_U8,
+    CONTAINER_COLUMN_U16 = MCOLUMN_U16,
+    CONTAINER_COLUMN_U32 = MCOLUMN_U32,
+    CONTAINER_COLUMN_U64 = MCOLUMN_U64,
+    CONTAINER_COLUMN_I8 = MCOLUMN_I8,
+    CONTAINER_COLUMN_I16 = MCOLUMN_I16,
+    CONTAINER_COLUMN_I32 = MCOLUMN_I32,
+    CONTAINER_COLUMN_I64 = MCOLUMN_I64,
+    CONTAINER_COLUMN_BOOLEAN = MCOLUMN_BOOLEAN,
+    CONTAINER_COLUMN_FLOAT = MCOLUMN_FLOAT,
+    CONTAINER_ERR
+} sub_type_e;
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  implementation types (and marker) for list-only container types
+// ---------------------------------------------------------------------------------------------------------------------
+
+typedef enum list_container {
+    LIST_ARRAY = MARRAY_BEGIN,
+    LIST_COLUMN_U8 = MCOLUMN_U8,
+    LIST_COLUMN_U16 = MCOLUMN_U16,
+    LIST_COLUMN_U32 = MCOLUMN_U32,
+    LIST_COLUMN_U64 = MCOLUMN_U64,
+    LIST_COLUMN_I8 = MCOLUMN_I8,
+    LIST_COLUMN_I16 = MCOLUMN_I16,
+    LIST_COLUMN_I32 = MCOLUMN_I32,
+    LIST_COLUMN_I64 = MCOLUMN_I64,
+    LIST_COLUMN_BOOLEAN = MCOLUMN_BOOLEAN,
+    LIST_COLUMN_FLOAT = MCOLUMN_FLOAT
+} list_container_e;
+
+bool list_by_column_type(list_container_e *out, int field_type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif/*
+ * delta - binary deltas between record revisions
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_DELTA_H
+#define HAD_DELTA_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/rec.h>
+#include <karbonit/std/vec.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* number of bytes of the original record that are looked up as a whole in the revised record */
+#define DELTA_BLOCK_SIZE        16
+
+/**
+ * Computes a binary delta that turns the raw data (see <code>rec_raw_data</code>) of <code>original</code> into the
+ * raw data of <code>revised</code>, typically a revision of <code>original</code>, and stores it in
+ * <code>delta</code>, which is created by this function. The delta consists of copies of byte ranges of the original
+ * record and of bytes that do not occur in the original record, such that a small change, e.g., an update of a field
+ * or the insertion of a property, results in a small delta even though it moves the bytes behind it. The delta is
+ * meaningful only together with <code>original</code>, and is dropped with <code>vec_drop</code>.
+ */
+bool delta_create(vec ofType(u8) *delta, rec *original, rec *revised);
+
+/**
+ * Creates <code>revised</code> from <code>original</code> and the <code>len</code> bytes of <code>delta</code> at
+ * <code>delta</code> (see <code>delta_create</code>). Fails without creating <code>revised</code> if the delta was
+ * computed for another original record, or if it is corrupted. The created record is verified to be the one for which
+ * the delta was computed, i.e., it has the same raw data and commit hash (see <code>rec_commit_hash</code>).
+ */
+bool delta_apply(rec *revised, rec *original, const void *delta, u64 len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/*
+ * dot-eval - dot-notated path evaluator
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_DOT_EVAL_H
+#define HAD_DOT_EVAL_H
+
+#include <karbonit/stdinc.h>
+#include <karbonit/carbon/dot.h>
+#include <karbonit/carbon/container.h>
+#include <karbonit/carbon/skip-index.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct dot_eval {
+        rec *doc;
+        arr_it root_it;
+        /* optional skip index for the record, used to access array elements by their index */
+        const skip_index *skips;
+        pstatus_e status;
+        struct {
+                container_e container;
+                union {
+                        arr_it array;
+                        obj_it object;
+                        struct {
+                                col_it it;
+                                u32 elem_pos;
+                        } column;
+                } containers;
+        } result;
+} dot_eval;
+
+void dot_eval_begin(dot_eval *eval, const dot *path, rec *doc);
+
+/**
+ * Evaluates the path as <code>dot_eval_begin</code> does, but uses <code>skips</code> (if non-null) to access
+ * elements of indexed arrays without stepping over all elements before them. An index that was not created for
+ * the revision of <code>doc</code> is ignored.
+ */
+void dot_eval_begin_indexed(dot_eval *eval, const dot *path, rec *doc, const skip_index *skips);
+
+/**
+ * Evaluates the path as <code>dot_eval_begin</code> does, but uses the path index <code>index</code> (if non-null)
+ * to jump to the result directly instead of scanning the containers on the path. The record is only traversed if the
+ * index was not created for the revision of <code>doc</code>, or if the path does not resolve in the index.
+ */
+void dot_eval_begin_pindexed(dot_eval *eval, const dot *path, rec *doc, pindex *index);
+bool dot_eval_begin_mutable(dot_eval *eval, const dot *path, rev *context);
+
+bool dot_eval_status(pstatus_e *status, dot_eval *state);
+
+#define DOT_EVAL_HAS_RESULT(dot_eval)                                                                                  \
+        ((dot_eval)->status == PATH_RESOLVED)
+
+bool carbon_path_exists(rec *doc, const char *path);
+
+bool carbon_path_is_array(rec *doc, const char *path);
+bool carbon_path_is_column(rec *doc, const char *path);
+bool carbon_path_is_object(rec *doc, const char *path);
+bool carbon_path_is_container(rec *doc, const char *path);
+bool carbon_path_is_null(rec *doc, const char *path);
+bool carbon_path_is_number(rec *doc, const char *path);
+bool carbon_path_is_boolean(rec *doc, const char *path);
+bool carbon_path_is_string(rec *doc, const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/*
+ * dot - an ast for dot-notated query paths
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_DOT_H
+#define HAD_DOT_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/types.h>
+#include <karbonit/std/string.h>
+#include <karbonit/carbon/arr-it.h>
+#include <karbonit/carbon/col-it.h>
+#include <karbonit/carbon/obj-it.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum dot_node_type {
+        DOT_NODE_IDX,
+        DOT_NODE_KEY
+} dot_node_type_e;
+
+typedef struct dot_node {
+    dot_node_type_e type;
+        union {
+                char *string;
+                u32 idx;
+        } name;
+        /* length of the key (key nodes only) */
+        u32 len;
+} dot_node;
+
+/**
+ * Compiled (i.e., parsed) dot path. Evaluating a path does not modify it, so a path that is compiled once can be
+ * evaluated on any number of records, and by several threads at the same time (see find_from_dot, and the
+ * <code>update_set_*_compiled</code> functions).
+ */
+typedef struct dot {
+        vec ofType(dot_node) nodes;
+} dot;
+
+#define DOT_CACHE_WAYS                  4
+#define DOT_THREAD_CACHE_CAPACITY       256
+
+typedef struct dot_cache_entry {
+        /* the path string, or NULL if the entry is unused */
+        char *str;
+        u64 hash;
+        dot path;
+} dot_cache_entry;
+
+/**
+ * Bounded cache of compiled paths keyed by their path string. The cache is set-associative with DOT_CACHE_WAYS
+ * entries per set; on a miss, the least recently inserted entry of the set is replaced. A cache must not be shared
+ * among threads without synchronization; use <code>dot_thread_cache</code> for a per-thread cache.
+ */
+typedef struct dot_cache {
+        dot_cache_entry *entries;
+        /* per set, the next entry to be replaced */
+        u8 *victims;
+        u32 num_sets;
+} dot_cache;
+
+typedef enum pstatus {
+        PATH_RESOLVED,
+        PATH_EMPTY_DOC,
+        PATH_NOSUCHINDEX,
+        PATH_NOSUCHKEY,
+        PATH_NOTTRAVERSABLE,
+        PATH_NOCONTAINER,
+        PATH_NOTANOBJECT,
+        PATH_NONESTING,
+        PATH_INTERNAL
+} pstatus_e;
+
+bool dot_create(dot *path);
+void dot_clear(dot *path);
+bool dot_from_string(dot *path, const char *path_string);
+bool dot_drop(dot *path);
+void dot_add_key(dot *dst, const char *key);
+void dot_add_nkey(dot *dst, const char *key, size_t len);
+void dot_add_idx(dot *dst, u32 idx);
+bool dot_len(u32 *len, const dot *path);
+bool dot_is_empty(const dot *path);
+bool dot_type_at(dot_node_type_e *type_out, u32 pos, const dot *path);
+bool dot_idx_at(u32 *idx, u32 pos, const dot *path);
+const char *dot_key_at(u32 pos, const dot *path);
+const char *dot_nkey_at(u32 *len, u32 pos, const dot *path);
+bool dot_to_str(str_buf *sb, dot *path);
+bool dot_fprint(FILE *file, dot *path);
+bool dot_print(dot *path);
+
+/**
+ * Creates a cache for (at least) <code>capacity</code> compiled paths
+ */
+bool dot_cache_create(dot_cache *cache, u32 capacity);
+
+/**
+ * Returns the compiled path for <code>path_string</code>, which is compiled on a cache miss. The returned path is
+ * owned by the cache, and valid until the next call to <code>dot_cache_get</code> on the same cache. Returns
+ * <code>NULL</code> if the path string cannot be parsed. For a <code>NULL</code> cache (e.g., if
+ * <code>dot_thread_cache</code> fails), the path is compiled on each call, and is valid until the next such call of
+ * the same thread.
+ */
+const dot *dot_cache_get(dot_cache *cache, const char *path_string);
+bool dot_cache_drop(dot_cache *cache);
+
+/**
+ * Returns the path cache of the calling thread, which is created on the first call and released when the thread
+ * terminates. The cache holds up to DOT_THREAD_CACHE_CAPACITY paths, and is used by all functions that take a path
+ * string (e.g., find_from_string and update_set_u64) such that repeated paths are compiled only once per thread.
+ * Returns <code>NULL</code> if the cache cannot be created, which <code>dot_cache_get</code> accepts.
+ */
+dot_cache *dot_thread_cache(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/*
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/rec.h>
+#include <karbonit/carbon/abstract.h>
+#include <karbonit/mem/memblock.h>
+#include <karbonit/std/uintvar/stream.h>
+
+#ifndef HAD_FIELD_H
+#define HAD_FIELD_H
+
+typedef enum field_type {
+        /** constants */
+        FIELD_NULL = MNULL, /** null */
+        FIELD_TRUE = MTRUE, /** true */
+        FIELD_FALSE = MFALSE, /** false */
+
+        /** containers / abstract base types */
+        FIELD_OBJECT_UNSORTED_MULTIMAP = UNSORTED_MULTIMAP, /** object */
+        FIELD_ARRAY_UNSORTED_MULTISET = UNSORTED_MULTISET_ARRAY, /** variable-type array of elements of varying type */
+        FIELD_COLUMN_U8_UNSORTED_MULTISET = UNSORTED_MULTISET_COL_U8, /** fixed-type array of elements of particular type */
+        FIELD_COLUMN_U16_UNSORTED_MULTISET = UNSORTED_MULTISET_COL_U16, /** fixed-type array of elements of particular type */
+        FIELD_COLUMN_U32_UNSORTED_MULTISET = UNSORTED_MULTISET_COL_U32, /** fixed-type array of elements of particular type */
+        FIELD_COLUMN_U64_UNSORTED_MULTISET = UNSORTED_MULTISET_COL_U64, /** fixed-type array of elements of particular type */
+        FIELD_COLUMN_I8_UNSORTED_MULTISET = UNSORTED_MULTISET_COL_I8, /** fixed-type array of elements of particular type */
+        FIELD_COLUMN_I16_UNSORTED_MULTISET = UNSORTED_MULTISET_COL_I16, /** fixed-type array of elements of particular type */
+        FIELD_COLUMN_I32_UNSORTED_MULTISET = UNSORTED_MULTISET_COL_I32, /** fixed-type array of elements of particular type */
+        FIELD_COLUMN_I64_UNSORTED_MULTISET = UNSORTED_MULTISET_COL_I64, /** fixed-type array of elements of particular type */
+        FIELD_COLUMN_FLOAT_UNSORTED_MULTISET = UNSORTED_MULTISET_COL_FLOAT, /** fixed-type array of elements of particular type */
+        FIELD_COLUMN_BOOLEAN_UNSORTED_MULTISET = UNSORTED_MULTISET_COL_BOOLEAN, /** fixed-type array of elements of particular type */
+
+        /** abstract derived types for object containers */
+        FIELD_DERIVED_OBJECT_SORTED_MULTIMAP = SORTED_MULTIMAP,
+        FIELD_DERIVED_OBJECT_UNSORTED_MAP = UNSORTED_MAP,
+        FIELD_DERIVED_OBJECT_SORTED_MAP = SORTED_MAP,
+
+        /** abstract derived types for array containers */
+        FIELD_DERIVED_ARRAY_SORTED_MULTISET = SORTED_MULTISET_ARRAY,
+        FIELD_DERIVED_ARRAY_UNSORTED_SET = UNSORTED_SET_ARRAY,
+        FIELD_DERIVED_ARRAY_SORTED_SET = SORTED_SET_ARRAY,
+
+        /** abstract derived types for column-u8 containers */
+        FIELD_DERIVED_COLUMN_U8_SORTED_MULTISET = SORTED_MULTISET_COL_U8,
+        FIELD_DERIVED_COLUMN_U8_UNSORTED_SET = UNSORTED_SET_COL_U8,
+        FIELD_DERIVED_COLUMN_U8_SORTED_SET = SORTED_SET_COL_U8,
+
+        /** abstract derived types for column-u16 containers */
+        FIELD_DERIVED_COLUMN_U16_SORTED_MULTISET = SORTED_MULTISET_COL_U16,
+        FIELD_DERIVED_COLUMN_U16_UNSORTED_SET = UNSORTED_SET_COL_U16,
+        FIELD_DERIVED_COLUMN_U16_SORTED_SET = SORTED_SET_COL_U16,
+
+        /** abstract derived types for column-u32 containers */
+        FIELD_DERIVED_COLUMN_U32_SORTED_MULTISET = SORTED_MULTISET_COL_U32,
+        FIELD_DERIVED_COLUMN_U32_UNSORTED_SET = UNSORTED_SET_COL_U32,
+        FIELD_DERIVED_COLUMN_U32_SORTED_SET = SORTED_SET_COL_U32,
+
+        /** abstract derived types for column-u64 containers */
+        FIELD_DERIVED_COLUMN_U64_SORTED_MULTISET = SORTED_MULTISET_COL_U64,
+        FIELD_DERIVED_COLUMN_U64_UNSORTED_SET = UNSORTED_SET_COL_U64,
+        FIELD_DERIVED_COLUMN_U64_SORTED_SET = SORTED_SET_COL_U64,
+
+        /** abstract derived types for column-i8 containers */
+        FIELD_DERIVED_COLUMN_I8_SORTED_MULTISET = SORTED_MULTISET_COL_I8,
+        FIELD_DERIVED_COLUMN_I8_UNSORTED_SET = UNSORTED_SET_COL_I8,
+        FIELD_DERIVED_COLUMN_I8_SORTED_SET = SORTED_SET_COL_I8,
+
+        /** abstract derived types for column-i16 containers */
+        FIELD_DERIVED_COLUMN_I16_SORTED_MULTISET = SORTED_MULTISET_COL_I16,
+        FIELD_DERIVED_COLUMN_I16_UNSORTED_SET = UNSORTED_SET_COL_I16,
+        FIELD_DERIVED_COLUMN_I16_SORTED_SET = SORTED_SET_COL_I16,
+
+        /** abstract derived types for column-i32 containers */
+        FIELD_DERIVED_COLUMN_I32_SORTED_MULTISET = SORTED_MULTISET_COL_I32,
+        FIELD_DERIVED_COLUMN_I32_UNSORTED_SET = UNSORTED_SET_COL_I32,
+        FIELD_DERIVED_COLUMN_I32_SORTED_SET = SORTED_SET_COL_I32,
+
+        /** abstract derived types for column-i64 containers */
+        FIELD_DERIVED_COLUMN_I64_SORTED_MULTISET = SORTED_MULTISET_COL_I64,
+        FIELD_DERIVED_COLUMN_I64_UNSORTED_SET = UNSORTED_SET_COL_I64,
+        FIELD_DERIVED_COLUMN_I64_SORTED_SET = SORTED_SET_COL_I64,
+
+        /** abstract derived types for column-float containers */
+        FIELD_DERIVED_COLUMN_FLOAT_SORTED_MULTISET = SORTED_MULTISET_COL_FLOAT,
+        FIELD_DERIVED_COLUMN_FLOAT_UNSORTED_SET = UNSORTED_SET_COL_FLOAT,
+        FIELD_DERIVED_COLUMN_FLOAT_SORTED_SET = SORTED_SET_COL_FLOAT,
+
+        /** abstract derived types for column-boolean containers */
+        FIELD_DERIVED_COLUMN_BOOLEAN_SORTED_MULTISET = SORTED_MULTISET_COL_BOOLEAN,
+        FIELD_DERIVED_COLUMN_BOOLEAN_UNSORTED_SET = UNSORTED_SET_COL_BOOLEAN,
+        FIELD_DERIVED_COLUMN_BOOLEAN_SORTED_SET = SORTED_SET_COL_BOOLEAN,
+
+        /** character strings */
+        FIELD_STRING = MSTRING, /** UTF-8 str_buf */
+
+        /** numbers */
+        FIELD_NUMBER_U8 = MU8, /** 8bit unsigned integer */
+        FIELD_NUMBER_U16 = MU16, /** 16bit unsigned integer */
+        FIELD_NUMBER_U32 = MU32, /** 32bit unsigned integer */
+        FIELD_NUMBER_U64 = MU64, /** 64bit unsigned integer */
+        FIELD_NUMBER_I8 = MI8, /** 8bit signed integer */
+        FIELD_NUMBER_I16 = MI16, /** 16bit signed integer */
+        FIELD_NUMBER_I32 = MI32, /** 32bit signed integer */
+        FIELD_NUMBER_I64 = MI64, /** 64bit signed integer */
+        FIELD_NUMBER_FLOAT = MFLOAT, /** 32bit float */
+
+        /** binary data */
+        FIELD_BINARY = MBINARY, /** arbitrary binary object with known mime type */
+        FIELD_BINARY_CUSTOM = MCUSTOM_BINARY, /** arbitrary binary object with unknown mime type*/
+} field_e;
+
+typedef enum col_it_type {
+        COLUMN_U8,
+        COLUMN_U16,
+        COLUMN_U32,
+        COLUMN_U64,
+        COLUMN_I8,
+        COLUMN_I16,
+        COLUMN_I32,
+        COLUMN_I64,
+        COLUMN_FLOAT,
+        COLUMN_BOOLEAN
+} col_it_type_e;
+
+typedef enum field_class {
+        CLASS_CONSTANT,
+        CLASS_NUMBER,
+        CLASS_CHARACTER_STRING,
+        CLASS_BINARY_STRING,
+        CLASS_CONTAINER
+} field_class_e;
+
+typedef enum constant {
+        CONST_TRUE,
+        CONST_FALSE,
+        CONST_NULL
+} constant_e;
+
+#define NULL_STR "null"
+#define TRUE_STR "boolean-true"
+#define FALSE_STR "boolean-false"
+#define OBJECT_UNSORTED_MULTIMAP_STR "unsorted-multimap"
+#define OBJECT_SORTED_MULTIMAP_STR "sorted-multimap"
+#define OBJECT_UNSORTED_MAP_STR "unsorted-map"
+#define OBJECT_SORTED_MAP_STR "sorted-map"
+#define ARRAY_UNSORTED_MULTISET_STR "array-unsorted-multiset"
+#define ARRAY_SORTED_MULTISET_STR "array-sorted-multiset"
+#define ARRAY_UNSORTED_SET_STR "array-unsorted-set"
+#define ARRAY_SORTED_SET_STR "array-sorted-set"
+#define COLUMN_U8_UNSORTED_MULTISET_STR "column-u8-unsorted-multiset"
+#define COLUMN_U8_SORTED_MULTISET_STR "column-u8-sorted-multiset"
+#define COLUMN_U8_UNSORTED_SET_STR "column-u8-unsorted-set"
+#define COLUMN_U8_SORTED_SET_STR "column-u8-sorted-set"
+#define COLUMN_U16_UNSORTED_MULTISET_STR "column-u16-unsorted-multiset"
+#define COLUMN_U16_SORTED_MULTISET_STR "column-u16-sorted-multiset"
+#define COLUMN_U16_UNSORTED_SET_STR "column-u16-unsorted-set"
+#define COLUMN_U16_SORTED_SET_STR "column-u16-sorted-set"
+#define COLUMN_U32_UNSORTED_MULTISET_STR "column-u32-unsorted-multiset"
+#define COLUMN_U32_SORTED_MULTISET_STR "column-u32-sorted-multiset"
+#define COLUMN_U32_UNSORTED_SET_STR "column-u32-unsorted-set"
+#define COLUMN_U32_SORTED_SET_STR "column-u32-sorted-set"
+#define COLUMN_U64_UNSORTED_MULTISET_STR "column-u64-unsorted-multiset"
+#define COLUMN_U64_SORTED_MULTISET_STR "column-u64-sorted-multiset"
+#define COLUMN_U64_UNSORTED_SET_STR "column-u64-unsorted-set"
+#define COLUMN_U64_SORTED_SET_STR "column-u64-sorted-set"
+#define COLUMN_I8_UNSORTED_MULTISET_STR "column-i8-unsorted-multiset"
+#define COLUMN_I8_SORTED_MULTISET_STR "column-i8-sorted-multiset"
+#define COLUMN_I8_UNSORTED_SET_STR "column-i8-unsorted-set"
+#define COLUMN_I8_SORTED_SET_STR "column-i8-sorted-set"
+#define COLUMN_I16_UNSORTED_MULTISET_STR "column-i16-unsorted-multiset"
+#define COLUMN_I16_SORTED_MULTISET_STR "column-i16-sorted-multiset"
+#define COLUMN_I16_UNSORTED_SET_STR "column-i16-unsorted-set"
+#define COLUMN_I16_SORTED_SET_STR "column-i16-sorted-set"
+#define COLUMN_I32_UNSORTED_MULTISET_STR "column-i32-unsorted-multiset"
+#define COLUMN_I32_SORTED_MULTISET_STR "column-i32-sorted-multiset"
+#define COLUMN_I32_UNSORTED_SET_STR "column-i32-unsorted-set"
+#define COLUMN_I32_SORTED_SET_STR "column-i32-sorted-set"
+#define COLUMN_I64_UNSORTED_MULTISET_STR "column-i64-unsorted-multiset"
+#define COLUMN_I64_SORTED_MULTISET_STR "column-i64-sorted-multiset"
+#define COLUMN_I64_UNSORTED_SET_STR "column-i64-unsorted-set"
+#define COLUMN_I64_SORTED_SET_STR "column-i64-sorted-set"
+#define COLUMN_FLOAT_UNSORTED_MULTISET_STR "column-float-unsorted-multiset"
+#define COLUMN_FLOAT_SORTED_MULTISET_STR "column-float-sorted-multiset"
+#define COLUMN_FLOAT_UNSORTED_SET_STR "column-float-unsorted-set"
+#define COLUMN_FLOAT_SORTED_SET_STR "column-float-sorted-set"
+#define COLUMN_BOOLEAN_UNSORTED_MULTISET_STR "column-boolean-unsorted-multiset"
+#define COLUMN_BOOLEAN_SORTED_MULTISET_STR "column-boolean-sorted-multiset"
+#define COLUMN_BOOLEAN_UNSORTED_SET_STR "column-boolean-unsorted-set"
+#define COLUMN_BOOLEAN_SORTED_SET_STR "column-boolean-sorted-set"
+#define STRING_STR "string"
+#define BINARY_STR "binary"
+#define NUMBER_U8_STR "number-u8"
+#define NUMBER_U16_STR "number-u16"
+#define NUMBER_U32_STR "number-u32"
+#define NUMBER_U64_STR "number-u64"
+#define NUMBER_I8_STR "number-i8"
+#define NUMBER_I16_STR "number-i16"
+#define NUMBER_I32_STR "number-i32"
+#define NUMBER_I64_STR "number-i64"
+#define NUMBER_FLOAT_STR "number-float"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+const char *field_str(field_e type);
+
+field_class_e field_get_class(field_e type);
+
+bool carbon_field_skip(memfile *file);
+
+bool carbon_field_skip_object(memfile *file, u8 marker);
+bool carbon_field_skip_array(memfile *file, u8 marker);
+bool carbon_field_skip_column(memfile *file);
+bool carbon_field_skip_binary(memfile *file);
+bool carbon_field_skip_custom_binary(memfile *file);
+bool carbon_field_skip_string(memfile *file);
+bool carbon_field_skip_float(memfile *file);
+bool carbon_field_skip_boolean(memfile *file);
+bool carbon_field_skip_null(memfile *file);
+bool carbon_field_skip_8(memfile *file);
+bool carbon_field_skip_16(memfile *file);
+bool carbon_field_skip_32(memfile *file);
+bool carbon_field_skip_64(memfile *file);
+
+#define CARBON_FIELD_SKIP_BINARY__FAST(memfile, field)                                                                \
+        /** skip blob */                                                                \
+        MEMFILE_SKIP__UNSAFE((memfile), (field)->len);
+
+#define CARBON_FIELD_SKIP_CUSTOM_BINARY__FAST(memfile, field)                                                                \
+        /** skip blob */                                                                \
+        MEMFILE_SKIP__UNSAFE((memfile), (field)->len);
+
+#define CARBON_FIELD_SKIP_STRING__FAST(memfile, field)                                                                \
+        /** skip blob */                                                                \
+        MEMFILE_SKIP__UNSAFE((memfile), (field)->len);
+
+#define CARBON_FIELD_SKIP_FLOAT__FAST(memfile)                                                                \
+        MEMFILE_SKIP__UNSAFE((memfile), sizeof(float));
+
+#define CARBON_FIELD_SKIP_8__FAST(memfile)                                                                \
+        MEMFILE_SKIP__UNSAFE((memfile), sizeof(u8));
+
+#define CARBON_FIELD_SKIP_16__FAST(memfile)                                                                \
+        MEMFILE_SKIP__UNSAFE((memfile), sizeof(u16));
+
+#define CARBON_FIELD_SKIP_32__FAST(memfile)                                                                \
+        MEMFILE_SKIP__UNSAFE((memfile), sizeof(u32));
+
+#define CARBON_FIELD_SKIP_64__FAST(memfile)                                                                 \
+        MEMFILE_SKIP__UNSAFE((memfile), sizeof(u64));
+
+field_e field_for_column(list_type_e derivation, col_it_type_e type);
+field_e field_column_entry_to_regular_type(field_e type, bool is_null, bool is_true);
+
+
+
+#define FIELD_IS_TRAVERSABLE(_field_e_type_)                                                                             \
+        (FIELD_IS_OBJECT_OR_SUBTYPE(_field_e_type_) ||                                                                   \
+         FIELD_IS_LIST_OR_SUBTYPE(_field_e_type_))
+
+#define FIELD_IS_SIGNED(_field_e_type_)                                                                                  \
+        ((_field_e_type_ == FIELD_NUMBER_I8 || _field_e_type_ == FIELD_NUMBER_I16 ||                                       \
+          _field_e_type_ == FIELD_NUMBER_I32 || _field_e_type_ == FIELD_NUMBER_I64 ||                                      \
+          _field_e_type_ == FIELD_COLUMN_I8_UNSORTED_MULTISET ||                                                         \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_I8_SORTED_MULTISET ||                                                   \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_I8_UNSORTED_SET ||                                                      \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_I8_SORTED_SET ||                                                        \
+          _field_e_type_ == FIELD_COLUMN_I16_UNSORTED_MULTISET ||                                                        \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_I16_SORTED_MULTISET ||                                                  \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_I16_UNSORTED_SET ||                                                     \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_I16_SORTED_SET ||                                                       \
+          _field_e_type_ == FIELD_COLUMN_I32_UNSORTED_MULTISET ||                                                        \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_I32_SORTED_MULTISET ||                                                  \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_I32_UNSORTED_SET ||                                                     \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_I32_SORTED_SET ||                                                       \
+          _field_e_type_ == FIELD_COLUMN_I64_UNSORTED_MULTISET ||                                                        \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_I64_SORTED_MULTISET ||                                                  \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_I64_UNSORTED_SET ||                                                     \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_I64_SORTED_SET))
+
+#define FIELD_IS_UNSIGNED(_field_e_type_)                                                                                \
+        ((_field_e_type_ == FIELD_NUMBER_U8 || _field_e_type_ == FIELD_NUMBER_U16 ||                                       \
+          _field_e_type_ == FIELD_NUMBER_U32 || _field_e_type_ == FIELD_NUMBER_U64 ||                                      \
+          _field_e_type_ == FIELD_COLUMN_U8_UNSORTED_MULTISET ||                                                         \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_U8_SORTED_MULTISET ||                                                   \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_U8_UNSORTED_SET ||                                                      \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_U8_SORTED_SET ||                                                        \
+          _field_e_type_ == FIELD_COLUMN_U16_UNSORTED_MULTISET ||                                                        \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_U16_SORTED_MULTISET ||                                                  \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_U16_UNSORTED_SET ||                                                     \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_U16_SORTED_SET ||                                                       \
+          _field_e_type_ == FIELD_COLUMN_U32_UNSORTED_MULTISET ||                                                        \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_U32_SORTED_MULTISET ||                                                  \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_U32_UNSORTED_SET ||                                                     \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_U32_SORTED_SET ||                                                       \
+          _field_e_type_ == FIELD_COLUMN_U64_UNSORTED_MULTISET ||                                                        \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_U64_SORTED_MULTISET ||                                                  \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_U64_UNSORTED_SET ||                                                     \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_U64_SORTED_SET))
+
+#define FIELD_IS_FLOATING(_field_e_type_)                                                                                \
+        ((_field_e_type_ == FIELD_NUMBER_FLOAT || _field_e_type_ == FIELD_COLUMN_FLOAT_UNSORTED_MULTISET ||                \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_FLOAT_SORTED_MULTISET ||                                                \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_FLOAT_UNSORTED_SET ||                                                   \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_FLOAT_SORTED_SET))
+
+#define FIELD_IS_NUMBER(_field_e_type_)                                                                                  \
+        (FIELD_IS_INTEGER(_field_e_type_) || FIELD_IS_FLOATING(_field_e_type_))
+
+#define FIELD_IS_INTEGER(_field_e_type_)                                                                                 \
+        (FIELD_IS_SIGNED(_field_e_type_) || FIELD_IS_UNSIGNED(_field_e_type_))
+
+#define FIELD_IS_BINARY(_field_e_type_)                                                                                  \
+        ((_field_e_type_ == FIELD_BINARY || _field_e_type_ == FIELD_BINARY_CUSTOM))
+
+#define FIELD_IS_BOOLEAN(_field_e_type_)                                                                                 \
+        ((_field_e_type_ == FIELD_TRUE || _field_e_type_ == FIELD_FALSE ||                                                 \
+          _field_e_type_ == FIELD_COLUMN_BOOLEAN_UNSORTED_MULTISET ||                                                    \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_BOOLEAN_SORTED_MULTISET ||                                              \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_BOOLEAN_UNSORTED_SET ||                                                 \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_BOOLEAN_SORTED_SET))
+
+#define FIELD_IS_STRING(_field_e_type_)                                                                                  \
+        (_field_e_type_ == FIELD_STRING)
+
+#define FIELD_IS_CONSTANT(_field_e_type_)                                                                                \
+        ((FIELD_IS_NULL(_field_e_type_) || FIELD_IS_BOOLEAN(_field_e_type_)))
+
+#define FIELD_IS_ARRAY_OR_SUBTYPE(_field_e_type_)                                                                        \
+        ((_field_e_type_ == FIELD_ARRAY_UNSORTED_MULTISET || _field_e_type_ == FIELD_DERIVED_ARRAY_SORTED_MULTISET ||      \
+          _field_e_type_ == FIELD_DERIVED_ARRAY_UNSORTED_SET || _field_e_type_ == FIELD_DERIVED_ARRAY_SORTED_SET))
+
+#define FIELD_IS_COLUMN_U8_OR_SUBTYPE(_field_e_type_)                                                                    \
+        ((_field_e_type_ == FIELD_COLUMN_U8_UNSORTED_MULTISET ||                                                         \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_U8_SORTED_MULTISET ||                                                   \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_U8_UNSORTED_SET ||                                                      \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_U8_SORTED_SET))
+
+#define FIELD_IS_COLUMN_U16_OR_SUBTYPE(_field_e_type_)                                                                   \
+        ((_field_e_type_ == FIELD_COLUMN_U16_UNSORTED_MULTISET ||                                                        \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_U16_SORTED_MULTISET ||                                                  \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_U16_UNSORTED_SET ||                                                     \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_U16_SORTED_SET))
+
+#define FIELD_IS_COLUMN_U32_OR_SUBTYPE(_field_e_type_)                                                                   \
+        ((_field_e_type_ == FIELD_COLUMN_U32_UNSORTED_MULTISET ||                                                        \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_U32_SORTED_MULTISET ||                                                  \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_U32_UNSORTED_SET ||                                                     \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_U32_SORTED_SET))
+
+#define FIELD_IS_COLUMN_U64_OR_SUBTYPE(_field_e_type_)                                                                   \
+        ((_field_e_type_ == FIELD_COLUMN_U64_UNSORTED_MULTISET ||                                                        \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_U64_SORTED_MULTISET ||                                                  \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_U64_UNSORTED_SET ||                                                     \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_U64_SORTED_SET))
+
+#define FIELD_IS_COLUMN_I8_OR_SUBTYPE(_field_e_type_)                                                                    \
+        ((_field_e_type_ == FIELD_COLUMN_I8_UNSORTED_MULTISET ||                                                         \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_I8_SORTED_MULTISET ||                                                   \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_I8_UNSORTED_SET ||                                                      \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_I8_SORTED_SET))
+
+#define FIELD_IS_COLUMN_I16_OR_SUBTYPE(_field_e_type_)                                                                   \
+        ((_field_e_type_ == FIELD_COLUMN_I16_UNSORTED_MULTISET ||                                                        \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_I16_SORTED_MULTISET ||                                                  \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_I16_UNSORTED_SET ||                                                     \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_I16_SORTED_SET))
+
+#define FIELD_IS_COLUMN_I32_OR_SUBTYPE(_field_e_type_)                                                                   \
+        ((_field_e_type_ == FIELD_COLUMN_I32_UNSORTED_MULTISET ||                                                        \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_I32_SORTED_MULTISET ||                                                  \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_I32_UNSORTED_SET ||                                                     \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_I32_SORTED_SET))
+
+#define FIELD_IS_COLUMN_I64_OR_SUBTYPE(_field_e_type_)                                                                   \
+        ((_field_e_type_ == FIELD_COLUMN_I64_UNSORTED_MULTISET ||                                                        \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_I64_SORTED_MULTISET ||                                                  \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_I64_UNSORTED_SET ||                                                     \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_I64_SORTED_SET))
+
+#define FIELD_IS_COLUMN_FLOAT_OR_SUBTYPE(_field_e_type_)                                                                 \
+        ((_field_e_type_ == FIELD_COLUMN_FLOAT_UNSORTED_MULTISET ||                                                      \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_FLOAT_SORTED_MULTISET ||                                                \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_FLOAT_UNSORTED_SET ||                                                   \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_FLOAT_SORTED_SET))
+
+#define FIELD_IS_COLUMN_BOOL_OR_SUBTYPE(_field_e_type_)                                                                  \
+        ((_field_e_type_ == FIELD_COLUMN_BOOLEAN_UNSORTED_MULTISET ||                                                    \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_BOOLEAN_SORTED_MULTISET ||                                              \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_BOOLEAN_UNSORTED_SET ||                                                 \
+          _field_e_type_ == FIELD_DERIVED_COLUMN_BOOLEAN_SORTED_SET))
+
+#define FIELD_IS_LIST_OR_SUBTYPE(_field_e_type_)                                                                         \
+        (FIELD_IS_ARRAY_OR_SUBTYPE(_field_e_type_) || FIELD_IS_COLUMN_OR_SUBTYPE(_field_e_type_))
+
+#define FIELD_IS_COLUMN_OR_SUBTYPE(_field_e_type_)                                                                       \
+        (FIELD_IS_COLUMN_U8_OR_SUBTYPE(_field_e_type_) ||                                                                \
+         FIELD_IS_COLUMN_U16_OR_SUBTYPE(_field_e_type_) ||                                                               \
+         FIELD_IS_COLUMN_U32_OR_SUBTYPE(_field_e_type_) ||                                                               \
+         FIELD_IS_COLUMN_U64_OR_SUBTYPE(_field_e_type_) ||                                                               \
+         FIELD_IS_COLUMN_I8_OR_SUBTYPE(_field_e_type_) ||                                                                \
+         FIELD_IS_COLUMN_I16_OR_SUBTYPE(_field_e_type_) ||                                                               \
+         FIELD_IS_COLUMN_I32_OR_SUBTYPE(_field_e_type_) ||                                                               \
+         FIELD_IS_COLUMN_I64_OR_SUBTYPE(_field_e_type_) ||                                                               \
+         FIELD_IS_COLUMN_FLOAT_OR_SUBTYPE(_field_e_type_) ||                                                             \
+         FIELD_IS_COLUMN_BOOL_OR_SUBTYPE(_field_e_type_))
+
+#define FIELD_IS_OBJECT_OR_SUBTYPE(_field_e_type_)                                                                       \
+        ((_field_e_type_ == FIELD_OBJECT_UNSORTED_MULTIMAP || _field_e_type_ == FIELD_DERIVED_OBJECT_SORTED_MULTIMAP ||    \
+          _field_e_type_ == FIELD_DERIVED_OBJECT_UNSORTED_MAP ||                                                         \
+          _field_e_type_ == FIELD_DERIVED_OBJECT_SORTED_MAP))
+
+#define FIELD_IS_NULL(_field_e_type_)                                                                                    \
+        (_field_e_type_ == FIELD_NULL)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/*
+ * find - finding fields inside a carbon file by a dot-notated query path
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_FIND_H
+#define HAD_FIND_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/rec.h>
+#include <karbonit/carbon/col-it.h>
+#include <karbonit/carbon/arr-it.h>
+#include <karbonit/carbon/obj-it.h>
+#include <karbonit/carbon/container.h>
+#include <karbonit/carbon/dot.h>
+#include <karbonit/carbon/dot-eval.h>
+#include <karbonit/std/uintvar/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct find {
+        rec *doc;
+        field_e type;
+        dot_eval eval;
+        union {
+                arr_it array;
+                col_it column;
+                obj_it object;
+                bool boolean;
+                u64 unsigned_number;
+                i64 signed_number;
+                float float_number;
+                string_field string;
+                binary_field binary;
+        } value;
+} find;
+
+bool find_from_string(find *out, const char *dot, rec *doc);
+bool find_from_dot(find *out, const dot *path, rec *doc);
+
+/**
+ * Evaluates the path as <code>find_from_dot</code> does, but accesses elements of arrays that are indexed in
+ * <code>skips</code> (if non-null) by seeking instead of stepping over all elements before them.
+ */
+bool find_from_dot_indexed(find *out, const dot *path, rec *doc, const skip_index *skips);
+
+/**
+ * Evaluates the path as <code>find_from_dot</code> does, but jumps to the result by means of the path index
+ * <code>index</code> (if non-null) if that index was created for the revision of <code>doc</code>.
+ */
+bool find_from_dot_pindexed(find *out, const dot *path, rec *doc, pindex *index);
+bool internal_find_exec(find *find, const dot *path, rec *doc);
+
+/**
+ * Populates the result of <code>find</code> from its evaluation state, for which the result container is already set
+ * if the path was resolved. Returns true if the path was resolved.
+ */
+bool internal_find_from_eval(find *find);
+
+bool find_has_result(find *find);
+const char *find_result_to_str(str_buf *dst_str, find *find);
+
+bool find_result_type(field_e *type, find *find);
+
+bool find_update_array_type(find *find, list_type_e derivation);
+bool find_array_is_multiset(find *find);
+bool find_array_is_sorted(find *find);
+
+bool find_update_column_type(find *find, list_type_e derivation);
+bool find_column_is_multiset(find *find);
+bool find_column_is_sorted(find *find);
+
+bool find_update_object_type(find *find, map_type_e derivation);
+bool find_object_is_multimap(find *find);
+bool find_object_is_sorted(find *find);
+
+bool find_multimap(find *find);
+bool find_multiset(find *find);
+bool find_sorted(find *find);
+
+bool find_result_is_array(find *find);
+bool find_result_is_object(find *find);
+bool find_result_is_column(find *find);
+bool find_result_is_boolean(find *find);
+bool find_result_is_undefined(find *find);
+bool find_result_is_unsigned(find *find);
+bool find_result_is_signed(find *find);
+bool find_result_is_float(find *find);
+bool find_result_is_null(find *find);
+bool find_result_is_string(find *find);
+bool find_result_is_binary(find *find);
+
+arr_it *find_result_array(find *find);
+obj_it *find_result_object(find *find);
+col_it *find_result_column(find *find);
+bool find_result_boolean(bool *result, find *find);
+bool find_result_unsigned(u64 *out, find *find);
+bool find_result_signed(i64 *out, find *find);
+bool find_result_float(float *out, find *find);
+const char *find_result_string(u64 *str_len, find *find);
+binary_field *find_result_binary(find *find);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/*
+ * handle - shared record handle with atomic publishing of revisions
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_HANDLE_H
+#define HAD_HANDLE_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/rec.h>
+#include <karbonit/carbon/revise.h>
+#include <karbonit/std/epoch.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A record that is shared by threads, of which readers take snapshots without locks while writers replace the record
+ * by revisions of it.
+ *
+ * Readers and writers access the handle inside read-side critical sections of the handle's epoch, i.e., a thread
+ * registers once by <code>epoch_register(&handle->reclaim)</code>, and brackets snapshots, the use of snapshots,
+ * and publishing by <code>epoch_enter</code> and <code>epoch_leave</code>. A snapshot is a single atomic load, and
+ * is a view of the record that stays unchanged even if a revision is published meanwhile. A writer revises a snapshot
+ * (see <code>revise_begin_copy</code>), and publishes the revised record only if the record was not replaced since
+ * the snapshot, which is detected by a compare-and-swap of the current record, and, for writers that know only the
+ * commit hash of the record they revised, by its commit hash (see <code>rec_commit_hash</code>). Replaced records
+ * are dropped once no thread accesses them anymore (see <code>epoch_retire</code>).
+ */
+typedef struct handle {
+        _Atomic(rec *) current;
+        epoch reclaim;
+} handle;
+
+/**
+ * Creates a handle for the record <code>doc</code>, which the handle takes over.
+ */
+bool handle_create(handle *handle, rec *doc);
+
+/**
+ * Drops the handle, its record, and all replaced records. No thread must be in a critical section.
+ */
+bool handle_drop(handle *handle);
+
+/**
+ * Makes <code>view</code> a read-only view (see <code>rec_view</code>) of the current record, which is valid until
+ * the caller leaves its critical section.
+ */
+bool handle_snapshot(rec *view, handle *handle);
+
+/**
+ * Replaces the current record by <code>revised</code> if the commit hash of the current record is
+ * <code>expected_hash</code>, i.e., if no other writer published a revision since the caller took the snapshot that
+ * <code>revised</code> is a revision of. The handle takes over <code>revised</code> on success. Otherwise, the function
+ * returns <code>false</code> without setting an error and the caller keeps <code>revised</code>, which it drops or
+ * recreates from a new snapshot. Must be called inside a critical section. Records without primary key have no commit
+ * hash (see <code>rec_create_begin</code>), such that a conflict cannot be detected by it; for these, the function
+ * fails with <code>ERR_ILLEGALARG</code>, and their revisions are published by <code>handle_revise_end</code>.
+ */
+bool handle_publish(handle *handle, rec *revised, u64 expected_hash);
+
+/**
+ * Ends the revision <code>context</code> of a snapshot (see <code>revise_begin_copy</code>) as
+ * <code>revise_end</code> does, and publishes the revised record (see <code>handle_publish</code>) if the current
+ * record is still the one of the snapshot. Returns <code>false</code> if another revision was published meanwhile, in
+ * which case the revised record is not dropped. Must be called inside the critical section in which the snapshot was
+ * taken.
+ */
+bool handle_revise_end(handle *handle, rev *context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/*
+ * insert - container insert operations
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_INSERT_H
+#define HAD_INSERT_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/mem/memblock.h>
+#include <karbonit/mem/memfile.h>
+#include <karbonit/std/spinlock.h>
+#include <karbonit/rec.h>
+#include <karbonit/carbon/internal.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  public interface
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool insert_null(insert *in);
+bool insert_true(insert *in);
+bool insert_false(insert *in);
+bool insert_u8(insert *in, u8 value);
+bool insert_u16(insert *in, u16 value);
+bool insert_u32(insert *in, u32 value);
+bool insert_u64(insert *in, u64 value);
+bool insert_i8(insert *in, i8 value);
+bool insert_i16(insert *in, i16 value);
+bool insert_i32(insert *in, i32 value);
+bool insert_i64(insert *in, i64 value);
+bool insert_unsigned(insert *in, u64 value);
+bool insert_signed(insert *in, i64 value);
+bool insert_float(insert *in, float value);
+bool insert_string(insert *in, const char *value);
+bool insert_nchar(insert *in, const char *value, u64 value_len);
+
+/**
+ * Inserts the <code>num_values</code> values in <code>values</code>, one after another. Null values are given by the
+ * null value of their type; for booleans, the values are <code>CARBON_BOOLEAN_COLUMN_*</code> bytes. If <code>in</code>
+ * inserts into an unsorted column, the column grows at most once, and the values are copied with a single write. Into
+ * sorted columns and arrays, the values are inserted one by one, where null values become null fields in arrays.
+ * Nothing is inserted into a column of another element type, which fails with <code>ERR_TYPEMISMATCH</code>.
+ */
+bool insert_boolean_values(insert *in, const boolean *values, u32 num_values);
+bool insert_u8_values(insert *in, const u8 *values, u32 num_values);
+bool insert_u16_values(insert *in, const u16 *values, u32 num_values);
+bool insert_u32_values(insert *in, const u32 *values, u32 num_values);
+bool insert_u64_values(insert *in, const u64 *values, u32 num_values);
+bool insert_i8_values(insert *in, const i8 *values, u32 num_values);
+bool insert_i16_values(insert *in, const i16 *values, u32 num_values);
+bool insert_i32_values(insert *in, const i32 *values, u32 num_values);
+bool insert_i64_values(insert *in, const i64 *values, u32 num_values);
+bool insert_float_values(insert *in, const float *values, u32 num_values);
+
+bool insert_from_carbon(); // TODO: Implement P2
+bool insert_from_array(); // TODO: Implement P2
+bool insert_from_object(); // TODO: Implement P2
+bool insert_from_column(); // TODO: Implement P2
+
+/**
+ * Inserts a user-defined binary string <code>value</code> of <code>nbytes</code> bytes along with a (mime) type annotation.
+ * The type annotation is automatically found if <code>file_ext</code> is non-null and known to the system. If it is
+ * not known or null, the non-empty <code>user_type</code> string is used to encode the mime annotation. In case
+ * <code>user_type</code> is null (or empty) and <code>file_ext</code> is null (or not known), the mime type is set to
+ * <code>application/octet-stream</code>, which encodes arbitrary binary data.
+ */
+bool insert_binary(insert *in, const void *value, size_t nbytes, const char *file_ext, const char *user_type);
+
+insert *insert_object_begin(obj_state *out, insert *in, u64 object_capacity);
+bool insert_object_end(obj_state *state);
+
+insert *insert_object_map_begin(obj_state *out, insert *in,
+                                              map_type_e derivation, u64 object_capacity);
+bool insert_object_map_end(obj_state *state);
+
+insert *insert_array_begin(arr_state *state_out, insert *inserter_in, u64 array_capacity);
+bool insert_array_end(arr_state *state_in);
+
+insert *insert_array_list_begin(arr_state *state_out, insert *inserter_in, list_type_e derivation, u64 array_capacity);
+bool insert_array_list_end(arr_state *state_in);
+
+insert *insert_column_begin(col_state *state_out, insert *inserter_in, col_it_type_e type, u64 cap);
+bool insert_column_end(col_state *state_in);
+
+insert *insert_column_list_begin(col_state *state_out, insert *inserter_in, list_type_e derivation, col_it_type_e type, u64 cap);
+bool insert_column_list_end(col_state *state_in);
+
+bool insert_prop_null(insert *in, const char *key);
+bool insert_prop_true(insert *in, const char *key);
+bool insert_prop_false(insert *in, const char *key);
+bool insert_prop_u8(insert *in, const char *key, u8 value);
+bool insert_prop_u16(insert *in, const char *key, u16 value);
+bool insert_prop_u32(insert *in, const char *key, u32 value);
+bool insert_prop_u64(insert *in, const char *key, u64 value);
+bool insert_prop_i8(insert *in, const char *key, i8 value);
+bool insert_prop_i16(insert *in, const char *key, i16 value);
+bool insert_prop_i32(insert *in, const char *key, i32 value);
+bool insert_prop_i64(insert *in, const char *key, i64 value);
+bool insert_prop_unsigned(insert *in, const char *key, u64 value);
+bool insert_prop_signed(insert *in, const char *key, i64 value);
+bool insert_prop_float(insert *in, const char *key, float value);
+bool insert_prop_string(insert *in, const char *key, const char *value);
+bool insert_prop_nchar(insert *in, const char *key, const char *value, u64 value_len);
+bool insert_prop_binary(insert *in, const char *key, const void *value, size_t nbytes, const char *file_ext, const char *user_type);
+
+bool insert_prop_from_carbon(); // TODO: Implement P2
+bool insert_prop_from_array(); // TODO: Implement P2
+bool insert_prop_from_object(); // TODO: Implement P2
+bool insert_prop_from_column(); // TODO: Implement P2
+
+insert *insert_prop_object_begin(obj_state *out, insert *in, const char *key, u64 object_capacity);
+u64 insert_prop_object_end(obj_state *state);
+
+insert *insert_prop_map_begin(obj_state *out, insert *in, map_type_e derivation, const char *key, u64 object_capacity);
+u64 insert_prop_map_end(obj_state *state);
+
+insert *insert_prop_array_begin(arr_state *state, insert *in, const char *key, u64 array_capacity);
+u64 insert_prop_array_end(arr_state *state);
+
+insert *insert_prop_column_begin(col_state *state_out, insert *inserter_in, const char *key, col_it_type_e type, u64 cap);
+u64 insert_prop_column_end(col_state *state_in);
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  for internal usage only
+// ---------------------------------------------------------------------------------------------------------------------
+
+void internal_insert_create_for_array(insert *in, arr_it *context);
+bool internal_insert_create_for_column(insert *in, col_it *context);
+bool internal_insert_create_for_object(insert *in, obj_it *context);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/*
+ * shared internal usage - do not use for public purposes
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_INTERNAL_H
+#define HAD_INTERNAL_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/mem/memfile.h>
+#include <karbonit/std/uintvar/stream.h>
+#include <karbonit/json/json-parser.h>
+#include <karbonit/carbon/internal.h>
+#include <karbonit/carbon/container.h>
+#include <karbonit/carbon/field.h>
+#include <karbonit/carbon/arr-it.h>
+#include <karbonit/carbon/abstract.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct insert {
+        container_e context_type;
+        union {
+                arr_it *array;
+                col_it *column;
+                obj_it *object;
+        } context;
+        memfile file;
+        offset_t position;
+} insert;
+
+typedef struct arr_state {
+        insert *parent;
+        arr_it *array;
+        insert nested;
+        offset_t begin, end;
+} arr_state;
+
+typedef struct obj_state {
+        insert *parent;
+        obj_it *it;
+        insert in;
+        offset_t begin, end;
+} obj_state;
+
+typedef struct col_state {
+        insert *parent;
+        field_e type;
+        col_it *nested_column;
+        insert nested;
+        offset_t begin, end;
+} col_state;
+
+bool internal_insert_object(memfile *file, map_type_e derivation, size_t nbytes);
+bool internal_insert_array(memfile *file, list_type_e derivation, size_t nbytes);
+bool internal_insert_column(memfile *file, list_type_e derivation, col_it_type_e type, size_t capactity);
+
+/**
+ * Returns the number of bytes required to store a field type including its type marker in a byte sequence.
+ */
+#define INTERNAL_GET_TYPE_SIZE_ENCODED(field_e)                                                                        \
+({                                                                                                                     \
+        size_t type_size = sizeof(u8); /** at least the media type marker is required */                               \
+        switch (field_e) {                                                                                             \
+                case FIELD_NULL:                                                                                       \
+                case FIELD_TRUE:                                                                                       \
+                case FIELD_FALSE:                                                                                      \
+                        /** only media type marker is required */                                                      \
+                        break;                                                                                         \
+                case FIELD_NUMBER_U8:                                                                                  \
+                case FIELD_NUMBER_I8:                                                                                  \
+                        type_size += sizeof(u8);                                                                       \
+                        break;                                                                                         \
+                case FIELD_NUMBER_U16:                                                                                 \
+                case FIELD_NUMBER_I16:                                                                                 \
+                        type_size += sizeof(u16);                                                                      \
+                        break;                                                                                         \
+                case FIELD_NUMBER_U32:                                                                                 \
+                case FIELD_NUMBER_I32:                                                                                 \
+                        type_size += sizeof(u32);                                                                      \
+                        break;                                                                                         \
+                case FIELD_NUMBER_U64:                                                                                 \
+                case FIELD_NUMBER_I64:                                                                                 \
+                        type_size += sizeof(u64);                                                                      \
+                        break;                                                                                         \
+                case FIELD_NUMBER_FLOAT:                                                                               \
+                        type_size += sizeof(float);                                                                    \
+                        break;                                                                                         \
+                default: ERROR(ERR_INTERNALERR, NULL);                                                                 \
+                        type_size = 0;                                                                                 \
+                        break;                                                                                         \
+        }                                                                                                              \
+        type_size;                                                                                                     \
+})
+
+/**
+ * Returns the number of bytes required to store a field value of a particular type excluding its type marker.
+ */
+#define INTERNAL_GET_TYPE_VALUE_SIZE(field_e)                                                                          \
+({                                                                         \
+        size_t internal_get_type_value_size_result = 0;                                                                         \
+        switch (field_e) {                                                                         \
+                case FIELD_NULL:                                                                         \
+                case FIELD_TRUE:                                                                         \
+                case FIELD_FALSE:                                                                         \
+                case FIELD_COLUMN_BOOLEAN_UNSORTED_MULTISET:                                                                         \
+                case FIELD_DERIVED_COLUMN_BOOLEAN_SORTED_MULTISET:                                                                         \
+                case FIELD_DERIVED_COLUMN_BOOLEAN_UNSORTED_SET:                                                                         \
+                case FIELD_DERIVED_COLUMN_BOOLEAN_SORTED_SET:                                                                         \
+                        /** these constant values are determined by their media type markers */                                                                         \
+                        internal_get_type_value_size_result = sizeof(u8);                                                                         \
+                        break;                                                                         \
+                case FIELD_NUMBER_U8:                                                                         \
+                case FIELD_NUMBER_I8:                                                                         \
+                case FIELD_COLUMN_U8_UNSORTED_MULTISET:                                                                         \
+                case FIELD_DERIVED_COLUMN_U8_SORTED_MULTISET:                                                                         \
+                case FIELD_DERIVED_COLUMN_U8_UNSORTED_SET:                                                                         \
+                case FIELD_DERIVED_COLUMN_U8_SORTED_SET:                                                                         \
+                case FIELD_COLUMN_I8_UNSORTED_MULTISET:                                                                         \
+                case FIELD_DERIVED_COLUMN_I8_SORTED_MULTISET:                                                                         \
+                case FIELD_DERIVED_COLUMN_I8_UNSORTED_SET:                                                                         \
+                case FIELD_DERIVED_COLUMN_I8_SORTED_SET:                                                                         \
+                        internal_get_type_value_size_result = sizeof(u8);                                                                         \
+                        break;                                                                         \
+                case FIELD_NUMBER_U16:                                                                         \
+                case FIELD_NUMBER_I16:                                                                         \
+                case FIELD_COLUMN_U16_UNSORTED_MULTISET:                                                                         \
+                case FIELD_DERIVED_COLUMN_U16_SORTED_MULTISET:                                                                         \
+                case FIELD_DERIVED_COLUMN_U16_UNSORTED_SET:                                                                         \
+                case FIELD_DERIVED_COLUMN_U16_SORTED_SET:                                                                         \
+                case FIELD_COLUMN_I16_UNSORTED_MULTISET:                                                                         \
+                case FIELD_DERIVED_COLUMN_I16_SORTED_MULTISET:                                                                         \
+                case FIELD_DERIVED_COLUMN_I16_UNSORTED_SET:                                                                         \
+                case FIELD_DERIVED_COLUMN_I16_SORTED_SET:                                                                         \
+                        internal_get_type_value_size_result = sizeof(u16);                                                                         \
+                        break;                                                                         \
+                case FIELD_NUMBER_U32:                                                                         \
+                case FIELD_NUMBER_I32:                                                                         \
+                case FIELD_COLUMN_U32_UNSORTED_MULTISET:                                                                         \
+                case FIELD_DERIVED_COLUMN_U32_SORTED_MULTISET:                                                                         \
+                case FIELD_DERIVED_COLUMN_U32_UNSORTED_SET:                                                                         \
+                case FIELD_DERIVED_COLUMN_U32_SORTED_SET:                                                                         \
+                case FIELD_COLUMN_I32_UNSORTED_MULTISET:                                                                         \
+                case FIELD_DERIVED_COLUMN_I32_SORTED_MULTISET:                                                                         \
+                case FIELD_DERIVED_COLUMN_I32_UNSORTED_SET:                                                                         \
+                case FIELD_DERIVED_COLUMN_I32_SORTED_SET:                                                                         \
+                        internal_get_type_value_size_result = sizeof(u32);                                                                         \
+                        break;                                                                         \
+                case FIELD_NUMBER_U64:                                                                         \
+                case FIELD_NUMBER_I64:                                                                         \
+                case FIELD_COLUMN_U64_UNSORTED_MULTISET:                                                                         \
+                case FIELD_DERIVED_COLUMN_U64_SORTED_MULTISET:                                                                         \
+                case FIELD_DERIVED_COLUMN_U64_UNSORTED_SET:                                                                         \
+                case FIELD_DERIVED_COLUMN_U64_SORTED_SET:                                                                         \
+                case FIELD_COLUMN_I64_UNSORTED_MULTISET:                                                                         \
+                case FIELD_DERIVED_COLUMN_I64_SORTED_MULTISET:                                                                         \
+                case FIELD_DERIVED_COLUMN_I64_UNSORTED_SET:                                                                         \
+                case FIELD_DERIVED_COLUMN_I64_SORTED_SET:                                                                         \
+                        internal_get_type_value_size_result = sizeof(u64);                                                                         \
+                        break;                                                                         \
+                case FIELD_NUMBER_FLOAT:                                                                         \
+                case FIELD_COLUMN_FLOAT_UNSORTED_MULTISET:                                                                         \
+                case FIELD_DERIVED_COLUMN_FLOAT_SORTED_MULTISET:                                                                         \
+                case FIELD_DERIVED_COLUMN_FLOAT_UNSORTED_SET:                                                                         \
+                case FIELD_DERIVED_COLUMN_FLOAT_SORTED_SET:                                                                         \
+                        internal_get_type_value_size_result = sizeof(float);                                                                         \
+                        break;                                                                         \
+                default:                                                                         \
+                        ERROR(ERR_INTERNALERR, NULL);                                                                         \
+                        break;                                                                         \
+        }                                                                         \
+        internal_get_type_value_size_result;                                                                         \
+})
+
+bool internal_array_refresh(bool *is_empty_slot, bool *is_array_end, arr_it *it);
+bool internal_array_field_read(arr_it *it);
+bool internal_array_skip_contents(bool *is_empty_slot, bool *is_array_end, arr_it *it);
+
+bool internal_object_it_next(bool *is_empty_slot, bool *is_object_end, obj_it *it);
+bool internal_object_it_refresh(bool *is_empty_slot, bool *is_object_end, obj_it *it);
+bool internal_object_it_prop_key_access(obj_it *it);
+bool internal_object_it_prop_value_skip(obj_it *it);
+bool internal_object_it_prop_skip(obj_it *it);
+bool internal_object_skip_contents(bool *is_empty_slot, bool *is_array_end, obj_it *it);
+bool internal_field_data_access(memfile *file, field *field);
+
+offset_t internal_column_get_payload_off(col_it *it);
+
+#define INTERNAL_PAYLOAD_AFTER_HEADER(rec)                                                                             \
+        ((rec)->data_off)
+
+
+u64 internal_header_get_commit_hash(rec *doc);
+
+void internal_history_push(vec ofType(offset_t) *vec, offset_t off);
+void internal_history_clear(vec ofType(offset_t) *vec);
+offset_t internal_history_pop(vec ofType(offset_t) *vec);
+offset_t internal_history_peek(vec ofType(offset_t) *vec);
+bool internal_history_has(vec ofType(offset_t) *vec);
+
+bool internal_field_clone(field *dst, field *src);
+
+#define INTERNAL_FIELD_AUTO_CLOSE(field)                                                                               \
+{                                                                                                                      \
+        if ((field)->arr_it.created && !(field)->arr_it.accessed) {                                                    \
+                internal_auto_close_nested_array(field);                                                               \
+                (field)->arr_it.created = false;                                                                       \
+                (field)->arr_it.accessed = false;                                                                      \
+        }                                                                                                              \
+        if ((field)->obj_it.created && !(field)->obj_it.accessed) {                                                    \
+                internal_auto_close_nested_object_it(field);                                                           \
+                (field)->obj_it.created = false;                                                                       \
+                (field)->obj_it.accessed = false;                                                                      \
+        }                                                                                                              \
+        if ((field)->col_it_created) {                                                                                 \
+                internal_auto_close_nested_column_it((field));                                                         \
+                (field)->obj_it.created = false;                                                                       \
+        }                                                                                                              \
+}
+
+bool internal_field_field_type(field_e *type, field *field);
+bool internal_field_bool_value(bool *value, field *field);
+bool internal_field_is_null(bool *is_null, field *field);
+
+#define INTERNAL_FIELD_U8_VALUE(field)                                                                             \
+        (*(u8 *) field->data)
+
+#define INTERNAL_FIELD_U16_VALUE(field)                                                                             \
+        (*(u16 *) field->data)
+
+#define INTERNAL_FIELD_U32_VALUE(field)                                                                             \
+        (*(u32 *) field->data)
+
+#define INTERNAL_FIELD_U64_VALUE(field)                                                                             \
+        (*(u64 *) field->data)
+
+#define INTERNAL_FIELD_I8_VALUE(field)                                                                             \
+        (*(i8 *) field->data)
+
+#define INTERNAL_FIELD_I16_VALUE(field)                                                                             \
+        (*(i16 *) field->data)
+
+#define INTERNAL_FIELD_I32_VALUE(field)                                                                             \
+        (*(i32 *) field->data)
+
+#define INTERNAL_FIELD_I64_VALUE(field)                                                                             \
+        (*(i64 *) field->data)
+
+#define INTERNAL_FIELD_FLOAT_VALUE(field)                                                                             \
+        (*(float *) field->data)
+
+
+#define INTERNAL_FIELD_SIGNED_VALUE(field)                                                                            \
+({                                                                                                               \
+        i64 ret = 0;                                                                            \
+        switch (field->type) {                                                                            \
+                case FIELD_NUMBER_I8:   ret = INTERNAL_FIELD_I8_VALUE(field);                                                                            \
+                        break;                                                                            \
+                case FIELD_NUMBER_I16:  ret = INTERNAL_FIELD_I16_VALUE(field);                                                                            \
+                        break;                                                                            \
+                case FIELD_NUMBER_I32:  ret = INTERNAL_FIELD_I32_VALUE(field);                                                                            \
+                        break;                                                                            \
+                case FIELD_NUMBER_I64:  ret = INTERNAL_FIELD_I64_VALUE(field);                                                                            \
+                        break;                                                                            \
+                default: ERROR(ERR_TYPEMISMATCH, NULL);                                                                            \
+                        ret = 0;                                                                            \
+                        break;                                                                            \
+        }                                                                                                        \
+        ret;                                                                                                     \
+})
+
+#define INTERNAL_FIELD_UNSIGNED_VALUE(field)                                                                            \
+({                                                                            \
+        u64 ret = 0;                                                                            \
+        switch (field->type) {                                                                            \
+                case FIELD_NUMBER_U8:  ret = INTERNAL_FIELD_U8_VALUE(field);                                                                            \
+                        break;                                                                            \
+                case FIELD_NUMBER_U16: ret = INTERNAL_FIELD_U16_VALUE(field);                                                                            \
+                        break;                                                                            \
+                case FIELD_NUMBER_U32: ret = INTERNAL_FIELD_U32_VALUE(field);                                                                            \
+                        break;                                                                            \
+                case FIELD_NUMBER_U64: ret = INTERNAL_FIELD_U64_VALUE(field);                                                                            \
+                        break;                                                                            \
+                default: ERROR(ERR_TYPEMISMATCH, NULL);                                                                            \
+                        ret = 0;                                                                            \
+                        break;                                                                            \
+        }                                                                            \
+        ret;                                                                            \
+})
+
+const char *internal_field_string_value(u64 *strlen, field *field);
+bool internal_field_binary_value(binary_field *out, field *field);
+
+bool internal_field_remove(memfile *memfile, field_e type);
+
+/**
+ * For <code>mode</code>, see <code>rec_create_begin</code>
+ */
+void internal_from_json(rec *doc, const json *data, key_e rec_key_type, const void *primary_key, int mode);
+
+/**
+ * Converts the JSON document <code>json</code> into the same record as <code>internal_from_json</code> does for its
+ * AST, but inserts into the record while tokenizing <code>json</code>, without a token stream or an AST. Only the
+ * values of an array that may become a column are held until the end of the array. Returns false, and leaves
+ * <code>doc</code> uninitialized, if <code>json</code> is not a valid JSON document.
+ */
+bool internal_from_json_stream(rec *doc, const char *json, key_e rec_key_type, const void *primary_key, int mode);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/*
+ * item - a thing that is returned by array and object iterators
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_ITEM_H
+#define HAD_ITEM_H
+
+#include <karbonit/stdinc.h>
+#include <karbonit/types.h>
+#include <karbonit/forwdecl.h>
+#include <karbonit/carbon/container.h>
+#include <karbonit/carbon/binary.h>
+#include <karbonit/carbon/string-field.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum item_type
+{
+    ITEM_UNDEF,
+    ITEM_NULL,
+    ITEM_TRUE,
+    ITEM_FALSE,
+    ITEM_STRING,
+    ITEM_NUMBER_SIGNED,
+    ITEM_NUMBER_UNSIGNED,
+    ITEM_NUMBER_FLOAT,
+    ITEM_BINARY,
+    ITEM_ARRAY,
+    ITEM_COLUMN,
+    ITEM_OBJECT
+} item_type_e;
+
+typedef struct item
+{
+    untyped_e parent_type;
+    union {
+        arr_it *array;
+        obj_it *object;
+    } parent;
+    u64 idx;
+
+    item_type_e value_type;
+    union {
+        i64 number_signed;
+        u64 number_unsigned;
+        float number_float;
+        string_field string;
+        binary_field binary;
+    } value;
+} item;
+
+#define INTERNAL_ITEM_IS_TYPE(item, type)                                                                       \
+        (ITEM_GET_TYPE(item) == type)
+
+#define INTERNAL_ITEM_GET_VALUE(item, member, default_value)                                                    \
+        ((item) ? (item)->value.member : default_value)
+
+#define ITEM_IS_FIELD(item)                                                                                     \
+        ((item) ? (item)->parent_type == UNTYPED_ARRAY : false)
+
+#define ITEM_IS_PROP(item)                                                                                      \
+        ((item) ? (item)->parent_type == UNTYPED_OBJECT : false)
+
+#define ITEM_GET_TYPE(item)                                                                                     \
+        ((item) ? (item)->value_type : ITEM_UNDEF)
+
+#define ITEM_IS_UNDEF(item)                                                                                     \
+        INTERNAL_ITEM_IS_TYPE(item, ITEM_UNDEF)
+
+#define ITEM_IS_NULL(item)                                                                                      \
+        INTERNAL_ITEM_IS_TYPE(item, ITEM_NULL)
+
+#define ITEM_IS_TRUE(item)                                                                                      \
+        INTERNAL_ITEM_IS_TYPE(item, ITEM_TRUE)
+
+#define ITEM_IS_FALSE(item)                                                                                     \
+        INTERNAL_ITEM_IS_TYPE(item, ITEM_FALSE)
+
+#define ITEM_IS_BOOLEAN(item)                                                                                   \
+        (ITEM_IS_TRUE(item) || ITEM_IS_FALSE(item))
+
+#define ITEM_IS_STRING(item)                                                                                    \
+        INTERNAL_ITEM_IS_TYPE(item, ITEM_STRING)
+
+#define ITEM_IS_SIGNED(item)                                                                                    \
+        INTERNAL_ITEM_IS_TYPE(item, ITEM_NUMBER_SIGNED)
+
+#define ITEM_IS_UNSIGNED(item)                                                                                  \
+        INTERNAL_ITEM_IS_TYPE(item, ITEM_NUMBER_UNSIGNED)
+
+#define ITEM_IS_FLOAT(item)                                                                                     \
+        INTERNAL_ITEM_IS_TYPE(item, ITEM_NUMBER_FLOAT)
+
+#define ITEM_IS_NUMBER(item)                                                                                    \
+        (ITEM_IS_SIGNED(item) || ITEM_IS_UNSIGNED(item) || ITEM_IS_FLOAT(item))
+
+#define ITEM_IS_BINARY(item)                                                                                    \
+        INTERNAL_ITEM_IS_TYPE(item, ITEM_BINARY)
+
+#define ITEM_IS_ARRAY(item)                                                                                     \
+        INTERNAL_ITEM_IS_TYPE(item, ITEM_ARRAY)
+
+#define ITEM_IS_COLUMN(item)                                                                                    \
+        INTERNAL_ITEM_IS_TYPE(item, ITEM_COLUMN)
+
+#define ITEM_IS_OBJECT(item)                                                                                    \
+        INTERNAL_ITEM_IS_TYPE(item, ITEM_OBJECT)
+
+#define ITEM_GET_INDEX(item)                                                                                    \
+        ((item) ? (item)->idx : 0)
+
+#define ITEM_GET_NUMBER_SIGNED(item, default_value)                                                             \
+        INTERNAL_ITEM_GET_VALUE(item, number_signed, default_value)
+
+#define ITEM_GET_NUMBER_UNSIGNED(item, default_value)                                                           \
+        INTERNAL_ITEM_GET_VALUE(item, number_unsigned, default_value)
+
+#define ITEM_GET_NUMBER_FLOAT(item, default_value)                                                              \
+        INTERNAL_ITEM_GET_VALUE(item, number_float, default_value)
+
+#define ITEM_GET_STRING(item, default_value)                                                                    \
+        INTERNAL_ITEM_GET_VALUE(item, string, default_value)
+
+#define ITEM_GET_BINARY(item, default_value)                                                                    \
+        INTERNAL_ITEM_GET_VALUE(item, binary, default_value)
+
+#define INTERNAL_ITEM_GET_ITERATOR(it, item, create_fn)                                                                 \
+        if (LIKELY((item)->parent_type == UNTYPED_ARRAY)) {                                                                                   \
+                create_fn((it), &((item)->parent.object->file), (item)->parent.array->field_offset);                                                                                        \
+        } else {                                                                                   \
+                create_fn((it), &((item)->parent.array->file), (item)->parent.object->field.value.start);                                                                                      \
+        }
+
+#define ITEM_GET_ARRAY(it, item)                                                                                    \
+        INTERNAL_ITEM_GET_ITERATOR(it, item, internal_arr_it_create)
+
+#define ITEM_GET_COLUMN(it, item)                                                                                   \
+        INTERNAL_ITEM_GET_ITERATOR(it, item, col_it_create)
+
+#define ITEM_GET_OBJECT(it, item)                                                                                   \
+        INTERNAL_ITEM_GET_ITERATOR(it, item, internal_obj_it_create)
+
+#define ITEM_REMOVE(item)                                                                                       \
+        ((item)->parent == UNTYPED_ARRAY ? internal_arr_it_remove((item)->parent.array) :                  \
+                                                 internal_obj_it_remove((item)->parent.object))
+
+#define ITEM_SET_NULL(item)                                                                                     \
+        ((item)->parent == UNTYPED_ARRAY ? internal_arr_it_update_null((item)->parent.array) :             \
+                                                 internal_obj_it_update_null((item)->parent.object))            \
+
+#define ITEM_SET_TRUE(item)                                                                                     \
+        ((item)->parent == UNTYPED_ARRAY ? internal_arr_it_update_true((item)->parent.array) :             \
+                                                 internal_obj_it_update_true((item)->parent.object))
+
+#define ITEM_SET_FALSE(item)                                                                                    \
+        ((item)->parent == UNTYPED_ARRAY ? internal_arr_it_update_false((item)->parent.array) :            \
+                                                 internal_obj_it_update_false((item)->parent.object)
+
+#define ITEM_SET_NUMBER_FLOAT(item, float_value)                                                                \
+        ((item)->parent == UNTYPED_ARRAY ? internal_arr_it_update_float((item)->parent.array, float_value):\
+                                                 internal_obj_it_update_float((item)->parent.object, float_value))
+
+#define ITEM_SET_NUMBER_SIGNED(item, i64_value)                                                                 \
+({                                                                                                                     \
+        bool ret = false;                                                                                              \
+        switch (number_min_type_signed(value)) {                                                                       \
+                case NUMBER_I8:                                                                                        \
+                        ret = ((item)->parent == UNTYPED_ARRAY ?                                                 \
+                                        internal_arr_it_update_i8(subj->parent.array, (i8) i64_value) :          \
+                                        internal_obj_it_update_i8(subj->parent.object, (i8) i64_value));        \
+                break;                                                                                                 \
+                case NUMBER_I16:                                                                                       \
+                        ret = ((item)->parent == UNTYPED_ARRAY ?                                                 \
+                                        internal_arr_it_update_i16(subj->parent.array, (i16) i64_value) :        \
+                                        internal_obj_it_update_i16(subj->parent.object, (i16) i64_value));      \
+                break;                                                                                                 \
+                case NUMBER_I32:                                                                                       \
+                        ret = ((item)->parent == UNTYPED_ARRAY ?                                                 \
+                                        internal_arr_it_update_i32(subj->parent.array, (i32) i64_value) :        \
+                                        internal_obj_it_update_i32(subj->parent.object, (i32) i64_value));      \
+                break;                                                                                                 \
+                case NUMBER_I64:                                                                                       \
+                        ret = ((item)->parent == UNTYPED_ARRAY ?                                                 \
+                                        internal_arr_it_update_i64(subj->parent.array, i64_value) :              \
+                                        internal_obj_it_update_i64(subj->parent.ojbect, i64_value) :            \
+                break;                                                                                                 \
+                default:                                                                                               \
+                        ERROR(ERR_INTERNALERR, NULL)                                                                   \
+                break;                                                                                                 \
+        }                                                                                                              \
+        ret;                                                                                                           \
+})
+
+#define ITEM_SET_NUMBER_UNSIGNED(item, u64_value)                                                               \
+({                                                                                                                     \
+        bool ret = false;                                                                                              \
+        switch (number_min_type_unsigned(value)) {                                                                     \
+                case NUMBER_U8:                                                                                        \
+                        ret = ((item)->parent == UNTYPED_ARRAY ?                                                 \
+                                        internal_arr_it_update_u8(subj->parent.array, (u8) u64_value) :          \
+                                        internal_obj_it_update_u8(subj->parent.object, (u8) u64_value));        \
+                break;                                                                                                 \
+                case NUMBER_U16:                                                                                       \
+                        ret = ((item)->parent == UNTYPED_ARRAY ?                                                 \
+                                        internal_arr_it_update_u16(subj->parent.array, (u16) u64_value) :        \
+                                        internal_obj_it_update_u16(subj->parent.object, (u16) u64_value));      \
+                break;                                                                                                 \
+                case NUMBER_U32:                                                                                       \
+                        ret = ((item)->parent == UNTYPED_ARRAY ?                                                 \
+                                        internal_arr_it_update_u32(subj->parent.array, (u32) u64_value) :        \
+                                        internal_obj_it_update_u32(subj->parent.object, (u32) u64_value));      \
+                break;                                                                                                 \
+                case NUMBER_U64:                                                                                       \
+                        ret = ((item)->parent == UNTYPED_ARRAY ?                                                 \
+                                        internal_arr_it_update_u64(subj->parent.array, u64_value) :              \
+                                        internal_obj_it_update_u64(subj->parent.object, u64_value) :            \
+                break;                                                                                                 \
+                default:                                                                                               \
+                        ERROR(ERR_INTERNALERR, NULL)                                                                   \
+                break;                                                                                                 \
+        }                                                                                                              \
+        ret;                                                                                                           \
+})
+
+#define ITEM_SET_STRING(item, const_char_str)                                                                   \
+        ((item)->parent == UNTYPED_ARRAY ?                                                                       \
+                                internal_arr_it_update_string((item)->parent.array, const_char_str) :            \
+                                internal_obj_it_update_string((item)->parent.object, const_char_str))
+
+#define ITEM_SET_BINARY(item, const_void_ptr_value, size_t_nbytes, const_char_ptr_file_ext,                     \
+                               const_char_ptr_user_type)                                                               \
+        ((item)->parent == UNTYPED_ARRAY ?                                                                       \
+                                internal_arr_it_update_binary((item)->parent.array, const_void_ptr_value,        \
+                                                                    size_t_nbytes, const_char_ptr_file_ext,            \
+                                                                    const_char_ptr_user_type) :                        \
+                                internal_obj_it_update_binary((item)->parent.object, const_void_ptr_value,      \
+                                                                    size_t_nbytes, const_char_ptr_file_ext,            \
+                                                                    const_char_ptr_user_type))
+
+#define ITEM_SET_ARRAY_BEGIN(state, item)                                                                       \
+        ((item)->parent == UNTYPED_ARRAY ?                                                                       \
+                                internal_arr_it_update_array_begin((state), (item)->parent.array) :              \
+                                internal_obj_it_update_array_begin((state), (item)->parent.object))             \
+
+#define ITEM_SET_ARRAY_END(state)                                                                               \
+        ((item)->parent == UNTYPED_ARRAY ?                                                                       \
+                                internal_arr_it_update_array_end((state)) :                                      \
+                                internal_obj_it_update_array_end((state)))
+
+#define ITEM_SET_COLUMN_BEGIN(state, item)                                                                      \
+        ((item)->parent == UNTYPED_ARRAY ?                                                                       \
+                                internal_arr_it_update_column_begin((state), (item)->parent.array) :             \
+                                internal_obj_it_update_column_begin((state), (item)->parent.object))
+
+#define ITEM_SET_COLUMN_END(state)                                                                              \
+        ((item)->parent == UNTYPED_ARRAY ?                                                                       \
+                                internal_arr_it_update_column_end((state)) :                                     \
+                                internal_obj_it_update_column_end((state)))
+
+#define ITEM_SET_OBJECT_BEGIN(state, item)                                                                      \
+        ((item)->parent == UNTYPED_ARRAY ?                                                                       \
+                                internal_arr_it_update_object_begin((state), (item)->parent.array) :             \
+                                internal_obj_it_update_object_begin((state), (item)->parent.object))
+
+#define ITEM_SET_OBJECT_END(state)                                                                              \
+        ((item)->parent == UNTYPED_ARRAY ?                                                                       \
+                                internal_arr_it_update_object_end((state)) :                                     \
+                                internal_obj_it_update_object_end((state))
+
+#define ITEM_SET_FROM_REC(item, const_carbon_ptr_src)                                                        \
+        ((item)->parent == UNTYPED_ARRAY ?                                                                       \
+                                internal_arr_it_update_from_carbon((item)->parent.array, const_carbon_ptr_src) : \
+                                internal_obj_it_update_from_carbon((item)->parent.object, const_carbon_ptr_src))
+
+#define ITEM_SET_FROM_ARRAY(item, const_arr_it_ptr_src)                                                   \
+        ((item)->parent == UNTYPED_ARRAY ?                                                                       \
+                                internal_arr_it_update_from_array((item)->>parent.array,                         \
+                                                                        const_arr_it_ptr_src) :                  \
+                                internal_obj_it_update_from_array((item)->>parent.object,                       \
+                                                                        const_arr_it_ptr_src))
+
+#define ITEM_SET_FROM_OBJECT(item, const_obj_it_ptr_src)                                                 \
+        ((item)->parent == UNTYPED_ARRAY ?                                                                       \
+                                internal_arr_it_update_from_object((item)->parent.array,                         \
+                                                                         const_obj_it_ptr_src) :                \
+                                internal_obj_it_update_from_object((item)->parent.object,                       \
+                                                                         const_obj_it_ptr_src))
+
+#define ITEM_SET_FROM_COLUMN(item, const_col_it_ptr_src)                                                 \
+        ((item)->parent == UNTYPED_ARRAY ?                                                                       \
+                                internal_arr_it_update_from_column((item)->parent.array,                         \
+                                                                         const_col_it_ptr_src) :                \
+                                internal_obj_it_update_from_column((item)->parent.object,                       \
+                                                                         const_col_it_ptr_src))
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  for internal usage
+// ---------------------------------------------------------------------------------------------------------------------
+
+
+#define ITEM_SETUP_VALUE(item, field_type, field)                                                               \
+({                                                               \
+        bool status = true;                                                            \
+        if (FIELD_IS_SIGNED(field_type) && !FIELD_IS_LIST_OR_SUBTYPE(field_type)) {                                                               \
+                (item)->value.number_signed = INTERNAL_FIELD_SIGNED_VALUE((field));                                                               \
+                (item)->value_type = ITEM_NUMBER_SIGNED;                                                               \
+        } else if (FIELD_IS_UNSIGNED(field_type) && !FIELD_IS_LIST_OR_SUBTYPE(field_type)) {                                                               \
+                (item)->value.number_unsigned = INTERNAL_FIELD_UNSIGNED_VALUE((field));                                                               \
+                (item)->value_type = ITEM_NUMBER_UNSIGNED;                                                               \
+        } else if (FIELD_IS_FLOATING(field_type) && !FIELD_IS_LIST_OR_SUBTYPE(field_type)) {                                                               \
+                (item)->value.number_float = INTERNAL_FIELD_FLOAT_VALUE((field));                                                               \
+                (item)->value_type = ITEM_NUMBER_FLOAT;                                                               \
+        } else if (FIELD_IS_BINARY(field_type)) {                                                               \
+                internal_field_binary_value(&(item)->value.binary, (field));                                                               \
+                (item)->value_type = ITEM_BINARY;                                                               \
+        } else if (FIELD_IS_BOOLEAN(field_type) && !FIELD_IS_LIST_OR_SUBTYPE(field_type)) {                                                               \
+                (item)->value_type = field_type == FIELD_TRUE ? ITEM_TRUE : ITEM_FALSE;                                                               \
+        } else if (FIELD_IS_ARRAY_OR_SUBTYPE(field_type)) {                                                               \
+                (item)->value_type = ITEM_ARRAY;                                                               \
+        } else if (FIELD_IS_COLUMN_OR_SUBTYPE(field_type)) {                                                               \
+                (item)->value_type = ITEM_COLUMN;                                                               \
+        } else if (FIELD_IS_OBJECT_OR_SUBTYPE(field_type)) {                                                               \
+                (item)->value_type = ITEM_OBJECT;                                                               \
+        } else if (FIELD_IS_NULL(field_type)) {                                                               \
+                (item)->value_type = ITEM_NULL;                                                               \
+        } else if (FIELD_IS_STRING(field_type)) {                                                               \
+                (item)->value.string.str = internal_field_string_value(&(item)->value.string.len, (field));                                                               \
+                (item)->value_type = ITEM_STRING;                                                               \
+        } else {                                                               \
+                (item)->value_type = ITEM_UNDEF;                                                               \
+                status = false;                                                               \
+        }                                                               \
+        status;                                                               \
+})
+
+#define INTERNAL_ITEM_CREATE_FROM_ARRAY(item, parent_arr_it, pos, field, field_type)                                                   \
+({                                                                                                       \
+        (item)->parent_type = UNTYPED_ARRAY;                                                              \
+        (item)->parent.array = parent_arr_it;                                                                  \
+        (item)->idx = (pos);                                                                        \
+        ITEM_SETUP_VALUE((item), (field_type), (field));                                           \
+})
+
+bool internal_item_create_from_object(item *item, obj_it *parent);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/*
+ * key - low-level key operations
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_KEY_H
+#define HAD_KEY_H
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/rec.h>
+#include <karbonit/mem/memfile.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool key_create(memfile *file, key_e type);
+bool key_skip(key_e *out, memfile *file);
+bool key_read_type(key_e *out, memfile *file);
+bool key_write_unsigned(memfile *file, u64 key);
+bool key_write_signed(memfile *file, i64 key);
+bool key_write_string(memfile *file, const char *key);
+bool key_update_string(memfile *file, const char *key);
+bool key_update_string_wnchar(memfile *file, const char *key, size_t length);
+const void *key_read(u64 *len, key_e *out, memfile *file);
+const char *key_type_str(key_e type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * markers - encoding for marker-based format
+ * see carbonspec.org/format-specs/format-overview/marker-format.html
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_MARKERS_H
+#define HAD_MARKERS_H
+
+#include <karbonit/stdinc.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** data type marker */
+#define MNULL                        'n'
+#define MTRUE                        't'
+#define MFALSE                       'f'
+#define MSTRING                      's'
+#define MU8                          'c'
+#define MU16                         'd'
+#define MU32                         'i'
+#define MU64                         'l'
+#define MI8                          'C'
+#define MI16                         'D'
+#define MI32                         'I'
+#define MI64                         'L'
+#define MFLOAT                       'r'
+#define MBINARY                      'b'
+#define MCUSTOM_BINARY               'x'
+
+/** container marker */
+#define MOBJECT_BEGIN                '{'
+#define MOBJECT_END                  '}'
+#define MARRAY_BEGIN                 '['
+#define MARRAY_END                   ']'
+#define MCOLUMN_U8                   '1'
+#define MCOLUMN_U16                  '2'
+#define MCOLUMN_U32                  '3'
+#define MCOLUMN_U64                  '4'
+#define MCOLUMN_I8                   '5'
+#define MCOLUMN_I16                  '6'
+#define MCOLUMN_I32                  '7'
+#define MCOLUMN_I64                  '8'
+#define MCOLUMN_FLOAT                'R'
+#define MCOLUMN_BOOLEAN              'B'
+
+/** record identifier marker */
+#define MNOKEY                       '?'
+#define MAUTOKEY                     '*'
+#define MUKEY                        '+'
+#define MIKEY                        '-'
+#define MSKEY                        '!'
+
+/** abstract types for object containers */
+#define MUNSORTED_MULTIMAP           MOBJECT_BEGIN
+#define MSORTED_MULTIMAP             '~'
+#define MUNSORTED_MAP                ':'
+#define MSORTED_MAP                  '#'
+
+/** abstract types for array containers */
+#define MUNSORTED_MULTISET_ARR       MARRAY_BEGIN
+#define MSORTED_MULTISET_ARR         '<'
+#define MUNSORTED_SET_ARR            '/'
+#define MSORTED_SET_ARR              '='
+
+/** abstract types for column-u8 containers */
+#define MUNSORTED_MULTISET_U8        MCOLUMN_U8
+#define MSORTED_MULTISET_U8          0x01 /** SOH */
+#define MUNSORTED_SET_U8             0x02 /** STX */
+#define MSORTED_SET_U8               0x03 /** ETX */
+
+/** abstract types for column-u16 containers */
+#define MUNSORTED_MULTISET_U16       MCOLUMN_U16
+#define MSORTED_MULTISET_U16         0x05 /** ENQ */
+#define MUNSORTED_SET_U16            0x06 /** ACK */
+#define MSORTED_SET_U16              0x07 /** BEL */
+
+/** abstract types for column-u32 containers */
+#define MUNSORTED_MULTISET_U32       MCOLUMN_U32
+#define MSORTED_MULTISET_U32         0x09 /** TAB */
+#define MUNSORTED_SET_U32            0x0A /** LF */
+#define MSORTED_SET_U32              0x0B /** VT */
+
+/** abstract types for column-u64 containers */
+#define MUNSORTED_MULTISET_U64       MCOLUMN_U64
+#define MSORTED_MULTISET_U64         0x0D /** CR */
+#define MUNSORTED_SET_U64            0x0E /** SO */
+#define MSORTED_SET_U64              0x0F /** SI */
+
+/** abstract types for column-i8 containers */
+#define MUNSORTED_MULTISET_I8        MCOLUMN_I8
+#define MSORTED_MULTISET_I8          0x11 /** DC1 */
+#define MUNSORTED_SET_I8             0x12 /** DC2 */
+#define MSORTED_SET_I8               0x13 /** DC3 */
+
+/** abstract types for column-i16 containers */
+#define MUNSORTED_MULTISET_I16       MCOLUMN_I16
+#define MSORTED_MULTISET_I16         0x15 /** NAK */
+#define MUNSORTED_SET_I16            0x16 /** SYN */
+#define MSORTED_SET_I16              0x17 /** ETB */
+
+/** abstract types for column-i32 containers */
+#define MUNSORTED_MULTISET_I32       MCOLUMN_I32
+#define MSORTED_MULTISET_I32         0x19 /** EM */
+#define MUNSORTED_SET_I32            0x1A /** SUB */
+#define MSORTED_SET_I32              0x1B /** ESC */
+
+/** abstract types for column-i64 containers */
+#define MUNSORTED_MULTISET_I64       MCOLUMN_I64
+#define MSORTED_MULTISET_I64         0x1D /** GS */
+#define MUNSORTED_SET_I64            0x1E /** RS */
+#define MSORTED_SET_I64              0x1F /** US */
+
+/** abstract types for column-float containers */
+#define MUNSORTED_MULTISET_FLOAT    MCOLUMN_FLOAT
+#define MSORTED_MULTISET_FLOAT      '"'
+#define MUNSORTED_SET_FLOAT         '$'
+#define MSORTED_SET_FLOAT           '.'
+
+/** abstract types for column-boolean containers */
+#define MUNSORTED_MULTISET_BOOLEAN  MCOLUMN_BOOLEAN
+#define MSORTED_MULTISET_BOOLEAN    '_'
+#define MUNSORTED_SET_BOOLEAN       '\''
+#define MSORTED_SET_BOOLEAN         0x7F /** DEL */
+
+#define MERR -1
+
+void markers_print(str_buf *dst, rec *src);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/*
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_MIME_H
+#define HAD_MIME_H
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/mem/memfile.h>
+#include <karbonit/rec.h>
+#include <karbonit/carbon/field.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef u8 media_type; /** byte to determine type at hand (e.g., JSON array, str_buf, null, ...) */
+
+static struct mime {
+        const char *type;
+        const char *ext;
+
+} global_mime_register[] = { /** the entries in this list must be sorted by extension! */
+        {"application/vnd.lotus-1-2-3",                                               "123"},
+        {"text/vnd.in3d.3dml",                                                        "3dml"},
+        {"video/3gpp2",                                                               "3g2"},
+        {"video/3gpp",                                                                "3gp"},
+        {"application/x-7z-compressed",                                               "7z"},
+        {"application/x-authorware-bin",                                              "aab"},
+        {"audio/x-aac",                                                               "aac"},
+        {"application/x-authorware-map",                                              "aam"},
+        {"application/x-authorware-seg",                                              "aas"},
+        {"application/x-abiword",                                                     "abw"},
+        {"application/pkix-attr-cert",                                                "ac"},
+        {"application/vnd.americandynamics.acc",                                      "acc"},
+        {"application/x-ace-compressed",                                              "ace"},
+        {"application/vnd.acucobol",                                                  "acu"},
+        {"audio/adpcm",                                                               "adp"},
+        {"application/vnd.audiograph",                                                "aep"},
+        {"application/vnd.ibm.modcap",                                                "afp"},
+        {"application/vnd.ahead.space",                                               "ahead"},
+        {"application/postscript",                                                    "ai"},
+        {"audio/x-aiff",                                                              "aif"},
+        {"application/vnd.adobe.air-application-installer-package+zip",               "air"},
+        {"application/vnd.dvb.ait",                                                   "ait"},
+        {"application/vnd.amiga.ami",                                                 "ami"},
+        {"application/vnd.android.package-archive",                                   "apk"},
+        {"application/x-ms-application",                                              "application"},
+        {"application/vnd.lotus-approach",                                            "apr"},
+        {"video/x-ms-asf",                                                            "asf"},
+        {"application/vnd.accpac.simply.aso",                                         "aso"},
+        {"application/vnd.acucorp",                                                   "atc"},
+        {"application/atom+xml",                                                      "atom"},
+        {"application/atomcat+xml",                                                   "atomcat"},
+        {"application/atomsvc+xml",                                                   "atomsvc"},
+        {"application/vnd.antix.game-component",                                      "atx"},
+        {"audio/basic",                                                               "au"},
+        {"video/x-msvideo",                                                           "avi"},
+        {"application/applixware",                                                    "aw"},
+        {"application/vnd.airzip.filesecure.azf",                                     "azf"},
+        {"application/vnd.airzip.filesecure.azs",                                     "azs"},
+        {"application/vnd.amazon.ebook",                                              "azw"},
+        {"application/x-bcpio",                                                       "bcpio"},
+        {"application/x-font-bdf",                                                    "bdf"},
+        {"application/vnd.syncml.dm+wbxml",                                           "bdm"},
+        {"application/vnd.realvnc.bed",                                               "bed"},
+        {"application/vnd.fujitsu.oasysprs",                                          "bh2"},
+        {"application/octet-stream",                                                  "bin"},
+        {"application/vnd.bmi",                                                       "bmi"},
+        {"image/bmp",                                                                 "bmp"},
+        {"application/vnd.previewsystems.box",                                        "box"},
+        {"image/prs.btif",                                                            "btif"},
+        {"application/x-bzip",                                                        "bz"},
+        {"application/x-bzip2",                                                       "bz2"},
+        {"text/x-c",                                                                  "c"},
+        {"application/vnd.cluetrust.cartomobile-config",                              "c11amc"},
+        {"application/vnd.cluetrust.cartomobile-config-pkg",                          "c11amz"},
+        {"application/vnd.clonk.c4group",                                             "c4g"},
+        {"application/vnd.ms-cab-compressed",                                         "cab"},
+        {"application/vnd.curl.car",                                                  "car"},
+        {"application/vnd.ms-pki.seccat",                                             "cat"},
+        {"application/vnd.contact.cmsg",                                              "cdbcmsg"},
+        {"application/vnd.mediastation.cdkey",                                        "cdkey"},
+        {"application/cdmi-capability",                                               "cdmia"},
+        {"application/cdmi-container",                                                "cdmic"},
+        {"application/cdmi-domain",                                                   "cdmid"},
+        {"application/cdmi-object",                                                   "cdmio"},
+        {"application/cdmi-queue",                                                    "cdmiq"},
+        {"chemical/x-cdx",                                                            "cdx"},
+        {"application/vnd.chemdraw+xml",                                              "cdxml"},
+        {"application/vnd.cinderella",                                                "cdy"},
+        {"application/pkix-cert",                                                     "cer"},
+        {"image/cgm",                                                                 "cgm"},
+        {"application/x-chat",                                                        "chat"},
+        {"application/vnd.ms-htmlhelp",                                               "chm"},
+        {"application/vnd.kde.kchart",                                                "chrt"},
+        {"chemical/x-cif",                                                            "cif"},
+        {"application/vnd.anser-web-certificate-issue-initiation",                    "cii"},
+        {"application/vnd.ms-artgalry",                                               "cil"},
+        {"application/vnd.claymore",                                                  "cla"},
+        {"application/java-vm",                                                       "class"},
+        {"application/vnd.crick.clicker.keyboard",                                    "clkk"},
+        {"application/vnd.crick.clicker.palette",                                     "clkp"},
+        {"application/vnd.crick.clicker.template",                                    "clkt"},
+        {"application/vnd.crick.clicker.wordbank",                                    "clkw"},
+        {"application/vnd.crick.clicker",                                             "clkx"},
+        {"application/x-msclip",                                                      "clp"},
+        {"application/vnd.cosmocaller",                                               "cmc"},
+        {"chemical/x-cmdf",                                                           "cmdf"},
+        {"chemical/x-cml",                                                            "cml"},
+        {"application/vnd.yellowriver-custom-menu",                                   "cmp"},
+        {"image/x-cmx",                                                               "cmx"},
+        {"application/vnd.rim.cod",                                                   "cod"},
+        {"application/x-cpio",                                                        "cpio"},
+        {"application/mac-compactpro",                                                "cpt"},
+        {"application/x-mscardfile",                                                  "crd"},
+        {"application/pkix-crl",                                                      "crl"},
+        {"application/vnd.rig.cryptonote",                                            "cryptonote"},
+        {"application/x-csh",                                                         "csh"},
+        {"chemical/x-csml",                                                           "csml"},
+        {"application/vnd.commonspace",                                               "csp"},
+        {"text/css",                                                                  "css"},
+        {"text/csv",                                                                  "csv"},
+        {"application/cu-seeme",                                                      "cu"},
+        {"text/vnd.curl",                                                             "curl"},
+        {"application/prs.cww",                                                       "cww"},
+        {"model/vnd.collada+xml",                                                     "dae"},
+        {"application/vnd.mobius.daf",                                                "daf"},
+        {"application/davmount+xml",                                                  "davmount"},
+        {"text/vnd.curl.dcurl",                                                       "dcurl"},
+        {"application/vnd.oma.dd2+xml",                                               "dd2"},
+        {"application/vnd.fujixerox.ddd",                                             "ddd"},
+        {"application/x-debian-package",                                              "deb"},
+        {"application/x-x509-ca-cert",                                                "der"},
+        {"application/vnd.dreamfactory",                                              "dfac"},
+        {"application/x-director",                                                    "dir"},
+        {"application/vnd.mobius.dis",                                                "dis"},
+        {"image/vnd.djvu",                                                            "djvu"},
+        {"application/x-apple-diskimage",                                             "dmg"},
+        {"application/vnd.dna",                                                       "dna"},
+        {"application/msword",                                                        "doc"},
+        {"application/vnd.ms-word.document.macroenabled.12",                          "docm"},
+        {"application/vnd.openxmlformats-officedocument.wordprocessingml.document",   "docx"},
+        {"application/vnd.ms-word.template.macroenabled.12",                          "dotm"},
+        {"application/vnd.openxmlformats-officedocument.wordprocessingml.template",   "dotx"},
+        {"application/vnd.osgi.dp",                                                   "dp"},
+        {"application/vnd.dpgraph",                                                   "dpg"},
+        {"audio/vnd.dra",                                                             "dra"},
+        {"text/prs.lines.tag",                                                        "dsc"},
+        {"application/dssc+der",                                                      "dssc"},
+        {"application/x-dtbook+xml",                                                  "dtb"},
+        {"application/xml-dtd",                                                       "dtd"},
+        {"audio/vnd.dts",                                                             "dts"},
+        {"audio/vnd.dts.hd",                                                          "dtshd"},
+        {"application/x-dvi",                                                         "dvi"},
+        {"model/vnd.dwf",                                                             "dwf"},
+        {"image/vnd.dwg",                                                             "dwg"},
+        {"image/vnd.dxf",                                                             "dxf"},
+        {"application/vnd.spotfire.dxp",                                              "dxp"},
+        {"audio/vnd.nuera.ecelp4800",                                                 "ecelp4800"},
+        {"audio/vnd.nuera.ecelp7470",                                                 "ecelp7470"},
+        {"audio/vnd.nuera.ecelp9600",                                                 "ecelp9600"},
+        {"application/vnd.novadigm.edm",                                              "edm"},
+        {"application/vnd.novadigm.edx",                                              "edx"},
+        {"application/vnd.picsel",                                                    "efif"},
+        {"application/vnd.pg.osasli",                                                 "ei6"},
+        {"message/rfc822",                                                            "eml"},
+        {"application/emma+xml",                                                      "emma"},
+        {"audio/vnd.digital-winds",                                                   "eol"},
+        {"application/vnd.ms-fontobject",                                             "eot"},
+        {"application/epub+zip",                                                      "epub"},
+        {"application/ecmascript",                                                    "es"},
+        {"application/vnd.eszigno3+xml",                                              "es3"},
+        {"application/vnd.epson.esf",                                                 "esf"},
+        {"text/x-setext",                                                             "etx"},
+        {"application/x-msdownload",                                                  "exe"},
+        {"application/exi",                                                           "exi"},
+        {"application/vnd.novadigm.ext",                                              "ext"},
+        {"application/vnd.ezpix-album",                                               "ez2"},
+        {"application/vnd.ezpix-package",                                             "ez3"},
+        {"text/x-fortran",                                                            "f"},
+        {"video/x-f4v",                                                               "f4v"},
+        {"image/vnd.fastbidsheet",                                                    "fbs"},
+        {"application/vnd.isac.fcs",                                                  "fcs"},
+        {"application/vnd.fdf",                                                       "fdf"},
+        {"application/vnd.denovo.fcselayout-link",                                    "fe_launch"},
+        {"application/vnd.fujitsu.oasysgp",                                           "fg5"},
+        {"image/x-freehand",                                                          "fh"},
+        {"application/x-xfig",                                                        "fig"},
+        {"video/x-fli",                                                               "fli"},
+        {"application/vnd.micrografx.flo",                                            "flo"},
+        {"video/x-flv",                                                               "flv"},
+        {"application/vnd.kde.kivio",                                                 "flw"},
+        {"text/vnd.fmi.flexstor",                                                     "flx"},
+        {"text/vnd.fly",                                                              "fly"},
+        {"application/vnd.framemaker",                                                "fm"},
+        {"application/vnd.frogans.fnc",                                               "fnc"},
+        {"image/vnd.fpx",                                                             "fpx"},
+        {"application/vnd.fsc.weblaunch",                                             "fsc"},
+        {"image/vnd.fst",                                                             "fst"},
+        {"application/vnd.fluxtime.clip",                                             "ftc"},
+        {"application/vnd.anser-web-funds-transfer-initiation",                       "fti"},
+        {"video/vnd.fvt",                                                             "fvt"},
+        {"application/vnd.adobe.fxp",                                                 "fxp"},
+        {"application/vnd.fuzzysheet",                                                "fzs"},
+        {"application/vnd.geoplan",                                                   "g2w"},
+        {"image/g3fax",                                                               "g3"},
+        {"application/vnd.geospace",                                                  "g3w"},
+        {"application/vnd.groove-account",                                            "gac"},
+        {"model/vnd.gdl",                                                             "gdl"},
+        {"application/vnd.dynageo",                                                   "geo"},
+        {"application/vnd.geometry-explorer",                                         "gex"},
+        {"application/vnd.geogebra.file",                                             "ggb"},
+        {"application/vnd.geogebra.tool",                                             "ggt"},
+        {"application/vnd.groove-help",                                               "ghf"},
+        {"image/gif",                                                                 "gif"},
+        {"application/vnd.groove-identity-message",                                   "gim"},
+        {"application/vnd.gmx",                                                       "gmx"},
+        {"application/x-gnumeric",                                                    "gnumeric"},
+        {"application/vnd.flographit",                                                "gph"},
+        {"application/vnd.grafeq",                                                    "gqf"},
+        {"application/srgs",                                                          "gram"},
+        {"application/vnd.groove-injector",                                           "grv"},
+        {"application/srgs+xml",                                                      "grxml"},
+        {"application/x-font-ghostscript",                                            "gsf"},
+        {"application/x-gtar",                                                        "gtar"},
+        {"application/vnd.groove-tool-message",                                       "gtm"},
+        {"model/vnd.gtw",                                                             "gtw"},
+        {"text/vnd.graphviz",                                                         "gv"},
+        {"application/vnd.geonext",                                                   "gxt"},
+        {"video/h261",                                                                "h261"},
+        {"video/h263",                                                                "h263"},
+        {"video/h264",                                                                "h264"},
+        {"application/vnd.hal+xml",                                                   "hal"},
+        {"application/vnd.hbci",                                                      "hbci"},
+        {"application/x-hdf",                                                         "hdf"},
+        {"application/winhlp",                                                        "hlp"},
+        {"application/vnd.hp-hpgl",                                                   "hpgl"},
+        {"application/vnd.hp-hpid",                                                   "hpid"},
+        {"application/vnd.hp-hps",                                                    "hps"},
+        {"application/mac-binhex40",                                                  "hqx"},
+        {"application/vnd.kenameaapp",                                                "htke"},
+        {"text/html",                                                                 "html"},
+        {"application/vnd.yamaha.hv-dic",                                             "hvd"},
+        {"application/vnd.yamaha.hv-voice",                                           "hvp"},
+        {"application/vnd.yamaha.hv-script",                                          "hvs"},
+        {"application/vnd.intergeo",                                                  "i2g"},
+        {"application/vnd.iccprofile",                                                "icc"},
+        {"x-conference/x-cooltalk",                                                   "ice"},
+        {"image/x-icon",                                                              "ico"},
+        {"text/calendar",                                                             "ics"},
+        {"image/ief",                                                                 "ief"},
+        {"application/vnd.shana.informed.formdata",                                   "ifm"},
+        {"application/vnd.igloader",                                                  "igl"},
+        {"application/vnd.insors.igm",                                                "igm"},
+        {"model/iges",                                                                "igs"},
+        {"application/vnd.micrografx.igx",                                            "igx"},
+        {"application/vnd.shana.informed.interchange",                                "iif"},
+        {"application/vnd.accpac.simply.imp",                                         "imp"},
+        {"application/vnd.ms-ims",                                                    "ims"},
+        {"application/ipfix",                                                         "ipfix"},
+        {"application/vnd.shana.informed.package",                                    "ipk"},
+        {"application/vnd.ibm.rights-management",                                     "irm"},
+        {"application/vnd.irepository.package+xml",                                   "irp"},
+        {"application/vnd.shana.informed.formtemplate",                               "itp"},
+        {"application/vnd.immervision-ivp",                                           "ivp"},
+        {"application/vnd.immervision-ivu",                                           "ivu"},
+        {"text/vnd.sun.j2me.app-descriptor",                                          "jad"},
+        {"application/vnd.jam",                                                       "jam"},
+        {"application/java-archive",                                                  "jar"},
+        {"text/x-java-source",                                                        "java"},
+        {"application/vnd.jisp",                                                      "jisp"},
+        {"application/vnd.hp-jlyt",                                                   "jlt"},
+        {"application/x-java-jnlp-file",                                              "jnlp"},
+        {"application/vnd.joost.joda-archive",                                        "joda"},
+        {"image/jpeg",                                                                "jpeg"},
+        {"video/jpeg",                                                                "jpgv"},
+        {"video/jpm",                                                                 "jpm"},
+        {"application/javascript",                                                    "js"},
+        {"application/json",                                                          "json"},
+        {"application/vnd.kde.karbon",                                                "karbon"},
+        {"application/vnd.kde.kformula",                                              "kfo"},
+        {"application/vnd.kidspiration",                                              "kia"},
+        {"application/vnd.google-earth.kml+xml",                                      "kml"},
+        {"application/vnd.google-earth.kmz",                                          "kmz"},
+        {"application/vnd.kinar",                                                     "kne"},
+        {"application/vnd.kde.kontour",                                               "kon"},
+        {"application/vnd.kde.kpresenter",                                            "kpr"},
+        {"application/vnd.kde.kspread",                                               "ksp"},
+        {"image/ktx",                                                                 "ktx"},
+        {"application/vnd.kahootz",                                                   "ktz"},
+        {"application/vnd.kde.kword",                                                 "kwd"},
+        {"application/vnd.las.las+xml",                                               "lasxml"},
+        {"application/x-latex",                                                       "latex"},
+        {"application/vnd.llamagraphics.life-balance.desktop",                        "lbd"},
+        {"application/vnd.llamagraphics.life-balance.exchange+xml",                   "lbe"},
+        {"application/vnd.hhe.lesson-player",                                         "les"},
+        {"application/vnd.route66.link66+xml",                                        "link66"},
+        {"application/vnd.ms-lrm",                                                    "lrm"},
+        {"application/vnd.frogans.ltf",                                               "ltf"},
+        {"audio/vnd.lucent.voice",                                                    "lvp"},
+        {"application/vnd.lotus-wordpro",                                             "lwp"},
+        {"application/mp21",                                                          "m21"},
+        {"audio/x-mpegurl",                                                           "m3u"},
+        {"application/vnd.apple.mpegurl",                                             "m3u8"},
+        {"video/x-m4v",                                                               "m4v"},
+        {"application/mathematica",                                                   "ma"},
+        {"application/mads+xml",                                                      "mads"},
+        {"application/vnd.ecowin.chart",                                              "mag"},
+        {"application/mathml+xml",                                                    "mathml"},
+        {"application/vnd.mobius.mbk",                                                "mbk"},
+        {"application/mbox",                                                          "mbox"},
+        {"application/vnd.medcalcdata",                                               "mc1"},
+        {"application/vnd.mcd",                                                       "mcd"},
+        {"text/vnd.curl.mcurl",                                                       "mcurl"},
+        {"application/x-msaccess",                                                    "mdb"},
+        {"image/vnd.ms-modi",                                                         "mdi"},
+        {"application/metalink4+xml",                                                 "meta4"},
+        {"application/mets+xml",                                                      "mets"},
+        {"application/vnd.mfmp",                                                      "mfm"},
+        {"application/vnd.osgeo.mapguide.package",                                    "mgp"},
+        {"application/vnd.proteus.magazine",                                          "mgz"},
+        {"audio/midi",                                                                "mid"},
+        {"application/vnd.mif",                                                       "mif"},
+        {"video/mj2",                                                                 "mj2"},
+        {"application/vnd.dolby.mlp",                                                 "mlp"},
+        {"application/vnd.chipnuts.karaoke-mmd",                                      "mmd"},
+        {"application/vnd.smaf",                                                      "mmf"},
+        {"image/vnd.fujixerox.edmics-mmr",                                            "mmr"},
+        {"application/x-msmoney",                                                     "mny"},
+        {"application/mods+xml",                                                      "mods"},
+        {"video/x-sgi-movie",                                                         "movie"},
+        {"application/mp4",                                                           "mp4"},
+        {"application/vnd.mophun.certificate",                                        "mpc"},
+        {"video/mpeg",                                                                "mpeg"},
+        {"audio/mpeg",                                                                "mpga"},
+        {"application/vnd.apple.installer+xml",                                       "mpkg"},
+        {"application/vnd.blueice.multipass",                                         "mpm"},
+        {"application/vnd.mophun.application",                                        "mpn"},
+        {"application/vnd.ms-project",                                                "mpp"},
+        {"application/vnd.ibm.minipay",                                               "mpy"},
+        {"application/vnd.mobius.mqy",                                                "mqy"},
+        {"application/marc",                                                          "mrc"},
+        {"application/marcxml+xml",                                                   "mrcx"},
+        {"application/mediaservercontrol+xml",                                        "mscml"},
+        {"application/vnd.mseq",                                                      "mseq"},
+        {"application/vnd.epson.msf",                                                 "msf"},
+        {"model/mesh",                                                                "msh"},
+        {"application/vnd.mobius.msl",                                                "msl"},
+        {"application/vnd.muvee.style",                                               "msty"},
+        {"model/vnd.mts",                                                             "mts"},
+        {"application/vnd.musician",                                                  "mus"},
+        {"application/vnd.recordare.musicxml+xml",                                    "musicxml"},
+        {"application/x-msmediaview",                                                 "mvb"},
+        {"application/vnd.mfer",                                                      "mwf"},
+        {"application/mxf",                                                           "mxf"},
+        {"application/vnd.recordare.musicxml",                                        "mxl"},
+        {"application/xv+xml",                                                        "mxml"},
+        {"application/vnd.triscape.mxs",                                              "mxs"},
+        {"video/vnd.mpegurl",                                                         "mxu"},
+        {"application/vnd.nokia.n-gage.symbian.install",                              "n-gage"},
+        {"text/n3",                                                                   "n3"},
+        {"application/vnd.wolfram.player",                                            "nbp"},
+        {"application/x-netcdf",                                                      "nc"},
+        {"application/x-dtbncx+xml",                                                  "ncx"},
+        {"application/vnd.nokia.n-gage.data",                                         "ngdat"},
+        {"application/vnd.neurolanguage.nlu",                                         "nlu"},
+        {"application/vnd.enliven",                                                   "nml"},
+        {"application/vnd.noblenet-directory",                                        "nnd"},
+        {"application/vnd.noblenet-sealer",                                           "nns"},
+        {"application/vnd.noblenet-web",                                              "nnw"},
+        {"image/vnd.net-fpx",                                                         "npx"},
+        {"application/vnd.lotus-notes",                                               "nsf"},
+        {"application/vnd.fujitsu.oasys2",                                            "oa2"},
+        {"application/vnd.fujitsu.oasys3",                                            "oa3"},
+        {"application/vnd.fujitsu.oasys",                                             "oas"},
+        {"application/x-msbinder",                                                    "obd"},
+        {"application/oda",                                                           "oda"},
+        {"application/vnd.oasis.opendocument.database",                               "odb"},
+        {"application/vnd.oasis.opendocument.chart",                                  "odc"},
+        {"application/vnd.oasis.opendocument.formula",                                "odf"},
+        {"application/vnd.oasis.opendocument.formula-template",                       "odft"},
+        {"application/vnd.oasis.opendocument.graphics",                               "odg"},
+        {"application/vnd.oasis.opendocument.image",                                  "odi"},
+        {"application/vnd.oasis.opendocument.text-master",                            "odm"},
+        {"application/vnd.oasis.opendocument.presentation",                           "odp"},
+        {"application/vnd.oasis.opendocument.spreadsheet",                            "ods"},
+        {"application/vnd.oasis.opendocument.text",                                   "odt"},
+        {"audio/ogg",                                                                 "oga"},
+        {"video/ogg",                                                                 "ogv"},
+        {"application/ogg",                                                           "ogx"},
+        {"application/onenote",                                                       "onetoc"},
+        {"application/oebps-package+xml",                                             "opf"},
+        {"application/vnd.lotus-organizer",                                           "org"},
+        {"application/vnd.yamaha.openscoreformat",                                    "osf"},
+        {"application/vnd.yamaha.openscoreformat.osfpvg+xml",                         "osfpvg"},
+        {"application/vnd.oasis.opendocument.chart-template",                         "otc"},
+        {"application/x-font-otf",                                                    "otf"},
+        {"application/vnd.oasis.opendocument.graphics-template",                      "otg"},
+        {"application/vnd.oasis.opendocument.text-web",                               "oth"},
+        {"application/vnd.oasis.opendocument.image-template",                         "oti"},
+        {"application/vnd.oasis.opendocument.presentation-template",                  "otp"},
+        {"application/vnd.oasis.opendocument.spreadsheet-template",                   "ots"},
+        {"application/vnd.oasis.opendocument.text-template",                          "ott"},
+        {"application/vnd.openofficeorg.extension",                                   "oxt"},
+        {"text/x-pascal",                                                             "p"},
+        {"application/pkcs10",                                                        "p10"},
+        {"application/x-pkcs12",                                                      "p12"},
+        {"application/x-pkcs7-certificates",                                          "p7b"},
+        {"application/pkcs7-mime",                                                    "p7m"},
+        {"application/x-pkcs7-certreqresp",                                           "p7r"},
+        {"application/pkcs7-signature",                                               "p7s"},
+        {"application/pkcs8",                                                         "p8"},
+        {"text/plain-bas",                                                            "par"},
+        {"application/vnd.pawaafile",                                                 "paw"},
+        {"application/vnd.powerbuffer6",                                             "pbd"},
+        {"image/x-portable-bitmap",                                                   "pbm"},
+        {"application/x-font-pcf",                                                    "pcf"},
+        {"application/vnd.hp-pcl",                                                    "pcl"},
+        {"application/vnd.hp-pclxl",                                                  "pclxl"},
+        {"application/vnd.curl.pcurl",                                                "pcurl"},
+        {"image/x-pcx",                                                               "pcx"},
+        {"application/vnd.palm",                                                      "pdb"},
+        {"application/pdf",                                                           "pdf"},
+        {"application/x-font-type1",                                                  "pfa"},
+        {"application/font-tdpfr",                                                    "pfr"},
+        {"image/x-portable-graymap",                                                  "pgm"},
+        {"application/x-chess-pgn",                                                   "pgn"},
+        {"application/pgp-encrypted",                                                 "pgp"},
+        {"image/x-pict",                                                              "pic"},
+        {"image/pjpeg",                                                               "pjpeg"},
+        {"application/pkixcmp",                                                       "pki"},
+        {"application/pkix-pkipath",                                                  "pkipath"},
+        {"application/vnd.3gpp.pic-bw-large",                                         "plb"},
+        {"application/vnd.mobius.plc",                                                "plc"},
+        {"application/vnd.pocketlearn",                                               "plf"},
+        {"application/pls+xml",                                                       "pls"},
+        {"application/vnd.ctc-posml",                                                 "pml"},
+        {"image/png",                                                                 "png"},
+        {"image/x-portable-anymap",                                                   "pnm"},
+        {"application/vnd.macports.portpkg",                                          "portpkg"},
+        {"application/vnd.ms-powerpoint.template.macroenabled.12",                    "potm"},
+        {"application/vnd.openxmlformats-officedocument.presentationml.template",     "potx"},
+        {"application/vnd.ms-powerpoint.addin.macroenabled.12",                       "ppam"},
+        {"application/vnd.cups-ppd",                                                  "ppd"},
+        {"image/x-portable-pixmap",                                                   "ppm"},
+        {"application/vnd.ms-powerpoint.slideshow.macroenabled.12",                   "ppsm"},
+        {"application/vnd.openxmlformats-officedocument.presentationml.slideshow",    "ppsx"},
+        {"application/vnd.ms-powerpoint",                                             "ppt"},
+        {"application/vnd.ms-powerpoint.presentation.macroenabled.12",                "pptm"},
+        {"application/vnd.openxmlformats-officedocument.presentationml.presentation", "pptx"},
+        {"application/x-mobipocket-ebook",                                            "prc"},
+        {"application/vnd.lotus-freelance",                                           "pre"},
+        {"application/pics-rules",                                                    "prf"},
+        {"application/vnd.3gpp.pic-bw-small",                                         "psb"},
+        {"image/vnd.adobe.photoshop",                                                 "psd"},
+        {"application/x-font-linux-psf",                                              "psf"},
+        {"application/pskc+xml",                                                      "pskcxml"},
+        {"application/vnd.pvi.ptid1",                                                 "ptid"},
+        {"application/x-mspublisher",                                                 "pub"},
+        {"application/vnd.3gpp.pic-bw-var",                                           "pvb"},
+        {"application/vnd.3m.post-it-notes",                                          "pwn"},
+        {"audio/vnd.ms-playready.media.pya",                                          "pya"},
+        {"video/vnd.ms-playready.media.pyv",                                          "pyv"},
+        {"application/vnd.epson.quickanime",                                          "qam"},
+        {"application/vnd.intu.qbo",                                                  "qbo"},
+        {"application/vnd.intu.qfx",                                                  "qfx"},
+        {"application/vnd.publishare-delta-tree",                                     "qps"},
+        {"video/quicktime",                                                           "qt"},
+        {"application/vnd.quark.quarkxpress",                                         "qxd"},
+        {"audio/x-pn-realaudio",                                                      "ram"},
+        {"application/x-rar-compressed",                                              "rar"},
+        {"image/x-cmu-raster",                                                        "ras"},
+        {"application/vnd.ipunplugged.rcprofile",                                     "rcprofile"},
+        {"application/rdf+xml",                                                       "rdf"},
+        {"application/vnd.data-vision.rdz",                                           "rdz"},
+        {"application/vnd.businessobjects",                                           "rep"},
+        {"application/x-dtbresource+xml",                                             "res"},
+        {"image/x-rgb",                                                               "rgb"},
+        {"application/reginfo+xml",                                                   "rif"},
+        {"audio/vnd.rip",                                                             "rip"},
+        {"application/resource-lists+xml",                                            "rl"},
+        {"image/vnd.fujixerox.edmics-rlc",                                            "rlc"},
+        {"application/resource-lists-diff+xml",                                       "rld"},
+        {"application/vnd.rn-realmedia",                                              "rm"},
+        {"audio/x-pn-realaudio-plugin",                                               "rmp"},
+        {"application/vnd.jcp.javame.midlet-rms",                                     "rms"},
+        {"application/relax-ng-compact-syntax",                                       "rnc"},
+        {"application/vnd.cloanto.rp9",                                               "rp9"},
+        {"application/vnd.nokia.radio-presets",                                       "rpss"},
+        {"application/vnd.nokia.radio-preset",                                        "rpst"},
+        {"application/sparql-query",                                                  "rq"},
+        {"application/rls-services+xml",                                              "rs"},
+        {"application/rsd+xml",                                                       "rsd"},
+        {"application/rss+xml",                                                       "rss"},
+        {"application/rtf",                                                           "rtf"},
+        {"text/richtext",                                                             "rtx"},
+        {"text/x-asm",                                                                "s"},
+        {"application/vnd.yamaha.smaf-audio",                                         "saf"},
+        {"application/sbml+xml",                                                      "sbml"},
+        {"application/vnd.ibm.secure-container",                                      "sc"},
+        {"application/x-msschedule",                                                  "scd"},
+        {"application/vnd.lotus-screencam",                                           "scm"},
+        {"application/scvp-cv-request",                                               "scq"},
+        {"application/scvp-cv-response",                                              "scs"},
+        {"text/vnd.curl.scurl",                                                       "scurl"},
+        {"application/vnd.stardivision.draw",                                         "sda"},
+        {"application/vnd.stardivision.calc",                                         "sdc"},
+        {"application/vnd.stardivision.impress",                                      "sdd"},
+        {"application/vnd.solent.sdkm+xml",                                           "sdkm"},
+        {"application/sdp",                                                           "sdp"},
+        {"application/vnd.stardivision.writer",                                       "sdw"},
+        {"application/vnd.seemail",                                                   "see"},
+        {"application/vnd.fdsn.seed",                                                 "seed"},
+        {"application/vnd.sema",                                                      "sema"},
+        {"application/vnd.semd",                                                      "semd"},
+        {"application/vnd.semf",                                                      "semf"},
+        {"application/java-serialized-object",                                        "ser"},
+        {"application/set-payment-initiation",                                        "setpay"},
+        {"application/set-registration-initiation",                                   "setreg"},
+        {"application/vnd.hydrostatix.sof-data",                                      "sfd-hdstx"},
+        {"application/vnd.spotfire.sfs",                                              "sfs"},
+        {"application/vnd.stardivision.writer-global",                                "sgl"},
+        {"text/sgml",                                                                 "sgml"},
+        {"application/x-sh",                                                          "sh"},
+        {"application/x-shar",                                                        "shar"},
+        {"application/shf+xml",                                                       "shf"},
+        {"application/vnd.symbian.install",                                           "sis"},
+        {"application/x-stuffit",                                                     "sit"},
+        {"application/x-stuffitx",                                                    "sitx"},
+        {"application/vnd.koan",                                                      "skp"},
+        {"application/vnd.ms-powerpoint.slide.macroenabled.12",                       "sldm"},
+        {"application/vnd.openxmlformats-officedocument.presentationml.slide",        "sldx"},
+        {"application/vnd.epson.salt",                                                "slt"},
+        {"application/vnd.stepmania.stepchart",                                       "sm"},
+        {"application/vnd.stardivision.math",                                         "smf"},
+        {"application/smil+xml",                                                      "smi"},
+        {"application/x-font-snf",                                                    "snf"},
+        {"application/vnd.yamaha.smaf-phrase",                                        "spf"},
+        {"application/x-futuresplash",                                                "spl"},
+        {"text/vnd.in3d.spot",                                                        "spot"},
+        {"application/scvp-vp-response",                                              "spp"},
+        {"application/scvp-vp-request",                                               "spq"},
+        {"application/x-wais-source",                                                 "src"},
+        {"application/sru+xml",                                                       "sru"},
+        {"application/sparql-results+xml",                                            "srx"},
+        {"application/vnd.kodak-descriptor",                                          "sse"},
+        {"application/vnd.epson.ssf",                                                 "ssf"},
+        {"application/ssml+xml",                                                      "ssml"},
+        {"application/vnd.sailingtracker.track",                                      "st"},
+        {"application/vnd.sun.xml.calc.template",                                     "stc"},
+        {"application/vnd.sun.xml.draw.template",                                     "std"},
+        {"application/vnd.wt.stf",                                                    "stf"},
+        {"application/vnd.sun.xml.impress.template",                                  "sti"},
+        {"application/hyperstudio",                                                   "stk"},
+        {"application/vnd.ms-pki.stl",                                                "stl"},
+        {"application/vnd.pg.format",                                                 "str"},
+        {"application/vnd.sun.xml.writer.template",                                   "stw"},
+        {"image/vnd.dvb.subtitle",                                                    "sub"},
+        {"application/vnd.sus-calendar",                                              "sus"},
+        {"application/x-sv4cpio",                                                     "sv4cpio"},
+        {"application/x-sv4crc",                                                      "sv4crc"},
+        {"application/vnd.dvb.service",                                               "svc"},
+        {"application/vnd.svd",                                                       "svd"},
+        {"image/svg+xml",                                                             "svg"},
+        {"application/x-shockwave-flash",                                             "swf"},
+        {"application/vnd.aristanetworks.swi",                                        "swi"},
+        {"application/vnd.sun.xml.calc",                                              "sxc"},
+        {"application/vnd.sun.xml.draw",                                              "sxd"},
+        {"application/vnd.sun.xml.writer.global",                                     "sxg"},
+        {"application/vnd.sun.xml.impress",                                           "sxi"},
+        {"application/vnd.sun.xml.math",                                              "sxm"},
+        {"application/vnd.sun.xml.writer",                                            "sxw"},
+        {"text/troff",                                                                "t"},
+        {"application/vnd.tao.intent-module-archive",                                 "tao"},
+        {"application/x-tar",                                                         "tar"},
+        {"application/vnd.3gpp2.tcap",                                                "tcap"},
+        {"application/x-tcl",                                                         "tcl"},
+        {"application/vnd.smart.teacher",                                             "teacher"},
+        {"application/tei+xml",                                                       "tei"},
+        {"application/x-tex",                                                         "tex"},
+        {"application/x-texinfo",                                                     "texinfo"},
+        {"application/thraud+xml",                                                    "tfi"},
+        {"application/x-tex-tfm",                                                     "tfm"},
+        {"application/vnd.ms-officetheme",                                            "thmx"},
+        {"image/tiff",                                                                "tiff"},
+        {"application/vnd.tmobile-livetv",                                            "tmo"},
+        {"application/x-bittorrent",                                                  "torrent"},
+        {"application/vnd.groove-tool-template",                                      "tpl"},
+        {"application/vnd.trid.tpt",                                                  "tpt"},
+        {"application/vnd.trueapp",                                                   "tra"},
+        {"application/x-msterminal",                                                  "trm"},
+        {"application/timestamped-data",                                              "tsd"},
+        {"text/tab-separated-values",                                                 "tsv"},
+        {"application/x-font-ttf",                                                    "ttf"},
+        {"text/turtle",                                                               "ttl"},
+        {"application/vnd.simtech-mindmapper",                                        "twd"},
+        {"application/vnd.genomatix.tuxedo",                                          "txd"},
+        {"application/vnd.mobius.txf",                                                "txf"},
+        {"text/plain",                                                                "txt"},
+        {"application/vnd.ufdl",                                                      "ufd"},
+        {"application/vnd.umajin",                                                    "umj"},
+        {"application/vnd.unity",                                                     "unityweb"},
+        {"application/vnd.uoml+xml",                                                  "uoml"},
+        {"text/uri-list",                                                             "uri"},
+        {"application/x-ustar",                                                       "ustar"},
+        {"application/vnd.uiq.theme",                                                 "utz"},
+        {"text/x-uuencode",                                                           "uu"},
+        {"audio/vnd.dece.audio",                                                      "uva"},
+        {"video/vnd.dece.hd",                                                         "uvh"},
+        {"image/vnd.dece.graphic",                                                    "uvi"},
+        {"video/vnd.dece.mobile",                                                     "uvm"},
+        {"video/vnd.dece.pd",                                                         "uvp"},
+        {"video/vnd.dece.sd",                                                         "uvs"},
+        {"video/vnd.uvvu.mp4",                                                        "uvu"},
+        {"video/vnd.dece.video",                                                      "uvv"},
+        {"application/x-cdlink",                                                      "vcd"},
+        {"text/x-vcard",                                                              "vcf"},
+        {"application/vnd.groove-vcard",                                              "vcg"},
+        {"text/x-vcalendar",                                                          "vcs"},
+        {"application/vnd.vcx",                                                       "vcx"},
+        {"application/vnd.visionary",                                                 "vis"},
+        {"video/vnd.vivo",                                                            "viv"},
+        {"application/vnd.visio",                                                     "vsd"},
+        {"application/vnd.visio2013",                                                 "vsdx"},
+        {"application/vnd.vsf",                                                       "vsf"},
+        {"model/vnd.vtu",                                                             "vtu"},
+        {"application/voicexml+xml",                                                  "vxml"},
+        {"application/x-doom",                                                        "wad"},
+        {"audio/x-wav",                                                               "wav"},
+        {"audio/x-ms-wax",                                                            "wax"},
+        {"image/vnd.wap.wbmp",                                                        "wbmp"},
+        {"application/vnd.criticaltools.wbs+xml",                                     "wbs"},
+        {"application/vnd.wap.wbxml",                                                 "wbxml"},
+        {"audio/webm",                                                                "weba"},
+        {"video/webm",                                                                "webm"},
+        {"image/webp",                                                                "webp"},
+        {"application/vnd.pmi.widget",                                                "wg"},
+        {"application/widget",                                                        "wgt"},
+        {"video/x-ms-wm",                                                             "wm"},
+        {"audio/x-ms-wma",                                                            "wma"},
+        {"application/x-ms-wmd",                                                      "wmd"},
+        {"application/x-msmetafile",                                                  "wmf"},
+        {"text/vnd.wap.wml",                                                          "wml"},
+        {"application/vnd.wap.wmlc",                                                  "wmlc"},
+        {"text/vnd.wap.wmlscript",                                                    "wmls"},
+        {"application/vnd.wap.wmlscriptc",                                            "wmlsc"},
+        {"video/x-ms-wmv",                                                            "wmv"},
+        {"video/x-ms-wmx",                                                            "wmx"},
+        {"application/x-ms-wmz",                                                      "wmz"},
+        {"application/x-font-woff",                                                   "woff"},
+        {"application/vnd.wordperfect",                                               "wpd"},
+        {"application/vnd.ms-wpl",                                                    "wpl"},
+        {"application/vnd.ms-works",                                                  "wps"},
+        {"application/vnd.wqd",                                                       "wqd"},
+        {"application/x-mswrite",                                                     "wri"},
+        {"model/vrml",                                                                "wrl"},
+        {"application/wsdl+xml",                                                      "wsdl"},
+        {"application/wspolicy+xml",                                                  "wspolicy"},
+        {"application/vnd.webturbo",                                                  "wtb"},
+        {"video/x-ms-wvx",                                                            "wvx"},
+        {"application/vnd.hzn-3d-crossword",                                          "x3d"},
+        {"application/x-silverlight-app",                                             "xap"},
+        {"application/vnd.xara",                                                      "xar"},
+        {"application/x-ms-xbap",                                                     "xbap"},
+        {"application/vnd.fujixerox.docuworks.binder",                                "xbd"},
+        {"image/x-xbitmap",                                                           "xbm"},
+        {"application/xcap-diff+xml",                                                 "xdf"},
+        {"application/vnd.syncml.dm+xml",                                             "xdm"},
+        {"application/vnd.adobe.xdp+xml",                                             "xdp"},
+        {"application/dssc+xml",                                                      "xdssc"},
+        {"application/vnd.fujixerox.docuworks",                                       "xdw"},
+        {"application/xenc+xml",                                                      "xenc"},
+        {"application/patch-ops-ERROR+xml",                                           "xer"},
+        {"application/vnd.adobe.xfdf",                                                "xfdf"},
+        {"application/vnd.xfdl",                                                      "xfdl"},
+        {"application/xhtml+xml",                                                     "xhtml"},
+        {"image/vnd.xiff",                                                            "xif"},
+        {"application/vnd.ms-excel.addin.macroenabled.12",                            "xlam"},
+        {"application/vnd.ms-excel",                                                  "xls"},
+        {"application/vnd.ms-excel.sheet.binary.macroenabled.12",                     "xlsb"},
+        {"application/vnd.ms-excel.sheet.macroenabled.12",                            "xlsm"},
+        {"application/vnd.openxmlformats-officedocument.spreadsheetml.sheet",         "xlsx"},
+        {"application/vnd.ms-excel.template.macroenabled.12",                         "xltm"},
+        {"application/vnd.openxmlformats-officedocument.spreadsheetml.template",      "xltx"},
+        {"application/xml",                                                           "xml"},
+        {"application/vnd.olpc-sugar",                                                "xo"},
+        {"application/xop+xml",                                                       "xop"},
+        {"application/x-xpinstall",                                                   "xpi"},
+        {"image/x-xpixmap",                                                           "xpm"},
+        {"application/vnd.is-xpr",                                                    "xpr"},
+        {"application/vnd.ms-xpsdocument",                                            "xps"},
+        {"application/vnd.intercon.formnet",                                          "xpw"},
+        {"application/xslt+xml",                                                      "xslt"},
+        {"application/vnd.syncml+xml",                                                "xsm"},
+        {"application/xspf+xml",                                                      "xspf"},
+        {"application/vnd.mozilla.xul+xml",                                           "xul"},
+        {"image/x-xwindowdump",                                                       "xwd"},
+        {"chemical/x-xyz",                                                            "xyz"},
+        {"text/yaml",                                                                 "yaml"},
+        {"application/yang",                                                          "yang"},
+        {"application/yin+xml",                                                       "yin"},
+        {"application/vnd.zzazz.deck+xml",                                            "zaz"},
+        {"application/zip",                                                           "zip"},
+        {"application/vnd.zul",                                                       "zir"},
+        {"application/vnd.handheld-entertainment+xml",                                "zmm"},
+};
+
+static const u32 _global_mime_register = (u32) ARRAY_LENGTH(global_mime_register);
+
+bool mime_write(memfile *dst, field_e type);
+
+/**
+ * Returns the mime type identifier for a file extension <code>ext</code>. If <code>ext</code> is not known,
+ * the mime type application/octet-stream (.bin) is returned.
+ */
+u32 mime_by_ext(const char *ext);
+
+/**
+ * Returns a human readable string representing the mime type for the mime type identifier <code>id</code>.
+ * In case <code>id</code> is invalid, the mime type application/octet-stream is returned.
+ */
+const char *mime_by_id(u32 id);
+
+/**
+ * Returns the file extension for the mime type identifier <code>id</code>.
+ * In case <code>id</code> is invalid, the file extension "bin" is returned.
+ */
+const char *mime_ext_by_id(u32 id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/*
+ * ndjson - bulk conversion of newline-delimited JSON into records
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_NDJSON_H
+#define HAD_NDJSON_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/rec.h>
+#include <karbonit/std/vec.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* minimum number of input bytes that are converted by the same task */
+#define NDJSON_MIN_CHUNK_SIZE           (64 * 1024)
+
+/* a line that could not be converted into a record */
+typedef struct ndjson_err {
+        /* line number, starting with 1 */
+        u64 line;
+        /* error code and message, as for ERROR */
+        int code;
+        const char *msg;
+} ndjson_err;
+
+/**
+ * Records that are converted from the lines of a newline-delimited JSON input, one record per line that is not
+ * blank. Records and errors are in the order of their lines.
+ */
+typedef struct ndjson_batch {
+        vec ofType(rec) records;
+        /* for each record, the number of its line (starting with 1) */
+        vec ofType(u64) lines;
+        vec ofType(ndjson_err) errors;
+} ndjson_batch;
+
+/**
+ * Converts each line of the <code>len</code> bytes of newline-delimited JSON at <code>data</code> into a record as
+ * <code>rec_from_json</code> does with record key type <code>key_type</code>. The input is split into line-aligned
+ * chunks that are converted in parallel by the threads of <code>pool</code> and the calling thread; for
+ * <code>pool</code> <code>NULL</code>, all lines are converted by the calling thread. A line that cannot be converted
+ * is reported in the batch's errors, and does not stop the conversion of the other lines. Returns false only if the
+ * batch could not be created.
+ */
+bool ndjson_ingest(ndjson_batch *batch, const char *data, u64 len, key_e key_type, thread_pool *pool);
+
+/**
+ * Maps the file at <code>file_path</code> into memory, and converts its lines (see <code>ndjson_ingest</code>)
+ */
+bool ndjson_ingest_file(ndjson_batch *batch, const char *file_path, key_e key_type, thread_pool *pool);
+
+/**
+ * Drops all records of the batch, and the batch itself
+ */
+bool ndjson_batch_drop(ndjson_batch *batch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/*
+ * obj_it - object container iterator
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_OBJ_IT_H
+#define HAD_OBJ_IT_H
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/mem/memfile.h>
+#include <karbonit/carbon/field.h>
+#include <karbonit/carbon/arr-it.h>
+#include <karbonit/carbon/prop.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct obj_it {
+        memfile file;
+        offset_t content_begin, begin;
+        bool eof;
+        u64 pos;
+        offset_t last_off;
+        struct {
+                struct {
+                        offset_t start;
+                        const char *name;
+                        u64 name_len;
+                } key;
+                struct {
+                        offset_t start;
+                        field data;
+                } value;
+        } field;
+        map_type_e type;
+        prop prop;
+        i64 mod_size; /** in case of modifications, the number of bytes that are added resp. removed */
+} obj_it;
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  public interface
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool obj_it_rewind(obj_it *it);
+prop *obj_it_next(obj_it *it);
+bool obj_it_has_next(obj_it *it);
+bool obj_it_prev(obj_it *it);
+
+u64 obj_it_length(obj_it *it);
+
+bool obj_it_is_multimap(obj_it *it);
+bool obj_it_is_sorted(obj_it *it);
+void obj_it_update_type(obj_it *it, map_type_e derivation);
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  for internal usage
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool internal_obj_it_create(obj_it *it, memfile *memfile, offset_t payload_start);
+bool internal_obj_it_copy(obj_it *dst, obj_it *src);
+bool internal_obj_it_clone(obj_it *dst, obj_it *src);
+
+bool internal_obj_it_fast_forward(obj_it *it);
+
+void *internal_obj_it_memfile(obj_it *it);
+offset_t internal_obj_it_memfile_pos(obj_it *it);
+bool internal_obj_it_tell(offset_t *key_off, offset_t *value_off, obj_it *it);
+
+string_field internal_obj_it_prop_name(obj_it *it);
+bool internal_obj_it_remove(obj_it *it);
+bool internal_obj_it_prop_type(field_e *type, obj_it *it);
+
+bool internal_obj_it_insert_begin(insert *in, obj_it *it);
+void internal_obj_it_insert_end(insert *in);
+
+void internal_obj_it_adjust(obj_it *it);
+
+bool internal_obj_it_update_name(obj_it *it, const char *key);
+bool internal_obj_it_update_u8(obj_it *it, u8 value);
+bool internal_obj_it_update_u16(obj_it *it, u16 value);
+bool internal_obj_it_update_u32(obj_it *it, u32 value);
+bool internal_obj_it_update_u64(obj_it *it, u64 value);
+bool internal_obj_it_update_i8(obj_it *it, i8 value);
+bool internal_obj_it_update_i16(obj_it *it, i16 value);
+bool internal_obj_it_update_i32(obj_it *it, i32 value);
+bool internal_obj_it_update_i64(obj_it *it, i64 value);
+bool internal_obj_it_update_float(obj_it *it, float value);
+bool internal_obj_it_update_true(obj_it *it);
+bool internal_obj_it_update_false(obj_it *it);
+bool internal_obj_it_update_null(obj_it *it);
+bool internal_obj_it_update_string(obj_it *it, const char *str);
+bool internal_obj_it_update_binary(obj_it *it, const void *value, size_t nbytes, const char *file_ext, const char *user_type);
+insert *internal_obj_it_update_array_begin(arr_state *state, obj_it *it);
+bool internal_obj_it_update_array_end(arr_state *state);
+
+insert *internal_obj_it_update_column_begin(col_state *state, obj_it *it);
+bool internal_obj_it_update_column_end(col_state *state);
+
+insert *internal_obj_it_update_object_begin(obj_state *state, obj_it *it);
+bool internal_obj_it_update_object_end(obj_state *state);
+
+bool internal_obj_it_update_from_carbon(obj_it *it, const rec *src);
+bool internal_obj_it_update_from_array(obj_it *it, const obj_it *src);
+bool internal_obj_it_update_from_object(obj_it *it, const obj_it *src);
+bool internal_obj_it_update_from_column(obj_it *it, const col_it *src);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * patch - modification of records within a revision (not thread-safe)
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_PATCH_H
+#define HAD_PATCH_H
+
+#include <karbonit/stdinc.h>
+#include <karbonit/forwdecl.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Opens a read-write enabled iterator for patching a record revision without creating a new one. */
+void patch(arr_it *it, rec *doc);
+
+void patch_find_begin(find *out, const char *dot, rec *doc);
+
+void patch_find_end(find *find);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/*
+ * pindex - path index for speeding up dot path evaluation and traversals
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_PATH_INDEX_H
+#define HAD_PATH_INDEX_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/mem/memfile.h>
+#include <karbonit/mem/memblock.h>
+#include <karbonit/error.h>
+#include <karbonit/rec.h>
+#include <karbonit/carbon/find.h>
+#include <karbonit/carbon/dot.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  types
+// ---------------------------------------------------------------------------------------------------------------------
+
+typedef struct pindex {
+        memblock *memblock;
+        memfile memfile;
+} pindex;
+
+typedef struct pindex_it {
+        rec *doc;
+        memfile memfile;
+        container_e container;
+        /* offset of the current container in the record (0 for the record itself), number of its elements or
+         * properties, and offset of the node offsets of its contents in the index */
+        offset_t container_off;
+        u64 len;
+        offset_t contents_off;
+        /* position of the selected element or property in the current container */
+        u64 pos;
+        /* offset of the node of the selected element or property in the index (0 if none is selected), its field
+         * type, and the offsets of its field and (for properties) its key in the record */
+        offset_t node_off;
+        field_e field_type;
+        offset_t field_off;
+        offset_t key_off;
+} pindex_it;
+
+typedef enum {
+        PINDEX_ROOT, PINDEX_PROP_KEY, PINDEX_ARRAY_INDEX, PINDEX_COLUMN_INDEX
+} pindex_node_e;
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  construction and deconstruction
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool pindex_create(pindex *index, rec *doc);
+bool pindex_drop(pindex *index);
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  persistence
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Writes the index to a file, e.g., next to the file of the indexed record. The file holds a short header (including
+ * the checksum of the contents of the indexed record) and the index as it is laid out in memory; all offsets in the
+ * index are relative to its beginning. Like records, the index is stored in the byte order of the host.
+ */
+bool pindex_to_file(const char *file_path, pindex *index);
+
+/**
+ * Opens an index that was written by <code>pindex_to_file</code>. The index is mapped into memory rather than read,
+ * and can be used without further processing. If <code>doc</code> is non-null, the index must have been created for
+ * the revision of <code>doc</code> (see <code>pindex_indexes_doc</code>), and for its contents, whose checksum is
+ * stored in the file header, such that an outdated index is not used after the record was revised or replaced.
+ */
+bool pindex_from_file(pindex *index, const char *file_path, rec *doc);
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  index data access and meta information
+// ---------------------------------------------------------------------------------------------------------------------
+
+const void *pindex_raw_data(u64 *size, pindex *index);
+bool pindex_commit_hash(u64 *commit_hash, pindex *index);
+/* checksum of the contents of the indexed record (see commit_compute) as of the creation of the index */
+bool pindex_checksum(u64 *checksum, pindex *index);
+bool pindex_key_type(key_e *rec_key_type, pindex *index);
+bool pindex_key_unsigned_value(u64 *key, pindex *index);
+bool pindex_key_signed_value(i64 *key, pindex *index);
+const char *pindex_key_string_value(u64 *str_len, pindex *index);
+/* Returns true if the index was created for the revision of <code>doc</code>: for records with a key if key and
+ * commit hash match, and for records without a key (which have no commit hash) if the checksum of their contents
+ * matches, which costs a pass over the record. */
+bool pindex_indexes_doc(pindex *index, rec *doc);
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  index access and type information
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Opens an iterator on the index of <code>doc</code>, which starts in the record itself as an array. Within a
+ * container, an element or property is selected with <code>pindex_it_list_goto</code> or
+ * <code>pindex_it_obj_goto</code> by looking up its node in the index, without reading the record. A selected
+ * container is entered with <code>pindex_it_list_enter</code> or <code>pindex_it_obj_enter</code>.
+ */
+bool pindex_it_open(pindex_it *it, pindex *index, rec *doc);
+bool pindex_it_type(container_e *type, pindex_it *it);
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  array and column container functions
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool pindex_it_list_length(u64 *key_len, pindex_it *it);
+bool pindex_it_list_goto(u64 pos, pindex_it *it);
+bool pindex_it_list_pos(u64 *pos, pindex_it *it);
+bool pindex_it_list_can_enter(pindex_it *it);
+bool pindex_it_list_enter(pindex_it *it);
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  object container functions
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool pindex_it_obj_num_props(u64 *num_props, pindex_it *it);
+bool pindex_it_obj_goto(const char *key_name, pindex_it *it);
+
+/**
+ * Selects the (first) property with the name <code>key_name</code> of length <code>key_len</code> by a lookup in
+ * the key table of the object, and returns false if there is no such property.
+ */
+bool pindex_it_obj_ngoto(const char *key_name, u64 key_len, pindex_it *it);
+const char *pindex_it_key_name(u64 *name_len, pindex_it *it);
+bool pindex_it_obj_can_enter(pindex_it *it);
+bool pindex_it_obj_enter(pindex_it *it);
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  field access
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool pindex_type(field_e *type, pindex_it *it);
+bool pindex_it_field_u8_value(u8 *value, pindex_it *it);
+bool pindex_it_field_u16_value(u16 *value, pindex_it *it);
+bool pindex_it_field_u32_value(u32 *value, pindex_it *it);
+bool pindex_it_field_u64_value(u64 *value, pindex_it *it);
+bool pindex_it_field_i8_value(i8 *value, pindex_it *it);
+bool pindex_it_field_i16_value(i16 *value, pindex_it *it);
+bool pindex_it_field_i32_value(i32 *value, pindex_it *it);
+bool pindex_it_field_i64_value(i64 *value, pindex_it *it);
+bool pindex_it_field_float_value(bool *is_null_in, float *value, pindex_it *it);
+bool pindex_it_field_signed_value(bool *is_null_in, i64 *value, pindex_it *it);
+bool pindex_it_field_unsigned_value(bool *is_null_in, u64 *value, pindex_it *it);
+const char *pindex_it_field_string_value(u64 *strlen, pindex_it *it);
+bool pindex_it_field_binary_value(binary_field *out, arr_it *it);
+bool pindex_it_field_array_value(arr_it *it_out, pindex_it *it_in);
+bool pindex_it_field_object_value(obj_it *it_out, pindex_it *it_in);
+bool pindex_it_field_column_value(col_it *it_out, pindex_it *it_in);
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  diagnostics
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool pindex_hexdump(FILE *file, pindex *index);
+void pindex_to_record(rec *doc, pindex *index);
+const char *pindex_to_str(str_buf *str, pindex *index);
+bool pindex_print(FILE *file, pindex *index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/*
+ * projection - evaluation of several dot paths in a single record traversal
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_PROJECTION_H
+#define HAD_PROJECTION_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/rec.h>
+#include <karbonit/carbon/dot.h>
+#include <karbonit/carbon/find.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PROJECTION_NO_PATH      UINT32_MAX
+
+typedef struct projection_node {
+        dot_node_type_e type;
+        /* array index (index nodes only) */
+        u32 idx;
+        /* key name (key nodes only), owned by the projection */
+        char *key;
+        u32 key_len;
+        /* first child, and next sibling, of this node; 0 if there is none */
+        u32 first_child;
+        u32 next_sibling;
+        /* first of the paths that end in this node, or PROJECTION_NO_PATH */
+        u32 first_path;
+} projection_node;
+
+/**
+ * Set of dot paths that are merged into a trie by their common prefixes, such that all of them are evaluated in a
+ * single pass over a record (see <code>projection_exec</code>). Each array or object on the way is scanned at most
+ * once regardless of how many paths go through it, whereas <code>find_from_dot</code> walks from the record root for
+ * each path on its own. A projection is not modified by its evaluation, and may be evaluated by several threads at
+ * the same time.
+ */
+typedef struct projection {
+        /* nodes of the trie; node 0 is the root, which stands for the record itself */
+        vec ofType(projection_node) nodes;
+        /* for each path, the next path that ends in the same node, or PROJECTION_NO_PATH */
+        vec ofType(u32) path_next;
+} projection;
+
+bool projection_create(projection *proj);
+bool projection_drop(projection *proj);
+
+/**
+ * Adds <code>path</code> to the projection, and stores in <code>pos</code> (if non-null) the position of the result
+ * for this path in the results of <code>projection_exec</code>. Paths are numbered in the order they are added; the
+ * same path may be added more than once. The path is copied, and must not be empty.
+ */
+bool projection_add(u32 *pos, projection *proj, const dot *path);
+bool projection_add_string(u32 *pos, projection *proj, const char *path_string);
+
+/**
+ * Returns the number of paths in the projection
+ */
+u32 projection_len(const projection *proj);
+
+/**
+ * Evaluates all paths of the projection on <code>doc</code>. The caller provides one <code>find</code> per path in
+ * <code>results</code> (see <code>projection_len</code>), each of which is set to the result that
+ * <code>find_from_dot</code> yields for that path, and is accessed with the <code>find_result_*</code> functions.
+ * Returns true if all paths are resolved.
+ */
+bool projection_exec(find *results, const projection *proj, rec *doc);
+
+/**
+ * Evaluates all paths of the projection on the revised record of <code>context</code>, as
+ * <code>projection_exec</code> does. The iterators of the results may be used to modify the revised record; as long
+ * as no modification changes the size of a field, all results remain valid.
+ */
+bool projection_exec_mutable(find *results, const projection *proj, rev *context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/*
+ * prop - object container property
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_PROP_H
+#define HAD_PROP_H
+
+#include <karbonit/stdinc.h>
+#include <karbonit/carbon/field.h>
+#include <karbonit/carbon/item.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct prop
+{
+        obj_it *parent;
+        u64 idx;
+        string_field  key;
+        item value;
+} prop;
+
+#define PROP_GET_NAME(prop)                                                                                     \
+        (prop ? (prop)->key : NULL_STRING)
+
+#define PROP_GET_TYPE(prop)                                                                                     \
+        ((prop) ? ITEM_GET_TYPE(&(prop)->value) : ITEM_UNDEF)
+
+#define PROP_IS_UNDEF(prop)                                                                                     \
+        ((prop) ? ITEM_IS_UNDEF(&(prop)->value) : true)
+
+#define PROP_IS_NULL(prop)                                                                                      \
+        ((prop) ? ITEM_IS_NULL(&(prop)->value) : false)
+
+#define PROP_IS_TRUE(prop)                                                                                      \
+        ((prop) ? ITEM_IS_TRUE(&(prop)->value) : false)
+
+#define PROP_IS_FALSE(prop)                                                                                     \
+        ((prop) ? ITEM_IS_FALSE(&(prop)->value) : false)
+
+#define PROP_IS_BOOLEAN(prop)                                                                                   \
+        ((prop) ? ITEM_IS_BOOLEAN(&(prop)->value) : false)
+
+#define PROP_IS_STRING(prop)                                                                                    \
+        ((prop) ? ITEM_IS_STRING(&(prop)->value) : false)
+
+#define PROP_IS_SIGNED(prop)                                                                                    \
+        ((prop) ? ITEM_IS_SIGNED(&(prop)->value) : false)
+
+#define PROP_IS_UNSIGNED(prop)                                                                                  \
+        ((prop) ? ITEM_IS_UNSIGNED(&(prop)->value) : false)
+
+#define PROP_IS_FLOAT(prop)                                                                                     \
+        ((prop) ? ITEM_IS_FLOAT(&(prop)->value) : false)
+
+#define PROP_IS_NUMBER(prop)                                                                                    \
+        ((prop) ? ITEM_IS_NUMBER(&(prop)->value) : false)
+
+#define PROP_IS_BINARY(prop)                                                                                    \
+        ((prop) ? ITEM_IS_BINARY(&(prop)->value) : false)
+
+#define PROP_IS_ARRAY(prop)                                                                                     \
+        ((prop) ? ITEM_IS_ARRAY(&(prop)->value) : false)
+
+#define PROP_IS_COLUMN(prop)                                                                                    \
+        ((prop) ? ITEM_IS_COLUMN(&(prop)->value) : false)
+
+#define PROP_IS_OBJECT(prop)                                                                                    \
+        ((prop) ? ITEM_IS_OBJECT(&(prop)->value) : false)
+
+#define PROP_GET_INDEX(prop)                                                                                    \
+        ((prop) ? (prop)->idx : 0)
+
+#define PROP_GET_NUMBER_SIGNED(prop, default_value)                                                             \
+        ((prop) ? ITEM_GET_NUMBER_SIGNED(&(prop)->value) : default_value)
+
+#define PROP_GET_NUMBER_UNSIGNED(prop, default_value)                                                           \
+        ((prop) ? ITEM_GET_NUMBER_UNSIGNED(&(prop)->value) : default_value)
+
+#define PROP_GET_NUMBER_FLOAT(prop, default_value)                                                              \
+        ((prop) ? ITEM_GET_NUMBER_FLOAT(&(prop)->value) : default_value)
+
+#define PROP_GET_STRING(prop, default_value)                                                                    \
+        ((prop) ? ITEM_GET_STRING(&(prop)->value) : default_value)
+
+#define PROP_GET_BINARY(prop, default_value)                                                                    \
+        ((prop) ? ITEM_GET_BINARY(&(prop)->value) : default_value)
+
+#define PROP_GET_ARRAY(it, prop)                                                                                    \
+        ITEM_GET_ARRAY((it), &(prop)->value)
+
+#define PROP_GET_COLUMN(it, prop)                                                                    \
+        ITEM_GET_COLUMN((it), &(prop)->value)
+
+#define PROP_GET_OBJECT(it, prop)                                                                                   \
+        ITEM_GET_OBJECT((it), &(prop)->value)
+
+#define PROP_REMOVE(prop)                                                                                       \
+        ((prop) ? internal_obj_it_remove(&(prop)->value) : default_value)
+
+#define PROP_SET_NAME(prop, key_name)                                                                           \
+        (internal_obj_it_update_name((prop)->parent, key_name))
+
+#define PROP_SET_NULL(prop)                                                                                     \
+        ITEM_SET_NULL(&(prop)->value)
+
+#define PROP_SET_TRUE(prop)                                                                                     \
+        ITEM_SET_TRUE(&(prop)->value)
+
+#define PROP_SET_FALSE(prop)                                                                                    \
+        ITEM_SET_FALSE(&(prop)->value)
+
+#define PROP_SET_NUMBER_FLOAT(prop, float_value)                                                                \
+        ITEM_SET_NUMBER_FLOAT(&(prop)->value, float_value)
+
+#define PROP_SET_NUMBER_SIGNED(prop, i64_value)                                                                 \
+        ITEM_SET_NUMBER_SIGNED(&(prop)->value, i64_value)
+
+#define PROP_SET_NUMBER_UNSIGNED(prop, u64_value)                                                               \
+        ITEM_SET_NUMBER_UNSIGNED(&(prop)->value, u64_value)
+
+#define PROP_SET_STRING(prop, const_char_str)                                                                   \
+        ITEM_SET_STRING(&(prop)->value, const_char_str)
+
+#define PROP_SET_BINARY(prop, const_void_ptr_value, size_t_nbytes, const_char_ptr_file_ext, const_char_ptr_user_type) \
+        ITEM_SET_BINARY(&(prop)->value, const_void_ptr_value, size_t_nbytes, const_char_ptr_file_ext, const_char_ptr_user_type)
+
+#define PROP_SET_ARRAY_BEGIN(state, prop)                                                                       \
+        ITEM_SET_ARRAY_BEGIN(state, &(prop)->value)
+
+#define PROP_SET_ARRAY_END(state)                                                                               \
+        ITEM_SET_ARRAY_END(state)
+
+#define PROP_SET_COLUMN_BEGIN(state, prop)                                                                      \
+        ITEM_SET_COLUMN_BEGIN(state, &(prop)->value)
+
+#define PROP_SET_COLUMN_END(state)                                                                              \
+        ITEM_SET_COLUMN_END(state)
+
+#define PROP_SET_OBJECT_BEGIN(state, prop)                                                                      \
+        ITEM_SET_OBJECT_BEGIN(state, &(prop)->value)
+
+#define PROP_SET_OBJECT_END(state)                                                                              \
+        ITEM_SET_OBJECT_END(state)
+
+#define PROP_SET_FROM_REC(prop, const_carbon_ptr_src)                                                        \
+        ITEM_SET_FROM_REC(&(prop)->value, const_carbon_ptr_src)
+
+#define PROP_SET_FROM_ARRAY(prop, const_arr_it_ptr_src)                                                         \
+        ITEM_SET_FROM_ARRAY(&(prop)->value, const_arr_it_ptr_src)
+
+#define PROP_SET_FROM_OBJECT(prop, const_obj_it_ptr_src)                                                        \
+        ITEM_SET_FROM_OBJECT(&(prop)->value, const_obj_it_ptr_src)
+
+#define PROP_SET_FROM_COLUMN(prop, const_col_it_ptr_src)                                                        \
+        ITEM_SET_FROM_COLUMN(&(prop)->value, const_col_it_ptr_src)
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  for internal usage
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool internal_prop_create(prop *dst, obj_it *parent);
+
+u64 internal_prop_size(memfile *file);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/*
+ * revise - thread-safe modification of records by revise records
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_REVISE_H
+#define HAD_REVISE_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/stdx/unique_id.h>
+#include <karbonit/rec.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Acquires a new revision context for the carbon document.
+ *
+ * In case of an already running revision, the function returns <code>false</code> without blocking.
+ * Otherwise, <code>revise_begin</code> is called internally.
+ *
+ * @param context non-null pointer to revision context
+ * @param doc document that should be revised
+ * @return <code>false</code> in case of an already running revision. Otherwise returns value of
+ *                            <code>revise_begin</code>
+ */
+void revise_begin(rev *context, rec *revised, rec *original);
+
+/**
+ * Begins a revision as <code>revise_begin</code> does, for which <code>index</code> is a path index of the original
+ * record (see <code>pindex_create</code>). The path of the first update (or removal) of the revision is resolved by
+ * jumping to its position known from the index. The revision releases the index when the revised record is accessed
+ * for modification (e.g., by <code>revise_iterator_open</code>), since the positions in the index are outdated then.
+ * An index that was not created for <code>original</code> is ignored.
+ */
+void revise_begin_indexed(rev *context, rec *revised, rec *original, pindex *index);
+
+/**
+ * Begins a revision as <code>revise_begin</code> does, but copies <code>original</code> into heap memory at once
+ * rather than sharing it copy-on-write (see MEMBLOCK_CPY_SHARED), i.e., the revision does not hold a shared memory
+ * object.
+ */
+void revise_begin_copy(rev *context, rec *revised, rec *original);
+const rec *revise_end(rev *context);
+
+bool revise_key_generate(unique_id_t *out, rev *context);
+
+bool revise_key_set_unsigned(rev *context, u64 key_value);
+bool revise_key_set_signed(rev *context, i64 key_value);
+bool revise_key_set_string(rev *context, const char *key_value);
+
+void revise_set_list_type(rev *context, list_type_e derivation);
+
+/**
+ * Enables (or disables) the gap editing mode for the revised record. In gap mode, the revised record keeps a movable
+ * gap at the position of the most recent insertion or removal such that sequences of localized edits (e.g., inserting
+ * many elements at the same iterator position) do not move the remainder of the record for each single edit. The
+ * record is materialized into its contiguous layout at latest by <code>revise_end</code>.
+ *
+ * @param context non-null pointer to revision context
+ * @param enabled <code>true</code> to enable the gap mode, <code>false</code> to disable it
+ * @return <code>true</code> on success, otherwise <code>false</code>
+ */
+bool revise_set_gap_mode(rev *context, bool enabled);
+
+bool revise_iterator_open(arr_it *it, rev *context);
+
+bool revise_find_begin(find *out, const char *dot, rev *context);
+
+bool revise_remove(const char *dot, rev *context);
+bool revise_remove_one(const char *dot, rec *rev_doc, rec *doc);
+
+bool revise_pack(rev *context);
+bool revise_shrink(rev *context);
+
+bool revise_abort(rev *context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/*
+ * skip-index - positional side-car index for random access into large arrays
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_SKIP_INDEX_H
+#define HAD_SKIP_INDEX_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/rec.h>
+#include <karbonit/std/vec.h>
+#include <karbonit/carbon/arr-it.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SKIP_INDEX_DEFAULT_STRIDE       64
+
+/**
+ * Positions of every <code>stride</code>-th element of an array, such that an iterator can be moved to any element
+ * by stepping over at most <code>stride - 1</code> elements (see <code>arr_it_seek</code>).
+ */
+typedef struct arr_skip {
+        /* offset of the array in its record, which identifies the array */
+        offset_t begin;
+        /* number of elements between two consecutive positions */
+        u32 stride;
+        /* number of elements in the array */
+        u64 len;
+        /* for the elements 0, stride, 2 * stride, ..., the offset at which the iterator reads the element */
+        vec ofType(offset_t) offsets;
+} arr_skip;
+
+/**
+ * Skip indexes for all arrays of a record that have a minimum number of elements. The index is kept aside from the
+ * record, and is bound to the revision of the record it was created for (see <code>skip_index_indexes_doc</code>).
+ * Like a record revision, an index is not modified once created, and may be used by several threads at the same time.
+ */
+typedef struct skip_index {
+        /* commit hash of the indexed record revision */
+        u64 commit_hash;
+        /* checksum of the contents of the indexed record (see commit_compute), since records without a primary key
+         * have no commit hash */
+        u64 checksum;
+        u32 stride;
+        u32 min_len;
+        /* indexed arrays, sorted by their offset */
+        vec ofType(arr_skip) arrays;
+} skip_index;
+
+/**
+ * Indexes the array on which <code>it</code> operates, which is scanned from its beginning. The iterator itself is
+ * not moved.
+ */
+bool arr_skip_create(arr_skip *skip, arr_it *it, u32 stride);
+bool arr_skip_drop(arr_skip *skip);
+
+/**
+ * Moves the iterator to the element at <code>pos</code>, and returns that element as <code>arr_it_next</code> does.
+ * The iterator can be in any state, and continues with the element after <code>pos</code> afterwards. If
+ * <code>skip</code> is non-null, it must have been created for the same array, and the iterator jumps close to the
+ * requested element instead of stepping over all elements before it. Returns <code>NULL</code> if the array has no
+ * element at <code>pos</code>.
+ */
+item *arr_it_seek(arr_it *it, u64 pos, const arr_skip *skip);
+
+/**
+ * Creates skip indexes with the given stride for all arrays (the record itself included) that have at least
+ * <code>min_len</code> elements. For <code>stride</code> 0, <code>SKIP_INDEX_DEFAULT_STRIDE</code> is used.
+ */
+bool skip_index_create(skip_index *index, rec *doc, u32 stride, u32 min_len);
+bool skip_index_drop(skip_index *index);
+
+/**
+ * Re-creates the index for <code>doc</code> (with the same stride and minimum length) if it does not index
+ * <code>doc</code>, e.g., after <code>doc</code> was revised.
+ */
+bool skip_index_update(skip_index *index, rec *doc);
+
+/**
+ * Returns true if <code>index</code> was created for the revision of <code>doc</code>. Records without a
+ * primary key have no commit hash; for these, the checksum of their contents is compared instead, which costs a pass
+ * over the record.
+ */
+bool skip_index_indexes_doc(const skip_index *index, rec *doc);
+
+/**
+ * Returns the skip index of the array at offset <code>begin</code> in the record, or <code>NULL</code> if that array
+ * is not indexed.
+ */
+const arr_skip *skip_index_get(const skip_index *index, offset_t begin);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/*
+ * store - in-memory store of records by their primary key
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_STORE_H
+#define HAD_STORE_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/rec.h>
+#include <karbonit/carbon/revise.h>
+#include <karbonit/std/epoch.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* maximum number of levels of the ordered index */
+#define STORE_MAX_HEIGHT        16
+
+typedef struct store_node store_node;
+typedef struct store_table store_table;
+
+/* primary key of a record in a store */
+typedef struct store_key {
+        union {
+                u64 unsigned_key;
+                i64 signed_key;
+        } value;
+        /* string keys only, not null-terminated */
+        const char *str;
+        u64 len;
+} store_key;
+
+/**
+ * Records by their primary key (see <code>rec_create_begin</code>), all of the same key type, with a hash index for
+ * lookups of single keys and an ordered index (a skip list) for scans over key ranges.
+ *
+ * A store has a single writer, which modifies the store by <code>store_put</code>, <code>store_remove_*</code>,
+ * and <code>store_revise_end</code>. The writer must be serialized by the caller (e.g., by a spinlock). Any number
+ * of readers (<code>store_get_*</code>, <code>store_scan_*</code>) run concurrently to the writer and to each other
+ * without locks: the writer never modifies a record or an index entry that is reachable by readers, but publishes
+ * new records and entries by atomic pointer updates. A reader sees each record either before or after a concurrent
+ * update, but never a partially updated record.
+ *
+ * Readers access the store only inside read-side critical sections of the store's epoch, i.e., a reader thread
+ * registers once by <code>epoch_register(&store->reclaim)</code>, and brackets its lookups, scans, and the use of the
+ * views it got by <code>epoch_enter</code> and <code>epoch_leave</code>. Records and index entries that the writer
+ * replaces or removes are retired to the epoch, and are dropped once no reader is in a critical section anymore that
+ * may access them (see <code>epoch_retire</code>).
+ */
+typedef struct store {
+        key_e key_type;
+        /* ordered index, whose head has STORE_MAX_HEIGHT levels and no key */
+        store_node *head;
+        /* hash index, which is replaced as a whole when it grows */
+        _Atomic(store_table *) table;
+        /* number of records, which readers load concurrently to the writer */
+        _Atomic(u64) len;
+        /* state of the random number generator for the levels of nodes in the ordered index */
+        u64 seed;
+        /* reclamation of replaced and removed records, and of index entries */
+        epoch reclaim;
+} store;
+
+/* scan over a key range of a store, see store_scan_unsigned */
+typedef struct store_it {
+        store *source;
+        store_node *node;
+        bool has_upper;
+        store_key upper;
+} store_it;
+
+/**
+ * Creates an empty store for records with primary keys of type <code>key_type</code>, which is one of
+ * <code>KEY_AUTOKEY</code>, <code>KEY_UKEY</code>, <code>KEY_IKEY</code>, and <code>KEY_SKEY</code>.
+ */
+bool store_create(store *store, key_e key_type);
+
+/**
+ * Drops the store and all records in it, including the retired ones. No reader must be in a critical section.
+ */
+bool store_drop(store *store);
+
+/**
+ * Returns the number of records in the store.
+ */
+u64 store_len(store *store);
+
+/**
+ * Adds the record <code>doc</code> to the store, replacing the record with the same primary key if any. The store
+ * takes over <code>doc</code>, which must not be dropped (or modified) by the caller afterwards. The replaced record
+ * is retired (see <code>store</code>). Fails with <code>ERR_TYPEMISMATCH</code> if the key type of <code>doc</code>
+ * is not the one of the store.
+ */
+bool store_put(store *store, rec *doc);
+
+/**
+ * Removes the record with the primary key <code>key</code> from the store, and retires it. Returns
+ * <code>false</code> if there is no such record.
+ */
+bool store_remove_unsigned(store *store, u64 key);
+bool store_remove_signed(store *store, i64 key);
+bool store_remove_string(store *store, const char *key);
+
+/**
+ * Drops retired records and index entries that no reader accesses anymore (see <code>epoch_collect</code>), which
+ * otherwise happens as the writer retires further ones. Returns the number of objects that remain retired.
+ */
+u64 store_reclaim(store *store);
+
+/**
+ * Looks up the record with the primary key <code>key</code> and makes <code>view</code> a read-only view of it.
+ * Returns <code>false</code> if there is no such record. A view is valid until the reader leaves its critical section
+ * even if the record is replaced or removed meanwhile, and is not dropped by the caller. A view is private to a
+ * reader, i.e., reading through the view does not interfere with other readers.
+ */
+bool store_get_unsigned(rec *view, store *store, u64 key);
+bool store_get_signed(rec *view, store *store, i64 key);
+bool store_get_string(rec *view, store *store, const char *key);
+
+/**
+ * Starts a scan over the records with primary keys between <code>lower</code> and <code>upper</code> (both
+ * inclusive) in ascending key order, whose records are fetched by <code>store_it_next</code>. For string keys, a
+ * <code>NULL</code> bound is unbounded, and <code>upper</code> must stay valid during the scan. A scan that runs
+ * concurrently to the writer sees records that are added or removed during the scan or not, but sees each record that
+ * is in the store during the whole scan exactly once.
+ */
+bool store_scan_unsigned(store_it *it, store *store, u64 lower, u64 upper);
+bool store_scan_signed(store_it *it, store *store, i64 lower, i64 upper);
+bool store_scan_string(store_it *it, store *store, const char *lower, const char *upper);
+
+/**
+ * Makes <code>view</code> a read-only view (see <code>store_get_unsigned</code>) of the next record of the scan.
+ * Returns <code>false</code> if there is no more record.
+ */
+bool store_it_next(rec *view, store_it *it);
+
+/**
+ * Begins a revision of the record of which <code>view</code> is a view. The record is copied at once (see
+ * <code>revise_begin_copy</code>) such that records in the store do not hold shared memory objects. The revision is
+ * completed by <code>store_revise_end</code>, or aborted by <code>revise_abort</code>. The writer itself may use views
+ * outside of critical sections as long as it does not replace or remove their records.
+ */
+bool store_revise_begin(rev *context, rec *revised, rec *view);
+
+/**
+ * Ends the revision as <code>revise_end</code> does, and atomically replaces the original record in the store with
+ * the revised record (see <code>store_put</code>). If the revision changed the primary key, the record with the
+ * original key is removed.
+ */
+bool store_revise_end(store *store, rev *context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * string-field - low-level string field for Carbon records
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_STRING_FIELD_H
+#define HAD_STRING_FIELD_H
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/mem/memfile.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct string_field
+{
+        const char *str;
+        u64 len;
+} string_field;
+
+static string_field NULL_STRING = {
+        .str = NULL,
+        .len = 0
+};
+
+bool string_field_write(memfile *file, const char *string);
+bool string_field_nchar_write(memfile *file, const char *string, u64 str_len);
+bool string_field_nomarker_write(memfile *file, const char *string);
+bool string_field_nomarker_nchar_write(memfile *file, const char *string, u64 str_len);
+bool string_field_nomarker_remove(memfile *file);
+bool string_field_remove(memfile *file);
+bool string_field_update(memfile *file, const char *string);
+bool string_field_update_wnchar(memfile *file, const char *string, size_t str_len);
+bool string_field_skip(memfile *file);
+bool string_field_nomarker_skip(memfile *file);
+const char *string_field_read(u64 *len, memfile *file);
+const char *string_field_nomarker_read(u64 *len, memfile *file);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * traverse - traversal framework for Carbon records and containers
+ *
+ * Copyright 2020 Marcus Pinnecke
+ */
+
+#ifndef HAD_TRAVERSE_FRAMEWORK_H
+#define HAD_TRAVERSE_FRAMEWORK_H
+
+#include <karbonit/stdinc.h>
+#include <karbonit/forwdecl.h>
+#include <karbonit/rec.h>
+#include <karbonit/carbon/arr-it.h>
+#include <karbonit/carbon/col-it.h>
+#include <karbonit/carbon/obj-it.h>
+#include <karbonit/carbon/dot.h>
+#include <karbonit/carbon/item.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct traverser_fn traverser_fn;
+
+typedef enum path_policy
+{
+        PATH_PRUNE, /* stop traversal in this branch */
+        PATH_EXPAND /* continue traversal if possible */
+} path_policy_e;
+
+typedef enum visit_ops
+{
+        VISIT_CALL_RECORD_ENTER = 0x1 << 0, /* call 'visit_record' when a record was found */
+        VISIT_CALL_RECORD_EXIT = 0x1 << 1, /* call 'visit_record' when a record traversal ended */
+        VISIT_CALL_ARRAY_ENTER = 0x1 << 2, /* call 'visit_array' when an array was found */
+        VISIT_CALL_ARRAY_EXIT = 0x1 << 3, /* call 'visit_array' when an array traversal ended */
+        VISIT_CALL_OBJECT_ENTER = 0x1 << 4, /* call 'visit_object' when an object was found */
+        VISIT_CALL_OBJECT_EXIT = 0x1 << 5, /* call 'visit_object' when an object traversal ended */
+        VISIT_CALL_FIELD_ENTER = 0x1 << 6, /* call 'visit_field' when a field was found */
+        VISIT_CALL_FIELD_EXIT = 0x1 << 7, /* call 'visit_field' when a field traversal ended */
+        VISIT_CALL_PROP_ENTER = 0x1 << 8, /* call 'visit_prop' when a property was found */
+        VISIT_CALL_PROP_EXIT = 0x1 << 9, /* call 'visit_prop' when a property traversal ended */
+        VISIT_NO_PATH = 0x1 << 10 /* do not create dot-path information during traversal */
+} visit_ops_e;
+
+#define VISIT_ALL   (VISIT_CALL_RECORD_ENTER | VISIT_CALL_RECORD_EXIT |                                                \
+                     VISIT_CALL_ARRAY_ENTER | VISIT_CALL_ARRAY_EXIT |                                                  \
+                     VISIT_CALL_OBJECT_ENTER | VISIT_CALL_OBJECT_EXIT |                                                \
+                     VISIT_CALL_FIELD_ENTER | VISIT_CALL_FIELD_EXIT |                                                  \
+                     VISIT_CALL_PROP_ENTER | VISIT_CALL_PROP_EXIT)
+
+typedef enum visit_type
+{
+        ON_ENTER, /* 'visit_*' function was called because element was found */
+        ON_EXIT /* 'visit_*' function was called because element traversal has ended */
+} visit_type_e;
+
+typedef struct traverse_context
+{
+        dot path;
+        visit_type_e type;
+} traverse_info;
+
+typedef struct traverse_hidden
+{
+        void *arg;
+        union {
+            struct {
+                bool record_is_array;
+            } json_printer;
+            void *extra;
+        };
+} traverse_hidden;
+
+typedef void (*traverse_fn_create)(traverse_hidden *extra); /* called when traverser is created to setup implementation */
+
+typedef void (*traverse_fn_drop)(traverse_hidden *extra); /* call with live-time end, used for resource releasing */
+
+typedef path_policy_e (*traverse_fn_record)(const rec *record, const traverse_info *context, traverse_hidden *extra);
+
+typedef path_policy_e (*traverse_fn_array)(const arr_it *array, const traverse_info *context, traverse_hidden *extra);
+
+typedef path_policy_e (*traverse_fn_object)(const obj_it *object, const traverse_info *context, traverse_hidden *extra);
+
+typedef path_policy_e (*traverse_fn_field)(const item *field, const traverse_info *context, traverse_hidden *extra);
+
+typedef path_policy_e (*traverse_fn_prop)(const prop *prop, const traverse_info *context, traverse_hidden *extra);
+
+typedef struct traverser_fn
+{
+        traverse_fn_create create;
+        traverse_fn_drop drop;
+
+        traverse_fn_record visit_record;
+        traverse_fn_array visit_array;
+        traverse_fn_object visit_object;
+        traverse_fn_field visit_field;
+        traverse_fn_prop visit_prop;
+
+} traverser_fn;
+
+typedef struct traverse_impl
+{
+        traverser_fn fn;
+        traverse_hidden extra;
+} traverse_impl;
+
+typedef enum
+{
+        CNTX_RECORD,
+        CNTX_ARRAY,
+        CNTX_OBJECT,
+        CNTX_COLUMN,
+        CNTX_ITEM,
+        CNTX_PROP,
+} cntx_type_e;
+
+typedef struct {
+        cntx_type_e type;
+        union {
+                rec *record;
+                arr_it *array;
+                col_it *column;
+                obj_it *object;
+                item *item;
+                prop *prop;
+                const void *any;
+        } container;
+} container_cntx;
+
+typedef struct
+{
+        vec ofType(container_cntx) context;
+        unsigned visit_ops;
+        traverse_impl impl;
+        traverse_info info;
+} traverser;
+
+#define TRAVERSE(str_buf_dst, fn, visit_ops, traverse_func, src)                                                       \
+{                                                                                                                      \
+        traverser traverser;                                                                                           \
+        str_buf_clear(str_buf_dst);                                                                                    \
+        traverser_create(&traverser, (fn), (visit_ops));                                                               \
+        traverse_func(&traverser, src, str_buf_dst);                                                                   \
+        traverser_drop(&traverser);                                                                                    \
+}
+
+void traverser_create(traverser *traverse, const traverser_fn *fns, unsigned visit_ops); /* xor visit_ops_e */
+void traverser_drop(traverser *traverse);
+
+void traverser_run_from_record(traverser *traverse, rec *record, void *arg);
+void traverser_run_from_array(traverser *traverse, arr_it *it, void *arg);
+void traverser_run_from_object(traverser *traverse, obj_it *it, void *arg);
+void traverser_run_from_item(traverser *traverse, item *i, void *arg);
+void traverser_run_from_prop(traverser *traverse, prop *p, void *arg);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif/*
+ * update - update operations on records, containers and fields
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_UPDATE_H
+#define HAD_UPDATE_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/mem/memblock.h>
+#include <karbonit/mem/memfile.h>
+#include <karbonit/std/spinlock.h>
+#include <karbonit/rec.h>
+#include <karbonit/carbon/dot.h>
+#include <karbonit/carbon/dot-eval.h>
+#include <karbonit/carbon/internal.h>
+#include <karbonit/carbon/projection.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct update {
+        rev *context;
+        dot_eval eval;
+        const dot *path;
+} update;
+
+typedef enum update_batch_op_e {
+        UPDATE_BATCH_NULL,
+        UPDATE_BATCH_TRUE,
+        UPDATE_BATCH_FALSE,
+        UPDATE_BATCH_UNSIGNED,
+        UPDATE_BATCH_SIGNED,
+        UPDATE_BATCH_FLOAT
+} update_batch_op_e;
+
+typedef struct update_batch_op {
+        update_batch_op_e type;
+        /* path as given, owned by the batch */
+        char *path;
+        union {
+                u64 unsigned_value;
+                i64 signed_value;
+                float float_value;
+        } value;
+} update_batch_op;
+
+/**
+ * Set of (path, value) updates that are applied to a record together (see <code>update_batch_exec</code>). All
+ * paths of a batch are resolved in a single traversal of the record, whereas each <code>update_set_*</code> call
+ * resolves its path from the record root on its own. A batch is not modified by its execution, and may be applied
+ * to any number of records.
+ */
+typedef struct update_batch {
+        /* paths of the updates, in the order the updates were added */
+        projection paths;
+        vec ofType(update_batch_op) ops;
+} update_batch;
+
+bool update_set_null(rev *context, const char *path);
+bool update_set_true(rev *context, const char *path);
+bool update_set_false(rev *context, const char *path);
+bool update_set_u8(rev *context, const char *path, u8 value);
+bool update_set_u16(rev *context, const char *path, u16 value);
+bool update_set_u32(rev *context, const char *path, u32 value);
+bool update_set_u64(rev *context, const char *path, u64 value);
+bool update_set_i8(rev *context, const char *path, i8 value);
+bool update_set_i16(rev *context, const char *path, i16 value);
+bool update_set_i32(rev *context, const char *path, i32 value);
+bool update_set_i64(rev *context, const char *path, i64 value);
+bool update_set_float(rev *context, const char *path, float value);
+bool update_set_unsigned(rev *context, const char *path, u64 value);
+bool update_set_signed(rev *context, const char *path, i64 value);
+bool update_set_string(rev *context, const char *path, const char *value);
+bool update_set_binary(rev *context, const char *path, const void *value, size_t nbytes, const char *file_ext, const char *user_type);
+
+insert *update_set_array_begin(rev *context, const char *path, arr_state *state_out, u64 array_capacity);
+bool update_set_array_end(arr_state *state_in);
+
+insert *update_set_column_begin(rev *context, const char *path, col_state *state_out, field_e type, u64 cap);
+bool update_set_column_end(col_state *state_in);
+
+bool update_set_null_compiled(rev *context, const dot *path);
+bool update_set_true_compiled(rev *context, const dot *path);
+bool update_set_false_compiled(rev *context, const dot *path);
+
+bool update_set_u8_compiled(rev *context, const dot *path, u8 value);
+bool update_set_u16_compiled(rev *context, const dot *path, u16 value);
+bool update_set_u32_compiled(rev *context, const dot *path, u32 value);
+bool update_set_u64_compiled(rev *context, const dot *path, u64 value);
+bool update_set_i8_compiled(rev *context, const dot *path, i8 value);
+bool update_set_i16_compiled(rev *context, const dot *path, i16 value);
+bool update_set_i32_compiled(rev *context, const dot *path, i32 value);
+bool update_set_i64_compiled(rev *context, const dot *path, i64 value);
+bool update_set_float_compiled(rev *context, const dot *path, float value);
+bool update_set_unsigned_compiled(rev *context, const dot *path, u64 value);
+bool update_set_signed_compiled(rev *context, const dot *path, i64 value);
+bool update_set_string_compiled(rev *context, const dot *path, const char *value);
+bool update_set_binary_compiled(rev *context, const dot *path, const void *value, size_t nbytes, const char *file_ext, const char *user_type);
+insert * update_set_array_begin_compiled(rev *context, const dot *path, arr_state *state_out, u64 array_capacity);
+bool update_set_array_end_compiled(arr_state *state_in);
+insert *update_set_column_begin_compiled(rev *context, const dot *path, col_state *state_out, field_e type, u64 cap);
+bool update_set_column_end_compiled(col_state *state_in);
+
+bool update_one_set_null(const char *dot, rec *rev_doc, rec *doc);
+bool update_one_set_true(const char *dot, rec *rev_doc, rec *doc);
+bool update_one_set_false(const char *dot, rec *rev_doc, rec *doc);
+bool update_one_set_u8(const char *dot, rec *rev_doc, rec *doc, u8 value);
+bool update_one_set_u16(const char *dot, rec *rev_doc, rec *doc, u16 value);
+bool update_one_set_u32(const char *dot, rec *rev_doc, rec *doc, u32 value);
+bool update_one_set_u64(const char *dot, rec *rev_doc, rec *doc, u64 value);
+bool update_one_set_i8(const char *dot, rec *rev_doc, rec *doc, i8 value);
+bool update_one_set_i16(const char *dot, rec *rev_doc, rec *doc, i16 value);
+bool update_one_set_i32(const char *dot, rec *rev_doc, rec *doc, i32 value);
+bool update_one_set_i64(const char *dot, rec *rev_doc, rec *doc, i64 value);
+bool update_one_set_float(const char *dot, rec *rev_doc, rec *doc, float value);
+bool update_one_set_unsigned(const char *dot, rec *rev_doc, rec *doc, u64 value);
+bool update_one_set_signed(const char *dot, rec *rev_doc, rec *doc, i64 value);
+bool update_one_set_string(const char *dot, rec *rev_doc, rec *doc, const char *value);
+bool update_one_set_binary(const char *dot, rec *rev_doc, rec *doc, const void *value, size_t nbytes, const char *file_ext, const char *user_type);
+insert *update_one_set_array_begin(arr_state *state_out, const char *dot, rec *rev_doc, rec *doc, u64 array_capacity);
+bool update_one_set_array_end(arr_state *state_in);
+
+insert *update_one_set_column_begin(col_state *state_out, const char *dot, rec *rev_doc, rec *doc, field_e type, u64 cap);
+bool update_one_set_column_end(col_state *state_in);
+
+bool update_one_set_null_compiled(const dot *path, rec *rev_doc, rec *doc);
+bool update_one_set_true_compiled(const dot *path, rec *rev_doc, rec *doc);
+bool update_one_set_false_compiled(const dot *path, rec *rev_doc, rec *doc);
+bool update_one_set_u8_compiled(const dot *path, rec *rev_doc, rec *doc, u8 value);
+bool update_one_set_u16_compiled(const dot *path, rec *rev_doc, rec *doc, u16 value);
+bool update_one_set_u32_compiled(const dot *path, rec *rev_doc, rec *doc, u32 value);
+bool update_one_set_u64_compiled(const dot *path, rec *rev_doc, rec *doc, u64 value);
+bool update_one_set_i8_compiled(const dot *path, rec *rev_doc, rec *doc, i8 value);
+bool update_one_set_i16_compiled(const dot *path, rec *rev_doc, rec *doc, i16 value);
+bool update_one_set_i32_compiled(const dot *path, rec *rev_doc, rec *doc, i32 value);
+bool update_one_set_i64_compiled(const dot *path, rec *rev_doc, rec *doc, i64 value);
+bool update_one_set_float_compiled(const dot *path, rec *rev_doc, rec *doc, float value);
+bool update_one_set_unsigned_compiled(const dot *path, rec *rev_doc, rec *doc, u64 value);
+bool update_one_set_signed_compiled(const dot *path, rec *rev_doc, rec *doc, i64 value);
+bool update_one_set_string_compiled(const dot *path, rec *rev_doc, rec *doc, const char *value);
+bool update_one_set_binary_compiled(const dot *path, rec *rev_doc, rec *doc, const void *value, size_t nbytes, const char *file_ext, const char *user_type);
+insert *update_one_set_array_begin_compiled(arr_state *state_out, const dot *path, rec *rev_doc, rec *doc, u64 array_capacity);
+bool update_one_set_array_end_compiled(arr_state *state_in);
+
+insert *update_one_set_column_begin_compiled(col_state *state_out, const dot *path, rec *rev_doc, rec *doc, field_e type, u64 cap);
+bool update_one_set_column_end_compiled(col_state *state_in);
+
+bool update_batch_create(update_batch *batch);
+bool update_batch_drop(update_batch *batch);
+
+/**
+ * Adds an update of the field at <code>path</code> to the batch. Updates are applied in the order they are added;
+ * if a path is updated more than once, the last update wins. As for <code>update_set_unsigned</code> and
+ * <code>update_set_signed</code>, an integer is stored with the smallest type that holds it, unless it is written
+ * into an existing number field that holds it.
+ */
+bool update_batch_set_null(update_batch *batch, const char *path);
+bool update_batch_set_true(update_batch *batch, const char *path);
+bool update_batch_set_false(update_batch *batch, const char *path);
+bool update_batch_set_unsigned(update_batch *batch, const char *path, u64 value);
+bool update_batch_set_signed(update_batch *batch, const char *path, i64 value);
+bool update_batch_set_float(update_batch *batch, const char *path, float value);
+
+/**
+ * Returns the number of updates in the batch
+ */
+u32 update_batch_len(const update_batch *batch);
+
+/**
+ * Applies all updates of the batch to the revised record of <code>context</code> in the order they were added, with
+ * a result equal in value, but not necessarily in stored type, to the corresponding <code>update_set_*</code> calls.
+ * The paths are resolved in one traversal of the record. Updates that do not change the size of the field (e.g., a
+ * number is written into an existing number field that holds the number, or a constant replaces a constant) are
+ * written in place, up to the first update that cannot be written in place. A number written in place keeps the type
+ * of the existing field, whereas <code>update_set_unsigned</code> and <code>update_set_signed</code> store the
+ * smallest type that holds it. The update that cannot be written in place and all later updates are applied as the
+ * corresponding <code>update_set_*</code> function does. Returns true if all updates are applied.
+ */
+bool update_batch_exec(rev *context, const update_batch *batch);
+
+/**
+ * Applies the batch to <code>doc</code> in a new revision <code>rev_doc</code>, such that the commit hash is updated
+ * once for all updates of the batch.
+ */
+bool update_one_batch(const update_batch *batch, rec *rev_doc, rec *doc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/*
+ * ERROR - ERROR system
+ *
+ * Copyright 2018 Marcus Pinnecke
+ */
+
+#ifndef HAD_ERROR_H
+#define HAD_ERROR_H
+
+#include <stdint.h>
+
+#include <karbonit/forwdecl.h>
+#include <karbonit/stdinc.h>
+#include <karbonit/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ERR_NOERR 0                    /** No ERROR */
+#define ERR_NULLPTR 1                  /** Null pointer detected */
+#define ERR_NOTIMPL 2                  /** Function not implemented */
+#define ERR_OUTOFBOUNDS 3              /** Index is out of bounds */
+#define ERR_MALLOCERR 4                /** Memory allocation failed */
+#define ERR_ILLEGALARG 5               /** Illegal arguments */
+#define ERR_INTERNALERR 6              /** Internal ERROR */
+#define ERR_ILLEGALIMPL 7              /** Illegal implementation */
+#define ERR_NOTFOUND 8                 /** Not found */
+#define ERR_NIL 9                      /** Element not in list */
+#define ERR_ARRAYOFARRAYS 10           /** Array index out of bounds */
+#define ERR_ARRAYOFMIXEDTYPES 11       /** Illegal JSON array: mixed types */
+#define ERR_FOPEN_FAILED 12            /** Reading from file failed */
+#define ERR_IO 13                      /** I/O ERROR */
+#define ERR_FORMATVERERR 14            /** Unsupported archive format version */
+#define ERR_CORRUPTED 15               /** Format is corrupted */
+#define ERR_NOCARBONSTREAM 16          /** Stream is not a carbon archive */
+#define ERR_NOBITMODE 17               /** Not in bit writing mode */
+#define ERR_NOTIMPLEMENTED 18          /** Function is not yet implemented */
+#define ERR_NOTYPE 19                  /** Unsupported type found */
+#define ERR_NOCOMPRESSOR 20            /** Unsupported compressor strategy requested */
+#define ERR_NOVALUESTR 21              /** No string representation for type available */
+#define ERR_MARKERMAPPING 22           /** Marker type cannot be mapped to value type */
+#define ERR_PARSETYPE 23               /** Parsing stopped; unknown data type requested */
+#define ERR_NOJSONTOKEN 24             /** Unknown token during parsing JSON detected */
+#define ERR_NOJSONNUMBERT 25           /** Unknown value type for number in JSON property */
+#define ERR_NOARCHIVEFILE 26           /** Stream is not a valid archive file */
+#define ERR_UNSUPFINDSTRAT 27          /** Unsupported strategy requested for key lookup */
+#define ERR_ERRINTERNAL 28             /** Internal ERROR */
+#define ERR_HUFFERR 29                 /** No huffman code table entry found for character */
+#define ERR_MEMSTATE 30                /** Memory file was opened as read-only but requested a modification */
+#define ERR_JSONTYPE 31                /** Unable to import json file: unsupported type */
+#define ERR_WRITEPROT 32               /** Mode set to read-only but modification was requested */
+#define ERR_READOUTOFBOUNDS 33         /** Read outside of memory range bounds */
+#define ERR_SLOTBROKEN 34              /** Slot management broken */
+#define ERR_THREADOOOBJIDS 35          /** Thread run out of object ids: start another one */
+#define ERR_JSONPARSEERR 36            /** JSON parsing ERROR */
+#define ERR_BULKCREATEFAILED 37        /** Document insertion bulk creation failed */
+#define ERR_FOPENWRITE 38              /** File cannot be opened for writing */
+#define ERR_WRITEARCHIVE 39            /** Archive cannot be serialized into file */
+#define ERR_ARCHIVEOPEN 40             /** Archive cannot be deserialized form file */
+#define ERR_FREAD_FAILED 41            /** Unable to read from file */
+#define ERR_SCAN_FAILED 42             /** Unable to perform full scan in archive file */
+#define ERR_DECOMPRESSFAILED 43        /** String decompression from archive failed */
+#define ERR_ITERATORNOTCLOSED 44       /** Closing iterator failed */
+#define ERR_HARDCOPYFAILED 45          /** Unable to construct a hard copy of the source object */
+#define ERR_REALLOCERR 46              /** Memory reallocation failed */
+#define ERR_PREDEVAL_FAILED 47         /** Predicate evaluation failed */
+#define ERR_INITFAILED 48              /** Initialization failed */
+#define ERR_DROPFAILED 49              /** Resource release failed: potentially a memory leak occurred */
+#define ERR_OPPFAILED 50               /** Operation failed */
+#define ERR_REHASH_NOROLLBACK 51       /** Rehashing hash table failed; rollback is not performed */
+#define ERR_MEMFILEOPEN_FAILED 52      /** Unable to open memory file */
+#define ERR_VITEROPEN_FAILED 53        /** Value iterator cannot be initialized */
+#define ERR_MEMFILESKIP_FAILED 54      /** Memfile cannot skip desired amount of bytes */
+#define ERR_MEMFILESEEK_FAILED 55      /** Unable to seek in memory file */
+#define ERR_ITER_NOOBJ 56              /** Unable to get value: type is not non-array object */
+#define ERR_ITER_NOBOOL 57             /** Unable to get value: type is not non-array boolean */
+#define ERR_ITER_NOINT8 58             /** Unable to get value: type is not non-array int8 */
+#define ERR_ITER_NOINT16 59            /** Unable to get value: type is not non-array int16 */
+#define ERR_ITER_NOINT32 60            /** Unable to get value: type is not non-array int32 */
+#define ERR_ITER_NOINT64 61            /** Unable to get value: type is not non-array int64 */
+#define ERR_ITER_NOUINT8 62            /** Unable to get value: type is not non-array uint8 */
+#define ERR_ITER_NOUINT16 63           /** Unable to get value: type is not non-array uint16 */
+#define ERR_ITER_NOUINT32 64           /** Unable to get value: type is not non-array uint32 */
+#define ERR_ITER_NOUINT64 65           /** Unable to get value: type is not non-array uint64 */
+#define ERR_ITER_NONUMBER 66           /** Unable to get value: type is not non-array number */
+#define ERR_ITER_NOSTRING 67           /** Unable to get value: type is not non-array string */
+#define ERR_ITER_OBJECT_NEEDED 68      /** Illegal state: iteration over object issued, but collection found */
+#define ERR_ITER_COLLECTION_NEEDED 69  /** Illegal state: iteration over collection issued, but object found */
+#define ERR_TYPEMISMATCH 70            /** Type mismatch detected */
+#define ERR_INDEXCORRUPTED_OFFSET 71   /** Index is corrupted: requested offset is outside file bounds */
+#define ERR_TMP_FOPENWRITE 72          /** Temporary file cannot be opened for writing */
+#define ERR_FWRITE_FAILED 73           /** Unable to write to file */
+#define ERR_HASTABLE_DESERIALERR 74    /** Unable to deserialize hash table from file */
+#define ERR_UNKNOWN_DIC_TYPE 75        /** Unknown string dictionary implementation requested */
+#define ERR_STACK_OVERFLOW 76          /** Stack overflow */
+#define ERR_STACK_UNDERFLOW 77         /** Stack underflow */
+#define ERR_OUTDATED 78                /** Object was modified but is out of date */
+#define ERR_NOTREADABLE 79             /** Object is currently being updated; no read allowed */
+#define ERR_ILLEGALOP 80               /** Illegal operation */
+#define ERR_BADTYPE 81                 /** Unsupported type */
+#define ERR_UNSUPPCONTAINER 82         /** Unsupported container for data type */
+#define ERR_INSERT_TOO_DANGEROUS 83    /** Adding integers with this function will perform an auto casting to
+                                             * the smallest type required to store the integer value. Since you push
+                                             * integers with this function into an column container that is bound
+                                             * to a specific type, any insertion function call will fail once the
+                                             * integer value requires a larger (or smaller) type than the fist value
+                                             * added to the container. Use '*_insert_X' instead, where X is u8, u16,...
+                                             * , u32 resp. i8, i16,..., i32. */
+#define ERR_PARSE_DOT_EXPECTED 84       /** parsing ERROR: dot ('.') expected */
+#define ERR_PARSE_ENTRY_EXPECTED 85     /** parsing ERROR: key name or array index expected */
+#define ERR_PARSE_UNKNOWN_TOKEN 86      /** parsing ERROR: unknown token */
+#define ERR_DOT_PATH_PARSERR 87         /** dot-notated path could not be parsed */
+#define ERR_ILLEGALSTATE 88             /** Illegal state */
+#define ERR_UNSUPPORTEDTYPE 89          /** Unsupported data type */
+#define ERR_FAILED 90                   /** Operation failed */
+#define ERR_CLEANUP 91                  /** Cleanup operation failed; potentially a memory leak occurred */
+#define ERR_DOT_PATH_COMPILEERR 92      /** dot-notated path could not be compiled */
+#define ERR_NONUMBER 93                 /** not a number */
+#define ERR_BUFFERTOOTINY 94            /** buffer capacity exceeded */
+#define ERR_TAILINGJUNK 95              /** tailing junk was detected in a stream */
+#define ERR_NOTINDEXED 96               /** not indexed */
+#define ERR_NOERR_RESULT_BOOLEAN 97     /** No ERROR, and result is boolean */
+#define ERR_NOERR_RESULT_INT 98         /** No ERROR, and result is 63bit int */
+#define ERR_NOERR_RESULT_UINT 99        /** No ERROR, and result is 63bit unsigned int */
+#define ERR_NOERR_RESULT_PTR 100        /** No ERROR, and result is 63bit pointer */
+#define ERR_PERMISSIONS 101             /** Permissions ERROR */
+
+static const char *const global_err_str[] =
+        {"No ERROR", "Null pointer detected", "Function not implemented", "Index is out of bounds",
+         "Memory allocation failed", "Illegal arguments", "Internal ERROR", "Illegal implementation", "Not found",
+         "Element not in list", "Array index out of bounds", "Illegal JSON array: mixed types",
+         "Reading from file failed", "I/O ERROR", "Unsupported archive format version", "Format is corrupted",
+         "Stream is not a types archive", "Not in bit writing mode", "Function is not yet implemented",
+         "Unsupported type found", "Unsupported pack strategy requested", "No str_buf representation for type available",
+         "Marker type cannot be mapped to value type", "Parsing stopped; unknown data type requested",
+         "Unknown token during parsing JSON detected", "Unknown value type for number in JSON property",
+         "Stream is not a valid archive file", "Unsupported strategy requested for key lookup", "Internal ERROR",
+         "No huffman code table entry found for character",
+         "Memory file was opened as read-only but requested a modification",
+         "Unable to import json file: unsupported type", "Mode set to read-only but modification was requested",
+         "Read outside of memory range bounds", "Slot management broken",
+         "Thread run out of object ids: start another one", "JSON parsing ERROR",
+         "Document insertion bulk creation failed", "File cannot be opened for writing",
+         "Archive cannot be serialized into file", "Archive cannot be deserialized form file",
+         "Unable to read from file", "Unable to perform full scan in archive file",
+         "String decompression from archive failed", "Closing iterator failed",
+         "Unable to construct a hard copy of the source object", "Memory reallocation failed",
+         "Predicate evaluation failed", "Initialization failed",
+         "Resource release failed: potentially a memory leak occurred", "Operation failed",
+         "Rehashing hash table failed; rollback is not performed", "Unable to open memory file",
+         "Value iterator cannot be initialized", "Memfile cannot skip desired amount of bytes",
+         "Unable to seek in memory file", "Unable to get value: type is not non-array object",
+         "Unable to get value: type is not non-array boolean", "Unable to get value: type is not non-array int8",
+         "Unable to get value: type is not non-array int16", "Unable to get value: type is not non-array int32",
+         "Unable to get value: type is not non-array int64", "Unable to get value: type is not non-array uint8",
+         "Unable to get value: type is not non-array uint16", "Unable to get value: type is not non-array uint32",
+         "Unable to get value: type is not non-array uint64", "Unable to get value: type is not non-array number",
+         "Unable to get value: type is not non-array str_buf",
+         "Illegal state: iteration over object issued, but collection found",
+         "Illegal state: iteration over collection issued, but object found", "Type mismatch detected",
+         "Index is corrupted: requested offset is outside file bounds", "Temporary file cannot be opened for writing",
+         "Unable to write to file", "Unable to deserialize hash table from file",
+         "Unknown str_buf dictionary implementation requested", "Stack overflow", "Stack underflow",
+         "Object was modified but is out of date", "Object is currently being updated; no read allowed",
+         "Illegal operation", "Unsupported type", "Unsupported container for data type",
+         "Adding integers with this function will perform an auto casting to the smallest type required to store "
+         "the integer value. Since you push integers with this function into an column container that is bound "
+         "to a specific type, any insertion function call will fail once the integer value requires a larger "
+         "(or smaller) type than the fist value added to the container. Use '*_insert_X' instead, where X is "
+         "u8, u16,..., u32 resp. i8, i16,..., i32. ", "parsing ERROR dot ('.') expected",
+         "parsing ERROR key name or array index expected", "parsing ERROR: unknown token",
+         "dot-notated path could not be parsed", "Illegal state", "Unsupported data type", "Operation failed",
+         "Cleanup operation failed; potentially a memory leak occurred", "dot-notated path could not be compiled",
+         "not a number", "buffer capacity exceeded", "tailing junk was detected in a stream", "not indexed",
+         "result is boolean", "result is 63bit int", "result is 63bit unsigned int", "result is 63bit pointer",
+         "Permissions ERROR"
+        };
+
+#define ERRSTR_ILLEGAL_CODE "illegal ERROR code"
+
+static const int global_nerr_str = ARRAY_LENGTH(global_err_str);
+
+extern _Thread_local struct err_info {
+        int code;
+        const char *file;
+        u32 line;
+        char *details;
+        bool noabort;
+} g_err;
+
+#ifndef NDEBUG
+#define ERROR(code, msg)                        \
+({                                              \
+    error_set(code, __FILE__, __LINE__, msg);   \
+    error_print(stderr);                        \
+    if (!g_err.noabort) { abort(); }            \
+    false;                                      \
+})
+#else
+#define ERROR(code, msg)                        \
+({                                              \
+    error_set(code, __FILE__, __LINE__, msg);   \
+    error_print(stderr);                        \
+    false;                                      \
+})
+#endif
+
+
+#define ERROR_IF_AND_RETURN(expr, code, msg) { if ((expr)) { ERROR(code, msg); return false; }}
+#define PANIC(code) { ERROR(code, "PANIC condition"); abort(); }
+
+void error_abort_enable();
+void error_abort_disable();
+
+void error_set(int code, const char *file, u32 line, const char *details);
+void error_clear();
+const char *error_get_str();
+int error_get_code();
+const char *error_get_file(u32 *line);
+const char *error_get_details();
+void error_print(FILE *file);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef FORWDECL_H
+#define FORWDECL_H
+
+typedef struct allocator allocator;
+
+typedef struct archive archive;
+typedef struct archive_callback archive_callback;
+typedef struct sid_cache_stats sid_cache_stats;
+typedef struct archive_header archive_header;
+typedef struct record_header record_header;
+typedef struct object_header object_header;
+typedef struct prop_header prop_header;
+typedef union string_tab_flags string_tab_flags_u;
+typedef struct string_table_header string_table_header;
+typedef struct object_array_header object_array_header;
+typedef struct column_group_header column_group_header;
+typedef struct column_header column_header;
+typedef union object_flags object_flags_u;
+typedef struct archive_prop_offs archive_prop_offs;
+typedef struct fixed_prop fixed_prop;
+typedef struct table_prop table_prop;
+typedef struct var_prop var_prop;
+typedef struct array_prop array_prop;
+typedef struct null_prop null_prop;
+typedef struct record_flags record_flags;
+typedef struct string_table string_table;
+typedef struct record_table record_table;
+typedef struct archive_info archive_info;
+typedef struct string_entry_header string_entry_header;
+typedef struct archive_io_context archive_io_context;
+typedef struct archive_object archive_object;
+typedef struct collection_iter_state collection_iter_state;
+typedef struct archive_value_vector archive_value_vector;
+typedef struct prop_iter prop_iter;
+typedef struct independent_iter_state independent_iter_state;
+typedef struct column_object_iter column_object_iter;
+typedef struct string_pred string_pred;
+typedef struct query query;
+typedef struct strid_info strid_info;
+typedef struct strid_iter strid_iter;
+typedef struct path_entry path_entry;
+typedef struct archive_visitor_desc archive_visitor_desc;
+typedef struct visitor visitor;
+typedef struct column_doc_column column_doc_column;
+typedef struct column_doc_group column_doc_group;
+typedef struct column_doc_obj column_doc_obj;
+typedef struct column_doc column_doc;
+typedef struct doc_entries doc_entries;
+typedef struct doc_bulk doc_bulk;
+typedef struct doc doc;
+typedef struct doc_obj doc_obj;
+typedef union encoded_doc_value encoded_doc_value_u;
+typedef struct encoded_doc_prop_header encoded_doc_prop_header;
+typedef struct encoded_doc_prop encoded_doc_prop;
+typedef struct encoded_doc_prop_array encoded_doc_prop_array;
+typedef struct encoded_doc encoded_doc;
+typedef struct encoded_doc_list encoded_doc_list;
+typedef struct memfile memfile;
+
+typedef struct async_func_proxy async_func_proxy;
+typedef struct filter_arg filter_arg;
+typedef struct map_args map_args;
+typedef struct gather_scatter_args gather_scatter_args;
+
+typedef struct bitmap bitmap;
+
+typedef struct rec rec;
+typedef struct insert insert;
+typedef struct rec_new rec_new;
+typedef struct field field;
+
+typedef struct arr_it arr_it;
+typedef struct item item;
+typedef struct string_field string_field;
+struct traverse_extra;
+
+typedef struct col_it col_it;
+typedef struct dot_node dot_node;
+typedef struct dot dot;
+typedef struct find find;
+typedef struct arr_state arr_state;
+typedef struct obj_state obj_state;
+typedef struct col_state col_state;
+typedef struct obj_it obj_it;
+typedef struct prop prop;
+typedef struct dot_eval dot_eval;
+typedef struct pindex pindex;
+typedef struct pindex_it pindex_it;
+typedef struct printer printer;
+typedef struct rev rev;
+typedef struct binary_field binary_field;
+typedef struct update update;
+typedef struct packer packer;
+
+typedef struct hashset_bucket hashset_bucket;
+typedef struct hashset hashset;
+typedef struct hashtable_bucket hashtable_bucket;
+typedef struct hashtable hashtable;
+typedef struct huffman huffman;
+typedef struct pack_huffman_entry pack_huffman_entry;
+typedef struct pack_huffman_info pack_huffman_info;
+typedef struct pack_huffman_str_info pack_huffman_str_info;
+
+typedef struct json json;
+typedef struct json_token json_token;
+typedef struct json_err json_err;
+typedef struct json_tokenizer json_tokenizer;
+typedef struct json_parser json_parser;
+typedef struct json json;
+typedef struct json_node_value json_node_value;
+typedef struct json_object json_object;
+typedef struct json_element json_element;
+typedef struct json_string json_string;
+typedef struct json_prop json_prop;
+typedef struct json_members json_members;
+typedef struct json_elements json_elements;
+typedef struct json_array json_array;
+typedef struct json_number json_number;
+
+typedef struct memblock memblock;
+typedef struct memfile memfile;
+
+typedef struct command_opt command_opt;
+typedef struct command_opt_group command_opt_group;
+typedef struct command_opt_mgr command_opt_mgr;
+
+typedef struct priority_queue_element_info priority_queue_element_info;
+typedef struct priority_queue priority_queue;
+
+typedef struct slice slice;
+typedef struct hash_bounds hash_bounds;
+typedef struct slice_descriptor slice_descriptor;
+typedef struct slice_list slice_list;
+typedef struct slice_handle slice_handle;
+
+typedef struct spinlock spinlock;
+
+typedef struct vec vec;
+
+typedef struct str_hash str_hash;
+typedef struct str_hash_counters str_hash_counters;
+
+typedef struct str_buf str_buf;
+
+typedef struct string_dict string_dict;
+
+typedef struct thread_task thread_task;
+typedef struct task_state task_state;
+typedef struct task_handle task_handle;
+typedef struct thread_pool thread_pool;
+typedef struct thread_info thread_info;
+typedef struct thread_pool_stats thread_pool_stats;
+typedef struct thread_stats thread_stats;
+typedef struct task_stats task_stats;
+
+#endif
+/*
+ * Copyright 2018 Marcus Pinnecke
+ */
+
+#ifndef HAD_HEXDUMP_H
+#define HAD_HEXDUMP_H
+
+#include <karbonit/stdinc.h>
+#include <karbonit/std/string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool hexdump(str_buf *dst, const void *base, u64 nbytes);
+bool hexdump_print(FILE *file, const void *base, u64 nbytes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/*
+ * json - Java Script Object Notation sub module
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_JSON_H
+#define HAD_JSON_H
+
+#include <karbonit/stdinc.h>
+#include <karbonit/types.h>
+#include <karbonit/forwdecl.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+const char *json_from_record(str_buf *dst, rec *src);
+const char *json_from_array(str_buf *dst, arr_it *src);
+const char *json_from_column(str_buf *dst, col_it *src);
+const char *json_from_object(str_buf *dst, obj_it *src);
+const char *json_from_item(str_buf *dst, item *src);
+
+/**
+ * Writes the record <code>src</code> as JSON to the file descriptor <code>fd</code>, in the same format as
+ * <code>json_from_record</code>, but in chunks of a fixed-size buffer instead of as a whole string
+ */
+bool json_write_record(int fd, rec *src);
+
+const char *json_from_binary(str_buf *dst, const binary_field *binary);
+const char *json_from_string(str_buf *dst, const string_field *str);
+const char *json_from_boolean(str_buf *dst, bool value);
+const char *json_from_unsigned(str_buf *dst, u64 value);
+const char *json_from_signed(str_buf *dst, i64 value);
+const char *json_from_float(str_buf *dst, float value);
+const char *json_from_null(str_buf *dst);
+const char *json_from_undef(str_buf *dst);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/*
+ * Copyright 2018 Marcus Pinnecke
+ */
+
+#ifndef HAD_JSON_PARSER_H
+#define HAD_JSON_PARSER_H
+
+#include <karbonit/stdinc.h>
+#include <karbonit/std/vec.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum json_token_type {
+        OBJECT_OPEN,
+        OBJECT_CLOSE,
+        LITERAL_STRING,
+        LITERAL_INT,
+        LITERAL_FLOAT,
+        LITERAL_TRUE,
+        LITERAL_FALSE,
+        LITERAL_NULL,
+        COMMA,
+        ASSIGN,
+        ARRAY_OPEN,
+        ARRAY_CLOSE,
+        JSON_UNKNOWN
+} json_token_e;
+
+typedef struct json_token {
+        json_token_e type;
+        const char *string;
+        unsigned line;
+        unsigned column;
+        unsigned length;
+} json_token;
+
+typedef struct json_err {
+        const json_token *token;
+        const char *token_type_str;
+        const char *msg;
+} json_err;
+
+/* number of input characters that the tokenizer indexes at once */
+#define JSON_TOKENIZER_BLOCK_SIZE       64
+
+/**
+ * Tokenizes in two stages: the first stage indexes the input block-wise, marking the characters at which strings and
+ * runs of blanks may end (with AVX2 if the processor supports it); the second stage emits tokens, and jumps over
+ * strings and blanks by that index instead of inspecting each character on its own.
+ */
+typedef struct json_tokenizer {
+        const char *cursor;
+        json_token token;
+        /* input, and its terminating nul character */
+        const char *begin;
+        const char *end;
+        /* indexed input block; bit i of the masks stands for block[i], or for a nul character beyond the input */
+        const char *block;
+        /* '"', '\n', '\r', and nul characters */
+        u64 string_ends;
+        /* all characters except ' ', '\t', '\v', '\f', and '\r' */
+        u64 non_blanks;
+} json_tokenizer;
+
+typedef struct json_parser {
+        json_tokenizer tokenizer;
+} json_parser;
+
+typedef enum json_parent {
+        JSON_PARENT_OBJECT, JSON_PARENT_MEMBER, JSON_PARENT_ELEMENTS
+} json_parent_e;
+
+typedef enum json_value_type_e {
+        JSON_VALUE_OBJECT,
+        JSON_VALUE_ARRAY,
+        JSON_VALUE_STRING,
+        JSON_VALUE_NUMBER,
+        JSON_VALUE_TRUE,
+        JSON_VALUE_FALSE,
+        JSON_VALUE_NULL
+} json_value_type_e;
+
+typedef enum json_list_type_e {
+        JSON_LIST_EMPTY,
+        JSON_LIST_VARIABLE_OR_NESTED,
+        JSON_LIST_FIXED_U8,
+        JSON_LIST_FIXED_U16,
+        JSON_LIST_FIXED_U32,
+        JSON_LIST_FIXED_U64,
+        JSON_LIST_FIXED_I8,
+        JSON_LIST_FIXED_I16,
+        JSON_LIST_FIXED_I32,
+        JSON_LIST_FIXED_I64,
+        JSON_LIST_FIXED_FLOAT,
+        JSON_LIST_FIXED_NULL,
+        JSON_LIST_FIXED_BOOLEAN
+} json_list_type_e;
+
+typedef struct json {
+        json_element *element;
+        /* allocator of all nodes, or NULL for the standard C library allocator */
+        allocator *alloc;
+} json;
+
+typedef struct json_node_value {
+        json_element *parent;
+        json_value_type_e value_type;
+        union {
+                json_object *object;
+                json_array *array;
+                json_string *string;
+                json_number *number;
+                void *ptr;
+        } value;
+} json_node_value;
+
+typedef struct json_object {
+        json_node_value *parent;
+        json_members *value;
+} json_object;
+
+typedef struct json_element {
+        json_parent_e parent_type;
+        union {
+                json *json;
+                json_prop *member;
+                json_elements *elements;
+                void *ptr;
+        } parent;
+        json_node_value value;
+} json_element;
+
+typedef struct json_string {
+        json_prop *parent;
+        char *value;
+} json_string;
+
+typedef struct json_prop {
+        json_members *parent;
+        json_string key;
+        json_element value;
+} json_prop;
+
+typedef struct json_members {
+        json_object *parent;
+        vec ofType(json_prop) members;
+} json_members;
+
+typedef struct json_elements {
+        json_array *parent;
+        vec ofType(json_element) elements;
+} json_elements;
+
+typedef struct json_array {
+        json_node_value *parent;
+        json_elements elements;
+} json_array;
+
+typedef enum json_number_type {
+        JSON_NUMBER_FLOAT, JSON_NUMBER_UNSIGNED, JSON_NUMBER_SIGNED
+} json_number_type_e;
+
+typedef struct json_number {
+        json_node_value *parent;
+        json_number_type_e value_type;
+        union {
+                float float_number;
+                i64 signed_integer;
+                u64 unsigned_integer;
+        } value;
+} json_number;
+
+bool json_tokenizer_init(json_tokenizer *tokenizer, const char *input);
+const json_token *json_tokenizer_next(json_tokenizer *tokenizer);
+void json_token_dup(json_token *dst, const json_token *src);
+void json_token_print(FILE *file, const json_token *token);
+bool json_parse(json *json, json_err *error_desc, json_parser *parser, const char *input);
+/* Same as json_parse, but allocates the AST via <code>alloc</code> (e.g., an arena that is dropped as a whole after
+ * the conversion of the AST). The allocator must outlive the AST. */
+bool json_parse_with(json *json, json_err *error_desc, json_parser *parser, const char *input, allocator *alloc);
+bool json_test(json *json);
+bool json_drop(json *json);
+bool json_print(FILE *file, json *json);
+bool json_list_is_empty(const json_elements *elements);
+bool json_list_length(u32 *len, const json_elements *elements);
+json_list_type_e json_fitting_type(json_list_type_e current, json_list_type_e to_add);
+/* Reads the number in <code>token</code>, a <code>LITERAL_INT</code> or <code>LITERAL_FLOAT</code> token */
+void json_number_from_token(json_number *number, const json_token *token);
+/* Returns the smallest list type that holds <code>number</code> (see <code>json_fitting_type</code>) */
+json_list_type_e json_number_list_type(const json_number *number);
+bool json_array_get_type(json_list_type_e *type, const json_array *array);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ALLOC_H
+#define ALLOC_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Allocator that can be passed to data structures (e.g., vec, str_buf, memblock, and the JSON parser) to route
+ * their memory requests. Structures take a pointer to an allocator which must outlive them; a <code>NULL</code>
+ * allocator stands for the standard C library allocator (and is what all structures use by default).
+ *
+ * Memory returned by <code>malloc</code> is zeroed (see MALLOC), memory returned by <code>realloc</code> beyond the
+ * size of the original request is not.
+ */
+typedef struct allocator {
+        /**
+         * Implementation-specific values
+         */
+        void *extra;
+
+        void *(*malloc)(allocator *self, size_t size);
+        void *(*realloc)(allocator *self, void *ptr, size_t size);
+        void (*free)(allocator *self, void *ptr);
+
+        /**
+         * Frees all resources bound to <code>self</code>, including memory which was not freed via <code>free</code>
+         */
+        void (*drop)(allocator *self);
+} allocator;
+
+/**
+ * Standard C library allocator (i.e., <code>malloc</code>, <code>realloc</code>, and <code>free</code>)
+ */
+bool alloc_create_std(allocator *alloc);
+
+/**
+ * Region-based (bump pointer) allocator that requests memory from the system in chunks of <code>chunk_size</code>
+ * bytes. Allocating is incrementing a pointer, and freeing single allocations is a no-op. The entire memory is
+ * released at once with <code>alloc_drop</code> (or recycled with <code>alloc_arena_reset</code>). Use an arena for
+ * short-lived structures that are built and dropped as a whole, e.g., the JSON AST during a conversion.
+ */
+bool alloc_create_arena(allocator *alloc, size_t chunk_size);
+
+/**
+ * Forgets all allocations made by the arena allocator <code>alloc</code> and keeps (the first chunk of) its memory
+ * for reuse.
+ */
+bool alloc_arena_reset(allocator *alloc);
+
+/**
+ * Returns the number of bytes in use by the arena allocator <code>alloc</code>
+ */
+size_t alloc_arena_used(const allocator *alloc);
+
+/**
+ * Pooled allocator for objects of (at most) <code>obj_size</code> bytes. Objects are carved from slabs of
+ * <code>slab_objs</code> objects, and freed objects are recycled via a free list. Requests of more than
+ * <code>obj_size</code> bytes are served by the standard C library allocator.
+ */
+bool alloc_create_pool(allocator *alloc, size_t obj_size, size_t slab_objs);
+
+/**
+ * Returns the arena allocator of the calling thread. The arena is created on the first call, and released when the
+ * thread terminates. Since all code running in the thread shares this arena, the owner of a pipeline that uses it is
+ * responsible to call <code>alloc_arena_reset</code> once the structures built are not used anymore.
+ */
+allocator *alloc_thread_arena(void);
+
+bool alloc_drop(allocator *alloc);
+
+static inline void *alloc_malloc(allocator *alloc, size_t size)
+{
+        return alloc ? alloc->malloc(alloc, size) : MALLOC(size);
+}
+
+static inline void *alloc_realloc(allocator *alloc, void *ptr, size_t size)
+{
+        return alloc ? alloc->realloc(alloc, ptr, size) : realloc(ptr, size);
+}
+
+static inline void alloc_free(allocator *alloc, void *ptr)
+{
+        if (alloc) {
+                alloc->free(alloc, ptr);
+        } else {
+                free(ptr);
+        }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * memblock - memory block as abstraction of resizable continuous memory area
+ *
+ * Copyright 2018 Marcus Pinnecke
+ */
+
+#ifndef HAD_MEMBLOCK_H
+#define HAD_MEMBLOCK_H
+
+#include <sys/mman.h>
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/mem/alloc.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Policy that is applied to the reserved memory of a memory block in case the block must be enlarged. The exact policy
+ * reallocates to the (logical) size requested which is cheap in terms of memory but makes sequences of small
+ * enlargements (e.g., many inserts into a record) quadratic. The geometric policy (default) reserves memory ahead by
+ * a constant factor such that a sequence of enlargements has amortized constant costs. Independent of the policy, the
+ * (logical) size of a block, see MEMBLOCK_SIZE, is always the size requested. */
+typedef enum memblock_growth {
+        MEMBLOCK_GROWTH_EXACT,
+        MEMBLOCK_GROWTH_GEOMETRIC
+} memblock_growth_e;
+
+#define MEMBLOCK_GROWTH_FACTOR 1.7f
+
+struct memblock_cow;
+struct memblock_digest;
+
+typedef struct memblock {
+    offset_t blockLength;
+    offset_t last_byte;
+    offset_t capacity;
+    memblock_growth_e growth;
+    void *base;
+    /* non-null if the block is a read-only view on a memory-mapped file, see MEMBLOCK_FROM_FILE_MAPPED */
+    void *mapped_base;
+    size_t mapped_len;
+    /* movable gap inside the reserved memory (gap editing mode only), see MEMBLOCK_SET_GAP_MODE */
+    bool gap_mode;
+    offset_t gap_off;
+    offset_t gap_len;
+    /* non-null if the blocks memory is shared copy-on-write with other blocks, see MEMBLOCK_CPY_SHARED */
+    struct memblock_cow *cow;
+    u8 *cow_dirty;
+    u32 cow_ndirty;
+    /* allocator for the blocks memory, or NULL for the standard C library allocator, see MEMBLOCK_CREATE_WITH */
+    allocator *alloc;
+    /* non-null if chunk hashes of the block are cached, see memblock_digest_compute */
+    struct memblock_digest *digest;
+} memblock;
+
+#define MEMBLOCK_IS_MAPPED(block)                                                                                      \
+        ((block)->mapped_base != NULL)
+
+#define MEMBLOCK_IS_SHARED(block)                                                                                      \
+        ((block)->cow != NULL)
+
+#define MEMBLOCK_SET_GROWTH(block, policy)                                                                             \
+{                                                                                                                      \
+        (block)->growth = (policy);                                                                                    \
+}
+
+#define MEMBLOCK_CAPACITY(block)                                                                                       \
+        ((block) ? (block)->capacity : 0)
+
+/* Reserves memory for at least <code>nbytes</code> bytes in the block without changing the blocks (logical) size.
+ * Use this to avoid reallocations if the (upper bound of the) final size is known in advance. */
+#define MEMBLOCK_RESERVE(block, nbytes)                                                                                \
+({                                                                                                                     \
+        bool memblock_reserve_status = true;                                                                           \
+        if (UNLIKELY(MEMBLOCK_IS_MAPPED((block)))) {                                                                   \
+                memblock_reserve_status = ERROR(ERR_WRITEPROT, "memory-mapped block cannot be resized");               \
+        } else if ((offset_t) (nbytes) > (block)->capacity && MEMBLOCK_IS_SHARED((block))) {                           \
+                memblock_reserve_status = memblock_cow_detach((block), (nbytes));                                      \
+        } else if ((offset_t) (nbytes) > (block)->capacity) {                                                          \
+                void *memblock_reserve_base = alloc_realloc((block)->alloc, (block)->base, (nbytes));                                        \
+                if (UNLIKELY(!memblock_reserve_base)) {                                                                \
+                        memblock_reserve_status = ERROR(ERR_REALLOCERR, NULL);                                         \
+                } else {                                                                                               \
+                        (block)->base = memblock_reserve_base;                                                         \
+                        (block)->capacity = (nbytes);                                                                  \
+                }                                                                                                      \
+        }                                                                                                              \
+        memblock_reserve_status;                                                                                       \
+})
+
+/* Ensures that at least <code>nbytes</code> are reserved according to the blocks growth policy */
+#define MEMBLOCK_GROW_CAPACITY(block, nbytes)                                                                          \
+({                                                                                                                     \
+        offset_t memblock_grow_required = (nbytes);                                                                    \
+        bool memblock_grow_status = true;                                                                              \
+        if (memblock_grow_required > (block)->capacity) {                                                              \
+                if ((block)->growth == MEMBLOCK_GROWTH_GEOMETRIC) {                                                    \
+                        offset_t memblock_grow_geometric = (block)->capacity * MEMBLOCK_GROWTH_FACTOR;                 \
+                        memblock_grow_required = JAK_MAX(memblock_grow_required, memblock_grow_geometric);             \
+                }                                                                                                      \
+                memblock_grow_status = MEMBLOCK_RESERVE((block), memblock_grow_required);                              \
+        }                                                                                                              \
+        memblock_grow_status;                                                                                          \
+})
+
+/* Copy-on-write sharing: a block that is copied via MEMBLOCK_CPY_SHARED is copied into a shared memory object which
+ * is mapped by the copy (the owner), and privately by each further copy of the owner or of its copies. Such a further
+ * copy costs a mapping only, and reads of a copy are served by the pages of the shared object. Pages that a copy
+ * modifies are copied by the operating system on the first write; the copy tracks these modified chunks such that a
+ * copy of a copy (e.g., a revision of a revision) only re-applies these chunks. The owner detaches from the shared
+ * object (i.e., it becomes a plain heap block) on its first modification as long as copies exist. The shared object
+ * (and its file descriptor) is kept as long as any block maps it, such that a chain of copies, each made from the
+ * previous one which is dropped afterwards, keeps sharing the same object. Blocks that are smaller than
+ * MEMBLOCK_COW_MIN_SIZE, and memory-mapped blocks, are deep copied instead.
+ *
+ * Copying never modifies the source block, which thus may be read concurrently. Any operation that writes to the
+ * block must announce the physical range written via MEMBLOCK_TOUCH beforehand; the blocks memory may move by doing
+ * so. If MEMBLOCK_TOUCH fails (i.e., an owner cannot detach from the copies that map it), the write must not happen,
+ * and the operation fails. */
+#define MEMBLOCK_COW_CHUNK              4096
+#define MEMBLOCK_COW_MIN_SIZE           (64 * 1024)
+
+/* a copy of a copy re-shares its contents once more than 1/MEMBLOCK_COW_REBASE_RATIO of its chunks are modified */
+#define MEMBLOCK_COW_REBASE_RATIO       4
+
+bool memblock_cow_clone(memblock **dst, memblock *src);
+bool memblock_cow_touch(memblock *block, offset_t off, offset_t nbytes);
+bool memblock_cow_detach(memblock *block, offset_t capacity);
+void memblock_cow_drop(memblock *block);
+
+/* Chunk digest: memblock_digest_compute hashes the blocks contents as hash64_chunked does, and caches the hash of each
+ * chunk in the block. Chunks that are modified afterwards are tracked via MEMBLOCK_TOUCH, and the next digest rehashes
+ * only these chunks. The cache is copied along with the block (see MEMBLOCK_CPY and MEMBLOCK_CPY_SHARED) such that a
+ * revision of a record rehashes only the chunks modified by the revision. */
+bool memblock_digest_compute(u64 *hash, memblock *block);
+void memblock_digest_touch(memblock *block, offset_t off, offset_t nbytes);
+void memblock_digest_cpy(memblock *dst, const memblock *src);
+void memblock_digest_drop(memblock *block);
+
+#define MEMBLOCK_TOUCH(block, off, nbytes)                                                                             \
+({                                                                                                                     \
+        bool memblock_touch_status = true;                                                                             \
+        if (UNLIKELY((block)->digest != NULL)) {                                                                       \
+                memblock_digest_touch((block), (off), (nbytes));                                                       \
+        }                                                                                                              \
+        if (UNLIKELY(MEMBLOCK_IS_SHARED((block)))) {                                                                   \
+                memblock_touch_status = memblock_cow_touch((block), (off), (nbytes));                                  \
+        }                                                                                                              \
+        memblock_touch_status;                                                                                         \
+})
+
+/* Gap editing mode: in this mode, a block keeps a movable gap of unused bytes at the position of the most recent
+ * structural change (see MEMBLOCK_MOVE_RIGHT and MEMBLOCK_MOVE_LEFT). Inserting at or removing from the gap does not
+ * move the remainder of the block but only resizes the gap, and moving the gap costs the distance moved. A sequence
+ * of localized edits therefore costs the size of edits rather than the size of the block for each single edit.
+ *
+ * Positions used with the block (and memfiles on top of it) are logical positions, i.e., the gap is invisible. Reads
+ * located after the gap are translated; reads that would touch the gap move the gap out of the way first. Any access
+ * to the raw data of the block (e.g., MEMBLOCK_RAW_DATA) materializes the block into its contiguous layout. Pointers
+ * obtained from a block in gap mode are valid until the next operation on that block. */
+#define MEMBLOCK_GAP_MIN        64
+
+/* number of bytes behind a peek position that are guaranteed to be located before the gap (e.g., to decode a variable
+ * length integer given only a pointer to its first byte) */
+#define MEMBLOCK_GAP_GUARD      16
+
+#define MEMBLOCK_HAS_GAP(block)                                                                                        \
+        ((block)->gap_len != 0)
+
+#define MEMBLOCK_PHYSICAL_POS(block, pos)                                                                              \
+        ((offset_t) (pos) + (MEMBLOCK_HAS_GAP((block)) && (offset_t) (pos) >= (block)->gap_off ? (block)->gap_len : 0))
+
+#define MEMBLOCK_MOVE_GAP(block, to)                                                                                   \
+({                                                                                                                     \
+        bool memblock_gap_status = true;                                                                               \
+        offset_t memblock_gap_to = (to);                                                                               \
+        if (memblock_gap_to < (block)->gap_off) {                                                                      \
+                memblock_gap_status = MEMBLOCK_TOUCH((block), memblock_gap_to,                                         \
+                                                     (block)->gap_off + (block)->gap_len - memblock_gap_to);           \
+        } else if (memblock_gap_to > (block)->gap_off) {                                                               \
+                memblock_gap_status = MEMBLOCK_TOUCH((block), (block)->gap_off,                                        \
+                                                     memblock_gap_to - (block)->gap_off + (block)->gap_len);           \
+        }                                                                                                              \
+        if (LIKELY(memblock_gap_status)) {                                                                             \
+                char *memblock_gap_base = (char *) (block)->base;                                                      \
+                if (memblock_gap_to < (block)->gap_off) {                                                              \
+                        memmove(memblock_gap_base + memblock_gap_to + (block)->gap_len,                                \
+                                memblock_gap_base + memblock_gap_to, (block)->gap_off - memblock_gap_to);              \
+                } else if (memblock_gap_to > (block)->gap_off) {                                                       \
+                        memmove(memblock_gap_base + (block)->gap_off,                                                  \
+                                memblock_gap_base + (block)->gap_off + (block)->gap_len,                               \
+                                memblock_gap_to - (block)->gap_off);                                                   \
+                }                                                                                                      \
+                (block)->gap_off = memblock_gap_to;                                                                    \
+        }                                                                                                              \
+        memblock_gap_status;                                                                                           \
+})
+
+/* Materializes the contiguous layout of the block; the gap becomes reserved memory at the end of the block. The gap
+ * stays in place if the block cannot be written (see MEMBLOCK_TOUCH). */
+#define MEMBLOCK_CLOSE_GAP(block)                                                                                      \
+{                                                                                                                      \
+        if (UNLIKELY(MEMBLOCK_HAS_GAP((block)))) {                                                                     \
+                if (LIKELY(MEMBLOCK_MOVE_GAP((block), (block)->blockLength))) {                                        \
+                        (block)->gap_off = (block)->gap_len = 0;                                                       \
+                }                                                                                                      \
+        }                                                                                                              \
+}
+
+/* Enlarges the gap to at least <code>nbytes</code> bytes and places it at <code>where</code>. To amortize the costs of
+ * moving the remainder of the block, the gap is enlarged proportional to the blocks size. Returns false if the block
+ * cannot grow or cannot be written, in which case the gap keeps its size. */
+#define MEMBLOCK_WIDEN_GAP(block, where, nbytes)                                                                       \
+({                                                                                                                     \
+        bool memblock_widen_status = true;                                                                             \
+        offset_t memblock_widen_len = JAK_MAX((offset_t) (nbytes),                                                     \
+                                              JAK_MAX((offset_t) MEMBLOCK_GAP_MIN, (block)->blockLength >> 3));        \
+        if (MEMBLOCK_HAS_GAP((block))) {                                                                               \
+                memblock_widen_status = MEMBLOCK_MOVE_GAP((block), (where));                                           \
+        } else {                                                                                                       \
+                (block)->gap_off = (where);                                                                            \
+        }                                                                                                              \
+        if (memblock_widen_status &&                                                                                   \
+            MEMBLOCK_GROW_CAPACITY((block), (block)->blockLength + memblock_widen_len) &&                              \
+            MEMBLOCK_TOUCH((block), (block)->gap_off,                                                                  \
+                           (block)->blockLength + memblock_widen_len - (block)->gap_off)) {                            \
+                memmove((char *) (block)->base + (block)->gap_off + memblock_widen_len,                                \
+                        (char *) (block)->base + (block)->gap_off + (block)->gap_len,                                  \
+                        (block)->blockLength - (block)->gap_off);                                                      \
+                (block)->gap_len = memblock_widen_len;                                                                 \
+        } else {                                                                                                       \
+                memblock_widen_status = false;                                                                         \
+        }                                                                                                              \
+        memblock_widen_status;                                                                                         \
+})
+
+/* Enables or disables the gap editing mode for the block. Disabling materializes the contiguous layout. */
+#define MEMBLOCK_SET_GAP_MODE(block, enabled)                                                                          \
+({                                                                                                                     \
+        bool memblock_gap_mode_status = true;                                                                          \
+        if (UNLIKELY(MEMBLOCK_IS_MAPPED((block)))) {                                                                   \
+                memblock_gap_mode_status = ERROR(ERR_WRITEPROT, "memory-mapped block cannot be edited");               \
+        } else {                                                                                                       \
+                if (!(enabled)) {                                                                                      \
+                        MEMBLOCK_CLOSE_GAP((block));                                                                   \
+                }                                                                                                      \
+                (block)->gap_mode = (enabled);                                                                         \
+        }                                                                                                              \
+        memblock_gap_mode_status;                                                                                      \
+})
+
+/* Returns a pointer to the byte at (logical) position <code>pos</code> such that at least <code>nbytes</code> bytes
+ * (plus a guard of MEMBLOCK_GAP_GUARD bytes) can be accessed without crossing the gap. */
+#define MEMBLOCK_PEEK_AT(block, pos, nbytes)                                                                           \
+({                                                                                                                     \
+        offset_t memblock_peek_pos = (pos);                                                                            \
+        if (UNLIKELY(MEMBLOCK_HAS_GAP((block))) && memblock_peek_pos < (block)->gap_off) {                             \
+                offset_t memblock_peek_end = memblock_peek_pos + (nbytes) + MEMBLOCK_GAP_GUARD;                        \
+                if (memblock_peek_end >= (block)->blockLength) {                                                       \
+                        MEMBLOCK_CLOSE_GAP((block));                                                                   \
+                } else if (memblock_peek_end > (block)->gap_off) {                                                     \
+                        MEMBLOCK_MOVE_GAP((block), memblock_peek_end);                                                 \
+                }                                                                                                      \
+        }                                                                                                              \
+        ((char *) (block)->base) + MEMBLOCK_PHYSICAL_POS((block), memblock_peek_pos);                                  \
+})
+
+/* Same as MEMBLOCK_PEEK_AT but for writing <code>nbytes</code> bytes to the position returned, or NULL if the block
+ * cannot be written (see MEMBLOCK_TOUCH) */
+#define MEMBLOCK_PEEK_MUT_AT(block, pos, nbytes)                                                                       \
+({                                                                                                                     \
+        char *memblock_peek_mut = MEMBLOCK_PEEK_AT((block), (pos), (nbytes));                                          \
+        if (UNLIKELY(MEMBLOCK_IS_SHARED((block)) || (block)->digest)) {                                                \
+                offset_t memblock_peek_mut_off = memblock_peek_mut - (char *) (block)->base;                           \
+                memblock_peek_mut = MEMBLOCK_TOUCH((block), memblock_peek_mut_off, (nbytes)) ?                         \
+                                    (char *) (block)->base + memblock_peek_mut_off : NULL;                             \
+        }                                                                                                              \
+        memblock_peek_mut;                                                                                             \
+})
+
+/* Returns a pointer to the byte at (logical) position <code>pos</code> such that the remainder of the block can be
+ * accessed without crossing the gap. */
+#define MEMBLOCK_RAW_DATA_AT(block, pos)                                                                               \
+({                                                                                                                     \
+        offset_t memblock_raw_pos = (pos);                                                                             \
+        if (UNLIKELY(MEMBLOCK_HAS_GAP((block))) && memblock_raw_pos < (block)->gap_off) {                              \
+                MEMBLOCK_CLOSE_GAP((block));                                                                           \
+        }                                                                                                              \
+        ((char *) (block)->base) + MEMBLOCK_PHYSICAL_POS((block), memblock_raw_pos);                                   \
+})
+
+#define MEMBLOCK_CREATE(block, size)                                                                                   \
+        MEMBLOCK_CREATE_WITH((block), (size), NULL)
+
+/* Same as MEMBLOCK_CREATE but the blocks memory is requested via <code>alloc</code> which must outlive the block */
+#define MEMBLOCK_CREATE_WITH(block, size, alloc_in)                                                                    \
+({												                                                                       \
+        bool memblock_create_status = true;                                                                                            \
+        if (UNLIKELY(size == 0)) {							                                                           \
+            *(block) = NULL;                                                                                           \
+            memblock_create_status = ERROR(ERR_ILLEGALARG, NULL);		                                                               \
+        } else {									                                                                   \
+            struct memblock *result = (struct memblock *) MALLOC(sizeof(struct memblock));	                           \
+            ZERO_MEMORY(result, sizeof(memblock));			                                                           \
+            result->blockLength = size;						                                                           \
+            result->last_byte = 0;							                                                           \
+            result->capacity = size;						                                                           \
+            result->growth = MEMBLOCK_GROWTH_GEOMETRIC;					                                                   \
+            result->alloc = (alloc_in);						                                                           \
+            result->base = alloc_malloc(result->alloc, size);					                                       \
+            *(block) = result;								                                                           \
+        }                                                                                                              \
+        memblock_create_status;									                                                                       \
+})
+
+#define MEMBLOCK_DROP(block)                                                                                           \
+{                                                                                                                      \
+    if (MEMBLOCK_IS_MAPPED((block))) {                                                                                 \
+        munmap((block)->mapped_base, (block)->mapped_len);                                                             \
+    } else if (MEMBLOCK_IS_SHARED((block))) {                                                                          \
+        memblock_cow_drop((block));                                                                                    \
+    } else {                                                                                                           \
+        alloc_free((block)->alloc, (block)->base);                                                                     \
+    }                                                                                                                  \
+    memblock_digest_drop((block));                                                                                     \
+    free((block));                                                                                                     \
+}
+
+#define MEMBLOCK_FROM_FILE(block, file, nbytes)							                                               \
+({																		                                               \
+        MEMBLOCK_CREATE((block), nbytes);								                                               \
+        size_t numRead = fread((*(block))->base, 1, nbytes, file);							                           \
+        ((size_t) numRead == (size_t) nbytes);												                           \
+})
+
+/* Constructs a read-only block of <code>nbytes</code> bytes that is backed by the contents of <code>file</code>
+ * starting at the current file position. The contents are not read but mapped into memory such that pages are only
+ * loaded when touched (and shared in the page cache among processes). <code>advice</code> is passed to
+ * <code>madvise</code> (e.g., <code>MADV_RANDOM</code> or <code>MADV_SEQUENTIAL</code>). A mapped block can be read
+ * with a memfile opened as <code>READ_ONLY</code>; any attempt to resize or modify the block fails. To modify its
+ * contents, copy the block via MEMBLOCK_CPY (which always results in a heap-allocated block). */
+#define MEMBLOCK_FROM_FILE_MAPPED(block, file, nbytes, advice)                                                         \
+({                                                                                                                     \
+        bool memblock_mapped_status = true;                                                                            \
+        long memblock_mapped_off = ftell((file));                                                                      \
+        size_t memblock_mapped_page = (size_t) sysconf(_SC_PAGESIZE);                                                  \
+        if (UNLIKELY(memblock_mapped_off < 0 || (nbytes) == 0)) {                                                      \
+                *(block) = NULL;                                                                                       \
+                memblock_mapped_status = ERROR(ERR_ILLEGALARG, NULL);                                                  \
+        } else {                                                                                                       \
+                size_t memblock_mapped_delta = (size_t) memblock_mapped_off % memblock_mapped_page;                    \
+                size_t memblock_mapped_len = memblock_mapped_delta + (nbytes);                                         \
+                void *memblock_mapped = mmap(NULL, memblock_mapped_len, PROT_READ, MAP_PRIVATE, fileno((file)),        \
+                                             memblock_mapped_off - memblock_mapped_delta);                             \
+                if (UNLIKELY(memblock_mapped == MAP_FAILED)) {                                                         \
+                        *(block) = NULL;                                                                               \
+                        memblock_mapped_status = ERROR(ERR_IO, "unable to map file into memory");                      \
+                } else {                                                                                               \
+                        madvise(memblock_mapped, memblock_mapped_len, (advice));                                       \
+                        struct memblock *result = (struct memblock *) MALLOC(sizeof(struct memblock));                 \
+                        result->blockLength = (nbytes);                                                                \
+                        result->last_byte = (nbytes);                                                                  \
+                        result->capacity = (nbytes);                                                                   \
+                        result->growth = MEMBLOCK_GROWTH_GEOMETRIC;                                                    \
+                        result->base = (char *) memblock_mapped + memblock_mapped_delta;                               \
+                        result->mapped_base = memblock_mapped;                                                         \
+                        result->mapped_len = memblock_mapped_len;                                                      \
+                        *(block) = result;                                                                             \
+                        fseek((file), (nbytes), SEEK_CUR);                                                             \
+                }                                                                                                      \
+        }                                                                                                              \
+        memblock_mapped_status;                                                                                        \
+})
+
+#define MEMBLOCK_FROM_RAW_DATA(block, data, nbytes)													                   \
+{																									                   \
+        struct memblock *result = (struct memblock *) MALLOC(sizeof(struct memblock));				                   \
+        result->blockLength = nbytes;																                   \
+        result->last_byte = nbytes;																	                   \
+        result->capacity = nbytes;																	                   \
+        result->growth = MEMBLOCK_GROWTH_GEOMETRIC;															                   \
+        result->base = MALLOC(nbytes);																                   \
+        memcpy(result->base, data, nbytes);															                   \
+        *(block) = result;																	                   \
+}
+
+#define MEMBLOCK_RAW_DATA(block)									                                                   \
+        ((block) && (block)->base ? ({ MEMBLOCK_CLOSE_GAP((block)); (block)->base; }) : NULL)
+
+#define MEMBLOCK_RAW_DATA_UNSAFE(block)									                                                   \
+        (block->base)
+
+#define MEMBLOCK_WRITE(block, position, data, nbytes)										                           \
+({										                                                                               \
+        bool memblock_write_status;										                                                           \
+        if (UNLIKELY(MEMBLOCK_IS_MAPPED(block))) {										                                   \
+                memblock_write_status = ERROR(ERR_WRITEPROT, NULL);										               \
+        } else if (LIKELY(position + nbytes < block->blockLength)) {										                   \
+                char *memblock_write_dst = MEMBLOCK_PEEK_MUT_AT(block, position, nbytes);                              \
+                if (LIKELY(memblock_write_dst != NULL)) {                                                              \
+                        memcpy(memblock_write_dst, data, nbytes);                                                      \
+                        block->last_byte = JAK_MAX(block->last_byte, position + nbytes);                               \
+                        memblock_write_status = true;                                                                  \
+                } else {                                                                                               \
+                        memblock_write_status = false;                                                                 \
+                }                                                                                                      \
+        } else {										                                                               \
+                memblock_write_status = false;										                                                   \
+        }										                                                                       \
+        memblock_write_status;										                                                                   \
+})
+
+#define MEMBLOCK_CPY(dst, src)										                                                   \
+{										                                                                               \
+        MEMBLOCK_CREATE((dst), (src)->blockLength);										                               \
+        if (MEMBLOCK_HAS_GAP((src))) {										                                           \
+                memcpy((*(dst))->base, (src)->base, (src)->gap_off);										           \
+                memcpy((char *) (*(dst))->base + (src)->gap_off,										               \
+                       (char *) (src)->base + (src)->gap_off + (src)->gap_len, (src)->blockLength - (src)->gap_off);   \
+        } else {										                                                               \
+                memcpy((*(dst))->base, (src)->base, (src)->blockLength);										       \
+                assert(memcmp((*(dst))->base, (src)->base, (src)->blockLength) == 0);								   \
+        }										                                                                       \
+        assert((*(dst))->base);										                                                   \
+        assert((*(dst))->blockLength == (src)->blockLength);										                   \
+        (*(dst))->last_byte = (src)->last_byte;										                                   \
+        (*(dst))->growth = (src)->growth;										                                   \
+        memblock_digest_cpy(*(dst), (src));										                                   \
+}
+
+/* Copies <code>src</code> into <code>dst</code> sharing the memory of both blocks copy-on-write, see MEMBLOCK_COW_CHUNK */
+#define MEMBLOCK_CPY_SHARED(dst, src)                                                                                  \
+        memblock_cow_clone((dst), (src))
+
+#define MEMBLOCK_SHRINK(block)																		                   \
+{																		                                               \
+        if (LIKELY(!MEMBLOCK_IS_MAPPED((block)))) {																   \
+                MEMBLOCK_CLOSE_GAP((block));															               \
+                (block)->blockLength = (block)->last_byte;															   \
+                if (!MEMBLOCK_IS_SHARED((block))) {															           \
+                        (block)->base = alloc_realloc((block)->alloc, (block)->base, (block)->blockLength);								   \
+                        (block)->capacity = (block)->blockLength;													   \
+                }															                                           \
+        }																		                                       \
+}
+
+#define MEMBLOCK_MOVE_RIGHT(block, where, nbytes)		                                                               \
+        MEMBLOCK_MOVE_EX((block), (where), nbytes, true);
+
+#define MEMBLOCK_MOVE_LEFT(block, where, nbytes)															           \
+({															                                                           \
+        bool status = true;															                                   \
+        if (UNLIKELY(MEMBLOCK_IS_MAPPED((block)))) {													               \
+            status = ERROR(ERR_WRITEPROT, NULL);															           \
+        } else if (UNLIKELY((where) + (nbytes) >= (block)->blockLength)) {											   \
+            status = ERROR(ERR_OUTOFBOUNDS, NULL);															           \
+        } else if ((block)->gap_mode) {															                   \
+            if (MEMBLOCK_HAS_GAP((block))) {															               \
+                    status = MEMBLOCK_MOVE_GAP((block), (where));                                                      \
+            } else {															                                       \
+                    (block)->gap_off = (where);															               \
+            }															                                               \
+            if (UNLIKELY(!status ||                                                                                    \
+                         !MEMBLOCK_GROW_CAPACITY((block), (block)->blockLength + (block)->gap_len + (nbytes)) ||       \
+                         !MEMBLOCK_TOUCH((block), (block)->blockLength + (block)->gap_len, (nbytes)))) {               \
+                    status = false;                                                                                    \
+            } else {                                                                                                   \
+                    (block)->gap_len += (nbytes);                                                                      \
+                    ZERO_MEMORY((char *) (block)->base + (block)->blockLength + (block)->gap_len - (nbytes), (nbytes)) \
+                    assert((block)->last_byte >= (nbytes));                                                            \
+                    (block)->last_byte -= (nbytes);                                                                    \
+                    if ((block)->gap_len > JAK_MAX((offset_t) MEMBLOCK_GAP_MIN, (block)->blockLength)) {               \
+                            MEMBLOCK_CLOSE_GAP((block));                                                               \
+                    }                                                                                                  \
+            }                                                                                                          \
+        } else {															                                           \
+            size_t remainder = (block)->blockLength - (where) - (nbytes);											   \
+            if (remainder > 0 && MEMBLOCK_TOUCH((block), (where), (block)->blockLength - (where))) {                   \
+                    memmove((block)->base + (where), (block)->base + (where) + (nbytes), remainder);				   \
+                    assert((block)->last_byte >= (nbytes));															   \
+                    (block)->last_byte -= (nbytes);															           \
+                    ZERO_MEMORY((block)->base + (block)->blockLength - (nbytes), (nbytes))							   \
+            } else {															                                       \
+                    status = false;															                           \
+            }															                                               \
+        }															                                                   \
+        status;															                                               \
+})
+
+#define MEMBLOCK_MOVE_EX(block, where, nbytes, zero_out)															   \
+({																                                                       \
+        bool status = true;																                               \
+        if (UNLIKELY(MEMBLOCK_IS_MAPPED((block)))) {																   \
+            status = ERROR(ERR_WRITEPROT, NULL);																       \
+        } else if (UNLIKELY(where >= (block)->blockLength)) {														   \
+            ERROR(ERR_OUTOFBOUNDS, NULL);																               \
+            status = false;																                               \
+        } else {																                                       \
+            if (UNLIKELY(nbytes == 0)) {																               \
+                ERROR(ERR_ILLEGALARG, NULL);																           \
+                status = false;																                           \
+            } else if ((block)->gap_mode) {																               \
+                offset_t memblock_move_len = JAK_MAX((block)->blockLength, (block)->last_byte + nbytes);			   \
+                if ((block)->gap_len < (offset_t) (nbytes)) {                                                          \
+                        status = MEMBLOCK_WIDEN_GAP((block), (where), (nbytes));                                       \
+                } else {                                                                                               \
+                        status = MEMBLOCK_MOVE_GAP((block), (where));                                                  \
+                }                                                                                                      \
+                if (LIKELY(status) && zero_out) {                                                                      \
+                        status = MEMBLOCK_TOUCH((block), (where), nbytes);                                             \
+                        if (LIKELY(status)) {                                                                          \
+                                ZERO_MEMORY((char *) (block)->base + (where), nbytes);                                 \
+                        }                                                                                              \
+                }                                                                                                      \
+                if (LIKELY(status)) {                                                                                  \
+                        (block)->gap_off += nbytes;                                                                    \
+                        (block)->gap_len -= nbytes;                                                                    \
+                        (block)->blockLength = memblock_move_len;                                                      \
+                        (block)->last_byte += nbytes;                                                                  \
+                }                                                                                                      \
+            } else {																                                   \
+                status = MEMBLOCK_TOUCH((block), (where),                                                              \
+                                        JAK_MAX((block)->blockLength, (block)->last_byte + nbytes) - (where));         \
+                if (LIKELY(status) && (block)->last_byte + nbytes > (block)->blockLength) {                            \
+                        size_t new_length = ((block)->last_byte + nbytes);                                             \
+                        if (UNLIKELY(!MEMBLOCK_GROW_CAPACITY((block), new_length))) {                                  \
+                                status = false;                                                                        \
+                        } else {                                                                                       \
+                                if (zero_out) {                                                                        \
+                                        ZERO_MEMORY((block)->base + (block)->blockLength,                              \
+                                                    (new_length - (block)->blockLength));                              \
+                                }                                                                                      \
+                                (block)->blockLength = new_length;                                                     \
+                        }                                                                                              \
+                }                                                                                                      \
+                if (LIKELY(status)) {                                                                                  \
+                        memmove((block)->base + where + nbytes, (block)->base + where, (block)->last_byte - where);    \
+                        if (zero_out) {                                                                                \
+                                ZERO_MEMORY((block)->base + where, nbytes);                                            \
+                        }                                                                                              \
+                        (block)->last_byte += nbytes;                                                                  \
+                }                                                                                                      \
+            }                                                                                                          \
+        }																                                               \
+        status;																                                           \
+})
+
+#define MEMBLOCK_ZERO_OUT(block)										                                               \
+{										                                                                               \
+        MEMBLOCK_CLOSE_GAP((block));										                                           \
+        if (LIKELY(MEMBLOCK_TOUCH((block), 0, (block)->blockLength))) {                                                \
+                ZERO_MEMORY((block)->base, (block)->blockLength)                                                       \
+        }                                                                                                              \
+}
+
+#define MEMBLOCK_SIZE(size, block)										                                               \
+{										                                                                               \
+        *(size) = (block)->blockLength;										                                           \
+}
+
+#define MEMBLOCK_LAST_USED_BYTE(block)										                                           \
+        ((block) ? (block)->last_byte : 0)
+
+#define MEMBLOCK_WRITE_TO_FILE(cfile, block)                                                                           \
+({                                                                                                                     \
+        bool memblock_write_to_file_status;                                                                            \
+        if (MEMBLOCK_HAS_GAP((block))) {                                                                               \
+                offset_t memblock_tail_len = (block)->blockLength - (block)->gap_off;                                  \
+                memblock_write_to_file_status =                                                                        \
+                        fwrite((block)->base, 1, (block)->gap_off, (cfile)) == (block)->gap_off &&                     \
+                        fwrite((char *) (block)->base + (block)->gap_off + (block)->gap_len, 1, memblock_tail_len,     \
+                               (cfile)) == memblock_tail_len;                                                          \
+        } else {                                                                                                       \
+                size_t nwritten = fwrite((block)->base, (block)->blockLength, 1, (cfile));                             \
+                memblock_write_to_file_status = (nwritten == 1);                                                       \
+        }                                                                                                              \
+        memblock_write_to_file_status;                                                                                 \
+})
+
+#define MEMBLOCK_RESIZE(block, size)							                                                       \
+({							                                                                                           \
+        bool memblock_resize_status = true;							                                                       \
+        offset_t memblock_resize_size = (size);							                                               \
+        if (UNLIKELY(memblock_resize_size == 0)) {							                                               \
+                memblock_resize_status = ERROR(ERR_ILLEGALARG, NULL);							                           \
+        } else if (UNLIKELY(MEMBLOCK_IS_MAPPED((block)))) {							                                       \
+                memblock_resize_status = ERROR(ERR_WRITEPROT, "memory-mapped block cannot be resized");	               \
+        } else {							                                                                           \
+            if (MEMBLOCK_HAS_GAP((block)) && memblock_resize_size <= (block)->gap_off) {                               \
+                    MEMBLOCK_CLOSE_GAP((block));                                                                       \
+            }                                                                                                          \
+            offset_t memblock_resize_phys = memblock_resize_size + (block)->gap_len;                                   \
+            offset_t memblock_resize_end = (block)->blockLength + (block)->gap_len;                                    \
+            if (memblock_resize_phys > (block)->capacity) {                                                            \
+                    memblock_resize_status = MEMBLOCK_GROW_CAPACITY((block), memblock_resize_phys);                    \
+            } else if ((block)->growth == MEMBLOCK_GROWTH_EXACT && !MEMBLOCK_IS_SHARED((block))) {                     \
+                    (block)->base = alloc_realloc((block)->alloc, (block)->base, memblock_resize_phys);                \
+                    (block)->capacity = memblock_resize_phys;                                                          \
+            }                                                                                                          \
+            if (memblock_resize_status && memblock_resize_phys > memblock_resize_end) {                                \
+                    memblock_resize_status = MEMBLOCK_TOUCH((block), memblock_resize_end,                              \
+                                                            memblock_resize_phys - memblock_resize_end);               \
+                    if (memblock_resize_status) {                                                                      \
+                            ZERO_MEMORY(((char *)(block)->base) + memblock_resize_end,                                 \
+                                        (memblock_resize_phys - memblock_resize_end));                                 \
+                    }                                                                                                  \
+            }                                                                                                          \
+            if (memblock_resize_status) {                                                                              \
+                    (block)->blockLength = memblock_resize_size;                                                       \
+            }                                                                                                          \
+        }							                                                                                   \
+        memblock_resize_status;							                                                                   \
+})
+
+#define MEMBLOCK_MOVE_CONTENTS_AND_DROP(block)					                                                       \
+({					                                                                                                   \
+        MEMBLOCK_CLOSE_GAP((block));					                                                               \
+        if (MEMBLOCK_IS_SHARED((block)) || (block)->alloc) {					                                   \
+                /* the contents are handed out for being freed with free() */					                       \
+                void *memblock_contents = malloc((block)->blockLength);					                               \
+                memcpy(memblock_contents, (block)->base, (block)->blockLength);					                       \
+                MEMBLOCK_IS_SHARED((block)) ? memblock_cow_drop((block)) : alloc_free((block)->alloc, (block)->base);  \
+                (block)->base = memblock_contents;					                                                   \
+        }					                                                                                           \
+        void *result = (block)->base;					                                                               \
+        (block)->base = NULL;					                                                                       \
+        memblock_digest_drop((block));					                                                               \
+        free((block));					                                                                               \
+        result;					                                                                                       \
+})
+
+#define MEMFILE_UPDATE_LAST_BYTE(block, where)							                                               \
+{							                                                                                           \
+        bool memfile_update_last_byte_status = true; UNUSED(memfile_update_last_byte_status);							                                                                   \
+        if (UNLIKELY((where) >= (block)->blockLength)) {							                                   \
+            memfile_update_last_byte_status = ERROR(ERR_ILLEGALSTATE, NULL);							                                           \
+        } else {							                                                                           \
+            (block)->last_byte = JAK_MAX((block)->last_byte, (where));							                       \
+        }							                                                                                   \
+        memfile_update_last_byte_status;							                                                                               \
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/*
+ * memfile - memory file abstraction for i/o on memory blocks
+ *
+ * Copyright 2018 Marcus Pinnecke
+ */
+
+#ifndef HAD_MEMFILE_H
+#define HAD_MEMFILE_H
+
+#include <karbonit/stdinc.h>
+#include <karbonit/std/string.h>
+#include <karbonit/hexdump.h>
+#include <karbonit/mem/memblock.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct memfile {
+        memblock *memblock;
+        offset_t pos;
+        offset_t saved_pos[10];
+        i8 saved_pos_ptr;
+        bool bit_mode;
+        size_t current_read_bit, current_write_bit, bytes_completed;
+        access_mode_e mode;
+} memfile;
+
+#define MEMFILE_PEEK_TYPE(file, type)                                                                                  \
+({                                                                                                                     \
+        assert (MEMFILE_REMAIN_SIZE((file)) >= sizeof(type));                                                          \
+        type* memfile_peek_type_ret = (type*) MEMFILE_PEEK((file), sizeof(type));                                                        \
+        memfile_peek_type_ret;                                                                                                           \
+})
+
+#define MEMFILE_READ_TYPE(file, type)                                                                                  \
+({                                                                                                                     \
+        assert (MEMFILE_REMAIN_SIZE(file) >= sizeof(type));                                                            \
+        (type *) MEMFILE_READ(file, sizeof(type));                                                                     \
+})
+
+#define MEMFILE_READ_TYPE_LIST(file, type, how_many)                                                                   \
+     (const type *) MEMFILE_READ(file, how_many * sizeof(type))
+
+#define MEMFILE_TELL(file)                                                                                             \
+        ((file)->pos)
+
+#define MEMFILE_SKIP_BYTE(file)                                                                                        \
+        MEMFILE_SKIP(file, sizeof(u8))
+
+#define MEMFILE_WRITE(file, data, nbytes)																		       \
+({		                                                                                                               \
+        bool memfile_write_status = false;																                           \
+        if ((file)->mode == READ_WRITE) {																		       \
+                if (LIKELY(nbytes != 0)) {																		       \
+                        offset_t file_size = 0;																		   \
+                        MEMBLOCK_SIZE(&file_size, (file)->memblock);												   \
+                        offset_t required_size = (file)->pos + nbytes;												   \
+                        if (UNLIKELY(required_size >= file_size)) {													   \
+                                MEMBLOCK_RESIZE((file)->memblock, required_size * 1.7f);							   \
+                        }																		                       \
+																		                                               \
+                        if (UNLIKELY(!MEMBLOCK_WRITE((file)->memblock, (file)->pos, ((char *)data), nbytes))) {		   \
+                                memfile_write_status = false;																		   \
+                        } else {	 																	               \
+                                (file)->pos += nbytes;																   \
+                                memfile_write_status = true;                                                           \
+                        }                                                                                              \
+                } else {                                                                                               \
+                        memfile_write_status = true;                                                                   \
+                }                                                                                                      \
+        } else {																		                               \
+                ERROR(ERR_WRITEPROT, NULL);																		       \
+                memfile_write_status = false;																		                   \
+        }																		                                       \
+        memfile_write_status;                                                                                                        \
+})
+
+#define MEMFILE_SAVE_POSITION(file)										                                               \
+({										                                                                               \
+        offset_t pos = MEMFILE_TELL((file));										                                   \
+        if (LIKELY((file)->saved_pos_ptr < (i8) (ARRAY_LENGTH((file)->saved_pos)))) {								   \
+                (file)->saved_pos[(file)->saved_pos_ptr++] = pos;										               \
+        } else {										                                                               \
+                ERROR(ERR_STACK_OVERFLOW, NULL);										                               \
+                pos = 0;										                                                       \
+        }										                                                                       \
+        pos;										                                                                   \
+})
+
+#define MEMFILE_RESTORE_POSITION(file)												                                   \
+({												                                                                       \
+	bool memfile_restore_position_status;												                                                   \
+        if (LIKELY((file)->saved_pos_ptr >= 0)) {												                       \
+                offset_t pos = (file)->saved_pos[--(file)->saved_pos_ptr];											   \
+                MEMFILE_SEEK((file), pos);												                               \
+                memfile_restore_position_status = true;												                                           \
+        } else {												                                                       \
+                memfile_restore_position_status = ERROR(ERR_STACK_UNDERFLOW, NULL);												               \
+        }												                                                               \
+        memfile_restore_position_status;												                                                           \
+})
+
+#define MEMFILE_ENSURE_SPACE(file, nbytes)											                                   \
+({											                                                                           \
+        DECLARE_AND_INIT(offset_t, block_size);											                               \
+        MEMBLOCK_SIZE(&block_size, (file)->memblock);											                       \
+        assert((file)->pos < block_size);											                                   \
+        size_t diff = block_size - (file)->pos;											                               \
+        if (diff < (nbytes)) {											                                               \
+                MEMFILE_GROW((file), (nbytes) - diff);											                       \
+        }											                                                                   \
+        MEMFILE_SAVE_POSITION((file));											                                       \
+        offset_t current_off = MEMFILE_TELL((file));											                       \
+        signed_offset_t shift = 0;											                                           \
+        for (u32 i = 0; i < (nbytes); i++) {											                               \
+                char c = *MEMFILE_READ((file), 1);											                           \
+                if (UNLIKELY(c != 0)) {											                                       \
+                        MEMFILE_SEEK((file), current_off);											                   \
+                        MEMFILE_INPLACE_INSERT((file), (nbytes) - i);											       \
+                        shift += (nbytes) - i;											                               \
+                        break;											                                               \
+                }											                                                           \
+        }											                                                                   \
+        MEMFILE_RESTORE_POSITION((file));											                                   \
+        shift;											                                                               \
+})
+
+#define MEMFILE_READ_UINTVAR_STREAM(_nbytes_, _file_)													                   \
+({													                                                                   \
+        u64 ___result; UNUSED(___result);													                                               \
+        {                                       \
+                u8 __nbytes_read_ = 0;             \
+                ___result = UINTVAR_STREAM_READ(&__nbytes_read_, (uintvar_stream_t) MEMFILE_PEEK((_file_), sizeof(char)));                   \
+                MEMFILE_SKIP((_file_), __nbytes_read_);                                                                                                                                   \
+                if ((_nbytes_) != NULL) { u8 *assign_nbytes = (_nbytes_); *assign_nbytes = __nbytes_read_; }                                                   \
+        }                               \
+        ___result;													                                                       \
+})
+
+#define MEMFILE_SKIP_UINTVAR_STREAM(file)						                                                       \
+        MEMFILE_READ_UINTVAR_STREAM(NULL, (file));
+
+#define MEMFILE_PEEK_UINTVAR_STREAM(nbytes, file)									                                   \
+({									                                                                                   \
+        MEMFILE_SAVE_POSITION((file));									                                               \
+        u64 result = MEMFILE_READ_UINTVAR_STREAM((nbytes), (file));									                   \
+        MEMFILE_RESTORE_POSITION((file));									                                           \
+        result;									                                                                       \
+})
+
+#define MEMFILE_WRITE_UINTVAR_STREAM(nbytes_moved, file, value)												           \
+({												                                                                       \
+        u8 required_blocks = UINTVAR_STREAM_REQUIRED_BLOCKS((value));												   \
+        signed_offset_t shift = MEMFILE_ENSURE_SPACE((file), required_blocks);										   \
+        uintvar_stream_t dst = (uintvar_stream_t) MEMFILE_PEEK_MUT((file), required_blocks);						   \
+        if (LIKELY(dst != NULL)) {                                                                                     \
+                uintvar_stream_write(dst, (value));                                                                    \
+        }                                                                                                              \
+        MEMFILE_SKIP((file), required_blocks);												                           \
+        if ((nbytes_moved) != NULL) { signed_offset_t *assign = nbytes_moved; *assign = shift; }					   \
+        required_blocks;												                                               \
+})
+
+#define MEMFILE_UPDATE_UINTVAR_STREAM(file, value)															           \
+({															                                                           \
+        u8 bytes_used_now, bytes_used_then;															                   \
+        MEMFILE_PEEK_UINTVAR_STREAM(&bytes_used_now, (file));														   \
+        bytes_used_then = UINTVAR_STREAM_REQUIRED_BLOCKS((value));												   	   \
+        if (bytes_used_now < bytes_used_then) {															               \
+                u8 inc = bytes_used_then - bytes_used_now;															   \
+                MEMFILE_INPLACE_INSERT((file), inc);															       \
+        } else if (bytes_used_now > bytes_used_then) {															       \
+                u8 dec = bytes_used_now - bytes_used_then;															   \
+                MEMFILE_INPLACE_REMOVE((file), dec);															       \
+        }															                                                   \
+        uintvar_stream_t dst = (uintvar_stream_t) MEMFILE_PEEK_MUT((file), bytes_used_then);						   \
+        /** the block cannot be written if dst is NULL, see MEMBLOCK_TOUCH */                                          \
+        u8 required_blocks = LIKELY(dst != NULL) ? uintvar_stream_write(dst, (value)) : bytes_used_then;               \
+        MEMFILE_SKIP((file), required_blocks);															               \
+        (bytes_used_then - bytes_used_now);															                   \
+})
+
+
+#define MEMFILE_OPEN(file, block, access_mode_e_mode)								                                   \
+{								                                                                                       \
+        ZERO_MEMORY((file), sizeof(memfile))								                                           \
+        (file)->memblock = (block);								                                                       \
+        (file)->pos = 0;								                                                               \
+        (file)->bit_mode = false;								                                                       \
+        (file)->mode = (access_mode_e_mode);								                                           \
+        (file)->saved_pos_ptr = 0;								                                                       \
+}
+
+#define MEMFILE_CLONE(dst, src)																                           \
+{															                                                           \
+        MEMFILE_OPEN((dst), (src)->memblock, (src)->mode);															   \
+        MEMFILE_SEEK((dst), MEMFILE_TELL((src)));															           \
+        (dst)->bit_mode = (src)->bit_mode;															                   \
+        (dst)->saved_pos_ptr = (src)->saved_pos_ptr;															       \
+        memcpy(&(dst)->saved_pos, &(src)->saved_pos, ARRAY_LENGTH((src)->saved_pos));								   \
+}
+
+#define MEMFILE_SEEK__UNSAFE(file, position)												                                   \
+        (file)->pos = (position)
+
+#define MEMFILE_SEEK(_file_, _position_)												                                   \
+({												                                                                       \
+        bool ___status = true;												                                               \
+        {                                                                                                               \
+                offset_t ___file_size = 0;                                                                                                                                           \
+                MEMBLOCK_SIZE(&___file_size, (_file_)->memblock);                                                                                                                   \
+                if (UNLIKELY((_position_) >= ___file_size)) {                                                                                                                       \
+                        if ((_file_)->mode == READ_WRITE) {                                                                                                                       \
+                                offset_t new_size = (_position_) + 1;                                                                                                               \
+                                MEMBLOCK_RESIZE((_file_)->memblock, new_size);                                                                                                   \
+                        } else {                                                                                                                                               \
+                                ___status = ERROR(ERR_MEMSTATE, NULL);                                                                                                               \
+                        }                                                                                                                                                       \
+                }                                                                                                                                                               \
+                (_file_)->pos = (_position_);                                                                                                                                       \
+        }                                                                                                               \
+        ___status;												                                                           \
+})
+
+#define MEMFILE_SEEK_FROM_HERE(file, where)				                                                               \
+{				                                                                                                       \
+        offset_t now = MEMFILE_TELL((file));				                                                           \
+        offset_t then = now + (where);				                                                                   \
+        MEMFILE_SEEK((file), then);				                                                                       \
+}
+
+#define MEMFILE_GROW(file_in, grow_by_bytes)									                                       \
+{									                                                                                   \
+        if (LIKELY((grow_by_bytes) > 0)) {									                                           \
+                offset_t block_size = 0;									                                           \
+                MEMBLOCK_SIZE(&block_size, (file_in)->memblock);									                   \
+                MEMBLOCK_RESIZE((file_in)->memblock, (block_size + (grow_by_bytes)));								   \
+        }									                                                                           \
+}
+
+#define MEMFILE_GET_OFFSET(position, file)							                                                   \
+{							                                                                                           \
+        *(position) = file->pos;							                                                           \
+}
+
+#define MEMFILE_SIZE(file)							                                                                   \
+({							                                                                                           \
+        u64 ret;							                                                                           \
+        if (!(file)->memblock) {          							                                                   \
+                ret = 0;							                                                                   \
+        } else {							                                                                           \
+                MEMBLOCK_SIZE(&ret, (file)->memblock);							                                       \
+        }							                                                                                   \
+        ret;							                                                                               \
+})
+
+#define MEMFILE_CUT(file, how_many_bytes)							                                                   \
+({							                                                                                           \
+        offset_t block_size = 0;							                                                           \
+        MEMBLOCK_SIZE(&block_size, (file)->memblock);							                                       \
+        bool memfile_cut_status;							                                                                       \
+        if ((how_many_bytes) > 0 && block_size > (how_many_bytes)) {							                       \
+                size_t new_block_size = block_size - (how_many_bytes);							                       \
+                MEMBLOCK_RESIZE((file)->memblock, new_block_size);							                           \
+                (file)->pos = JAK_MIN((file)->pos, new_block_size);							                           \
+                memfile_cut_status = true;							                                                               \
+        } else {							                                                                           \
+                memfile_cut_status = ERROR(ERR_ILLEGALARG, NULL);							                                       \
+        }							                                                                                   \
+        memfile_cut_status;							                                                                               \
+})
+
+#define MEMFILE_REMAIN_SIZE(file)														                               \
+({														                                                               \
+        assert((file)->pos <= MEMFILE_SIZE((file)));														           \
+        (MEMFILE_SIZE((file)) - (file)->pos);														                   \
+})
+
+#define MEMFILE_SHRINK(file)														                                   \
+({														                                                               \
+        bool memfile_shrink_status;														                                           \
+        if ((file)->mode == READ_WRITE) {														                       \
+                MEMBLOCK_SHRINK((file)->memblock);														               \
+                u64 size;														                                       \
+                MEMBLOCK_SIZE(&size, (file)->memblock);														           \
+                assert(size == (file)->pos);														                   \
+                memfile_shrink_status = true;														                                   \
+        } else {														                                               \
+                memfile_shrink_status = ERROR(ERR_WRITEPROT, NULL);														           \
+        }														                                                       \
+        memfile_shrink_status;														                                                   \
+})
+
+#define MEMFILE_READ(file, nbytes)											                                           \
+({											                                                                           \
+        const char *memfile_peek_result = MEMFILE_PEEK((file), (nbytes));											               \
+        (file)->pos += (nbytes);											                                           \
+        memfile_peek_result;											                                                               \
+})
+
+#define MEMFILE_READ_UNSAEF(file, nbytes)											                                           \
+({											                                                                           \
+        const char *memfile_peek_result = MEMFILE_PEEK__FAST((file));											               \
+        (file)->pos += (nbytes);											                                           \
+        memfile_peek_result;											                                                               \
+})
+
+#define MEMFILE_READ_BYTE(file)								                                                           \
+        *MEMFILE_READ_TYPE((file), u8)
+
+#define MEMFILE_PEEK_BYTE(file)								                                                           \
+        *MEMFILE_PEEK_TYPE(file, u8)
+
+#define MEMFILE_READ_U64(file)								                                                           \
+        *MEMFILE_READ_TYPE((file), u64)
+
+#define MEMFILE_READ_I64(file)						                                                                   \
+		*MEMFILE_READ_TYPE((file), i64)
+
+#define MEMFILE_SKIP__UNSAFE(file, nbytes)                              \
+        (file)->pos += (nbytes)
+
+#define MEMFILE_SKIP(file, nbytes)															                           \
+({															                                                           \
+        bool memfile_skip_status = true;															                                   \
+        {                                                                                               \
+                offset_t required_size = (file)->pos + (nbytes);                                                                                                                           \
+                (file)->pos += (nbytes);                                                                                                                                                   \
+                offset_t file_size = 0;                                                                                                                                                       \
+                MEMBLOCK_SIZE(&file_size, (file)->memblock);                                                                                                                               \
+                if (UNLIKELY(required_size >= file_size)) {                                                                                                                                   \
+                        if ((file)->mode == READ_WRITE) {                                                                                                                                   \
+                                MEMBLOCK_RESIZE((file)->memblock, required_size * 1.7f);                                                                           \
+                        } else {                                                                                                                                                           \
+                                ERROR(ERR_WRITEPROT, NULL);                                                                                                                                   \
+                                memfile_skip_status = false;                                                                                                                                               \
+                        }                                                                                                                                                                   \
+                }                                                                                                                                                                           \
+                if (LIKELY(memfile_skip_status)) {                                                                                                                                                       \
+                        MEMFILE_UPDATE_LAST_BYTE((file)->memblock, (file)->pos);                                                                                                   \
+                }                                                                                                                                                                           \
+                assert((file)->pos < MEMFILE_SIZE((file)));                                                                                                                                   \
+        }                                                                               \
+        memfile_skip_status;															                                               \
+})
+
+#define MEMFILE_PEEK(file, nbytes)												                                       \
+({												                                                                       \
+        const char *result = NULL;												                                       \
+        {                                                                                                       \
+                offset_t file_size = 0;												                                           \
+                MEMBLOCK_SIZE(&file_size, (file)->memblock);												                   \
+                if (UNLIKELY((file)->pos + (nbytes) > file_size)) {												               \
+                        ERROR(ERR_READOUTOFBOUNDS, NULL);												                       \
+                        result = NULL;												                                           \
+                } else {												                                                       \
+                                if (MEMBLOCK_RAW_DATA_UNSAFE((file)->memblock)) {										               \
+                                result = MEMBLOCK_PEEK_AT((file)->memblock, (file)->pos, (nbytes));						           \
+                                }														                                               \
+                }												                                                               \
+        }                                                                       \
+        result;												                                                           \
+})
+
+/* pointer to the current position that is valid for the entire remainder of the file (e.g., for raw scans) */
+#define MEMFILE_RAW_DATA(file)                          \
+        ((u8 *) MEMBLOCK_RAW_DATA_AT((file)->memblock, (file)->pos))
+
+/* Same as MEMFILE_PEEK but for writing <code>nbytes</code> bytes at the current position */
+#define MEMFILE_PEEK_MUT(file, nbytes)                                                                                 \
+        MEMBLOCK_PEEK_MUT_AT((file)->memblock, (file)->pos, (nbytes))
+
+#define MEMFILE_PEEK__FAST(file)												                                       \
+                MEMBLOCK_PEEK_AT((file)->memblock, (file)->pos, sizeof(char))
+
+#define MEMFILE_WRITE_BYTE(file, data)							                                                       \
+{																                                                       \
+        u8 byte = data;												                                                   \
+        MEMFILE_WRITE((file), &(byte), sizeof(u8));												                       \
+}
+
+#define MEMFILE_BEGIN_BIT_MODE(file)													                               \
+({													                                                                   \
+        bool memfile_begin_bit_mode_status = true;													                                           \
+        if ((file)->mode == READ_WRITE) {													                           \
+                (file)->bit_mode = true;													                           \
+                (file)->current_read_bit = (file)->current_write_bit = (file)->bytes_completed = 0;					   \
+                (file)->bytes_completed = 0;													                       \
+                offset_t offset;													                                   \
+                char empty = '\0';													                                   \
+                MEMFILE_GET_OFFSET(&offset, (file));													               \
+                MEMFILE_WRITE((file), &empty, sizeof(char));													       \
+                MEMFILE_SEEK((file), offset);													                       \
+        } else {													                                                   \
+                memfile_begin_bit_mode_status = ERROR(ERR_WRITEPROT, NULL);													               \
+        }													                                                           \
+        memfile_begin_bit_mode_status;													                                                       \
+})
+
+static inline bool memfile_write_bit(memfile *file, bool flag)
+{
+        file->current_read_bit = 0;
+
+        if (file->bit_mode) {
+                if (file->current_write_bit < 8) {
+                        offset_t offset;
+                        MEMFILE_GET_OFFSET(&offset, file);
+                        char byte = *MEMFILE_READ(file, sizeof(char));
+                        char mask = 1 << file->current_write_bit;
+                        if (flag) {
+                                SET_BITS(byte, mask);
+                        } else {
+                                UNSET_BITS(byte, mask);
+                        }
+                        MEMFILE_SEEK(file, offset);
+                        MEMFILE_WRITE(file, &byte, sizeof(char));
+                        MEMFILE_SEEK(file, offset);
+                        file->current_write_bit++;
+                } else {
+                    file->current_write_bit = 0;
+                    file->bytes_completed++;
+                    char empty = '\0';
+                    offset_t off;
+                    MEMFILE_SKIP(file, 1);
+                    MEMFILE_GET_OFFSET(&off, file);
+                    MEMFILE_WRITE(file, &empty, sizeof(char));
+                    MEMFILE_SEEK(file, off);
+
+                    return memfile_write_bit(file, flag);
+                }
+                return true;
+        } else {
+                ERROR(ERR_NOBITMODE, NULL);
+                return false;
+        }
+}
+
+#define MEMFILE_READ_BIT(file)																		                   \
+({																		                                               \
+        bool memfile_read_bit_status = true;																		                       \
+        if (!(file)) {																		                           \
+                memfile_read_bit_status = false;																		                   \
+        } else {																		                               \
+			(file)->current_write_bit = 0;																		       \
+			if ((file)->bit_mode) {																		               \
+			        if ((file)->current_read_bit < 8) {																   \
+			                offset_t offset;																		   \
+			                MEMFILE_GET_OFFSET(&offset, (file));													   \
+			                char mask = 1 << (file)->current_read_bit;												   \
+			                char byte = *MEMFILE_READ((file), sizeof(char));										   \
+			                MEMFILE_SEEK((file), offset);															   \
+			                bool result = ((byte & mask) >> (file)->current_read_bit) == true;						   \
+			                (file)->current_read_bit++;																   \
+			                memfile_read_bit_status = result;																		   \
+			        } else {																		                   \
+			                (file)->current_read_bit = 0;															   \
+			                MEMFILE_SKIP((file), sizeof(char));														   \
+			                memfile_read_bit_status = MEMFILE_READ_BIT((file));														   \
+			        }																		                           \
+			} else {																		                           \
+			        ERROR(ERR_NOBITMODE, NULL);																		   \
+			        memfile_read_bit_status = false;																		               \
+			}																		                                   \
+        }																		                                       \
+        memfile_read_bit_status;																		                                   \
+})
+
+#define MEMFILE_SEEK_TO_START(file)											                                           \
+        MEMFILE_SEEK((file), 0)
+
+#define MEMFILE_SEEK_TO_END(file)											                                           \
+({											                                                                           \
+        size_t size = MEMBLOCK_LAST_USED_BYTE((file)->memblock);											           \
+        MEMFILE_SEEK((file), size);											                                           \
+})
+
+#define MEMFILE_INPLACE_INSERT(file, nbytes)											                               \
+        MEMBLOCK_MOVE_RIGHT((file)->memblock, (file)->pos, (nbytes));
+
+#define MEMFILE_INPLACE_REMOVE(file, nbytes_from_here)											                       \
+        MEMBLOCK_MOVE_LEFT((file)->memblock, (file)->pos, (nbytes_from_here));
+
+#define MEMFILE_END_BIT_MODE(num_bytes_written, file)											                       \
+{											                                                                           \
+        (file)->bit_mode = false;											                                           \
+        if ((file)->current_write_bit <= 8) {											                               \
+                MEMFILE_SKIP((file), 1);											                                   \
+                (file)->bytes_completed++;											                                   \
+        }											                                                                   \
+        if ((num_bytes_written) != NULL) { 											                                   \
+        	size_t *assign = (num_bytes_written);											                           \
+        	*assign = (file)->bytes_completed;											                               \
+        }											                                                                   \
+        (file)->current_write_bit = (file)->bytes_completed = 0;											           \
+}
+
+/**
+ * Buffered bit stream on a memory file that writes (resp. reads) up to 64 bits per call. Bits are collected in a
+ * 64-bit accumulator, and transferred to the file in words rather than one read-modify-write per bit as in bit mode.
+ *
+ * The layout is the one of bit mode: the i-th bit of the stream is bit <code>i % 8</code> of the <code>i / 8</code>-th
+ * byte, and a stream of <code>n</code> bits occupies <code>max(1, ceil(n / 8))</code> bytes. Hence, streams written
+ * with <code>memfile_write_bit</code> can be read with <code>memfile_bits_read</code> and vice versa.
+ */
+typedef struct memfile_bits {
+        memfile *file;
+        /* pending bits; bit 0 is the next bit to be written (resp. read) */
+        u64 acc;
+        /* number of pending bits in the accumulator */
+        u32 nbits;
+        /* number of bytes transferred from (resp. to) the file */
+        size_t nbytes;
+} memfile_bits;
+
+static inline bool memfile_bits_begin_write(memfile_bits *stream, memfile *file)
+{
+        if (file->mode != READ_WRITE) {
+                return ERROR(ERR_WRITEPROT, NULL);
+        }
+        stream->file = file;
+        stream->acc = 0;
+        stream->nbits = 0;
+        stream->nbytes = 0;
+        return true;
+}
+
+static inline void memfile_bits_flush_bytes(memfile_bits *stream, u32 nbytes)
+{
+        u8 buffer[sizeof(u64)];
+        for (u32 i = 0; i < nbytes; i++) {
+                buffer[i] = (u8) (stream->acc >> (8 * i));
+        }
+        MEMFILE_WRITE(stream->file, buffer, nbytes);
+        stream->nbytes += nbytes;
+}
+
+/**
+ * Appends the <code>nbits</code> (at most 64) low-order bits of <code>value</code> to the stream, least significant
+ * bit first.
+ */
+static inline void memfile_bits_write(memfile_bits *stream, u64 value, u32 nbits)
+{
+        assert(nbits <= 64);
+        if (UNLIKELY(nbits == 0)) {
+                return;
+        }
+        value &= nbits < 64 ? (((u64) 1 << nbits) - 1) : ~(u64) 0;
+        stream->acc |= value << stream->nbits;
+        if (stream->nbits + nbits >= 64) {
+                memfile_bits_flush_bytes(stream, sizeof(u64));
+                stream->acc = stream->nbits ? value >> (64 - stream->nbits) : 0;
+                stream->nbits = stream->nbits + nbits - 64;
+        } else {
+                stream->nbits += nbits;
+        }
+}
+
+/**
+ * Writes the pending bits (padded with zeros to a full byte), and stores the number of bytes occupied by the stream
+ * in <code>num_bytes_written</code> (if non-null).
+ */
+static inline void memfile_bits_end_write(size_t *num_bytes_written, memfile_bits *stream)
+{
+        if (stream->nbits > 0 || stream->nbytes == 0) {
+                memfile_bits_flush_bytes(stream, JAK_MAX(1u, (stream->nbits + 7) / 8));
+        }
+        stream->acc = 0;
+        stream->nbits = 0;
+        if (num_bytes_written) {
+                *num_bytes_written = stream->nbytes;
+        }
+}
+
+static inline void memfile_bits_begin_read(memfile_bits *stream, memfile *file)
+{
+        stream->file = file;
+        stream->acc = 0;
+        stream->nbits = 0;
+        stream->nbytes = 0;
+}
+
+/**
+ * Reads the next <code>nbits</code> (at most 64) bits from the stream. The first bit read is the least significant
+ * bit of the result. Bits beyond the end of the file are read as zeros.
+ */
+static inline u64 memfile_bits_read(memfile_bits *stream, u32 nbits)
+{
+        assert(nbits <= 64);
+        if (nbits > 56) {
+                /* the accumulator is refilled bytewise, and might hold no more than 57 bits */
+                u64 low = memfile_bits_read(stream, 32);
+                return low | (memfile_bits_read(stream, nbits - 32) << 32);
+        }
+        if (stream->nbits < nbits) {
+                offset_t remain = MEMFILE_REMAIN_SIZE(stream->file);
+                u32 nload = (u32) JAK_MIN((offset_t) (64 - stream->nbits) / 8, remain);
+                const u8 *data = (const u8 *) MEMFILE_READ(stream->file, nload);
+                for (u32 i = 0; i < nload; i++) {
+                        stream->acc |= (u64) data[i] << stream->nbits;
+                        stream->nbits += 8;
+                }
+                stream->nbytes += nload;
+        }
+        u64 result = stream->acc & (nbits < 64 ? (((u64) 1 << nbits) - 1) : ~(u64) 0);
+        u32 consumed = JAK_MIN(nbits, stream->nbits);
+        stream->acc = consumed < 64 ? stream->acc >> consumed : 0;
+        stream->nbits -= consumed;
+        return result;
+}
+
+/**
+ * Positions the file right after the last byte from which bits were read, and stores the number of bytes consumed
+ * in <code>num_bytes_read</code> (if non-null).
+ */
+static inline void memfile_bits_end_read(size_t *num_bytes_read, memfile_bits *stream)
+{
+        /* whole bytes that were loaded into the accumulator but not consumed are given back to the file */
+        u32 unread = stream->nbits / 8;
+        stream->file->pos -= unread;
+        stream->nbytes -= unread;
+        stream->acc = 0;
+        stream->nbits = 0;
+        if (num_bytes_read) {
+                *num_bytes_read = stream->nbytes;
+        }
+}
+
+#define MEMFILE_CURRENT_POS(file, nbytes)																               \
+({																                                                       \
+		void *data = NULL;																                               \
+        if ((file) && (nbytes) > 0) {																                   \
+                offset_t file_size = 0;																                   \
+                MEMBLOCK_SIZE(&file_size, (file)->memblock);														   \
+                offset_t required_size = (file)->pos + (nbytes);													   \
+                if (UNLIKELY((file)->pos + (nbytes) >= file_size)) {												   \
+                        if ((file)->mode == READ_WRITE) {															   \
+                                MEMBLOCK_RESIZE((file)->memblock, required_size * 1.7f);							   \
+                        } else {																                       \
+                                ERROR(ERR_WRITEPROT, NULL);															   \
+                                data = NULL;																           \
+                        }																                               \
+                }																                                       \
+                data = (void *) MEMFILE_PEEK_MUT((file), (nbytes));													   \
+        }																                                               \
+        data;																                                           \
+})
+
+#define MEMFILE_HEXDUMP(str_buf_sb, file)																               \
+{																                                                       \
+        DECLARE_AND_INIT(offset_t, block_size)																           \
+        MEMBLOCK_SIZE(&block_size, (file)->memblock);																   \
+        hexdump((str_buf_sb), MEMBLOCK_RAW_DATA((file)->memblock), block_size);										   \
+}
+
+#define MEMFILE_HEXDUMP_PRINTF(cfile, memfile)													                       \
+({													                                                                   \
+        DECLARE_AND_INIT(offset_t, block_size)													                       \
+        MEMBLOCK_SIZE(&block_size, (memfile)->memblock);													           \
+        hexdump_print((cfile), MEMBLOCK_RAW_DATA((memfile)->memblock), block_size);									   \
+})
+
+#define MEMFILE_HEXDUMP_PRINT(memfile)						                                                           \
+        MEMFILE_HEXDUMP_PRINTF(stdout, (memfile));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif/*
+ * rec - Carbon file record implementation
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_REC_H
+#define HAD_REC_H
+
+#include <karbonit/stdinc.h>
+#include <karbonit/forwdecl.h>
+#include <karbonit/mem/memfile.h>
+#include <karbonit/carbon/markers.h>
+#include <karbonit/carbon/abstract.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Carbon files are built for task parallel environments where multiple readers and (potentially) a single writer
+ * operate on a single file at a certain point in time. A per-file history is managed by a sequence of revisions
+ * that result from revising an existing record. Each revision has a commit hash that identifies that particular version
+ * of the record. Revising is an atomic modification operation on a record, which may span multiple manipulations
+ * (inserts, updates, deletes) at once in one bulk. By the concept of revisions (see 'revise_begin()' and
+ * 'carbon_revision_close()') readers are never blocked by a writer because a writer modifies a copy of the record
+ * eventually swapping the old one with the revised record. However, for single-threaded environments, setting up a
+ * new revision may be to much overhead. Therefore, a revision can be patched. Carbon file patching is, in a nut shell,
+ * a revise but without data snapshotting and commit hash management. Patching allows to modify a document without
+ * creating a new revision but by altered the current revision (i.e., the commit hash remains the same). See patch.h
+ * for more. */
+typedef struct rec {
+        memblock *block;
+        memfile file;
+        offset_t data_off;
+} rec;
+
+/* record revision context */
+typedef struct rev {
+        rec *original;
+        rec *revised;
+        /* path index of the original record, if any, which is valid for the revised record as long as it is not
+         * modified (see revise_begin_indexed) */
+        pindex *index;
+} rev;
+
+typedef struct rec_new {
+        rec original;
+        rev context;
+        arr_it *array;
+        insert *in;
+        /** options shrink or compact (or both) documents, see
+         * CARBON_KEEP, CARBON_SHRINK, CARBON_COMPACT, and CARBON_OPTIMIZE  */
+        int mode;
+} rec_new;
+
+#define CARBON_NIL_STR "undef"
+
+typedef enum key {
+        /** no key, no revision number */
+        KEY_NOKEY = MNOKEY,
+        /** auto-generated 64bit unsigned integer key */
+        KEY_AUTOKEY = MAUTOKEY,
+        /** user-defined 64bit unsigned integer key */
+        KEY_UKEY = MUKEY,
+        /** user-defined 64bit signed integer key */
+        KEY_IKEY = MIKEY,
+        /** user-defined n-char str_buf key */
+        KEY_SKEY = MSKEY
+} key_e;
+
+#define KEEP              0x00 /** do not shrink, do not compact, use UNSORTED_MULTISET (equiv. JSON array) */
+#define SHRINK            0x01 /** perform shrinking, i.e., remove tail-buffer from carbon file */
+#define COMPACT           0x02 /** perform compacting, i.e., remove reserved memory from containers */
+#define UNSORTED_MULTISET 0x04 /** annotate the record outer-most array as unsorted multi set */
+#define SORTED_MULTISET   0x08 /** annotate the record outer-most array as sorted multi set */
+#define UNSORTED_SET      0x10 /** annotate the record outer-most array as unsorted set */
+#define SORTED_SET        0x20 /** annotate the record outer-most array as sorted set */
+#define COLUMNAR          0x40 /** import arrays of numbers, resp. booleans, from JSON as columns of narrowest type */
+
+#define OPTIMIZE          (SHRINK | COMPACT | UNSORTED_MULTISET | COLUMNAR)
+
+/**
+ * Constructs a new context in which a new document can be created. The parameter <b>options</b> controls
+ * how reserved spaces should be handled after document creation is done, and which abstract type for the outer-most
+ * record array should be used.
+ *
+ * Set <code>options</code> to <code>CARBON_KEEP</code> for no optimization. With this option, all capacities
+ * (i.e., additional ununsed but free space) in containers (objects, arrays, and columns) are kept and tailing free
+ * space after the document is kept, too. Use this option to optimize for "insertion-heavy" documents since keeping all
+ * capacities lowest the probability of reallocations and memory movements. Set <b>options</b> to
+ * <code>CARBON_COMPACT</code> if capacities in containers should be removed after creation, and
+ * <code>CARBON_COMPACT</code> to remove tailing free space. Use <code>CARBON_OPTIMIZE</code> to use both
+ * <code>CARBON_SHRINK</code> and <code>CARBON_COMPACT</code>.
+ *
+ * As a rule of thumb for <b>options</b>. The resulting document...
+ * <ul>
+ *  <li>...will be updated heavily where updates may change the type-width of fields, will be target of many inserts
+ *  containers, use <code>CARBON_KEEP</code>. The document will have a notable portion of reserved memory contained;
+ *  insertions or updates will, however, not require immediately reallocation or memory movements.</li>
+ *  <li>...will <i>not</i> be target of insertion of strings or blob fields in the near future, use
+ *      <code>CARBON_SHRINK</code>. The document will not have padding reserved memory at the end, which means that
+ *      a realloction will be required once the document grows (e.g., a container must be englarged). Typically,
+ *      document growth is handled with container capacities (see <code>CARBON_COMPACT</code>). However, insertions
+ *      of variable-length data (i.e., strings and blobs) may require container enlargement. In this case, having
+ *      padding reserved memory at the end of the document lowers the risk of a reallocation.</li>
+ *  <li>...will <i>not</i> not be target of insertion operations or update operations that changes a fields type-width
+ *      in the near future. In simpler words, if a document is updated and each such update keeps the (byte) size
+ *      of the field, use <code>CARBON_COMPACT</code>. This option will remove all capacities in containers.</li>
+ *  <li>...is read-mostly, or updates will not change the type or type-width of fields, use <code>CARBON_OPTIMIZE</code>.
+ *      The document will have the smallest memory footprint possible.</li>
+ * </ul>
+ *
+ * To annotate the outer-most record array as an array container with particular properties, set <code>options</code>
+ * to...
+ * <ul>
+ *  <li>...<code>UNSORTED_MULTISET</code> that allows duplicates and has no sorting</li>
+ *  <li>...<code>SORTED_MULTISET</code> that allows duplicates and has a particular sorting</li>
+ *  <li>...<code>UNSORTED_SET</code> that disallows duplicates and has no sorting</li>
+ *  <li>...<code>SORTED_SET</code> that disallows duplicates and has a particular sorting</li>
+ *  </ul>
+ *  If no annotation is given, the outer-most record array is annotated as <code>UNSORTED_MULTISET</code>, which
+ *  matches the semantics of a JSON array. Please note that this library does not provide any features to make
+ *  deduplication and sorting work. Instead, the annotation stores the semantics of that particular container, which
+ *  functionality must be effectively implemented at caller site.
+ *
+ * For records that are created from JSON, set <code>COLUMNAR</code> (which is part of <code>OPTIMIZE</code>) to
+ * store arrays that contain numbers, booleans, and nulls only as columns instead of arrays. The column type is the
+ * narrowest type that holds all values of the array, e.g., <code>[1, null, 300]</code> becomes a column of
+ * <code>u16</code>, and <code>[-1, 0.5]</code> a column of <code>float</code>. Arrays that mix booleans and numbers,
+ * or whose values do not fit into a single column type, remain arrays.
+ */
+insert *rec_create_begin(rec_new *context, rec *doc, key_e type, int options);
+void rec_create_end(rec_new *context);
+void rec_create_empty(rec *doc, list_type_e derivation, key_e type);
+void rec_create_empty_ex(rec *doc, list_type_e derivation, key_e type, u64 doc_cap, u64 array_cap);
+
+bool rec_from_json(rec *doc, const char *json, key_e type, const void *key);
+bool rec_from_raw_data(rec *doc, const void *data, u64 len);
+
+/** Opens the record stored in file <code>file_path</code> (as written from <code>rec_raw_data</code>) without
+ * reading it. The file is memory-mapped read-only, which makes opening (even very large) records almost free and
+ * lets several processes share the same pages. The record can be read and revised (a revision is a heap copy) but not
+ * patched. The mapping is released with <code>rec_drop</code>. */
+bool rec_from_file(rec *doc, const char *file_path);
+
+bool rec_drop(rec *doc);
+
+/** Drops the heap-allocated record <code>ptr</code> and frees it. The signature matches reclamation callbacks, e.g.,
+ * for <code>epoch_retire</code>. */
+void rec_drop_and_free(void *ptr);
+
+const void *rec_raw_data(u64 *len, rec *doc);
+
+/** Copies <code>doc</code> into <code>clone</code>. Large records are shared copy-on-write (see MEMBLOCK_CPY_SHARED)
+ * such that the copy costs the parts modified in <code>clone</code> afterwards rather than the size of the record.
+ * Cloning does not modify <code>doc</code>, i.e., pointers into <code>doc</code> stay valid and <code>doc</code> may be
+ * read concurrently. Modifying <code>doc</code> afterwards may move its memory while it shares it with copies. */
+void rec_clone(rec *clone, rec *doc);
+
+/** Makes <code>view</code> a read-only view of <code>doc</code>, which shares the memory of <code>doc</code> but reads
+ * through a cursor of its own, such that several threads can read the same record through views of their own. A view
+ * is valid as long as <code>doc</code> is, and is not dropped. */
+void rec_view(rec *view, rec *doc);
+bool rec_commit_hash(u64 *hash, rec *doc);
+
+/** Checks if the records most-outer array is annotated as a multi set abstract type. Returns true if the record
+ * is a multi set, and false if the record is a set. In case of any ERROR, a failure is returned. */
+bool rec_is_multiset(rec *doc);
+
+/** Checks if the records most-outer array is annotated as a sorted abstract type. Returns true if this is the case,
+ * otherwise false. In case of any ERROR, a failure is returned. */
+bool rec_is_sorted(rec *doc);
+
+/** Changes the abstract type of the most-outer record array to the given abstract type */
+void rec_update_list_type(rec *revised, rec *doc, list_type_e derivation);
+
+const char *rec_to_json(str_buf *dst, rec *doc);
+
+/* Opens a read-only iterator for navigating though the records contents.
+ *
+ * For readers, use 'rec_read', and 'revise_begin()' for writers.
+ *
+ * In case a single record must be updated while the upfront costs for the entire revision process is not sustainable,
+ * a record might be patched using a patch iterator, see
+ *
+ *
+ * An opened iterator must be closed by calling 'rec_read_end'. Not closing an iterator leads to undefined
+ * behavior. */
+void rec_read(arr_it *it, rec *doc);
+
+bool rec_is_array(const rec *doc);
+
+bool rec_hexdump_print(FILE *file, rec *doc);
+
+bool rec_key_type(key_e *out, rec *doc);
+const void *rec_key_raw_value(u64 *len, key_e *type, rec *doc);
+bool rec_key_signed_value(i64 *key, rec *doc);
+bool rec_key_unsigned_value(u64 *key, rec *doc);
+const char *key_string_value(u64 *len, rec *doc);
+bool rec_has_key(key_e type);
+bool rec_key_is_unsigned(key_e type);
+bool rec_key_is_signed(key_e type);
+bool rec_key_is_string(key_e type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without ion, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ASYNC_H
+#define ASYNC_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <stdlib.h>
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ASYNC_MSG_UNKNOWN_HINT "Unknown threading hint"
+
+typedef uint_fast16_t thread_id_t;
+
+typedef void (*for_body_func_t)(const void *start, size_t width, size_t len, void *args, thread_id_t tid);
+typedef void (*map_body_func_t)(void *dst, const void *src, size_t src_width, size_t dst_width, size_t len, void *args);
+typedef void(*pred_func_t)(size_t *matching_positions, size_t *num_matching_positions, const void *src, size_t width, size_t len, void *args, size_t position_offset_to_add);
+
+typedef enum threading_hint {
+        THREADING_HINT_SINGLE, THREADING_HINT_MULTI
+} threading_hint;
+
+typedef struct async_func_proxy {
+        for_body_func_t function;
+        const void *start;
+        size_t width;
+        size_t len;
+        thread_id_t tid;
+        void *args;
+} async_func_proxy;
+
+typedef struct filter_arg {
+        size_t num_positions;
+        size_t *src_positions;
+        const void *start;
+        size_t len;
+        size_t width;
+        void *args;
+        pred_func_t pred;
+        size_t position_offset_to_add;
+} filter_arg;
+
+typedef struct map_args {
+        map_body_func_t map_func;
+        void *dst;
+        const void *src;
+        size_t dst_width;
+        void *args;
+} map_args;
+
+typedef struct gather_scatter_args {
+        const size_t *idx;
+        const void *src;
+        void *dst;
+} gather_scatter_args;
+
+void *async_for_proxy_function(void *args);
+
+#define PARALLEL_ERROR(msg, retval)                                                                             \
+{                                                                                                                      \
+    perror(msg);                                                                                                       \
+    return retval;                                                                                                     \
+}
+
+#define ASYNC_MATCH(forSingle, forMulti)                                                                            \
+{                                                                                                                      \
+    if (LIKELY(hint == THREADING_HINT_MULTI)) {                                             \
+        return (forMulti);                                                                                             \
+    } else if (hint == THREADING_HINT_SINGLE) {                                                           \
+        return (forSingle);                                                                                            \
+    } else PARALLEL_ERROR(ASYNC_MSG_UNKNOWN_HINT, false);                                                    \
+}
+
+bool foreach(const void *base, size_t width, size_t len, for_body_func_t f, void *args, threading_hint hint,
+             uint_fast16_t num_threads);
+bool map(void *dst, const void *src, size_t src_width, size_t len, size_t dst_width, map_body_func_t f, void *args, threading_hint hint, uint_fast16_t num_threads);
+bool gather(void *dst, const void *src, size_t width, const size_t *idx, size_t dst_src_len, threading_hint hint, uint_fast16_t num_threads);
+bool gather_adr(void *dst, const void *src, size_t src_width, const size_t *idx, size_t num, threading_hint hint, uint_fast16_t num_threads);
+bool scatter(void *dst, const void *src, size_t width, const size_t *idx, size_t num, threading_hint hint, uint_fast16_t num_threads);
+bool shuffle(void *dst, const void *src, size_t width, const size_t *dst_idx, const size_t *src_idx, size_t idxLen, threading_hint hint);
+bool filter_early(void *result, size_t *result_size, const void *src, size_t width, size_t len, pred_func_t pred, void *args, threading_hint hint, uint_fast16_t num_threads);
+bool filter_late(size_t *pos, size_t *num_pos, const void *src, size_t width, size_t len, pred_func_t pred, void *args, threading_hint hint, size_t num_threads);
+
+bool sync_for(const void *base, size_t width, size_t len, for_body_func_t f, void *args);
+bool async_for(const void *base, size_t width, size_t len, for_body_func_t f, void *args, uint_fast16_t num_threads);
+bool async_map_exec(void *dst, const void *src, size_t src_width, size_t len, size_t dst_width, map_body_func_t f, void *args, threading_hint hint, uint_fast16_t num_threads);
+bool sync_gather(void *dst, const void *src, size_t width, const size_t *idx, size_t dst_src_len);
+bool async_gather(void *dst, const void *src, size_t width, const size_t *idx, size_t dst_src_len, uint_fast16_t num_threads);
+bool sync_gather_adr(void *dst, const void *src, size_t src_width, const size_t *idx, size_t num);
+bool int_async_gather_adr_func(void *dst, const void *src, size_t src_width, const size_t *idx, size_t num, uint_fast16_t num_threads);
+bool sync_scatter(void *dst, const void *src, size_t width, const size_t *idx, size_t num);
+bool sync_scatter_func(void *dst, const void *src, size_t width, const size_t *idx, size_t num, uint_fast16_t num_threads);
+bool sync_shuffle(void *dst, const void *src, size_t width, const size_t *dst_idx, const size_t *src_idx, size_t idx_len);
+bool async_shuffle(void *dst, const void *src, size_t width, const size_t *dst_idx, const size_t *src_idx, size_t idx_len);
+bool async_filter_early(void *result, size_t *result_size, const void *src, size_t width, size_t len, pred_func_t pred, void *args);
+bool int_async_filter_early(void *result, size_t *result_size, const void *src, size_t width, size_t len, pred_func_t pred, void *args, uint_fast16_t num_threads);
+bool int_sync_filter_late(size_t *pos, size_t *num_pos, const void *src, size_t width, size_t len, pred_func_t pred, void *args);
+bool async_filter_late(size_t *pos, size_t *num_pos, const void *src, size_t width, size_t len, pred_func_t pred, void *args, size_t num_threads);
+
+bool foreach(const void *base, size_t width, size_t len, for_body_func_t f, void *args, threading_hint hint,
+             uint_fast16_t num_threads);
+bool map(void *dst, const void *src, size_t src_width, size_t len, size_t dst_width, map_body_func_t f, void *args, threading_hint hint, uint_fast16_t num_threads);
+bool gather(void *dst, const void *src, size_t width, const size_t *idx, size_t dst_src_len, threading_hint hint, uint_fast16_t num_threads);
+bool gather_adr(void *dst, const void *src, size_t src_width, const size_t *idx, size_t num, threading_hint hint, uint_fast16_t num_threads);
+bool scatter(void *dst, const void *src, size_t width, const size_t *idx, size_t num, threading_hint hint, uint_fast16_t num_threads);
+bool shuffle(void *dst, const void *src, size_t width, const size_t *dst_idx, const size_t *src_idx, size_t idx_len, threading_hint hint);
+bool filter_early(void *result, size_t *result_size, const void *src, size_t width, size_t len, pred_func_t pred, void *args, threading_hint hint, uint_fast16_t num_threads);
+bool filter_late(size_t *pos, size_t *num_pos, const void *src, size_t width, size_t len, pred_func_t pred, void *args, threading_hint hint, size_t num_threads);
+bool sync_for(const void *base, size_t width, size_t len, for_body_func_t f, void *args);
+bool async_for(const void *base, size_t width, size_t len, for_body_func_t f, void *args, uint_fast16_t num_threads);
+
+void map_proxy(const void *src, size_t src_width, size_t len, void *args, thread_id_t tid);
+bool async_map_exec(void *dst, const void *src, size_t src_width, size_t len, size_t dst_width, map_body_func_t f, void *args, threading_hint hint, uint_fast16_t num_threads);
+void int_async_gather(const void *start, size_t width, size_t len, void *args, thread_id_t tid);
+
+bool sync_gather(void *dst, const void *src, size_t width, const size_t *idx, size_t dst_src_len);
+bool async_gather(void *dst, const void *src, size_t width, const size_t *idx, size_t dst_src_len, uint_fast16_t num_threads);
+bool sync_gather_adr(void *dst, const void *src, size_t src_width, const size_t *idx, size_t num);
+void async_gather_adr_func(const void *start, size_t width, size_t len, void *args, thread_id_t tid);
+bool int_async_gather_adr_func(void *dst, const void *src, size_t src_width, const size_t *idx, size_t num, uint_fast16_t num_threads);
+void async_scatter(const void *start, size_t width, size_t len, void *args, thread_id_t tid);
+bool sync_scatter(void *dst, const void *src, size_t width, const size_t *idx, size_t num);
+bool sync_scatter_func(void *dst, const void *src, size_t width, const size_t *idx, size_t num, uint_fast16_t num_threads);
+bool sync_shuffle(void *dst, const void *src, size_t width, const size_t *dst_idx, const size_t *src_idx, size_t idx_len);
+bool async_shuffle(void *dst, const void *src, size_t width, const size_t *dst_idx, const size_t *src_idx, size_t idx_len);
+
+bool int_sync_filter_late(size_t *positions, size_t *num_positions, const void *source, size_t width, size_t length, pred_func_t predicate, void *arguments);
+void *int_sync_filter_procy_func(void *args);
+
+bool async_filter_late(size_t *pos, size_t *num_pos, const void *src, size_t width, size_t len, pred_func_t pred, void *args, size_t num_threads);
+bool async_filter_early(void *result, size_t *result_size, const void *src, size_t width, size_t len, pred_func_t pred, void *args);
+bool int_async_filter_early(void *result, size_t *result_size, const void *src, size_t width, size_t len, pred_func_t pred, void *args, uint_fast16_t num_threads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef BITMAP_H
+#define BITMAP_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/std/vec.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct bitmap {
+        vec ofType(u64) data;
+        u16 num_bits;
+} bitmap;
+
+bool bitmap_create(bitmap *bitmap, u16 num_bits);
+bool bitmap_cpy(bitmap *dst, const bitmap *src);
+bool bitmap_drop(bitmap *map);
+size_t bitmap_nbits(const bitmap *map);
+bool bitmap_clear(bitmap *map);
+bool bitmap_set(bitmap *map, u16 bit_position, bool on);
+bool bitmap_get(bitmap *map, u16 bit_position);
+bool bitmap_lshift(bitmap *map);
+bool bitmap_print(FILE *file, const bitmap *map);
+bool bitmap_blocks(u32 **blocks, u32 *num_blocks, const bitmap *map);
+void bitmap_print_bits(FILE *file, u32 n);
+void bitmap_print_bits_in_char(FILE *file, char n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef BLOOM_H
+#define BLOOM_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/std/bitmap.h>
+#include <karbonit/std/hash.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BLOOM_SET(filter, key, key_size)                                                                           \
+({                                                                                                                     \
+    size_t nbits = bitmap_nbits(filter);                                                                           \
+    size_t b0 = HASH_ADDITIVE(key_size, key) % nbits;                                                              \
+    size_t b1 = HASH_XOR(key_size, key) % nbits;                                                                   \
+    size_t b2 = HASH_ROT(key_size, key) % nbits;                                                                   \
+    size_t b3 = HASH_SAX(key_size, key) % nbits;                                                                   \
+    bitmap_set(filter, b0, true);                                                                                  \
+    bitmap_set(filter, b1, true);                                                                                  \
+    bitmap_set(filter, b2, true);                                                                                  \
+    bitmap_set(filter, b3, true);                                                                                  \
+})
+
+#define BLOOM_TEST(filter, key, key_size)                                                                          \
+({                                                                                                                     \
+    size_t nbits = bitmap_nbits(filter);                                                                           \
+    size_t b0 = HASH_ADDITIVE(key_size, key) % nbits;                                                              \
+    size_t b1 = HASH_XOR(key_size, key) % nbits;                                                                   \
+    size_t b2 = HASH_ROT(key_size, key) % nbits;                                                                   \
+    size_t b3 = HASH_SAX(key_size, key) % nbits;                                                                   \
+    bool b0set = bitmap_get(filter, b0);                                                                           \
+    bool b1set = bitmap_get(filter, b1);                                                                           \
+    bool b2set = bitmap_get(filter, b2);                                                                           \
+    bool b3set = bitmap_get(filter, b3);                                                                           \
+    (b0set && b1set && b2set && b3set);                                                                                \
+})
+
+#define BLOOM_TEST_AND_SET(filter, key, key_size)                                                                  \
+({                                                                                                                     \
+    size_t nbits = bitmap_nbits(filter);                                                                           \
+    size_t b0 = HASH_ADDITIVE(key_size, key) % nbits;                                                              \
+    size_t b1 = HASH_XOR(key_size, key) % nbits;                                                                   \
+    size_t b2 = HASH_ROT(key_size, key) % nbits;         \
+    size_t b3 = HASH_SAX(key_size, key) % nbits;         \
+    bool b0set = bitmap_get(filter, b0);                    \
+    bool b1set = bitmap_get(filter, b1);                    \
+    bool b2set = bitmap_get(filter, b2);                    \
+    bool b3set = bitmap_get(filter, b3);                    \
+    bitmap_set(filter, b0, true);                           \
+    bitmap_set(filter, b1, true);                           \
+    bitmap_set(filter, b2, true);                           \
+    bitmap_set(filter, b3, true);                           \
+    (b0set && b1set && b2set && b3set);                     \
+})
+
+bool bloom_create(bitmap *filter, size_t size);
+bool bloom_drop(bitmap *filter);
+bool bloom_clear(bitmap *filter);
+size_t bloom_nbits(bitmap *filter);
+
+unsigned bloom_nhashs();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif/**
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef EPOCH_H
+#define EPOCH_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/std/spinlock.h>
+#include <karbonit/std/vec.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* number of retired objects after which retiring another object tries to free retired objects */
+#define EPOCH_COLLECT_THRESHOLD         64
+
+/* state of a reader that is not in a read-side critical section */
+#define EPOCH_QUIESCENT                 0
+
+/**
+ * A reader of data structures whose objects are reclaimed by an epoch (see <code>epoch_create</code>). Readers are
+ * registered once per thread, and are reused by later registrations once unregistered.
+ */
+typedef struct epoch_reader {
+        /* epoch (shifted by one, with the lowest bit set) in which the reader entered its critical section, or
+         * EPOCH_QUIESCENT outside of critical sections */
+        _Atomic(u64) state;
+        _Atomic(bool) registered;
+        struct epoch *epoch;
+        struct epoch_reader *next;
+} epoch_reader;
+
+/* an object that is unreachable for new readers, and that is dropped once no reader may access it anymore */
+typedef struct epoch_retired {
+        u64 epoch;
+        void *ptr;
+        void (*drop)(void *ptr);
+} epoch_retired;
+
+/**
+ * Epoch-based reclamation of objects that are removed from a data structure while readers may still access them,
+ * e.g., superseded revisions of a record.
+ *
+ * Readers access the data structure only inside read-side critical sections (<code>epoch_enter</code> and
+ * <code>epoch_leave</code>), which neither block nor write to memory shared with other readers. A writer that
+ * unlinks an object from the data structure retires it (<code>epoch_retire</code>) instead of dropping it. A retired
+ * object is dropped once all readers that were in a critical section when it was retired have left their critical
+ * section, i.e., once the global epoch advanced twice after retiring the object. The global epoch advances only if
+ * all readers in critical sections observed the current epoch, such that a reader that stays in its critical section
+ * delays (but never prevents) the reclamation of objects.
+ */
+typedef struct epoch {
+        _Atomic(u64) global;
+        /* registered readers, which are never unlinked before the epoch is dropped */
+        _Atomic(epoch_reader *) readers;
+        /* guards retired objects */
+        spinlock lock;
+        vec ofType(epoch_retired) retired;
+} epoch;
+
+bool epoch_create(epoch *epoch);
+
+/**
+ * Drops all retired objects, and the epoch. No reader must be in a critical section.
+ */
+bool epoch_drop(epoch *epoch);
+
+/**
+ * Registers a reader for the calling thread, which is used by this thread only and released by
+ * <code>epoch_unregister</code>. Registration is lock-free, and can run concurrently to readers and writers.
+ */
+epoch_reader *epoch_register(epoch *epoch);
+bool epoch_unregister(epoch_reader *reader);
+
+/**
+ * Enters a read-side critical section, during which objects that are reachable by the reader at some point in the
+ * critical section are not dropped. Critical sections do not nest.
+ */
+void epoch_enter(epoch_reader *reader);
+
+/**
+ * Leaves the read-side critical section. Objects that the reader accessed must not be accessed anymore afterwards.
+ */
+void epoch_leave(epoch_reader *reader);
+
+/**
+ * Retires the object <code>ptr</code>, which the caller made unreachable for new readers, such that it is dropped by
+ * <code>drop</code> once no reader may access it anymore. Dropping happens during later calls to
+ * <code>epoch_retire</code> or <code>epoch_collect</code> (in the calling thread), or at latest by
+ * <code>epoch_drop</code>.
+ */
+bool epoch_retire(epoch *epoch, void *ptr, void (*drop)(void *ptr));
+
+/**
+ * Tries to advance the global epoch, and drops retired objects that no reader may access anymore. Returns the number
+ * of objects that remain retired.
+ */
+u64 epoch_collect(epoch *epoch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef HASH_H
+#define HASH_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef u8 hash8_t;
+typedef u16 hash16_t;
+typedef u32 hash32_t;
+typedef u64 hash64_t;
+
+#define HASH_ADDITIVE(key_size, key)                                                                               \
+({                                                                                                                     \
+    hash32_t hash = 0;                                                                                                 \
+    for (size_t i = 0; i < key_size; i++) {                                                                            \
+        hash += ((unsigned char* )key)[i];                                                                             \
+    }                                                                                                                  \
+    hash;                                                                                                              \
+})
+
+#define HASH_BERNSTEIN(key_size, key)        HASH_BERNSTEIN_WTYPE(key_size, key, hash32_t)
+#define HASH8_BERNSTEIN(key_size, key)       HASH_BERNSTEIN_WTYPE(key_size, key, hash8_t)
+#define HASH16_BERNSTEIN(key_size, key)      HASH_BERNSTEIN_WTYPE(key_size, key, hash16_t)
+#define HASH64_BERNSTEIN(key_size, key)        HASH_BERNSTEIN_WTYPE(key_size, key, hash64_t)
+
+#define HASH_BERNSTEIN_WTYPE(key_size, key, hash_type)                                                             \
+({                                                                                                                     \
+    assert ((key != NULL) && (key_size > 0));                                                                          \
+                                                                                                                       \
+    hash_type hash = 0;                                                                                                \
+    for (size_t i = 0; i < key_size; i++) {                                                                            \
+        hash ^= 33 * hash + ((unsigned char* )key)[i];                                                                 \
+    }                                                                                                                  \
+    hash;                                                                                                              \
+})
+
+#define HASH64_BERNSTEIN_WSEED(key_size, key, seed)                                                                \
+({                                                                                                                     \
+    assert ((key != NULL) && (key_size > 0));                                                                          \
+                                                                                                                       \
+    hash64_t hash = seed;                                                                                              \
+    for (size_t i = 0; i < key_size; i++) {                                                                            \
+        hash ^= 33 * hash + ((unsigned char* )key)[i];                                                                 \
+    }                                                                                                                  \
+    hash;                                                                                                              \
+})
+
+#define HASH_BERNSTEIN2(key_size, key)                                                                             \
+({                                                                                                                     \
+    assert ((key != NULL) && (key_size > 0));                                                                          \
+                                                                                                                       \
+    hash32_t hash = 0;                                                                                                 \
+    for (size_t i = 0; i < key_size; i++) {                                                                            \
+        hash ^= 33 * hash ^ ((unsigned char* )key)[i];                                                                 \
+    }                                                                                                                  \
+    hash;                                                                                                              \
+})
+
+#define HASH_ELF(key_size, key)                                                                                    \
+({                                                                                                                     \
+    assert ((key != NULL) && (key_size > 0));                                                                          \
+                                                                                                                       \
+    hash32_t hash = 0, g;                                                                                              \
+    for (size_t i = 0; i < key_size; i++) {                                                                            \
+        hash = (hash << 4) + ((unsigned char* )key)[i];                                                                \
+        if ((g = hash & 0xf0000000L) != 0) {                                                                           \
+            hash ^= g >> 24;                                                                                           \
+        }                                                                                                              \
+        hash &= ~g;                                                                                                    \
+    }                                                                                                                  \
+    hash;                                                                                                              \
+})
+
+#define HASH8_FNV(key_size, key)             HASH_FNV_WTYPE(key_size, key, hash8_t)
+#define HASH16_FNV(key_size, key)            HASH_FNV_WTYPE(key_size, key, hash16_t)
+#define HASH_FNV(key_size, key)              HASH_FNV_WTYPE(key_size, key, hash32_t)
+#define HASH64_FNV(key_size, key)              HASH_FNV_WTYPE(key_size, key, hash64_t)
+
+#define HASH_FNV_WTYPE(key_size, key, hash_type)                                                                   \
+({                                                                                                                     \
+    assert ((key != NULL) && (key_size > 0));                                                                          \
+                                                                                                                       \
+    hash_type hash = (hash_type) 2166136261;                                                                           \
+    for (size_t i = 0; i < key_size; i++) {                                                                            \
+        hash = (hash * 16777619) ^ ((unsigned char* )key)[i];                                                          \
+    }                                                                                                                  \
+    hash;                                                                                                              \
+})
+
+#define JENKINS_MIX(a, b, c)                                                                                       \
+{                                                                                                                      \
+    a -= b; a -= c; a ^= (c >> 13);                                                                                    \
+    b -= c; b -= a; b ^= (a << 8);                                                                                     \
+    c -= a; c -= b; c ^= (b >> 13);                                                                                    \
+    a -= b; a -= c; a ^= (c >> 12);                                                                                    \
+    b -= c; b -= a; b ^= (a << 16);                                                                                    \
+    c -= a; c -= b; c ^= (b >> 5);                                                                                     \
+    a -= b; a -= c; a ^= (c >> 3);                                                                                     \
+    b -= c; b -= a; b ^= (a << 10);                                                                                    \
+    c -= a; c -= b; c ^= (b >> 15);                                                                                    \
+}
+
+/** implements: hash32_t hash_jenkins(size_t key_size, const void *key) */
+#define HASH_JENKINS(keySizeIn, key)                                                                               \
+({                                                                                                                     \
+    size_t key_size = keySizeIn;                                                                                       \
+    assert ((key != NULL) && (key_size > 0));                                                                          \
+                                                                                                                       \
+    unsigned a, b;                                                                                                     \
+    unsigned c = 0;                                                                                                    \
+    unsigned char *k = (unsigned char *) key;                                                                          \
+                                                                                                                       \
+    a = b = 0x9e3779b9;                                                                                                \
+                                                                                                                       \
+    while (key_size >= 12) {                                                                                           \
+        a += (k[0] + ((unsigned)k[1] << 8) + ((unsigned)k[2] << 16) + ((unsigned)k[3] << 24));                         \
+        b += (k[4] + ((unsigned)k[5] << 8) + ((unsigned)k[6] << 16) + ((unsigned)k[7] << 24));                         \
+        c += (k[8] + ((unsigned)k[9] << 8) + ((unsigned)k[10] << 16) + ((unsigned)k[11] << 24));                       \
+        JENKINS_MIX(a, b, c);                                                                                      \
+        k += 12;                                                                                                       \
+        key_size -= 12;                                                                                                \
+    }                                                                                                                  \
+                                                                                                                       \
+    c += key_size;                                                                                                     \
+                                                                                                                       \
+    switch (key_size) {                                                                                                \
+        case 11: c += ((unsigned)k[10] << 24); break;                                                                  \
+        case 10: c += ((unsigned)k[9] << 16); break;                                                                   \
+        case 9: c += ((unsigned)k[8] << 8); break;                                                                     \
+        case 8: b += ((unsigned)k[7] << 24); break;                                                                    \
+        case 7: b += ((unsigned)k[6] << 16); break;                                                                    \
+        case 6: b += ((unsigned)k[5] << 8); break;                                                                     \
+        case 5: b += k[4]; break;                                                                                      \
+        case 4: a += ((unsigned)k[3] << 24); break;                                                                    \
+        case 3: a += ((unsigned)k[2] << 16); break;                                                                    \
+        case 2: a += ((unsigned)k[1] << 8); break;                                                                     \
+        case 1: a += k[0]; break;                                                                                      \
+    }                                                                                                                  \
+    JENKINS_MIX(a, b, c);                                                                                          \
+    c;                                                                                                                 \
+})
+
+#define HASH_OAT(key_size, key)                                                                                    \
+({                                                                                                                     \
+    assert ((key != NULL) && (key_size > 0));                                                                          \
+                                                                                                                       \
+    hash32_t hash = 0;                                                                                                 \
+    for (size_t i = 0; i < key_size; i++) {                                                                            \
+        hash += ((unsigned char* )key)[i];                                                                             \
+        hash += (hash << 10);                                                                                          \
+        hash ^= (hash >> 6);                                                                                           \
+    }                                                                                                                  \
+                                                                                                                       \
+    hash += (hash << 3);                                                                                               \
+    hash ^= (hash >> 11);                                                                                              \
+    hash += (hash << 15);                                                                                              \
+                                                                                                                       \
+    hash;                                                                                                              \
+})
+
+#define HASH_ROT(key_size, key)                                                                                    \
+({                                                                                                                     \
+    hash32_t hash = 0;                                                                                                 \
+    for (size_t i = 0; i < key_size; i++) {                                                                            \
+        hash ^= (hash << 4) ^ (hash >> 28) ^ ((unsigned char* )key)[i];                                                \
+    }                                                                                                                  \
+    hash;                                                                                                              \
+})
+
+#define HASH_SAX(key_size, key)                                                                                    \
+({                                                                                                                     \
+    hash32_t hash = 0;                                                                                                 \
+    for (size_t i = 0; i < key_size; i++) {                                                                            \
+        hash ^= (hash << 5) + (hash >> 2) + ((unsigned char* )key)[i];                                                 \
+    }                                                                                                                  \
+    hash;                                                                                                              \
+})
+
+#define HASH_XOR(key_size, key)                                                                                    \
+({                                                                                                                     \
+    hash32_t hash = 0;                                                                                                 \
+    for (size_t i = 0; i < key_size; i++) {                                                                            \
+        hash ^= ((unsigned char* )key)[i];                                                                             \
+    }                                                                                                                  \
+    hash;                                                                                                              \
+})
+
+/** implements: hash64_t hash64_xx(size_t key_size, const void *key); i.e., XXH64 with seed zero */
+#define HASH64_XX(key_size, key)             hash64_xx((key), (key_size), 0)
+
+#define HASH64_XX_PRIME1        0x9E3779B185EBCA87ULL
+#define HASH64_XX_PRIME2        0xC2B2AE3D27D4EB4FULL
+#define HASH64_XX_PRIME3        0x165667B19E3779F9ULL
+#define HASH64_XX_PRIME4        0x85EBCA77C2B2AE63ULL
+#define HASH64_XX_PRIME5        0x27D4EB2F165667C5ULL
+
+#define HASH64_ROTL(x, r)       (((x) << (r)) | ((x) >> (64 - (r))))
+
+static inline u64 hash64_xx_round(u64 acc, u64 input)
+{
+        acc += input * HASH64_XX_PRIME2;
+        acc = HASH64_ROTL(acc, 31);
+        return acc * HASH64_XX_PRIME1;
+}
+
+static inline u64 hash64_xx_merge(u64 acc, u64 val)
+{
+        acc ^= hash64_xx_round(0, val);
+        return acc * HASH64_XX_PRIME1 + HASH64_XX_PRIME4;
+}
+
+/**
+ * 64-bit hash (XXH64) that consumes the key a word at a time. Four independent lanes of 8 bytes each are processed
+ * per iteration, which makes the hash an order of magnitude faster than the bytewise hashes above for larger keys.
+ */
+static inline hash64_t hash64_xx(const void *key, size_t key_size, u64 seed)
+{
+        const u8 *p = (const u8 *) key;
+        const u8 *end = p + key_size;
+        u64 hash, word;
+        u32 half;
+
+        if (key_size >= 32) {
+                u64 v1 = seed + HASH64_XX_PRIME1 + HASH64_XX_PRIME2;
+                u64 v2 = seed + HASH64_XX_PRIME2;
+                u64 v3 = seed;
+                u64 v4 = seed - HASH64_XX_PRIME1;
+                do {
+                        memcpy(&word, p, sizeof(u64));
+                        v1 = hash64_xx_round(v1, word);
+                        memcpy(&word, p + 8, sizeof(u64));
+                        v2 = hash64_xx_round(v2, word);
+                        memcpy(&word, p + 16, sizeof(u64));
+                        v3 = hash64_xx_round(v3, word);
+                        memcpy(&word, p + 24, sizeof(u64));
+                        v4 = hash64_xx_round(v4, word);
+                        p += 32;
+                } while (p + 32 <= end);
+                hash = HASH64_ROTL(v1, 1) + HASH64_ROTL(v2, 7) + HASH64_ROTL(v3, 12) + HASH64_ROTL(v4, 18);
+                hash = hash64_xx_merge(hash, v1);
+                hash = hash64_xx_merge(hash, v2);
+                hash = hash64_xx_merge(hash, v3);
+                hash = hash64_xx_merge(hash, v4);
+        } else {
+                hash = seed + HASH64_XX_PRIME5;
+        }
+
+        hash += (u64) key_size;
+
+        for (; p + 8 <= end; p += 8) {
+                memcpy(&word, p, sizeof(u64));
+                hash ^= hash64_xx_round(0, word);
+                hash = HASH64_ROTL(hash, 27) * HASH64_XX_PRIME1 + HASH64_XX_PRIME4;
+        }
+        if (p + 4 <= end) {
+                memcpy(&half, p, sizeof(u32));
+                hash ^= (u64) half * HASH64_XX_PRIME1;
+                hash = HASH64_ROTL(hash, 23) * HASH64_XX_PRIME2 + HASH64_XX_PRIME3;
+                p += 4;
+        }
+        for (; p < end; p++) {
+                hash ^= (*p) * HASH64_XX_PRIME5;
+                hash = HASH64_ROTL(hash, 11) * HASH64_XX_PRIME1;
+        }
+
+        hash ^= hash >> 33;
+        hash *= HASH64_XX_PRIME2;
+        hash ^= hash >> 29;
+        hash *= HASH64_XX_PRIME3;
+        hash ^= hash >> 32;
+        return hash;
+}
+
+/**
+ * Chunked (two-level Merkle) hashing: the key is split into chunks of HASH64_CHUNK_SIZE bytes (the last chunk may be
+ * shorter), each chunk is hashed on its own, and the hash of the key is the hash of the sequence of chunk hashes. A
+ * key that changes in a few chunks only can therefore be rehashed by rehashing these chunks, and combining the
+ * (cached) hashes of all chunks with <code>hash64_chunks_combine</code>.
+ */
+#define HASH64_CHUNK_SIZE       4096
+
+#define HASH64_NUM_CHUNKS(key_size)                                                                                    \
+        (((key_size) + HASH64_CHUNK_SIZE - 1) / HASH64_CHUNK_SIZE)
+
+static inline hash64_t hash64_chunk(const void *key, size_t key_size, size_t chunk)
+{
+        size_t off = chunk * HASH64_CHUNK_SIZE;
+        return hash64_xx((const u8 *) key + off, JAK_MIN((size_t) HASH64_CHUNK_SIZE, key_size - off), 0);
+}
+
+static inline hash64_t hash64_chunks_combine(const hash64_t *chunk_hashes, size_t num_chunks, size_t key_size)
+{
+        return hash64_xx(chunk_hashes, num_chunks * sizeof(hash64_t), (u64) key_size);
+}
+
+static inline hash64_t hash64_chunked(const void *key, size_t key_size)
+{
+        size_t num_chunks = HASH64_NUM_CHUNKS(key_size);
+        hash64_t small[16];
+        hash64_t *chunk_hashes = num_chunks <= 16 ? small : (hash64_t *) malloc(num_chunks * sizeof(hash64_t));
+        for (size_t chunk = 0; chunk < num_chunks; chunk++) {
+                chunk_hashes[chunk] = hash64_chunk(key, key_size, chunk);
+        }
+        hash64_t hash = hash64_chunks_combine(chunk_hashes, num_chunks, key_size);
+        if (chunk_hashes != small) {
+                free(chunk_hashes);
+        }
+        return hash;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif/**
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef HASHTEST_H
+#define HASHTEST_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/std/vec.h>
+#include <karbonit/std/spinlock.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct hashset_bucket {
+        bool in_use_flag;  /** flag indicating if bucket is in use */
+        i32 displacement; /** difference between intended position during insert, and actual position in table */
+        u64 key_idx;      /** position of key element in owning hashset structure */
+} hashset_bucket;
+
+/**
+ * Hashset implementation specialized for key of fixed-length size, and where comparision
+ * for equals is byte-compare. With this, calling a (type-dependent) compare function becomes obsolete.
+ *
+ * Example: u64.
+ *
+ * This hashset is optimized to reduce access time to elements. Internally, a robin-hood hashing technique is used.
+ *
+ * Note: this implementation does not support string or pointer types. The structure is thread-safe by a spinlock
+ * lock implementation.
+ */
+typedef struct hashset {
+        vec key_data;
+        vec ofType(hashset_bucket) table;
+        spinlock lock;
+        u32 size;
+} hashset;
+
+bool hashset_create(hashset *map, size_t key_size, size_t capacity);
+hashset *hashset_cpy(hashset *src);
+bool hashset_drop(hashset *map);
+
+vec *hashset_keys(hashset *map);
+bool hashset_clear(hashset *map);
+bool hashset_avg_displace(float *displace, const hashset *map);
+bool hashset_lock(hashset *map);
+bool hashset_unlock(hashset *map);
+bool hashset_insert_or_update(hashset *map, const void *keys, uint_fast32_t num_pairs);
+bool hashset_remove_if_contained(hashset *map, const void *keys, size_t num_pairs);
+bool hashset_contains_key(hashset *map, const void *key);
+bool hashset_get_load_factor(float *factor, hashset *map);
+bool hashset_rehash(hashset *map);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef HAHSTABLE_H
+#define HAHSTABLE_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/std/vec.h>
+#include <karbonit/std/spinlock.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct hashtable_bucket {
+        bool in_use_flag;  /** flag indicating if bucket is in use */
+        i32 displacement; /** difference between intended position during insert, and actual position in table */
+        u32 num_probs;    /** number of probe calls to this bucket */
+        u64 data_idx;      /** position of key element in owning hashtable structure */
+} hashtable_bucket;
+
+/**
+ * Hash table implementation specialized for key and value types of fixed-length size, and where comparision
+ * for equals is byte-compare. With this, calling a (type-dependent) compare function becomes obsolete.
+ *
+ * Example: mapping of u64 to u32.
+ *
+ * This hash table is optimized to reduce access time to elements. Internally, a robin-hood hashing technique is used.
+ *
+ * Note: this implementation does not support string or pointer types. The structure is thread-safe by a spinlock
+ * lock implementation.
+ */
+typedef struct hashtable {
+        vec key_data;
+        vec value_data;
+        vec ofType(hashtable_bucket) table;
+        spinlock lock;
+        u32 size;
+} hashtable;
+
+bool hashtable_create(hashtable *map, size_t key_size, size_t value_size, size_t capacity);
+hashtable *hashtable_cpy(hashtable *src);
+bool hashtable_drop(hashtable *map);
+
+bool hashtable_clear(hashtable *map);
+bool hashtable_avg_displace(float *displace, const hashtable *map);
+bool hashtable_insert_or_update(hashtable *map, const void *keys, const void *values, uint_fast32_t num_pairs);
+bool hashtable_serialize(FILE *file, hashtable *table);
+bool hashtable_deserialize(hashtable *table, FILE *file);
+bool hashtable_remove_if_contained(hashtable *map, const void *keys, size_t num_pairs);
+const void *hashtable_get_value(hashtable *map, const void *key);
+bool hashtable_get_load_factor(float *factor, hashtable *map);
+bool hashtable_rehash(hashtable *map);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef OPT_H
+#define OPT_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/std/vec.h>
+
+typedef struct command_opt {
+        char *opt_name;
+        char *opt_desc;
+        char *opt_manfile;
+        int (*callback)(int argc, char **argv, FILE *file);
+} command_opt;
+
+typedef struct command_opt_group {
+        vec ofType(command_opt) cmd_options;
+        char *desc;
+} command_opt_group;
+
+typedef enum module_arg_policy {
+        MOD_ARG_REQUIRED, MOD_ARG_NOT_REQUIRED, MOD_ARG_MAYBE_REQUIRED,
+} module_arg_policy;
+
+typedef struct command_opt_mgr {
+        vec ofType(command_opt_group) groups;
+        module_arg_policy policy;
+        bool (*fallback)(int argc, char **argv, FILE *file, command_opt_mgr *manager);
+        char *module_name;
+        char *module_desc;
+} command_opt_mgr;
+
+bool opt_manager_create(command_opt_mgr *manager, char *module_name, char *module_desc, module_arg_policy policy, bool (*fallback)(int argc, char **argv, FILE *file, command_opt_mgr *manager));
+bool opt_manager_drop(command_opt_mgr *manager);
+
+bool opt_manager_process(command_opt_mgr *manager, int argc, char **argv, FILE *file);
+bool opt_manager_create_group(command_opt_group **group, const char *desc, command_opt_mgr *manager);
+bool opt_group_add_cmd(command_opt_group *group, const char *opt_name, char *opt_desc, char *opt_manfile, int (*callback)(int argc, char **argv, FILE *file));
+bool opt_manager_show_help(FILE *file, command_opt_mgr *manager);
+
+#endif
+/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef SPINLOCK_H
+#define SPINLOCK_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <stdatomic.h>
+
+#include <karbonit/stdinc.h>
+#include <karbonit/std/vec.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct spinlock {
+        atomic_flag lock;
+        pthread_t owner;
+} spinlock;
+
+bool spinlock_init(spinlock *spinlock);
+bool spinlock_acquire(spinlock *spinlock);
+bool spinlock_release(spinlock *spinlock);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+// ---------------------------------------------------------------------------------------------------------------------
+//
+//  S U M M A R Y
+//
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * SUMMARY
+ *
+ * A specialized hash table that uses strings as keys, and 64bit values. The specialization is to avoid some
+ * indirection cost to compare keys, e.g., by calling a function pointer to compare two objects like clib suggest it,
+ * and to ensure that the value is embedded in continuous memory rather than a pointer to another distant memory block.
+ *
+ * Internally, the str_hash is organized by paritions where each partition is assigned exclusively to
+ * one thread. Each such parition contains of as a vec of length 'num_buckets' which contains of elements of a bucket
+ * type. A bucket type is an fixed-size array of entries, each containing a key and a value. In case of no collisions,
+ * this array contains of exactly one element. In case of collisions, colliding keys are stored in this array of entries
+ * in the same bucket. To speedup lookups, this entry vec may be additionally sorted and a (specialized) binary
+ * search is invoked to find the bucket entry associated to a particular key (if any). Other lookup strategies includes
+ * both single and multi-threaded forward scans. Which strategy to use in which case is decided by the
+ * str_hash itself, however. To satisfy user-specific memory limitations, some per-bucket elements may
+ * be swapped out to a didicated swap space.
+ *
+ * The underlying hashing function is the Jenkins hash function.
+ */
+
+#ifndef STRHASH_H
+#define STRHASH_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/std/vec.h>
+#include <karbonit/std/hash.h>
+#include <karbonit/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Enables or disabled packing of entries inside a bucket. By default, packing is disabled.
+ * To turn on packing, set 'CONFIG_PACK_BUCKETS' symbol
+ */
+#ifdef CONFIG_PACK_BUCKETS
+#define
+#define BUCKET_PACKING __attribute__((__packed__))
+#else
+#define BUCKET_PACKING
+#endif
+
+/**
+ * Number of elements stored in the per-bucket cache (Tier 2, see below)
+ */
+#ifndef CONFIG_BUCKET_CACHE_SIZE
+#define CONFIG_BUCKET_CACHE_SIZE  16
+#endif
+
+/**
+ * Maximum number of elements stored per bucket (Tier 3, see below)
+ */
+#ifndef CONFIG_BUCKET_CAPACITY
+#define CONFIG_BUCKET_CAPACITY  1024
+#endif
+
+typedef enum str_hash_tag {
+        MEMORY_RESIDENT
+} str_hash_tag_e;
+
+typedef struct str_hash_counters {
+        size_t num_bucket_search_miss;
+        size_t num_bucket_search_hit;
+        size_t num_bucket_cache_search_miss;
+        size_t num_bucket_cache_search_hit;
+} str_hash_counters;
+
+typedef struct str_hash {
+        /**
+         * Implementation-specific values
+         */
+        void *extra;
+
+        /**
+         * Implementation tag
+         */
+        str_hash_tag_e tag;
+
+        /**
+         * Statistics to lookup misses and hits
+         *
+         * <b>Note</b>: Implementation must maintain counters by itself
+         */
+        str_hash_counters counters;
+
+        /**
+         *  Frees resources bound to <code>self</code> via the allocator specified by the constructor
+         */
+        int (*drop)(str_hash *self);
+
+        /**
+         * Put <code>num_pair</code> objects into this str_hash maybe updating old objects with the same key.
+         */
+        int (*put_bulk_safe)(str_hash *self, char *const *keys, const archive_field_sid_t *values, size_t npairs);
+
+        /**
+         * Put <code>num_pair</code> objects into this str_hash maybe without checking for updates.
+         */
+        int (*put_bulk_fast)(str_hash *self, char *const *keys, const archive_field_sid_t *values, size_t npairs);
+
+        /**
+         * Same as 'put_safe_bulk' but specialized for a single element
+         */
+        int (*put_exact_safe)(str_hash *self, const char *key, archive_field_sid_t value);
+
+        /**
+         * Same as 'put_fast_bulk' but specialized for a single element
+         */
+        int (*put_exact_fast)(str_hash *self, const char *key, archive_field_sid_t value);
+
+        /**
+         * Get the values associated with <code>keys</code> in this str_hash (if any).
+         */
+        int (*get_bulk_safe)(str_hash *self, archive_field_sid_t **out, bool **found_mask, size_t *nnot_found, char *const *keys, size_t nkeys);
+
+        /**
+         * The same as 'get_safe_bulk' but optimized for a single element
+         */
+        int (*get_exact_safe)(str_hash *self, archive_field_sid_t *out, bool *found_mask, const char *key);
+
+        /**
+         * Get the values associated with <code>keys</code> in this str_hash. All keys <u>must</u> exist.
+         */
+        int (*get_fast)(str_hash *self, archive_field_sid_t **out, char *const *keys, size_t nkeys);
+
+        /**
+         * Updates keys associated with <code>values</code> in this str_hash. All values <u>must</u> exist, and the
+         * mapping between keys and values must be bidirectional.
+         */
+        int (*update_key_fast)(str_hash *self, const archive_field_sid_t *values, char *const *keys, size_t nkeys);
+
+        /**
+         * Removes the objects with the gives keys from this str_hash
+         */
+        int (*remove)(str_hash *self, char *const *keys, size_t nkeys);
+
+        /**
+         * Frees up allocated memory for <code>ptr</code> via the allocator in <code>str_hash</code> that was specified
+         * by the call to <code>string_id_map_create</code>
+         */
+        int (*free)(str_hash *self, void *ptr);
+} str_hash;
+
+/**
+ * Frees resources bound to <code>str_hash</code> via the allocator specified by the call to <code>string_id_map_create</code>.
+ *
+ * @param str_hash a non-null pointer to the str_hash
+ * @return <code>true</code> in case of success, otherwise a value indiciating the ERROR.
+ */
+inline static int str_hash_drop(str_hash *str_hash)
+{
+        assert(str_hash->drop);
+        return str_hash->drop(str_hash);
+}
+
+/**
+ * Resets statistics counters
+ *
+ * @param str_hash a non-null pointer to the str_hash
+ * @return <code>true</code> in case of success, otherwise a value indicating the ERROR.
+ */
+inline static bool str_hash_reset_counters(str_hash *str_hash)
+{
+        memset(&str_hash->counters, 0, sizeof(str_hash_counters));
+        return true;
+}
+
+/**
+ * Returns statistics counters
+ * @param out non-null pointer to destination counter
+ * @param str_hash non-null pointer to the str_hash
+ * @return <code>true</code> in case of success, otherwise a value indicating the ERROR.
+ */
+inline static int str_hash_get_counters(str_hash_counters *out, const str_hash *str_hash)
+{
+        *out = str_hash->counters;
+        return true;
+}
+
+/**
+ * Put <code>num_pair</code> objects into this str_hash maybe updating old objects with the same key. If it is
+ * guaranteed that the key is not yet inserted into this table, use <code>string_hashtable_put_blind</code>
+ * instead.
+ *
+ * @param str_hash a non-null pointer to the str_hash
+ * @param keys a non-null constant pointer to a list of at least <code>num_pairs</code> length of constant strings
+ * @param values a non-null constant pointer to a list of at least <code>num_pairs</code> length of 64bit values
+ * @param num_pairs the number of pairs that are read via <code>keys</code> and <code>values</code>
+ * @return <code>true</code> in case of success, otherwise a value indicating the ERROR.
+ */
+inline static int str_hash_put_safe(str_hash *str_hash, char *const *keys, const archive_field_sid_t *values, size_t npairs)
+{
+        assert(str_hash->put_bulk_safe);
+        return str_hash->put_bulk_safe(str_hash, keys, values, npairs);
+}
+
+/**
+ * Put <code>num_pair</code> objects into this str_hash, ingoring whether the key exists or not. This function is
+ * useful for insert operations of pairs where it is guaranteed that the keys are not yet inserted into this hashtable.
+ * In case this guarantee is broken, the behavior is undefined. Depending on the implementation, this specialized
+ * <code>put</code> function may have a better performance.
+ *
+ * If a check for existence is required, use <code>string_hashtable_put_test</code>
+ * instead.
+ *
+ * @param str_hash a non-null pointer to the str_hash
+ * @param keys a non-null constant pointer to a list of at least <code>num_pairs</code> length of constant strings
+ * @param values a non-null constant pointer to a list of at least <code>num_pairs</code> length of 64bit values
+ * @param num_pairs the number of pairs that are read via <code>keys</code> and <code>values</code>
+ * @return <code>true</code> in case of success, otherwise a value indiciating the ERROR.
+ */
+inline static int str_hash_put_bulk_fast(str_hash *str_hash, char *const *keys, const archive_field_sid_t *values, size_t npairs)
+{
+        assert(str_hash->put_bulk_fast);
+        return str_hash->put_bulk_fast(str_hash, keys, values, npairs);
+}
+
+/**
+ * Same as 'string_lookup_put_bulk' but specialized for a single pair
+ */
+inline static int str_hash_put_exact(str_hash *str_hash, const char *key, archive_field_sid_t value)
+{
+        assert(str_hash->put_exact_safe);
+        return str_hash->put_exact_safe(str_hash, key, value);
+}
+
+/**
+ * Same as 'string_lookup_put_fast_bulk' but specialized for a single pair
+ */
+inline static int str_hash_put_exact_fast(str_hash *str_hash, const char *key, archive_field_sid_t value)
+{
+        assert(str_hash->put_exact_fast);
+        return str_hash->put_exact_fast(str_hash, key, value);
+}
+
+/**
+ * Get the values associated with <code>keys</code> in this str_hash (if any). In case one <code>key</code> does not
+ * exists, the function will return this information via the parameters <code>found_mask</code> and
+ * <code>num_not_found</code>. However, in case it is guaranteed that all keys exist, consider to use
+ * <code>string_id_map_get_blind</code> instead. *
+ *
+ * @param out A non-null pointer to an unallocated memory address. The str_hash will allocate enough memory to store the
+ *            result. There are <code>num_keys</code> elements returned, but not all of them are guaranteed to
+ *            contain a particular value. That an entry does not contain a particular value happens if the
+ *            associated key is not stored in this str_hash. Whether or not one particular entry is a valid value,
+ *            can be determined by the caller via the <code>found_mask</code>.
+ *            <b>Important</b> <code>out</code> must be freed manually by calling <code>string_id_map_free</code>.
+ * @param found_mask A non-null pointer to an unallocated memory address. The str_hash will allocate enough memory to store
+ *            the result. There are <code>num_keys</code> boolean values returned. This mask is used to determine
+ *            if the i-th key has a mapping in this str_hash. If this is the case, the i-th entry in <code>found_mask</code>
+ *            is <b>true</b> and the i-th entry in <code>out</code> holds the value. Otherwise, in case the i-th
+ *            value in <code>found_mask</code> is <b>false</b>, there is no value stored to the i-th key in
+ *            <code>keys</code>, and reading <code>out</code> for the i-th position is undefined.
+ * @param num_not_found A non-null pointer to a value that will store the number of keys in <code>keys</code> for
+ *                      which no value is stored in this str_hash.
+ * @param num_out A non-null pointer to an unsigned integer that will contain the number of values return by the
+ *                call to this function.
+ * @param str_hash a non-null pointer to the str_hash
+ * @param keys a non-null pointer to a list of at least <code>num_keys</code> strings
+ * @param num_keys the number of keys
+ * @return <code>true</code> in case of success, otherwise a value indicating the ERROR.
+ */
+inline static int str_hash_get_bulk_safe(archive_field_sid_t **out, bool **found_mask, size_t *num_not_found, str_hash *str_hash, char *const *keys, size_t nkeys)
+{
+        assert(str_hash->get_bulk_safe);
+        int result = str_hash->get_bulk_safe(str_hash, out, found_mask, num_not_found, keys, nkeys);
+        assert (out != NULL);
+        assert (found_mask != NULL);
+        return result;
+}
+
+inline static int str_hash_get_bulk_safe_exact(archive_field_sid_t *out, bool *found, str_hash *str_hash, const char *key)
+{
+        assert(str_hash->get_exact_safe);
+        int result = str_hash->get_exact_safe(str_hash, out, found, key);
+        assert (out != NULL);
+        assert (found != NULL);
+        return result;
+}
+
+/**
+ * Get the values associated with <code>keys</code> in this str_hash. In case one <code>key</code> does not
+ * exists, the behavior is undefined.
+ *
+ * However, if it cannot be guaranteed that all keys are known, use
+ * <code>string_id_map_get_test</code> instead.
+ *
+ * @param out A non-null pointer to an unallocated memory address. The str_hash will allocate <code>num_keys</code>
+ *            times <code>sizeof(archive_field_sid_t)</code> bytes memory to store the result. There are <code>num_keys</code>
+ *            elements returned, and all of them are guaranteed to contain a particular value.
+ * @param str_hash a non-null pointer to the str_hash
+ * @param keys a non-null pointer to a list of at least <code>num_keys</code> strings
+ * @param num_keys the number of keys
+ * @return <code>true</code> in case of success, otherwise a value indicating the ERROR.
+ */
+inline static int str_hash_get_bulk_fast(archive_field_sid_t **out, str_hash *str_hash, char *const *keys, size_t nkeys)
+{
+        assert(str_hash->get_fast);
+        return str_hash->get_fast(str_hash, out, keys, nkeys);
+}
+
+/**
+ * Update keys for a given list of values. It must be guaranteed that the mapping between a key and its value is
+ * bidirectional, and that all values exists.
+ *
+ * If you want to update a value given its key, use <code>string_hashtable_put_test</code> or
+ * <code>string_hashtable_put_blind</code> instead.
+ *
+ * @param out A non-null pointer to an unallocated memory address. The str_hash will allocate <code>num_keys</code>
+ *            times <code>sizeof(archive_field_sid_t)</code> bytes memory to store the result. There are <code>num_keys</code>
+ *            elements returned, and all of them are guaranteed to contain a particular value.
+ * @param str_hash a non-null pointer to the str_hash
+ * @param keys a non-null pointer to a list of at least <code>num_keys</code> strings
+ * @param num_keys the number of keys
+ * @return <code>true</code> in case of success, otherwise a value indicating the ERROR.
+ */
+inline static int str_hash_update_fast(str_hash *str_hash, const archive_field_sid_t *values, char *const *keys, size_t nkeys)
+{
+        assert(str_hash->update_key_fast);
+        return str_hash->update_key_fast(str_hash, values, keys, nkeys);
+}
+
+/**
+ * Removes the objects with the gives keys from this str_hash
+ *
+ * @param str_hash a non-null pointer to the str_hash
+ * @param keys a non-null pointer to a list of at least <code>num_keys</code> strings
+ * @param num_keys the number of keys
+ * @return
+ */
+inline static int str_hash_remove(str_hash *str_hash, char *const *keys, size_t nkeys)
+{
+        assert(str_hash->remove);
+        return str_hash->remove(str_hash, keys, nkeys);
+}
+
+/**
+ * Frees up allocated memory for <code>values</code> via the allocator in <code>str_hash</code> that was specified
+ * by the call to <code>string_id_map_create</code>
+ *
+ * @param values A non-null pointer (potentially resulting from a call to <code>string_id_map_get</code>)
+ * @return <code>true</code> in case of success, otherwise a value indiciating the ERROR.
+ */
+inline static int str_hash_free(void *ptr, str_hash *str_hash)
+{
+        assert(str_hash->free);
+        return str_hash->free(str_hash, ptr);
+}
+
+/**
+ * Resets the counter <code>counters</code> by setting all members to zero.
+ *
+ * @param counters non-null pointer to counter object
+ * @return true if everything went normal, otherwise an value indicating the ERROR
+ */
+inline static int str_hash_counters_init(str_hash_counters *counters)
+{
+        memset(counters, 0, sizeof(str_hash_counters));
+        return true;
+}
+
+/**
+ * Adds members of both input parameters and stores the result in <code>dstLhs</code>.
+ *
+ * @param dstLhs non-null pointer to counter (will contain the result)
+ * @param rhs non-null pointer to counter
+ * @return true if everything went normal, otherwise an value indicating the ERROR
+ */
+inline static int str_hash_counters_add(str_hash_counters *dst_lhs, const str_hash_counters *rhs)
+{
+        dst_lhs->num_bucket_search_miss += rhs->num_bucket_search_miss;
+        dst_lhs->num_bucket_search_hit += rhs->num_bucket_search_hit;
+        dst_lhs->num_bucket_cache_search_hit += rhs->num_bucket_cache_search_hit;
+        dst_lhs->num_bucket_cache_search_miss += rhs->num_bucket_cache_search_miss;
+        return true;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef STRHASH_MEM_H
+#define STRHASH_MEM_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/std/str_hash.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool str_hash_create_inmemory(str_hash *str_hash, size_t num_buckets, size_t cap_buckets);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef STRING_H
+#define STRING_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/mem/alloc.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct str_buf {
+        char *data;
+        size_t cap;
+        size_t end;
+        /* allocator for 'data', or NULL for the standard C library allocator */
+        allocator *alloc;
+} str_buf;
+
+bool str_buf_create(str_buf *buffer);
+bool str_buf_create_ex(str_buf *buffer, size_t capacity);
+/* requests memory via the allocator <code>alloc</code> which must outlive the buffer */
+bool str_buf_create_with(str_buf *buffer, size_t capacity, allocator *alloc);
+bool str_buf_drop(str_buf *buffer);
+
+bool str_buf_add(str_buf *buffer, const char *str);
+bool str_buf_add_nchar(str_buf *buffer, const char *str, u64 strlen);
+void str_buf_add_nquote(str_buf *buffer, const char *str, u64 strlen);
+bool str_buf_add_char(str_buf *buffer, char c);
+bool str_buf_add_u8(str_buf *buffer, u8 value);
+bool str_buf_add_u16(str_buf *buffer, u16 value);
+bool str_buf_add_u32(str_buf *buffer, u32 value);
+bool str_buf_add_u64(str_buf *buffer, u64 value);
+bool str_buf_add_i8(str_buf *buffer, i8 value);
+bool str_buf_add_i16(str_buf *buffer, i16 value);
+bool str_buf_add_i32(str_buf *buffer, i32 value);
+bool str_buf_add_i64(str_buf *buffer, i64 value);
+bool str_buf_add_u64_as_hex(str_buf *buffer, u64 value);
+bool str_buf_add_u64_as_hex_0x_prefix_compact(str_buf *buffer, u64 value);
+bool str_buf_add_float(str_buf *buffer, float value);
+bool str_buf_add_bool(str_buf *buffer, bool value);
+bool str_buf_add_boolean(str_buf *buffer, boolean value);
+bool str_buf_clear(str_buf *buffer);
+bool str_buf_ensure_capacity(str_buf *buffer, u64 cap);
+size_t string_len(str_buf *buffer);
+bool str_buf_trim(str_buf *buffer);
+bool str_buf_is_empty(str_buf *buffer);
+
+const char *str_buf_cstr(str_buf *buffer);
+
+bool str_buf_print(str_buf *buffer);
+bool str_buf_fprint(FILE *file, str_buf *buffer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef STRDIC_H
+#define STRDIC_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/types.h>
+#include <karbonit/std/hash.h>
+#include <karbonit/std/vec.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+FORWARD_STRUCT_DECL(StringDictionary)
+FORWARD_STRUCT_DECL(Vector)
+
+typedef enum str_dict_tag_e {
+        SYNC, ASYNC
+} str_dict_tag_e;
+
+/**
+ * Thread-safe string pool implementation
+ */
+typedef struct string_dict {
+        /**
+         * Implementation-specific fields
+         */
+        void *extra;
+
+        /**
+         * Tag determining the current implementation
+         */
+        str_dict_tag_e tag;
+
+        /**
+         * Frees up implementation-specific resources.
+         *
+         * Note: Implementation must ensure thread-safeness
+         */
+        bool (*drop)(string_dict *self);
+
+        /**
+         * Inserts a particular number of strings into this dictionary and returns associated string identifiers.
+         *
+         * Note: Implementation must ensure thread-safeness
+        */
+        bool (*insert)(string_dict *self, archive_field_sid_t **out, char *const *strings, size_t nstrings, size_t nthreads);
+
+        /**
+         * Removes a particular number of strings from this dictionary by their ids. The caller must ensure that
+         * all string identifiers in <code>strings</code> are valid.
+         *
+         * Note: Implementation must ensure thread-safeness
+         */
+        bool (*remove)(string_dict *self, archive_field_sid_t *strings, size_t nstrings);
+
+        /**
+         * Get the string ids associated with <code>keys</code> in this async_map_exec (if any).
+         *
+         * Note: Implementation must ensure thread-safeness
+         */
+        bool (*locate_safe)(string_dict *self, archive_field_sid_t **out, bool **found_mask, size_t *num_not_found, char *const *keys, size_t num_keys);
+
+        /**
+         * Get the string ids associated with <code>keys</code> in this dic. All keys <u>must</u> exist.
+         *
+         * Note: Implementation must ensure thread-safeness
+        */
+        bool (*locate_fast)(string_dict *self, archive_field_sid_t **out, char *const *keys, size_t num_keys);
+
+        /**
+         * Extracts strings given their string identifier. All <code>ids</code> must be known.
+         *
+         * Note: Implementation must ensure thread-safeness
+         */
+        char **(*extract)(string_dict *self, const archive_field_sid_t *ids, size_t num_ids);
+
+        /**
+         * Frees up memory allocated inside a function call via the allocator given in the constructor
+         *
+         * Note: Implementation must ensure thread-safeness
+         */
+        bool (*free)(string_dict *self, void *ptr);
+
+        /**
+         * Reset internal statistic counters
+         */
+        bool (*resetCounters)(string_dict *self);
+
+        /**
+         * Get internal statistic counters
+         */
+        bool (*counters)(string_dict *self, str_hash_counters *counters);
+
+        /**
+         * Returns number of distinct strings stored in the dictionary
+         */
+        bool (*num_distinct)(string_dict *self, size_t *num);
+
+        /**
+         * Returns all contained (unique) strings and their mapped (unique) ids
+         */
+        bool (*get_contents)(string_dict *self, vec ofType (char *) *strings, vec ofType(archive_field_sid_t) *string_ids);
+} string_dict;
+
+/**
+ *
+ * @param dic
+ * @return
+ */
+static BUILT_IN(bool) string_dict_drop(string_dict *dic)
+{
+        assert(dic->drop);
+        return dic->drop(dic);
+}
+
+static BUILT_IN(bool)
+string_dict_insert(string_dict *dic, archive_field_sid_t **out, char *const *strings, size_t nstrings, size_t nthreads)
+{
+        assert(dic->insert);
+        return dic->insert(dic, out, strings, nstrings, nthreads);
+}
+
+static BUILT_IN(bool)  string_dict_reset_counters(string_dict *dic)
+{
+        assert(dic->resetCounters);
+        return dic->resetCounters(dic);
+}
+
+static BUILT_IN(bool)  string_dict_get_counters(str_hash_counters *counters, string_dict *dic)
+{
+        assert(dic->counters);
+        return dic->counters(dic, counters);
+}
+
+static BUILT_IN(bool)  string_dict_remove(string_dict *dic, archive_field_sid_t *strings, size_t num_strings)
+{
+        assert(dic->remove);
+        return dic->remove(dic, strings, num_strings);
+}
+
+static BUILT_IN(bool) string_dict_locate_safe(archive_field_sid_t **out, bool **found_mask, size_t *num_not_found, string_dict *dic, char *const *keys, size_t num_keys)
+{
+        assert(dic->locate_safe);
+        return dic->locate_safe(dic, out, found_mask, num_not_found, keys, num_keys);
+}
+
+static BUILT_IN(bool) string_dict_locate_fast(archive_field_sid_t **out, string_dict *dic, char *const *keys, size_t nkeys)
+{
+        assert(dic->locate_fast);
+        return dic->locate_fast(dic, out, keys, nkeys);
+}
+
+static BUILT_IN(char **)string_dict_extract(string_dict *dic, const archive_field_sid_t *ids, size_t nids)
+{
+        return dic->extract(dic, ids, nids);
+}
+
+static BUILT_IN(bool) string_dict_free(string_dict *dic, void *ptr)
+{
+        if (ptr) {
+                assert(dic->free);
+                return dic->free(dic, ptr);
+        } else {
+                return true;
+        }
+}
+
+static BUILT_IN(bool) string_dict_num_distinct(size_t *num, string_dict *dic)
+{
+        assert(dic->num_distinct);
+        return dic->num_distinct(dic, num);
+}
+
+static BUILT_IN(bool) string_dict_get_contents(vec ofType (char *) *strings, vec ofType(archive_field_sid_t) *string_ids, string_dict *dic)
+{
+        assert(dic->get_contents);
+        return dic->get_contents(dic, strings, string_ids);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2019 Marcus Pinnecke, Robert Jendersie, Johannes Wuensche, Johann Wagner, and Marten Wallewein-Eising
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without ion, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/utils/priority_queue.h>
+#include <karbonit/std/thread_pool/status.h>
+#include <karbonit/std/thread_pool/stats.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef NOOP
+#define NOOP (void)0
+#endif
+
+#include <stdlib.h>
+#include <pthread.h>
+
+// Required due to bug in gcc, see https://gcc.gnu.org/bugzilla/show_bug.cgi?id=60932
+// stdatomic.h must no be included in GTest
+#ifndef CPP_TEST
+
+#include <stdatomic.h>
+
+#endif
+
+#define THREAD_POOL_MAX_TASKS 4097
+
+typedef void (*task_routine)(void *routine);
+
+typedef struct thread_task {
+        void *args;
+        pthread_attr_t *attr;
+        task_routine routine;
+        size_t group_id;
+        size_t priority;
+        task_stats statistics;
+} thread_task;
+
+typedef struct task_state {
+        atomic_int task_count; // remaining tasks in this group
+        unsigned generation;
+} task_state;
+
+typedef struct task_handle {
+        size_t index;
+        unsigned generation;
+} task_handle;
+
+typedef struct thread_pool {
+        char *name;
+        pthread_t *pool;
+        priority_queue waiting_tasks;
+        task_state *task_group_states;
+        size_t task_state_capacity; // number of tasks that can be tracked
+        size_t size;
+        size_t capacity;
+        thread_info **thread_infos;
+        thread_task **thread_tasks;
+        thread_pool_stats *statistics;
+        int enable_monitoring;
+} thread_pool;
+
+typedef struct thread_info {
+        char name[12];
+        thread_pool *pool;
+        size_t id;
+        atomic_int status;
+        thread_stats *statistics;
+} thread_info;
+
+thread_pool *thread_pool_create(size_t num_threads, int enable_monitoring);
+thread_pool *thread_pool_create_named(size_t num_threads, const char *name, int enable_monitoring);
+
+// Releases all resources hold by the threadpool. 
+// Currently working threads may finish but tasks left in the queue will be discarded.
+void thread_pool_free(thread_pool *pool);
+void thread_pool_set_name(thread_pool *pool, const char *name);
+
+// Sets the number of active threads to num_threads.
+// Currently working threads are terminated after there task is completed.
+bool thread_pool_resize(thread_pool *pool, size_t num_threads);
+
+// Add multiple tasks to be executed. Their progress is tracked by a single handle.
+// hndl can be a nullptr.
+bool thread_pool_enqueue_tasks(thread_task *task, thread_pool *pool, size_t num_tasks, task_handle *hndl);
+
+bool thread_pool_enqueue_task(thread_task *task, thread_pool *pool, task_handle *hndl);
+
+// Add multiple tasks to be executed. Waits until all passed tasks are finished. 
+// The main thread also participates in task execution
+bool thread_pool_enqueue_tasks_wait(thread_task *task, thread_pool *pool, size_t num_tasks);
+
+// Waits until the tasks referenced by hndl are completed.
+bool thread_pool_wait_for_task(thread_pool *pool, task_handle *hndl);
+
+// Waits until all tasks currently in the queue are executed.
+// The main thread also participates in task execution.
+bool thread_pool_wait_for_all(thread_pool *pool);
+
+void *__thread_main(void *args);
+thread_task *__get_next_task(thread_pool *pool);
+bool __create_thread(thread_info *thread_info, pthread_t *pp);
+void __sig_seg(int sig);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2019 Marcus Pinnecke, Robert Jendersie, Johannes Wuensche, Johann Wagner, and Marten Wallewein-Eising
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without ion, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef THREAD_POOL_MONITORING_H
+#define THREAD_POOL_MONITORING_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/std/thread_pool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Returns the average fraction of time the active threads have been working.
+double thread_pool_get_time_working(thread_pool *pool);
+
+// Fill all stats of the passed thread pool instance
+thread_pool_stats thread_pool_get_stats(thread_pool *pool);
+
+// Fill all stats of the thread matching the given id in the thread pool
+thread_stats thread_pool_get_thread_stats(thread_pool *pool, size_t id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2019 Marcus Pinnecke, Robert Jendersie, Johannes Wuensche, Johann Wagner, and Marten Wallewein-Eising
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without ion, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef THREAD_POOL_STATISTICS_H
+#define THREAD_POOL_STATISTICS_H
+
+#include <karbonit/stdinc.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <karbonit/utils/time.h>
+#include <stdio.h>
+
+typedef struct thread_pool_stats {
+        struct timespec creation_time;
+        unsigned int task_enqueued_count;
+        unsigned int task_complete_count;
+        long long complete_time;
+        long long wait_time;
+        long long avg_complete_time;
+        long long avg_wait_time;
+} thread_pool_stats;
+
+typedef struct thread_stats {
+        struct timespec creation_time;
+        long long idle_time;
+        long long busy_time;
+        size_t task_count;
+} thread_stats;
+
+typedef struct task_stats {
+        struct timespec enqueue_time;
+        struct timespec execution_time;
+        struct timespec complete_time;
+} task_stats;
+
+static inline long long __get_time_diff(struct timespec *begin, struct timespec *end)
+{
+        return (end->tv_sec - begin->tv_sec) * 1000000000L + (end->tv_nsec - begin->tv_nsec); /// 1000000000.0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2019 Marcus Pinnecke, Robert Jendersie, Johannes Wuensche, Johann Wagner, and Marten Wallewein-Eising
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without ion, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef THREAD_POOL_STATUS_H
+#define THREAD_POOL_STATUS_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum thread_status_e {
+        THREAD_STATUS_IDLE = 0,
+        THREAD_STATUS_WORKING = 1,
+        THREAD_STATUS_ABORTED = 2,
+        THREAD_STATUS_FINISHED = 3,
+        THREAD_STATUS_KILLED = 4,
+        THREAD_STATUS_CREATED = 5,
+        THREAD_STATUS_WILL_TERMINATE = 6,
+        THREAD_STATUS_COMPLETED = 7,
+        THREAD_STATUS_EMPTY = 99
+} thread_status_e;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * A variable-length unsigned integer type that encodes the number of used bytes by a preceding marker byte
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef UINTVAR_MARKER_H
+#define UINTVAR_MARKER_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/types.h>
+#include <stdbool.h>
+
+/**
+ * This type is for variable-length unsigned integer types.
+ *
+ * The encoding uses a dedicated byte (called marker) to identify the number of subsequent bytes that holding the
+ * actual value: if the first byte read is...
+ *      - ... 'c', then the next byte contains an unsigned integer value of 8bit.
+ *      - ... 'd', then the next 2 bytes contain an unsigned integer value of 16bit.
+ *      - ... 'i', then the next 4 bytes contain an unsigned integer value of 32bit.
+ *      - ... 'l', then the next 8 bytes contain an unsigned integer value of 64bit.
+ *
+ * This implementation supports variable-length encoding to the maximum of unsigned integers of
+ * 64bit (fixed-sized) requiring constant 1 byte more than the standard C type.
+ *
+ * Note that size requirements for this kind of variable-length encoding is (relatively) huge;
+ * the encoding requires as least 12.5% additional storage (to encode 64bit integers) and at most
+ * 100.0% (!) additional storage (to encode 8bit integers). The benefit of marker-based variable-length encoding is that
+ * read-/write performance is superior to byte-stream based variable-length encoding (see <code>uintvar_stream</code>),
+ * and that size requirements payoff for values larger than 65536. Faster read/write performance compared to byte-stream
+ * based variable-length encoding comes by the fact that after determination of actual number of bytes to reads
+ * (i.e., the marker), there is no interpretation overhead to read the actual value while in byte-stream based encoding
+ * each subsequent byte must be inspect (on whether it is the last byte in the stream) before reading its contained
+ * value (after some byte shift operations).
+ *
+ * Rule of thumb:
+ *      - if fixed-length types are a good choice, and...
+ *          - ... if speed matters, use fast-types of the C library (e.g., <code>uint_fast32_t</code>)
+ *          - ... if space matters, use fix-types of the C library (e.g., <code>uint32_t</code>)
+ *      - if variable-length types are a good choice, and...
+ *          - ... if space shall be minimized in exchange of read/write performance, use <code>uintvar_stream_t</code>
+ *          - ... if read/write performance shall be maximized in exchange of space, use <code>uintvar_marker_t</code>
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UINT_VAR_MARKER_8 'c'
+#define UINT_VAR_MARKER_16 'd'
+#define UINT_VAR_MARKER_32 'i'
+#define UINT_VAR_MARKER_64 'l'
+
+typedef void *uintvar_marker_t;
+
+typedef enum uintvar_marker {
+        UINTVAR_8,
+        UINTVAR_16,
+        UINTVAR_32,
+        UINTVAR_64
+} uintvar_marker_e;
+
+bool uintvar_marker_write(uintvar_marker_t dst, u64 value);
+u64 uintvar_marker_read(u8 *nbytes_read, uintvar_marker_t src);
+uintvar_marker_e uintvar_marker_type_for(u64 value);
+bool uintvar_marker_type(const void *data);
+size_t uintvar_marker_sizeof(uintvar_marker_t value);
+size_t uintvar_marker_required_size(u64 value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * A variable-length unsigned integer type that encodes the number of used bytes by a flag bit in the byte stream
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef UINTVAR_STREAM_H
+#define UINTVAR_STREAM_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/types.h>
+#include <karbonit/mem/memfile.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MASK_LAST_BYTE                  (0 | ((char) ~0u))
+#define MASK_FORWARD_BIT                ((char) (1u << 7))
+#define MASK_BLOCK_DATA                 (~MASK_FORWARD_BIT)
+
+/**
+ * This type is for variable-length unsigned integer types.
+ *
+ * The encoding uses the most significant bit (MSB) for each byte in sequence of bytes (called blocks) to determine the
+ * number of bytes required to express the unsigned integer value. The MSB is 1 if there is at least one further byte to
+ * be read, and 0 if the end of the sequence is reached. The remaining 7 bits per block contain the actual bits for
+ * integer value encoding.
+ *
+ * This implementation supports variable-length encoding of the maximum value up to unsigned integer of 64bit (fixed-
+ * length) in at most 10 blocks.
+ *
+ * Example: Given the unsigned integer 16389, its fixed-length representation is
+ *                  01000000 00000101
+ *          Using the varuint type, the representation is
+ *                  (1)0000001 (1)0000000 (0)0000101
+ *
+ *
+ *      # required |      min value      |      max value
+ *        blocks   |       (incl.)       |       (incl.)
+ *      -----------+---------------------+----------------------
+ *               1 |                   0 |                  127
+ *               2 |                 128 |                16383
+ *               3 |               16384 |              2097151
+ *               4 |             2097152 |            268435455
+ *               5 |           268435456 |          34359738367
+ *               6 |         34359738368 |        4398046511103
+ *               7 |       4398046511104 |      562949953421311
+ *               8 |     562949953421312 |    72057594037927935
+ *               9 |   72057594037927936 |  9223372036854775807
+ *              10 | 9223372036854775808 | 18446744073709551615
+ *
+  * Rule of thumb:
+ *      - if fixed-length types are a good choice, and...
+ *          - ... if speed matters, use fast-types of the C library (e.g., <code>uint_fast32_t</code>)
+ *          - ... if space matters, use fix-types of the C library (e.g., <code>uint32_t</code>)
+ *      - if variable-length types are a good choice, and...
+ *          - ... if space shall be minimized in exchange of read/write performance, use <code>uintvar_stream_t</code>
+ *          - ... if read/write performance shall be maximized in exchange of space, use <code>uintvar_marker_t</code>
+ */
+
+typedef void *uintvar_stream_t;
+
+#define UINTVAR_STREAM_MAX_BLOCKS()    (4)
+
+u8 uintvar_stream_write(uintvar_stream_t dst, u64 value);
+
+#define UINTVAR_STREAM_SIZEOF(value)                                                                               \
+({                                                                                                                     \
+        size_t num_blocks_strlen = UINTVAR_STREAM_REQUIRED_BLOCKS(value);                                          \
+        num_blocks_strlen = num_blocks_strlen < sizeof(uintvar_stream_t) ? sizeof(uintvar_stream_t):num_blocks_strlen; \
+        num_blocks_strlen;                                                                                             \
+})
+
+#define UINTVAR_STREAM_REQUIRED_BLOCKS(value)                                                                      \
+({                                                                                                                     \
+        u64 cmp_value = value;                                                                  \
+        u8 num_blocks_required;                                                                                    \
+        if (cmp_value < 128u) {                                                                                            \
+                num_blocks_required = 1;                                                                               \
+        } else if (cmp_value < 16384u) {                                                                                   \
+                num_blocks_required = 2;                                                                               \
+        } else if (cmp_value < 2097152u) {                                                                                 \
+                num_blocks_required = 3;                                                                               \
+        } else if (cmp_value < 268435456u) {                                                                               \
+                num_blocks_required = 4;                                                                               \
+        } else if (cmp_value < 34359738368u) {                                                                             \
+                num_blocks_required = 5;                                                                               \
+        } else if (cmp_value < 4398046511104u) {                                                                           \
+                num_blocks_required = 6;                                                                               \
+        } else if (cmp_value < 562949953421312u) {                                                                         \
+                num_blocks_required = 7;                                                                               \
+        } else if (cmp_value < 72057594037927936u) {                                                                       \
+                num_blocks_required = 8;                                                                               \
+        } else if (cmp_value < 9223372036854775808u) {                                                                     \
+                num_blocks_required = 9;                                                                               \
+        } else {                                                                                                       \
+                num_blocks_required = 10;                                                                              \
+        }                                                                                                              \
+        num_blocks_required;                                                                                           \
+})
+
+#define UINTVAR_STREAM_READ(u8_ptr_nbytes, uintvar_stream)                                                             \
+({                                                                                                                     \
+        u64 uintvar_stream_read_value = 0;                                                                                                 \
+        {                                                                                                       \
+                bool ___has_next__ = true;                                                                                          \
+                uint_fast8_t ___ndecoded__ = 0;                                                                                     \
+                                                                                                                               \
+                const char *___stream__ = (const char *)(uintvar_stream);                                                           \
+                for (char ___byte__ = *(char *) ___stream__, block_val = 0; ___has_next__;                                                \
+                     ___has_next__ = (___byte__ & MASK_FORWARD_BIT) == MASK_FORWARD_BIT,                                             \
+                     block_val = ___byte__ & MASK_BLOCK_DATA, uintvar_stream_read_value = (uintvar_stream_read_value << 7) | block_val, ___stream__++,                       \
+                     ___ndecoded__++, ___byte__ = *(char *) ___stream__)                                                                  \
+                { }                                                                                                            \
+                                                                                                                               \
+                u8 *___nbytes_ptr__ = (u8_ptr_nbytes);                                                                              \
+                OPTIONAL_SET(___nbytes_ptr__, ___ndecoded__);                                                                            \
+        }                                                                                                                       \
+        uintvar_stream_read_value;                                                                                                         \
+})
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2018 Marcus Pinnecke
+ */
+
+#ifndef HAD_VEC_H
+#define HAD_VEC_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <sys/mman.h>
+
+#include <karbonit/stdinc.h>
+#include <karbonit/mem/alloc.h>
+#include <karbonit/mem/memfile.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * An implementation of the concrete data type Vector, a resizeable dynamic array.
+ */
+typedef struct vec {
+        /**
+         *  Fixed number of bytes for a single element that should be stored in the vec
+         */
+        size_t elem_size;
+
+        /**
+         *  The number of elements currently stored in the vec
+         */
+        u32 num_elems;
+
+        /**
+         *  The number of elements for which currently memory is reserved
+         */
+        u32 cap_elems;
+
+        /**
+        * The grow factor considered for resize operations
+        */
+        float grow_factor;
+
+        /**
+         * A pointer to a memory address managed by 'allocator' that contains the user data
+         */
+        void *base;
+
+        /**
+         * The allocator for 'base', or <code>NULL</code> for the standard C library allocator
+         */
+        allocator *alloc;
+} vec;
+
+/**
+ * Utility implementation of generic vec to specialize for type of 'char *'
+ */
+typedef vec ofType(const char *) string_vec_t;
+
+/**
+ * Constructs a new vec for elements of size 'elem_size', reserving memory for 'cap_elems' elements using
+ * the allocator 'alloc'.
+ *
+ * @param out non-null vec that should be constructed
+ * @param alloc an allocator
+ * @param elem_size fixed-length element size
+ * @param cap_elems number of elements for which memory should be reserved
+ * @return STATUS_OK if success, and STATUS_NULLPTR in case of NULL pointer parameters
+ */
+bool vec_create(vec *out, size_t elem_size, size_t cap_elems);
+
+/**
+ * Same as <code>vec_create</code> but requests memory via the allocator <code>alloc</code> which must outlive the vec
+ */
+bool vec_create_with(vec *out, size_t elem_size, size_t cap_elems, allocator *alloc);
+
+bool vec_to_file(FILE *file, vec *vec);
+
+bool vec_from_file(vec *vec, FILE *file);
+
+/**
+ * Provides hints on the OS kernel how to deal with memory inside this vec.
+ *
+ * @param vec non-null vec
+ * @param madviseAdvice value to give underlying <code>madvise</code> syscall and advice, see man page
+ * of <code>madvise</code>
+ * @return STATUS_OK if success, otherwise a value indicating the ERROR
+ */
+bool vec_madvise(vec *vec, int madviseAdvice);
+
+/**
+ * Sets the factor for determining the reallocation size in case of a resizing operation.
+ *
+ * Note that <code>factor</code> must be larger than one.
+ *
+ * @param vec non-null vec for which the grow factor should be changed
+ * @param factor a positive real number larger than 1
+ * @return STATUS_OK if success, otherwise a value indicating the ERROR
+ */
+bool vec_set_grow_factor(vec *vec, float factor);
+
+/**
+ * Frees up memory requested via the allocator.
+ *
+ * Depending on the allocator implementation, dropping the reserved memory might not take immediately effect.
+ * The pointer 'vec' itself gets not freed.
+ *
+ * @param vec vec to be freed
+ * @return STATUS_OK if success, and STATUS_NULL_PTR in case of NULL pointer to 'vec'
+ */
+bool vec_drop(vec *vec);
+
+/**
+ * Returns information on whether elements are stored in this vec or not.
+ * @param vec non-null pointer to the vec
+ * @return Returns <code>STATUS_TRUE</code> if <code>vec</code> is empty. Otherwise <code>STATUS_FALSE</code> unless
+ *         an ERROR occurs. In case an ERROR is occured, the return value is neither <code>STATUS_TRUE</code> nor
+ *         <code>STATUS_FALSE</code> but an value indicating that ERROR.
+ */
+bool vec_is_empty(const vec *vec);
+
+/**
+ * Appends 'num_elems' elements stored in 'data' into the vec by copying num_elems * vec->elem_size into the
+ * vectors memory block.
+ *
+ * In case the capacity is not sufficient, the vec gets automatically resized.
+ *
+ * @param vec the vec in which the data should be pushed
+ * @param data non-null pointer to data that should be appended. Must be at least size of 'num_elems' * vec->elem_size.
+ * @param num_elems number of elements stored in data
+ * @return STATUS_OK if success, and STATUS_NULLPTR in case of NULL pointer parameters
+ */
+bool vec_push(vec *vec, const void *data, size_t num_elems);
+
+const void *vec_peek(vec *vec);
+
+#define VEC_PEEK(vec, type) (type *)(vec_peek(vec))
+
+/**
+ * Appends 'how_many' elements of the same source stored in 'data' into the vec by copying how_many * vec->elem_size
+ * into the vectors memory block.
+ *
+ * In case the capacity is not sufficient, the vec gets automatically resized.
+ *
+ * @param vec the vec in which the data should be pushed
+ * @param data non-null pointer to data that should be appended. Must be at least size of one vec->elem_size.
+ * @param num_elems number of elements stored in data
+ * @return STATUS_OK if success, and STATUS_NULLPTR in case of NULL pointer parameters
+ */
+bool vec_repeated_push(vec *vec, const void *data, size_t how_often);
+
+/**
+ * Returns a pointer to the last element in this vec, or <code>NULL</code> is the vec is already empty.
+ * The number of elements contained in that vec is decreased, too.
+ *
+ * @param vec non-null pointer to the vec
+ * @return Pointer to last element, or <code>NULL</code> if vec is empty
+ */
+const void *vec_pop(vec *vec);
+
+bool vec_clear(vec *vec);
+
+/**
+ * Shinks the vec's internal data block to fits its real size, i.e., remove reserved memory
+ *
+ * @param vec
+ * @return
+ */
+bool vec_shrink(vec *vec);
+
+/**
+ * Increases the capacity of that vec according the internal grow factor
+ * @param numNewSlots a pointer to a value that will store the number of newly created slots in that vec if
+ *                      <code>num_new_slots</code> is non-null. If this parameter is <code>NULL</code>, it is ignored.
+ * @param vec non-null pointer to the vec that should be grown
+ * @return STATUS_OK in case of success, and another value indicating an ERROR otherwise.
+ */
+bool vec_grow(size_t *numNewSlots, vec *vec);
+
+bool vec_grow_to(vec *vec, size_t capacity);
+
+#define VEC_LENGTH(vec)                                                                                             \
+        (vec)->num_elems
+
+#define VEC_GET(vec, pos, type) ((type *) vec_at(vec, pos))
+
+#define VEC_NEW_AND_GET(vec, type)                                                                              \
+({                                                                                                                     \
+    type obj;                                                                                                          \
+    size_t vectorLength = VEC_LENGTH(vec);                                                                      \
+    vec_push(vec, &obj, 1);                                                                                     \
+    VEC_GET(vec, vectorLength, type);                                                                           \
+})
+
+const void *vec_at(const vec *vec, size_t pos);
+
+/**
+ * Returns the number of elements for which memory is currently reserved in the vec
+ *
+ * @param vec the vec for which the operation is started
+ * @return 0 in case of NULL pointer to 'vec', or the number of elements otherwise.
+ */
+size_t vec_capacity(const vec *vec);
+
+/**
+ * Set the internal size of <code>vec</code> to its capacity.
+ */
+bool vec_enlarge_size_to_capacity(vec *vec);
+
+bool vec_zero_memory(vec *vec);
+
+bool vec_zero_memory_in_range(vec *vec, size_t from, size_t to);
+
+bool vec_set(vec *vec, size_t pos, const void *data);
+
+bool vec_cpy(vec *dst, const vec *src);
+
+bool vec_cpy_to(vec *dst, vec *src);
+
+/**
+ * Gives raw data access to data stored in the vec; do not manipulate this data since otherwise the vec
+ * might get corrupted.
+ *
+ * @param vec the vec for which the operation is started
+ * @return pointer to user-data managed by this vec
+ */
+const void *vec_data(const vec *vec);
+
+char *vec_string(const vec ofType(T) *vec,
+                    void (*printerFunc)(memfile *dst, void ofType(T) *values, size_t num_elems));
+
+#define VEC_ALL(vec, type) (type *) vec_data(vec)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef COMMON_H
+#define COMMON_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <assert.h>
+#include <inttypes.h>
+#include <errno.h>
+#include <limits.h>
+#include <math.h>
+
+#include <karbonit/forwdecl.h>
+
+#ifndef __cplusplus
+
+# include <stdatomic.h>
+
+#else
+# include <atomic>
+# define _Atomic(X) std::atomic< X >
+#endif
+
+#define MALLOC(size)                \
+({                                      \
+        void *ptr = malloc(size);       \
+        ZERO_MEMORY(ptr, size);     \
+        ptr;                            \
+})
+
+#define QUERY_LIMIT_NONE -1
+#define QUERY_LIMIT_1     1
+
+#define ARRAY_LENGTH(x)                                                                                            \
+    sizeof(x)/sizeof(x[0])
+
+typedef uint64_t offset_t;
+typedef int64_t signed_offset_t;
+
+typedef unsigned char u_char;
+
+typedef enum archive_field_type {
+        ARCHIVE_FIELD_NULL = 0,
+        ARCHIVE_FIELD_BOOLEAN = 1,
+        ARCHIVE_FIELD_INT8 = 2,
+        ARCHIVE_FIELD_INT16 = 3,
+        ARCHIVE_FIELD_INT32 = 4,
+        ARCHIVE_FIELD_INT64 = 5,
+        ARCHIVE_FIELD_UINT8 = 6,
+        ARCHIVE_FIELD_UINT16 = 7,
+        ARCHIVE_FIELD_UINT32 = 8,
+        ARCHIVE_FIELD_UINT64 = 9,
+        ARCHIVE_FIELD_FLOAT = 10,
+        ARCHIVE_FIELD_STRING = 11,
+        ARCHIVE_FIELD_OBJECT = 12,
+        ARCHIVE_FIELD_ERR    = 13
+} archive_field_e;
+
+typedef enum access_mode_e {
+        READ_WRITE,
+        READ_ONLY
+} access_mode_e;
+
+#define MAYBE_UNUSED __attribute__((unused))
+
+MAYBE_UNUSED static const char *basic_type_to_json_type_str(enum archive_field_type t)
+{
+        switch (t) {
+                case ARCHIVE_FIELD_INT8:
+                case ARCHIVE_FIELD_INT16:
+                case ARCHIVE_FIELD_INT32:
+                case ARCHIVE_FIELD_INT64:
+                case ARCHIVE_FIELD_UINT8:
+                case ARCHIVE_FIELD_UINT16:
+                case ARCHIVE_FIELD_UINT32:
+                case ARCHIVE_FIELD_UINT64:
+                        return "integer";
+                case ARCHIVE_FIELD_FLOAT:
+                        return "float";
+                case ARCHIVE_FIELD_STRING:
+                        return "str_buf";
+                case ARCHIVE_FIELD_BOOLEAN:
+                        return "boolean";
+                case ARCHIVE_FIELD_NULL:
+                        return "null";
+                case ARCHIVE_FIELD_OBJECT:
+                        return "object";
+                default:
+                        return "(unknown)";
+        }
+}
+
+MAYBE_UNUSED static const char *basic_type_to_system_type_str(enum archive_field_type t)
+{
+        switch (t) {
+                case ARCHIVE_FIELD_INT8:
+                        return "int8";
+                case ARCHIVE_FIELD_INT16:
+                        return "int16";
+                case ARCHIVE_FIELD_INT32:
+                        return "int32";
+                case ARCHIVE_FIELD_INT64:
+                        return "int64";
+                case ARCHIVE_FIELD_UINT8:
+                        return "uint8";
+                case ARCHIVE_FIELD_UINT16:
+                        return "uint16";
+                case ARCHIVE_FIELD_UINT32:
+                        return "uint32";
+                case ARCHIVE_FIELD_UINT64:
+                        return "uint64";
+                case ARCHIVE_FIELD_FLOAT:
+                        return "float32";
+                case ARCHIVE_FIELD_STRING:
+                        return "string64";
+                case ARCHIVE_FIELD_BOOLEAN:
+                        return "bool8";
+                case ARCHIVE_FIELD_NULL:
+                        return "void";
+                case ARCHIVE_FIELD_OBJECT:
+                        return "variable";
+                default:
+                        return "(unknown)";
+        }
+}
+
+#if !defined(LOG_TRACE) || defined(NDEBUG)
+#define TRACE(tag, msg, ...) { }
+#else
+#define TRACE(tag, msg, ...)                                                                                    \
+{                                                                                                                      \
+    char buffer[1024];                                                                                                 \
+    sprintf(buffer, "--%d-- [TRACE   : %-10s] %s\n", getpid(), tag, msg);                                              \
+    fprintf(stderr, buffer, __VA_ARGS__);                                                                              \
+    fflush(stderr);                                                                                                    \
+}
+#endif
+
+#if !defined(LOG_INFO) || defined(NDEBUG)
+#define INFO(tag, msg, ...) { }
+#else
+#define INFO(tag, msg, ...)                                                                                     \
+{                                                                                                                      \
+    char buffer[1024];                                                                                                 \
+    sprintf(buffer, "--%d-- [INFO    : %-10s] %s\n", getpid(), tag, msg);                                              \
+    fprintf(stderr, buffer, __VA_ARGS__);                                                                              \
+    fflush(stderr);                                                                                                    \
+}
+#endif
+
+#if !defined(LOG_DEBUG) || defined(NDEBUG)
+#define DEBUG(tag, msg, ...)                                                                                       \
+{ }
+#else
+#define DEBUG(tag, msg, ...)                                                                                    \
+{                                                                                                                      \
+    char buffer[1024];                                                                                                 \
+    sprintf(buffer, "--%d-- [DEBUG   : %-10s] %s\n", getpid(), tag, msg);                                              \
+    fprintf(stderr, buffer, __VA_ARGS__);                                                                              \
+    fflush(stderr);                                                                                                    \
+}
+#endif
+
+#if !defined(LOG_WARN) || defined(NDEBUG)
+#define WARN(tag, msg, ...) { }
+#else
+#define WARN(tag, msg, ...)                                                                                     \
+    {                                                                                                                  \
+        char buffer[1024];                                                                                             \
+        sprintf(buffer, "--%d-- [WARNING: %-10s] %s\n", getpid(), tag, msg);                                           \
+        fprintf(stderr, buffer, __VA_ARGS__);                                                                          \
+        fflush(stderr);                                                                                                \
+    }
+#endif
+
+#define CARBON_ARCHIVE_MAGIC                "MP/CARBON"
+#define CARBON_ARCHIVE_VERSION               1
+
+#define  MARKER_SYMBOL_OBJECT_BEGIN        '{'
+#define  MARKER_SYMBOL_OBJECT_END          '}'
+#define  MARKER_SYMBOL_PROP_NULL           'n'
+#define  MARKER_SYMBOL_PROP_BOOLEAN        'b'
+#define  MARKER_SYMBOL_PROP_INT8           'c'
+#define  MARKER_SYMBOL_PROP_INT16          's'
+#define  MARKER_SYMBOL_PROP_INT32          'i'
+#define  MARKER_SYMBOL_PROP_INT64          'l'
+#define  MARKER_SYMBOL_PROP_UINT8          'r'
+#define  MARKER_SYMBOL_PROP_UINT16         'h'
+#define  MARKER_SYMBOL_PROP_UINT32         'e'
+#define  MARKER_SYMBOL_PROP_UINT64         'g'
+#define  MARKER_SYMBOL_PROP_REAL           'f'
+#define  MARKER_SYMBOL_PROP_TEXT           't'
+#define  MARKER_SYMBOL_PROP_OBJECT         'o'
+#define  MARKER_SYMBOL_PROP_NULL_ARRAY     'N'
+#define  MARKER_SYMBOL_PROP_BOOLEAN_ARRAY  'B'
+#define  MARKER_SYMBOL_PROP_INT8_ARRAY     'C'
+#define  MARKER_SYMBOL_PROP_INT16_ARRAY    'S'
+#define  MARKER_SYMBOL_PROP_INT32_ARRAY    'I'
+#define  MARKER_SYMBOL_PROP_INT64_ARRAY    'L'
+#define  MARKER_SYMBOL_PROP_UINT8_ARRAY    'R'
+#define  MARKER_SYMBOL_PROP_UINT16_ARRAY   'H'
+#define  MARKER_SYMBOL_PROP_UINT32_ARRAY   'E'
+#define  MARKER_SYMBOL_PROP_UINT64_ARRAY   'G'
+#define  MARKER_SYMBOL_PROP_REAL_ARRAY     'F'
+#define  MARKER_SYMBOL_PROP_TEXT_ARRAY     'T'
+#define  MARKER_SYMBOL_PROP_OBJECT_ARRAY   'O'
+#define  MARKER_SYMBOL_EMBEDDED_STR_DIC    'D'
+#define  MARKER_SYMBOL_EMBEDDED_STR        '-'
+#define  MARKER_SYMBOL_COLUMN_GROUP        'X'
+#define  MARKER_SYMBOL_COLUMN              'x'
+#define  MARKER_SYMBOL_HUFFMAN_DIC_ENTRY   'd'
+#define  MARKER_SYMBOL_RECORD_HEADER       'r'
+#define  MARKER_SYMBOL_HASHTABLE_HEADER    '#'
+#define  MARKER_SYMBOL_VEC_HEADER       '|'
+
+#define DECLARE_AND_INIT(type, name)                                                                               \
+        type name;                                                                                                     \
+        ZERO_MEMORY(&name, sizeof(type));
+
+#define ZERO_MEMORY(dst, len)                                                                                      \
+    memset((char *) (dst), 0, (len));
+
+#define CAST(type, name, src)                                                                                      \
+      type name = (type) src
+
+#define UNUSED(x)   (void)(x);
+
+#define BUILT_IN(x)   MAYBE_UNUSED x
+
+#define ofType(x) /** a convenience way to write types for generic containers; no effect than just a visual one */
+#define ofMapping(x, y) /** a convenience way to write types for generic containers; no effect than just a visual one */
+
+#define OPTIONAL_CALL(x, func, ...) if((x) && (x)->func) { (x)->func(__VA_ARGS__); }
+
+#define JAK_MAX(a, b)                                                                                                  \
+    ((b) > (a) ? (b) : (a))
+
+#define JAK_MIN(a, b)                                                                                                  \
+    ((a) < (b) ? (a) : (b))
+
+#define CHECK_SUCCESS(x)                                                                                           \
+{                                                                                                                      \
+    if (UNLIKELY(!x)) {                                                                                                \
+        return x;                                                                                                      \
+    }                                                                                                                  \
+}
+
+#define SUCCESS_OR_JUMP(expr, label)                                                                               \
+{                                                                                                                      \
+    if (UNLIKELY(!expr)) {                                                                                             \
+        goto label;                                                                                                    \
+    }                                                                                                                  \
+}
+
+#define LIKELY(x)                                                                                                      \
+    __builtin_expect((x), 1)
+#define UNLIKELY(x)                                                                                                    \
+    __builtin_expect((x), 0)
+
+#define PREFETCH_READ(adr)                                                                                             \
+    __builtin_prefetch(adr, 0, 3)
+
+#define PREFETCH_WRITE(adr)                                                                                            \
+    __builtin_prefetch(adr, 1, 3)
+
+#define FORWARD_STRUCT_DECL(x) struct x;
+
+#define BIT_NUM_OF(x)             (sizeof(x) * 8)
+#define SET_BIT(n)                ( ((u32) 1) << (n) )
+#define SET_BITS(x, mask)         ( x |=  (mask) )
+#define UNSET_BITS(x, mask)       ( x &= ~(mask) )
+#define ARE_BITS_SET(mask, bit)   (((bit) & mask ) == (bit))
+
+#define ERROR_IF_NOT_IMPLEMENTED(err, x, func)                                                                         \
+    OPTIONAL(x->func == NULL, ERROR(ERR_NOTIMPLEMENTED, NULL))
+
+#define OPTIONAL(expr, stmt)                                                                                       \
+    if (expr) { stmt; }
+
+#define OPTIONAL_SET(x, y)                                                                                         \
+     OPTIONAL(x, *x = y)
+
+#define OPTIONAL_SET_OR_ELSE(x, y, stmt)                                                                           \
+    if (x) {                                                                                                           \
+        *x = y;                                                                                                        \
+    } else { stmt; }
+
+bool global_console_enable_output;
+
+#define CONSOLE_OUTPUT_ON()                                                                                        \
+    global_console_enable_output = true;
+
+#define CONSOLE_OUTPUT_OFF()                                                                                       \
+    global_console_enable_output = false;
+
+#define CONSOLE_WRITE(file, msg, ...)                                                                              \
+{                                                                                                                      \
+    if (global_console_enable_output) {                                                                                   \
+        pid_t pid = getpid();                                                                                          \
+        char timeBuffer[2048];                                                                                         \
+        char formatBuffer[2048];                                                                                       \
+        time_t now = time (0);                                                                                         \
+        fflush(file);                                                                                                  \
+        strftime (timeBuffer, 2048, "%Y-%m-%d %H:%M:%S", localtime (&now));                                            \
+        sprintf (formatBuffer, msg, __VA_ARGS__);                                                                      \
+        fprintf(file, "[%d] %s   %-70s", pid, timeBuffer, formatBuffer);                                               \
+        fflush(file);                                                                                                  \
+    }                                                                                                                  \
+}
+
+#define CONSOLE_WRITE_ENDL(file)                                                                                   \
+{                                                                                                                      \
+    if (global_console_enable_output) {                                                                                   \
+        fprintf(file, "\n");                                                                                           \
+    }                                                                                                                  \
+}
+
+#define CONSOLE_WRITE_CONT(file, msg, ...)                                                                         \
+{                                                                                                                      \
+    if (global_console_enable_output) {                                                                                   \
+        fprintf(file, msg, __VA_ARGS__);                                                                               \
+    }                                                                                                                  \
+}
+
+#define CONSOLE_WRITELN(file, msg, ...)                                                                            \
+{                                                                                                                      \
+    if (global_console_enable_output) {                                                                                   \
+        CONSOLE_WRITE(file, msg, __VA_ARGS__)                                                                      \
+        CONSOLE_WRITE_ENDL(file)                                                                                   \
+        fflush(file);                                                                                                  \
+    }                                                                                                                  \
+}
+
+#endif
+/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef SLICELIST_H
+#define SLICELIST_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/std/vec.h>
+#include <karbonit/std/bitmap.h>
+#include <karbonit/std/spinlock.h>
+#include <karbonit/std/bloom.h>
+#include <karbonit/std/hash.h>
+#include <karbonit/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+FORWARD_STRUCT_DECL(slice)
+
+#ifndef SLICE_LIST_BLOOMFILTER_TARGET_MEMORY_NAME
+#define SLICE_LIST_BLOOMFILTER_TARGET_MEMORY_NAME "1 of 100 in CPU L1"
+#endif
+#ifndef SLICE_LIST_BLOOMFILTER_TARGET_MEMORY_SIZE_IN_BYTE
+#define SLICE_LIST_BLOOMFILTER_TARGET_MEMORY_SIZE_IN_BYTE (32768/100)
+#endif
+
+#ifndef SLICE_LIST_TARGET_MEMORY_NAME
+#define SLICE_LIST_TARGET_MEMORY_NAME "10 of 100 in CPU L1"
+#endif
+#ifndef SLICE_LIST_TARGET_MEMORY_SIZE_IN_BYTE
+#define SLICE_LIST_TARGET_MEMORY_SIZE_IN_BYTE (32768/10)
+#endif
+
+#define SLICE_DATA_SIZE (SLICE_LIST_TARGET_MEMORY_SIZE_IN_BYTE - sizeof(slice_lookup_strat_e) - sizeof(u32))
+
+#define SLICE_KEY_COLUMN_MAX_ELEMS (SLICE_DATA_SIZE / 8 / 3) /** one array with elements of 64 bits each, 3 of them */
+
+typedef enum slice_lookup_strat_e {
+        SLICE_LOOKUP_SCAN, SLICE_LOOKUP_BESEARCH,
+} slice_lookup_strat_e;
+
+typedef struct slice {
+        /** Enumeration to determine which strategy for 'find' is currently applied */
+        slice_lookup_strat_e strat;
+
+        /** Data stored inside this slice. By setting 'SLICE_LIST_CPU_L3_SIZE_IN_BYTE' statically to the target
+         * CPU L3 size, it is intended that one entire 'slice_t' structure fits into the L3 cache of the CPU.
+         * It is assumed that at least one element can be inserted into a 'slice_t' object (which means that
+         * the type of elements to be inserted must be less or equal to SLICE_DATA_SIZE. In case an element is
+         * removed from this list, data is physically moved to avoid a "sparse" list, i.e., it is alwalys
+         * guaranteeed that 'data' contains continously elements without any gabs until 'num_elems' limit. This
+         * avoids to lookup in a struct bitmap or other structure whether a particular element is removed or not; also
+         * this does not steal an element from the domain of the used data type to encode 'not present' with a
+         * particular values. However, a remove operation is expensive. */
+        const char *key_column[SLICE_KEY_COLUMN_MAX_ELEMS];
+        hash32_t key_hash_column[SLICE_KEY_COLUMN_MAX_ELEMS];
+        archive_field_sid_t string_id_column[SLICE_KEY_COLUMN_MAX_ELEMS];
+
+        /** The number of elements stored in 'key_colum', 'key_hash_column', and 'string_id_column' */
+        u32 num_elems;
+
+        u32 cache_idx;
+} slice;
+
+typedef struct hash_bounds {
+        /** Min and max values inside this slice. Used to skip the lookup in the per-slice bitmap during search */
+        hash32_t min_hash, max_hash;
+} hash_bounds;
+
+typedef struct slice_descriptor {
+        /** The number of reads to this slice including misses and hits. Along with 'num_reads_hit' used to determine
+         * the order of this element w.r.t. to other elements in the list */
+        size_t num_reads_all;
+
+        /** The number of reads to this slice that lead to a search hit. See 'num_reads_all' for the purpose. */
+        size_t num_reads_hit;
+
+} slice_descriptor;
+
+typedef struct slice_list {
+        spinlock lock;
+
+        vec ofType(slice) slices;
+        vec ofType(slice_descriptor) descriptors;
+        vec ofType(bloomfilter) filters;
+        vec ofType(hash_bounds) bounds;
+
+        u32 appender_idx;
+} slice_list_t;
+
+typedef struct slice_handle {
+        slice *container;
+        const char *key;
+        archive_field_sid_t value;
+        bool is_contained;
+} slice_handle;
+
+bool slice_list_create(slice_list_t *list, size_t slice_capacity);
+bool slice_list_drop(slice_list_t *list);
+bool slice_list_lookup(slice_handle *handle, slice_list_t *list, const char *needle);
+bool slice_list_is_empty(const slice_list_t *list);
+bool slice_list_insert(slice_list_t *list, char **strings, archive_field_sid_t *ids, size_t npairs);
+bool slice_list_remove(slice_list_t *list, slice_handle *handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef UNIQUE_ID_H
+#define UNIQUE_ID_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef u64 unique_id_t;
+
+bool unique_id_create(unique_id_t *out);
+
+bool unique_id_get_global_wallclocktime(uint_fast8_t *out, unique_id_t id);
+bool unique_id_get_global_build_path_bit(uint_fast8_t *out, unique_id_t id);
+bool unique_id_get_global_build_time_bit(uint_fast8_t *out, unique_id_t id);
+bool unique_id_get_process_id(uint_fast8_t *out, unique_id_t id);
+bool unique_id_get_process_magic(uint_fast8_t *out, unique_id_t id);
+bool unique_id_get_process_counter(uint_fast16_t *out, unique_id_t id);
+bool unique_id_get_thread_id(uint_fast8_t *out, unique_id_t id);
+bool unique_id_get_thread_magic(uint_fast8_t *out, unique_id_t id);
+bool unique_id_get_thread_counter(uint_fast32_t *out, unique_id_t id);
+bool unique_id_get_call_random(uint_fast8_t *out, unique_id_t id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef TYPES_H
+#define TYPES_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int8_t i8;
+typedef int16_t i16;
+typedef int32_t i32;
+typedef int64_t i64;
+typedef u8 boolean;
+
+#define U8_NULL         UINT8_MAX
+#define U16_NULL        UINT16_MAX
+#define U32_NULL        UINT32_MAX
+#define U64_NULL        UINT64_MAX
+#define I8_NULL         INT8_MIN
+#define I16_NULL        INT16_MIN
+#define I32_NULL        INT32_MIN
+#define I64_NULL        INT64_MIN
+
+#define CARBON_NULL_FLOAT        NAN
+#define CARBON_NULL_UNSIGNED     U64_NULL
+#define CARBON_NULL_SIGNED       I64_NULL
+
+#define CARBON_U8_MIN    UINT8_MIN
+#define CARBON_U16_MIN   UINT16_MIN
+#define CARBON_U32_MIN   UINT32_MIN
+#define CARBON_U64_MIN   UINT64_MIN
+#define CARBON_I8_MIN    (INT8_MIN + 1)
+#define CARBON_I16_MIN   (INT16_MIN + 1)
+#define CARBON_I32_MIN   (INT32_MIN + 1)
+#define CARBON_I64_MIN   (INT64_MIN + 1)
+#define CARBON_U8_MAX    (U8_NULL - 1)
+#define CARBON_U16_MAX   (U16_NULL - 1)
+#define CARBON_U32_MAX   (U32_NULL - 1)
+#define CARBON_U64_MAX   (U64_NULL - 1)
+#define CARBON_I8_MAX    INT8_MAX
+#define CARBON_I16_MAX   INT16_MAX
+#define CARBON_I32_MAX   INT32_MAX
+#define CARBON_I64_MAX   INT64_MAX
+
+#define CARBON_BOOLEAN_COLUMN_FALSE     0
+#define CARBON_BOOLEAN_COLUMN_TRUE      1
+#define CARBON_BOOLEAN_COLUMN_NULL      2
+
+#define IS_NULL_BOOLEAN(x)      ((x) == CARBON_BOOLEAN_COLUMN_NULL)
+#define IS_NULL_U8(x)           ((x) == U8_NULL)
+#define IS_NULL_U16(x)          ((x) == U16_NULL)
+#define IS_NULL_U32(x)          ((x) == U32_NULL)
+#define IS_NULL_U64(x)          ((x) == U64_NULL)
+#define IS_NULL_I8(x)           ((x) == I8_NULL)
+#define IS_NULL_I16(x)          ((x) == I16_NULL)
+#define IS_NULL_I32(x)          ((x) == I32_NULL)
+#define IS_NULL_I64(x)          ((x) == I64_NULL)
+#define IS_NULL_FLOAT(x)        (isnan((x)))
+#define IS_NULL_UNSIGNED(x)     ((x) == CARBON_NULL_UNSIGNED)
+#define IS_NULL_SIGNED(x)       ((x) == CARBON_NULL_SIGNED)
+
+typedef u64 archive_field_sid_t;  /** str_buf identifier, resolvable by a str_buf dictionary */
+typedef char field_null_t;
+typedef i8 archive_field_boolean_t;
+typedef i8 archive_field_i8_t;
+typedef i16 archive_field_i16_t;
+typedef i32 archive_field_i32_t;
+typedef i64 archive_field_i64_t;
+typedef u8 archive_field_u8_t;
+typedef u16 archive_field_u16_t;
+typedef u32 archive_field_u32_t;
+typedef u64 archive_field_u64_t;
+typedef float archive_field_number_t;
+typedef const char *field_string_t;
+
+#define NULL_ENCODED_STRING            0
+#define NULL_BOOLEAN                   INT8_MAX
+#define NULL_INT8                      INT8_MAX
+#define NULL_INT16                     INT16_MAX
+#define NULL_INT32                     INT32_MAX
+#define NULL_INT64                     INT64_MAX
+#define NULL_UINT8                     UINT8_MAX
+#define NULL_UINT16                    UINT16_MAX
+#define NULL_UINT32                    UINT32_MAX
+#define NULL_UINT64                    UINT64_MAX
+#define NULL_FLOAT                     NAN
+#define NULL_OBJECT_MODEL(objectModel) (objectModel->entries.num_elems == 0)
+
+#define IS_NULL_STRING(str)   (str == NULL_ENCODED_STRING)
+#define IS_NULL_BOOL(val)     (val == NULL_BOOLEAN)
+#define IS_NULL_INT8(val)     (val == NULL_INT8)
+#define IS_NULL_INT16(val)    (val == NULL_INT16)
+#define IS_NULL_INT32(val)    (val == NULL_INT32)
+#define IS_NULL_INT64(val)    (val == NULL_INT64)
+#define IS_NULL_UINT8(val)    (val == NULL_UINT8)
+#define IS_NULL_UINT16(val)   (val == NULL_UINT16)
+#define IS_NULL_UINT32(val)   (val == NULL_UINT32)
+#define IS_NULL_UINT64(val)   (val == NULL_UINT64)
+#define IS_NULL_NUMBER(val)   (val == NULL_FLOAT)
+
+#define LIMITS_INT8_MAX                (NULL_INT8 - 1)
+#define LIMITS_INT16_MAX               (NULL_INT16 - 1)
+#define LIMITS_INT32_MAX               (NULL_INT32 - 1)
+#define LIMITS_INT64_MAX               (NULL_INT64 - 1)
+#define LIMITS_UINT8_MAX               (NULL_UINT8 - 1)
+#define LIMITS_UINT16_MAX              (NULL_UINT16 - 1)
+#define LIMITS_UINT32_MAX              (NULL_UINT32 - 1)
+#define LIMITS_UINT64_MAX              (NULL_UINT64 - 1)
+
+#define LIMITS_INT8_MIN                INT8_MIN
+#define LIMITS_INT16_MIN               INT16_MIN
+#define LIMITS_INT32_MIN               INT32_MIN
+#define LIMITS_INT64_MIN               INT64_MIN
+#define LIMITS_UINT8_MIN               0
+#define LIMITS_UINT16_MIN              0
+#define LIMITS_UINT32_MIN              0
+#define LIMITS_UINT64_MIN              0
+
+#define NULL_TEXT "null"
+
+#define BOOLEAN_FALSE 0
+#define BOOLEAN_TRUE  1
+
+#define GET_TYPE_SIZE(value_type)                                                                                      \
+({                                                                                                                     \
+    size_t value_size;                                                                                                 \
+    switch (value_type) {                                                                                              \
+        case ARCHIVE_FIELD_NULL:                                                                                           \
+            value_size = sizeof(u16);                                                                              \
+            break;                                                                                                     \
+        case ARCHIVE_FIELD_BOOLEAN:                                                                                        \
+            value_size = sizeof(archive_field_boolean_t);                                                          \
+            break;                                                                                                     \
+        case ARCHIVE_FIELD_INT8:                                                                                           \
+            value_size = sizeof(archive_field_i8_t);                                                               \
+            break;                                                                                                     \
+        case ARCHIVE_FIELD_INT16:                                                                                          \
+            value_size = sizeof(archive_field_i16_t);                                                              \
+            break;                                                                                                     \
+        case ARCHIVE_FIELD_INT32:                                                                                          \
+            value_size = sizeof(archive_field_i32_t);                                                              \
+            break;                                                                                                     \
+        case ARCHIVE_FIELD_INT64:                                                                                          \
+            value_size = sizeof(archive_field_i64_t);                                                              \
+            break;                                                                                                     \
+        case ARCHIVE_FIELD_UINT8:                                                                                          \
+            value_size = sizeof(archive_field_u8_t);                                                               \
+            break;                                                                                                     \
+        case ARCHIVE_FIELD_UINT16:                                                                                         \
+            value_size = sizeof(archive_field_u16_t);                                                              \
+            break;                                                                                                     \
+        case ARCHIVE_FIELD_UINT32:                                                                                         \
+            value_size = sizeof(archive_field_u32_t);                                                              \
+            break;                                                                                                     \
+        case ARCHIVE_FIELD_UINT64:                                                                                         \
+            value_size = sizeof(archive_field_u64_t);                                                              \
+            break;                                                                                                     \
+        case ARCHIVE_FIELD_FLOAT:                                                                                          \
+            value_size = sizeof(archive_field_number_t);                                                           \
+            break;                                                                                                     \
+        case ARCHIVE_FIELD_STRING:                                                                                         \
+            value_size = sizeof(archive_field_sid_t);                                                              \
+            break;                                                                                                     \
+        case ARCHIVE_FIELD_OBJECT:                                                                                         \
+            value_size = sizeof(column_doc_obj);                                                                   \
+            break;                                                                                                     \
+        default:  {                                                                                                     \
+            ERROR(ERR_NOTYPE, NULL);                                                                                \
+            value_size = 0;                                                                                         \
+            }                                                                                                       \
+    }                                                                                                                  \
+    value_size;                                                                                                        \
+})
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef CONVERT_H
+#define CONVERT_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+i64 convert_atoi64(const char *string);
+u64 convert_atoiu64(const char *string);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif/**
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef AKR_NUMBERS_H
+#define AKR_NUMBERS_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/types.h>
+
+typedef enum number_min_type_e {
+        NUMBER_U8,
+        NUMBER_U16,
+        NUMBER_U32,
+        NUMBER_U64,
+        NUMBER_I8,
+        NUMBER_I16,
+        NUMBER_I32,
+        NUMBER_I64,
+        NUMBER_UNKNOWN
+} number_min_type_e;
+
+number_min_type_e number_min_type_unsigned(u64 value);
+number_min_type_e number_min_type_signed(i64 value);
+
+#endif
+/**
+ * Copyright 2019 Marcus Pinnecke, Robert Jendersie, Johannes Wuensche, Johann Wagner, and Marten Wallewein-Eising
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without ion, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PRIORITY_QUEUE_H
+#define PRIORITY_QUEUE_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct priority_queue_element_info {
+        size_t priority;
+        void *element;
+} priority_queue_element_info;
+
+typedef struct priority_queue {
+        priority_queue_element_info *data;
+        size_t num_elements;
+        size_t capacity;
+        pthread_mutex_t mutex;
+} priority_queue;
+
+void priority_queue_init(priority_queue *queue);
+void priority_queue_free(priority_queue *queue);
+void priority_queue_push(priority_queue *queue, void *data, size_t priority);
+void *priority_queue_pop(priority_queue *queue);
+int priority_queue_is_empty(priority_queue *queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef SORT_H
+#define SORT_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef bool (*less_eq_func_t)(const void *lhs, const void *rhs);
+
+typedef bool (*less_eq_wargs_func_t)(const void *lhs, const void *rhs, void *args);
+
+typedef bool (*eq_func_t)(const void *lhs, const void *rhs);
+
+typedef bool (*less_func_t)(const void *lhs, const void *rhs);
+
+#define QSORT_INDICES_SWAP(x, y)                                                                                   \
+{                                                                                                                      \
+    size_t *a = x;                                                                                                     \
+    size_t *b = y;                                                                                                     \
+    size_t tmp = *a;                                                                                                   \
+    *a = *b;                                                                                                           \
+    *b = tmp;                                                                                                          \
+}
+
+#define QSORT_INDICIES_PARTITION(indices, base, width, comp, l, h)                                                 \
+({                                                                                                                     \
+    const void   *x       = base + indices[h] * width;                                                                 \
+    i64        i       = (l - 1);                                                                                  \
+                                                                                                                       \
+    for (i64 j = l; j <= h - 1; j++)                                                                               \
+    {                                                                                                                  \
+        if (comp(base + indices[j] * width, x))                                                                        \
+        {                                                                                                              \
+            i++;                                                                                                       \
+            QSORT_INDICES_SWAP (indices + i, indices + j);                                                         \
+        }                                                                                                              \
+    }                                                                                                                  \
+    QSORT_INDICES_SWAP (indices + (i + 1), indices + h);                                                           \
+    (i + 1);                                                                                                           \
+})
+
+#define QSORT_INDICIES_PARTITION_WARGS(indices, base, width, comp, l, h, args)                                     \
+({                                                                                                                     \
+    const void   *x       = base + indices[h] * width;                                                                 \
+    i64        i       = (l - 1);                                                                                  \
+                                                                                                                       \
+    for (i64 j = l; j <= h - 1; j++)                                                                               \
+    {                                                                                                                  \
+        if (comp(base + indices[j] * width, x, args))                                                                  \
+        {                                                                                                              \
+            i++;                                                                                                       \
+            QSORT_INDICES_SWAP (indices + i, indices + j);                                                         \
+        }                                                                                                              \
+    }                                                                                                                  \
+    QSORT_INDICES_SWAP (indices + (i + 1), indices + h);                                                           \
+    (i + 1);                                                                                                           \
+})
+
+bool sort_qsort_indicies(size_t *indices, const void *base, size_t width, less_eq_func_t comp, size_t nelemns);
+int sort_qsort_indicies_wargs(size_t *indices, const void *base, size_t width, less_eq_wargs_func_t comp, size_t nelemens, void *args);
+size_t sort_bsearch_indicies(const size_t *indicies, const void *base, size_t width, size_t nelemens, const void *neelde, eq_func_t compEq, less_func_t compLess);
+
+size_t sort_get_min(const size_t *elements, size_t nelemens);
+size_t sort_get_max(const size_t *elements, size_t nelemens);
+double sort_get_sum(const size_t *elements, size_t nelemens);
+double sort_get_avg(const size_t *elements, size_t nelemens);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef STRING_UTILS_H
+#define STRING_UTILS_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool strings_contains_blank_char(const char *str);
+bool strings_is_enquoted(const char *str);
+bool strings_is_enquoted_wlen(const char *str, size_t len);
+const char *strings_skip_blanks(const char *str);
+char *strings_remove_tailing_blanks(char *str_in);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef TIME_H
+#define TIME_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef u64 timestamp;
+
+timestamp wallclock();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
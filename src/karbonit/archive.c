@@ -34,9 +34,13 @@
 #include <karbonit/stdinc.h>
 #include <karbonit/mem/memblock.h>
 #include <karbonit/mem/memfile.h>
+#include <karbonit/mem/alloc.h>
 #include <karbonit/archive/huffman.h>
 #include <karbonit/archive.h>
 
+/* chunk size of the arena for the JSON AST in archive_stream_from_json */
+#define ARCHIVE_JSON_ARENA_CHUNK_SIZE (256 * 1024)
+
 #define WRITE_PRIMITIVE_VALUES(memfile, values_vec, type)                                                              \
 {                                                                                                                      \
     type *values = VEC_ALL(values_vec, type);                                                                \
@@ -218,6 +222,7 @@ bool archive_stream_from_json(memblock **stream, const char *json_string,
         doc_entries *partition;
         column_doc *columndoc;
         json json;
+        allocator arena;
 
         OPTIONAL_CALL(callback, begin_archive_stream_from_json)
 
@@ -233,7 +238,9 @@ bool archive_stream_from_json(memblock **stream, const char *json_string,
         OPTIONAL_CALL(callback, end_setup_string_dict_ionary);
 
         OPTIONAL_CALL(callback, begin_parse_json);
-        if (!(json_parse(&json, &error_desc, &parser, json_string))) {
+        /* the AST is dropped as a whole after its import into the document bulk */
+        alloc_create_arena(&arena, ARCHIVE_JSON_ARENA_CHUNK_SIZE);
+        if (!(json_parse_with(&json, &error_desc, &parser, json_string, &arena))) {
                 char buffer[2048];
                 if (error_desc.token) {
                         sprintf(buffer,
@@ -247,12 +254,14 @@ bool archive_stream_from_json(memblock **stream, const char *json_string,
                         sprintf(buffer, "%s", error_desc.msg);
                         ERROR(ERR_JSONPARSEERR, &buffer[0]);
                 }
+                alloc_drop(&arena);
                 return false;
         }
         OPTIONAL_CALL(callback, end_parse_json);
 
         OPTIONAL_CALL(callback, begin_test_json);
         if (!json_test(&json)) {
+                alloc_drop(&arena);
                 return false;
         }
         OPTIONAL_CALL(callback, end_test_json);
@@ -260,13 +269,14 @@ bool archive_stream_from_json(memblock **stream, const char *json_string,
         OPTIONAL_CALL(callback, begin_import_json);
         if (!doc_bulk_create(&bulk, &dic)) {
                 ERROR(ERR_BULKCREATEFAILED, NULL);
+                alloc_drop(&arena);
                 return false;
         }
 
         partition = doc_bulk_new_entries(&bulk);
         doc_bulk_add_json(partition, &json);
 
-        json_drop(&json);
+        alloc_drop(&arena);
 
         doc_bulk_shrink(&bulk);
 
@@ -2521,7 +2531,8 @@ static bool read_record(record_header *header_read, archive *archive, FILE *disk
                 return false;
         } else {
                 archive->record_table.flags.value = header.flags;
-                bool status = MEMBLOCK_FROM_FILE(&archive->record_table.record_db, disk_file, header.record_size);
+                bool status = MEMBLOCK_FROM_FILE_MAPPED(&archive->record_table.record_db, disk_file,
+                                                        header.record_size, MADV_RANDOM);
                 if (!status) {
                         return false;
                 }
@@ -84,6 +84,22 @@ bool coding_huffman_drop(huffman *dic)
         return true;
 }
 
+/* writes the bits of the block from its most significant set bit down to bit 0 */
+static void huff_write_block(memfile_bits *stream, u32 block)
+{
+        if (block != 0) {
+                u32 nbits = 32 - __builtin_clz(block);
+                /* the stream is filled least significant bit first, so the code is reversed */
+                u32 code = block;
+                code = ((code >> 1) & 0x55555555) | ((code & 0x55555555) << 1);
+                code = ((code >> 2) & 0x33333333) | ((code & 0x33333333) << 2);
+                code = ((code >> 4) & 0x0F0F0F0F) | ((code & 0x0F0F0F0F) << 4);
+                code = ((code >> 8) & 0x00FF00FF) | ((code & 0x00FF00FF) << 8);
+                code = (code >> 16) | (code << 16);
+                memfile_bits_write(stream, code >> (32 - nbits), nbits);
+        }
+}
+
 bool coding_huffman_serialize(memfile *file, const huffman *dic, char marker_symbol)
 {
         for (size_t i = 0; i < dic->table.num_elems; i++) {
@@ -97,20 +113,13 @@ bool coding_huffman_serialize(memfile *file, const huffman *dic, char marker_sym
                 /** this will be the number of bytes used to encode the significant part of the prefix code */
                 MEMFILE_SKIP(file, sizeof(u8));
 
-                MEMFILE_BEGIN_BIT_MODE(file);
-                bool first_bit_found = false;
-                for (int i = 31; entry->blocks && i >= 0; i--) {
-                        u32 mask = 1 << i;
-                        u32 k = entry->blocks[0] & mask;
-                        bool bit_state = k != 0;
-                        first_bit_found |= bit_state;
-
-                        if (first_bit_found) {
-                                memfile_write_bit(file, bit_state);
-                        }
+                memfile_bits stream;
+                memfile_bits_begin_write(&stream, file);
+                if (entry->blocks) {
+                        huff_write_block(&stream, entry->blocks[0]);
                 }
                 size_t num_bytes_written;
-                MEMFILE_END_BIT_MODE(&num_bytes_written, file);
+                memfile_bits_end_write(&num_bytes_written, &stream);
                 MEMFILE_GET_OFFSET(&offset_continue, file);
                 MEMFILE_SEEK(file, offset_meta);
                 u8 num_bytes_written_uint8 = (u8) num_bytes_written;
@@ -122,51 +131,36 @@ bool coding_huffman_serialize(memfile *file, const huffman *dic, char marker_sym
         return true;
 }
 
-static pack_huffman_entry *find_dic_entry(huffman *dic, unsigned char c)
+static size_t encodeString(memfile *file, huffman *dic, const char *string)
 {
-        for (size_t i = 0; i < dic->table.num_elems; i++) {
-                pack_huffman_entry *entry = VEC_GET(&dic->table, i, pack_huffman_entry);
-                if (entry->letter == c) {
-                        return entry;
-                }
+        /* entries by letter; the first entry for a letter wins */
+        const pack_huffman_entry *entries[UCHAR_MAX + 1] = { NULL };
+        for (size_t i = dic->table.num_elems; i > 0; i--) {
+                const pack_huffman_entry *entry = VEC_GET(&dic->table, i - 1, pack_huffman_entry);
+                entries[entry->letter] = entry;
         }
-        ERROR(ERR_HUFFERR, NULL);
-        return NULL;
-}
 
-static size_t encodeString(memfile *file, huffman *dic, const char *string)
-{
-        MEMFILE_BEGIN_BIT_MODE(file);
+        memfile_bits stream;
+        memfile_bits_begin_write(&stream, file);
 
         for (const char *c = string; *c != '\0'; c++) {
-                pack_huffman_entry *entry = find_dic_entry(dic, (unsigned char) *c);
+                const pack_huffman_entry *entry = entries[(unsigned char) *c];
                 if (!entry) {
+                        ERROR(ERR_HUFFERR, NULL);
                         return 0;
                 }
 
                 if (!entry->blocks) {
-                        memfile_write_bit(file, false);
+                        memfile_bits_write(&stream, 0, 1);
                 } else {
                         for (size_t j = 0; j < entry->nblocks; j++) {
-                                u32 block = entry->blocks[j];
-
-                                bool first_bit_found = false;
-                                for (int i = 31; i >= 0; i--) {
-                                        u32 mask = 1 << i;
-                                        u32 k = block & mask;
-                                        bool bit_state = k != 0;
-                                        first_bit_found |= bit_state;
-
-                                        if (first_bit_found) {
-                                                memfile_write_bit(file, bit_state);
-                                        }
-                                }
+                                huff_write_block(&stream, entry->blocks[j]);
                         }
                 }
         }
 
         size_t num_written_bytes;
-        MEMFILE_END_BIT_MODE(&num_written_bytes, file);
+        memfile_bits_end_write(&num_written_bytes, &stream);
         return num_written_bytes;
 }
 
@@ -430,6 +430,185 @@ bool col_it_is_sorted(col_it *it)
         return abstract_is_sorted(type_class);
 }
 
+/* three-way comparison of two column values, for which null values are greater than all other values */
+#define COL_IT_VALUE_CMP(lhs, rhs, is_null)                                                                            \
+        (is_null(lhs) ? !is_null(rhs) : (is_null(rhs) ? -1 : ((lhs) > (rhs)) - ((lhs) < (rhs))))
+
+#define COL_IT_DEFINE_CMP(name, type, is_null)                                                                         \
+static int col_it_cmp_##name(const void *lhs, const void *rhs)                                                         \
+{                                                                                                                      \
+        type a = *(const type *) lhs, b = *(const type *) rhs;                                                         \
+        return COL_IT_VALUE_CMP(a, b, is_null);                                                                        \
+}
+
+COL_IT_DEFINE_CMP(boolean, u8, IS_NULL_BOOLEAN)
+COL_IT_DEFINE_CMP(u8, u8, IS_NULL_U8)
+COL_IT_DEFINE_CMP(u16, u16, IS_NULL_U16)
+COL_IT_DEFINE_CMP(u32, u32, IS_NULL_U32)
+COL_IT_DEFINE_CMP(u64, u64, IS_NULL_U64)
+COL_IT_DEFINE_CMP(i8, i8, IS_NULL_I8)
+COL_IT_DEFINE_CMP(i16, i16, IS_NULL_I16)
+COL_IT_DEFINE_CMP(i32, i32, IS_NULL_I32)
+COL_IT_DEFINE_CMP(i64, i64, IS_NULL_I64)
+COL_IT_DEFINE_CMP(float, float, IS_NULL_FLOAT)
+
+typedef int (*col_it_cmp_fn)(const void *lhs, const void *rhs);
+
+static col_it_cmp_fn col_it_cmp_for(field_e type)
+{
+        if (FIELD_IS_COLUMN_BOOL_OR_SUBTYPE(type)) {
+                return col_it_cmp_boolean;
+        } else if (FIELD_IS_COLUMN_U8_OR_SUBTYPE(type)) {
+                return col_it_cmp_u8;
+        } else if (FIELD_IS_COLUMN_U16_OR_SUBTYPE(type)) {
+                return col_it_cmp_u16;
+        } else if (FIELD_IS_COLUMN_U32_OR_SUBTYPE(type)) {
+                return col_it_cmp_u32;
+        } else if (FIELD_IS_COLUMN_U64_OR_SUBTYPE(type)) {
+                return col_it_cmp_u64;
+        } else if (FIELD_IS_COLUMN_I8_OR_SUBTYPE(type)) {
+                return col_it_cmp_i8;
+        } else if (FIELD_IS_COLUMN_I16_OR_SUBTYPE(type)) {
+                return col_it_cmp_i16;
+        } else if (FIELD_IS_COLUMN_I32_OR_SUBTYPE(type)) {
+                return col_it_cmp_i32;
+        } else if (FIELD_IS_COLUMN_I64_OR_SUBTYPE(type)) {
+                return col_it_cmp_i64;
+        } else {
+                assert(FIELD_IS_COLUMN_FLOAT_OR_SUBTYPE(type));
+                return col_it_cmp_float;
+        }
+}
+
+int internal_col_it_value_cmp(field_e type, const void *lhs, const void *rhs)
+{
+        return col_it_cmp_for(type)(lhs, rhs);
+}
+
+u32 internal_col_it_bound(field_e type, const void *values, u32 num_values, const void *value, bool upper)
+{
+        col_it_cmp_fn cmp = col_it_cmp_for(type);
+        size_t value_size = INTERNAL_GET_TYPE_VALUE_SIZE(type);
+        u32 lo = 0, hi = num_values;
+        while (lo < hi) {
+                u32 mid = lo + (hi - lo) / 2;
+                int result = cmp((const char *) values + mid * value_size, value);
+                if (result < 0 || (upper && result == 0)) {
+                        lo = mid + 1;
+                } else {
+                        hi = mid;
+                }
+        }
+        return lo;
+}
+
+bool col_it_find(u32 *pos, col_it *it, const void *value)
+{
+        u32 num_values;
+        MEMFILE_SAVE_POSITION(&it->file);
+        const char *values = COL_IT_VALUES(NULL, &num_values, it);
+        MEMFILE_RESTORE_POSITION(&it->file);
+
+        col_it_cmp_fn cmp = col_it_cmp_for(it->field_type);
+        size_t value_size = INTERNAL_GET_TYPE_VALUE_SIZE(it->field_type);
+        u32 result = 0;
+        if (col_it_is_sorted(it)) {
+                result = internal_col_it_bound(it->field_type, values, num_values, value, false);
+        } else {
+                while (result < num_values && cmp(values + result * value_size, value) != 0) {
+                        result++;
+                }
+        }
+        OPTIONAL_SET(pos, result);
+        return result < num_values && cmp(values + result * value_size, value) == 0;
+}
+
+#define COL_IT_DEFINE_FIND(name, type, is_column_type)                                                                 \
+bool col_it_find_##name(u32 *pos, col_it *it, type value)                                                              \
+{                                                                                                                      \
+        ERROR_IF_AND_RETURN(!is_column_type(it->field_type), ERR_TYPEMISMATCH, NULL);                                  \
+        return col_it_find(pos, it, &value);                                                                           \
+}
+
+COL_IT_DEFINE_FIND(u8, u8, FIELD_IS_COLUMN_U8_OR_SUBTYPE)
+COL_IT_DEFINE_FIND(u16, u16, FIELD_IS_COLUMN_U16_OR_SUBTYPE)
+COL_IT_DEFINE_FIND(u32, u32, FIELD_IS_COLUMN_U32_OR_SUBTYPE)
+COL_IT_DEFINE_FIND(u64, u64, FIELD_IS_COLUMN_U64_OR_SUBTYPE)
+COL_IT_DEFINE_FIND(i8, i8, FIELD_IS_COLUMN_I8_OR_SUBTYPE)
+COL_IT_DEFINE_FIND(i16, i16, FIELD_IS_COLUMN_I16_OR_SUBTYPE)
+COL_IT_DEFINE_FIND(i32, i32, FIELD_IS_COLUMN_I32_OR_SUBTYPE)
+COL_IT_DEFINE_FIND(i64, i64, FIELD_IS_COLUMN_I64_OR_SUBTYPE)
+COL_IT_DEFINE_FIND(float, float, FIELD_IS_COLUMN_FLOAT_OR_SUBTYPE)
+
+/* drops repeated values of a sorted set, which are adjacent since the values are in order */
+static void col_it_remove_duplicates(col_it *it)
+{
+        if (col_it_is_multiset(it) || it->num < 2) {
+                return;
+        }
+
+        size_t value_size = INTERNAL_GET_TYPE_VALUE_SIZE(it->field_type);
+        col_it_cmp_fn cmp = col_it_cmp_for(it->field_type);
+        MEMFILE_SAVE_POSITION(&it->file);
+        MEMFILE_SEEK(&it->file, internal_column_get_payload_off(it));
+        char *values = MEMFILE_PEEK_MUT(&it->file, it->num * value_size);
+        if (UNLIKELY(!values)) {
+                MEMFILE_RESTORE_POSITION(&it->file);
+                return;
+        }
+
+        u32 num_values = 1;
+        for (u32 i = 1; i < it->num; i++) {
+                if (cmp(values + (num_values - 1) * value_size, values + i * value_size) != 0) {
+                        memmove(values + num_values * value_size, values + i * value_size, value_size);
+                        num_values++;
+                }
+        }
+
+        signed_offset_t shift = 0;
+        if (num_values < it->num) {
+                /** the dropped values become unused capacity */
+                memset(values + num_values * value_size, 0, (it->num - num_values) * value_size);
+                MEMFILE_SEEK(&it->file, it->header_begin);
+                shift = MEMFILE_UPDATE_UINTVAR_STREAM(&it->file, num_values);
+                it->num = num_values;
+        }
+
+        MEMFILE_RESTORE_POSITION(&it->file);
+        MEMFILE_SEEK_FROM_HERE(&it->file, shift);
+}
+
+/* moves the value at pos of a sorted column, which was overwritten, to its position in the sort order, and drops it
+ * if the column is a set that contains it already */
+static void col_it_restore_order(col_it *it, u32 pos)
+{
+        size_t value_size = INTERNAL_GET_TYPE_VALUE_SIZE(it->field_type);
+        MEMFILE_SAVE_POSITION(&it->file);
+        MEMFILE_SEEK(&it->file, internal_column_get_payload_off(it));
+        char *values = MEMFILE_PEEK_MUT(&it->file, JAK_MAX(1u, it->num) * value_size);
+        MEMFILE_RESTORE_POSITION(&it->file);
+        if (UNLIKELY(!values)) {
+                return;
+        }
+
+        char value[sizeof(u64)];
+        memcpy(value, values + pos * value_size, value_size);
+
+        /* the values on either side of pos are still sorted */
+        u32 target = pos;
+        if (pos > 0 && col_it_cmp_for(it->field_type)(values + (pos - 1) * value_size, value) > 0) {
+                target = internal_col_it_bound(it->field_type, values, pos, value, true);
+                memmove(values + (target + 1) * value_size, values + target * value_size, (pos - target) * value_size);
+        } else if (pos + 1 < it->num) {
+                target = pos + internal_col_it_bound(it->field_type, values + (pos + 1) * value_size,
+                                                     it->num - pos - 1, value, false);
+                memmove(values + pos * value_size, values + (pos + 1) * value_size, (target - pos) * value_size);
+        }
+        memcpy(values + target * value_size, value, value_size);
+
+        col_it_remove_duplicates(it);
+}
+
 bool col_it_update_type(col_it *it, list_type_e derivation)
 {
         if (!FIELD_IS_COLUMN_OR_SUBTYPE(it->field_type)) {
@@ -446,6 +625,27 @@ bool col_it_update_type(col_it *it, list_type_e derivation)
 
         MEMFILE_RESTORE_POSITION(&it->file);
 
+        bool was_sorted = col_it_is_sorted(it);
+        it->field_type = (field_e) derive_marker;
+        it->list_type = derivation;
+
+        if (!was_sorted && col_it_is_sorted(it) && it->num > 1) {
+                /** values are kept in order for sorted columns */
+                MEMFILE_SAVE_POSITION(&it->file);
+                MEMFILE_SEEK(&it->file, internal_column_get_payload_off(it));
+                void *values = MEMFILE_PEEK_MUT(&it->file, it->num * INTERNAL_GET_TYPE_VALUE_SIZE(it->field_type));
+                if (LIKELY(values != NULL)) {
+                        qsort(values, it->num, INTERNAL_GET_TYPE_VALUE_SIZE(it->field_type),
+                              col_it_cmp_for(it->field_type));
+                }
+                MEMFILE_RESTORE_POSITION(&it->file);
+        }
+
+        if (col_it_is_sorted(it)) {
+                /** sorted sets may have held duplicates as multisets before */
+                col_it_remove_duplicates(it);
+        }
+
         return true;
 }
 
@@ -572,6 +772,10 @@ bool col_it_update_set_null(col_it *it, u32 pos)
 
         MEMFILE_RESTORE_POSITION(&it->file);
 
+        if (col_it_is_sorted(it)) {
+                col_it_restore_order(it, pos);
+        }
+
         return true;
 }
 
@@ -687,6 +891,9 @@ bool col_it_update_set_true(col_it *it, u32 pos)
                 case FIELD_DERIVED_COLUMN_BOOLEAN_SORTED_SET: {
                         u8 value = CARBON_BOOLEAN_COLUMN_TRUE;
                         MEMFILE_WRITE(&it->file, &value, sizeof(u8));
+                        if (col_it_is_sorted(it)) {
+                                col_it_restore_order(it, pos);
+                        }
                 }
                         break;
                 case FIELD_COLUMN_U8_UNSORTED_MULTISET:
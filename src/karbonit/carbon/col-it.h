@@ -54,12 +54,12 @@ offset_t col_it_tell(col_it *it, u32 elem_idx);
                 u32 num_elements = (u32) MEMFILE_READ_UINTVAR_STREAM(NULL, &it_ptr->file); UNUSED(num_elements);                                     \
                 u32 cap_elements = (u32) MEMFILE_READ_UINTVAR_STREAM(NULL, &it_ptr->file); UNUSED(cap_elements);                                     \
                 offset_t payload_start = MEMFILE_TELL(&it_ptr->file);                                                          \
-                col_it_values_result = MEMFILE_PEEK(&it_ptr->file, sizeof(char));                                                            \
+                u32 skip = cap_elements * INTERNAL_GET_TYPE_VALUE_SIZE(it_ptr->field_type);                                    \
+                col_it_values_result = MEMFILE_PEEK(&it_ptr->file, JAK_MAX(sizeof(char), skip));                               \
                 field_e *ptr_type = (field_e_ptr); UNUSED(ptr_type);                                                                            \
                 u32 *ptr_nvalues = (_nvalues_u32_ptr_); UNUSED(ptr_nvalues);                                                                          \
                 OPTIONAL_SET(ptr_type, it_ptr->field_type);                                                                    \
                 OPTIONAL_SET(ptr_nvalues, num_elements);                                                                       \
-                u32 skip = cap_elements * INTERNAL_GET_TYPE_VALUE_SIZE(it_ptr->field_type);                                    \
                 MEMFILE_SEEK(&it_ptr->file, payload_start + skip);                                                             \
         }                                                                                                                       \
         col_it_values_result;                                                                                                        \
@@ -133,7 +133,43 @@ const float *internal_col_it_float_values(u32 *nvalues, col_it *it);
 bool col_it_remove(col_it *it, u32 pos);
 bool col_it_is_multiset(col_it *it);
 bool col_it_is_sorted(col_it *it);
+
+/**
+ * Changes the abstract type of the column. If the column becomes sorted, its values are sorted in place, and if it
+ * becomes a sorted set, repeated values are dropped. Values of sorted columns are kept in ascending order by inserts
+ * and updates, where null values are greater than all other values, and sorted sets drop values that an insert or
+ * update would repeat.
+ */
 bool col_it_update_type(col_it *it, list_type_e derivation);
+
+/**
+ * Searches for <code>value</code>, which points to a value of the column's element type (for boolean columns, one of
+ * the <code>CARBON_BOOLEAN_COLUMN_*</code> bytes). Returns true if the value is contained, and sets <code>pos</code>
+ * (if non-null) to the position of its first occurrence. Sorted columns are binary searched, and <code>pos</code> is
+ * set to the position at which the value would be inserted if it is not contained. Unsorted columns are scanned, and
+ * <code>pos</code> is set to the number of values if the value is not contained.
+ */
+bool col_it_find(u32 *pos, col_it *it, const void *value);
+bool col_it_find_u8(u32 *pos, col_it *it, u8 value);
+bool col_it_find_u16(u32 *pos, col_it *it, u16 value);
+bool col_it_find_u32(u32 *pos, col_it *it, u32 value);
+bool col_it_find_u64(u32 *pos, col_it *it, u64 value);
+bool col_it_find_i8(u32 *pos, col_it *it, i8 value);
+bool col_it_find_i16(u32 *pos, col_it *it, i16 value);
+bool col_it_find_i32(u32 *pos, col_it *it, i32 value);
+bool col_it_find_i64(u32 *pos, col_it *it, i64 value);
+bool col_it_find_float(u32 *pos, col_it *it, float value);
+
+/**
+ * Compares two values of a column of the given type in the order of sorted columns
+ */
+int internal_col_it_value_cmp(field_e type, const void *lhs, const void *rhs);
+
+/**
+ * Returns the position of the first of the sorted <code>values</code> that is greater than (if <code>upper</code>),
+ * or not less than (otherwise), <code>value</code>.
+ */
+u32 internal_col_it_bound(field_e type, const void *values, u32 num_values, const void *value, bool upper);
 bool col_it_update_set_null(col_it *it, u32 pos);
 bool col_it_update_set_true(col_it *it, u32 pos);
 bool col_it_update_set_false(col_it *it, u32 pos);
@@ -0,0 +1,764 @@
+/**
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <math.h>
+
+#include <karbonit/carbon/col-kernels.h>
+#include <karbonit/carbon/internal.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+/* the AVX2 kernels are compiled for AVX2 regardless of the target of the build, and used only if the processor
+ * supports AVX2 */
+#define KERNELS_AVX2                    __attribute__((target("avx2")))
+#define KERNELS_VECTORIZED(call)        (__builtin_cpu_supports("avx2") ? (call) : 0)
+#else
+#define KERNELS_VECTORIZED(call)        0
+#endif
+
+typedef enum kernels_type {
+        KERNELS_BOOLEAN,
+        KERNELS_U8,
+        KERNELS_U16,
+        KERNELS_U32,
+        KERNELS_U64,
+        KERNELS_I8,
+        KERNELS_I16,
+        KERNELS_I32,
+        KERNELS_I64,
+        KERNELS_FLOAT
+} kernels_type_e;
+
+static bool kernels_type(kernels_type_e *type, col_it *it)
+{
+        field_e field_type = it->field_type;
+        if (FIELD_IS_COLUMN_BOOL_OR_SUBTYPE(field_type)) {
+                *type = KERNELS_BOOLEAN;
+        } else if (FIELD_IS_COLUMN_U8_OR_SUBTYPE(field_type)) {
+                *type = KERNELS_U8;
+        } else if (FIELD_IS_COLUMN_U16_OR_SUBTYPE(field_type)) {
+                *type = KERNELS_U16;
+        } else if (FIELD_IS_COLUMN_U32_OR_SUBTYPE(field_type)) {
+                *type = KERNELS_U32;
+        } else if (FIELD_IS_COLUMN_U64_OR_SUBTYPE(field_type)) {
+                *type = KERNELS_U64;
+        } else if (FIELD_IS_COLUMN_I8_OR_SUBTYPE(field_type)) {
+                *type = KERNELS_I8;
+        } else if (FIELD_IS_COLUMN_I16_OR_SUBTYPE(field_type)) {
+                *type = KERNELS_I16;
+        } else if (FIELD_IS_COLUMN_I32_OR_SUBTYPE(field_type)) {
+                *type = KERNELS_I32;
+        } else if (FIELD_IS_COLUMN_I64_OR_SUBTYPE(field_type)) {
+                *type = KERNELS_I64;
+        } else if (FIELD_IS_COLUMN_FLOAT_OR_SUBTYPE(field_type)) {
+                *type = KERNELS_FLOAT;
+        } else {
+                return ERROR(ERR_TYPEMISMATCH, NULL);
+        }
+        return true;
+}
+
+static const void *kernels_values(u32 *num_values, col_it *it)
+{
+        MEMFILE_SAVE_POSITION(&it->file);
+        const void *values = COL_IT_VALUES(NULL, num_values, it);
+        MEMFILE_RESTORE_POSITION(&it->file);
+        return values;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  scalar kernels
+// ---------------------------------------------------------------------------------------------------------------------
+
+#define KERNELS_DEFINE_SCALAR(name, type, is_null, sum_type)                                                           \
+static u32 scalar_count_non_null_##name(const type *values, u32 num_values)                                            \
+{                                                                                                                      \
+        u32 result = 0;                                                                                                \
+        for (u32 i = 0; i < num_values; i++) {                                                                         \
+                result += !is_null(values[i]);                                                                         \
+        }                                                                                                              \
+        return result;                                                                                                 \
+}                                                                                                                      \
+                                                                                                                       \
+static sum_type scalar_sum_##name(const type *values, u32 num_values)                                                  \
+{                                                                                                                      \
+        sum_type result = 0;                                                                                           \
+        for (u32 i = 0; i < num_values; i++) {                                                                         \
+                result += is_null(values[i]) ? 0 : (sum_type) values[i];                                               \
+        }                                                                                                              \
+        return result;                                                                                                 \
+}                                                                                                                      \
+                                                                                                                       \
+/* merges the least and greatest non-null values into min and max, which hold values if found is set */                \
+static void scalar_min_max_##name(bool *found, type *min, type *max, const type *values, u32 num_values)               \
+{                                                                                                                      \
+        for (u32 i = 0; i < num_values; i++) {                                                                         \
+                type value = values[i];                                                                                \
+                if (!is_null(value)) {                                                                                 \
+                        *min = !*found || value < *min ? value : *min;                                                 \
+                        *max = !*found || value > *max ? value : *max;                                                 \
+                        *found = true;                                                                                 \
+                }                                                                                                      \
+        }                                                                                                              \
+}                                                                                                                      \
+                                                                                                                       \
+static void scalar_filter_##name(u64 *sel, const type *values, u32 num_values, type lower, type upper)                 \
+{                                                                                                                      \
+        for (u32 word = 0; word < COL_KERNELS_SEL_WORDS(num_values); word++) {                                         \
+                u32 end = JAK_MIN(num_values, (word + 1) * 64);                                                        \
+                u64 bits = 0;                                                                                          \
+                for (u32 i = word * 64; i < end; i++) {                                                                \
+                        type value = values[i];                                                                        \
+                        bits |= (u64) (!is_null(value) && value >= lower && value <= upper) << (i % 64);               \
+                }                                                                                                      \
+                sel[word] = bits;                                                                                      \
+        }                                                                                                              \
+}
+
+KERNELS_DEFINE_SCALAR(boolean, boolean, IS_NULL_BOOLEAN, u64)
+KERNELS_DEFINE_SCALAR(u8, u8, IS_NULL_U8, u64)
+KERNELS_DEFINE_SCALAR(u16, u16, IS_NULL_U16, u64)
+KERNELS_DEFINE_SCALAR(u32, u32, IS_NULL_U32, u64)
+KERNELS_DEFINE_SCALAR(u64, u64, IS_NULL_U64, u64)
+KERNELS_DEFINE_SCALAR(i8, i8, IS_NULL_I8, u64)
+KERNELS_DEFINE_SCALAR(i16, i16, IS_NULL_I16, u64)
+KERNELS_DEFINE_SCALAR(i32, i32, IS_NULL_I32, u64)
+KERNELS_DEFINE_SCALAR(i64, i64, IS_NULL_I64, u64)
+KERNELS_DEFINE_SCALAR(float, float, IS_NULL_FLOAT, double)
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  AVX2 kernels
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* Each of these processes a prefix of the values, and returns its length; the scalar kernels take over from there.
+ * Unsigned integers are compared as signed integers after flipping their sign bit (bias). */
+
+#ifdef KERNELS_AVX2
+
+KERNELS_AVX2 static u64 avx2_hsum_64(__m256i v)
+{
+        u64 lanes[4];
+        _mm256_storeu_si256((__m256i *) lanes, v);
+        return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+KERNELS_AVX2 static u32 avx2_count_non_null_32(u32 *count, const u32 *values, u32 num_values, u32 null)
+{
+        u32 num = num_values / 8 * 8;
+        const __m256i vnull = _mm256_set1_epi32((int) null);
+        __m256i nulls = _mm256_setzero_si256();
+        for (u32 i = 0; i < num; i += 8) {
+                __m256i v = _mm256_loadu_si256((const __m256i *) (values + i));
+                /* a match is -1 */
+                nulls = _mm256_sub_epi32(nulls, _mm256_cmpeq_epi32(v, vnull));
+        }
+        u32 lanes[8];
+        _mm256_storeu_si256((__m256i *) lanes, nulls);
+        *count = num;
+        for (u32 i = 0; i < 8; i++) {
+                *count -= lanes[i];
+        }
+        return num;
+}
+
+KERNELS_AVX2 static u32 avx2_sum_32(u64 *sum, const u32 *values, u32 num_values, u32 null, bool is_signed)
+{
+        u32 num = num_values / 8 * 8;
+        const __m256i vnull = _mm256_set1_epi32((int) null);
+        __m256i acc = _mm256_setzero_si256();
+        for (u32 i = 0; i < num; i += 8) {
+                __m256i v = _mm256_loadu_si256((const __m256i *) (values + i));
+                v = _mm256_andnot_si256(_mm256_cmpeq_epi32(v, vnull), v);
+                __m128i lo = _mm256_castsi256_si128(v), hi = _mm256_extracti128_si256(v, 1);
+                if (is_signed) {
+                        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(lo));
+                        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(hi));
+                } else {
+                        acc = _mm256_add_epi64(acc, _mm256_cvtepu32_epi64(lo));
+                        acc = _mm256_add_epi64(acc, _mm256_cvtepu32_epi64(hi));
+                }
+        }
+        *sum = avx2_hsum_64(acc);
+        return num;
+}
+
+KERNELS_AVX2 static u32 avx2_min_max_32(bool *found, u32 *min, u32 *max, const u32 *values, u32 num_values, u32 null,
+                                        u32 bias)
+{
+        u32 num = num_values / 8 * 8;
+        const __m256i vnull = _mm256_set1_epi32((int) null), vbias = _mm256_set1_epi32((int) bias);
+        const __m256i greatest = _mm256_set1_epi32(INT32_MAX), least = _mm256_set1_epi32(INT32_MIN);
+        __m256i vmin = greatest, vmax = least, non_null = _mm256_setzero_si256();
+        for (u32 i = 0; i < num; i += 8) {
+                __m256i v = _mm256_loadu_si256((const __m256i *) (values + i));
+                __m256i is_null = _mm256_cmpeq_epi32(v, vnull);
+                v = _mm256_xor_si256(v, vbias);
+                vmin = _mm256_min_epi32(vmin, _mm256_blendv_epi8(v, greatest, is_null));
+                vmax = _mm256_max_epi32(vmax, _mm256_blendv_epi8(v, least, is_null));
+                non_null = _mm256_or_si256(non_null, _mm256_xor_si256(is_null, _mm256_set1_epi32(-1)));
+        }
+        i32 mins[8], maxs[8];
+        _mm256_storeu_si256((__m256i *) mins, vmin);
+        _mm256_storeu_si256((__m256i *) maxs, vmax);
+        i32 result_min = INT32_MAX, result_max = INT32_MIN;
+        for (u32 i = 0; i < 8; i++) {
+                result_min = JAK_MIN(result_min, mins[i]);
+                result_max = JAK_MAX(result_max, maxs[i]);
+        }
+        *found = !_mm256_testz_si256(non_null, non_null);
+        *min = (u32) result_min ^ bias;
+        *max = (u32) result_max ^ bias;
+        return num;
+}
+
+KERNELS_AVX2 static u32 avx2_filter_32(u64 *sel, const u32 *values, u32 num_values, u32 lower, u32 upper, u32 null,
+                                       u32 bias)
+{
+        u32 num = num_values / 64 * 64;
+        const __m256i vnull = _mm256_set1_epi32((int) null), vbias = _mm256_set1_epi32((int) bias);
+        const __m256i vlower = _mm256_set1_epi32((int) (lower ^ bias)), vupper = _mm256_set1_epi32((int) (upper ^ bias));
+        for (u32 word = 0; word < num / 64; word++) {
+                u64 bits = 0;
+                for (u32 i = 0; i < 64; i += 8) {
+                        __m256i v = _mm256_loadu_si256((const __m256i *) (values + word * 64 + i));
+                        __m256i biased = _mm256_xor_si256(v, vbias);
+                        __m256i miss = _mm256_or_si256(_mm256_cmpeq_epi32(v, vnull),
+                                                       _mm256_or_si256(_mm256_cmpgt_epi32(vlower, biased),
+                                                                       _mm256_cmpgt_epi32(biased, vupper)));
+                        bits |= (u64) (~_mm256_movemask_ps(_mm256_castsi256_ps(miss)) & 0xff) << i;
+                }
+                sel[word] = bits;
+        }
+        return num;
+}
+
+KERNELS_AVX2 static u32 avx2_count_non_null_64(u32 *count, const u64 *values, u32 num_values, u64 null)
+{
+        u32 num = num_values / 4 * 4;
+        const __m256i vnull = _mm256_set1_epi64x((long long) null);
+        __m256i nulls = _mm256_setzero_si256();
+        for (u32 i = 0; i < num; i += 4) {
+                __m256i v = _mm256_loadu_si256((const __m256i *) (values + i));
+                nulls = _mm256_sub_epi64(nulls, _mm256_cmpeq_epi64(v, vnull));
+        }
+        *count = num - (u32) avx2_hsum_64(nulls);
+        return num;
+}
+
+KERNELS_AVX2 static u32 avx2_sum_64(u64 *sum, const u64 *values, u32 num_values, u64 null)
+{
+        u32 num = num_values / 4 * 4;
+        const __m256i vnull = _mm256_set1_epi64x((long long) null);
+        __m256i acc = _mm256_setzero_si256();
+        for (u32 i = 0; i < num; i += 4) {
+                __m256i v = _mm256_loadu_si256((const __m256i *) (values + i));
+                acc = _mm256_add_epi64(acc, _mm256_andnot_si256(_mm256_cmpeq_epi64(v, vnull), v));
+        }
+        *sum = avx2_hsum_64(acc);
+        return num;
+}
+
+KERNELS_AVX2 static u32 avx2_min_max_64(bool *found, u64 *min, u64 *max, const u64 *values, u32 num_values, u64 null,
+                                        u64 bias)
+{
+        u32 num = num_values / 4 * 4;
+        const __m256i vnull = _mm256_set1_epi64x((long long) null), vbias = _mm256_set1_epi64x((long long) bias);
+        const __m256i greatest = _mm256_set1_epi64x(INT64_MAX), least = _mm256_set1_epi64x(INT64_MIN);
+        __m256i vmin = greatest, vmax = least, non_null = _mm256_setzero_si256();
+        for (u32 i = 0; i < num; i += 4) {
+                __m256i v = _mm256_loadu_si256((const __m256i *) (values + i));
+                __m256i is_null = _mm256_cmpeq_epi64(v, vnull);
+                v = _mm256_xor_si256(v, vbias);
+                __m256i as_min = _mm256_blendv_epi8(v, greatest, is_null);
+                __m256i as_max = _mm256_blendv_epi8(v, least, is_null);
+                vmin = _mm256_blendv_epi8(vmin, as_min, _mm256_cmpgt_epi64(vmin, as_min));
+                vmax = _mm256_blendv_epi8(vmax, as_max, _mm256_cmpgt_epi64(as_max, vmax));
+                non_null = _mm256_or_si256(non_null, _mm256_xor_si256(is_null, _mm256_set1_epi64x(-1)));
+        }
+        i64 mins[4], maxs[4];
+        _mm256_storeu_si256((__m256i *) mins, vmin);
+        _mm256_storeu_si256((__m256i *) maxs, vmax);
+        i64 result_min = INT64_MAX, result_max = INT64_MIN;
+        for (u32 i = 0; i < 4; i++) {
+                result_min = JAK_MIN(result_min, mins[i]);
+                result_max = JAK_MAX(result_max, maxs[i]);
+        }
+        *found = !_mm256_testz_si256(non_null, non_null);
+        *min = (u64) result_min ^ bias;
+        *max = (u64) result_max ^ bias;
+        return num;
+}
+
+KERNELS_AVX2 static u32 avx2_filter_64(u64 *sel, const u64 *values, u32 num_values, u64 lower, u64 upper, u64 null,
+                                       u64 bias)
+{
+        u32 num = num_values / 64 * 64;
+        const __m256i vnull = _mm256_set1_epi64x((long long) null), vbias = _mm256_set1_epi64x((long long) bias);
+        const __m256i vlower = _mm256_set1_epi64x((long long) (lower ^ bias));
+        const __m256i vupper = _mm256_set1_epi64x((long long) (upper ^ bias));
+        for (u32 word = 0; word < num / 64; word++) {
+                u64 bits = 0;
+                for (u32 i = 0; i < 64; i += 4) {
+                        __m256i v = _mm256_loadu_si256((const __m256i *) (values + word * 64 + i));
+                        __m256i biased = _mm256_xor_si256(v, vbias);
+                        __m256i miss = _mm256_or_si256(_mm256_cmpeq_epi64(v, vnull),
+                                                       _mm256_or_si256(_mm256_cmpgt_epi64(vlower, biased),
+                                                                       _mm256_cmpgt_epi64(biased, vupper)));
+                        bits |= (u64) (~_mm256_movemask_pd(_mm256_castsi256_pd(miss)) & 0xf) << i;
+                }
+                sel[word] = bits;
+        }
+        return num;
+}
+
+KERNELS_AVX2 static u32 avx2_count_non_null_float(u32 *count, const float *values, u32 num_values)
+{
+        u32 num = num_values / 8 * 8;
+        __m256i nulls = _mm256_setzero_si256();
+        for (u32 i = 0; i < num; i += 8) {
+                __m256 v = _mm256_loadu_ps(values + i);
+                nulls = _mm256_sub_epi32(nulls, _mm256_castps_si256(_mm256_cmp_ps(v, v, _CMP_UNORD_Q)));
+        }
+        u32 lanes[8];
+        _mm256_storeu_si256((__m256i *) lanes, nulls);
+        *count = num;
+        for (u32 i = 0; i < 8; i++) {
+                *count -= lanes[i];
+        }
+        return num;
+}
+
+KERNELS_AVX2 static u32 avx2_sum_float(double *sum, const float *values, u32 num_values)
+{
+        u32 num = num_values / 8 * 8;
+        __m256d acc = _mm256_setzero_pd();
+        for (u32 i = 0; i < num; i += 8) {
+                __m256 v = _mm256_loadu_ps(values + i);
+                /* nulls (NaN) become 0 */
+                v = _mm256_and_ps(v, _mm256_cmp_ps(v, v, _CMP_ORD_Q));
+                acc = _mm256_add_pd(acc, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+                acc = _mm256_add_pd(acc, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+        }
+        double lanes[4];
+        _mm256_storeu_pd(lanes, acc);
+        *sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+        return num;
+}
+
+KERNELS_AVX2 static u32 avx2_min_max_float(bool *found, float *min, float *max, const float *values, u32 num_values)
+{
+        u32 num = num_values / 8 * 8;
+        __m256 vmin = _mm256_set1_ps(INFINITY), vmax = _mm256_set1_ps(-INFINITY), non_null = _mm256_setzero_ps();
+        for (u32 i = 0; i < num; i += 8) {
+                __m256 v = _mm256_loadu_ps(values + i);
+                /* yields the second operand if the first one is null (NaN) */
+                vmin = _mm256_min_ps(v, vmin);
+                vmax = _mm256_max_ps(v, vmax);
+                non_null = _mm256_or_ps(non_null, _mm256_cmp_ps(v, v, _CMP_ORD_Q));
+        }
+        float mins[8], maxs[8];
+        _mm256_storeu_ps(mins, vmin);
+        _mm256_storeu_ps(maxs, vmax);
+        *min = INFINITY;
+        *max = -INFINITY;
+        for (u32 i = 0; i < 8; i++) {
+                *min = JAK_MIN(*min, mins[i]);
+                *max = JAK_MAX(*max, maxs[i]);
+        }
+        *found = !_mm256_testz_ps(non_null, non_null);
+        return num;
+}
+
+KERNELS_AVX2 static u32 avx2_filter_float(u64 *sel, const float *values, u32 num_values, float lower, float upper)
+{
+        u32 num = num_values / 64 * 64;
+        const __m256 vlower = _mm256_set1_ps(lower), vupper = _mm256_set1_ps(upper);
+        for (u32 word = 0; word < num / 64; word++) {
+                u64 bits = 0;
+                for (u32 i = 0; i < 64; i += 8) {
+                        __m256 v = _mm256_loadu_ps(values + word * 64 + i);
+                        /* ordered comparisons are false for nulls (NaN) */
+                        __m256 hit = _mm256_and_ps(_mm256_cmp_ps(v, vlower, _CMP_GE_OQ),
+                                                   _mm256_cmp_ps(v, vupper, _CMP_LE_OQ));
+                        bits |= (u64) _mm256_movemask_ps(hit) << i;
+                }
+                sel[word] = bits;
+        }
+        return num;
+}
+
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  kernels
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool col_kernels_count(u32 *count, col_it *it)
+{
+        kernels_type_e type;
+        if (!kernels_type(&type, it)) {
+                return false;
+        }
+        kernels_values(count, it);
+        return true;
+}
+
+bool col_kernels_count_non_null(u32 *count, col_it *it)
+{
+        kernels_type_e type;
+        if (!kernels_type(&type, it)) {
+                return false;
+        }
+        u32 num_values, done = 0, vectorized = 0;
+        const void *values = kernels_values(&num_values, it);
+
+#define KERNELS_COUNT(name, vectorize)                                                                                 \
+        done = vectorize;                                                                                              \
+        *count = vectorized + scalar_count_non_null_##name((const name *) values + done, num_values - done);           \
+        break;
+
+        switch (type) {
+                case KERNELS_BOOLEAN:
+                        KERNELS_COUNT(boolean, 0)
+                case KERNELS_U8:
+                        KERNELS_COUNT(u8, 0)
+                case KERNELS_U16:
+                        KERNELS_COUNT(u16, 0)
+                case KERNELS_U32:
+                        KERNELS_COUNT(u32, KERNELS_VECTORIZED(avx2_count_non_null_32(&vectorized, values,
+                                                                                     num_values, U32_NULL)))
+                case KERNELS_U64:
+                        KERNELS_COUNT(u64, KERNELS_VECTORIZED(avx2_count_non_null_64(&vectorized, values,
+                                                                                     num_values, U64_NULL)))
+                case KERNELS_I8:
+                        KERNELS_COUNT(i8, 0)
+                case KERNELS_I16:
+                        KERNELS_COUNT(i16, 0)
+                case KERNELS_I32:
+                        KERNELS_COUNT(i32, KERNELS_VECTORIZED(avx2_count_non_null_32(&vectorized, values,
+                                                                                     num_values, (u32) I32_NULL)))
+                case KERNELS_I64:
+                        KERNELS_COUNT(i64, KERNELS_VECTORIZED(avx2_count_non_null_64(&vectorized, values,
+                                                                                     num_values, (u64) I64_NULL)))
+                case KERNELS_FLOAT:
+                        KERNELS_COUNT(float, KERNELS_VECTORIZED(avx2_count_non_null_float(&vectorized, values,
+                                                                                          num_values)))
+                default:
+                        return ERROR(ERR_INTERNALERR, NULL);
+        }
+#undef KERNELS_COUNT
+        return true;
+}
+
+#define KERNELS_SUM(name, vectorize)                                                                                   \
+        done = vectorize;                                                                                              \
+        result = vectorized + scalar_sum_##name((const name *) values + done, num_values - done);                      \
+        break;
+
+bool col_kernels_sum_unsigned(u64 *sum, col_it *it)
+{
+        kernels_type_e type;
+        if (!kernels_type(&type, it)) {
+                return false;
+        }
+        u32 num_values, done = 0;
+        u64 result, vectorized = 0;
+        const void *values = kernels_values(&num_values, it);
+
+        switch (type) {
+                case KERNELS_BOOLEAN:
+                        KERNELS_SUM(boolean, 0)
+                case KERNELS_U8:
+                        KERNELS_SUM(u8, 0)
+                case KERNELS_U16:
+                        KERNELS_SUM(u16, 0)
+                case KERNELS_U32:
+                        KERNELS_SUM(u32, KERNELS_VECTORIZED(avx2_sum_32(&vectorized, values, num_values,
+                                                                        U32_NULL, false)))
+                case KERNELS_U64:
+                        KERNELS_SUM(u64, KERNELS_VECTORIZED(avx2_sum_64(&vectorized, values, num_values, U64_NULL)))
+                default:
+                        return ERROR(ERR_TYPEMISMATCH, NULL);
+        }
+        *sum = result;
+        return true;
+}
+
+bool col_kernels_sum_signed(i64 *sum, col_it *it)
+{
+        kernels_type_e type;
+        if (!kernels_type(&type, it)) {
+                return false;
+        }
+        u32 num_values, done = 0;
+        /* summed up as unsigned integers, which wrap around on overflow */
+        u64 result, vectorized = 0;
+        const void *values = kernels_values(&num_values, it);
+
+        switch (type) {
+                case KERNELS_I8:
+                        KERNELS_SUM(i8, 0)
+                case KERNELS_I16:
+                        KERNELS_SUM(i16, 0)
+                case KERNELS_I32:
+                        KERNELS_SUM(i32, KERNELS_VECTORIZED(avx2_sum_32(&vectorized, values, num_values,
+                                                                        (u32) I32_NULL, true)))
+                case KERNELS_I64:
+                        KERNELS_SUM(i64, KERNELS_VECTORIZED(avx2_sum_64(&vectorized, values, num_values,
+                                                                        (u64) I64_NULL)))
+                default:
+                        return ERROR(ERR_TYPEMISMATCH, NULL);
+        }
+        *sum = (i64) result;
+        return true;
+}
+
+bool col_kernels_sum_float(double *sum, col_it *it)
+{
+        kernels_type_e type;
+        if (!kernels_type(&type, it)) {
+                return false;
+        }
+        ERROR_IF_AND_RETURN(type != KERNELS_FLOAT, ERR_TYPEMISMATCH, NULL);
+        u32 num_values;
+        double vectorized = 0;
+        const float *values = kernels_values(&num_values, it);
+        u32 done = KERNELS_VECTORIZED(avx2_sum_float(&vectorized, values, num_values));
+        *sum = vectorized + scalar_sum_float(values + done, num_values - done);
+        return true;
+}
+
+#undef KERNELS_SUM
+
+static bool kernels_is_null(kernels_type_e type, const void *value)
+{
+        switch (type) {
+                case KERNELS_BOOLEAN:
+                        return IS_NULL_BOOLEAN(*(const boolean *) value);
+                case KERNELS_U8:
+                        return IS_NULL_U8(*(const u8 *) value);
+                case KERNELS_U16:
+                        return IS_NULL_U16(*(const u16 *) value);
+                case KERNELS_U32:
+                        return IS_NULL_U32(*(const u32 *) value);
+                case KERNELS_U64:
+                        return IS_NULL_U64(*(const u64 *) value);
+                case KERNELS_I8:
+                        return IS_NULL_I8(*(const i8 *) value);
+                case KERNELS_I16:
+                        return IS_NULL_I16(*(const i16 *) value);
+                case KERNELS_I32:
+                        return IS_NULL_I32(*(const i32 *) value);
+                case KERNELS_I64:
+                        return IS_NULL_I64(*(const i64 *) value);
+                case KERNELS_FLOAT:
+                        return IS_NULL_FLOAT(*(const float *) value);
+                default:
+                        return false;
+        }
+}
+
+/* sets min and max (each if non-null) to the least and greatest non-null value, and returns false if there is none */
+static bool kernels_min_max(void *min, void *max, col_it *it)
+{
+        kernels_type_e type;
+        if (!kernels_type(&type, it)) {
+                return false;
+        }
+        u32 num_values;
+        const char *values = kernels_values(&num_values, it);
+        size_t value_size = INTERNAL_GET_TYPE_VALUE_SIZE(it->field_type);
+
+        if (col_it_is_sorted(it)) {
+                /* nulls are greater than all other values, and the greatest non-null value precedes the first null */
+                u32 lo = 0, hi = num_values;
+                while (lo < hi) {
+                        u32 mid = lo + (hi - lo) / 2;
+                        if (kernels_is_null(type, values + mid * value_size)) {
+                                hi = mid;
+                        } else {
+                                lo = mid + 1;
+                        }
+                }
+                if (lo == 0) {
+                        return false;
+                }
+                if (min) {
+                        memcpy(min, values, value_size);
+                }
+                if (max) {
+                        memcpy(max, values + (lo - 1) * value_size, value_size);
+                }
+                return true;
+        }
+
+        bool found = false;
+        u64 result_min, result_max;
+        u32 done = 0;
+
+#define KERNELS_MIN_MAX(name, vectorize)                                                                               \
+        {                                                                                                              \
+                name *typed_min = (name *) &result_min, *typed_max = (name *) &result_max;                             \
+                done = vectorize;                                                                                      \
+                scalar_min_max_##name(&found, typed_min, typed_max, (const name *) values + done, num_values - done);  \
+                break;                                                                                                 \
+        }
+
+        switch (type) {
+                case KERNELS_BOOLEAN:
+                        KERNELS_MIN_MAX(boolean, 0)
+                case KERNELS_U8:
+                        KERNELS_MIN_MAX(u8, 0)
+                case KERNELS_U16:
+                        KERNELS_MIN_MAX(u16, 0)
+                case KERNELS_U32:
+                        KERNELS_MIN_MAX(u32, KERNELS_VECTORIZED(avx2_min_max_32(&found, typed_min, typed_max,
+                                        (const u32 *) values, num_values, U32_NULL, 0x80000000u)))
+                case KERNELS_U64:
+                        KERNELS_MIN_MAX(u64, KERNELS_VECTORIZED(avx2_min_max_64(&found, typed_min, typed_max,
+                                        (const u64 *) values, num_values, U64_NULL, 0x8000000000000000ull)))
+                case KERNELS_I8:
+                        KERNELS_MIN_MAX(i8, 0)
+                case KERNELS_I16:
+                        KERNELS_MIN_MAX(i16, 0)
+                case KERNELS_I32:
+                        KERNELS_MIN_MAX(i32, KERNELS_VECTORIZED(avx2_min_max_32(&found, (u32 *) typed_min,
+                                        (u32 *) typed_max, (const u32 *) values, num_values, (u32) I32_NULL, 0)))
+                case KERNELS_I64:
+                        KERNELS_MIN_MAX(i64, KERNELS_VECTORIZED(avx2_min_max_64(&found, (u64 *) typed_min,
+                                        (u64 *) typed_max, (const u64 *) values, num_values, (u64) I64_NULL, 0)))
+                case KERNELS_FLOAT:
+                        KERNELS_MIN_MAX(float, KERNELS_VECTORIZED(avx2_min_max_float(&found, typed_min, typed_max,
+                                        (const float *) values, num_values)))
+                default:
+                        return ERROR(ERR_INTERNALERR, NULL);
+        }
+#undef KERNELS_MIN_MAX
+
+        if (found) {
+                if (min) {
+                        memcpy(min, &result_min, value_size);
+                }
+                if (max) {
+                        memcpy(max, &result_max, value_size);
+                }
+        }
+        return found;
+}
+
+bool col_kernels_min(void *value, col_it *it)
+{
+        return kernels_min_max(value, NULL, it);
+}
+
+bool col_kernels_max(void *value, col_it *it)
+{
+        return kernels_min_max(NULL, value, it);
+}
+
+bool col_kernels_filter_range(u64 *sel, col_it *it, const void *lower, const void *upper)
+{
+        kernels_type_e type;
+        if (!kernels_type(&type, it)) {
+                return false;
+        }
+        u32 num_values, done = 0;
+        const void *values = kernels_values(&num_values, it);
+
+#define KERNELS_FILTER(name, least, greatest, vectorize)                                                               \
+        {                                                                                                              \
+                name lo = lower ? *(const name *) lower : (least);                                                     \
+                name hi = upper ? *(const name *) upper : (greatest);                                                  \
+                done = vectorize;                                                                                      \
+                scalar_filter_##name(sel + done / 64, (const name *) values + done, num_values - done, lo, hi);        \
+                break;                                                                                                 \
+        }
+
+        switch (type) {
+                case KERNELS_BOOLEAN:
+                        KERNELS_FILTER(boolean, CARBON_BOOLEAN_COLUMN_FALSE, CARBON_BOOLEAN_COLUMN_TRUE, 0)
+                case KERNELS_U8:
+                        KERNELS_FILTER(u8, 0, UINT8_MAX, 0)
+                case KERNELS_U16:
+                        KERNELS_FILTER(u16, 0, UINT16_MAX, 0)
+                case KERNELS_U32:
+                        KERNELS_FILTER(u32, 0, UINT32_MAX, KERNELS_VECTORIZED(avx2_filter_32(sel, values, num_values,
+                                       lo, hi, U32_NULL, 0x80000000u)))
+                case KERNELS_U64:
+                        KERNELS_FILTER(u64, 0, UINT64_MAX, KERNELS_VECTORIZED(avx2_filter_64(sel, values, num_values,
+                                       lo, hi, U64_NULL, 0x8000000000000000ull)))
+                case KERNELS_I8:
+                        KERNELS_FILTER(i8, INT8_MIN, INT8_MAX, 0)
+                case KERNELS_I16:
+                        KERNELS_FILTER(i16, INT16_MIN, INT16_MAX, 0)
+                case KERNELS_I32:
+                        KERNELS_FILTER(i32, INT32_MIN, INT32_MAX, KERNELS_VECTORIZED(avx2_filter_32(sel, values,
+                                       num_values, (u32) lo, (u32) hi, (u32) I32_NULL, 0)))
+                case KERNELS_I64:
+                        KERNELS_FILTER(i64, INT64_MIN, INT64_MAX, KERNELS_VECTORIZED(avx2_filter_64(sel, values,
+                                       num_values, (u64) lo, (u64) hi, (u64) I64_NULL, 0)))
+                case KERNELS_FLOAT:
+                        KERNELS_FILTER(float, -INFINITY, INFINITY, KERNELS_VECTORIZED(avx2_filter_float(sel, values,
+                                       num_values, lo, hi)))
+                default:
+                        return ERROR(ERR_INTERNALERR, NULL);
+        }
+#undef KERNELS_FILTER
+        return true;
+}
+
+bool col_kernels_filter_eq(u64 *sel, col_it *it, const void *value)
+{
+        return col_kernels_filter_range(sel, it, value, value);
+}
+
+#define COL_KERNELS_DEFINE_FILTER(name, type, is_column_type)                                                          \
+bool col_kernels_filter_range_##name(u64 *sel, col_it *it, type lower, type upper)                                     \
+{                                                                                                                      \
+        ERROR_IF_AND_RETURN(!is_column_type(it->field_type), ERR_TYPEMISMATCH, NULL);                                  \
+        return col_kernels_filter_range(sel, it, &lower, &upper);                                                      \
+}                                                                                                                      \
+                                                                                                                       \
+bool col_kernels_filter_eq_##name(u64 *sel, col_it *it, type value)                                                    \
+{                                                                                                                      \
+        ERROR_IF_AND_RETURN(!is_column_type(it->field_type), ERR_TYPEMISMATCH, NULL);                                  \
+        return col_kernels_filter_range(sel, it, &value, &value);                                                      \
+}
+
+COL_KERNELS_DEFINE_FILTER(u8, u8, FIELD_IS_COLUMN_U8_OR_SUBTYPE)
+COL_KERNELS_DEFINE_FILTER(u16, u16, FIELD_IS_COLUMN_U16_OR_SUBTYPE)
+COL_KERNELS_DEFINE_FILTER(u32, u32, FIELD_IS_COLUMN_U32_OR_SUBTYPE)
+COL_KERNELS_DEFINE_FILTER(u64, u64, FIELD_IS_COLUMN_U64_OR_SUBTYPE)
+COL_KERNELS_DEFINE_FILTER(i8, i8, FIELD_IS_COLUMN_I8_OR_SUBTYPE)
+COL_KERNELS_DEFINE_FILTER(i16, i16, FIELD_IS_COLUMN_I16_OR_SUBTYPE)
+COL_KERNELS_DEFINE_FILTER(i32, i32, FIELD_IS_COLUMN_I32_OR_SUBTYPE)
+COL_KERNELS_DEFINE_FILTER(i64, i64, FIELD_IS_COLUMN_I64_OR_SUBTYPE)
+COL_KERNELS_DEFINE_FILTER(float, float, FIELD_IS_COLUMN_FLOAT_OR_SUBTYPE)
+
+u32 col_kernels_sel_count(const u64 *sel, u32 num_values)
+{
+        u32 result = 0;
+        for (u32 word = 0; word < COL_KERNELS_SEL_WORDS(num_values); word++) {
+                result += (u32) __builtin_popcountll(sel[word]);
+        }
+        return result;
+}
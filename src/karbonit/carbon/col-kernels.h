@@ -0,0 +1,104 @@
+/*
+ * col-kernels - aggregates and filters over the values of columns
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_COL_KERNELS_H
+#define HAD_COL_KERNELS_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/carbon/col-it.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Number of words of a selection bitmap for a column of <code>num_values</code> values. The value at position
+ * <code>i</code> is selected if bit <code>i % 64</code> of word <code>i / 64</code> is set.
+ */
+#define COL_KERNELS_SEL_WORDS(num_values)       (((num_values) + 63) / 64)
+
+/**
+ * The kernels operate on the values of the column on which <code>it</code> operates, and skip null values unless
+ * said otherwise. On x86-64 processors that support AVX2, columns of 32 and 64 bit integers and floats are processed
+ * in vector registers; all other columns, and all other processors, use a scalar loop. Kernels do not modify the
+ * column, and do not move the iterator.
+ */
+
+/**
+ * Sets <code>count</code> to the number of values in the column, null values included
+ */
+bool col_kernels_count(u32 *count, col_it *it);
+
+/**
+ * Sets <code>count</code> to the number of non-null values in the column
+ */
+bool col_kernels_count_non_null(u32 *count, col_it *it);
+
+/**
+ * Sums up the non-null values of the column, which is 0 for a column without non-null values. Columns of unsigned
+ * integers are summed up with <code>col_kernels_sum_unsigned</code> (for boolean columns, the sum is the number of
+ * true values), columns of signed integers with <code>col_kernels_sum_signed</code>, and columns of floats with
+ * <code>col_kernels_sum_float</code>, which adds up in double precision. Integer sums wrap around on overflow.
+ */
+bool col_kernels_sum_unsigned(u64 *sum, col_it *it);
+bool col_kernels_sum_signed(i64 *sum, col_it *it);
+bool col_kernels_sum_float(double *sum, col_it *it);
+
+/**
+ * Stores the least, resp. greatest, non-null value of the column in <code>value</code>, which points to a value of
+ * the column's element type (for boolean columns, one of the <code>CARBON_BOOLEAN_COLUMN_*</code> bytes). Returns
+ * false if the column contains no non-null value. Sorted columns are not scanned.
+ */
+bool col_kernels_min(void *value, col_it *it);
+bool col_kernels_max(void *value, col_it *it);
+
+/**
+ * Selects the values of the column that are not less than <code>lower</code> and not greater than
+ * <code>upper</code>, both of which point to a value of the column's element type, or are <code>NULL</code> for
+ * an unbounded range. The caller provides <code>COL_KERNELS_SEL_WORDS(count)</code> words in <code>sel</code>, all
+ * of which are overwritten. Null values are never selected.
+ */
+bool col_kernels_filter_range(u64 *sel, col_it *it, const void *lower, const void *upper);
+bool col_kernels_filter_range_u8(u64 *sel, col_it *it, u8 lower, u8 upper);
+bool col_kernels_filter_range_u16(u64 *sel, col_it *it, u16 lower, u16 upper);
+bool col_kernels_filter_range_u32(u64 *sel, col_it *it, u32 lower, u32 upper);
+bool col_kernels_filter_range_u64(u64 *sel, col_it *it, u64 lower, u64 upper);
+bool col_kernels_filter_range_i8(u64 *sel, col_it *it, i8 lower, i8 upper);
+bool col_kernels_filter_range_i16(u64 *sel, col_it *it, i16 lower, i16 upper);
+bool col_kernels_filter_range_i32(u64 *sel, col_it *it, i32 lower, i32 upper);
+bool col_kernels_filter_range_i64(u64 *sel, col_it *it, i64 lower, i64 upper);
+bool col_kernels_filter_range_float(u64 *sel, col_it *it, float lower, float upper);
+
+/**
+ * Selects the values of the column that are equal to <code>value</code> (see <code>col_kernels_filter_range</code>)
+ */
+bool col_kernels_filter_eq(u64 *sel, col_it *it, const void *value);
+bool col_kernels_filter_eq_u8(u64 *sel, col_it *it, u8 value);
+bool col_kernels_filter_eq_u16(u64 *sel, col_it *it, u16 value);
+bool col_kernels_filter_eq_u32(u64 *sel, col_it *it, u32 value);
+bool col_kernels_filter_eq_u64(u64 *sel, col_it *it, u64 value);
+bool col_kernels_filter_eq_i8(u64 *sel, col_it *it, i8 value);
+bool col_kernels_filter_eq_i16(u64 *sel, col_it *it, i16 value);
+bool col_kernels_filter_eq_i32(u64 *sel, col_it *it, i32 value);
+bool col_kernels_filter_eq_i64(u64 *sel, col_it *it, i64 value);
+bool col_kernels_filter_eq_float(u64 *sel, col_it *it, float value);
+
+/**
+ * Returns the number of values that are selected in the selection bitmap of a column of <code>num_values</code>
+ * values
+ */
+u32 col_kernels_sel_count(const u64 *sel, u32 num_values);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -60,9 +60,17 @@ bool commit_update(memfile *file, const char *base, u64 len)
         return true;
 }
 
+bool commit_update_incremental(memfile *file)
+{
+        u64 commit_hash;
+        memblock_digest_compute(&commit_hash, file->memblock);
+        MEMFILE_WRITE(file, &commit_hash, sizeof(u64));
+        return true;
+}
+
 bool commit_compute(u64 *commit_hash, const void *base, u64 len)
 {
-        *commit_hash = HASH64_FNV(len, base);
+        *commit_hash = hash64_chunked(base, len);
         return true;
 }
 
@@ -25,6 +25,8 @@ bool commit_skip(memfile *file);
 bool commit_read(u64 *commit_hash, memfile *file);
 bool commit_peek(u64 *commit_hash, memfile *file);
 bool commit_update(memfile *file, const char *base, u64 len);
+/* as commit_update for the files entire memory block, rehashing only chunks modified since the last update */
+bool commit_update_incremental(memfile *file);
 bool commit_compute(u64 *commit_hash, const void *base, u64 len);
 const char *commit_to_str(str_buf *dst, u64 commit_hash);
 bool commit_append_to_str(str_buf *dst, u64 commit_hash);
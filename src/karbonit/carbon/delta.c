@@ -0,0 +1,287 @@
+/**
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/carbon/delta.h>
+#include <karbonit/carbon/commit.h>
+#include <karbonit/std/uintvar/stream.h>
+
+/* a delta starts with the checksums of the original and the revised raw data, the revised commit hash, and the
+ * length of the revised raw data, followed by a sequence of operations */
+#define DELTA_HEADER_SIZE       (3 * sizeof(u64))
+
+/* copies a range of the original raw data, given by its offset and length */
+#define DELTA_OP_COPY           0x01
+/* adds bytes, given by their length and the bytes themselves */
+#define DELTA_OP_ADD            0x02
+
+#define DELTA_HASH_PRIME        0x01000193u
+
+/* start offset of a block of the original raw data, and the hash of that block */
+typedef struct delta_block {
+        u32 hash;
+        /* offset plus one, or 0 for an empty slot */
+        u64 offset;
+} delta_block;
+
+/* hash table of the blocks of the original raw data that start at multiples of DELTA_BLOCK_SIZE */
+typedef struct delta_index {
+        delta_block *slots;
+        u64 mask;
+} delta_index;
+
+static u32 block_hash(const u8 *data)
+{
+        u32 hash = 0;
+        for (u32 i = 0; i < DELTA_BLOCK_SIZE; i++) {
+                hash = hash * DELTA_HASH_PRIME + data[i];
+        }
+        return hash;
+}
+
+/* DELTA_HASH_PRIME to the power of DELTA_BLOCK_SIZE - 1, by which the leaving byte is weighted in the hash */
+static u32 block_hash_leave_factor(void)
+{
+        u32 factor = 1;
+        for (u32 i = 1; i < DELTA_BLOCK_SIZE; i++) {
+                factor *= DELTA_HASH_PRIME;
+        }
+        return factor;
+}
+
+static u64 slot_of(const delta_index *index, u32 hash)
+{
+        return (hash ^ (hash >> 15)) & index->mask;
+}
+
+static void index_create(delta_index *index, const u8 *data, u64 len)
+{
+        u64 num_blocks = len / DELTA_BLOCK_SIZE;
+        u64 capacity = 16;
+        while (capacity < 2 * num_blocks) {
+                capacity *= 2;
+        }
+        index->slots = calloc(capacity, sizeof(delta_block));
+        index->mask = capacity - 1;
+
+        for (u64 block = 0; block < num_blocks; block++) {
+                u64 offset = block * DELTA_BLOCK_SIZE;
+                u32 hash = block_hash(data + offset);
+                u64 slot = slot_of(index, hash);
+                /** of several blocks with the same hash (e.g., runs of zeros), only the first one is kept */
+                while (index->slots[slot].offset && index->slots[slot].hash != hash) {
+                        slot = (slot + 1) & index->mask;
+                }
+                if (!index->slots[slot].offset) {
+                        index->slots[slot].hash = hash;
+                        index->slots[slot].offset = offset + 1;
+                }
+        }
+}
+
+/* returns the offset plus one of a block of the original that equals the block at data, or 0 if there is none */
+static u64 index_find(const delta_index *index, const u8 *original, const u8 *data, u32 hash)
+{
+        for (u64 slot = slot_of(index, hash); index->slots[slot].offset; slot = (slot + 1) & index->mask) {
+                if (index->slots[slot].hash == hash) {
+                        u64 offset = index->slots[slot].offset - 1;
+                        return memcmp(original + offset, data, DELTA_BLOCK_SIZE) == 0 ? offset + 1 : 0;
+                }
+        }
+        return 0;
+}
+
+static void put_u64(vec ofType(u8) *dst, u64 value)
+{
+        vec_push(dst, &value, sizeof(u64));
+}
+
+static void put_uintvar(vec ofType(u8) *dst, u64 value)
+{
+        u8 buffer[10];
+        vec_push(dst, buffer, uintvar_stream_write(buffer, value));
+}
+
+static void put_add(vec ofType(u8) *dst, const u8 *data, u64 len)
+{
+        if (len > 0) {
+                u8 op = DELTA_OP_ADD;
+                vec_push(dst, &op, 1);
+                put_uintvar(dst, len);
+                vec_push(dst, data, len);
+        }
+}
+
+static void put_copy(vec ofType(u8) *dst, u64 offset, u64 len)
+{
+        u8 op = DELTA_OP_COPY;
+        vec_push(dst, &op, 1);
+        put_uintvar(dst, offset);
+        put_uintvar(dst, len);
+}
+
+bool delta_create(vec ofType(u8) *delta, rec *original, rec *revised)
+{
+        u64 original_len, revised_len, original_checksum, revised_checksum, revised_hash;
+        const u8 *o = rec_raw_data(&original_len, original);
+        const u8 *r = rec_raw_data(&revised_len, revised);
+
+        commit_compute(&original_checksum, o, original_len);
+        commit_compute(&revised_checksum, r, revised_len);
+        rec_commit_hash(&revised_hash, revised);
+
+        vec_create(delta, sizeof(u8), 64);
+        put_u64(delta, original_checksum);
+        put_u64(delta, revised_checksum);
+        put_u64(delta, revised_hash);
+        put_uintvar(delta, revised_len);
+
+        delta_index index;
+        index_create(&index, o, original_len);
+        u32 leave_factor = block_hash_leave_factor();
+
+        /** bytes in [literal, pos) are not covered by a copy yet */
+        u64 literal = 0, pos = 0;
+        bool has_hash = false;
+        u32 hash = 0;
+
+        while (pos + DELTA_BLOCK_SIZE <= revised_len) {
+                if (!has_hash) {
+                        hash = block_hash(r + pos);
+                        has_hash = true;
+                }
+                u64 match = index_find(&index, o, r + pos, hash);
+                if (match) {
+                        u64 begin = match - 1, end = begin + DELTA_BLOCK_SIZE;
+                        /** extend the match into the bytes around it that are equal as well */
+                        while (begin > 0 && pos > literal && o[begin - 1] == r[pos - 1]) {
+                                begin--;
+                                pos--;
+                        }
+                        u64 revised_end = pos + (end - begin);
+                        while (end < original_len && revised_end < revised_len && o[end] == r[revised_end]) {
+                                end++;
+                                revised_end++;
+                        }
+                        put_add(delta, r + literal, pos - literal);
+                        put_copy(delta, begin, end - begin);
+                        literal = pos = revised_end;
+                        has_hash = false;
+                } else {
+                        if (pos + DELTA_BLOCK_SIZE < revised_len) {
+                                hash = (hash - r[pos] * leave_factor) * DELTA_HASH_PRIME + r[pos + DELTA_BLOCK_SIZE];
+                        }
+                        pos++;
+                }
+        }
+        put_add(delta, r + literal, revised_len - literal);
+
+        free(index.slots);
+        return true;
+}
+
+static bool read_uintvar(u64 *value, const u8 **pos, const u8 *end)
+{
+        *value = 0;
+        for (u32 i = 0; i < 10 && *pos < end; i++) {
+                u8 byte = *(*pos)++;
+                *value = (*value << 7) | (byte & MASK_BLOCK_DATA);
+                if (!(byte & MASK_FORWARD_BIT)) {
+                        return true;
+                }
+        }
+        return false;
+}
+
+/* runs the operations in [pos, end) on the original raw data o, which must produce exactly revised_len bytes;
+ * writes the bytes to data, or only validates the operations if data is NULL */
+static bool apply_ops(u8 *data, const u8 *pos, const u8 *end, const u8 *o, u64 original_len, u64 revised_len)
+{
+        u64 data_len = 0;
+        bool status = true;
+
+        while (status && pos < end) {
+                u8 op = *pos++;
+                u64 offset = 0, op_len = 0;
+                switch (op) {
+                        case DELTA_OP_COPY:
+                                status = read_uintvar(&offset, &pos, end) && read_uintvar(&op_len, &pos, end) &&
+                                         offset <= original_len && op_len <= original_len - offset &&
+                                         op_len <= revised_len - data_len;
+                                if (status && data) {
+                                        memcpy(data + data_len, o + offset, op_len);
+                                }
+                                break;
+                        case DELTA_OP_ADD:
+                                status = read_uintvar(&op_len, &pos, end) && op_len <= (u64) (end - pos) &&
+                                         op_len <= revised_len - data_len;
+                                if (status && data) {
+                                        memcpy(data + data_len, pos, op_len);
+                                }
+                                pos += status ? op_len : 0;
+                                break;
+                        default:
+                                status = false;
+                                break;
+                }
+                data_len += status ? op_len : 0;
+        }
+        return status && data_len == revised_len;
+}
+
+bool delta_apply(rec *revised, rec *original, const void *delta, u64 len)
+{
+        const u8 *pos = delta, *end = pos + len;
+        u64 original_len, original_checksum, revised_checksum, revised_hash, revised_len, checksum;
+        const u8 *o = rec_raw_data(&original_len, original);
+
+        ERROR_IF_AND_RETURN(len < DELTA_HEADER_SIZE, ERR_CORRUPTED, "delta is too short");
+        memcpy(&original_checksum, pos, sizeof(u64));
+        memcpy(&revised_checksum, pos + sizeof(u64), sizeof(u64));
+        memcpy(&revised_hash, pos + 2 * sizeof(u64), sizeof(u64));
+        pos += DELTA_HEADER_SIZE;
+
+        commit_compute(&checksum, o, original_len);
+        ERROR_IF_AND_RETURN(checksum != original_checksum, ERR_ILLEGALARG, "delta was computed for another record");
+        ERROR_IF_AND_RETURN(!read_uintvar(&revised_len, &pos, end), ERR_CORRUPTED, "delta is corrupted");
+        /** the length is untrusted until the operations are known to produce exactly that many bytes, each of which
+         * is taken from the original record or the delta, such that nothing is allocated for a corrupted length */
+        ERROR_IF_AND_RETURN(!apply_ops(NULL, pos, end, o, original_len, revised_len), ERR_CORRUPTED,
+                            "delta is corrupted");
+
+        u8 *data = MALLOC(JAK_MAX(1u, revised_len));
+        apply_ops(data, pos, end, o, original_len, revised_len);
+        commit_compute(&checksum, data, revised_len);
+        if (checksum != revised_checksum) {
+                free(data);
+                return ERROR(ERR_CORRUPTED, "delta is corrupted");
+        }
+
+        rec_from_raw_data(revised, data, revised_len);
+        free(data);
+
+        u64 hash;
+        rec_commit_hash(&hash, revised);
+        if (hash != revised_hash) {
+                rec_drop(revised);
+                return ERROR(ERR_CORRUPTED, "commit hash of the record created from the delta does not match");
+        }
+        return true;
+}
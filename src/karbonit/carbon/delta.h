@@ -0,0 +1,48 @@
+/*
+ * delta - binary deltas between record revisions
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_DELTA_H
+#define HAD_DELTA_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/rec.h>
+#include <karbonit/std/vec.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* number of bytes of the original record that are looked up as a whole in the revised record */
+#define DELTA_BLOCK_SIZE        16
+
+/**
+ * Computes a binary delta that turns the raw data (see <code>rec_raw_data</code>) of <code>original</code> into the
+ * raw data of <code>revised</code>, typically a revision of <code>original</code>, and stores it in
+ * <code>delta</code>, which is created by this function. The delta consists of copies of byte ranges of the original
+ * record and of bytes that do not occur in the original record, such that a small change, e.g., an update of a field
+ * or the insertion of a property, results in a small delta even though it moves the bytes behind it. The delta is
+ * meaningful only together with <code>original</code>, and is dropped with <code>vec_drop</code>.
+ */
+bool delta_create(vec ofType(u8) *delta, rec *original, rec *revised);
+
+/**
+ * Creates <code>revised</code> from <code>original</code> and the <code>len</code> bytes of <code>delta</code> at
+ * <code>delta</code> (see <code>delta_create</code>). Fails without creating <code>revised</code> if the delta was
+ * computed for another original record, or if it is corrupted. The created record is verified to be the one for which
+ * the delta was computed, i.e., it has the same raw data and commit hash (see <code>rec_commit_hash</code>).
+ */
+bool delta_apply(rec *revised, rec *original, const void *delta, u64 len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -18,6 +18,7 @@
 #include <karbonit/carbon/dot-eval.h>
 #include <karbonit/carbon/find.h>
 #include <karbonit/carbon/revise.h>
+#include <karbonit/carbon/pindex.h>
 
 static inline pstatus_e _dot_eval_traverse_column(dot_eval *state,
                                                   const dot *path, u32 current_path_pos,
@@ -27,23 +28,53 @@ static inline pstatus_e _dot_eval_traverse_array(dot_eval *state,
                                                  const dot *path, u32 current_path_pos,
                                                  arr_it *it, bool is_record);
 
+static bool _dot_eval_pindex(dot_eval *state, const dot *path, pindex *index);
+static bool _dot_eval_can_jump(pindex *index, rec *doc);
+
 void dot_eval_begin(dot_eval *eval, const dot *path,
                                  rec *doc)
+{
+        dot_eval_begin_indexed(eval, path, doc, NULL);
+}
+
+void dot_eval_begin_indexed(dot_eval *eval, const dot *path, rec *doc, const skip_index *skips)
 {
         ZERO_MEMORY(eval, sizeof(dot_eval));
         eval->doc = doc;
+        if (skips && skip_index_indexes_doc(skips, doc)) {
+                eval->skips = skips;
+        }
         rec_read(&eval->root_it, eval->doc);
         eval->status = _dot_eval_traverse_array(eval, path, 0, &eval->root_it, true);
 }
 
+void dot_eval_begin_pindexed(dot_eval *eval, const dot *path, rec *doc, pindex *index)
+{
+        ZERO_MEMORY(eval, sizeof(dot_eval));
+        eval->doc = doc;
+        rec_read(&eval->root_it, eval->doc);
+        if (_dot_eval_can_jump(index, doc) && _dot_eval_pindex(eval, path, index)) {
+                eval->status = PATH_RESOLVED;
+        } else {
+                eval->status = _dot_eval_traverse_array(eval, path, 0, &eval->root_it, true);
+        }
+}
+
 bool dot_eval_begin_mutable(dot_eval *eval, const dot *path,
                                          rev *context)
 {
+        /** opening the iterator releases the index from the revision */
+        pindex *index = context->index;
         eval->doc = context->revised;
+        eval->skips = NULL;
         if (!revise_iterator_open(&eval->root_it, context)) {
             return ERROR(ERR_OPPFAILED, "revise iterator cannot be opened");
         }
-        eval->status = _dot_eval_traverse_array(eval, path, 0, &eval->root_it, true);
+        if (_dot_eval_can_jump(index, eval->doc) && _dot_eval_pindex(eval, path, index)) {
+                eval->status = PATH_RESOLVED;
+        } else {
+                eval->status = _dot_eval_traverse_array(eval, path, 0, &eval->root_it, true);
+        }
         return true;
 }
 
@@ -105,8 +136,17 @@ bool carbon_path_is_object(rec *doc, const char *path)
 
 bool carbon_path_is_container(rec *doc, const char *path)
 {
-        return (carbon_path_is_array(doc, path) || carbon_path_is_column(doc, path) ||
-                carbon_path_is_object(doc, path));
+        find find;
+        field_e field_type;
+        bool result = false;
+
+        if (find_from_string(&find, path, doc)) {
+                find_result_type(&field_type, &find);
+                result = FIELD_IS_ARRAY_OR_SUBTYPE(field_type) || FIELD_IS_COLUMN_OR_SUBTYPE(field_type) ||
+                         FIELD_IS_OBJECT_OR_SUBTYPE(field_type);
+        }
+
+        return result;
 }
 
 bool carbon_path_is_null(rec *doc, const char *path)
@@ -178,8 +218,8 @@ static inline pstatus_e _dot_eval_traverse_object(dot_eval *state,
 
         status = obj_it_next(it);
         dot_len(&length, path);
-        const char *needle = dot_key_at(current_path_pos, path);
-        u64 needle_len = strlen(needle);
+        u32 needle_len;
+        const char *needle = dot_nkey_at(&needle_len, current_path_pos, path);
         u32 next_path_pos = current_path_pos + 1;
 
         if (!status) {
@@ -187,8 +227,13 @@ static inline pstatus_e _dot_eval_traverse_object(dot_eval *state,
                 return PATH_EMPTY_DOC;
         } else {
                 string_field prop_key;
+                bool is_sorted = obj_it_is_sorted(it);
                 do {
                         prop_key = internal_obj_it_prop_name(it);
+                        if (is_sorted && internal_obj_it_key_cmp(prop_key.str, prop_key.len, needle, needle_len) > 0) {
+                                /** properties of sorted maps are in order of their keys, i.e., the key is not contained */
+                                break;
+                        }
                         if (prop_key.len == needle_len && strncmp(prop_key.str, needle, needle_len) == 0) {
                                 if (next_path_pos == length) {
                                         state->result.container = OBJECT;
@@ -366,8 +411,16 @@ static inline pstatus_e _dot_eval_traverse_array(dot_eval *state,
                         case DOT_NODE_IDX:
                                 dot_idx_at(&requested_array_idx, current_path_pos, path);
 
-                                while (current_array_idx < requested_array_idx && arr_it_next(it)) {
-                                        current_array_idx++;
+                                const arr_skip *skip = state->skips && requested_array_idx > 0 ?
+                                                       skip_index_get(state->skips, it->begin) : NULL;
+                                if (skip) {
+                                        if (arr_it_seek(it, requested_array_idx, skip)) {
+                                                current_array_idx = requested_array_idx;
+                                        }
+                                } else {
+                                        while (current_array_idx < requested_array_idx && arr_it_next(it)) {
+                                                current_array_idx++;
+                                        }
                                 }
                                 assert(current_array_idx <= requested_array_idx);
                                 if (current_array_idx != requested_array_idx) {
@@ -514,4 +567,86 @@ static inline pstatus_e _dot_eval_traverse_column(dot_eval *state,
                         return PATH_RESOLVED;
                 }
         }
-}
\ No newline at end of file
+}
+
+/* returns true if the index can be used to jump to the result in the record. Records without a key have no commit
+ * hash, and checking that the index belongs to them costs a pass over the record, which is what the index should
+ * save; they are therefore evaluated without the index. */
+static bool _dot_eval_can_jump(pindex *index, rec *doc)
+{
+        key_e key_type;
+        return index && rec_key_type(&key_type, doc) && key_type != KEY_NOKEY && pindex_indexes_doc(index, doc);
+}
+
+/* resolves the path in the index, and sets the result to the element or property the index points to; returns false
+ * if the path does not resolve in the index, in which case the status is determined by traversing the record */
+static bool _dot_eval_pindex(dot_eval *state, const dot *path, pindex *index)
+{
+        pindex_it it;
+        dot_node_type_e node_type;
+        u32 length;
+
+        dot_len(&length, path);
+        pindex_it_open(&it, index, state->doc);
+
+        dot_type_at(&node_type, 0, path);
+        if (node_type == DOT_NODE_KEY) {
+                /** a key is looked up in the object that is the only element of the record */
+                if (it.len != 1 || !pindex_it_list_goto(0, &it) || !pindex_it_list_enter(&it) ||
+                    it.container != OBJECT) {
+                        return false;
+                }
+        }
+
+        for (u32 i = 0; i < length; i++) {
+                dot_type_at(&node_type, i, path);
+                if (node_type == DOT_NODE_IDX) {
+                        u32 idx;
+                        dot_idx_at(&idx, i, path);
+                        if (!pindex_it_list_goto(idx, &it) ||
+                            (i == 0 && it.len == 1 && FIELD_IS_COLUMN_OR_SUBTYPE(it.field_type))) {
+                                /** a column as the only element of the record is evaluated as the record itself */
+                                return false;
+                        }
+                } else {
+                        u32 key_len;
+                        const char *key = dot_nkey_at(&key_len, i, path);
+                        if (!pindex_it_obj_ngoto(key, key_len, &it)) {
+                                return false;
+                        }
+                }
+                if (i + 1 < length &&
+                    !(it.container == OBJECT ? pindex_it_obj_enter(&it) : pindex_it_list_enter(&it))) {
+                        return false;
+                }
+        }
+
+        memfile *file = &state->root_it.file;
+        offset_t container_off = it.container_off ? it.container_off : state->root_it.begin;
+        state->result.container = it.container;
+        switch (it.container) {
+                case ARRAY: {
+                        arr_it *result = &state->result.containers.array;
+                        internal_arr_it_create(result, file, container_off);
+                        MEMFILE_SEEK(&result->file, it.field_off);
+                        result->pos = it.pos;
+                        arr_it_next(result);
+                }
+                        break;
+                case OBJECT: {
+                        obj_it *result = &state->result.containers.object;
+                        internal_obj_it_create(result, file, container_off);
+                        MEMFILE_SEEK(&result->file, it.key_off);
+                        result->pos = it.pos;
+                        obj_it_next(result);
+                }
+                        break;
+                case COLUMN:
+                        col_it_create(&state->result.containers.column.it, file, container_off);
+                        state->result.containers.column.elem_pos = it.pos;
+                        break;
+                default:
+                        return false;
+        }
+        return true;
+}
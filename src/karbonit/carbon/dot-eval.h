@@ -10,6 +10,7 @@
 #include <karbonit/stdinc.h>
 #include <karbonit/carbon/dot.h>
 #include <karbonit/carbon/container.h>
+#include <karbonit/carbon/skip-index.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -18,6 +19,8 @@ extern "C" {
 typedef struct dot_eval {
         rec *doc;
         arr_it root_it;
+        /* optional skip index for the record, used to access array elements by their index */
+        const skip_index *skips;
         pstatus_e status;
         struct {
                 container_e container;
@@ -33,6 +36,20 @@ typedef struct dot_eval {
 } dot_eval;
 
 void dot_eval_begin(dot_eval *eval, const dot *path, rec *doc);
+
+/**
+ * Evaluates the path as <code>dot_eval_begin</code> does, but uses <code>skips</code> (if non-null) to access
+ * elements of indexed arrays without stepping over all elements before them. An index that was not created for
+ * the revision of <code>doc</code> is ignored.
+ */
+void dot_eval_begin_indexed(dot_eval *eval, const dot *path, rec *doc, const skip_index *skips);
+
+/**
+ * Evaluates the path as <code>dot_eval_begin</code> does, but uses the path index <code>index</code> (if non-null)
+ * to jump to the result directly instead of scanning the containers on the path. The record is only traversed if the
+ * index was not created for the revision of <code>doc</code>, or if the path does not resolve in the index.
+ */
+void dot_eval_begin_pindexed(dot_eval *eval, const dot *path, rec *doc, pindex *index);
 bool dot_eval_begin_mutable(dot_eval *eval, const dot *path, rev *context);
 
 bool dot_eval_status(pstatus_e *status, dot_eval *state);
@@ -24,6 +24,7 @@
 #include <karbonit/carbon/dot.h>
 #include <karbonit/std/string.h>
 #include <karbonit/utils/strings.h>
+#include <karbonit/std/hash.h>
 
 enum dot_token_type {
         TOKEN_DOT,
@@ -113,7 +114,7 @@ static const char *next_token(struct dot_token *token, const char *str)
 
 bool dot_create(dot *path)
 {
-        vec_create(&path->nodes, sizeof(dot_node), 256);
+        vec_create(&path->nodes, sizeof(dot_node), 8);
         return true;
 }
 
@@ -193,6 +194,7 @@ void dot_add_nkey(dot *dst, const char *key, size_t len)
                 size_t l = strlen(str_wo_rightspaces);
                 node->name.string[l - 1] = '\0';
         }
+        node->len = strlen(node->name.string);
         assert(!strings_is_enquoted(node->name.string));
 }
 
@@ -241,6 +243,16 @@ const char *dot_key_at(u32 pos, const dot *path)
         return VEC_GET(&path->nodes, pos, dot_node)->name.string;
 }
 
+const char *dot_nkey_at(u32 *len, u32 pos, const dot *path)
+{
+        ERROR_IF_AND_RETURN(pos >= VEC_LENGTH(&path->nodes), ERR_OUTOFBOUNDS, NULL);
+        const dot_node *node = VEC_GET(&path->nodes, pos, dot_node);
+        ERROR_IF_AND_RETURN(node->type != DOT_NODE_KEY, ERR_TYPEMISMATCH, NULL);
+
+        *len = node->len;
+        return node->name.string;
+}
+
 bool dot_drop(dot *path)
 {
         for (u32 i = 0; i < VEC_LENGTH(&path->nodes); i++) {
@@ -297,4 +309,134 @@ bool dot_fprint(FILE *file, dot *path)
 bool dot_print(dot *path)
 {
         return dot_fprint(stdout, path);
-}
\ No newline at end of file
+}
+
+static const dot *thread_uncached_path(const char *path_string);
+
+bool dot_cache_create(dot_cache *cache, u32 capacity)
+{
+        u32 num_sets = 1;
+        while (num_sets * DOT_CACHE_WAYS < capacity) {
+                num_sets *= 2;
+        }
+        cache->num_sets = num_sets;
+        cache->entries = MALLOC(num_sets * DOT_CACHE_WAYS * sizeof(dot_cache_entry));
+        cache->victims = MALLOC(num_sets);
+        if (UNLIKELY(!cache->entries || !cache->victims)) {
+                free(cache->entries);
+                free(cache->victims);
+                return false;
+        }
+        return true;
+}
+
+const dot *dot_cache_get(dot_cache *cache, const char *path_string)
+{
+        if (UNLIKELY(!cache)) {
+                return thread_uncached_path(path_string);
+        }
+
+        u64 hash = HASH64_XX(strlen(path_string), path_string);
+        u32 set = hash & (cache->num_sets - 1);
+        dot_cache_entry *entries = cache->entries + set * DOT_CACHE_WAYS;
+        dot_cache_entry *victim = NULL;
+
+        for (u32 way = 0; way < DOT_CACHE_WAYS; way++) {
+                dot_cache_entry *entry = entries + way;
+                if (!entry->str) {
+                        victim = victim ? victim : entry;
+                } else if (entry->hash == hash && strcmp(entry->str, path_string) == 0) {
+                        return &entry->path;
+                }
+        }
+
+        dot path;
+        if (!dot_from_string(&path, path_string)) {
+                return NULL;
+        }
+        if (!victim) {
+                victim = entries + cache->victims[set];
+                cache->victims[set] = (cache->victims[set] + 1) % DOT_CACHE_WAYS;
+                free(victim->str);
+                dot_drop(&victim->path);
+        }
+        victim->str = strdup(path_string);
+        victim->hash = hash;
+        victim->path = path;
+        return &victim->path;
+}
+
+bool dot_cache_drop(dot_cache *cache)
+{
+        for (u32 i = 0; i < cache->num_sets * DOT_CACHE_WAYS; i++) {
+                dot_cache_entry *entry = cache->entries + i;
+                if (entry->str) {
+                        free(entry->str);
+                        dot_drop(&entry->path);
+                }
+        }
+        free(cache->entries);
+        free(cache->victims);
+        return true;
+}
+
+static _Thread_local dot_cache thread_cache;
+static _Thread_local bool thread_cache_init = false;
+/* path compiled by dot_cache_get without a cache, e.g., if the thread cache cannot be created */
+static _Thread_local dot thread_path;
+static _Thread_local bool thread_path_init = false;
+static pthread_key_t thread_cache_key;
+static pthread_once_t thread_cache_key_once = PTHREAD_ONCE_INIT;
+
+static void thread_cache_release(void *arg)
+{
+        UNUSED(arg);
+        if (thread_cache_init) {
+                dot_cache_drop(&thread_cache);
+                thread_cache_init = false;
+        }
+        if (thread_path_init) {
+                dot_drop(&thread_path);
+                thread_path_init = false;
+        }
+}
+
+static void thread_cache_key_create(void)
+{
+        pthread_key_create(&thread_cache_key, thread_cache_release);
+}
+
+/* releases the cache and the uncached path of the calling thread when it terminates */
+static void thread_cache_register(void)
+{
+        pthread_once(&thread_cache_key_once, thread_cache_key_create);
+        pthread_setspecific(thread_cache_key, &thread_cache);
+}
+
+static const dot *thread_uncached_path(const char *path_string)
+{
+        dot path;
+        if (!dot_from_string(&path, path_string)) {
+                return NULL;
+        }
+        if (thread_path_init) {
+                dot_drop(&thread_path);
+        } else {
+                thread_cache_register();
+        }
+        thread_path = path;
+        thread_path_init = true;
+        return &thread_path;
+}
+
+dot_cache *dot_thread_cache(void)
+{
+        if (UNLIKELY(!thread_cache_init)) {
+                if (UNLIKELY(!dot_cache_create(&thread_cache, DOT_THREAD_CACHE_CAPACITY))) {
+                        return NULL;
+                }
+                thread_cache_register();
+                thread_cache_init = true;
+        }
+        return &thread_cache;
+}
@@ -34,12 +34,41 @@ typedef struct dot_node {
                 char *string;
                 u32 idx;
         } name;
+        /* length of the key (key nodes only) */
+        u32 len;
 } dot_node;
 
+/**
+ * Compiled (i.e., parsed) dot path. Evaluating a path does not modify it, so a path that is compiled once can be
+ * evaluated on any number of records, and by several threads at the same time (see find_from_dot, and the
+ * <code>update_set_*_compiled</code> functions).
+ */
 typedef struct dot {
         vec ofType(dot_node) nodes;
 } dot;
 
+#define DOT_CACHE_WAYS                  4
+#define DOT_THREAD_CACHE_CAPACITY       256
+
+typedef struct dot_cache_entry {
+        /* the path string, or NULL if the entry is unused */
+        char *str;
+        u64 hash;
+        dot path;
+} dot_cache_entry;
+
+/**
+ * Bounded cache of compiled paths keyed by their path string. The cache is set-associative with DOT_CACHE_WAYS
+ * entries per set; on a miss, the least recently inserted entry of the set is replaced. A cache must not be shared
+ * among threads without synchronization; use <code>dot_thread_cache</code> for a per-thread cache.
+ */
+typedef struct dot_cache {
+        dot_cache_entry *entries;
+        /* per set, the next entry to be replaced */
+        u8 *victims;
+        u32 num_sets;
+} dot_cache;
+
 typedef enum pstatus {
         PATH_RESOLVED,
         PATH_EMPTY_DOC,
@@ -64,10 +93,34 @@ bool dot_is_empty(const dot *path);
 bool dot_type_at(dot_node_type_e *type_out, u32 pos, const dot *path);
 bool dot_idx_at(u32 *idx, u32 pos, const dot *path);
 const char *dot_key_at(u32 pos, const dot *path);
+const char *dot_nkey_at(u32 *len, u32 pos, const dot *path);
 bool dot_to_str(str_buf *sb, dot *path);
 bool dot_fprint(FILE *file, dot *path);
 bool dot_print(dot *path);
 
+/**
+ * Creates a cache for (at least) <code>capacity</code> compiled paths
+ */
+bool dot_cache_create(dot_cache *cache, u32 capacity);
+
+/**
+ * Returns the compiled path for <code>path_string</code>, which is compiled on a cache miss. The returned path is
+ * owned by the cache, and valid until the next call to <code>dot_cache_get</code> on the same cache. Returns
+ * <code>NULL</code> if the path string cannot be parsed. For a <code>NULL</code> cache (e.g., if
+ * <code>dot_thread_cache</code> fails), the path is compiled on each call, and is valid until the next such call of
+ * the same thread.
+ */
+const dot *dot_cache_get(dot_cache *cache, const char *path_string);
+bool dot_cache_drop(dot_cache *cache);
+
+/**
+ * Returns the path cache of the calling thread, which is created on the first call and released when the thread
+ * terminates. The cache holds up to DOT_THREAD_CACHE_CAPACITY paths, and is used by all functions that take a path
+ * string (e.g., find_from_string and update_set_u64) such that repeated paths are compiled only once per thread.
+ * Returns <code>NULL</code> if the cache cannot be created, which <code>dot_cache_get</code> accepts.
+ */
+dot_cache *dot_thread_cache(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -35,11 +35,14 @@ result_from_column(find *find, u32 requested_idx, col_it *it);
 
 bool find_from_string(find *out, const char *dot, rec *doc)
 {
-        struct dot path;
-        dot_from_string(&path, dot);
-        bool ret = find_from_dot(out, &path, doc);
-        dot_drop(&path);
-        return ret;
+        const struct dot *path = dot_cache_get(dot_thread_cache(), dot);
+        if (UNLIKELY(!path)) {
+                ZERO_MEMORY(out, sizeof(find));
+                out->doc = doc;
+                out->eval.status = PATH_INTERNAL;
+                return false;
+        }
+        return find_from_dot(out, path, doc);
 }
 
 bool find_from_dot(find *out, const dot *path, rec *doc)
@@ -48,12 +51,37 @@ bool find_from_dot(find *out, const dot *path, rec *doc)
         return find_has_result(out);
 }
 
+bool find_from_dot_indexed(find *out, const dot *path, rec *doc, const skip_index *skips)
+{
+        ZERO_MEMORY(out, sizeof(find));
+        out->doc = doc;
+
+        dot_eval_begin_indexed(&out->eval, path, doc, skips);
+        internal_find_from_eval(out);
+        return find_has_result(out);
+}
+
+bool find_from_dot_pindexed(find *out, const dot *path, rec *doc, pindex *index)
+{
+        ZERO_MEMORY(out, sizeof(find));
+        out->doc = doc;
+
+        dot_eval_begin_pindexed(&out->eval, path, doc, index);
+        internal_find_from_eval(out);
+        return find_has_result(out);
+}
+
 bool internal_find_exec(find *find, const dot *path, rec *doc)
 {
         ZERO_MEMORY(find, sizeof(find));
         find->doc = doc;
 
         dot_eval_begin(&find->eval, path, doc);
+        return internal_find_from_eval(find);
+}
+
+bool internal_find_from_eval(find *find)
+{
         if (find_has_result(find)) {
                 switch (find->eval.result.container) {
                         case ARRAY:
@@ -180,16 +208,7 @@ bool find_update_column_type(find *find, list_type_e derivation)
         find_result_type(&type, find);
         if (FIELD_IS_COLUMN_OR_SUBTYPE(type)) {
                 col_it *it = find_result_column(find);
-                MEMFILE_SAVE_POSITION(&it->file);
-                MEMFILE_SEEK(&it->file, it->begin);
-
-                list_container_e list_container;
-                list_by_column_type(&list_container, it->field_type);
-                derived_e derive_marker = abstract_derive_list_to(list_container, derivation);
-                abstract_write_derived_type(&it->file, derive_marker);
-
-                MEMFILE_RESTORE_POSITION(&it->file);
-                return true;
+                return col_it_update_type(it, derivation);
         } else {
                 return ERROR(ERR_TYPEMISMATCH, "find: column type update must be invoked on column or sub type");
         }
@@ -225,13 +244,7 @@ bool find_update_object_type(find *find, map_type_e derivation)
         find_result_type(&type, find);
         if (FIELD_IS_OBJECT_OR_SUBTYPE(type)) {
                 obj_it *it = find_result_object(find);
-                MEMFILE_SAVE_POSITION(&it->file);
-                MEMFILE_SEEK(&it->file, it->begin);
-
-                derived_e derive_marker = abstract_derive_map_to(derivation);
-                abstract_write_derived_type(&it->file, derive_marker);
-
-                MEMFILE_RESTORE_POSITION(&it->file);
+                obj_it_update_type(it, derivation);
                 return true;
 
         } else {
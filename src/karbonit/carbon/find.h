@@ -45,8 +45,26 @@ typedef struct find {
 
 bool find_from_string(find *out, const char *dot, rec *doc);
 bool find_from_dot(find *out, const dot *path, rec *doc);
+
+/**
+ * Evaluates the path as <code>find_from_dot</code> does, but accesses elements of arrays that are indexed in
+ * <code>skips</code> (if non-null) by seeking instead of stepping over all elements before them.
+ */
+bool find_from_dot_indexed(find *out, const dot *path, rec *doc, const skip_index *skips);
+
+/**
+ * Evaluates the path as <code>find_from_dot</code> does, but jumps to the result by means of the path index
+ * <code>index</code> (if non-null) if that index was created for the revision of <code>doc</code>.
+ */
+bool find_from_dot_pindexed(find *out, const dot *path, rec *doc, pindex *index);
 bool internal_find_exec(find *find, const dot *path, rec *doc);
 
+/**
+ * Populates the result of <code>find</code> from its evaluation state, for which the result container is already set
+ * if the path was resolved. Returns true if the path was resolved.
+ */
+bool internal_find_from_eval(find *find);
+
 bool find_has_result(find *find);
 const char *find_result_to_str(str_buf *dst_str, find *find);
 
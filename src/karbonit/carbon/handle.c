@@ -0,0 +1,84 @@
+/**
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/carbon/handle.h>
+
+bool handle_create(handle *handle, rec *doc)
+{
+        rec *record = MALLOC(sizeof(rec));
+        *record = *doc;
+        atomic_init(&handle->current, record);
+        epoch_create(&handle->reclaim);
+        return true;
+}
+
+bool handle_drop(handle *handle)
+{
+        rec_drop_and_free(atomic_load_explicit(&handle->current, memory_order_relaxed));
+        epoch_drop(&handle->reclaim);
+        return true;
+}
+
+bool handle_snapshot(rec *view, handle *handle)
+{
+        rec_view(view, atomic_load_explicit(&handle->current, memory_order_acquire));
+        return true;
+}
+
+/* replaces 'current' by 'revised' unless another writer replaced 'current' meanwhile; since replaced records are not
+ * freed during the caller's critical section, their addresses are not reused, i.e., the exchange detects any
+ * replacement */
+static bool publish_over(handle *handle, rec *current, rec *revised)
+{
+        rec *record = MALLOC(sizeof(rec));
+        *record = *revised;
+        if (!atomic_compare_exchange_strong_explicit(&handle->current, &current, record, memory_order_acq_rel,
+                                                     memory_order_relaxed)) {
+                free(record);
+                return false;
+        }
+        epoch_retire(&handle->reclaim, current, rec_drop_and_free);
+        return true;
+}
+
+bool handle_publish(handle *handle, rec *revised, u64 expected_hash)
+{
+        rec view;
+        u64 current_hash;
+        key_e key_type;
+        rec *current = atomic_load_explicit(&handle->current, memory_order_acquire);
+        rec_view(&view, current);
+        rec_key_type(&key_type, &view);
+        if (UNLIKELY(key_type == KEY_NOKEY)) {
+                /** the commit hash of such records is always 0, and thus does not detect other revisions */
+                return ERROR(ERR_ILLEGALARG, "records without primary key are published by handle_revise_end");
+        }
+        rec_commit_hash(&current_hash, &view);
+        return current_hash == expected_hash && publish_over(handle, current, revised);
+}
+
+bool handle_revise_end(handle *handle, rev *context)
+{
+        revise_end(context);
+        rec *current = atomic_load_explicit(&handle->current, memory_order_acquire);
+        /* the snapshot shares the memory block of the record it was taken from */
+        return current->block == context->original->block && publish_over(handle, current, context->revised);
+}
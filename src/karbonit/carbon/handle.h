@@ -0,0 +1,82 @@
+/*
+ * handle - shared record handle with atomic publishing of revisions
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_HANDLE_H
+#define HAD_HANDLE_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/rec.h>
+#include <karbonit/carbon/revise.h>
+#include <karbonit/std/epoch.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A record that is shared by threads, of which readers take snapshots without locks while writers replace the record
+ * by revisions of it.
+ *
+ * Readers and writers access the handle inside read-side critical sections of the handle's epoch, i.e., a thread
+ * registers once by <code>epoch_register(&handle->reclaim)</code>, and brackets snapshots, the use of snapshots,
+ * and publishing by <code>epoch_enter</code> and <code>epoch_leave</code>. A snapshot is a single atomic load, and
+ * is a view of the record that stays unchanged even if a revision is published meanwhile. A writer revises a snapshot
+ * (see <code>revise_begin_copy</code>), and publishes the revised record only if the record was not replaced since
+ * the snapshot, which is detected by a compare-and-swap of the current record, and, for writers that know only the
+ * commit hash of the record they revised, by its commit hash (see <code>rec_commit_hash</code>). Replaced records
+ * are dropped once no thread accesses them anymore (see <code>epoch_retire</code>).
+ */
+typedef struct handle {
+        _Atomic(rec *) current;
+        epoch reclaim;
+} handle;
+
+/**
+ * Creates a handle for the record <code>doc</code>, which the handle takes over.
+ */
+bool handle_create(handle *handle, rec *doc);
+
+/**
+ * Drops the handle, its record, and all replaced records. No thread must be in a critical section.
+ */
+bool handle_drop(handle *handle);
+
+/**
+ * Makes <code>view</code> a read-only view (see <code>rec_view</code>) of the current record, which is valid until
+ * the caller leaves its critical section.
+ */
+bool handle_snapshot(rec *view, handle *handle);
+
+/**
+ * Replaces the current record by <code>revised</code> if the commit hash of the current record is
+ * <code>expected_hash</code>, i.e., if no other writer published a revision since the caller took the snapshot that
+ * <code>revised</code> is a revision of. The handle takes over <code>revised</code> on success. Otherwise, the function
+ * returns <code>false</code> without setting an error and the caller keeps <code>revised</code>, which it drops or
+ * recreates from a new snapshot. Must be called inside a critical section. Records without primary key have no commit
+ * hash (see <code>rec_create_begin</code>), such that a conflict cannot be detected by it; for these, the function
+ * fails with <code>ERR_ILLEGALARG</code>, and their revisions are published by <code>handle_revise_end</code>.
+ */
+bool handle_publish(handle *handle, rec *revised, u64 expected_hash);
+
+/**
+ * Ends the revision <code>context</code> of a snapshot (see <code>revise_begin_copy</code>) as
+ * <code>revise_end</code> does, and publishes the revised record (see <code>handle_publish</code>) if the current
+ * record is still the one of the snapshot. Returns <code>false</code> if another revision was published meanwhile, in
+ * which case the revised record is not dropped. Must be called inside the critical section in which the snapshot was
+ * taken.
+ */
+bool handle_revise_end(handle *handle, rev *context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
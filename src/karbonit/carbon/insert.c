@@ -43,6 +43,8 @@ write_field_data(insert *in, u8 field_marker, const void *base, u64 nbytes);
 
 static bool push_in_column(insert *in, const void *base, field_e type);
 
+static bool push_values_in_column(insert *in, const void *values, u32 num_values);
+
 static bool push_media_type_for_array(insert *in, field_e type);
 
 static void internal_create(insert *in, memfile *src, offset_t pos);
@@ -342,14 +344,14 @@ bool insert_unsigned(insert *in, u64 value)
 {
         ERROR_IF_AND_RETURN(in->context_type == COLUMN, ERR_INSERT_TOO_DANGEROUS, NULL)
 
-        switch (number_min_type_signed(value)) {
-                case NUMBER_I8:
+        switch (number_min_type_unsigned(value)) {
+                case NUMBER_U8:
                         return insert_u8(in, (u8) value);
-                case NUMBER_I16:
+                case NUMBER_U16:
                         return insert_u16(in, (u16) value);
-                case NUMBER_I32:
+                case NUMBER_U32:
                         return insert_u32(in, (u32) value);
-                case NUMBER_I64:
+                case NUMBER_U64:
                         return insert_u64(in, (u64) value);
                 default: ERROR(ERR_INTERNALERR, NULL);
                         return false;
@@ -390,6 +392,62 @@ bool insert_float(insert *in, float value)
         return true;
 }
 
+bool insert_boolean_values(insert *in, const boolean *values, u32 num_values)
+{
+        ERROR_IF_AND_RETURN(in->context_type == COLUMN &&
+                            !FIELD_IS_COLUMN_BOOL_OR_SUBTYPE(in->context.column->field_type),
+                            ERR_TYPEMISMATCH, "Element type does not match container type");
+        switch (in->context_type) {
+                case ARRAY:
+                        for (u32 i = 0; i < num_values; i++) {
+                                if (IS_NULL_BOOLEAN(values[i])) {
+                                        insert_null(in);
+                                } else if (values[i] == CARBON_BOOLEAN_COLUMN_TRUE) {
+                                        insert_true(in);
+                                } else {
+                                        insert_false(in);
+                                }
+                        }
+                        return true;
+                case COLUMN:
+                        return push_values_in_column(in, values, num_values);
+                default: ERROR(ERR_INTERNALERR, NULL);
+                        return false;
+        }
+}
+
+#define INSERT_DEFINE_VALUES(name, type, is_column_type, is_null)                                                      \
+bool insert_##name##_values(insert *in, const type *values, u32 num_values)                                            \
+{                                                                                                                      \
+        ERROR_IF_AND_RETURN(in->context_type == COLUMN && !is_column_type(in->context.column->field_type),             \
+                            ERR_TYPEMISMATCH, "Element type does not match container type");                           \
+        switch (in->context_type) {                                                                                    \
+                case ARRAY:                                                                                            \
+                        for (u32 i = 0; i < num_values; i++) {                                                         \
+                                if (is_null(values[i])) {                                                              \
+                                        insert_null(in);                                                               \
+                                } else {                                                                               \
+                                        insert_##name(in, values[i]);                                                  \
+                                }                                                                                      \
+                        }                                                                                              \
+                        return true;                                                                                   \
+                case COLUMN:                                                                                           \
+                        return push_values_in_column(in, values, num_values);                                          \
+                default: ERROR(ERR_INTERNALERR, NULL);                                                                 \
+                        return false;                                                                                  \
+        }                                                                                                              \
+}
+
+INSERT_DEFINE_VALUES(u8, u8, FIELD_IS_COLUMN_U8_OR_SUBTYPE, IS_NULL_U8)
+INSERT_DEFINE_VALUES(u16, u16, FIELD_IS_COLUMN_U16_OR_SUBTYPE, IS_NULL_U16)
+INSERT_DEFINE_VALUES(u32, u32, FIELD_IS_COLUMN_U32_OR_SUBTYPE, IS_NULL_U32)
+INSERT_DEFINE_VALUES(u64, u64, FIELD_IS_COLUMN_U64_OR_SUBTYPE, IS_NULL_U64)
+INSERT_DEFINE_VALUES(i8, i8, FIELD_IS_COLUMN_I8_OR_SUBTYPE, IS_NULL_I8)
+INSERT_DEFINE_VALUES(i16, i16, FIELD_IS_COLUMN_I16_OR_SUBTYPE, IS_NULL_I16)
+INSERT_DEFINE_VALUES(i32, i32, FIELD_IS_COLUMN_I32_OR_SUBTYPE, IS_NULL_I32)
+INSERT_DEFINE_VALUES(i64, i64, FIELD_IS_COLUMN_I64_OR_SUBTYPE, IS_NULL_I64)
+INSERT_DEFINE_VALUES(float, float, FIELD_IS_COLUMN_FLOAT_OR_SUBTYPE, IS_NULL_FLOAT)
+
 bool insert_string(insert *in, const char *value)
 {
         return insert_nchar(in, value, strlen(value));
@@ -655,9 +713,52 @@ static bool inserter_refresh_mod_size(insert *in, i64 mod_size)
         return true;
 }
 
+/* in sorted maps, moves the insert position behind the last property whose key is not greater than 'key' such that
+ * properties stay in order of their keys, and properties with equal keys in order of their insertion. Keys that are
+ * not less than the key this inserter appended last are appended without scanning the map. */
+static void insert_prop_seek_sorted(insert *in, const char *key)
+{
+        if (!obj_it_is_sorted(in->context.object)) {
+                return;
+        }
+        u64 key_len = strlen(key);
+        offset_t pos = MEMFILE_TELL(&in->file);
+        char next = *MEMFILE_PEEK(&in->file, sizeof(char));
+        if (in->sorted_last && (next == 0 || next == MOBJECT_END)) {
+                u64 last_len;
+                MEMFILE_SAVE_POSITION(&in->file);
+                MEMFILE_SEEK(&in->file, in->sorted_last);
+                const char *last = string_field_nomarker_read(&last_len, &in->file);
+                bool in_order = internal_obj_it_key_cmp(last, last_len, key, key_len) <= 0;
+                MEMFILE_RESTORE_POSITION(&in->file);
+                if (in_order) {
+                        in->sorted_last = pos;
+                        return;
+                }
+        }
+
+        obj_it scan;
+        bool appended = true;
+        internal_obj_it_create(&scan, &in->file, in->context.object->begin);
+        pos = MEMFILE_TELL(&scan.file);
+        while (obj_it_next(&scan)) {
+                string_field name = internal_obj_it_prop_name(&scan);
+                if (internal_obj_it_key_cmp(name.str, name.len, key, key_len) > 0) {
+                        pos = scan.last_off;
+                        appended = false;
+                        break;
+                }
+                pos = MEMFILE_TELL(&scan.file);
+        }
+        /** inserting before the last property moves it */
+        in->sorted_last = appended ? pos : 0;
+        MEMFILE_SEEK(&in->file, pos);
+}
+
 bool insert_prop_null(insert *in, const char *key)
 {
         ERROR_IF_AND_RETURN(in->context_type != OBJECT, ERR_UNSUPPCONTAINER, NULL);
+        insert_prop_seek_sorted(in, key);
         offset_t prop_start = MEMFILE_TELL(&in->file);
         string_field_nomarker_write(&in->file, key);
         push_media_type_for_array(in, FIELD_NULL);
@@ -669,6 +770,7 @@ bool insert_prop_null(insert *in, const char *key)
 bool insert_prop_true(insert *in, const char *key)
 {
         ERROR_IF_AND_RETURN(in->context_type != OBJECT, ERR_UNSUPPCONTAINER, NULL);
+        insert_prop_seek_sorted(in, key);
         offset_t prop_start = MEMFILE_TELL(&in->file);
         string_field_nomarker_write(&in->file, key);
         push_media_type_for_array(in, FIELD_TRUE);
@@ -680,6 +782,7 @@ bool insert_prop_true(insert *in, const char *key)
 bool insert_prop_false(insert *in, const char *key)
 {
         ERROR_IF_AND_RETURN(in->context_type != OBJECT, ERR_UNSUPPCONTAINER, NULL);
+        insert_prop_seek_sorted(in, key);
         offset_t prop_start = MEMFILE_TELL(&in->file);
         string_field_nomarker_write(&in->file, key);
         push_media_type_for_array(in, FIELD_FALSE);
@@ -691,6 +794,7 @@ bool insert_prop_false(insert *in, const char *key)
 bool insert_prop_u8(insert *in, const char *key, u8 value)
 {
         ERROR_IF_AND_RETURN(in->context_type != OBJECT, ERR_UNSUPPCONTAINER, NULL);
+        insert_prop_seek_sorted(in, key);
         offset_t prop_start = MEMFILE_TELL(&in->file);
         string_field_nomarker_write(&in->file, key);
         write_field_data(in, FIELD_NUMBER_U8, &value, sizeof(u8));
@@ -702,6 +806,7 @@ bool insert_prop_u8(insert *in, const char *key, u8 value)
 bool insert_prop_u16(insert *in, const char *key, u16 value)
 {
         ERROR_IF_AND_RETURN(in->context_type != OBJECT, ERR_UNSUPPCONTAINER, NULL);
+        insert_prop_seek_sorted(in, key);
         offset_t prop_start = MEMFILE_TELL(&in->file);
         string_field_nomarker_write(&in->file, key);
         write_field_data(in, FIELD_NUMBER_U16, &value, sizeof(u16));
@@ -713,6 +818,7 @@ bool insert_prop_u16(insert *in, const char *key, u16 value)
 bool insert_prop_u32(insert *in, const char *key, u32 value)
 {
         ERROR_IF_AND_RETURN(in->context_type != OBJECT, ERR_UNSUPPCONTAINER, NULL);
+        insert_prop_seek_sorted(in, key);
         offset_t prop_start = MEMFILE_TELL(&in->file);
         string_field_nomarker_write(&in->file, key);
         write_field_data(in, FIELD_NUMBER_U32, &value, sizeof(u32));
@@ -724,6 +830,7 @@ bool insert_prop_u32(insert *in, const char *key, u32 value)
 bool insert_prop_u64(insert *in, const char *key, u64 value)
 {
         ERROR_IF_AND_RETURN(in->context_type != OBJECT, ERR_UNSUPPCONTAINER, NULL);
+        insert_prop_seek_sorted(in, key);
         offset_t prop_start = MEMFILE_TELL(&in->file);
         string_field_nomarker_write(&in->file, key);
         write_field_data(in, FIELD_NUMBER_U64, &value, sizeof(u64));
@@ -735,6 +842,7 @@ bool insert_prop_u64(insert *in, const char *key, u64 value)
 bool insert_prop_i8(insert *in, const char *key, i8 value)
 {
         ERROR_IF_AND_RETURN(in->context_type != OBJECT, ERR_UNSUPPCONTAINER, NULL);
+        insert_prop_seek_sorted(in, key);
         offset_t prop_start = MEMFILE_TELL(&in->file);
         string_field_nomarker_write(&in->file, key);
         write_field_data(in, FIELD_NUMBER_I8, &value, sizeof(i8));
@@ -746,6 +854,7 @@ bool insert_prop_i8(insert *in, const char *key, i8 value)
 bool insert_prop_i16(insert *in, const char *key, i16 value)
 {
         ERROR_IF_AND_RETURN(in->context_type != OBJECT, ERR_UNSUPPCONTAINER, NULL);
+        insert_prop_seek_sorted(in, key);
         offset_t prop_start = MEMFILE_TELL(&in->file);
         string_field_nomarker_write(&in->file, key);
         write_field_data(in, FIELD_NUMBER_I16, &value, sizeof(i16));
@@ -757,6 +866,7 @@ bool insert_prop_i16(insert *in, const char *key, i16 value)
 bool insert_prop_i32(insert *in, const char *key, i32 value)
 {
         ERROR_IF_AND_RETURN(in->context_type != OBJECT, ERR_UNSUPPCONTAINER, NULL);
+        insert_prop_seek_sorted(in, key);
         offset_t prop_start = MEMFILE_TELL(&in->file);
         string_field_nomarker_write(&in->file, key);
         write_field_data(in, FIELD_NUMBER_I32, &value, sizeof(i32));
@@ -768,6 +878,7 @@ bool insert_prop_i32(insert *in, const char *key, i32 value)
 bool insert_prop_i64(insert *in, const char *key, i64 value)
 {
         ERROR_IF_AND_RETURN(in->context_type != OBJECT, ERR_UNSUPPCONTAINER, NULL);
+        insert_prop_seek_sorted(in, key);
         offset_t prop_start = MEMFILE_TELL(&in->file);
         string_field_nomarker_write(&in->file, key);
         write_field_data(in, FIELD_NUMBER_I64, &value, sizeof(i64));
@@ -815,6 +926,7 @@ bool insert_prop_signed(insert *in, const char *key, i64 value)
 bool insert_prop_float(insert *in, const char *key, float value)
 {
         ERROR_IF_AND_RETURN(in->context_type != OBJECT, ERR_UNSUPPCONTAINER, NULL);
+        insert_prop_seek_sorted(in, key);
         offset_t prop_start = MEMFILE_TELL(&in->file);
         string_field_nomarker_write(&in->file, key);
         write_field_data(in, FIELD_NUMBER_FLOAT, &value, sizeof(float));
@@ -831,6 +943,7 @@ bool insert_prop_string(insert *in, const char *key, const char *value)
 bool insert_prop_nchar(insert *in, const char *key, const char *value, u64 value_len)
 {
         ERROR_IF_AND_RETURN(in->context_type != OBJECT, ERR_UNSUPPCONTAINER, NULL);
+        insert_prop_seek_sorted(in, key);
         offset_t prop_start = MEMFILE_TELL(&in->file);
         string_field_nomarker_write(&in->file, key);
         string_field_nchar_write(&in->file, value, value_len);
@@ -843,6 +956,7 @@ bool insert_prop_binary(insert *in, const char *key, const void *value,
                                size_t nbytes, const char *file_ext, const char *user_type)
 {
         ERROR_IF_AND_RETURN(in->context_type != OBJECT, ERR_UNSUPPCONTAINER, NULL);
+        insert_prop_seek_sorted(in, key);
         offset_t prop_start = MEMFILE_TELL(&in->file);
         string_field_nomarker_write(&in->file, key);
         _insert_binary(in, value, nbytes, file_ext, user_type);
@@ -856,6 +970,7 @@ static insert *__insert_prop_object_container_begin(obj_state *out,
                                                        u64 object_capacity)
 {
         ERROR_IF_AND_RETURN(in->context_type != OBJECT, ERR_UNSUPPCONTAINER, NULL);
+        insert_prop_seek_sorted(in, key);
         string_field_nomarker_write(&in->file, key);
         return insert_object_map_begin(out, in, derivation, object_capacity);
 }
@@ -890,6 +1005,7 @@ insert *insert_prop_array_begin(arr_state *state,
                                                          u64 array_capacity)
 {
         ERROR_IF_AND_RETURN(in->context_type != OBJECT, ERR_UNSUPPCONTAINER, NULL);
+        insert_prop_seek_sorted(in, key);
         string_field_nomarker_write(&in->file, key);
         return insert_array_begin(state, in, array_capacity);
 }
@@ -905,6 +1021,7 @@ insert *insert_prop_column_begin(col_state *state_out,
                                                           col_it_type_e type, u64 cap)
 {
         ERROR_IF_AND_RETURN(inserter_in->context_type != OBJECT, ERR_UNSUPPCONTAINER, NULL);
+        insert_prop_seek_sorted(inserter_in, key);
         string_field_nomarker_write(&inserter_in->file, key);
         return insert_column_begin(state_out, inserter_in, type, cap);
 }
@@ -925,17 +1042,57 @@ write_field_data(insert *in, u8 field_marker, const void *base, u64 nbytes)
         return MEMFILE_WRITE(&in->file, base, nbytes);
 }
 
+/** grows the capacity of the column, whose element counter is already updated, such that it holds num_elems values */
+static void column_grow(insert *in, u32 capacity, u32 num_elems, size_t type_size)
+{
+        MEMFILE_SAVE_POSITION(&in->file);
+
+        /** capacities grow geometrically, such that appending values one after another takes amortized constant time */
+        u32 new_capacity = (capacity + 1) * 1.7f;
+        new_capacity = JAK_MAX(new_capacity, num_elems);
+
+        // Update capacity counter
+        MEMFILE_SEEK(&in->file, in->context.column->header_begin);
+        MEMFILE_SKIP_UINTVAR_STREAM(&in->file); // skip num element counter
+        MEMFILE_UPDATE_UINTVAR_STREAM(&in->file, new_capacity);
+        in->context.column->cap = new_capacity;
+
+        size_t payload_start = internal_column_get_payload_off(in->context.column);
+        MEMFILE_SEEK(&in->file, payload_start + capacity * type_size);
+        MEMFILE_ENSURE_SPACE(&in->file, (new_capacity - capacity) * type_size);
+
+        MEMFILE_RESTORE_POSITION(&in->file);
+}
+
 static bool push_in_column(insert *in, const void *base, field_e type)
 {
         assert(in->context_type == COLUMN);
 
         size_t type_size = INTERNAL_GET_TYPE_VALUE_SIZE(type);
+        col_it *column = in->context.column;
 
         MEMFILE_SAVE_POSITION(&in->file);
 
-        // Increase element counter
-        MEMFILE_SEEK(&in->file, in->context.column->header_begin);
+        MEMFILE_SEEK(&in->file, column->header_begin);
         u32 num_elems = MEMFILE_PEEK_UINTVAR_STREAM(NULL, &in->file);
+
+        /** values of sorted columns are inserted at their position in the sort order (after equal values) */
+        u32 pos = num_elems;
+        if (num_elems > 0 && col_it_is_sorted(column)) {
+                bool is_set = !col_it_is_multiset(column);
+                MEMFILE_SEEK(&in->file, internal_column_get_payload_off(column));
+                const char *values = MEMFILE_PEEK(&in->file, num_elems * type_size);
+                pos = internal_col_it_bound(column->field_type, values, num_elems, base, !is_set);
+                if (is_set && pos < num_elems &&
+                    internal_col_it_value_cmp(column->field_type, values + pos * type_size, base) == 0) {
+                        /** a set does not contain duplicates */
+                        MEMFILE_RESTORE_POSITION(&in->file);
+                        return true;
+                }
+                MEMFILE_SEEK(&in->file, column->header_begin);
+        }
+
+        // Increase element counter
         num_elems++;
         MEMFILE_UPDATE_UINTVAR_STREAM(&in->file, num_elems);
         in->context.column->num = num_elems;
@@ -943,26 +1100,59 @@ static bool push_in_column(insert *in, const void *base, field_e type)
         u32 capacity = MEMFILE_READ_UINTVAR_STREAM(NULL, &in->file);
 
         if (UNLIKELY(num_elems > capacity)) {
-                MEMFILE_SAVE_POSITION(&in->file);
+                column_grow(in, capacity, num_elems, type_size);
+        }
 
-                u32 new_capacity = (capacity + 1) * 1.7f;
+        size_t payload_start = internal_column_get_payload_off(in->context.column);
+        MEMFILE_SEEK(&in->file, payload_start + pos * type_size);
+        if (pos + 1 < num_elems) {
+                char *slot = MEMFILE_PEEK_MUT(&in->file, (num_elems - pos) * type_size);
+                if (UNLIKELY(!slot)) {
+                        MEMFILE_RESTORE_POSITION(&in->file);
+                        return false;
+                }
+                memmove(slot + type_size, slot, (num_elems - pos - 1) * type_size);
+        }
+        MEMFILE_WRITE(&in->file, base, type_size);
+
+        MEMFILE_RESTORE_POSITION(&in->file);
+        return true;
+}
 
-                // Update capacity counter
-                MEMFILE_SEEK(&in->file, in->context.column->header_begin);
-                MEMFILE_SKIP_UINTVAR_STREAM(&in->file); // skip num element counter
-                MEMFILE_UPDATE_UINTVAR_STREAM(&in->file, new_capacity);
-                in->context.column->cap = new_capacity;
+static bool push_values_in_column(insert *in, const void *values, u32 num_values)
+{
+        assert(in->context_type == COLUMN);
 
-                size_t payload_start = internal_column_get_payload_off(in->context.column);
-                MEMFILE_SEEK(&in->file, payload_start + (num_elems - 1) * type_size);
-                MEMFILE_ENSURE_SPACE(&in->file, (new_capacity - capacity) * type_size);
+        col_it *column = in->context.column;
+        size_t type_size = INTERNAL_GET_TYPE_VALUE_SIZE(column->field_type);
 
-                MEMFILE_RESTORE_POSITION(&in->file);
+        if (num_values == 0) {
+                return true;
+        }
+        if (col_it_is_sorted(column)) {
+                /** each value is inserted at its position in the sort order */
+                for (u32 i = 0; i < num_values; i++) {
+                        push_in_column(in, (const char *) values + i * type_size, column->field_type);
+                }
+                return true;
         }
 
-        size_t payload_start = internal_column_get_payload_off(in->context.column);
-        MEMFILE_SEEK(&in->file, payload_start + (num_elems - 1) * type_size);
-        MEMFILE_WRITE(&in->file, base, type_size);
+        MEMFILE_SAVE_POSITION(&in->file);
+
+        MEMFILE_SEEK(&in->file, column->header_begin);
+        u32 num_elems = MEMFILE_PEEK_UINTVAR_STREAM(NULL, &in->file);
+        u32 new_num_elems = num_elems + num_values;
+        MEMFILE_UPDATE_UINTVAR_STREAM(&in->file, new_num_elems);
+        column->num = new_num_elems;
+
+        u32 capacity = MEMFILE_READ_UINTVAR_STREAM(NULL, &in->file);
+        if (new_num_elems > capacity) {
+                column_grow(in, capacity, new_num_elems, type_size);
+        }
+
+        size_t payload_start = internal_column_get_payload_off(column);
+        MEMFILE_SEEK(&in->file, payload_start + num_elems * type_size);
+        MEMFILE_WRITE(&in->file, values, num_values * type_size);
 
         MEMFILE_RESTORE_POSITION(&in->file);
         return true;
@@ -978,6 +1168,7 @@ static void internal_create(insert *in, memfile *src, offset_t pos)
 {
         MEMFILE_CLONE(&in->file, src);
         in->position = pos ? pos : MEMFILE_TELL(src);
+        in->sorted_last = 0;
         MEMFILE_SEEK(&in->file, in->position);
 }
 
@@ -44,6 +44,24 @@ bool insert_float(insert *in, float value);
 bool insert_string(insert *in, const char *value);
 bool insert_nchar(insert *in, const char *value, u64 value_len);
 
+/**
+ * Inserts the <code>num_values</code> values in <code>values</code>, one after another. Null values are given by the
+ * null value of their type; for booleans, the values are <code>CARBON_BOOLEAN_COLUMN_*</code> bytes. If <code>in</code>
+ * inserts into an unsorted column, the column grows at most once, and the values are copied with a single write. Into
+ * sorted columns and arrays, the values are inserted one by one, where null values become null fields in arrays.
+ * Nothing is inserted into a column of another element type, which fails with <code>ERR_TYPEMISMATCH</code>.
+ */
+bool insert_boolean_values(insert *in, const boolean *values, u32 num_values);
+bool insert_u8_values(insert *in, const u8 *values, u32 num_values);
+bool insert_u16_values(insert *in, const u16 *values, u32 num_values);
+bool insert_u32_values(insert *in, const u32 *values, u32 num_values);
+bool insert_u64_values(insert *in, const u64 *values, u32 num_values);
+bool insert_i8_values(insert *in, const i8 *values, u32 num_values);
+bool insert_i16_values(insert *in, const i16 *values, u32 num_values);
+bool insert_i32_values(insert *in, const i32 *values, u32 num_values);
+bool insert_i64_values(insert *in, const i64 *values, u32 num_values);
+bool insert_float_values(insert *in, const float *values, u32 num_values);
+
 bool insert_from_carbon(); // TODO: Implement P2
 bool insert_from_array(); // TODO: Implement P2
 bool insert_from_object(); // TODO: Implement P2
@@ -77,6 +95,12 @@ bool insert_column_end(col_state *state_in);
 insert *insert_column_list_begin(col_state *state_out, insert *inserter_in, list_type_e derivation, col_it_type_e type, u64 cap);
 bool insert_column_list_end(col_state *state_in);
 
+/**
+ * Inserts properties into the object <code>in</code> inserts into. Into sorted maps (see
+ * <code>insert_object_map_begin</code>), each property is inserted behind the last property whose key is not greater
+ * than <code>key</code> (compared bytewise) such that the properties stay in order of their keys. Properties with equal
+ * keys keep the order of their insertion.
+ */
 bool insert_prop_null(insert *in, const char *key);
 bool insert_prop_true(insert *in, const char *key);
 bool insert_prop_false(insert *in, const char *key);
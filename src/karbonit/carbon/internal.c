@@ -196,6 +196,9 @@ bool internal_array_field_read(arr_it *it)
 
 bool internal_field_data_access(memfile *file, field *field)
 {
+        /** number of bytes accessible via the data pointer */
+        u64 data_len = 1;
+
         MEMFILE_SAVE_POSITION(file);
         MEMFILE_SKIP(file, sizeof(media_type));
 
@@ -217,6 +220,7 @@ bool internal_field_data_access(memfile *file, field *field)
                         u8 nbytes;
                         uintvar_stream_t len = (uintvar_stream_t) MEMFILE_PEEK(file, 1);
                         field->len = UINTVAR_STREAM_READ(&nbytes, len);
+                        data_len = field->len;
 
                         MEMFILE_SKIP(file, nbytes);
                 }
@@ -230,6 +234,7 @@ bool internal_field_data_access(memfile *file, field *field)
 
                         /** read blob length */
                         field->len = MEMFILE_READ_UINTVAR_STREAM(NULL, file);
+                        data_len = field->len;
 
                         /** the mem points now to the actual blob data, which is used by the iterator to set the field */
                 }
@@ -241,6 +246,7 @@ bool internal_field_data_access(memfile *file, field *field)
 
                         /** read blob length */
                         field->len = MEMFILE_READ_UINTVAR_STREAM(NULL, file);
+                        data_len = field->len;
 
                         /** the mem points now to the actual blob data, which is used by the iterator to set the field */
                 }
@@ -301,7 +307,7 @@ bool internal_field_data_access(memfile *file, field *field)
                         return ERROR(ERR_CORRUPTED, NULL);
         }
 
-        field->data = MEMFILE_PEEK(file, 1);
+        field->data = MEMFILE_PEEK(file, JAK_MAX(1, data_len));
         MEMFILE_RESTORE_POSITION(file);
         return true;
 }
@@ -1123,6 +1129,493 @@ void internal_from_json(rec *doc, const json *data,
         rec_create_end(&context);
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+//  streaming conversion from JSON
+// ---------------------------------------------------------------------------------------------------------------------
+
+#define FROM_JSON_OBJECT_CAP    256
+#define FROM_JSON_ARRAY_CAP     256
+
+/* a number, boolean, or null value of an array that may become a column */
+typedef struct from_json_value {
+        json_value_type_e type;
+        json_number number;
+} from_json_value;
+
+/* summary of the values of a pending array, from which the narrowest column type is determined */
+typedef struct from_json_range {
+        u32 num_values;
+        u32 num_nulls;
+        u32 num_booleans;
+        u32 num_floats;
+        /* least negative integer (0 if there is none), and greatest non-negative integer */
+        i64 min;
+        u64 max;
+        /* true if an integer cannot be represented exactly as float, i.e., the values do not fit a float column */
+        bool inexact_as_float;
+} from_json_range;
+
+typedef struct from_json_stream {
+        json_tokenizer tokenizer;
+        /* options for record creation, see rec_create_begin */
+        int mode;
+        /* current token, or NULL at the end of the input */
+        const json_token *token;
+        /* key of the current property */
+        vec ofType(char) key;
+        /* the innermost array is pending (not yet inserted) as long as it contains numbers, booleans, and nulls only,
+         * since it becomes a column (with option COLUMNAR) unless another value follows */
+        insert *pending_parent;
+        bool pending_is_root;
+        bool pending_is_prop;
+        vec ofType(char) pending_key;
+        json_list_type_e pending_type;
+        from_json_range pending_range;
+        vec ofType(from_json_value) pending_values;
+} from_json_stream;
+
+static bool from_json_value_any(from_json_stream *stream, insert *ins, const char *key, bool is_root);
+
+static void from_json_next(from_json_stream *stream)
+{
+        stream->token = json_tokenizer_next(&stream->tokenizer);
+}
+
+static bool from_json_is(from_json_stream *stream, json_token_e type)
+{
+        return stream->token && stream->token->type == type;
+}
+
+static void from_json_copy_key(vec ofType(char) *dst, const char *key, size_t key_len)
+{
+        vec_clear(dst);
+        vec_push(dst, key, key_len);
+        char end = '\0';
+        vec_push(dst, &end, 1);
+}
+
+/* reads the number, boolean, or null at the current token; returns false for other tokens */
+static bool from_json_scalar(from_json_value *value, from_json_stream *stream)
+{
+        if (!stream->token) {
+                return false;
+        }
+        switch (stream->token->type) {
+                case LITERAL_INT:
+                case LITERAL_FLOAT:
+                        value->type = JSON_VALUE_NUMBER;
+                        json_number_from_token(&value->number, stream->token);
+                        return true;
+                case LITERAL_TRUE:
+                        value->type = JSON_VALUE_TRUE;
+                        return true;
+                case LITERAL_FALSE:
+                        value->type = JSON_VALUE_FALSE;
+                        return true;
+                case LITERAL_NULL:
+                        value->type = JSON_VALUE_NULL;
+                        return true;
+                default:
+                        return false;
+        }
+}
+
+/* rejects the integers that are reserved for null, i.e., that have no representation as a number field */
+static bool from_json_check_scalar(const from_json_value *value)
+{
+        if (value->type == JSON_VALUE_NUMBER &&
+            ((value->number.value_type == JSON_NUMBER_UNSIGNED && value->number.value.unsigned_integer == U64_NULL) ||
+             (value->number.value_type == JSON_NUMBER_SIGNED && value->number.value.signed_integer == I64_NULL))) {
+                return ERROR(ERR_UNSUPPORTEDTYPE, "integer is out of range since it is reserved for null");
+        }
+        return true;
+}
+
+static void from_json_insert_scalar(insert *ins, const char *key, const from_json_value *value)
+{
+        switch (value->type) {
+                case JSON_VALUE_NUMBER:
+                        switch (value->number.value_type) {
+                                case JSON_NUMBER_FLOAT:
+                                        key ? insert_prop_float(ins, key, value->number.value.float_number) :
+                                              insert_float(ins, value->number.value.float_number);
+                                        break;
+                                case JSON_NUMBER_UNSIGNED:
+                                        key ? insert_prop_unsigned(ins, key, value->number.value.unsigned_integer) :
+                                              insert_unsigned(ins, value->number.value.unsigned_integer);
+                                        break;
+                                case JSON_NUMBER_SIGNED:
+                                        key ? insert_prop_signed(ins, key, value->number.value.signed_integer) :
+                                              insert_signed(ins, value->number.value.signed_integer);
+                                        break;
+                                default: ERROR(ERR_UNSUPPORTEDTYPE, NULL);
+                                        break;
+                        }
+                        break;
+                case JSON_VALUE_TRUE:
+                        key ? insert_prop_true(ins, key) : insert_true(ins);
+                        break;
+                case JSON_VALUE_FALSE:
+                        key ? insert_prop_false(ins, key) : insert_false(ins);
+                        break;
+                case JSON_VALUE_NULL:
+                        key ? insert_prop_null(ins, key) : insert_null(ins);
+                        break;
+                default: ERROR(ERR_UNSUPPORTEDTYPE, NULL);
+                        break;
+        }
+}
+
+#define FROM_JSON_AS_UNSIGNED(number)                                                                                  \
+        ((number)->value_type == JSON_NUMBER_SIGNED ? (u64) (number)->value.signed_integer :                           \
+                                                     (number)->value.unsigned_integer)
+#define FROM_JSON_AS_SIGNED(number)                                                                                    \
+        ((number)->value_type == JSON_NUMBER_UNSIGNED ? (i64) (number)->value.unsigned_integer :                       \
+                                                        (number)->value.signed_integer)
+#define FROM_JSON_AS_FLOAT(number)                                                                                     \
+        ((number)->value_type == JSON_NUMBER_FLOAT ? (number)->value.float_number :                                    \
+         (number)->value_type == JSON_NUMBER_SIGNED ? (float) (number)->value.signed_integer :                         \
+                                                      (float) (number)->value.unsigned_integer)
+
+static void from_json_pending_begin(from_json_stream *stream, insert *parent, const char *key, bool is_root)
+{
+        stream->pending_parent = parent;
+        stream->pending_is_root = is_root;
+        stream->pending_is_prop = key != NULL;
+        if (key) {
+                from_json_copy_key(&stream->pending_key, key, strlen(key));
+        }
+        stream->pending_type = JSON_LIST_EMPTY;
+        ZERO_MEMORY(&stream->pending_range, sizeof(from_json_range));
+        vec_clear(&stream->pending_values);
+}
+
+#define FROM_JSON_FLOAT_EXACT_MAX       (1u << 24)
+
+static void from_json_range_add(from_json_range *range, const from_json_value *value)
+{
+        range->num_values++;
+        switch (value->type) {
+                case JSON_VALUE_NULL:
+                        range->num_nulls++;
+                        break;
+                case JSON_VALUE_TRUE:
+                case JSON_VALUE_FALSE:
+                        range->num_booleans++;
+                        break;
+                case JSON_VALUE_NUMBER:
+                        if (value->number.value_type == JSON_NUMBER_FLOAT) {
+                                range->num_floats++;
+                        } else if (value->number.value_type == JSON_NUMBER_SIGNED &&
+                                   value->number.value.signed_integer < 0) {
+                                i64 number = value->number.value.signed_integer;
+                                range->min = JAK_MIN(range->min, number);
+                                range->inexact_as_float |= number < -(i64) FROM_JSON_FLOAT_EXACT_MAX;
+                        } else {
+                                u64 number = FROM_JSON_AS_UNSIGNED(&value->number);
+                                range->max = JAK_MAX(range->max, number);
+                                range->inexact_as_float |= number > FROM_JSON_FLOAT_EXACT_MAX;
+                        }
+                        break;
+                default: ERROR(ERR_UNSUPPORTEDTYPE, NULL);
+                        break;
+        }
+}
+
+/* returns the narrowest column type that holds all values of the range, with nulls encoded in that type, or
+ * JSON_LIST_VARIABLE_OR_NESTED if there is none. The bounds of each type exclude its null value (e.g., CARBON_U8_MAX
+ * is U8_NULL - 1), such that a value is never stored as null; the null values of 64-bit integers are rejected by
+ * from_json_check_scalar before. */
+static json_list_type_e from_json_range_type(const from_json_range *range)
+{
+        u32 num_numbers = range->num_values - range->num_nulls - range->num_booleans;
+        if (range->num_values == range->num_nulls) {
+                return range->num_values ? JSON_LIST_FIXED_NULL : JSON_LIST_EMPTY;
+        } else if (range->num_booleans) {
+                return num_numbers ? JSON_LIST_VARIABLE_OR_NESTED : JSON_LIST_FIXED_BOOLEAN;
+        } else if (range->num_floats) {
+                return range->inexact_as_float ? JSON_LIST_VARIABLE_OR_NESTED : JSON_LIST_FIXED_FLOAT;
+        } else if (range->min == 0) {
+                return range->max <= CARBON_U8_MAX ? JSON_LIST_FIXED_U8 :
+                       range->max <= CARBON_U16_MAX ? JSON_LIST_FIXED_U16 :
+                       range->max <= CARBON_U32_MAX ? JSON_LIST_FIXED_U32 :
+                       range->max <= CARBON_U64_MAX ? JSON_LIST_FIXED_U64 : JSON_LIST_VARIABLE_OR_NESTED;
+        } else {
+                return range->min >= CARBON_I8_MIN && range->max <= CARBON_I8_MAX ? JSON_LIST_FIXED_I8 :
+                       range->min >= CARBON_I16_MIN && range->max <= CARBON_I16_MAX ? JSON_LIST_FIXED_I16 :
+                       range->min >= CARBON_I32_MIN && range->max <= CARBON_I32_MAX ? JSON_LIST_FIXED_I32 :
+                       range->min >= CARBON_I64_MIN && range->max <= CARBON_I64_MAX ? JSON_LIST_FIXED_I64 :
+                       JSON_LIST_VARIABLE_OR_NESTED;
+        }
+}
+
+static const char *from_json_pending_key(from_json_stream *stream)
+{
+        return stream->pending_is_prop ? vec_data(&stream->pending_key) : NULL;
+}
+
+/* inserts the pending array as an array, and returns the inserter for its further elements */
+static insert *from_json_pending_to_array(arr_state *state, from_json_stream *stream)
+{
+        insert *array_ins = stream->pending_parent;
+        const char *key = from_json_pending_key(stream);
+        if (!stream->pending_is_root) {
+                array_ins = key ? insert_prop_array_begin(state, stream->pending_parent, key, FROM_JSON_ARRAY_CAP) :
+                                  insert_array_begin(state, stream->pending_parent, FROM_JSON_ARRAY_CAP);
+        }
+        for (u32 i = 0; i < stream->pending_values.num_elems; i++) {
+                from_json_insert_scalar(array_ins, NULL, VEC_GET(&stream->pending_values, i, from_json_value));
+        }
+        return array_ins;
+}
+
+#define FROM_JSON_COLUMN(stream, ctype, column_type, null_value, convert)                                              \
+{                                                                                                                      \
+        u32 num_values = (stream)->pending_values.num_elems;                                                           \
+        const from_json_value *values = VEC_ALL(&(stream)->pending_values, from_json_value);                           \
+        ctype *column_values = MALLOC(JAK_MAX(1u, num_values) * sizeof(ctype));                                       \
+        for (u32 i = 0; i < num_values; i++) {                                                                         \
+                const json_number *number = &values[i].number; UNUSED(number);                                        \
+                column_values[i] = values[i].type == JSON_VALUE_NULL ? (ctype) (null_value) : (ctype) (convert);       \
+        }                                                                                                              \
+        const char *column_key = from_json_pending_key(stream);                                                        \
+        col_state state;                                                                                               \
+        insert *cins = column_key ?                                                                                    \
+                insert_prop_column_begin(&state, (stream)->pending_parent, column_key, column_type, num_values) :      \
+                insert_column_begin(&state, (stream)->pending_parent, column_type, num_values);                        \
+        insert_##ctype##_values(cins, column_values, num_values);                                                      \
+        insert_column_end(&state);                                                                                     \
+        free(column_values);                                                                                           \
+}
+
+/* inserts the completed pending array by the type of its values, i.e., into columns if possible */
+static void from_json_pending_end(from_json_stream *stream)
+{
+        const from_json_value *values = VEC_ALL(&stream->pending_values, from_json_value);
+        u32 num_values = stream->pending_values.num_elems;
+
+        if (stream->pending_is_root) {
+                /** elements of the record itself */
+                for (u32 i = 0; i < num_values; i++) {
+                        const json_number *number = &values[i].number;
+                        if (values[i].type != JSON_VALUE_NUMBER) {
+                                from_json_insert_scalar(stream->pending_parent, NULL, values + i);
+                        } else if (stream->pending_type == JSON_LIST_FIXED_FLOAT) {
+                                insert_float(stream->pending_parent, FROM_JSON_AS_FLOAT(number));
+                        } else if (stream->pending_type >= JSON_LIST_FIXED_I8) {
+                                insert_signed(stream->pending_parent, FROM_JSON_AS_SIGNED(number));
+                        } else {
+                                insert_unsigned(stream->pending_parent, FROM_JSON_AS_UNSIGNED(number));
+                        }
+                }
+                return;
+        }
+
+        switch (stream->pending_type) {
+                case JSON_LIST_EMPTY:
+                case JSON_LIST_FIXED_NULL: {
+                        arr_state state;
+                        from_json_pending_to_array(&state, stream);
+                        insert_array_end(&state);
+                }
+                        break;
+                case JSON_LIST_FIXED_U8:
+                        FROM_JSON_COLUMN(stream, u8, COLUMN_U8, U8_NULL, FROM_JSON_AS_UNSIGNED(number))
+                        break;
+                case JSON_LIST_FIXED_U16:
+                        FROM_JSON_COLUMN(stream, u16, COLUMN_U16, U16_NULL, FROM_JSON_AS_UNSIGNED(number))
+                        break;
+                case JSON_LIST_FIXED_U32:
+                        FROM_JSON_COLUMN(stream, u32, COLUMN_U32, U32_NULL, FROM_JSON_AS_UNSIGNED(number))
+                        break;
+                case JSON_LIST_FIXED_U64:
+                        FROM_JSON_COLUMN(stream, u64, COLUMN_U64, U64_NULL, FROM_JSON_AS_UNSIGNED(number))
+                        break;
+                case JSON_LIST_FIXED_I8:
+                        FROM_JSON_COLUMN(stream, i8, COLUMN_I8, I8_NULL, FROM_JSON_AS_SIGNED(number))
+                        break;
+                case JSON_LIST_FIXED_I16:
+                        FROM_JSON_COLUMN(stream, i16, COLUMN_I16, I16_NULL, FROM_JSON_AS_SIGNED(number))
+                        break;
+                case JSON_LIST_FIXED_I32:
+                        FROM_JSON_COLUMN(stream, i32, COLUMN_I32, I32_NULL, FROM_JSON_AS_SIGNED(number))
+                        break;
+                case JSON_LIST_FIXED_I64:
+                        FROM_JSON_COLUMN(stream, i64, COLUMN_I64, I64_NULL, FROM_JSON_AS_SIGNED(number))
+                        break;
+                case JSON_LIST_FIXED_FLOAT:
+                        FROM_JSON_COLUMN(stream, float, COLUMN_FLOAT, CARBON_NULL_FLOAT, FROM_JSON_AS_FLOAT(number))
+                        break;
+                case JSON_LIST_FIXED_BOOLEAN: {
+                        FROM_JSON_COLUMN(stream, boolean, COLUMN_BOOLEAN, CARBON_BOOLEAN_COLUMN_NULL,
+                                         values[i].type == JSON_VALUE_TRUE ? CARBON_BOOLEAN_COLUMN_TRUE :
+                                                                             CARBON_BOOLEAN_COLUMN_FALSE)
+                }
+                        break;
+                default: ERROR(ERR_UNSUPPORTEDTYPE, NULL);
+                        break;
+        }
+}
+
+static bool from_json_array(from_json_stream *stream, insert *ins, const char *key, bool is_root)
+{
+        arr_state state;
+        insert *array_ins = NULL;
+        bool result = true;
+
+        from_json_next(stream); /** skip '[' */
+        from_json_pending_begin(stream, ins, key, is_root);
+        if (!is_root && !(stream->mode & COLUMNAR)) {
+                array_ins = from_json_pending_to_array(&state, stream);
+        }
+
+        if (from_json_is(stream, ARRAY_CLOSE)) {
+                from_json_next(stream);
+        } else while (true) {
+                from_json_value value;
+                if (from_json_scalar(&value, stream)) {
+                        if (UNLIKELY(!from_json_check_scalar(&value))) {
+                                result = false;
+                                break;
+                        }
+                        if (!array_ins) {
+                                from_json_range_add(&stream->pending_range, &value);
+                                stream->pending_type = from_json_range_type(&stream->pending_range);
+                                vec_push(&stream->pending_values, &value, 1);
+                                if (stream->pending_type == JSON_LIST_VARIABLE_OR_NESTED) {
+                                        array_ins = from_json_pending_to_array(&state, stream);
+                                }
+                        } else {
+                                from_json_insert_scalar(array_ins, NULL, &value);
+                        }
+                        from_json_next(stream);
+                } else {
+                        if (!array_ins) {
+                                array_ins = from_json_pending_to_array(&state, stream);
+                        }
+                        if (!(result = from_json_value_any(stream, array_ins, NULL, false))) {
+                                break;
+                        }
+                }
+                if (from_json_is(stream, COMMA)) {
+                        from_json_next(stream);
+                } else if (from_json_is(stream, ARRAY_CLOSE)) {
+                        from_json_next(stream);
+                        break;
+                } else {
+                        result = false;
+                        break;
+                }
+        }
+
+        if (!array_ins) {
+                if (result) {
+                        from_json_pending_end(stream);
+                }
+        } else if (!is_root) {
+                insert_array_end(&state);
+        }
+        return result;
+}
+
+static bool from_json_object(from_json_stream *stream, insert *ins, const char *key)
+{
+        obj_state state;
+        insert *oins = key ? insert_prop_object_begin(&state, ins, key, FROM_JSON_OBJECT_CAP) :
+                             insert_object_begin(&state, ins, FROM_JSON_OBJECT_CAP);
+        bool result = true;
+
+        from_json_next(stream); /** skip '{' */
+        if (from_json_is(stream, OBJECT_CLOSE)) {
+                from_json_next(stream);
+        } else while (true) {
+                if (!from_json_is(stream, LITERAL_STRING)) {
+                        result = false;
+                        break;
+                }
+                from_json_copy_key(&stream->key, stream->token->string, stream->token->length);
+                from_json_next(stream);
+                if (!from_json_is(stream, ASSIGN)) {
+                        result = false;
+                        break;
+                }
+                from_json_next(stream);
+                if (!(result = from_json_value_any(stream, oins, vec_data(&stream->key), false))) {
+                        break;
+                }
+                if (from_json_is(stream, COMMA)) {
+                        from_json_next(stream);
+                } else if (from_json_is(stream, OBJECT_CLOSE)) {
+                        from_json_next(stream);
+                        break;
+                } else {
+                        result = false;
+                        break;
+                }
+        }
+
+        insert_object_end(&state);
+        return result;
+}
+
+/* inserts the value at the current token into the container of ins, as property key if key is non-null */
+static bool from_json_value_any(from_json_stream *stream, insert *ins, const char *key, bool is_root)
+{
+        from_json_value value;
+        if (!stream->token) {
+                return false;
+        }
+        switch (stream->token->type) {
+                case OBJECT_OPEN:
+                        return from_json_object(stream, ins, key);
+                case ARRAY_OPEN:
+                        return from_json_array(stream, ins, key, is_root);
+                case LITERAL_STRING:
+                        key ? insert_prop_nchar(ins, key, stream->token->string, stream->token->length) :
+                              insert_nchar(ins, stream->token->string, stream->token->length);
+                        from_json_next(stream);
+                        return true;
+                default:
+                        if (!from_json_scalar(&value, stream) || !from_json_check_scalar(&value)) {
+                                return false;
+                        }
+                        from_json_insert_scalar(ins, key, &value);
+                        from_json_next(stream);
+                        return true;
+        }
+}
+
+bool internal_from_json_stream(rec *doc, const char *json, key_e rec_key_type, const void *primary_key, int mode)
+{
+        UNUSED(primary_key)
+
+        from_json_stream stream;
+        ZERO_MEMORY(&stream, sizeof(from_json_stream));
+        json_tokenizer_init(&stream.tokenizer, json);
+        stream.mode = mode;
+        vec_create(&stream.key, sizeof(char), 64);
+        vec_create(&stream.pending_key, sizeof(char), 64);
+        vec_create(&stream.pending_values, sizeof(from_json_value), 64);
+        from_json_next(&stream);
+
+        bool result = stream.token != NULL;
+        if (result) {
+                rec_new context;
+                insert *ins = rec_create_begin(&context, doc, rec_key_type, mode);
+                /** the document must consist of exactly one value */
+                result = from_json_value_any(&stream, ins, NULL, true) && stream.token == NULL;
+                rec_create_end(&context);
+                if (!result) {
+                        rec_drop(doc);
+                }
+        }
+
+        vec_drop(&stream.key);
+        vec_drop(&stream.pending_key);
+        vec_drop(&stream.pending_values);
+        return result;
+}
+
 static void marker_insert(memfile *memfile, u8 marker)
 {
         /** check whether marker can be written, otherwise make space for it */
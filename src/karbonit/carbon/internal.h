@@ -34,6 +34,8 @@ typedef struct insert {
         } context;
         memfile file;
         offset_t position;
+        /* in sorted maps, offset of the key of the last property this inserter appended, or 0 if unknown */
+        offset_t sorted_last;
 } insert;
 
 typedef struct arr_state {
@@ -305,6 +307,14 @@ bool internal_field_remove(memfile *memfile, field_e type);
  */
 void internal_from_json(rec *doc, const json *data, key_e rec_key_type, const void *primary_key, int mode);
 
+/**
+ * Converts the JSON document <code>json</code> into the same record as <code>internal_from_json</code> does for its
+ * AST, but inserts into the record while tokenizing <code>json</code>, without a token stream or an AST. Only the
+ * values of an array that may become a column are held until the end of the array. Returns false, and leaves
+ * <code>doc</code> uninitialized, if <code>json</code> is not a valid JSON document.
+ */
+bool internal_from_json_stream(rec *doc, const char *json, key_e rec_key_type, const void *primary_key, int mode);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,208 @@
+/**
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <sys/mman.h>
+#include <karbonit/carbon/ndjson.h>
+#include <karbonit/carbon/internal.h>
+#include <karbonit/std/thread_pool.h>
+#include <karbonit/mem/memblock.h>
+
+/* maximum number of chunks per thread, such that threads that finish early take over further chunks */
+#define NDJSON_CHUNKS_PER_THREAD        4
+
+/* lines of the input that are converted by one task */
+typedef struct ndjson_chunk {
+        const char *begin;
+        const char *end;
+        key_e key_type;
+        /* number of lines in the chunk */
+        u64 num_lines;
+        /* as in the batch, but with line numbers relative to the chunk's first line (starting with 0) */
+        vec ofType(rec) records;
+        vec ofType(u64) lines;
+        vec ofType(ndjson_err) errors;
+} ndjson_chunk;
+
+static bool is_blank_line(const char *line, const char *end)
+{
+        for (; line < end; line++) {
+                if (*line != ' ' && *line != '\t' && *line != '\r' && *line != '\v' && *line != '\f') {
+                        return false;
+                }
+        }
+        return true;
+}
+
+static void convert_chunk(void *args)
+{
+        ndjson_chunk *chunk = (ndjson_chunk *) args;
+        vec ofType(char) line_buffer;
+        vec_create(&line_buffer, sizeof(char), 1024);
+
+        /** errors of a line are reported for that line, on whichever thread converts it; since the abort setting is
+         * thread-local, pool threads would abort otherwise */
+        bool noabort = g_err.noabort;
+        error_abort_disable();
+
+        for (const char *line = chunk->begin; line < chunk->end; chunk->num_lines++) {
+                const char *line_end = memchr(line, '\n', chunk->end - line);
+                line_end = line_end ? line_end : chunk->end;
+
+                if (!is_blank_line(line, line_end)) {
+                        /** the JSON converter reads nul-terminated strings only */
+                        char end = '\0';
+                        vec_clear(&line_buffer);
+                        vec_push(&line_buffer, line, line_end - line);
+                        vec_push(&line_buffer, &end, 1);
+
+                        rec doc;
+                        if (internal_from_json_stream(&doc, vec_data(&line_buffer), chunk->key_type, NULL,
+                                                      OPTIMIZE)) {
+                                vec_push(&chunk->records, &doc, 1);
+                                vec_push(&chunk->lines, &chunk->num_lines, 1);
+                        } else {
+                                ndjson_err err = { .line = chunk->num_lines, .code = ERR_JSONPARSEERR,
+                                                   .msg = "line is not a valid JSON document" };
+                                vec_push(&chunk->errors, &err, 1);
+                        }
+                }
+                line = line_end + 1;
+        }
+
+        if (!noabort) {
+                error_abort_enable();
+        }
+        vec_drop(&line_buffer);
+}
+
+static u32 num_chunks_for(u64 len, thread_pool *pool)
+{
+        if (!pool) {
+                return 1;
+        }
+        /** the calling thread converts chunks as well */
+        u64 max_chunks = JAK_MIN((u64) (pool->size + 1) * NDJSON_CHUNKS_PER_THREAD, THREAD_POOL_MAX_TASKS - 1);
+        return (u32) JAK_MAX(1, JAK_MIN(max_chunks, len / NDJSON_MIN_CHUNK_SIZE));
+}
+
+bool ndjson_ingest(ndjson_batch *batch, const char *data, u64 len, key_e key_type, thread_pool *pool)
+{
+        ERROR_IF_AND_RETURN(!batch || (!data && len), ERR_NULLPTR, NULL);
+
+        vec_create(&batch->records, sizeof(rec), 64);
+        vec_create(&batch->lines, sizeof(u64), 64);
+        vec_create(&batch->errors, sizeof(ndjson_err), 4);
+
+        u32 num_chunks = num_chunks_for(len, pool);
+        ndjson_chunk *chunks = MALLOC(num_chunks * sizeof(ndjson_chunk));
+        thread_task *tasks = MALLOC(num_chunks * sizeof(thread_task));
+        ZERO_MEMORY(tasks, num_chunks * sizeof(thread_task));
+
+        /** chunks are split at the end of the line in which their expected size is reached */
+        const char *begin = data, *end = data + len;
+        for (u32 i = 0; i < num_chunks; i++) {
+                const char *chunk_end = i + 1 < num_chunks ? data + (len / num_chunks) * (i + 1) : end;
+                if (chunk_end < begin) {
+                        chunk_end = begin;
+                } else if (chunk_end > begin && chunk_end < end) {
+                        const char *line_end = memchr(chunk_end - 1, '\n', end - (chunk_end - 1));
+                        chunk_end = line_end ? line_end + 1 : end;
+                }
+                chunks[i] = (ndjson_chunk) { .begin = begin, .end = chunk_end, .key_type = key_type,
+                                             .num_lines = 0 };
+                vec_create(&chunks[i].records, sizeof(rec), 64);
+                vec_create(&chunks[i].lines, sizeof(u64), 64);
+                vec_create(&chunks[i].errors, sizeof(ndjson_err), 4);
+                tasks[i].args = chunks + i;
+                tasks[i].routine = convert_chunk;
+                begin = chunk_end;
+        }
+
+        if (num_chunks > 1) {
+                thread_pool_enqueue_tasks_wait(tasks, pool, num_chunks);
+        } else {
+                convert_chunk(chunks);
+        }
+
+        /** collect results in the order of their chunks, and translate line numbers into numbers of the input */
+        u64 first_line = 1;
+        for (u32 i = 0; i < num_chunks; i++) {
+                ndjson_chunk *chunk = chunks + i;
+                vec_push(&batch->records, vec_data(&chunk->records), chunk->records.num_elems);
+                for (u32 j = 0; j < chunk->lines.num_elems; j++) {
+                        u64 line = first_line + *VEC_GET(&chunk->lines, j, u64);
+                        vec_push(&batch->lines, &line, 1);
+                }
+                for (u32 j = 0; j < chunk->errors.num_elems; j++) {
+                        ndjson_err err = *VEC_GET(&chunk->errors, j, ndjson_err);
+                        err.line += first_line;
+                        vec_push(&batch->errors, &err, 1);
+                }
+                first_line += chunk->num_lines;
+                vec_drop(&chunk->records);
+                vec_drop(&chunk->lines);
+                vec_drop(&chunk->errors);
+        }
+
+        free(tasks);
+        free(chunks);
+        return true;
+}
+
+bool ndjson_ingest_file(ndjson_batch *batch, const char *file_path, key_e key_type, thread_pool *pool)
+{
+        FILE *file = fopen(file_path, "rb");
+        if (UNLIKELY(!file)) {
+                return ERROR(ERR_FOPEN_FAILED, file_path);
+        }
+
+        fseek(file, 0, SEEK_END);
+        long len = ftell(file);
+        fseek(file, 0, SEEK_SET);
+
+        if (len == 0) {
+                fclose(file);
+                return ndjson_ingest(batch, NULL, 0, key_type, pool);
+        }
+
+        memblock *block;
+        bool status = len > 0 && MEMBLOCK_FROM_FILE_MAPPED(&block, file, len, MADV_SEQUENTIAL);
+        fclose(file);
+        if (UNLIKELY(!status)) {
+                return ERROR(ERR_IO, "unable to map NDJSON file");
+        }
+
+        status = ndjson_ingest(batch, MEMBLOCK_RAW_DATA_UNSAFE(block), len, key_type, pool);
+        MEMBLOCK_DROP(block);
+        return status;
+}
+
+bool ndjson_batch_drop(ndjson_batch *batch)
+{
+        ERROR_IF_AND_RETURN(!batch, ERR_NULLPTR, NULL);
+        for (u32 i = 0; i < batch->records.num_elems; i++) {
+                rec_drop(VEC_GET(&batch->records, i, rec));
+        }
+        vec_drop(&batch->records);
+        vec_drop(&batch->lines);
+        vec_drop(&batch->errors);
+        return true;
+}
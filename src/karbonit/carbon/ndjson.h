@@ -0,0 +1,70 @@
+/*
+ * ndjson - bulk conversion of newline-delimited JSON into records
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_NDJSON_H
+#define HAD_NDJSON_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/rec.h>
+#include <karbonit/std/vec.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* minimum number of input bytes that are converted by the same task */
+#define NDJSON_MIN_CHUNK_SIZE           (64 * 1024)
+
+/* a line that could not be converted into a record */
+typedef struct ndjson_err {
+        /* line number, starting with 1 */
+        u64 line;
+        /* error code and message, as for ERROR */
+        int code;
+        const char *msg;
+} ndjson_err;
+
+/**
+ * Records that are converted from the lines of a newline-delimited JSON input, one record per line that is not
+ * blank. Records and errors are in the order of their lines.
+ */
+typedef struct ndjson_batch {
+        vec ofType(rec) records;
+        /* for each record, the number of its line (starting with 1) */
+        vec ofType(u64) lines;
+        vec ofType(ndjson_err) errors;
+} ndjson_batch;
+
+/**
+ * Converts each line of the <code>len</code> bytes of newline-delimited JSON at <code>data</code> into a record as
+ * <code>rec_from_json</code> does with record key type <code>key_type</code>. The input is split into line-aligned
+ * chunks that are converted in parallel by the threads of <code>pool</code> and the calling thread; for
+ * <code>pool</code> <code>NULL</code>, all lines are converted by the calling thread. A line that cannot be converted
+ * is reported in the batch's errors, and does not stop the conversion of the other lines. Returns false only if the
+ * batch could not be created.
+ */
+bool ndjson_ingest(ndjson_batch *batch, const char *data, u64 len, key_e key_type, thread_pool *pool);
+
+/**
+ * Maps the file at <code>file_path</code> into memory, and converts its lines (see <code>ndjson_ingest</code>)
+ */
+bool ndjson_ingest_file(ndjson_batch *batch, const char *file_path, key_e key_type, thread_pool *pool);
+
+/**
+ * Drops all records of the batch, and the batch itself
+ */
+bool ndjson_batch_drop(ndjson_batch *batch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
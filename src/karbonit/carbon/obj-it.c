@@ -212,6 +212,83 @@ bool obj_it_is_sorted(obj_it *it)
         return abstract_is_sorted(type_class);
 }
 
+int internal_obj_it_key_cmp(const char *lhs, u64 lhs_len, const char *rhs, u64 rhs_len)
+{
+        int cmp = memcmp(lhs, rhs, JAK_MIN(lhs_len, rhs_len));
+        return cmp ? cmp : (lhs_len > rhs_len) - (lhs_len < rhs_len);
+}
+
+/* property of an object that is sorted, with offsets relative to the first property */
+typedef struct obj_it_sort_prop {
+        offset_t start;
+        u64 size;
+        offset_t key_off;
+        const char *key;
+        u64 key_len;
+        u64 idx;
+} obj_it_sort_prop;
+
+static int obj_it_sort_prop_cmp(const void *lhs, const void *rhs)
+{
+        const obj_it_sort_prop *a = lhs, *b = rhs;
+        int cmp = internal_obj_it_key_cmp(a->key, a->key_len, b->key, b->key_len);
+        /** properties with equal keys keep their order since qsort is not stable */
+        return cmp ? cmp : (a->idx > b->idx) - (a->idx < b->idx);
+}
+
+/* reorders the properties of the object by their keys; the properties keep their total size, i.e., they are
+ * rearranged in place */
+static void obj_it_sort(obj_it *it)
+{
+        obj_it scan;
+        vec props;
+        bool is_sorted = true;
+        string_field last = NULL_STRING;
+
+        internal_obj_it_create(&scan, &it->file, it->begin);
+        /** the scan starts at the first property */
+        const char *base = (const char *) MEMFILE_RAW_DATA(&scan.file);
+        vec_create(&props, sizeof(obj_it_sort_prop), 16);
+        offset_t end = scan.content_begin;
+        while (obj_it_next(&scan)) {
+                string_field name = internal_obj_it_prop_name(&scan);
+                if (VEC_LENGTH(&props) > 0 && internal_obj_it_key_cmp(last.str, last.len, name.str, name.len) > 0) {
+                        is_sorted = false;
+                }
+                obj_it_sort_prop prop = {
+                        .start = scan.last_off - scan.content_begin,
+                        .size = MEMFILE_TELL(&scan.file) - scan.last_off,
+                        .key_off = name.str - base,
+                        .key_len = name.len,
+                        .idx = VEC_LENGTH(&props)
+                };
+                vec_push(&props, &prop, 1);
+                end = MEMFILE_TELL(&scan.file);
+                last = name;
+        }
+
+        if (!is_sorted) {
+                u64 len = end - scan.content_begin;
+                MEMFILE_SAVE_POSITION(&it->file);
+                MEMFILE_SEEK(&it->file, scan.content_begin);
+                char *contents = MEMFILE_PEEK_MUT(&it->file, len);
+                char *original = MALLOC(len);
+                memcpy(original, contents, len);
+
+                obj_it_sort_prop *sorted = VEC_ALL(&props, obj_it_sort_prop);
+                for (u64 i = 0; i < VEC_LENGTH(&props); i++) {
+                        sorted[i].key = original + sorted[i].key_off;
+                }
+                qsort(sorted, VEC_LENGTH(&props), sizeof(obj_it_sort_prop), obj_it_sort_prop_cmp);
+                for (u64 i = 0, pos = 0; i < VEC_LENGTH(&props); pos += sorted[i].size, i++) {
+                        memcpy(contents + pos, original + sorted[i].start, sorted[i].size);
+                }
+                free(original);
+                MEMFILE_RESTORE_POSITION(&it->file);
+        }
+        vec_drop(&props);
+}
+
 void obj_it_update_type(obj_it *it, map_type_e derivation)
 {
         MEMFILE_SAVE_POSITION(&it->file);
@@ -221,6 +298,13 @@ void obj_it_update_type(obj_it *it, map_type_e derivation)
         abstract_write_derived_type(&it->file, derive_marker);
 
         MEMFILE_RESTORE_POSITION(&it->file);
+
+        bool was_sorted = obj_it_is_sorted(it);
+        it->type = derivation;
+        if (!was_sorted && obj_it_is_sorted(it)) {
+                /** properties are kept in order of their keys for sorted maps */
+                obj_it_sort(it);
+        }
 }
 
 bool internal_obj_it_insert_begin(insert *in, obj_it *it)
@@ -53,6 +53,8 @@ u64 obj_it_length(obj_it *it);
 
 bool obj_it_is_multimap(obj_it *it);
 bool obj_it_is_sorted(obj_it *it);
+/** Changes the abstract type of the object to <code>derivation</code>. An object that becomes sorted has its
+ * properties reordered by their keys (see <code>insert_prop_null</code>). */
 void obj_it_update_type(obj_it *it, map_type_e derivation);
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -70,6 +72,9 @@ offset_t internal_obj_it_memfile_pos(obj_it *it);
 bool internal_obj_it_tell(offset_t *key_off, offset_t *value_off, obj_it *it);
 
 string_field internal_obj_it_prop_name(obj_it *it);
+/** three-way comparison of property keys by which sorted maps order their properties, i.e., bytewise, with a key
+ * being less than all longer keys it is a prefix of */
+int internal_obj_it_key_cmp(const char *lhs, u64 lhs_len, const char *rhs, u64 rhs_len);
 bool internal_obj_it_remove(obj_it *it);
 bool internal_obj_it_prop_type(field_e *type, obj_it *it);
 
@@ -26,12 +26,18 @@
 #include <karbonit/carbon/string-field.h>
 #include <karbonit/carbon/insert.h>
 #include <karbonit/carbon/commit.h>
+#include <karbonit/mem/alloc.h>
+#include <karbonit/std/hash.h>
 
 // ---------------------------------------------------------------------------------------------------------------------
 //  config
 // ---------------------------------------------------------------------------------------------------------------------
 
 #define pindex_CAPACITY 1024
+#define PINDEX_ARENA_CHUNK_SIZE (256 * 1024)
+
+#define PINDEX_FILE_MAGIC "KPIX"
+#define PINDEX_FILE_VERSION 3
 
 #define PATH_MARKER_PROP_NODE 'P'
 #define PATH_MARKER_ARRAY_NODE 'a'
@@ -59,6 +65,13 @@ struct pindex_node {
         vec ofType(struct pindex_node) sub_entries;
 };
 
+/* entry of the key table of an object node, which is an open addressing hash table over the property names */
+struct pindex_key_slot {
+        u32 hash;
+        /* position of the property plus one, or 0 for an empty slot */
+        u32 pos;
+};
+
 // ---------------------------------------------------------------------------------------------------------------------
 //  helper prototypes
 // ---------------------------------------------------------------------------------------------------------------------
@@ -94,42 +107,35 @@ static void intent(str_buf *str, unsigned intent)
         }
 }
 
-static void pindex_node_init(struct pindex_node *node)
+static void pindex_node_init(struct pindex_node *node, allocator *alloc)
 {
         ZERO_MEMORY(node, sizeof(struct pindex_node));
-        vec_create(&node->sub_entries, sizeof(struct pindex_node), 10);
+        vec_create_with(&node->sub_entries, sizeof(struct pindex_node), 10, alloc);
         node->type = PINDEX_ROOT;
 }
 
-static void pindex_node_drop(struct pindex_node *node)
-{
-        for (u32 i = 0; i < node->sub_entries.num_elems; i++) {
-                struct pindex_node *sub = VEC_GET(&node->sub_entries, i, struct pindex_node);
-                pindex_node_drop(sub);
-        }
-        vec_drop(&node->sub_entries);
-}
-
-static void pindex_node_new_array_element(struct pindex_node *node, u64 pos, offset_t value_off)
+static void pindex_node_new_array_element(struct pindex_node *node, u64 pos, offset_t value_off,
+                                           allocator *alloc)
 {
-        pindex_node_init(node);
+        pindex_node_init(node, alloc);
         node->type = PINDEX_ARRAY_INDEX;
         node->entry.pos = pos;
         node->field_offset = value_off;
 }
 
-static void pindex_node_new_column_element(struct pindex_node *node, u64 pos, offset_t value_off)
+static void pindex_node_new_column_element(struct pindex_node *node, u64 pos, offset_t value_off,
+                                           allocator *alloc)
 {
-        pindex_node_init(node);
+        pindex_node_init(node, alloc);
         node->type = PINDEX_COLUMN_INDEX;
         node->entry.pos = pos;
         node->field_offset = value_off;
 }
 
 static void pindex_node_new_object_prop(struct pindex_node *node, offset_t key_off, const char *name,
-                                            u64 name_len, offset_t value_off)
+                                            u64 name_len, offset_t value_off, allocator *alloc)
 {
-        pindex_node_init(node);
+        pindex_node_init(node, alloc);
         node->type = PINDEX_PROP_KEY;
         node->entry.key.offset = key_off;
         node->entry.key.name = name;
@@ -148,7 +154,7 @@ pindex_node_add_array_elem(struct pindex_node *parent, u64 pos, offset_t value_o
         /** For elements in array, the type marker (e.g., [c]) is contained. That is needed since the element might
          * be a container */
         struct pindex_node *sub = VEC_NEW_AND_GET(&parent->sub_entries, struct pindex_node);
-        pindex_node_new_array_element(sub, pos, value_off);
+        pindex_node_new_array_element(sub, pos, value_off, parent->sub_entries.alloc);
         return sub;
 }
 
@@ -157,7 +163,7 @@ pindex_node_add_column_elem(struct pindex_node *parent, u64 pos, offset_t value_
 {
         /** For elements in column, there is no type marker since no value is allowed to be a container */
         struct pindex_node *sub = VEC_NEW_AND_GET(&parent->sub_entries, struct pindex_node);
-        pindex_node_new_column_element(sub, pos, value_off);
+        pindex_node_new_column_element(sub, pos, value_off, parent->sub_entries.alloc);
         return sub;
 }
 
@@ -165,7 +171,7 @@ static struct pindex_node *pindex_node_add_key_elem(struct pindex_node *parent,
                                                             const char *name, u64 name_len, offset_t value_off)
 {
         struct pindex_node *sub = VEC_NEW_AND_GET(&parent->sub_entries, struct pindex_node);
-        pindex_node_new_object_prop(sub, key_off, name, name_len, value_off);
+        pindex_node_new_object_prop(sub, key_off, name, name_len, value_off, parent->sub_entries.alloc);
         return sub;
 }
 
@@ -197,14 +203,25 @@ static struct pindex_node *pindex_node_add_key_elem(struct pindex_node *parent,
 //        }
 //}
 
+/* checksum of the contents of the record, which binds an index to records that have no commit hash (i.e., no key) */
+static u64 record_checksum(rec *doc)
+{
+        u64 len, checksum;
+        const void *data = rec_raw_data(&len, doc);
+        commit_compute(&checksum, data, len);
+        return checksum;
+}
+
 static const void *
-record_ref_read(key_e *rec_key_type, u64 *key_length, u64 *commit_hash, memfile *memfile)
+record_ref_read(key_e *rec_key_type, u64 *key_length, u64 *commit_hash, u64 *checksum, memfile *memfile)
 {
         MEMFILE_SAVE_POSITION(memfile);
         MEMFILE_SEEK(memfile, 0);
         const void *ret = key_read(key_length, rec_key_type, memfile);
         u64 *hash = MEMFILE_READ_TYPE(memfile, u64);
         OPTIONAL_SET(commit_hash, *hash);
+        u64 *sum = MEMFILE_READ_TYPE(memfile, u64);
+        OPTIONAL_SET(checksum, *sum);
         MEMFILE_RESTORE_POSITION(memfile);
         return ret;
 }
@@ -215,6 +232,7 @@ static void record_ref_create(memfile *memfile, rec *doc)
         u64 commit_hash;
         rec_key_type(&type, doc);
         rec_commit_hash(&commit_hash, doc);
+        u64 checksum = record_checksum(doc);
 
         /** write record key */
         MEMFILE_SEEK(memfile, 0);
@@ -249,8 +267,9 @@ static void record_ref_create(memfile *memfile, rec *doc)
                 default: ERROR(ERR_TYPEMISMATCH, NULL);
         }
 
-        /** write record version */
+        /** write record version and contents */
         MEMFILE_WRITE(memfile, &commit_hash, sizeof(u64));
+        MEMFILE_WRITE(memfile, &checksum, sizeof(u64));
 }
 
 static void array_traverse(struct pindex_node *parent, arr_it *it)
@@ -483,34 +502,70 @@ static void array_build_index(struct pindex_node *parent, arr_it *elem_it)
 static void field_ref_write(memfile *file, struct pindex_node *node)
 {
         MEMFILE_WRITE_BYTE(file, node->field_type);
-        if (node->field_type != FIELD_NULL && node->field_type != FIELD_TRUE &&
-            node->field_type != FIELD_FALSE) {
-                /** only in case of field type that is not null, true, or false, there is more information behind
-                 * the field offset */
-                MEMFILE_WRITE_UINTVAR_STREAM(NULL, file, node->field_offset);
+        MEMFILE_WRITE_UINTVAR_STREAM(NULL, file, node->field_offset);
+}
+
+static u32 pindex_key_hash(const char *key, u64 key_len)
+{
+        return key_len > 0 ? HASH_FNV(key_len, key) : 0;
+}
+
+static u32 key_table_num_slots(u32 num_props)
+{
+        /** power of two with a load factor of at most 1/2 */
+        u32 num_slots = 2;
+        while (num_slots < 2 * num_props) {
+                num_slots *= 2;
         }
+        return num_slots;
+}
+
+static void key_table_flat(memfile *file, struct pindex_node *node)
+{
+        u32 num_slots = key_table_num_slots(node->sub_entries.num_elems);
+        struct pindex_key_slot *slots = MALLOC(num_slots * sizeof(struct pindex_key_slot));
+        ZERO_MEMORY(slots, num_slots * sizeof(struct pindex_key_slot));
+
+        for (u32 i = 0; i < node->sub_entries.num_elems; i++) {
+                struct pindex_node *sub = VEC_GET(&node->sub_entries, i, struct pindex_node);
+                u32 hash = pindex_key_hash(sub->entry.key.name, sub->entry.key.name_len);
+                u32 slot = hash & (num_slots - 1);
+                /** linear probing keeps the first of several equal keys in front of the others */
+                while (slots[slot].pos != 0) {
+                        slot = (slot + 1) & (num_slots - 1);
+                }
+                slots[slot].hash = hash;
+                slots[slot].pos = i + 1;
+        }
+
+        MEMFILE_WRITE_UINTVAR_STREAM(NULL, file, num_slots);
+        MEMFILE_WRITE(file, slots, num_slots * sizeof(struct pindex_key_slot));
+        free(slots);
 }
 
 static void container_contents_flat(memfile *file, struct pindex_node *node)
 {
         MEMFILE_WRITE_UINTVAR_STREAM(NULL, file, node->sub_entries.num_elems);
 
-        /** write position offsets */
-        offset_t position_off_latest = MEMFILE_TELL(file);
+        /** reserve the node offsets, which have a fixed size such that a node is located by its position */
+        offset_t node_offs_begin = MEMFILE_TELL(file);
+        u32 node_off = 0;
         for (u32 i = 0; i < node->sub_entries.num_elems; i++) {
-                MEMFILE_WRITE_UINTVAR_STREAM(NULL, file, 0);
+                MEMFILE_WRITE(file, &node_off, sizeof(u32));
+        }
+
+        if (FIELD_IS_OBJECT_OR_SUBTYPE(node->field_type)) {
+                key_table_flat(file, node);
         }
 
         for (u32 i = 0; i < node->sub_entries.num_elems; i++) {
-                offset_t node_off = MEMFILE_TELL(file);
+                node_off = MEMFILE_TELL(file);
                 struct pindex_node *sub = VEC_GET(&node->sub_entries, i, struct pindex_node);
                 node_flat(file, sub);
                 MEMFILE_SAVE_POSITION(file);
-                MEMFILE_SEEK(file, position_off_latest);
-                signed_offset_t shift = MEMFILE_UPDATE_UINTVAR_STREAM(file, node_off);
-                position_off_latest = MEMFILE_TELL(file);
+                MEMFILE_SEEK(file, node_offs_begin + i * sizeof(u32));
+                MEMFILE_WRITE(file, &node_off, sizeof(u32));
                 MEMFILE_RESTORE_POSITION(file);
-                MEMFILE_SEEK_FROM_HERE(file, shift);
         }
 }
 
@@ -658,22 +713,15 @@ static u8 field_ref_into_record(insert *ins, pindex *index, bool is_root)
         }
 
 
-        if (field_type != FIELD_NULL && field_type != FIELD_TRUE &&
-            field_type != FIELD_FALSE) {
-                /** only in case of field type that is not null, true, or false, there is more information behind
-                 * the field offset */
-                u64 field_offset = MEMFILE_READ_UINTVAR_STREAM(NULL, &index->memfile);
-                if (is_root) {
-                        insert_prop_null(ins, "offset");
-                } else {
-                        str_buf str;
-                        str_buf_create(&str);
-                        str_buf_add_u64_as_hex_0x_prefix_compact(&str, field_offset);
-                        insert_prop_string(ins, "offset", str_buf_cstr(&str));
-                        str_buf_drop(&str);
-                }
-        } else {
+        u64 field_offset = MEMFILE_READ_UINTVAR_STREAM(NULL, &index->memfile);
+        if (is_root) {
                 insert_prop_null(ins, "offset");
+        } else {
+                str_buf str;
+                str_buf_create(&str);
+                str_buf_add_u64_as_hex_0x_prefix_compact(&str, field_offset);
+                insert_prop_string(ins, "offset", str_buf_cstr(&str));
+                str_buf_drop(&str);
         }
         return field_type;
 }
@@ -686,15 +734,10 @@ static u8 field_ref_to_str(str_buf *str, pindex *index)
         str_buf_add_char(str, field_type);
         str_buf_add_char(str, ']');
 
-        if (field_type != FIELD_NULL && field_type != FIELD_TRUE &&
-            field_type != FIELD_FALSE) {
-                /** only in case of field type that is not null, true, or false, there is more information behind
-                 * the field offset */
-                u64 field_offset = MEMFILE_READ_UINTVAR_STREAM(NULL, &index->memfile);
-                str_buf_add_char(str, '(');
-                str_buf_add_u64_as_hex_0x_prefix_compact(str, field_offset);
-                str_buf_add_char(str, ')');
-        }
+        u64 field_offset = MEMFILE_READ_UINTVAR_STREAM(NULL, &index->memfile);
+        str_buf_add_char(str, '(');
+        str_buf_add_u64_as_hex_0x_prefix_compact(str, field_offset);
+        str_buf_add_char(str, ')');
 
         return field_type;
 }
@@ -727,7 +770,13 @@ static void column_into_record(insert *ins, pindex *index)
         _insert_field_ref(ins, index, false);
 }
 
-static void container_contents_into_record(insert *ins, pindex *index)
+static void key_table_skip(memfile *file)
+{
+        u64 num_slots = MEMFILE_READ_UINTVAR_STREAM(NULL, file);
+        MEMFILE_SKIP(file, num_slots * sizeof(struct pindex_key_slot));
+}
+
+static void container_contents_into_record(insert *ins, pindex *index, u8 field_type)
 {
         u64 num_elems = MEMFILE_READ_UINTVAR_STREAM(NULL, &index->memfile);
         insert_prop_unsigned(ins, "element-count", num_elems);
@@ -738,12 +787,15 @@ static void container_contents_into_record(insert *ins, pindex *index)
         str_buf str;
         str_buf_create(&str);
         for (u32 i = 0; i < num_elems; i++) {
-                u64 pos_offs = MEMFILE_READ_UINTVAR_STREAM(NULL, &index->memfile);
+                u32 pos_offs = *MEMFILE_READ_TYPE(&index->memfile, u32);
                 str_buf_clear(&str);
                 str_buf_add_u64_as_hex_0x_prefix_compact(&str, pos_offs);
                 insert_string(ains, str_buf_cstr(&str));
         }
         str_buf_drop(&str);
+        if (FIELD_IS_OBJECT_OR_SUBTYPE(field_type)) {
+                key_table_skip(&index->memfile);
+        }
 
         insert_prop_array_end(&array);
 
@@ -760,7 +812,7 @@ static void container_contents_into_record(insert *ins, pindex *index)
 }
 
 static void
-container_contents_to_str(str_buf *str, pindex *index, unsigned intent_level)
+container_contents_to_str(str_buf *str, pindex *index, u8 field_type, unsigned intent_level)
 {
         u64 num_elems = MEMFILE_READ_UINTVAR_STREAM(NULL, &index->memfile);
         str_buf_add_char(str, '(');
@@ -768,11 +820,14 @@ container_contents_to_str(str_buf *str, pindex *index, unsigned intent_level)
         str_buf_add_char(str, ')');
 
         for (u32 i = 0; i < num_elems; i++) {
-                u64 pos_offs = MEMFILE_READ_UINTVAR_STREAM(NULL, &index->memfile);
+                u32 pos_offs = *MEMFILE_READ_TYPE(&index->memfile, u32);
                 str_buf_add_char(str, '(');
                 str_buf_add_u64_as_hex_0x_prefix_compact(str, pos_offs);
                 str_buf_add_char(str, ')');
         }
+        if (FIELD_IS_OBJECT_OR_SUBTYPE(field_type)) {
+                key_table_skip(&index->memfile);
+        }
 
         for (u32 i = 0; i < num_elems; i++) {
                 node_to_str(str, index, intent_level);
@@ -849,7 +904,7 @@ container_to_str(str_buf *str, pindex *index, u8 field_type, unsigned intent_lev
                 case FIELD_DERIVED_COLUMN_BOOLEAN_UNSORTED_SET:
                 case FIELD_DERIVED_COLUMN_BOOLEAN_SORTED_SET: {
                         /** subsequent path elements to be printed */
-                        container_contents_to_str(str, index, ++intent_level);
+                        container_contents_to_str(str, index, field_type, ++intent_level);
                 }
                         break;
                 default: ERROR(ERR_INTERNALERR, NULL);
@@ -925,7 +980,7 @@ static void container_into_record(insert *ins, pindex *index, u8 field_type)
                 case FIELD_DERIVED_COLUMN_BOOLEAN_UNSORTED_SET:
                 case FIELD_DERIVED_COLUMN_BOOLEAN_SORTED_SET: {
                         /** subsequent path elements to be printed */
-                        container_contents_into_record(ins, index);
+                        container_contents_into_record(ins, index, field_type);
                 }
                         break;
                 default: ERROR(ERR_INTERNALERR, NULL);
@@ -981,7 +1036,7 @@ static void array_into_record(insert *ins, pindex *index, bool is_root)
         obj_state object;
         insert *oins = insert_prop_object_begin(&object, ins, "nodes", 1024);
         if (UNLIKELY(is_root)) {
-                container_contents_into_record(oins, index);
+                container_contents_into_record(oins, index, field_type);
         } else {
                 container_into_record(oins, index, field_type);
         }
@@ -1001,7 +1056,7 @@ array_to_str(str_buf *str, pindex *index, bool is_root, unsigned intent_level)
         u8 field_type = field_ref_to_str(str, index);
 
         if (UNLIKELY(is_root)) {
-                container_contents_to_str(str, index, intent_level);
+                container_contents_to_str(str, index, field_type, intent_level);
         } else {
                 container_to_str(str, index, field_type, intent_level);
         }
@@ -1039,9 +1094,11 @@ static void index_flat(memfile *file, struct pindex_node *root_array)
 static void index_build(memfile *file, rec *doc)
 {
         struct pindex_node root_array;
+        allocator arena;
 
-        /** init */
-        pindex_node_init(&root_array);
+        /** init (the tree is built in an arena, and dropped as a whole once flattened) */
+        alloc_create_arena(&arena, PINDEX_ARENA_CHUNK_SIZE);
+        pindex_node_init(&root_array, &arena);
 
         arr_it it;
         u64 array_pos = 0;
@@ -1056,10 +1113,12 @@ static void index_build(memfile *file, rec *doc)
         }
 
         index_flat(file, &root_array);
+        /** padding, such that the last node can be read up to its end by a read-only memfile */
+        MEMFILE_WRITE_BYTE(file, 0);
         MEMFILE_SHRINK(file);
 
         /** cleanup */
-        pindex_node_drop(&root_array);
+        alloc_drop(&arena);
 }
 
 static void record_ref_to_str(str_buf *str, pindex *index)
@@ -1099,9 +1158,13 @@ static void record_ref_to_str(str_buf *str, pindex *index)
                 default: ERROR(ERR_INTERNALERR, NULL);
         }
         u64 commit_hash = MEMFILE_READ_U64(&index->memfile);
+        u64 checksum = MEMFILE_READ_U64(&index->memfile);
         str_buf_add_char(str, '[');
         str_buf_add_u64(str, commit_hash);
         str_buf_add_char(str, ']');
+        str_buf_add_char(str, '[');
+        str_buf_add_u64(str, checksum);
+        str_buf_add_char(str, ']');
 }
 
 static void record_ref_to_record(insert *roins, pindex *index)
@@ -1133,10 +1196,13 @@ static void record_ref_to_record(insert *roins, pindex *index)
                 default: ERROR(ERR_INTERNALERR, NULL);
         }
         u64 commit_hash = MEMFILE_READ_U64(&index->memfile);
+        u64 checksum = MEMFILE_READ_U64(&index->memfile);
         str_buf str;
         str_buf_create(&str);
         commit_to_str(&str, commit_hash);
         insert_prop_string(roins, "commit-hash", str_buf_cstr(&str));
+        commit_to_str(&str, checksum);
+        insert_prop_string(roins, "checksum", str_buf_cstr(&str));
         str_buf_drop(&str);
 }
 
@@ -1155,8 +1221,85 @@ bool pindex_create(pindex *index, rec *doc)
 
 bool pindex_drop(pindex *index)
 {
-        UNUSED(index)
-        return false;
+        MEMBLOCK_DROP(index->memblock);
+        return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  persistence
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* header of an index file, which is followed by the index */
+struct pindex_file_header {
+        char magic[4];
+        u32 version;
+        u64 index_len;
+        /* checksum of the contents of the indexed record, see pindex_checksum */
+        u64 checksum;
+};
+
+bool pindex_to_file(const char *file_path, pindex *index)
+{
+        FILE *file = fopen(file_path, "wb");
+        if (UNLIKELY(!file)) {
+                return ERROR(ERR_FOPEN_FAILED, file_path);
+        }
+
+        struct pindex_file_header header;
+        ZERO_MEMORY(&header, sizeof(header));
+        memcpy(header.magic, PINDEX_FILE_MAGIC, sizeof(header.magic));
+        header.version = PINDEX_FILE_VERSION;
+        pindex_checksum(&header.checksum, index);
+        const void *data = pindex_raw_data(&header.index_len, index);
+
+        bool status = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                      fwrite(data, 1, header.index_len, file) == header.index_len;
+        status &= fclose(file) == 0;
+        return status ? true : ERROR(ERR_FWRITE_FAILED, file_path);
+}
+
+bool pindex_from_file(pindex *index, const char *file_path, rec *doc)
+{
+        FILE *file = fopen(file_path, "rb");
+        if (UNLIKELY(!file)) {
+                return ERROR(ERR_FOPEN_FAILED, file_path);
+        }
+
+        fseek(file, 0, SEEK_END);
+        long len = ftell(file);
+        fseek(file, 0, SEEK_SET);
+
+        struct pindex_file_header header;
+        if (UNLIKELY(fread(&header, sizeof(header), 1, file) != 1 ||
+                     memcmp(header.magic, PINDEX_FILE_MAGIC, sizeof(header.magic)) != 0 ||
+                     header.version != PINDEX_FILE_VERSION || header.index_len == 0 ||
+                     header.index_len != (u64) len - sizeof(header))) {
+                fclose(file);
+                return ERROR(ERR_CORRUPTED, "not a path index file");
+        }
+        if (doc && header.checksum != record_checksum(doc)) {
+                fclose(file);
+                return ERROR(ERR_NOTINDEXED, "path index is outdated");
+        }
+
+        bool status = MEMBLOCK_FROM_FILE_MAPPED(&index->memblock, file, header.index_len, MADV_RANDOM);
+        fclose(file);
+        if (UNLIKELY(!status)) {
+                return ERROR(ERR_IO, "unable to map path index file");
+        }
+        MEMFILE_OPEN(&index->memfile, index->memblock, READ_ONLY);
+
+        u64 checksum;
+        pindex_checksum(&checksum, index);
+        if (UNLIKELY(checksum != header.checksum)) {
+                pindex_drop(index);
+                return ERROR(ERR_CORRUPTED, "path index does not match its file header");
+        }
+        if (doc && !pindex_indexes_doc(index, doc)) {
+                pindex_drop(index);
+                return ERROR(ERR_NOTINDEXED, "path index is outdated");
+        }
+        return true;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -1176,20 +1319,26 @@ const void *pindex_raw_data(u64 *size, pindex *index)
 
 bool pindex_commit_hash(u64 *commit_hash, pindex *index)
 {
-        record_ref_read(NULL, NULL, commit_hash, &index->memfile);
+        record_ref_read(NULL, NULL, commit_hash, NULL, &index->memfile);
+        return true;
+}
+
+bool pindex_checksum(u64 *checksum, pindex *index)
+{
+        record_ref_read(NULL, NULL, NULL, checksum, &index->memfile);
         return true;
 }
 
 bool pindex_key_type(key_e *rec_key_type, pindex *index)
 {
-        record_ref_read(rec_key_type, NULL, NULL, &index->memfile);
+        record_ref_read(rec_key_type, NULL, NULL, NULL, &index->memfile);
         return true;
 }
 
 bool pindex_key_unsigned_value(u64 *key, pindex *index)
 {
         key_e rec_key_type;
-        u64 ret = *(u64 *) record_ref_read(&rec_key_type, NULL, NULL, &index->memfile);
+        u64 ret = *(u64 *) record_ref_read(&rec_key_type, NULL, NULL, NULL, &index->memfile);
         ERROR_IF_AND_RETURN(rec_key_type != KEY_AUTOKEY && rec_key_type != KEY_UKEY, ERR_TYPEMISMATCH, NULL);
         *key = ret;
         return true;
@@ -1198,7 +1347,7 @@ bool pindex_key_unsigned_value(u64 *key, pindex *index)
 bool pindex_key_signed_value(i64 *key, pindex *index)
 {
         key_e rec_key_type;
-        i64 ret = *(i64 *) record_ref_read(&rec_key_type, NULL, NULL, &index->memfile);
+        i64 ret = *(i64 *) record_ref_read(&rec_key_type, NULL, NULL, NULL, &index->memfile);
         ERROR_IF_AND_RETURN(rec_key_type != KEY_IKEY, ERR_TYPEMISMATCH, NULL);
         *key = ret;
         return true;
@@ -1208,7 +1357,7 @@ const char *pindex_key_string_value(u64 *str_len, pindex *index)
 {
         if (str_len && index) {
                 key_e rec_key_type;
-                const char *ret = (const char *) record_ref_read(&rec_key_type, str_len, NULL, &index->memfile);
+                const char *ret = (const char *) record_ref_read(&rec_key_type, str_len, NULL, NULL, &index->memfile);
                 ERROR_IF_AND_RETURN(rec_key_type != KEY_SKEY, ERR_TYPEMISMATCH, NULL);
                 return ret;
         } else {
@@ -1228,8 +1377,12 @@ bool pindex_indexes_doc(pindex *index, rec *doc)
                 rec_key_type(&doc_key_type, doc);
                 if (LIKELY(index_key_type == doc_key_type)) {
                         switch (index_key_type) {
-                                case KEY_NOKEY:
-                                        return true;
+                                case KEY_NOKEY: {
+                                        /** no commit hash to compare, since records without key have none */
+                                        u64 index_checksum;
+                                        pindex_checksum(&index_checksum, index);
+                                        return index_checksum == record_checksum(doc);
+                                }
                                 case KEY_AUTOKEY:
                                 case KEY_UKEY: {
                                         u64 index_key, doc_key;
@@ -1265,6 +1418,48 @@ bool pindex_indexes_doc(pindex *index, rec *doc)
 //  index access and type information
 // ---------------------------------------------------------------------------------------------------------------------
 
+/* reads the header of the node at the current position, and selects the node as the element at position pos */
+static void it_read_node(pindex_it *it, u64 pos)
+{
+        it->node_off = MEMFILE_TELL(&it->memfile);
+        u8 marker = MEMFILE_READ_BYTE(&it->memfile);
+        it->field_type = MEMFILE_READ_BYTE(&it->memfile);
+        it->field_off = MEMFILE_READ_UINTVAR_STREAM(NULL, &it->memfile);
+        it->key_off = marker == PATH_MARKER_PROP_NODE ? MEMFILE_READ_UINTVAR_STREAM(NULL, &it->memfile) : 0;
+        it->pos = pos;
+}
+
+static void it_select(pindex_it *it, u64 pos)
+{
+        MEMFILE_SEEK(&it->memfile, it->contents_off + pos * sizeof(u32));
+        u32 node_off = *MEMFILE_READ_TYPE(&it->memfile, u32);
+        MEMFILE_SEEK(&it->memfile, node_off);
+        it_read_node(it, pos);
+}
+
+static bool it_can_enter(pindex_it *it)
+{
+        return it->node_off != 0 && (FIELD_IS_ARRAY_OR_SUBTYPE(it->field_type) ||
+                                     FIELD_IS_COLUMN_OR_SUBTYPE(it->field_type) ||
+                                     FIELD_IS_OBJECT_OR_SUBTYPE(it->field_type));
+}
+
+static bool it_enter(pindex_it *it)
+{
+        if (!it_can_enter(it)) {
+                return false;
+        }
+        MEMFILE_SEEK(&it->memfile, it->node_off);
+        it_read_node(it, 0);
+        it->container = FIELD_IS_OBJECT_OR_SUBTYPE(it->field_type) ? OBJECT :
+                        FIELD_IS_COLUMN_OR_SUBTYPE(it->field_type) ? COLUMN : ARRAY;
+        it->container_off = it->field_off;
+        it->len = MEMFILE_READ_UINTVAR_STREAM(NULL, &it->memfile);
+        it->contents_off = MEMFILE_TELL(&it->memfile);
+        it->node_off = 0;
+        return true;
+}
+
 bool pindex_it_open(pindex_it *it, pindex *index,
                                rec *doc)
 {
@@ -1272,13 +1467,126 @@ bool pindex_it_open(pindex_it *it, pindex *index,
                 ZERO_MEMORY(it, sizeof(pindex_it));
                 MEMFILE_OPEN(&it->memfile, index->memfile.memblock, READ_ONLY);
                 it->doc = doc;
-                it->container = ARRAY;
+
+                /** skip the record reference, and enter the root node */
+                MEMFILE_SEEK(&it->memfile, 0);
+                key_read(NULL, NULL, &it->memfile);
+                MEMFILE_SKIP(&it->memfile, 2 * sizeof(u64));
+                it->node_off = MEMFILE_TELL(&it->memfile);
+                it->field_type = FIELD_ARRAY_UNSORTED_MULTISET;
+                it_enter(it);
+                it->container_off = 0;
                 return true;
         } else {
                 return ERROR(ERR_NOTINDEXED, NULL);
         }
 }
 
+bool pindex_it_type(container_e *type, pindex_it *it)
+{
+        *type = it->container;
+        return true;
+}
+
+bool pindex_it_list_length(u64 *key_len, pindex_it *it)
+{
+        ERROR_IF_AND_RETURN(it->container == OBJECT, ERR_TYPEMISMATCH, "container must be array or column");
+        *key_len = it->len;
+        return true;
+}
+
+bool pindex_it_list_goto(u64 pos, pindex_it *it)
+{
+        if (it->container == OBJECT || pos >= it->len) {
+                return false;
+        }
+        it_select(it, pos);
+        return true;
+}
+
+bool pindex_it_list_pos(u64 *pos, pindex_it *it)
+{
+        ERROR_IF_AND_RETURN(it->container == OBJECT, ERR_TYPEMISMATCH, "container must be array or column");
+        *pos = it->pos;
+        return true;
+}
+
+bool pindex_it_list_can_enter(pindex_it *it)
+{
+        return it->container != OBJECT && it_can_enter(it);
+}
+
+bool pindex_it_list_enter(pindex_it *it)
+{
+        return pindex_it_list_can_enter(it) && it_enter(it);
+}
+
+bool pindex_it_obj_num_props(u64 *num_props, pindex_it *it)
+{
+        ERROR_IF_AND_RETURN(it->container != OBJECT, ERR_TYPEMISMATCH, "container must be object");
+        *num_props = it->len;
+        return true;
+}
+
+bool pindex_it_obj_goto(const char *key_name, pindex_it *it)
+{
+        return pindex_it_obj_ngoto(key_name, strlen(key_name), it);
+}
+
+bool pindex_it_obj_ngoto(const char *key_name, u64 key_len, pindex_it *it)
+{
+        if (it->container != OBJECT) {
+                return false;
+        }
+
+        MEMFILE_SEEK(&it->memfile, it->contents_off + it->len * sizeof(u32));
+        u32 num_slots = MEMFILE_READ_UINTVAR_STREAM(NULL, &it->memfile);
+        u64 table_size = num_slots * sizeof(struct pindex_key_slot);
+        const struct pindex_key_slot *slots = (const struct pindex_key_slot *) MEMFILE_PEEK(&it->memfile, table_size);
+        u32 hash = pindex_key_hash(key_name, key_len);
+
+        for (u32 slot = hash & (num_slots - 1); slots[slot].pos != 0; slot = (slot + 1) & (num_slots - 1)) {
+                if (slots[slot].hash == hash) {
+                        it_select(it, slots[slot].pos - 1);
+                        u64 name_len;
+                        const char *name = pindex_it_key_name(&name_len, it);
+                        if (name_len == key_len && strncmp(name, key_name, key_len) == 0) {
+                                return true;
+                        }
+                }
+        }
+        it->node_off = 0;
+        return false;
+}
+
+const char *pindex_it_key_name(u64 *name_len, pindex_it *it)
+{
+        ERROR_IF_AND_RETURN(it->container != OBJECT || it->node_off == 0, ERR_ILLEGALSTATE,
+                            "no property selected");
+        memfile file;
+        MEMFILE_OPEN(&file, it->doc->file.memblock, READ_ONLY);
+        MEMFILE_SEEK(&file, it->key_off);
+        *name_len = MEMFILE_READ_UINTVAR_STREAM(NULL, &file);
+        return MEMFILE_PEEK(&file, *name_len);
+}
+
+bool pindex_it_obj_can_enter(pindex_it *it)
+{
+        return it->container == OBJECT && it_can_enter(it);
+}
+
+bool pindex_it_obj_enter(pindex_it *it)
+{
+        return pindex_it_obj_can_enter(it) && it_enter(it);
+}
+
+bool pindex_type(field_e *type, pindex_it *it)
+{
+        ERROR_IF_AND_RETURN(it->node_off == 0, ERR_ILLEGALSTATE, "no element or property selected");
+        *type = it->field_type;
+        return true;
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 //  diagnostics
 // ---------------------------------------------------------------------------------------------------------------------
@@ -36,7 +36,19 @@ typedef struct pindex_it {
         rec *doc;
         memfile memfile;
         container_e container;
+        /* offset of the current container in the record (0 for the record itself), number of its elements or
+         * properties, and offset of the node offsets of its contents in the index */
+        offset_t container_off;
+        u64 len;
+        offset_t contents_off;
+        /* position of the selected element or property in the current container */
         u64 pos;
+        /* offset of the node of the selected element or property in the index (0 if none is selected), its field
+         * type, and the offsets of its field and (for properties) its key in the record */
+        offset_t node_off;
+        field_e field_type;
+        offset_t field_off;
+        offset_t key_off;
 } pindex_it;
 
 typedef enum {
@@ -50,22 +62,52 @@ typedef enum {
 bool pindex_create(pindex *index, rec *doc);
 bool pindex_drop(pindex *index);
 
+// ---------------------------------------------------------------------------------------------------------------------
+//  persistence
+// ---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Writes the index to a file, e.g., next to the file of the indexed record. The file holds a short header (including
+ * the checksum of the contents of the indexed record) and the index as it is laid out in memory; all offsets in the
+ * index are relative to its beginning. Like records, the index is stored in the byte order of the host.
+ */
+bool pindex_to_file(const char *file_path, pindex *index);
+
+/**
+ * Opens an index that was written by <code>pindex_to_file</code>. The index is mapped into memory rather than read,
+ * and can be used without further processing. If <code>doc</code> is non-null, the index must have been created for
+ * the revision of <code>doc</code> (see <code>pindex_indexes_doc</code>), and for its contents, whose checksum is
+ * stored in the file header, such that an outdated index is not used after the record was revised or replaced.
+ */
+bool pindex_from_file(pindex *index, const char *file_path, rec *doc);
+
 // ---------------------------------------------------------------------------------------------------------------------
 //  index data access and meta information
 // ---------------------------------------------------------------------------------------------------------------------
 
 const void *pindex_raw_data(u64 *size, pindex *index);
 bool pindex_commit_hash(u64 *commit_hash, pindex *index);
+/* checksum of the contents of the indexed record (see commit_compute) as of the creation of the index */
+bool pindex_checksum(u64 *checksum, pindex *index);
 bool pindex_key_type(key_e *rec_key_type, pindex *index);
 bool pindex_key_unsigned_value(u64 *key, pindex *index);
 bool pindex_key_signed_value(i64 *key, pindex *index);
 const char *pindex_key_string_value(u64 *str_len, pindex *index);
+/* Returns true if the index was created for the revision of <code>doc</code>: for records with a key if key and
+ * commit hash match, and for records without a key (which have no commit hash) if the checksum of their contents
+ * matches, which costs a pass over the record. */
 bool pindex_indexes_doc(pindex *index, rec *doc);
 
 // ---------------------------------------------------------------------------------------------------------------------
 //  index access and type information
 // ---------------------------------------------------------------------------------------------------------------------
 
+/**
+ * Opens an iterator on the index of <code>doc</code>, which starts in the record itself as an array. Within a
+ * container, an element or property is selected with <code>pindex_it_list_goto</code> or
+ * <code>pindex_it_obj_goto</code> by looking up its node in the index, without reading the record. A selected
+ * container is entered with <code>pindex_it_list_enter</code> or <code>pindex_it_obj_enter</code>.
+ */
 bool pindex_it_open(pindex_it *it, pindex *index, rec *doc);
 bool pindex_it_type(container_e *type, pindex_it *it);
 
@@ -85,6 +127,12 @@ bool pindex_it_list_enter(pindex_it *it);
 
 bool pindex_it_obj_num_props(u64 *num_props, pindex_it *it);
 bool pindex_it_obj_goto(const char *key_name, pindex_it *it);
+
+/**
+ * Selects the (first) property with the name <code>key_name</code> of length <code>key_len</code> by a lookup in
+ * the key table of the object, and returns false if there is no such property.
+ */
+bool pindex_it_obj_ngoto(const char *key_name, u64 key_len, pindex_it *it);
 const char *pindex_it_key_name(u64 *name_len, pindex_it *it);
 bool pindex_it_obj_can_enter(pindex_it *it);
 bool pindex_it_obj_enter(pindex_it *it);
@@ -0,0 +1,428 @@
+/**
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/carbon/projection.h>
+#include <karbonit/carbon/item.h>
+#include <karbonit/carbon/revise.h>
+
+#define PROJ_NODE(proj, pos)            VEC_GET(&(proj)->nodes, pos, projection_node)
+#define PROJ_PATH_NEXT(proj, path)      (*VEC_GET(&(proj)->path_next, path, u32))
+
+/* state of one evaluation of a projection */
+typedef struct proj_eval {
+        const projection *proj;
+        find *results;
+        /* per node, whether the node was reached (or given up) during the scan of its parent container */
+        bool *reached;
+} proj_eval;
+
+bool projection_create(projection *proj)
+{
+        vec_create(&proj->nodes, sizeof(projection_node), 16);
+        vec_create(&proj->path_next, sizeof(u32), 8);
+
+        projection_node *root = VEC_NEW_AND_GET(&proj->nodes, projection_node);
+        ZERO_MEMORY(root, sizeof(projection_node));
+        root->first_path = PROJECTION_NO_PATH;
+        return true;
+}
+
+bool projection_drop(projection *proj)
+{
+        for (u32 i = 0; i < VEC_LENGTH(&proj->nodes); i++) {
+                free(PROJ_NODE(proj, i)->key);
+        }
+        vec_drop(&proj->nodes);
+        vec_drop(&proj->path_next);
+        return true;
+}
+
+/* returns the child of node for the path node at pos, which is added to the trie if it does not exist */
+static u32 proj_child(projection *proj, u32 node, const dot *path, u32 pos)
+{
+        dot_node_type_e type;
+        u32 idx = 0, key_len = 0;
+        const char *key = NULL;
+
+        dot_type_at(&type, pos, path);
+        if (type == DOT_NODE_IDX) {
+                dot_idx_at(&idx, pos, path);
+        } else {
+                key = dot_nkey_at(&key_len, pos, path);
+        }
+
+        u32 last = 0;
+        for (u32 child = PROJ_NODE(proj, node)->first_child; child; child = PROJ_NODE(proj, child)->next_sibling) {
+                const projection_node *candidate = PROJ_NODE(proj, child);
+                if (candidate->type == type && (type == DOT_NODE_IDX ? candidate->idx == idx :
+                        candidate->key_len == key_len && memcmp(candidate->key, key, key_len) == 0)) {
+                        return child;
+                }
+                last = child;
+        }
+
+        u32 result = VEC_LENGTH(&proj->nodes);
+        projection_node *child = VEC_NEW_AND_GET(&proj->nodes, projection_node);
+        ZERO_MEMORY(child, sizeof(projection_node));
+        child->type = type;
+        child->idx = idx;
+        if (type == DOT_NODE_KEY) {
+                child->key = MALLOC(key_len + 1);
+                memcpy(child->key, key, key_len);
+                child->key_len = key_len;
+        }
+        child->first_path = PROJECTION_NO_PATH;
+
+        if (last) {
+                PROJ_NODE(proj, last)->next_sibling = result;
+        } else {
+                PROJ_NODE(proj, node)->first_child = result;
+        }
+        return result;
+}
+
+bool projection_add(u32 *pos, projection *proj, const dot *path)
+{
+        u32 len;
+        dot_len(&len, path);
+        ERROR_IF_AND_RETURN(len == 0, ERR_ILLEGALARG, "empty path cannot be projected");
+
+        u32 node = 0;
+        for (u32 i = 0; i < len; i++) {
+                node = proj_child(proj, node, path, i);
+        }
+
+        u32 path_pos = VEC_LENGTH(&proj->path_next);
+        projection_node *end = PROJ_NODE(proj, node);
+        vec_push(&proj->path_next, &end->first_path, 1);
+        end->first_path = path_pos;
+
+        OPTIONAL_SET(pos, path_pos);
+        return true;
+}
+
+bool projection_add_string(u32 *pos, projection *proj, const char *path_string)
+{
+        const dot *path = dot_cache_get(dot_thread_cache(), path_string);
+        if (UNLIKELY(!path)) {
+                return ERROR(ERR_DOT_PATH_PARSERR, path_string);
+        }
+        return projection_add(pos, proj, path);
+}
+
+u32 projection_len(const projection *proj)
+{
+        return VEC_LENGTH(&proj->path_next);
+}
+
+/* sets the status of the paths that end in node */
+static void proj_set_status(proj_eval *eval, u32 node, pstatus_e status)
+{
+        for (u32 path = PROJ_NODE(eval->proj, node)->first_path; path != PROJECTION_NO_PATH;
+             path = PROJ_PATH_NEXT(eval->proj, path)) {
+                eval->results[path].eval.status = status;
+        }
+}
+
+/* sets the status of the paths that end in node or below */
+static void proj_fail(proj_eval *eval, u32 node, pstatus_e status)
+{
+        proj_set_status(eval, node, status);
+        for (u32 child = PROJ_NODE(eval->proj, node)->first_child; child;
+             child = PROJ_NODE(eval->proj, child)->next_sibling) {
+                proj_fail(eval, child, status);
+        }
+}
+
+/* sets the status of the paths below the children of the given type that were not reached yet */
+static void proj_fail_children(proj_eval *eval, u32 node, dot_node_type_e type, pstatus_e status)
+{
+        for (u32 child = PROJ_NODE(eval->proj, node)->first_child; child;
+             child = PROJ_NODE(eval->proj, child)->next_sibling) {
+                if (PROJ_NODE(eval->proj, child)->type == type && !eval->reached[child]) {
+                        eval->reached[child] = true;
+                        proj_fail(eval, child, status);
+                }
+        }
+}
+
+static u32 proj_num_children(proj_eval *eval, u32 node, dot_node_type_e type)
+{
+        u32 result = 0;
+        for (u32 child = PROJ_NODE(eval->proj, node)->first_child; child;
+             child = PROJ_NODE(eval->proj, child)->next_sibling) {
+                result += PROJ_NODE(eval->proj, child)->type == type && !eval->reached[child];
+        }
+        return result;
+}
+
+/* resolves the paths that end in node to the current element (or property) of the container iterator */
+static void proj_resolve(proj_eval *eval, u32 node, container_e container, void *it, u32 elem_pos)
+{
+        for (u32 path = PROJ_NODE(eval->proj, node)->first_path; path != PROJECTION_NO_PATH;
+             path = PROJ_PATH_NEXT(eval->proj, path)) {
+                find *result = eval->results + path;
+                result->eval.status = PATH_RESOLVED;
+                result->eval.result.container = container;
+                switch (container) {
+                        case ARRAY:
+                                internal_arr_it_clone(&result->eval.result.containers.array, it);
+                                break;
+                        case OBJECT:
+                                internal_obj_it_clone(&result->eval.result.containers.object, it);
+                                break;
+                        case COLUMN:
+                                col_it_clone(&result->eval.result.containers.column.it, it);
+                                result->eval.result.containers.column.elem_pos = elem_pos;
+                                break;
+                        default: ERROR(ERR_INTERNALERR, NULL);
+                                result->eval.status = PATH_INTERNAL;
+                                continue;
+                }
+                internal_find_from_eval(result);
+        }
+}
+
+static void proj_traverse_array(proj_eval *eval, u32 node, arr_it *it, bool is_record);
+static void proj_traverse_object(proj_eval *eval, u32 node, obj_it *it, bool is_record);
+static void proj_traverse_column(proj_eval *eval, u32 node, col_it *it);
+
+/* continues the evaluation of the paths below node in the container stored in value */
+static void proj_descend(proj_eval *eval, u32 node, field_e type, item *value)
+{
+        if (!FIELD_IS_TRAVERSABLE(type)) {
+                proj_fail_children(eval, node, DOT_NODE_IDX, PATH_NOTTRAVERSABLE);
+                proj_fail_children(eval, node, DOT_NODE_KEY, PATH_NOTTRAVERSABLE);
+        } else if (FIELD_IS_OBJECT_OR_SUBTYPE(type)) {
+                obj_it sub_it;
+                ITEM_GET_OBJECT(&sub_it, value);
+                proj_traverse_object(eval, node, &sub_it, false);
+        } else if (FIELD_IS_ARRAY_OR_SUBTYPE(type)) {
+                arr_it sub_it;
+                ITEM_GET_ARRAY(&sub_it, value);
+                proj_traverse_array(eval, node, &sub_it, false);
+        } else {
+                assert(FIELD_IS_COLUMN_OR_SUBTYPE(type));
+                col_it sub_it;
+                ITEM_GET_COLUMN(&sub_it, value);
+                proj_traverse_column(eval, node, &sub_it);
+        }
+}
+
+/* evaluates node (and below) for the current element of the array iterator */
+static void proj_visit_element(proj_eval *eval, u32 node, arr_it *it, bool is_unit_record)
+{
+        field_e elem_type;
+        arr_it_field_type(&elem_type, it);
+
+        if (is_unit_record && FIELD_IS_COLUMN_OR_SUBTYPE(elem_type)) {
+                /** the column of a unit record is evaluated as if it was the record itself */
+                proj_set_status(eval, node, PATH_NONESTING);
+                col_it sub_it;
+                ITEM_GET_COLUMN(&sub_it, &(it->item));
+                proj_traverse_column(eval, node, &sub_it);
+                return;
+        }
+
+        proj_resolve(eval, node, ARRAY, it, 0);
+        if (PROJ_NODE(eval->proj, node)->first_child) {
+                if (FIELD_IS_TRAVERSABLE(elem_type)) {
+                        /** index nodes require an array or column, and key nodes require an object */
+                        if (FIELD_IS_OBJECT_OR_SUBTYPE(elem_type)) {
+                                proj_fail_children(eval, node, DOT_NODE_IDX, PATH_NOCONTAINER);
+                        } else {
+                                proj_fail_children(eval, node, DOT_NODE_KEY, PATH_NOTANOBJECT);
+                        }
+                }
+                proj_descend(eval, node, elem_type, &(it->item));
+        }
+}
+
+static void proj_traverse_array(proj_eval *eval, u32 node, arr_it *it, bool is_record)
+{
+        if (!arr_it_next(it)) {
+                /** empty document */
+                proj_fail_children(eval, node, DOT_NODE_IDX, PATH_EMPTY_DOC);
+                proj_fail_children(eval, node, DOT_NODE_KEY, PATH_EMPTY_DOC);
+                return;
+        }
+
+        bool is_unit_record = is_record && arr_it_is_unit(it);
+
+        if (proj_num_children(eval, node, DOT_NODE_KEY) > 0) {
+                /** key lookups in an array are only defined for a record that consists of a single object */
+                field_e elem_type;
+                arr_it_field_type(&elem_type, it);
+                if (!FIELD_IS_OBJECT_OR_SUBTYPE(elem_type)) {
+                        proj_fail_children(eval, node, DOT_NODE_KEY, PATH_NOTANOBJECT);
+                } else if (is_unit_record) {
+                        obj_it sub_it;
+                        ITEM_GET_OBJECT(&sub_it, &(it->item));
+                        proj_traverse_object(eval, node, &sub_it, true);
+                } else {
+                        proj_fail_children(eval, node, DOT_NODE_KEY, PATH_NOSUCHKEY);
+                }
+        }
+
+        u32 pending = proj_num_children(eval, node, DOT_NODE_IDX);
+        for (u32 pos = 0; pending > 0; pos++) {
+                for (u32 child = PROJ_NODE(eval->proj, node)->first_child; child;
+                     child = PROJ_NODE(eval->proj, child)->next_sibling) {
+                        const projection_node *candidate = PROJ_NODE(eval->proj, child);
+                        if (candidate->type == DOT_NODE_IDX && candidate->idx == pos) {
+                                eval->reached[child] = true;
+                                proj_visit_element(eval, child, it, is_unit_record);
+                                pending--;
+                                break;
+                        }
+                }
+                if (pending > 0 && !arr_it_next(it)) {
+                        break;
+                }
+        }
+        proj_fail_children(eval, node, DOT_NODE_IDX, PATH_NOSUCHINDEX);
+}
+
+/* whether some of the pending keys of the node is not less than 'key', i.e., may follow in a sorted map */
+static bool proj_keys_pending_from(proj_eval *eval, u32 node, string_field key)
+{
+        for (u32 child = PROJ_NODE(eval->proj, node)->first_child; child;
+             child = PROJ_NODE(eval->proj, child)->next_sibling) {
+                const projection_node *candidate = PROJ_NODE(eval->proj, child);
+                if (candidate->type == DOT_NODE_KEY && !eval->reached[child] &&
+                    internal_obj_it_key_cmp(candidate->key, candidate->key_len, key.str, key.len) >= 0) {
+                        return true;
+                }
+        }
+        return false;
+}
+
+static void proj_traverse_object(proj_eval *eval, u32 node, obj_it *it, bool is_record)
+{
+        if (!obj_it_next(it)) {
+                /** empty document */
+                proj_fail_children(eval, node, DOT_NODE_KEY, PATH_EMPTY_DOC);
+                if (!is_record) {
+                        proj_fail_children(eval, node, DOT_NODE_IDX, PATH_EMPTY_DOC);
+                }
+                return;
+        }
+
+        u32 pending = proj_num_children(eval, node, DOT_NODE_KEY);
+        bool is_sorted = obj_it_is_sorted(it);
+        while (pending > 0) {
+                string_field prop_key = internal_obj_it_prop_name(it);
+                if (is_sorted && !proj_keys_pending_from(eval, node, prop_key)) {
+                        /** properties of sorted maps are in order of their keys, i.e., no pending key follows */
+                        break;
+                }
+                for (u32 child = PROJ_NODE(eval->proj, node)->first_child; child;
+                     child = PROJ_NODE(eval->proj, child)->next_sibling) {
+                        const projection_node *candidate = PROJ_NODE(eval->proj, child);
+                        if (candidate->type == DOT_NODE_KEY && !eval->reached[child] &&
+                            candidate->key_len == prop_key.len &&
+                            strncmp(candidate->key, prop_key.str, prop_key.len) == 0) {
+                                /** the first property with a matching key is taken, as for find */
+                                eval->reached[child] = true;
+                                proj_resolve(eval, child, OBJECT, it, 0);
+                                if (candidate->first_child) {
+                                        field_e prop_type;
+                                        internal_obj_it_prop_type(&prop_type, it);
+                                        proj_descend(eval, child, prop_type, &(it->prop.value));
+                                }
+                                pending--;
+                                break;
+                        }
+                }
+                if (pending > 0 && !obj_it_next(it)) {
+                        break;
+                }
+        }
+        proj_fail_children(eval, node, DOT_NODE_KEY, PATH_NOSUCHKEY);
+        if (!is_record) {
+                proj_fail_children(eval, node, DOT_NODE_IDX, PATH_NOSUCHKEY);
+        }
+}
+
+static void proj_traverse_column(proj_eval *eval, u32 node, col_it *it)
+{
+        field_e column_type;
+        u32 num_values = COL_IT_VALUES_INFO(&column_type, it);
+
+        for (u32 child = PROJ_NODE(eval->proj, node)->first_child; child;
+             child = PROJ_NODE(eval->proj, child)->next_sibling) {
+                const projection_node *candidate = PROJ_NODE(eval->proj, child);
+                if (candidate->type == DOT_NODE_IDX && !eval->reached[child]) {
+                        eval->reached[child] = true;
+                        if (candidate->idx < num_values) {
+                                proj_resolve(eval, child, COLUMN, it, candidate->idx);
+                        } else {
+                                proj_set_status(eval, child, PATH_NOSUCHINDEX);
+                        }
+                        /** a column cannot contain further containers */
+                        proj_fail_children(eval, child, DOT_NODE_IDX, PATH_NONESTING);
+                        proj_fail_children(eval, child, DOT_NODE_KEY, PATH_NONESTING);
+                }
+        }
+        proj_fail_children(eval, node, DOT_NODE_KEY, PATH_NOSUCHINDEX);
+}
+
+static bool proj_exec(find *results, const projection *proj, rec *doc, arr_it *it)
+{
+        u32 num_paths = projection_len(proj);
+        for (u32 i = 0; i < num_paths; i++) {
+                ZERO_MEMORY(results + i, sizeof(find));
+                results[i].doc = doc;
+                results[i].eval.doc = doc;
+                results[i].eval.status = PATH_INTERNAL;
+        }
+
+        proj_eval eval = {
+                .proj = proj,
+                .results = results,
+                .reached = MALLOC(VEC_LENGTH(&proj->nodes) * sizeof(bool))
+        };
+
+        proj_traverse_array(&eval, 0, it, true);
+        free(eval.reached);
+
+        bool all_resolved = true;
+        for (u32 i = 0; i < num_paths; i++) {
+                all_resolved &= find_has_result(results + i);
+        }
+        return all_resolved;
+}
+
+bool projection_exec(find *results, const projection *proj, rec *doc)
+{
+        arr_it it;
+        rec_read(&it, doc);
+        return proj_exec(results, proj, doc, &it);
+}
+
+bool projection_exec_mutable(find *results, const projection *proj, rev *context)
+{
+        arr_it it;
+        if (!revise_iterator_open(&it, context)) {
+                return ERROR(ERR_OPPFAILED, "revise iterator cannot be opened");
+        }
+        return proj_exec(results, proj, context->revised, &it);
+}
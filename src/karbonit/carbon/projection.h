@@ -0,0 +1,89 @@
+/*
+ * projection - evaluation of several dot paths in a single record traversal
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_PROJECTION_H
+#define HAD_PROJECTION_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/rec.h>
+#include <karbonit/carbon/dot.h>
+#include <karbonit/carbon/find.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PROJECTION_NO_PATH      UINT32_MAX
+
+typedef struct projection_node {
+        dot_node_type_e type;
+        /* array index (index nodes only) */
+        u32 idx;
+        /* key name (key nodes only), owned by the projection */
+        char *key;
+        u32 key_len;
+        /* first child, and next sibling, of this node; 0 if there is none */
+        u32 first_child;
+        u32 next_sibling;
+        /* first of the paths that end in this node, or PROJECTION_NO_PATH */
+        u32 first_path;
+} projection_node;
+
+/**
+ * Set of dot paths that are merged into a trie by their common prefixes, such that all of them are evaluated in a
+ * single pass over a record (see <code>projection_exec</code>). Each array or object on the way is scanned at most
+ * once regardless of how many paths go through it, whereas <code>find_from_dot</code> walks from the record root for
+ * each path on its own. A projection is not modified by its evaluation, and may be evaluated by several threads at
+ * the same time.
+ */
+typedef struct projection {
+        /* nodes of the trie; node 0 is the root, which stands for the record itself */
+        vec ofType(projection_node) nodes;
+        /* for each path, the next path that ends in the same node, or PROJECTION_NO_PATH */
+        vec ofType(u32) path_next;
+} projection;
+
+bool projection_create(projection *proj);
+bool projection_drop(projection *proj);
+
+/**
+ * Adds <code>path</code> to the projection, and stores in <code>pos</code> (if non-null) the position of the result
+ * for this path in the results of <code>projection_exec</code>. Paths are numbered in the order they are added; the
+ * same path may be added more than once. The path is copied, and must not be empty.
+ */
+bool projection_add(u32 *pos, projection *proj, const dot *path);
+bool projection_add_string(u32 *pos, projection *proj, const char *path_string);
+
+/**
+ * Returns the number of paths in the projection
+ */
+u32 projection_len(const projection *proj);
+
+/**
+ * Evaluates all paths of the projection on <code>doc</code>. The caller provides one <code>find</code> per path in
+ * <code>results</code> (see <code>projection_len</code>), each of which is set to the result that
+ * <code>find_from_dot</code> yields for that path, and is accessed with the <code>find_result_*</code> functions.
+ * Returns true if all paths are resolved.
+ */
+bool projection_exec(find *results, const projection *proj, rec *doc);
+
+/**
+ * Evaluates all paths of the projection on the revised record of <code>context</code>, as
+ * <code>projection_exec</code> does. The iterators of the results may be used to modify the revised record; as long
+ * as no modification changes the size of a field, all results remain valid.
+ */
+bool projection_exec_mutable(find *results, const projection *proj, rev *context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -40,9 +40,26 @@ void revise_begin(rev *context, rec *revised, rec *original)
 {
         context->original = original;
         context->revised = revised;
+        context->index = NULL;
         rec_clone(context->revised, context->original);
 }
 
+void revise_begin_indexed(rev *context, rec *revised, rec *original, pindex *index)
+{
+        revise_begin(context, revised, original);
+        context->index = index;
+}
+
+void revise_begin_copy(rev *context, rec *revised, rec *original)
+{
+        context->original = original;
+        context->revised = revised;
+        context->index = NULL;
+        MEMBLOCK_CPY(&revised->block, original->block);
+        MEMFILE_OPEN(&revised->file, revised->block, READ_WRITE);
+        revised->data_off = original->data_off;
+}
+
 
 static void key_unsigned_set(rec *doc, u64 key)
 {
@@ -138,9 +155,16 @@ void revise_set_list_type(rev *context, list_type_e derivation)
         abstract_write_derived_type(&it.file, derive_marker);
 }
 
+bool revise_set_gap_mode(rev *context, bool enabled)
+{
+        return MEMBLOCK_SET_GAP_MODE(context->revised->file.memblock, enabled);
+}
+
 bool revise_iterator_open(arr_it *it, rev *context)
 {
         offset_t payload_start = INTERNAL_PAYLOAD_AFTER_HEADER(context->revised);
+        /** the caller may modify the revised record with the iterator */
+        context->index = NULL;
         if (UNLIKELY(context->revised->file.mode != READ_WRITE)) {
                 return ERROR(ERR_PERMISSIONS, "revise iterator on read-only record invoked");
         }
@@ -149,11 +173,11 @@ bool revise_iterator_open(arr_it *it, rev *context)
 
 bool revise_find_begin(find *out, const char *dot, rev *context)
 {
-        struct dot path;
-        dot_from_string(&path, dot);
-        bool status = internal_find_exec(out, &path, context->revised);
-        dot_drop(&path);
-        return status;
+        const struct dot *path = dot_cache_get(dot_thread_cache(), dot);
+        if (UNLIKELY(!path)) {
+                return ERROR(ERR_DOT_PATH_PARSERR, NULL);
+        }
+        return internal_find_exec(out, path, context->revised);
 }
 
 bool revise_remove_one(const char *dot, rec *rev_doc, rec *doc)
@@ -167,12 +191,12 @@ bool revise_remove_one(const char *dot, rec *rev_doc, rec *doc)
 
 bool revise_remove(const char *path, rev *context)
 {
-        struct dot dot;
+        const struct dot *dot = dot_cache_get(dot_thread_cache(), path);
         dot_eval eval;
         bool result;
 
-        if (dot_from_string(&dot, path)) {
-                dot_eval_begin_mutable(&eval, &dot, context);
+        if (dot) {
+                dot_eval_begin_mutable(&eval, dot, context);
 
                 if (eval.status != PATH_RESOLVED) {
                         result = false;
@@ -194,7 +218,6 @@ bool revise_remove(const char *path, rev *context)
                         }
                 }
 
-                dot_drop(&dot);
                 return result;
         } else {
                 ERROR(ERR_DOT_PATH_PARSERR, NULL);
@@ -229,6 +252,7 @@ bool revise_shrink(rev *context)
 
 const rec *revise_end(rev *context)
 {
+        MEMBLOCK_SET_GAP_MODE(context->revised->file.memblock, false);
         internal_commit_update(context->revised);
         return context->revised;
 }
@@ -414,9 +438,7 @@ static bool carbon_header_rev_inc(rec *doc)
         MEMFILE_SEEK(&doc->file, 0);
         key_read(NULL, &rec_key_type, &doc->file);
         if (rec_has_key(rec_key_type)) {
-                u64 raw_data_len = 0;
-                const void *raw_data = rec_raw_data(&raw_data_len, doc);
-                commit_update(&doc->file, raw_data, raw_data_len);
+                commit_update_incremental(&doc->file);
         }
         MEMFILE_RESTORE_POSITION(&doc->file);
 
@@ -32,6 +32,22 @@ extern "C" {
  *                            <code>revise_begin</code>
  */
 void revise_begin(rev *context, rec *revised, rec *original);
+
+/**
+ * Begins a revision as <code>revise_begin</code> does, for which <code>index</code> is a path index of the original
+ * record (see <code>pindex_create</code>). The path of the first update (or removal) of the revision is resolved by
+ * jumping to its position known from the index. The revision releases the index when the revised record is accessed
+ * for modification (e.g., by <code>revise_iterator_open</code>), since the positions in the index are outdated then.
+ * An index that was not created for <code>original</code> is ignored.
+ */
+void revise_begin_indexed(rev *context, rec *revised, rec *original, pindex *index);
+
+/**
+ * Begins a revision as <code>revise_begin</code> does, but copies <code>original</code> into heap memory at once
+ * rather than sharing it copy-on-write (see MEMBLOCK_CPY_SHARED), i.e., the revision does not hold a shared memory
+ * object.
+ */
+void revise_begin_copy(rev *context, rec *revised, rec *original);
 const rec *revise_end(rev *context);
 
 bool revise_key_generate(unique_id_t *out, rev *context);
@@ -42,6 +58,18 @@ bool revise_key_set_string(rev *context, const char *key_value);
 
 void revise_set_list_type(rev *context, list_type_e derivation);
 
+/**
+ * Enables (or disables) the gap editing mode for the revised record. In gap mode, the revised record keeps a movable
+ * gap at the position of the most recent insertion or removal such that sequences of localized edits (e.g., inserting
+ * many elements at the same iterator position) do not move the remainder of the record for each single edit. The
+ * record is materialized into its contiguous layout at latest by <code>revise_end</code>.
+ *
+ * @param context non-null pointer to revision context
+ * @param enabled <code>true</code> to enable the gap mode, <code>false</code> to disable it
+ * @return <code>true</code> on success, otherwise <code>false</code>
+ */
+bool revise_set_gap_mode(rev *context, bool enabled);
+
 bool revise_iterator_open(arr_it *it, rev *context);
 
 bool revise_find_begin(find *out, const char *dot, rev *context);
@@ -0,0 +1,198 @@
+/**
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/carbon/skip-index.h>
+#include <karbonit/carbon/obj-it.h>
+#include <karbonit/carbon/item.h>
+#include <karbonit/carbon/commit.h>
+
+static void skip_index_array(skip_index *index, arr_it *it);
+
+/* indexes the arrays in (or being) the container value */
+static void skip_index_value(skip_index *index, field_e type, item *value)
+{
+        if (FIELD_IS_ARRAY_OR_SUBTYPE(type)) {
+                arr_it sub_it;
+                ITEM_GET_ARRAY(&sub_it, value);
+                skip_index_array(index, &sub_it);
+        } else if (FIELD_IS_OBJECT_OR_SUBTYPE(type)) {
+                obj_it sub_it;
+                ITEM_GET_OBJECT(&sub_it, value);
+                while (obj_it_next(&sub_it)) {
+                        field_e prop_type;
+                        internal_obj_it_prop_type(&prop_type, &sub_it);
+                        skip_index_value(index, prop_type, &(sub_it.prop.value));
+                }
+        }
+}
+
+/* scans the array from its beginning, and indexes the arrays nested in it if index is non-null */
+static void skip_scan(skip_index *index, arr_skip *skip, arr_it *it, u32 stride)
+{
+        skip->begin = it->begin;
+        skip->stride = stride;
+        skip->len = 0;
+        vec_create(&skip->offsets, sizeof(offset_t), 16);
+
+        ARR_IT_REWIND(it);
+        it->eof = false;
+        while (true) {
+                offset_t off = MEMFILE_TELL(&it->file);
+                if (!arr_it_next(it)) {
+                        break;
+                }
+                if (skip->len % stride == 0) {
+                        vec_push(&skip->offsets, &off, 1);
+                }
+                skip->len++;
+
+                if (index) {
+                        field_e type;
+                        arr_it_field_type(&type, it);
+                        skip_index_value(index, type, &(it->item));
+                }
+        }
+}
+
+static void skip_index_array(skip_index *index, arr_it *it)
+{
+        arr_skip skip;
+        skip_scan(index, &skip, it, index->stride);
+        if (skip.len >= index->min_len) {
+                vec_push(&index->arrays, &skip, 1);
+        } else {
+                arr_skip_drop(&skip);
+        }
+}
+
+bool arr_skip_create(arr_skip *skip, arr_it *it, u32 stride)
+{
+        ERROR_IF_AND_RETURN(stride == 0, ERR_ILLEGALARG, "stride must be positive");
+        arr_it scan;
+        internal_arr_it_copy(&scan, it);
+        skip_scan(NULL, skip, &scan, stride);
+        return true;
+}
+
+bool arr_skip_drop(arr_skip *skip)
+{
+        return vec_drop(&skip->offsets);
+}
+
+item *arr_it_seek(arr_it *it, u64 pos, const arr_skip *skip)
+{
+        if (skip && pos >= skip->stride) {
+                if (pos >= skip->len) {
+                        return NULL;
+                }
+                u64 entry = pos / skip->stride;
+                MEMFILE_SEEK(&it->file, *VEC_GET(&skip->offsets, entry, offset_t));
+                it->pos = entry * skip->stride;
+        } else {
+                ARR_IT_REWIND(it);
+        }
+        it->eof = false;
+
+        item *result;
+        do {
+                result = arr_it_next(it);
+        } while (result && it->pos <= pos);
+        return result;
+}
+
+static u64 skip_record_checksum(rec *doc)
+{
+        u64 len, checksum;
+        const void *data = rec_raw_data(&len, doc);
+        commit_compute(&checksum, data, len);
+        return checksum;
+}
+
+static int skip_cmp_begin(const void *lhs, const void *rhs)
+{
+        offset_t a = ((const arr_skip *) lhs)->begin, b = ((const arr_skip *) rhs)->begin;
+        return (a > b) - (a < b);
+}
+
+bool skip_index_create(skip_index *index, rec *doc, u32 stride, u32 min_len)
+{
+        rec_commit_hash(&index->commit_hash, doc);
+        index->checksum = skip_record_checksum(doc);
+        index->stride = stride ? stride : SKIP_INDEX_DEFAULT_STRIDE;
+        index->min_len = min_len;
+        vec_create(&index->arrays, sizeof(arr_skip), 8);
+
+        arr_it it;
+        rec_read(&it, doc);
+        skip_index_array(index, &it);
+
+        /** nested arrays are added before the arrays that contain them */
+        qsort(VEC_ALL(&index->arrays, arr_skip), VEC_LENGTH(&index->arrays), sizeof(arr_skip), skip_cmp_begin);
+        return true;
+}
+
+bool skip_index_drop(skip_index *index)
+{
+        for (u32 i = 0; i < VEC_LENGTH(&index->arrays); i++) {
+                arr_skip_drop(VEC_GET(&index->arrays, i, arr_skip));
+        }
+        return vec_drop(&index->arrays);
+}
+
+bool skip_index_update(skip_index *index, rec *doc)
+{
+        if (!skip_index_indexes_doc(index, doc)) {
+                u32 stride = index->stride, min_len = index->min_len;
+                skip_index_drop(index);
+                return skip_index_create(index, doc, stride, min_len);
+        }
+        return true;
+}
+
+bool skip_index_indexes_doc(const skip_index *index, rec *doc)
+{
+        u64 doc_hash;
+        rec_commit_hash(&doc_hash, doc);
+        if (index->commit_hash != doc_hash) {
+                return false;
+        }
+
+        key_e key_type;
+        rec_key_type(&key_type, doc);
+        /** no commit hash to compare, since records without key have none */
+        return key_type != KEY_NOKEY || index->checksum == skip_record_checksum(doc);
+}
+
+const arr_skip *skip_index_get(const skip_index *index, offset_t begin)
+{
+        const arr_skip *arrays = VEC_ALL(&index->arrays, arr_skip);
+        u32 lo = 0, hi = VEC_LENGTH(&index->arrays);
+        while (lo < hi) {
+                u32 mid = lo + (hi - lo) / 2;
+                if (arrays[mid].begin < begin) {
+                        lo = mid + 1;
+                } else {
+                        hi = mid;
+                }
+        }
+        return lo < VEC_LENGTH(&index->arrays) && arrays[lo].begin == begin ? arrays + lo : NULL;
+}
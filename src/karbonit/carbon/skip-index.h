@@ -0,0 +1,104 @@
+/*
+ * skip-index - positional side-car index for random access into large arrays
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_SKIP_INDEX_H
+#define HAD_SKIP_INDEX_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/rec.h>
+#include <karbonit/std/vec.h>
+#include <karbonit/carbon/arr-it.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SKIP_INDEX_DEFAULT_STRIDE       64
+
+/**
+ * Positions of every <code>stride</code>-th element of an array, such that an iterator can be moved to any element
+ * by stepping over at most <code>stride - 1</code> elements (see <code>arr_it_seek</code>).
+ */
+typedef struct arr_skip {
+        /* offset of the array in its record, which identifies the array */
+        offset_t begin;
+        /* number of elements between two consecutive positions */
+        u32 stride;
+        /* number of elements in the array */
+        u64 len;
+        /* for the elements 0, stride, 2 * stride, ..., the offset at which the iterator reads the element */
+        vec ofType(offset_t) offsets;
+} arr_skip;
+
+/**
+ * Skip indexes for all arrays of a record that have a minimum number of elements. The index is kept aside from the
+ * record, and is bound to the revision of the record it was created for (see <code>skip_index_indexes_doc</code>).
+ * Like a record revision, an index is not modified once created, and may be used by several threads at the same time.
+ */
+typedef struct skip_index {
+        /* commit hash of the indexed record revision */
+        u64 commit_hash;
+        /* checksum of the contents of the indexed record (see commit_compute), since records without a primary key
+         * have no commit hash */
+        u64 checksum;
+        u32 stride;
+        u32 min_len;
+        /* indexed arrays, sorted by their offset */
+        vec ofType(arr_skip) arrays;
+} skip_index;
+
+/**
+ * Indexes the array on which <code>it</code> operates, which is scanned from its beginning. The iterator itself is
+ * not moved.
+ */
+bool arr_skip_create(arr_skip *skip, arr_it *it, u32 stride);
+bool arr_skip_drop(arr_skip *skip);
+
+/**
+ * Moves the iterator to the element at <code>pos</code>, and returns that element as <code>arr_it_next</code> does.
+ * The iterator can be in any state, and continues with the element after <code>pos</code> afterwards. If
+ * <code>skip</code> is non-null, it must have been created for the same array, and the iterator jumps close to the
+ * requested element instead of stepping over all elements before it. Returns <code>NULL</code> if the array has no
+ * element at <code>pos</code>.
+ */
+item *arr_it_seek(arr_it *it, u64 pos, const arr_skip *skip);
+
+/**
+ * Creates skip indexes with the given stride for all arrays (the record itself included) that have at least
+ * <code>min_len</code> elements. For <code>stride</code> 0, <code>SKIP_INDEX_DEFAULT_STRIDE</code> is used.
+ */
+bool skip_index_create(skip_index *index, rec *doc, u32 stride, u32 min_len);
+bool skip_index_drop(skip_index *index);
+
+/**
+ * Re-creates the index for <code>doc</code> (with the same stride and minimum length) if it does not index
+ * <code>doc</code>, e.g., after <code>doc</code> was revised.
+ */
+bool skip_index_update(skip_index *index, rec *doc);
+
+/**
+ * Returns true if <code>index</code> was created for the revision of <code>doc</code>. Records without a
+ * primary key have no commit hash; for these, the checksum of their contents is compared instead, which costs a pass
+ * over the record.
+ */
+bool skip_index_indexes_doc(const skip_index *index, rec *doc);
+
+/**
+ * Returns the skip index of the array at offset <code>begin</code> in the record, or <code>NULL</code> if that array
+ * is not indexed.
+ */
+const arr_skip *skip_index_get(const skip_index *index, offset_t begin);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
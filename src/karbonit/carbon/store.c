@@ -0,0 +1,500 @@
+/**
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/carbon/store.h>
+#include <karbonit/std/hash.h>
+
+/* initial number of buckets of the hash index, which doubles whenever there are more records than buckets */
+#define STORE_INITIAL_BUCKETS   64
+
+/* a record in the ordered index, whose record is replaced atomically by the writer */
+struct store_node {
+        store_key key;
+        hash64_t hash;
+        _Atomic(rec *) record;
+        u32 height;
+        /* successors per level, of which the node has 'height' */
+        _Atomic(store_node *) next[];
+};
+
+/* an entry of a bucket of the hash index, which is immutable except for its successor */
+typedef struct store_entry {
+        hash64_t hash;
+        store_node *node;
+        _Atomic(struct store_entry *) next;
+} store_entry;
+
+struct store_table {
+        u64 mask;
+        _Atomic(store_entry *) buckets[];
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  keys
+// ---------------------------------------------------------------------------------------------------------------------
+
+static int key_cmp(const store *store, const store_key *lhs, const store_key *rhs)
+{
+        switch (store->key_type) {
+                case KEY_AUTOKEY:
+                case KEY_UKEY:
+                        return (lhs->value.unsigned_key > rhs->value.unsigned_key) -
+                               (lhs->value.unsigned_key < rhs->value.unsigned_key);
+                case KEY_IKEY:
+                        return (lhs->value.signed_key > rhs->value.signed_key) -
+                               (lhs->value.signed_key < rhs->value.signed_key);
+                default: {
+                        int cmp = memcmp(lhs->str, rhs->str, JAK_MIN(lhs->len, rhs->len));
+                        return cmp ? cmp : (lhs->len > rhs->len) - (lhs->len < rhs->len);
+                }
+        }
+}
+
+static hash64_t key_hash(const store *store, const store_key *key)
+{
+        return rec_key_is_string(store->key_type) ? HASH64_XX(key->len, key->str) :
+               HASH64_XX(sizeof(u64), &key->value.unsigned_key);
+}
+
+static void key_of_unsigned(store_key *key, u64 value)
+{
+        ZERO_MEMORY(key, sizeof(store_key));
+        key->value.unsigned_key = value;
+}
+
+static void key_of_signed(store_key *key, i64 value)
+{
+        ZERO_MEMORY(key, sizeof(store_key));
+        key->value.signed_key = value;
+}
+
+static void key_of_string(store_key *key, const char *value)
+{
+        ZERO_MEMORY(key, sizeof(store_key));
+        key->str = value;
+        key->len = strlen(value);
+}
+
+/* reads the key of 'doc', of which a string key points into 'doc' */
+static bool key_of_record(store_key *key, const store *store, rec *doc)
+{
+        u64 len;
+        key_e type;
+        const void *value = rec_key_raw_value(&len, &type, doc);
+        if (UNLIKELY(rec_key_is_unsigned(type) != rec_key_is_unsigned(store->key_type) ||
+                     rec_key_is_signed(type) != rec_key_is_signed(store->key_type) ||
+                     rec_key_is_string(type) != rec_key_is_string(store->key_type))) {
+                return ERROR(ERR_TYPEMISMATCH, "record key type does not match the key type of the store");
+        }
+        ZERO_MEMORY(key, sizeof(store_key));
+        if (rec_key_is_string(type)) {
+                key->str = value;
+                key->len = len;
+        } else {
+                memcpy(&key->value, value, sizeof(u64));
+        }
+        return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  views
+// ---------------------------------------------------------------------------------------------------------------------
+
+static void view_of(rec *view, store_node *node)
+{
+        rec_view(view, atomic_load_explicit(&node->record, memory_order_acquire));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  ordered index
+// ---------------------------------------------------------------------------------------------------------------------
+
+static store_node *node_create(store_key *key, hash64_t hash, rec *record, u32 height)
+{
+        store_node *node = MALLOC(sizeof(store_node) + height * sizeof(_Atomic(store_node *)));
+        node->key = *key;
+        if (key->str) {
+                char *str = MALLOC(key->len + 1);
+                memcpy(str, key->str, key->len);
+                node->key.str = str;
+        }
+        node->hash = hash;
+        node->height = height;
+        atomic_init(&node->record, record);
+        for (u32 level = 0; level < height; level++) {
+                atomic_init(&node->next[level], NULL);
+        }
+        return node;
+}
+
+static void node_drop(void *ptr)
+{
+        store_node *node = ptr;
+        rec *record = atomic_load_explicit(&node->record, memory_order_relaxed);
+        if (record) {
+                rec_drop_and_free(record);
+        }
+        free((char *) node->key.str);
+        free(node);
+}
+
+/* random level with probability 1/4 per level above the first one */
+static u32 node_height(store *store)
+{
+        store->seed ^= store->seed << 13;
+        store->seed ^= store->seed >> 7;
+        store->seed ^= store->seed << 17;
+        u32 height = 1;
+        for (u64 bits = store->seed; height < STORE_MAX_HEIGHT && (bits & 3) == 0; bits >>= 2) {
+                height++;
+        }
+        return height;
+}
+
+/* returns the first node whose key is not less than 'key', and stores its predecessors per level in 'preds' if
+ * non-null; a null key seeks the first node */
+static store_node *seek(store *store, const store_key *key, store_node **preds)
+{
+        store_node *pred = store->head;
+        for (i32 level = STORE_MAX_HEIGHT - 1; level >= 0; level--) {
+                store_node *next = atomic_load_explicit(&pred->next[level], memory_order_acquire);
+                while (key && next && key_cmp(store, &next->key, key) < 0) {
+                        pred = next;
+                        next = atomic_load_explicit(&pred->next[level], memory_order_acquire);
+                }
+                if (preds) {
+                        preds[level] = pred;
+                }
+        }
+        return atomic_load_explicit(&pred->next[0], memory_order_acquire);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  hash index
+// ---------------------------------------------------------------------------------------------------------------------
+
+static store_table *table_create(u64 num_buckets)
+{
+        store_table *table = MALLOC(sizeof(store_table) + num_buckets * sizeof(_Atomic(store_entry *)));
+        table->mask = num_buckets - 1;
+        for (u64 i = 0; i < num_buckets; i++) {
+                atomic_init(&table->buckets[i], NULL);
+        }
+        return table;
+}
+
+static void table_drop(void *ptr)
+{
+        store_table *table = ptr;
+        for (u64 i = 0; i <= table->mask; i++) {
+                store_entry *entry = atomic_load_explicit(&table->buckets[i], memory_order_relaxed);
+                while (entry) {
+                        store_entry *next = atomic_load_explicit(&entry->next, memory_order_relaxed);
+                        free(entry);
+                        entry = next;
+                }
+        }
+        free(table);
+}
+
+static void table_insert(store_table *table, store_node *node)
+{
+        _Atomic(store_entry *) *bucket = &table->buckets[node->hash & table->mask];
+        store_entry *entry = MALLOC(sizeof(store_entry));
+        entry->hash = node->hash;
+        entry->node = node;
+        atomic_init(&entry->next, atomic_load_explicit(bucket, memory_order_relaxed));
+        atomic_store_explicit(bucket, entry, memory_order_release);
+}
+
+static store_node *table_lookup(store *store, const store_key *key)
+{
+        hash64_t hash = key_hash(store, key);
+        store_table *table = atomic_load_explicit(&store->table, memory_order_acquire);
+        store_entry *entry = atomic_load_explicit(&table->buckets[hash & table->mask], memory_order_acquire);
+        for (; entry; entry = atomic_load_explicit(&entry->next, memory_order_acquire)) {
+                if (entry->hash == hash && key_cmp(store, &entry->node->key, key) == 0) {
+                        return entry->node;
+                }
+        }
+        return NULL;
+}
+
+static void table_remove(store *store, store_node *node)
+{
+        store_table *table = atomic_load_explicit(&store->table, memory_order_relaxed);
+        _Atomic(store_entry *) *link = &table->buckets[node->hash & table->mask];
+        store_entry *entry;
+        while ((entry = atomic_load_explicit(link, memory_order_relaxed))->node != node) {
+                link = &entry->next;
+        }
+        atomic_store_explicit(link, atomic_load_explicit(&entry->next, memory_order_relaxed), memory_order_release);
+        epoch_retire(&store->reclaim, entry, free);
+}
+
+/* replaces the hash index by one with twice the number of buckets, which is built before it is published */
+static void table_grow(store *store)
+{
+        store_table *table = atomic_load_explicit(&store->table, memory_order_relaxed);
+        store_table *grown = table_create(2 * (table->mask + 1));
+        for (store_node *node = atomic_load_explicit(&store->head->next[0], memory_order_relaxed); node;
+             node = atomic_load_explicit(&node->next[0], memory_order_relaxed)) {
+                table_insert(grown, node);
+        }
+        atomic_store_explicit(&store->table, grown, memory_order_release);
+        /* the entries of the replaced table are not shared with the grown table */
+        epoch_retire(&store->reclaim, table, table_drop);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  store
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool store_create(store *store, key_e key_type)
+{
+        if (UNLIKELY(key_type == KEY_NOKEY)) {
+                return ERROR(ERR_ILLEGALARG, "a store requires records with primary keys");
+        }
+        store->key_type = key_type;
+        store->head = node_create(&(store_key) { .str = NULL }, 0, NULL, STORE_MAX_HEIGHT);
+        atomic_init(&store->table, table_create(STORE_INITIAL_BUCKETS));
+        atomic_init(&store->len, 0);
+        store->seed = 0x9E3779B97F4A7C15ULL;
+        epoch_create(&store->reclaim);
+        return true;
+}
+
+bool store_drop(store *store)
+{
+        store_node *node = atomic_load_explicit(&store->head->next[0], memory_order_relaxed);
+        while (node) {
+                store_node *next = atomic_load_explicit(&node->next[0], memory_order_relaxed);
+                node_drop(node);
+                node = next;
+        }
+        node_drop(store->head);
+        table_drop(atomic_load_explicit(&store->table, memory_order_relaxed));
+        epoch_drop(&store->reclaim);
+        return true;
+}
+
+u64 store_len(store *store)
+{
+        return atomic_load_explicit(&store->len, memory_order_acquire);
+}
+
+bool store_put(store *store, rec *doc)
+{
+        store_key key;
+        if (!key_of_record(&key, store, doc)) {
+                return false;
+        }
+        store_node *preds[STORE_MAX_HEIGHT];
+        store_node *node = seek(store, &key, preds);
+        rec *record = MALLOC(sizeof(rec));
+        *record = *doc;
+
+        if (node && key_cmp(store, &node->key, &key) == 0) {
+                rec *replaced = atomic_exchange_explicit(&node->record, record, memory_order_acq_rel);
+                epoch_retire(&store->reclaim, replaced, rec_drop_and_free);
+                return true;
+        }
+
+        node = node_create(&key, key_hash(store, &key), record, node_height(store));
+        for (u32 level = 0; level < node->height; level++) {
+                store_node *next = atomic_load_explicit(&preds[level]->next[level], memory_order_relaxed);
+                atomic_store_explicit(&node->next[level], next, memory_order_relaxed);
+        }
+        /* bottom-up, such that a node that is reachable on a level is reachable on all levels below */
+        for (u32 level = 0; level < node->height; level++) {
+                atomic_store_explicit(&preds[level]->next[level], node, memory_order_release);
+        }
+        table_insert(atomic_load_explicit(&store->table, memory_order_relaxed), node);
+
+        /* the writer is the only one to modify the number of records, such that a load and a store suffice */
+        u64 len = atomic_load_explicit(&store->len, memory_order_relaxed) + 1;
+        atomic_store_explicit(&store->len, len, memory_order_release);
+        store_table *table = atomic_load_explicit(&store->table, memory_order_relaxed);
+        if (len > table->mask + 1) {
+                table_grow(store);
+        }
+        return true;
+}
+
+static bool store_remove(store *store, const store_key *key)
+{
+        store_node *preds[STORE_MAX_HEIGHT];
+        store_node *node = seek(store, key, preds);
+        if (!node || key_cmp(store, &node->key, key) != 0) {
+                return false;
+        }
+        /* top-down, such that a reader that reached the node on a lower level can still continue from it */
+        for (i32 level = node->height - 1; level >= 0; level--) {
+                store_node *next = atomic_load_explicit(&node->next[level], memory_order_relaxed);
+                atomic_store_explicit(&preds[level]->next[level], next, memory_order_release);
+        }
+        table_remove(store, node);
+        epoch_retire(&store->reclaim, node, node_drop);
+        atomic_store_explicit(&store->len, atomic_load_explicit(&store->len, memory_order_relaxed) - 1,
+                              memory_order_release);
+        return true;
+}
+
+bool store_remove_unsigned(store *store, u64 key)
+{
+        store_key value;
+        key_of_unsigned(&value, key);
+        return store_remove(store, &value);
+}
+
+bool store_remove_signed(store *store, i64 key)
+{
+        store_key value;
+        key_of_signed(&value, key);
+        return store_remove(store, &value);
+}
+
+bool store_remove_string(store *store, const char *key)
+{
+        store_key value;
+        key_of_string(&value, key);
+        return store_remove(store, &value);
+}
+
+u64 store_reclaim(store *store)
+{
+        return epoch_collect(&store->reclaim);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  readers
+// ---------------------------------------------------------------------------------------------------------------------
+
+static bool store_get(rec *view, store *store, const store_key *key)
+{
+        store_node *node = table_lookup(store, key);
+        if (node) {
+                view_of(view, node);
+                return true;
+        }
+        return false;
+}
+
+bool store_get_unsigned(rec *view, store *store, u64 key)
+{
+        store_key value;
+        key_of_unsigned(&value, key);
+        return store_get(view, store, &value);
+}
+
+bool store_get_signed(rec *view, store *store, i64 key)
+{
+        store_key value;
+        key_of_signed(&value, key);
+        return store_get(view, store, &value);
+}
+
+bool store_get_string(rec *view, store *store, const char *key)
+{
+        store_key value;
+        key_of_string(&value, key);
+        return store_get(view, store, &value);
+}
+
+static bool store_scan(store_it *it, store *store, const store_key *lower, const store_key *upper)
+{
+        it->source = store;
+        it->node = seek(store, lower, NULL);
+        it->has_upper = upper != NULL;
+        if (upper) {
+                it->upper = *upper;
+        }
+        return true;
+}
+
+bool store_scan_unsigned(store_it *it, store *store, u64 lower, u64 upper)
+{
+        store_key from, to;
+        key_of_unsigned(&from, lower);
+        key_of_unsigned(&to, upper);
+        return store_scan(it, store, &from, &to);
+}
+
+bool store_scan_signed(store_it *it, store *store, i64 lower, i64 upper)
+{
+        store_key from, to;
+        key_of_signed(&from, lower);
+        key_of_signed(&to, upper);
+        return store_scan(it, store, &from, &to);
+}
+
+bool store_scan_string(store_it *it, store *store, const char *lower, const char *upper)
+{
+        store_key from, to;
+        if (lower) {
+                key_of_string(&from, lower);
+        }
+        if (upper) {
+                key_of_string(&to, upper);
+        }
+        return store_scan(it, store, lower ? &from : NULL, upper ? &to : NULL);
+}
+
+bool store_it_next(rec *view, store_it *it)
+{
+        store_node *node = it->node;
+        if (!node || (it->has_upper && key_cmp(it->source, &node->key, &it->upper) > 0)) {
+                it->node = NULL;
+                return false;
+        }
+        /* a removed node keeps its successors, i.e., the scan continues behind it */
+        it->node = atomic_load_explicit(&node->next[0], memory_order_acquire);
+        view_of(view, node);
+        return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  revisions
+// ---------------------------------------------------------------------------------------------------------------------
+
+bool store_revise_begin(rev *context, rec *revised, rec *view)
+{
+        revise_begin_copy(context, revised, view);
+        return true;
+}
+
+bool store_revise_end(store *store, rev *context)
+{
+        store_key original, revised;
+        revise_end(context);
+        if (!key_of_record(&original, store, context->original) ||
+            !key_of_record(&revised, store, context->revised)) {
+                /* the revision is ended already, i.e., there is no one else to drop the revised record */
+                rec_drop(context->revised);
+                return false;
+        }
+        bool key_changed = key_cmp(store, &original, &revised) != 0;
+        if (key_changed) {
+                /* the original key points into the original record, which is retired rather than dropped on removal */
+                store_remove(store, &original);
+        }
+        return store_put(store, context->revised);
+}
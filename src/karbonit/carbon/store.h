@@ -0,0 +1,166 @@
+/*
+ * store - in-memory store of records by their primary key
+ *
+ * Copyright 2019 Marcus Pinnecke
+ */
+
+#ifndef HAD_STORE_H
+#define HAD_STORE_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/rec.h>
+#include <karbonit/carbon/revise.h>
+#include <karbonit/std/epoch.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* maximum number of levels of the ordered index */
+#define STORE_MAX_HEIGHT        16
+
+typedef struct store_node store_node;
+typedef struct store_table store_table;
+
+/* primary key of a record in a store */
+typedef struct store_key {
+        union {
+                u64 unsigned_key;
+                i64 signed_key;
+        } value;
+        /* string keys only, not null-terminated */
+        const char *str;
+        u64 len;
+} store_key;
+
+/**
+ * Records by their primary key (see <code>rec_create_begin</code>), all of the same key type, with a hash index for
+ * lookups of single keys and an ordered index (a skip list) for scans over key ranges.
+ *
+ * A store has a single writer, which modifies the store by <code>store_put</code>, <code>store_remove_*</code>,
+ * and <code>store_revise_end</code>. The writer must be serialized by the caller (e.g., by a spinlock). Any number
+ * of readers (<code>store_get_*</code>, <code>store_scan_*</code>) run concurrently to the writer and to each other
+ * without locks: the writer never modifies a record or an index entry that is reachable by readers, but publishes
+ * new records and entries by atomic pointer updates. A reader sees each record either before or after a concurrent
+ * update, but never a partially updated record.
+ *
+ * Readers access the store only inside read-side critical sections of the store's epoch, i.e., a reader thread
+ * registers once by <code>epoch_register(&store->reclaim)</code>, and brackets its lookups, scans, and the use of the
+ * views it got by <code>epoch_enter</code> and <code>epoch_leave</code>. Records and index entries that the writer
+ * replaces or removes are retired to the epoch, and are dropped once no reader is in a critical section anymore that
+ * may access them (see <code>epoch_retire</code>).
+ */
+typedef struct store {
+        key_e key_type;
+        /* ordered index, whose head has STORE_MAX_HEIGHT levels and no key */
+        store_node *head;
+        /* hash index, which is replaced as a whole when it grows */
+        _Atomic(store_table *) table;
+        /* number of records, which readers load concurrently to the writer */
+        _Atomic(u64) len;
+        /* state of the random number generator for the levels of nodes in the ordered index */
+        u64 seed;
+        /* reclamation of replaced and removed records, and of index entries */
+        epoch reclaim;
+} store;
+
+/* scan over a key range of a store, see store_scan_unsigned */
+typedef struct store_it {
+        store *source;
+        store_node *node;
+        bool has_upper;
+        store_key upper;
+} store_it;
+
+/**
+ * Creates an empty store for records with primary keys of type <code>key_type</code>, which is one of
+ * <code>KEY_AUTOKEY</code>, <code>KEY_UKEY</code>, <code>KEY_IKEY</code>, and <code>KEY_SKEY</code>.
+ */
+bool store_create(store *store, key_e key_type);
+
+/**
+ * Drops the store and all records in it, including the retired ones. No reader must be in a critical section.
+ */
+bool store_drop(store *store);
+
+/**
+ * Returns the number of records in the store.
+ */
+u64 store_len(store *store);
+
+/**
+ * Adds the record <code>doc</code> to the store, replacing the record with the same primary key if any. The store
+ * takes over <code>doc</code>, which must not be dropped (or modified) by the caller afterwards. The replaced record
+ * is retired (see <code>store</code>). Fails with <code>ERR_TYPEMISMATCH</code> if the key type of <code>doc</code>
+ * is not the one of the store.
+ */
+bool store_put(store *store, rec *doc);
+
+/**
+ * Removes the record with the primary key <code>key</code> from the store, and retires it. Returns
+ * <code>false</code> if there is no such record.
+ */
+bool store_remove_unsigned(store *store, u64 key);
+bool store_remove_signed(store *store, i64 key);
+bool store_remove_string(store *store, const char *key);
+
+/**
+ * Drops retired records and index entries that no reader accesses anymore (see <code>epoch_collect</code>), which
+ * otherwise happens as the writer retires further ones. Returns the number of objects that remain retired.
+ */
+u64 store_reclaim(store *store);
+
+/**
+ * Looks up the record with the primary key <code>key</code> and makes <code>view</code> a read-only view of it.
+ * Returns <code>false</code> if there is no such record. A view is valid until the reader leaves its critical section
+ * even if the record is replaced or removed meanwhile, and is not dropped by the caller. A view is private to a
+ * reader, i.e., reading through the view does not interfere with other readers.
+ */
+bool store_get_unsigned(rec *view, store *store, u64 key);
+bool store_get_signed(rec *view, store *store, i64 key);
+bool store_get_string(rec *view, store *store, const char *key);
+
+/**
+ * Starts a scan over the records with primary keys between <code>lower</code> and <code>upper</code> (both
+ * inclusive) in ascending key order, whose records are fetched by <code>store_it_next</code>. For string keys, a
+ * <code>NULL</code> bound is unbounded, and <code>upper</code> must stay valid during the scan. A scan that runs
+ * concurrently to the writer sees records that are added or removed during the scan or not, but sees each record that
+ * is in the store during the whole scan exactly once.
+ */
+bool store_scan_unsigned(store_it *it, store *store, u64 lower, u64 upper);
+bool store_scan_signed(store_it *it, store *store, i64 lower, i64 upper);
+bool store_scan_string(store_it *it, store *store, const char *lower, const char *upper);
+
+/**
+ * Makes <code>view</code> a read-only view (see <code>store_get_unsigned</code>) of the next record of the scan.
+ * Returns <code>false</code> if there is no more record.
+ */
+bool store_it_next(rec *view, store_it *it);
+
+/**
+ * Begins a revision of the record of which <code>view</code> is a view. The record is copied at once (see
+ * <code>revise_begin_copy</code>) such that records in the store do not hold shared memory objects. The revision is
+ * completed by <code>store_revise_end</code>, or aborted by <code>revise_abort</code>. The writer itself may use views
+ * outside of critical sections as long as it does not replace or remove their records.
+ */
+bool store_revise_begin(rev *context, rec *revised, rec *view);
+
+/**
+ * Ends the revision as <code>revise_end</code> does, and atomically replaces the original record in the store with
+ * the revised record (see <code>store_put</code>). If the revision changed the primary key, the record with the
+ * original key is removed. The store takes over the revised record in any case: if the key type of the revised record
+ * is not the one of the store, the call fails with <code>ERR_TYPEMISMATCH</code>, drops the revised record, and leaves
+ * the store unchanged.
+ */
+bool store_revise_end(store *store, rev *context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -115,9 +115,9 @@ create(update *updater, rev *context, const dot *path)
         return true;
 }
 
-static bool compile_path(dot *out, const char *in)
+static const dot *compile_path(const char *in)
 {
-        return dot_from_string(out, in);
+        return dot_cache_get(dot_thread_cache(), in);
 }
 
 static bool resolve_path(update *updater)
@@ -226,10 +226,9 @@ static inline col_it *column_iterator(u32 *elem_pos, update *updater)
 #define compile_path_and_delegate(context, path, func)                                                                 \
 ({                                                                                                                     \
         bool status;                                                                                                               \
-        dot compiled_path;                                                                           \
-        if (compile_path(&compiled_path, path)) {                                                                      \
-                status = func(context, &compiled_path);                                                                \
-                dot_drop(&compiled_path);                                                                   \
+        const dot *compiled_path = compile_path(path);                                                                 \
+        if (compiled_path) {                                                                                           \
+                status = func(context, compiled_path);                                                                 \
         } else {                                                                                                       \
                 return ERROR(ERR_DOT_PATH_PARSERR, "path string parsing failed");                             \
         }                                                                                                              \
@@ -238,11 +237,10 @@ static inline col_it *column_iterator(u32 *elem_pos, update *updater)
 
 #define compile_path_and_delegate_wargs(context, path, func, ...)                                                      \
 ({                                                                                                                     \
-        dot compiled_path;                                                                           \
+        const dot *compiled_path = compile_path(path);                                                                 \
         bool status;                                                                                                   \
-        if (compile_path(&compiled_path, path)) {                                                                      \
-                status = func(context, &compiled_path, __VA_ARGS__);                                                   \
-                dot_drop(&compiled_path);                                                                   \
+        if (compiled_path) {                                                                                           \
+                status = func(context, compiled_path, __VA_ARGS__);                                                    \
         } else {                                                                                                       \
                 return ERROR(ERR_DOT_PATH_PARSERR, "path string parsing failed");                             \
         }                                                                                                              \
@@ -853,4 +851,255 @@ bool update_one_set_column_end_compiled(col_state *state_in)
         bool status = update_set_column_end_compiled(state_in);
         // ... TODO: drop revision from context
         return status;
-}
\ No newline at end of file
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  batched updates
+// ---------------------------------------------------------------------------------------------------------------------
+
+#define UPDATE_BATCH_OP(batch, pos)     VEC_GET(&(batch)->ops, pos, update_batch_op)
+
+/* state of an update during the execution of a batch */
+#define UPDATE_BATCH_DONE               0
+#define UPDATE_BATCH_PENDING            1
+#define UPDATE_BATCH_SUPERSEDED         2
+
+bool update_batch_create(update_batch *batch)
+{
+        projection_create(&batch->paths);
+        vec_create(&batch->ops, sizeof(update_batch_op), 16);
+        return true;
+}
+
+bool update_batch_drop(update_batch *batch)
+{
+        for (u32 i = 0; i < VEC_LENGTH(&batch->ops); i++) {
+                free(UPDATE_BATCH_OP(batch, i)->path);
+        }
+        vec_drop(&batch->ops);
+        projection_drop(&batch->paths);
+        return true;
+}
+
+static update_batch_op *batch_add(update_batch *batch, const char *path, update_batch_op_e type)
+{
+        const dot *compiled_path = compile_path(path);
+        if (!compiled_path) {
+                ERROR(ERR_DOT_PATH_PARSERR, "path string parsing failed");
+                return NULL;
+        }
+        if (!projection_add(NULL, &batch->paths, compiled_path)) {
+                return NULL;
+        }
+        update_batch_op *op = VEC_NEW_AND_GET(&batch->ops, update_batch_op);
+        op->type = type;
+        op->path = strdup(path);
+        return op;
+}
+
+bool update_batch_set_null(update_batch *batch, const char *path)
+{
+        return batch_add(batch, path, UPDATE_BATCH_NULL) != NULL;
+}
+
+bool update_batch_set_true(update_batch *batch, const char *path)
+{
+        return batch_add(batch, path, UPDATE_BATCH_TRUE) != NULL;
+}
+
+bool update_batch_set_false(update_batch *batch, const char *path)
+{
+        return batch_add(batch, path, UPDATE_BATCH_FALSE) != NULL;
+}
+
+bool update_batch_set_unsigned(update_batch *batch, const char *path, u64 value)
+{
+        update_batch_op *op = batch_add(batch, path, UPDATE_BATCH_UNSIGNED);
+        if (op) {
+                op->value.unsigned_value = value;
+        }
+        return op != NULL;
+}
+
+bool update_batch_set_signed(update_batch *batch, const char *path, i64 value)
+{
+        update_batch_op *op = batch_add(batch, path, UPDATE_BATCH_SIGNED);
+        if (op) {
+                op->value.signed_value = value;
+        }
+        return op != NULL;
+}
+
+bool update_batch_set_float(update_batch *batch, const char *path, float value)
+{
+        update_batch_op *op = batch_add(batch, path, UPDATE_BATCH_FLOAT);
+        if (op) {
+                op->value.float_value = value;
+        }
+        return op != NULL;
+}
+
+u32 update_batch_len(const update_batch *batch)
+{
+        return VEC_LENGTH(&batch->ops);
+}
+
+/* writes the value of a number update into the array element without changing its type, if the type holds the
+ * value; returns false otherwise */
+static bool batch_array_number_in_place(arr_it *it, const update_batch_op *op)
+{
+        u64 u = op->value.unsigned_value;
+        i64 i = op->value.signed_value;
+
+        switch (op->type) {
+                case UPDATE_BATCH_UNSIGNED:
+                        switch (it->field.type) {
+                                case FIELD_NUMBER_U8:
+                                        return u <= CARBON_U8_MAX && internal_arr_it_update_u8(it, (u8) u);
+                                case FIELD_NUMBER_U16:
+                                        return u <= CARBON_U16_MAX && internal_arr_it_update_u16(it, (u16) u);
+                                case FIELD_NUMBER_U32:
+                                        return u <= CARBON_U32_MAX && internal_arr_it_update_u32(it, (u32) u);
+                                case FIELD_NUMBER_U64:
+                                        return u <= CARBON_U64_MAX && internal_arr_it_update_u64(it, u);
+                                default:
+                                        return false;
+                        }
+                case UPDATE_BATCH_SIGNED:
+                        switch (it->field.type) {
+                                case FIELD_NUMBER_I8:
+                                        return i >= CARBON_I8_MIN && i <= CARBON_I8_MAX &&
+                                               internal_arr_it_update_i8(it, (i8) i);
+                                case FIELD_NUMBER_I16:
+                                        return i >= CARBON_I16_MIN && i <= CARBON_I16_MAX &&
+                                               internal_arr_it_update_i16(it, (i16) i);
+                                case FIELD_NUMBER_I32:
+                                        return i >= CARBON_I32_MIN && i <= CARBON_I32_MAX &&
+                                               internal_arr_it_update_i32(it, (i32) i);
+                                case FIELD_NUMBER_I64:
+                                        return i >= CARBON_I64_MIN && internal_arr_it_update_i64(it, i);
+                                default:
+                                        return false;
+                        }
+                case UPDATE_BATCH_FLOAT:
+                        return it->field.type == FIELD_NUMBER_FLOAT &&
+                               internal_arr_it_update_float(it, op->value.float_value);
+                default:
+                        return false;
+        }
+}
+
+/* applies the update to the resolved field if this does not change the size of the field; returns false otherwise */
+static bool batch_update_in_place(find *result, const update_batch_op *op)
+{
+        switch (result->eval.result.container) {
+                case ARRAY: {
+                        arr_it *it = &result->eval.result.containers.array;
+                        switch (op->type) {
+                                case UPDATE_BATCH_NULL:
+                                        return FIELD_IS_CONSTANT(it->field.type) && internal_arr_it_update_null(it);
+                                case UPDATE_BATCH_TRUE:
+                                        return FIELD_IS_CONSTANT(it->field.type) && internal_arr_it_update_true(it);
+                                case UPDATE_BATCH_FALSE:
+                                        return FIELD_IS_CONSTANT(it->field.type) && internal_arr_it_update_false(it);
+                                default:
+                                        return batch_array_number_in_place(it, op);
+                        }
+                }
+                case COLUMN: {
+                        col_it *it = &result->eval.result.containers.column.it;
+                        u32 pos = result->eval.result.containers.column.elem_pos;
+                        if (col_it_is_sorted(it)) {
+                                /** updates of sorted columns move values back into order, and drop repeated values of
+                                 * sorted sets, i.e., they invalidate the positions of the other results */
+                                return false;
+                        }
+                        switch (op->type) {
+                                case UPDATE_BATCH_NULL:
+                                        return col_it_update_set_null(it, pos);
+                                case UPDATE_BATCH_TRUE:
+                                        return FIELD_IS_COLUMN_BOOL_OR_SUBTYPE(it->field_type) &&
+                                               col_it_update_set_true(it, pos);
+                                default:
+                                        /** setting false is left to the update by path as for single updates */
+                                        return false;
+                        }
+                }
+                default:
+                        return false;
+        }
+}
+
+static bool batch_update_by_path(rev *context, const update_batch_op *op)
+{
+        switch (op->type) {
+                case UPDATE_BATCH_NULL:
+                        return update_set_null(context, op->path);
+                case UPDATE_BATCH_TRUE:
+                        return update_set_true(context, op->path);
+                case UPDATE_BATCH_FALSE:
+                        return update_set_false(context, op->path);
+                case UPDATE_BATCH_UNSIGNED:
+                        return update_set_unsigned(context, op->path, op->value.unsigned_value);
+                case UPDATE_BATCH_SIGNED:
+                        return update_set_signed(context, op->path, op->value.signed_value);
+                case UPDATE_BATCH_FLOAT:
+                        return update_set_float(context, op->path, op->value.float_value);
+                default:
+                        return ERROR(ERR_INTERNALERR, "unknown batch update type");
+        }
+}
+
+bool update_batch_exec(rev *context, const update_batch *batch)
+{
+        u32 num_ops = update_batch_len(batch);
+        if (num_ops == 0) {
+                return true;
+        }
+
+        find *results = MALLOC(num_ops * sizeof(find));
+        u8 *state = MALLOC(num_ops * sizeof(u8));
+        bool status = true;
+
+        memset(state, UPDATE_BATCH_PENDING, num_ops * sizeof(u8));
+        for (u32 i = 0; i < num_ops; i++) {
+                /** paths that end in the same node are linked from the last added one to the first added one */
+                u32 earlier = *VEC_GET(&batch->paths.path_next, i, u32);
+                if (earlier != PROJECTION_NO_PATH) {
+                        state[earlier] = UPDATE_BATCH_SUPERSEDED;
+                }
+        }
+
+        projection_exec_mutable(results, &batch->paths, context);
+
+        /** in-place writes do not move any field, such that the results of the traversal remain valid up to the first
+         * update that cannot be written in place */
+        u32 i = 0;
+        for (; i < num_ops; i++) {
+                if (state[i] == UPDATE_BATCH_PENDING) {
+                        if (find_has_result(results + i) &&
+                            batch_update_in_place(results + i, UPDATE_BATCH_OP(batch, i))) {
+                                state[i] = UPDATE_BATCH_DONE;
+                        } else {
+                                break;
+                        }
+                }
+        }
+
+        /** this and all later updates may move fields, or see fields moved, and resolve their path on their own in the
+         * order they were added */
+        for (; i < num_ops; i++) {
+                if (state[i] == UPDATE_BATCH_PENDING) {
+                        status &= batch_update_by_path(context, UPDATE_BATCH_OP(batch, i));
+                }
+        }
+
+        free(state);
+        free(results);
+        return status;
+}
+
+bool update_one_batch(const update_batch *batch, rec *rev_doc, rec *doc)
+{
+        return revision_context_delegate_func(rev_doc, doc, update_batch_exec, batch);
+}
@@ -20,6 +20,7 @@
 #include <karbonit/carbon/dot.h>
 #include <karbonit/carbon/dot-eval.h>
 #include <karbonit/carbon/internal.h>
+#include <karbonit/carbon/projection.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -31,6 +32,38 @@ typedef struct update {
         const dot *path;
 } update;
 
+typedef enum update_batch_op_e {
+        UPDATE_BATCH_NULL,
+        UPDATE_BATCH_TRUE,
+        UPDATE_BATCH_FALSE,
+        UPDATE_BATCH_UNSIGNED,
+        UPDATE_BATCH_SIGNED,
+        UPDATE_BATCH_FLOAT
+} update_batch_op_e;
+
+typedef struct update_batch_op {
+        update_batch_op_e type;
+        /* path as given, owned by the batch */
+        char *path;
+        union {
+                u64 unsigned_value;
+                i64 signed_value;
+                float float_value;
+        } value;
+} update_batch_op;
+
+/**
+ * Set of (path, value) updates that are applied to a record together (see <code>update_batch_exec</code>). All
+ * paths of a batch are resolved in a single traversal of the record, whereas each <code>update_set_*</code> call
+ * resolves its path from the record root on its own. A batch is not modified by its execution, and may be applied
+ * to any number of records.
+ */
+typedef struct update_batch {
+        /* paths of the updates, in the order the updates were added */
+        projection paths;
+        vec ofType(update_batch_op) ops;
+} update_batch;
+
 bool update_set_null(rev *context, const char *path);
 bool update_set_true(rev *context, const char *path);
 bool update_set_false(rev *context, const char *path);
@@ -120,6 +153,45 @@ bool update_one_set_array_end_compiled(arr_state *state_in);
 insert *update_one_set_column_begin_compiled(col_state *state_out, const dot *path, rec *rev_doc, rec *doc, field_e type, u64 cap);
 bool update_one_set_column_end_compiled(col_state *state_in);
 
+bool update_batch_create(update_batch *batch);
+bool update_batch_drop(update_batch *batch);
+
+/**
+ * Adds an update of the field at <code>path</code> to the batch. Updates are applied in the order they are added;
+ * if a path is updated more than once, the last update wins. As for <code>update_set_unsigned</code> and
+ * <code>update_set_signed</code>, an integer is stored with the smallest type that holds it, unless it is written
+ * into an existing number field that holds it.
+ */
+bool update_batch_set_null(update_batch *batch, const char *path);
+bool update_batch_set_true(update_batch *batch, const char *path);
+bool update_batch_set_false(update_batch *batch, const char *path);
+bool update_batch_set_unsigned(update_batch *batch, const char *path, u64 value);
+bool update_batch_set_signed(update_batch *batch, const char *path, i64 value);
+bool update_batch_set_float(update_batch *batch, const char *path, float value);
+
+/**
+ * Returns the number of updates in the batch
+ */
+u32 update_batch_len(const update_batch *batch);
+
+/**
+ * Applies all updates of the batch to the revised record of <code>context</code> in the order they were added, with
+ * a result equal in value, but not necessarily in stored type, to the corresponding <code>update_set_*</code> calls.
+ * The paths are resolved in one traversal of the record. Updates that do not change the size of the field (e.g., a
+ * number is written into an existing number field that holds the number, or a constant replaces a constant) are
+ * written in place, up to the first update that cannot be written in place. A number written in place keeps the type
+ * of the existing field, whereas <code>update_set_unsigned</code> and <code>update_set_signed</code> store the
+ * smallest type that holds it. The update that cannot be written in place and all later updates are applied as the
+ * corresponding <code>update_set_*</code> function does. Returns true if all updates are applied.
+ */
+bool update_batch_exec(rev *context, const update_batch *batch);
+
+/**
+ * Applies the batch to <code>doc</code> in a new revision <code>rev_doc</code>, such that the commit hash is updated
+ * once for all updates of the batch.
+ */
+bool update_one_batch(const update_batch *batch, rec *rev_doc, rec *doc);
+
 #ifdef __cplusplus
 }
 #endif
@@ -4,6 +4,8 @@
  * Copyright 2019 Marcus Pinnecke
  */
 
+#include <errno.h>
+#include <unistd.h>
 #include <karbonit/json.h>
 #include <karbonit/karbonit.h>
 
@@ -62,35 +64,6 @@ const char *_json_from_column(str_buf *dst, col_it *src)
         return str_buf_cstr(dst);
 }
 
-static path_policy_e json_from_fn_record(const rec *record, const traverse_info *context, traverse_hidden *extra)
-{
-        str_buf *str = (str_buf *) extra->arg;
-        if (context->type == ON_ENTER) {
-                extra->json_printer.record_is_array = rec_is_array(record);
-        }
-        str_buf_add(str, extra->json_printer.record_is_array ?
-                              (context->type == ON_ENTER ? "[" : "]") :
-                              "");
-
-        return PATH_EXPAND;
-}
-
-static path_policy_e json_from_fn_array(const arr_it *array, const traverse_info *context, traverse_hidden *extra)
-{
-        UNUSED(array)
-        str_buf *str = (str_buf *) extra->arg;
-        str_buf_add_char(str, context->type == ON_ENTER ? '[' : ']');
-        return PATH_EXPAND;
-}
-
-static path_policy_e json_from_fn_object(const obj_it *object, const traverse_info *context, traverse_hidden *extra)
-{
-        UNUSED(object)
-        str_buf *str = (str_buf *) extra->arg;
-        str_buf_add_char(str, context->type == ON_ENTER ? '{' : '}');
-        return PATH_EXPAND;
-}
-
 static void json_print_field(str_buf *str, const item *field, const traverse_info *context)
 {
         if (context->type == ON_ENTER) {
@@ -123,51 +96,318 @@ static void json_print_field(str_buf *str, const item *field, const traverse_inf
         }
 }
 
-static path_policy_e json_from_fn_field(const item *item, const traverse_info *context, traverse_hidden *extra)
+// ---------------------------------------------------------------------------------------------------------------------
+//  direct serialization of containers
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* size of the buffer in which output is collected before it is written to a file descriptor */
+#define JSON_OUT_BUFFER_SIZE    (64 * 1024)
+
+/* output of the serializer, which is either appended to a string buffer, or written to a file descriptor */
+typedef struct json_out {
+        /* string buffer, or NULL for output to 'fd' */
+        str_buf *dst;
+        int fd;
+        char *buffer;
+        size_t len;
+        bool failed;
+} json_out;
+
+static const char JSON_OUT_DIGIT_PAIRS[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+static void out_write_fd(json_out *out, const char *data, size_t len)
 {
-        str_buf *str = (str_buf *) extra->arg;
-        str_buf_add(str, ITEM_GET_INDEX(item) > 0 && context->type == ON_ENTER ? ", " : "");
-        json_print_field(str, item, context);
-        return PATH_EXPAND;
+        while (len > 0 && !out->failed) {
+                ssize_t written = write(out->fd, data, len);
+                if (written < 0 && errno != EINTR) {
+                        out->failed = true;
+                } else if (written > 0) {
+                        data += written;
+                        len -= written;
+                }
+        }
 }
 
-static path_policy_e json_from_fn_prop(const prop *prop, const traverse_info *context, traverse_hidden *extra)
+static void out_flush(json_out *out)
 {
-        str_buf *str = (str_buf *) extra->arg;
-        if (context->type == ON_ENTER) {
-                str_buf_add(str, PROP_GET_INDEX(prop) > 0 && context->type == ON_ENTER ? ", " : "");
-                str_buf_add_nquote(str, prop->key.str, prop->key.len);
-                str_buf_add_char(str, ':');
+        if (!out->dst) {
+                out_write_fd(out, out->buffer, out->len);
+                out->len = 0;
+        }
+}
+
+static void out_put(json_out *out, const char *data, size_t len)
+{
+        if (out->dst) {
+                /** the string buffer keeps zeros behind its end, which terminate the string */
+                str_buf_ensure_capacity(out->dst, out->dst->end + len + 1);
+                memcpy(out->dst->data + out->dst->end, data, len);
+                out->dst->end += len;
+        } else {
+                if (out->len + len > JSON_OUT_BUFFER_SIZE) {
+                        out_flush(out);
+                }
+                if (len > JSON_OUT_BUFFER_SIZE) {
+                        out_write_fd(out, data, len);
+                } else {
+                        memcpy(out->buffer + out->len, data, len);
+                        out->len += len;
+                }
         }
-        json_print_field(str, &prop->value, context);
-        return PATH_EXPAND;
 }
 
-traverser_fn json_from_fn = {
-        .create = NULL,
-        .drop = NULL,
-        .visit_record = json_from_fn_record,
-        .visit_array = json_from_fn_array,
-        .visit_object = json_from_fn_object,
-        .visit_field = json_from_fn_field,
-        .visit_prop = json_from_fn_prop
-};
+#define OUT_LITERAL(out, literal)       out_put(out, literal, sizeof(literal) - 1)
+
+static void out_unsigned(json_out *out, u64 value)
+{
+        char digits[20];
+        char *begin = digits + sizeof(digits);
+        while (value >= 100) {
+                begin -= 2;
+                memcpy(begin, JSON_OUT_DIGIT_PAIRS + 2 * (value % 100), 2);
+                value /= 100;
+        }
+        if (value >= 10) {
+                begin -= 2;
+                memcpy(begin, JSON_OUT_DIGIT_PAIRS + 2 * value, 2);
+        } else {
+                *(--begin) = (char) ('0' + value);
+        }
+        out_put(out, begin, digits + sizeof(digits) - begin);
+}
+
+static void out_signed(json_out *out, i64 value)
+{
+        if (value < 0) {
+                OUT_LITERAL(out, "-");
+                out_unsigned(out, (u64) 0 - (u64) value);
+        } else {
+                out_unsigned(out, (u64) value);
+        }
+}
+
+/* formats as "%0.2f" (see str_buf_add_float) */
+static void out_float(json_out *out, float value)
+{
+        /** 100 times a float is exact in double precision, and nearbyint rounds half to even as printf does */
+        double scaled = fabs((double) value) * 100.0;
+        if (LIKELY(isfinite(value) && scaled < 1e18)) {
+                u64 hundredths = (u64) nearbyint(scaled);
+                char fraction[3] = { '.', (char) ('0' + hundredths % 100 / 10), (char) ('0' + hundredths % 10) };
+                if (signbit(value)) {
+                        OUT_LITERAL(out, "-");
+                }
+                out_unsigned(out, hundredths / 100);
+                out_put(out, fraction, sizeof(fraction));
+        } else {
+                char buffer[64];
+                int len = snprintf(buffer, sizeof(buffer), "%0.2f", value);
+                out_put(out, buffer, len);
+        }
+}
+
+static void out_string(json_out *out, const char *str, u64 len)
+{
+        OUT_LITERAL(out, "\"");
+        out_put(out, str, len);
+        OUT_LITERAL(out, "\"");
+}
+
+static void out_binary(json_out *out, const binary_field *binary)
+{
+        str_buf str;
+        str_buf_create(&str);
+        binary_field_print(&str, binary);
+        out_put(out, str.data, str.end);
+        str_buf_drop(&str);
+}
+
+#define OUT_COLUMN(out, it, type, is_null, write_value)                                                                \
+{                                                                                                                      \
+        u32 num_values;                                                                                                \
+        const type *values = internal_col_it_##type##_values(&num_values, it);                                         \
+        for (u32 i = 0; i < num_values; i++) {                                                                         \
+                if (i > 0) {                                                                                           \
+                        OUT_LITERAL(out, ", ");                                                                        \
+                }                                                                                                      \
+                if (is_null(values[i])) {                                                                              \
+                        OUT_LITERAL(out, "null");                                                                      \
+                } else {                                                                                               \
+                        write_value;                                                                                   \
+                }                                                                                                      \
+        }                                                                                                              \
+}
+
+#define OUT_BOOLEAN(out, value)         ((value) ? OUT_LITERAL(out, "true") : OUT_LITERAL(out, "false"))
+
+static void out_column(json_out *out, col_it *it)
+{
+        OUT_LITERAL(out, "[");
+        if (col_it_is_boolean(it)) {
+                OUT_COLUMN(out, it, boolean, IS_NULL_BOOLEAN, OUT_BOOLEAN(out, values[i]))
+        } else if (col_it_is_i8(it)) {
+                OUT_COLUMN(out, it, i8, IS_NULL_I8, out_signed(out, values[i]))
+        } else if (col_it_is_i16(it)) {
+                OUT_COLUMN(out, it, i16, IS_NULL_I16, out_signed(out, values[i]))
+        } else if (col_it_is_i32(it)) {
+                OUT_COLUMN(out, it, i32, IS_NULL_I32, out_signed(out, values[i]))
+        } else if (col_it_is_i64(it)) {
+                OUT_COLUMN(out, it, i64, IS_NULL_I64, out_signed(out, values[i]))
+        } else if (col_it_is_u8(it)) {
+                OUT_COLUMN(out, it, u8, IS_NULL_U8, out_unsigned(out, values[i]))
+        } else if (col_it_is_u16(it)) {
+                OUT_COLUMN(out, it, u16, IS_NULL_U16, out_unsigned(out, values[i]))
+        } else if (col_it_is_u32(it)) {
+                OUT_COLUMN(out, it, u32, IS_NULL_U32, out_unsigned(out, values[i]))
+        } else if (col_it_is_u64(it)) {
+                OUT_COLUMN(out, it, u64, IS_NULL_U64, out_unsigned(out, values[i]))
+        } else if (col_it_is_float(it)) {
+                OUT_COLUMN(out, it, float, IS_NULL_FLOAT, out_float(out, values[i]))
+        } else {
+                ERROR(ERR_UNSUPPORTEDTYPE, "column has unsupported type");
+        }
+        OUT_LITERAL(out, "]");
+}
+
+static void out_array(json_out *out, arr_it *it);
+static void out_object(json_out *out, obj_it *it);
+
+static void out_item(json_out *out, item *field)
+{
+        switch (ITEM_GET_TYPE(field)) {
+                case ITEM_NULL:
+                        OUT_LITERAL(out, "null");
+                        break;
+                case ITEM_TRUE:
+                        OUT_LITERAL(out, "true");
+                        break;
+                case ITEM_FALSE:
+                        OUT_LITERAL(out, "false");
+                        break;
+                case ITEM_STRING:
+                        out_string(out, field->value.string.str, field->value.string.len);
+                        break;
+                case ITEM_NUMBER_SIGNED:
+                        out_signed(out, field->value.number_signed);
+                        break;
+                case ITEM_NUMBER_UNSIGNED:
+                        out_unsigned(out, field->value.number_unsigned);
+                        break;
+                case ITEM_NUMBER_FLOAT:
+                        out_float(out, field->value.number_float);
+                        break;
+                case ITEM_BINARY:
+                        out_binary(out, &field->value.binary);
+                        break;
+                case ITEM_ARRAY: {
+                        arr_it it;
+                        ITEM_GET_ARRAY(&it, field);
+                        out_array(out, &it);
+                }
+                        break;
+                case ITEM_COLUMN: {
+                        col_it it;
+                        ITEM_GET_COLUMN(&it, field);
+                        out_column(out, &it);
+                }
+                        break;
+                case ITEM_OBJECT: {
+                        obj_it it;
+                        ITEM_GET_OBJECT(&it, field);
+                        out_object(out, &it);
+                }
+                        break;
+                default:
+                        break;
+        }
+}
+
+static void out_elements(json_out *out, arr_it *it)
+{
+        item *field;
+        for (bool first = true; (field = arr_it_next(it)); first = false) {
+                if (!first) {
+                        OUT_LITERAL(out, ", ");
+                }
+                out_item(out, field);
+        }
+}
+
+static void out_array(json_out *out, arr_it *it)
+{
+        OUT_LITERAL(out, "[");
+        out_elements(out, it);
+        OUT_LITERAL(out, "]");
+}
+
+static void out_object(json_out *out, obj_it *it)
+{
+        prop *p;
+        OUT_LITERAL(out, "{");
+        for (bool first = true; (p = obj_it_next(it)); first = false) {
+                if (!first) {
+                        OUT_LITERAL(out, ", ");
+                }
+                out_string(out, p->key.str, p->key.len);
+                OUT_LITERAL(out, ":");
+                out_item(out, &p->value);
+        }
+        OUT_LITERAL(out, "}");
+}
+
+static void out_record(json_out *out, rec *src)
+{
+        /** a record that is a unit array is written as its only element */
+        arr_it it;
+        rec_read(&it, src);
+        bool is_array = !arr_it_is_unit(&it);
+        if (is_array) {
+                OUT_LITERAL(out, "[");
+        }
+        out_elements(out, &it);
+        if (is_array) {
+                OUT_LITERAL(out, "]");
+        }
+}
 
 const char *json_from_record(str_buf *dst, rec *src)
 {
-        TRAVERSE(dst, &json_from_fn, VISIT_ALL, traverser_run_from_record, src);
+        /** JSON takes about as many bytes as the record, which saves most of the string buffer resizes */
+        u64 len = 0;
+        rec_raw_data(&len, src);
+        str_buf_clear(dst);
+        str_buf_ensure_capacity(dst, len + len / 2 + 1);
+
+        json_out out = { .dst = dst };
+        out_record(&out, src);
         return str_buf_cstr(dst);
 }
 
+bool json_write_record(int fd, rec *src)
+{
+        json_out out = { .dst = NULL, .fd = fd, .buffer = MALLOC(JSON_OUT_BUFFER_SIZE), .len = 0, .failed = false };
+        out_record(&out, src);
+        out_flush(&out);
+        free(out.buffer);
+        return out.failed ? ERROR(ERR_IO, "unable to write JSON") : true;
+}
+
 const char *json_from_array(str_buf *dst, arr_it *src)
 {
-        TRAVERSE(dst, &json_from_fn, VISIT_ALL, traverser_run_from_array, src);
+        json_out out = { .dst = dst };
+        str_buf_clear(dst);
+        out_array(&out, src);
         return str_buf_cstr(dst);
 }
 
 const char *json_from_object(str_buf *dst, obj_it *src)
 {
-        TRAVERSE(dst, &json_from_fn, VISIT_ALL, traverser_run_from_object, src);
+        json_out out = { .dst = dst };
+        str_buf_clear(dst);
+        out_object(&out, src);
         return str_buf_cstr(dst);
 }
 
@@ -21,6 +21,12 @@ const char *json_from_column(str_buf *dst, col_it *src);
 const char *json_from_object(str_buf *dst, obj_it *src);
 const char *json_from_item(str_buf *dst, item *src);
 
+/**
+ * Writes the record <code>src</code> as JSON to the file descriptor <code>fd</code>, in the same format as
+ * <code>json_from_record</code>, but in chunks of a fixed-size buffer instead of as a whole string
+ */
+bool json_write_record(int fd, rec *src);
+
 const char *json_from_binary(str_buf *dst, const binary_field *binary);
 const char *json_from_string(str_buf *dst, const string_field *str);
 const char *json_from_boolean(str_buf *dst, bool value);
@@ -56,9 +56,135 @@ bool json_tokenizer_init(json_tokenizer *tokenizer, const char *input)
         tokenizer->cursor = input;
         tokenizer->token =
                 (json_token) {.type = JSON_UNKNOWN, .length = 0, .column = 0, .line = 1, .string = NULL};
+        tokenizer->begin = input;
+        tokenizer->end = input + strlen(input);
+        tokenizer->block = NULL;
         return true;
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+//  tokenizer stage 1: block index
+// ---------------------------------------------------------------------------------------------------------------------
+
+static void index_block_scalar(u64 *string_ends, u64 *non_blanks, const char *block)
+{
+        u64 ends = 0, blanks = 0;
+        for (unsigned i = 0; i < JSON_TOKENIZER_BLOCK_SIZE; i++) {
+                char c = block[i];
+                ends |= (u64) (c == '"' || c == '\n' || c == '\r' || c == '\0') << i;
+                blanks |= (u64) (c == ' ' || c == '\t' || c == '\v' || c == '\f' || c == '\r') << i;
+        }
+        *string_ends = ends;
+        *non_blanks = ~blanks;
+}
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+
+__attribute__((target("avx2"))) static void index_block_avx2(u64 *string_ends, u64 *non_blanks, const char *block)
+{
+        u64 ends = 0, blanks = 0;
+        for (unsigned half = 0; half < 2; half++) {
+                __m256i v = _mm256_loadu_si256((const __m256i *) (block + half * 32));
+                __m256i e = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')),
+                                                            _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'))),
+                                            _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r')),
+                                                            _mm256_cmpeq_epi8(v, _mm256_setzero_si256())));
+                /* '\t', '\v', '\f', and '\r' are the characters 9 to 13, except '\n' */
+                __m256i control = _mm256_cmpeq_epi8(_mm256_min_epu8(_mm256_sub_epi8(v, _mm256_set1_epi8('\t')),
+                                                                    _mm256_set1_epi8('\r' - '\t')),
+                                                    _mm256_sub_epi8(v, _mm256_set1_epi8('\t')));
+                __m256i b = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')),
+                                            _mm256_andnot_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')),
+                                                                control));
+                ends |= (u64) (u32) _mm256_movemask_epi8(e) << (half * 32);
+                blanks |= (u64) (u32) _mm256_movemask_epi8(b) << (half * 32);
+        }
+        *string_ends = ends;
+        *non_blanks = ~blanks;
+}
+
+#define INDEX_BLOCK(string_ends, non_blanks, block)                                                                    \
+        (__builtin_cpu_supports("avx2") ? index_block_avx2(string_ends, non_blanks, block) :                          \
+                                          index_block_scalar(string_ends, non_blanks, block))
+#else
+#define INDEX_BLOCK(string_ends, non_blanks, block)     index_block_scalar(string_ends, non_blanks, block)
+#endif
+
+/* indexes the input block that contains pos, unless it is indexed already */
+static void tokenizer_index(json_tokenizer *tokenizer, const char *pos)
+{
+        const char *block = tokenizer->begin + (pos - tokenizer->begin) / JSON_TOKENIZER_BLOCK_SIZE *
+                                               JSON_TOKENIZER_BLOCK_SIZE;
+        if (block != tokenizer->block) {
+                tokenizer->block = block;
+                if (block + JSON_TOKENIZER_BLOCK_SIZE <= tokenizer->end) {
+                        INDEX_BLOCK(&tokenizer->string_ends, &tokenizer->non_blanks, block);
+                } else {
+                        /** the last block is padded with nul characters to not read beyond the input */
+                        char padded[JSON_TOKENIZER_BLOCK_SIZE] = { 0 };
+                        memcpy(padded, block, tokenizer->end - block);
+                        INDEX_BLOCK(&tokenizer->string_ends, &tokenizer->non_blanks, padded);
+                }
+        }
+}
+
+/* returns the first character at or after pos that may end a string (resp. a run of blanks); the terminating nul
+ * character at the latest */
+static const char *tokenizer_find(json_tokenizer *tokenizer, const char *pos, bool string_end)
+{
+        while (true) {
+                tokenizer_index(tokenizer, pos);
+                unsigned offset = pos - tokenizer->block;
+                u64 mask = (string_end ? tokenizer->string_ends : tokenizer->non_blanks) >> offset;
+                if (mask) {
+                        return pos + __builtin_ctzll(mask);
+                }
+                pos = tokenizer->block + JSON_TOKENIZER_BLOCK_SIZE;
+        }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  tokenizer stage 2: tokens
+// ---------------------------------------------------------------------------------------------------------------------
+
+/* returns true if the first n characters of str are not the terminating nul character */
+static bool has_min_length(const char *str, unsigned n)
+{
+        for (unsigned i = 0; i < n; i++) {
+                if (str[i] == '\0') {
+                        return false;
+                }
+        }
+        return true;
+}
+
+static void parse_quoted_string_token(json_tokenizer *tokenizer)
+{
+        const char *content = tokenizer->cursor + 1, *end = content;
+        tokenizer->token.string = content;
+        tokenizer->token.column++;
+
+        while (*(end = tokenizer_find(tokenizer, end, true)) == '"') {
+                /** a quote is escaped by an odd number of backslashes */
+                const char *backslash = end;
+                while (backslash > content && *(backslash - 1) == '\\') {
+                        backslash--;
+                }
+                if ((end - backslash) % 2 == 0) {
+                        break;
+                }
+                end++;
+        }
+
+        /** strings end at their closing quote, or at the end of their line; a string that runs into the end of the
+         * input is not terminated, and yields a token the parser rejects */
+        char c = *end;
+        tokenizer->token.type = c != '\0' ? LITERAL_STRING : JSON_UNKNOWN;
+        tokenizer->token.length = end - content;
+        tokenizer->cursor = end + (c != '\0' ? 1 : 0) + ((c == '\r' || c == '\n') ? 1 : 0);
+}
+
 static void
 parse_string_token(json_tokenizer *tokenizer, char c, char delimiter, char delimiter2, char delimiter3,
                    bool include_start, bool include_end)
@@ -110,10 +236,9 @@ const json_token *json_tokenizer_next(json_tokenizer *tokenizer)
                         tokenizer->cursor++;
                         return json_tokenizer_next(tokenizer);
                 } else if (isspace(c)) {
-                        do {
-                                tokenizer->cursor++;
-                                tokenizer->token.column++;
-                        } while (isspace(c = *tokenizer->cursor) && c != '\n');
+                        const char *next = tokenizer_find(tokenizer, tokenizer->cursor + 1, false);
+                        tokenizer->token.column += next - tokenizer->cursor;
+                        tokenizer->cursor = next;
                         return json_tokenizer_next(tokenizer);
                 } else if (c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',') {
                         tokenizer->token.type =
@@ -126,23 +251,22 @@ const json_token *json_tokenizer_next(json_tokenizer *tokenizer)
                         tokenizer->token.length = 1;
                         tokenizer->cursor++;
                 } else if (c != '"' && (isalpha(c) || c == '_') &&
-                           (strlen(tokenizer->cursor) >= 4 && (strncmp(tokenizer->cursor, "null", 4) != 0 &&
-                                                               strncmp(tokenizer->cursor, "true", 4) != 0)) &&
-                           (strlen(tokenizer->cursor) >= 5 && strncmp(tokenizer->cursor, "false", 5) != 0)) {
+                           (has_min_length(tokenizer->cursor, 4) && (strncmp(tokenizer->cursor, "null", 4) != 0 &&
+                                                                    strncmp(tokenizer->cursor, "true", 4) != 0)) &&
+                           (has_min_length(tokenizer->cursor, 5) && strncmp(tokenizer->cursor, "false", 5) != 0)) {
                         parse_string_token(tokenizer, c, ' ', ':', ',', true, true);
                 } else if (c == '"') {
-                        parse_string_token(tokenizer, c, '"', '"', '"', false, false);
+                        parse_quoted_string_token(tokenizer);
                 } else if (c == 't' || c == 'f' || c == 'n') {
                         const unsigned lenTrueNull = 4;
                         const unsigned lenFalse = 5;
-                        const unsigned cursorLen = strlen(tokenizer->cursor);
-                        if (cursorLen >= lenTrueNull && strncmp(tokenizer->cursor, "true", lenTrueNull) == 0) {
+                        if (strncmp(tokenizer->cursor, "true", lenTrueNull) == 0) {
                                 tokenizer->token.type = LITERAL_TRUE;
                                 tokenizer->token.length = lenTrueNull;
-                        } else if (cursorLen >= lenFalse && strncmp(tokenizer->cursor, "false", lenFalse) == 0) {
+                        } else if (strncmp(tokenizer->cursor, "false", lenFalse) == 0) {
                                 tokenizer->token.type = LITERAL_FALSE;
                                 tokenizer->token.length = lenFalse;
-                        } else if (cursorLen >= lenTrueNull && strncmp(tokenizer->cursor, "null", lenTrueNull) == 0) {
+                        } else if (strncmp(tokenizer->cursor, "null", lenTrueNull) == 0) {
                                 tokenizer->token.type = LITERAL_NULL;
                                 tokenizer->token.length = lenTrueNull;
                         } else {
@@ -207,21 +331,25 @@ void json_token_print(FILE *file, const json_token *token)
         free(string);
 }
 
-static bool parse_object(json_object *object, vec ofType(json_token) *token_stream, size_t *token_idx);
+static bool parse_object(json_object *object, vec ofType(json_token) *token_stream, size_t *token_idx,
+                         allocator *alloc);
 
-static bool parse_array(json_array *array, vec ofType(json_token) *token_stream, size_t *token_idx);
+static bool parse_array(json_array *array, vec ofType(json_token) *token_stream, size_t *token_idx,
+                         allocator *alloc);
 
 static void parse_string(json_string *string, vec ofType(json_token) *token_stream,
-                         size_t *token_idx);
+                         size_t *token_idx, allocator *alloc);
 
 static void parse_number(json_number *number, vec ofType(json_token) *token_stream,
                          size_t *token_idx);
 
-static bool parse_element(json_element *element, vec ofType(json_token) *token_stream, size_t *token_idx);
+static bool parse_element(json_element *element, vec ofType(json_token) *token_stream, size_t *token_idx,
+                         allocator *alloc);
 
-static bool parse_elements(json_elements *elements, vec ofType(json_token) *token_stream, size_t *token_idx);
+static bool parse_elements(json_elements *elements, vec ofType(json_token) *token_stream, size_t *token_idx,
+                         allocator *alloc);
 
-static bool parse_token_stream(json *json, vec ofType(json_token) *token_stream);
+static bool parse_token_stream(json *json, vec ofType(json_token) *token_stream, allocator *alloc);
 
 static json_token get_token(vec ofType(json_token) *token_stream, size_t token_idx);
 
@@ -256,6 +384,12 @@ static bool json_ast_node_element_print(FILE *file, json_element *element);
 
 bool
 json_parse(json *json, json_err *error_desc, json_parser *parser, const char *input)
+{
+        return json_parse_with(json, error_desc, parser, input, NULL);
+}
+
+bool
+json_parse_with(json *json, json_err *error_desc, json_parser *parser, const char *input, allocator *alloc)
 {
         str_buf str;
         str_buf_create(&str);
@@ -274,7 +408,8 @@ json_parse(json *json, json_err *error_desc, json_parser *parser, const char *in
 
         struct json retval;
         ZERO_MEMORY(&retval, sizeof(json))
-        retval.element = MALLOC(sizeof(json_element));
+        retval.alloc = alloc;
+        retval.element = alloc_malloc(alloc, sizeof(json_element));
         const json_token *token;
         int status;
 
@@ -304,7 +439,7 @@ json_parse(json *json, json_err *error_desc, json_parser *parser, const char *in
                 goto cleanup;
         }
 
-        if (!parse_token_stream(&retval, &token_stream)) {
+        if (!parse_token_stream(&retval, &token_stream, alloc)) {
                 status = false;
                 goto cleanup;
         }
@@ -409,18 +544,19 @@ static bool has_next_token(size_t token_idx, vec ofType(json_token) *token_strea
         return token_idx < token_stream->num_elems;
 }
 
-bool parse_members(json_members *members,
-                   vec ofType(json_token) *token_stream,
-                   size_t *token_idx)
+static bool parse_members(json_members *members,
+                          vec ofType(json_token) *token_stream,
+                          size_t *token_idx,
+                          allocator *alloc)
 {
-        vec_create(&members->members, sizeof(json_prop), 20);
+        vec_create_with(&members->members, sizeof(json_prop), 20, alloc);
         json_token delimiter_token;
 
         do {
                 json_prop *member = VEC_NEW_AND_GET(&members->members, json_prop);
                 json_token keyNameToken = get_token(token_stream, *token_idx);
 
-                member->key.value = MALLOC(keyNameToken.length + 1);
+                member->key.value = alloc_malloc(alloc, keyNameToken.length + 1);
                 strncpy(member->key.value, keyNameToken.string, keyNameToken.length);
                 member->key.value[keyNameToken.length] = '\0';
 
@@ -445,27 +581,27 @@ bool parse_members(json_members *members,
                 switch (valueToken.type) {
                         case OBJECT_OPEN:
                                 member->value.value.value_type = JSON_VALUE_OBJECT;
-                                member->value.value.value.object = MALLOC(sizeof(json_object));
-                                if (!parse_object(member->value.value.value.object, token_stream, token_idx)) {
+                                member->value.value.value.object = alloc_malloc(alloc, sizeof(json_object));
+                                if (!parse_object(member->value.value.value.object, token_stream, token_idx, alloc)) {
                                         return false;
                                 }
                                 break;
                         case ARRAY_OPEN:
                                 member->value.value.value_type = JSON_VALUE_ARRAY;
-                                member->value.value.value.array = MALLOC(sizeof(json_array));
-                                if (!parse_array(member->value.value.value.array, token_stream, token_idx)) {
+                                member->value.value.value.array = alloc_malloc(alloc, sizeof(json_array));
+                                if (!parse_array(member->value.value.value.array, token_stream, token_idx, alloc)) {
                                         return false;
                                 }
                                 break;
                         case LITERAL_STRING:
                                 member->value.value.value_type = JSON_VALUE_STRING;
-                                member->value.value.value.string = MALLOC(sizeof(json_string));
-                                parse_string(member->value.value.value.string, token_stream, token_idx);
+                                member->value.value.value.string = alloc_malloc(alloc, sizeof(json_string));
+                                parse_string(member->value.value.value.string, token_stream, token_idx, alloc);
                                 break;
                         case LITERAL_INT:
                         case LITERAL_FLOAT:
                                 member->value.value.value_type = JSON_VALUE_NUMBER;
-                                member->value.value.value.number = MALLOC(sizeof(json_number));
+                                member->value.value.value.number = alloc_malloc(alloc, sizeof(json_number));
                                 parse_number(member->value.value.value.number, token_stream, token_idx);
                                 break;
                         case LITERAL_TRUE:
@@ -491,36 +627,38 @@ bool parse_members(json_members *members,
         return true;
 }
 
-static bool parse_object(json_object *object, vec ofType(json_token) *token_stream, size_t *token_idx)
+static bool parse_object(json_object *object, vec ofType(json_token) *token_stream, size_t *token_idx,
+                         allocator *alloc)
 {
         assert(get_token(token_stream, *token_idx).type == OBJECT_OPEN);
         NEXT_TOKEN(token_idx);  /** Skip '{' */
-        object->value = MALLOC(sizeof(json_members));
+        object->value = alloc_malloc(alloc, sizeof(json_members));
 
         /** test whether this is an empty object */
         json_token token = get_token(token_stream, *token_idx);
 
         if (token.type != OBJECT_CLOSE) {
-                if (!parse_members(object->value, token_stream, token_idx)) {
+                if (!parse_members(object->value, token_stream, token_idx, alloc)) {
                         return false;
                 }
         } else {
-                vec_create(&object->value->members, sizeof(json_prop), 20);
+                vec_create_with(&object->value->members, sizeof(json_prop), 20, alloc);
         }
 
         NEXT_TOKEN(token_idx);  /** Skip '}' */
         return true;
 }
 
-static bool parse_array(json_array *array, vec ofType(json_token) *token_stream, size_t *token_idx)
+static bool parse_array(json_array *array, vec ofType(json_token) *token_stream, size_t *token_idx,
+                         allocator *alloc)
 {
         json_token token = get_token(token_stream, *token_idx);
         UNUSED(token);
         assert(token.type == ARRAY_OPEN);
         NEXT_TOKEN(token_idx); /** Skip '[' */
 
-        vec_create(&array->elements.elements, sizeof(json_element), 250);
-        if (!parse_elements(&array->elements, token_stream, token_idx)) {
+        vec_create_with(&array->elements.elements, sizeof(json_element), 250, alloc);
+        if (!parse_elements(&array->elements, token_stream, token_idx, alloc)) {
                 return false;
         }
 
@@ -529,12 +667,12 @@ static bool parse_array(json_array *array, vec ofType(json_token) *token_stream,
 }
 
 static void parse_string(json_string *string, vec ofType(json_token) *token_stream,
-                         size_t *token_idx)
+                         size_t *token_idx, allocator *alloc)
 {
         json_token token = get_token(token_stream, *token_idx);
         assert(token.type == LITERAL_STRING);
 
-        string->value = MALLOC(token.length + 1);
+        string->value = alloc_malloc(alloc, token.length + 1);
         if (LIKELY(token.length > 0)) {
                 strncpy(string->value, token.string, token.length);
         }
@@ -546,13 +684,19 @@ static void parse_number(json_number *number, vec ofType(json_token) *token_stre
                          size_t *token_idx)
 {
         json_token token = get_token(token_stream, *token_idx);
-        assert(token.type == LITERAL_FLOAT || token.type == LITERAL_INT);
+        json_number_from_token(number, &token);
+        NEXT_TOKEN(token_idx);
+}
 
-        char *value = MALLOC(token.length + 1);
-        strncpy(value, token.string, token.length);
-        value[token.length] = '\0';
+void json_number_from_token(json_number *number, const json_token *token)
+{
+        assert(token->type == LITERAL_FLOAT || token->type == LITERAL_INT);
+
+        char *value = MALLOC(token->length + 1);
+        strncpy(value, token->string, token->length);
+        value[token->length] = '\0';
 
-        if (token.type == LITERAL_INT) {
+        if (token->type == LITERAL_INT) {
                 i64 assumeSigned = convert_atoi64(value);
                 if (value[0] == '-') {
                         number->value_type = JSON_NUMBER_SIGNED;
@@ -574,10 +718,10 @@ static void parse_number(json_number *number, vec ofType(json_token) *token_stre
         }
 
         free(value);
-        NEXT_TOKEN(token_idx);
 }
 
-static bool parse_element(json_element *element, vec ofType(json_token) *token_stream, size_t *token_idx)
+static bool parse_element(json_element *element, vec ofType(json_token) *token_stream, size_t *token_idx,
+                         allocator *alloc)
 {
         if (!has_next_token(*token_idx, token_stream)) {
                 return false;
@@ -586,23 +730,23 @@ static bool parse_element(json_element *element, vec ofType(json_token) *token_s
 
         if (token.type == OBJECT_OPEN) { /** Parse object */
                 element->value.value_type = JSON_VALUE_OBJECT;
-                element->value.value.object = MALLOC(sizeof(json_object));
-                if (!parse_object(element->value.value.object, token_stream, token_idx)) {
+                element->value.value.object = alloc_malloc(alloc, sizeof(json_object));
+                if (!parse_object(element->value.value.object, token_stream, token_idx, alloc)) {
                         return false;
                 }
         } else if (token.type == ARRAY_OPEN) { /** Parse array */
                 element->value.value_type = JSON_VALUE_ARRAY;
-                element->value.value.array = MALLOC(sizeof(json_array));
-                if (!parse_array(element->value.value.array, token_stream, token_idx)) {
+                element->value.value.array = alloc_malloc(alloc, sizeof(json_array));
+                if (!parse_array(element->value.value.array, token_stream, token_idx, alloc)) {
                         return false;
                 }
         } else if (token.type == LITERAL_STRING) { /** Parse string */
                 element->value.value_type = JSON_VALUE_STRING;
-                element->value.value.string = MALLOC(sizeof(json_string));
-                parse_string(element->value.value.string, token_stream, token_idx);
+                element->value.value.string = alloc_malloc(alloc, sizeof(json_string));
+                parse_string(element->value.value.string, token_stream, token_idx, alloc);
         } else if (token.type == LITERAL_FLOAT || token.type == LITERAL_INT) { /** Parse number */
                 element->value.value_type = JSON_VALUE_NUMBER;
-                element->value.value.number = MALLOC(sizeof(json_number));
+                element->value.value.number = alloc_malloc(alloc, sizeof(json_number));
                 parse_number(element->value.value.number, token_stream, token_idx);
         } else if (token.type == LITERAL_TRUE) {
                 element->value.value_type = JSON_VALUE_TRUE;
@@ -619,7 +763,8 @@ static bool parse_element(json_element *element, vec ofType(json_token) *token_s
         return true;
 }
 
-static bool parse_elements(json_elements *elements, vec ofType(json_token) *token_stream, size_t *token_idx)
+static bool parse_elements(json_elements *elements, vec ofType(json_token) *token_stream, size_t *token_idx,
+                         allocator *alloc)
 {
         json_token delimiter;
         do {
@@ -627,7 +772,7 @@ static bool parse_elements(json_elements *elements, vec ofType(json_token) *toke
                 if (current.type != ARRAY_CLOSE && current.type != OBJECT_CLOSE) {
                         if (!parse_element(VEC_NEW_AND_GET(&elements->elements, json_element),
                                            token_stream,
-                                           token_idx)) {
+                                           token_idx, alloc)) {
                                 return false;
                         }
                 }
@@ -638,10 +783,10 @@ static bool parse_elements(json_elements *elements, vec ofType(json_token) *toke
         return true;
 }
 
-static bool parse_token_stream(json *json, vec ofType(json_token) *token_stream)
+static bool parse_token_stream(json *json, vec ofType(json_token) *token_stream, allocator *alloc)
 {
         size_t token_idx = 0;
-        if (!parse_element(json->element, token_stream, &token_idx)) {
+        if (!parse_element(json->element, token_stream, &token_idx, alloc)) {
                 return false;
         }
         connect_child_and_parents(json);
@@ -957,24 +1102,24 @@ static bool json_ast_node_element_print(FILE *file, json_element *element)
         return json_ast_node_value_print(file, &element->value);
 }
 
-static bool json_ast_node_value_drop(json_node_value *value);
+static bool json_ast_node_value_drop(json_node_value *value, allocator *alloc);
 
-static bool json_ast_node_element_drop(json_element *element)
+static bool json_ast_node_element_drop(json_element *element, allocator *alloc)
 {
-        return json_ast_node_value_drop(&element->value);
+        return json_ast_node_value_drop(&element->value, alloc);
 }
 
-static bool json_ast_node_member_drop(json_prop *member)
+static bool json_ast_node_member_drop(json_prop *member, allocator *alloc)
 {
-        free(member->key.value);
-        return json_ast_node_element_drop(&member->value);
+        alloc_free(alloc, member->key.value);
+        return json_ast_node_element_drop(&member->value, alloc);
 }
 
-static bool json_ast_node_members_drop(json_members *members)
+static bool json_ast_node_members_drop(json_members *members, allocator *alloc)
 {
         for (size_t i = 0; i < members->members.num_elems; i++) {
                 json_prop *member = VEC_GET(&members->members, i, json_prop);
-                if (!json_ast_node_member_drop(member)) {
+                if (!json_ast_node_member_drop(member, alloc)) {
                         return false;
                 }
         }
@@ -982,11 +1127,11 @@ static bool json_ast_node_members_drop(json_members *members)
         return true;
 }
 
-static bool json_ast_node_elements_drop(json_elements *elements)
+static bool json_ast_node_elements_drop(json_elements *elements, allocator *alloc)
 {
         for (size_t i = 0; i < elements->elements.num_elems; i++) {
                 json_element *element = VEC_GET(&elements->elements, i, json_element);
-                if (!json_ast_node_element_drop(element)) {
+                if (!json_ast_node_element_drop(element, alloc)) {
                         return false;
                 }
         }
@@ -994,24 +1139,24 @@ static bool json_ast_node_elements_drop(json_elements *elements)
         return true;
 }
 
-static bool json_ast_node_object_drop(json_object *object)
+static bool json_ast_node_object_drop(json_object *object, allocator *alloc)
 {
-        if (!json_ast_node_members_drop(object->value)) {
+        if (!json_ast_node_members_drop(object->value, alloc)) {
                 return false;
         } else {
-                free(object->value);
+                alloc_free(alloc, object->value);
                 return true;
         }
 }
 
-static bool json_ast_node_array_drop(json_array *array)
+static bool json_ast_node_array_drop(json_array *array, allocator *alloc)
 {
-        return json_ast_node_elements_drop(&array->elements);
+        return json_ast_node_elements_drop(&array->elements, alloc);
 }
 
-static void json_ast_node_string_drop(json_string *string)
+static void json_ast_node_string_drop(json_string *string, allocator *alloc)
 {
-        free(string->value);
+        alloc_free(alloc, string->value);
 }
 
 static void json_ast_node_number_drop(json_number *number)
@@ -1019,30 +1164,30 @@ static void json_ast_node_number_drop(json_number *number)
         UNUSED(number);
 }
 
-static bool json_ast_node_value_drop(json_node_value *value)
+static bool json_ast_node_value_drop(json_node_value *value, allocator *alloc)
 {
         switch (value->value_type) {
                 case JSON_VALUE_OBJECT:
-                        if (!json_ast_node_object_drop(value->value.object)) {
+                        if (!json_ast_node_object_drop(value->value.object, alloc)) {
                                 return false;
                         } else {
-                                free(value->value.object);
+                                alloc_free(alloc, value->value.object);
                         }
                         break;
                 case JSON_VALUE_ARRAY:
-                        if (!json_ast_node_array_drop(value->value.array)) {
+                        if (!json_ast_node_array_drop(value->value.array, alloc)) {
                                 return false;
                         } else {
-                                free(value->value.array);
+                                alloc_free(alloc, value->value.array);
                         }
                         break;
                 case JSON_VALUE_STRING:
-                        json_ast_node_string_drop(value->value.string);
-                        free(value->value.string);
+                        json_ast_node_string_drop(value->value.string, alloc);
+                        alloc_free(alloc, value->value.string);
                         break;
                 case JSON_VALUE_NUMBER:
                         json_ast_node_number_drop(value->value.number);
-                        free(value->value.number);
+                        alloc_free(alloc, value->value.number);
                         break;
                 case JSON_VALUE_TRUE:
                 case JSON_VALUE_FALSE:
@@ -1057,11 +1202,12 @@ static bool json_ast_node_value_drop(json_node_value *value)
 
 bool json_drop(json *json)
 {
+        allocator *alloc = json->alloc;
         json_element *element = json->element;
-        if (!json_ast_node_value_drop(&element->value)) {
+        if (!json_ast_node_value_drop(&element->value, alloc)) {
                 return false;
         } else {
-                free(json->element);
+                alloc_free(alloc, json->element);
                 return true;
         }
 }
@@ -1333,6 +1479,20 @@ static json_list_type_e number_type_to_list_type(number_min_type_e type)
         }
 }
 
+json_list_type_e json_number_list_type(const json_number *number)
+{
+        switch (number->value_type) {
+                case JSON_NUMBER_FLOAT:
+                        return JSON_LIST_FIXED_FLOAT;
+                case JSON_NUMBER_UNSIGNED:
+                        return number_type_to_list_type(number_min_type_unsigned(number->value.unsigned_integer));
+                case JSON_NUMBER_SIGNED:
+                        return number_type_to_list_type(number_min_type_signed(number->value.signed_integer));
+                default: ERROR(ERR_UNSUPPORTEDTYPE, NULL);
+                        return JSON_LIST_EMPTY;
+        }
+}
+
 bool json_array_get_type(json_list_type_e *type, const json_array *array)
 {
         json_list_type_e list_type = JSON_LIST_EMPTY;
@@ -1345,21 +1505,9 @@ bool json_array_get_type(json_list_type_e *type, const json_array *array)
                                 list_type = JSON_LIST_VARIABLE_OR_NESTED;
                                 goto return_result;
                         case JSON_VALUE_NUMBER: {
-                                json_list_type_e elem_type;
-                                switch (elem->value.value.number->value_type) {
-                                        case JSON_NUMBER_FLOAT:
-                                                elem_type = JSON_LIST_FIXED_FLOAT;
-                                                break;
-                                        case JSON_NUMBER_UNSIGNED:
-                                                elem_type = number_type_to_list_type(number_min_type_unsigned(
-                                                        elem->value.value.number->value.unsigned_integer));
-                                                break;
-                                        case JSON_NUMBER_SIGNED:
-                                                elem_type = number_type_to_list_type(number_min_type_signed(
-                                                        elem->value.value.number->value.signed_integer));
-                                                break;
-                                        default: ERROR(ERR_UNSUPPORTEDTYPE, NULL);
-                                                continue;
+                                json_list_type_e elem_type = json_number_list_type(elem->value.value.number);
+                                if (elem_type == JSON_LIST_EMPTY) {
+                                        continue;
                                 }
 
                                 list_type = json_fitting_type(list_type, elem_type);
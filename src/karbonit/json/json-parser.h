@@ -42,9 +42,26 @@ typedef struct json_err {
         const char *msg;
 } json_err;
 
+/* number of input characters that the tokenizer indexes at once */
+#define JSON_TOKENIZER_BLOCK_SIZE       64
+
+/**
+ * Tokenizes in two stages: the first stage indexes the input block-wise, marking the characters at which strings and
+ * runs of blanks may end (with AVX2 if the processor supports it); the second stage emits tokens, and jumps over
+ * strings and blanks by that index instead of inspecting each character on its own.
+ */
 typedef struct json_tokenizer {
         const char *cursor;
         json_token token;
+        /* input, and its terminating nul character */
+        const char *begin;
+        const char *end;
+        /* indexed input block; bit i of the masks stands for block[i], or for a nul character beyond the input */
+        const char *block;
+        /* '"', '\n', '\r', and nul characters */
+        u64 string_ends;
+        /* all characters except ' ', '\t', '\v', '\f', and '\r' */
+        u64 non_blanks;
 } json_tokenizer;
 
 typedef struct json_parser {
@@ -83,6 +100,8 @@ typedef enum json_list_type_e {
 
 typedef struct json {
         json_element *element;
+        /* allocator of all nodes, or NULL for the standard C library allocator */
+        allocator *alloc;
 } json;
 
 typedef struct json_node_value {
@@ -158,12 +177,19 @@ const json_token *json_tokenizer_next(json_tokenizer *tokenizer);
 void json_token_dup(json_token *dst, const json_token *src);
 void json_token_print(FILE *file, const json_token *token);
 bool json_parse(json *json, json_err *error_desc, json_parser *parser, const char *input);
+/* Same as json_parse, but allocates the AST via <code>alloc</code> (e.g., an arena that is dropped as a whole after
+ * the conversion of the AST). The allocator must outlive the AST. */
+bool json_parse_with(json *json, json_err *error_desc, json_parser *parser, const char *input, allocator *alloc);
 bool json_test(json *json);
 bool json_drop(json *json);
 bool json_print(FILE *file, json *json);
 bool json_list_is_empty(const json_elements *elements);
 bool json_list_length(u32 *len, const json_elements *elements);
 json_list_type_e json_fitting_type(json_list_type_e current, json_list_type_e to_add);
+/* Reads the number in <code>token</code>, a <code>LITERAL_INT</code> or <code>LITERAL_FLOAT</code> token */
+void json_number_from_token(json_number *number, const json_token *token);
+/* Returns the smallest list type that holds <code>number</code> (see <code>json_fitting_type</code>) */
+json_list_type_e json_number_list_type(const json_number *number);
 bool json_array_get_type(json_list_type_e *type, const json_array *array);
 
 #ifdef __cplusplus
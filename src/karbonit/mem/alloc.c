@@ -0,0 +1,419 @@
+/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/mem/alloc.h>
+
+/* all memory handed out is aligned to this boundary */
+#define ALLOC_ALIGN             16
+#define ALLOC_ROUND_UP(x)       (((x) + ALLOC_ALIGN - 1) & ~((size_t) ALLOC_ALIGN - 1))
+
+/* size of a request, which is stored in front of the memory handed out by arenas and pools */
+typedef struct alloc_header {
+        size_t size;
+        /* implementation-specific */
+        size_t tag;
+} alloc_header;
+
+#define ALLOC_HEADER(ptr)       ((alloc_header *) (ptr) - 1)
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  standard C library
+// ---------------------------------------------------------------------------------------------------------------------
+
+static void *std_malloc(allocator *self, size_t size)
+{
+        UNUSED(self);
+        return MALLOC(size);
+}
+
+static void *std_realloc(allocator *self, void *ptr, size_t size)
+{
+        UNUSED(self);
+        return realloc(ptr, size);
+}
+
+static void std_free(allocator *self, void *ptr)
+{
+        UNUSED(self);
+        free(ptr);
+}
+
+static void std_drop(allocator *self)
+{
+        UNUSED(self);
+}
+
+bool alloc_create_std(allocator *alloc)
+{
+        alloc->extra = NULL;
+        alloc->malloc = std_malloc;
+        alloc->realloc = std_realloc;
+        alloc->free = std_free;
+        alloc->drop = std_drop;
+        return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  arena
+// ---------------------------------------------------------------------------------------------------------------------
+
+typedef struct arena_chunk {
+        struct arena_chunk *next;
+        size_t cap;
+        size_t used;
+        size_t padding;
+        char data[];
+} arena_chunk;
+
+typedef struct arena {
+        /* chunk in which memory is currently allocated, followed by all filled chunks */
+        arena_chunk *head;
+        size_t chunk_size;
+        /* most recent allocation, which can be resized in place */
+        void *last;
+        size_t used;
+} arena;
+
+static arena_chunk *arena_chunk_new(size_t cap, arena_chunk *next)
+{
+        arena_chunk *chunk = malloc(sizeof(arena_chunk) + cap);
+        if (LIKELY(chunk != NULL)) {
+                chunk->next = next;
+                chunk->cap = cap;
+                chunk->used = 0;
+        }
+        return chunk;
+}
+
+static void *arena_malloc(allocator *self, size_t size)
+{
+        arena *extra = (arena *) self->extra;
+        size_t required = sizeof(alloc_header) + ALLOC_ROUND_UP(size);
+        arena_chunk *chunk = extra->head;
+
+        if (UNLIKELY(chunk->used + required > chunk->cap)) {
+                if (required > extra->chunk_size / 4) {
+                        /* large requests get a chunk on their own, such that the current chunk can be further filled */
+                        arena_chunk *large = arena_chunk_new(required, chunk->next);
+                        if (UNLIKELY(!large)) {
+                                ERROR(ERR_MALLOCERR, NULL);
+                                return NULL;
+                        }
+                        chunk->next = large;
+                        chunk = large;
+                } else {
+                        chunk = arena_chunk_new(extra->chunk_size, chunk);
+                        if (UNLIKELY(!chunk)) {
+                                ERROR(ERR_MALLOCERR, NULL);
+                                return NULL;
+                        }
+                        extra->head = chunk;
+                }
+        }
+
+        alloc_header *header = (alloc_header *) (chunk->data + chunk->used);
+        chunk->used += required;
+        extra->used += required;
+        header->size = size;
+        void *result = header + 1;
+        ZERO_MEMORY(result, size);
+        extra->last = result;
+        return result;
+}
+
+static void *arena_realloc(allocator *self, void *ptr, size_t size)
+{
+        if (!ptr) {
+                return arena_malloc(self, size);
+        }
+
+        arena *extra = (arena *) self->extra;
+        alloc_header *header = ALLOC_HEADER(ptr);
+        arena_chunk *chunk = extra->head;
+        size_t old_size = ALLOC_ROUND_UP(header->size);
+        size_t new_size = ALLOC_ROUND_UP(size);
+
+        if (new_size <= old_size) {
+                header->size = size;
+                return ptr;
+        } else if (ptr == extra->last && (char *) ptr + old_size == chunk->data + chunk->used &&
+                   chunk->used + new_size - old_size <= chunk->cap) {
+                /* the most recent allocation at the end of the current chunk grows in place */
+                chunk->used += new_size - old_size;
+                extra->used += new_size - old_size;
+                header->size = size;
+                return ptr;
+        } else {
+                size_t copy = header->size;
+                void *result = arena_malloc(self, size);
+                if (LIKELY(result != NULL)) {
+                        memcpy(result, ptr, copy);
+                }
+                return result;
+        }
+}
+
+static void arena_free(allocator *self, void *ptr)
+{
+        UNUSED(self);
+        UNUSED(ptr);
+}
+
+static void arena_drop(allocator *self)
+{
+        arena *extra = (arena *) self->extra;
+        for (arena_chunk *chunk = extra->head; chunk;) {
+                arena_chunk *next = chunk->next;
+                free(chunk);
+                chunk = next;
+        }
+        free(extra);
+        self->extra = NULL;
+}
+
+bool alloc_create_arena(allocator *alloc, size_t chunk_size)
+{
+        if (UNLIKELY(chunk_size < ALLOC_ALIGN)) {
+                return ERROR(ERR_ILLEGALARG, "chunk size of arena is too small");
+        }
+        arena *extra = MALLOC(sizeof(arena));
+        extra->chunk_size = ALLOC_ROUND_UP(chunk_size);
+        extra->head = arena_chunk_new(extra->chunk_size, NULL);
+        if (UNLIKELY(!extra->head)) {
+                free(extra);
+                return ERROR(ERR_MALLOCERR, NULL);
+        }
+
+        alloc->extra = extra;
+        alloc->malloc = arena_malloc;
+        alloc->realloc = arena_realloc;
+        alloc->free = arena_free;
+        alloc->drop = arena_drop;
+        return true;
+}
+
+bool alloc_arena_reset(allocator *alloc)
+{
+        if (UNLIKELY(alloc->malloc != arena_malloc)) {
+                return ERROR(ERR_ILLEGALARG, "allocator is not an arena");
+        }
+        arena *extra = (arena *) alloc->extra;
+        arena_chunk *keep = NULL;
+        for (arena_chunk *chunk = extra->head; chunk;) {
+                arena_chunk *next = chunk->next;
+                if (!keep && chunk->cap == extra->chunk_size) {
+                        keep = chunk;
+                } else {
+                        free(chunk);
+                }
+                chunk = next;
+        }
+        if (!keep) {
+                keep = arena_chunk_new(extra->chunk_size, NULL);
+                if (UNLIKELY(!keep)) {
+                        return ERROR(ERR_MALLOCERR, NULL);
+                }
+        }
+        keep->next = NULL;
+        keep->used = 0;
+        extra->head = keep;
+        extra->last = NULL;
+        extra->used = 0;
+        return true;
+}
+
+size_t alloc_arena_used(const allocator *alloc)
+{
+        return alloc->malloc == arena_malloc ? ((const arena *) alloc->extra)->used : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  pool
+// ---------------------------------------------------------------------------------------------------------------------
+
+typedef struct pool_slab {
+        struct pool_slab *next;
+        size_t padding;
+        char data[];
+} pool_slab;
+
+typedef struct pool {
+        pool_slab *slabs;
+        /* singly-linked list of freed objects, linked via their first bytes */
+        void *free_list;
+        size_t obj_size;
+        size_t stride;
+        size_t slab_objs;
+} pool;
+
+/* header size of a request which is too large for the pool, and hence served by the standard library */
+#define POOL_HUGE               ((size_t) -1)
+
+static void *pool_malloc(allocator *self, size_t size)
+{
+        pool *extra = (pool *) self->extra;
+        alloc_header *header;
+
+        if (UNLIKELY(size > extra->obj_size)) {
+                header = malloc(sizeof(alloc_header) + size);
+                if (UNLIKELY(!header)) {
+                        ERROR(ERR_MALLOCERR, NULL);
+                        return NULL;
+                }
+                header->tag = POOL_HUGE;
+        } else {
+                if (UNLIKELY(!extra->free_list)) {
+                        pool_slab *slab = malloc(sizeof(pool_slab) + extra->stride * extra->slab_objs);
+                        if (UNLIKELY(!slab)) {
+                                ERROR(ERR_MALLOCERR, NULL);
+                                return NULL;
+                        }
+                        slab->next = extra->slabs;
+                        extra->slabs = slab;
+                        for (size_t i = extra->slab_objs; i > 0; i--) {
+                                void **obj = (void **) (slab->data + (i - 1) * extra->stride);
+                                *obj = extra->free_list;
+                                extra->free_list = obj;
+                        }
+                }
+                header = (alloc_header *) extra->free_list;
+                extra->free_list = *(void **) header;
+                header->tag = 0;
+        }
+
+        header->size = size;
+        void *result = header + 1;
+        ZERO_MEMORY(result, size);
+        return result;
+}
+
+static void pool_free(allocator *self, void *ptr)
+{
+        if (ptr) {
+                pool *extra = (pool *) self->extra;
+                alloc_header *header = ALLOC_HEADER(ptr);
+                if (UNLIKELY(header->tag == POOL_HUGE)) {
+                        free(header);
+                } else {
+                        *(void **) header = extra->free_list;
+                        extra->free_list = header;
+                }
+        }
+}
+
+static void *pool_realloc(allocator *self, void *ptr, size_t size)
+{
+        if (!ptr) {
+                return pool_malloc(self, size);
+        }
+
+        pool *extra = (pool *) self->extra;
+        alloc_header *header = ALLOC_HEADER(ptr);
+        if (header->tag != POOL_HUGE && size <= extra->obj_size) {
+                header->size = size;
+                return ptr;
+        } else if (header->tag == POOL_HUGE && size > extra->obj_size) {
+                header = realloc(header, sizeof(alloc_header) + size);
+                if (UNLIKELY(!header)) {
+                        ERROR(ERR_REALLOCERR, NULL);
+                        return NULL;
+                }
+                header->size = size;
+                return header + 1;
+        } else {
+                void *result = pool_malloc(self, size);
+                if (LIKELY(result != NULL)) {
+                        memcpy(result, ptr, JAK_MIN(size, header->size));
+                        pool_free(self, ptr);
+                }
+                return result;
+        }
+}
+
+static void pool_drop(allocator *self)
+{
+        pool *extra = (pool *) self->extra;
+        for (pool_slab *slab = extra->slabs; slab;) {
+                pool_slab *next = slab->next;
+                free(slab);
+                slab = next;
+        }
+        free(extra);
+        self->extra = NULL;
+}
+
+bool alloc_create_pool(allocator *alloc, size_t obj_size, size_t slab_objs)
+{
+        if (UNLIKELY(obj_size == 0 || slab_objs == 0)) {
+                return ERROR(ERR_ILLEGALARG, NULL);
+        }
+        pool *extra = MALLOC(sizeof(pool));
+        extra->obj_size = obj_size;
+        extra->stride = sizeof(alloc_header) + ALLOC_ROUND_UP(obj_size);
+        extra->slab_objs = slab_objs;
+
+        alloc->extra = extra;
+        alloc->malloc = pool_malloc;
+        alloc->realloc = pool_realloc;
+        alloc->free = pool_free;
+        alloc->drop = pool_drop;
+        return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  thread-local arena
+// ---------------------------------------------------------------------------------------------------------------------
+
+#define THREAD_ARENA_CHUNK_SIZE (256 * 1024)
+
+static _Thread_local allocator thread_arena;
+static _Thread_local bool thread_arena_init = false;
+static pthread_key_t thread_arena_key;
+static pthread_once_t thread_arena_key_once = PTHREAD_ONCE_INIT;
+
+static void thread_arena_release(void *arg)
+{
+        alloc_drop((allocator *) arg);
+}
+
+static void thread_arena_key_create(void)
+{
+        pthread_key_create(&thread_arena_key, thread_arena_release);
+}
+
+allocator *alloc_thread_arena(void)
+{
+        if (UNLIKELY(!thread_arena_init)) {
+                if (UNLIKELY(!alloc_create_arena(&thread_arena, THREAD_ARENA_CHUNK_SIZE))) {
+                        return NULL;
+                }
+                pthread_once(&thread_arena_key_once, thread_arena_key_create);
+                pthread_setspecific(thread_arena_key, &thread_arena);
+                thread_arena_init = true;
+        }
+        return &thread_arena;
+}
+
+bool alloc_drop(allocator *alloc)
+{
+        alloc->drop(alloc);
+        return true;
+}
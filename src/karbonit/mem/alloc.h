@@ -0,0 +1,119 @@
+/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ALLOC_H
+#define ALLOC_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Allocator that can be passed to data structures (e.g., vec, str_buf, memblock, and the JSON parser) to route
+ * their memory requests. Structures take a pointer to an allocator which must outlive them; a <code>NULL</code>
+ * allocator stands for the standard C library allocator (and is what all structures use by default).
+ *
+ * Memory returned by <code>malloc</code> is zeroed (see MALLOC), memory returned by <code>realloc</code> beyond the
+ * size of the original request is not.
+ */
+typedef struct allocator {
+        /**
+         * Implementation-specific values
+         */
+        void *extra;
+
+        void *(*malloc)(allocator *self, size_t size);
+        void *(*realloc)(allocator *self, void *ptr, size_t size);
+        void (*free)(allocator *self, void *ptr);
+
+        /**
+         * Frees all resources bound to <code>self</code>, including memory which was not freed via <code>free</code>
+         */
+        void (*drop)(allocator *self);
+} allocator;
+
+/**
+ * Standard C library allocator (i.e., <code>malloc</code>, <code>realloc</code>, and <code>free</code>)
+ */
+bool alloc_create_std(allocator *alloc);
+
+/**
+ * Region-based (bump pointer) allocator that requests memory from the system in chunks of <code>chunk_size</code>
+ * bytes. Allocating is incrementing a pointer, and freeing single allocations is a no-op. The entire memory is
+ * released at once with <code>alloc_drop</code> (or recycled with <code>alloc_arena_reset</code>). Use an arena for
+ * short-lived structures that are built and dropped as a whole, e.g., the JSON AST during a conversion.
+ */
+bool alloc_create_arena(allocator *alloc, size_t chunk_size);
+
+/**
+ * Forgets all allocations made by the arena allocator <code>alloc</code> and keeps (the first chunk of) its memory
+ * for reuse.
+ */
+bool alloc_arena_reset(allocator *alloc);
+
+/**
+ * Returns the number of bytes in use by the arena allocator <code>alloc</code>
+ */
+size_t alloc_arena_used(const allocator *alloc);
+
+/**
+ * Pooled allocator for objects of (at most) <code>obj_size</code> bytes. Objects are carved from slabs of
+ * <code>slab_objs</code> objects, and freed objects are recycled via a free list. Requests of more than
+ * <code>obj_size</code> bytes are served by the standard C library allocator.
+ */
+bool alloc_create_pool(allocator *alloc, size_t obj_size, size_t slab_objs);
+
+/**
+ * Returns the arena allocator of the calling thread. The arena is created on the first call, and released when the
+ * thread terminates. Since all code running in the thread shares this arena, the owner of a pipeline that uses it is
+ * responsible to call <code>alloc_arena_reset</code> once the structures built are not used anymore.
+ */
+allocator *alloc_thread_arena(void);
+
+bool alloc_drop(allocator *alloc);
+
+static inline void *alloc_malloc(allocator *alloc, size_t size)
+{
+        return alloc ? alloc->malloc(alloc, size) : MALLOC(size);
+}
+
+static inline void *alloc_realloc(allocator *alloc, void *ptr, size_t size)
+{
+        return alloc ? alloc->realloc(alloc, ptr, size) : realloc(ptr, size);
+}
+
+static inline void alloc_free(allocator *alloc, void *ptr)
+{
+        if (alloc) {
+                alloc->free(alloc, ptr);
+        } else {
+                free(ptr);
+        }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
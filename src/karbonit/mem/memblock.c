@@ -0,0 +1,333 @@
+/**
+ * Copyright 2018 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <fcntl.h>
+#include <sys/syscall.h>
+
+#include <karbonit/mem/memblock.h>
+#include <karbonit/std/hash.h>
+
+/* shared memory object that holds the contents of a block which is shared among its copies */
+typedef struct memblock_cow {
+        /* kept open as long as any block maps this object, such that copies of any of these blocks can map it */
+        int fd;
+        /* number of blocks that map this object */
+        _Atomic(u32) refs;
+        /* size of the object, and the length of each mapping */
+        size_t len;
+} memblock_cow;
+
+/* number of shared memory objects (i.e., of open descriptors), see MEMBLOCK_COW_MAX_OBJECTS */
+static _Atomic(u32) cow_num_objects = 0;
+
+static int cow_create_fd(void)
+{
+#if defined(__linux__) && defined(SYS_memfd_create)
+        return (int) syscall(SYS_memfd_create, "karbonit-memblock", 0);
+#else
+        static _Atomic(u32) counter = 0;
+        char name[64];
+        snprintf(name, sizeof(name), "/karbonit-memblock-%d-%u", getpid(), atomic_fetch_add(&counter, 1));
+        int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd >= 0) {
+                shm_unlink(name);
+        }
+        return fd;
+#endif
+}
+
+static size_t cow_nchunks(size_t len)
+{
+        return (len + MEMBLOCK_COW_CHUNK - 1) / MEMBLOCK_COW_CHUNK;
+}
+
+static bool cow_is_dirty(const memblock *block, size_t chunk)
+{
+        return (block->cow_dirty[chunk / 8] >> (chunk % 8)) & 1;
+}
+
+/* unmaps the memory of the block, and drops the blocks reference to the shared memory object */
+static void cow_release(memblock *block)
+{
+        memblock_cow *cow = block->cow;
+        munmap(block->base, cow->len);
+
+        if (atomic_fetch_sub(&cow->refs, 1) == 1) {
+                close(cow->fd);
+                free(cow);
+                atomic_fetch_sub(&cow_num_objects, 1);
+        }
+
+        free(block->cow_dirty);
+        block->cow = NULL;
+        block->cow_dirty = NULL;
+        block->cow_ndirty = 0;
+        block->base = NULL;
+}
+
+/* copies the contents of <code>src</code> into a new shared memory object that is mapped by the copy as its owner, or
+ * returns NULL if no further object is available */
+static memblock *cow_share(memblock *src)
+{
+        if (atomic_fetch_add(&cow_num_objects, 1) >= MEMBLOCK_COW_MAX_OBJECTS) {
+                atomic_fetch_sub(&cow_num_objects, 1);
+                return NULL;
+        }
+
+        size_t page = (size_t) sysconf(_SC_PAGESIZE);
+        /* reserve address space for copies to grow; memory is only allocated for pages that are written */
+        size_t len = (2 * src->blockLength + page - 1) / page * page;
+
+        int fd = cow_create_fd();
+        void *base = MAP_FAILED;
+        if (LIKELY(fd >= 0) && LIKELY(ftruncate(fd, len) == 0)) {
+                base = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        if (UNLIKELY(base == MAP_FAILED)) {
+                if (fd >= 0) {
+                        close(fd);
+                }
+                atomic_fetch_sub(&cow_num_objects, 1);
+                return NULL;
+        }
+        if (MEMBLOCK_HAS_GAP(src)) {
+                memcpy(base, src->base, src->gap_off);
+                memcpy((char *) base + src->gap_off, (char *) src->base + src->gap_off + src->gap_len,
+                       src->blockLength - src->gap_off);
+        } else {
+                memcpy(base, src->base, src->blockLength);
+        }
+
+        memblock_cow *cow = MALLOC(sizeof(memblock_cow));
+        cow->fd = fd;
+        atomic_init(&cow->refs, 1);
+        cow->len = len;
+
+        memblock *result = MALLOC(sizeof(memblock));
+        result->blockLength = src->blockLength;
+        result->last_byte = src->last_byte;
+        result->capacity = len;
+        result->growth = src->growth;
+        result->base = base;
+        result->cow = cow;
+        return result;
+}
+
+/* maps the shared memory object of <code>src</code> privately for a copy, or returns NULL if it cannot be mapped */
+static memblock *cow_map(memblock *src)
+{
+        memblock_cow *cow = src->cow;
+
+        /* src holds a reference, so the descriptor stays open while it is mapped */
+        void *base = mmap(NULL, cow->len, PROT_READ | PROT_WRITE, MAP_PRIVATE, cow->fd, 0);
+        if (UNLIKELY(base == MAP_FAILED)) {
+                return NULL;
+        }
+        atomic_fetch_add(&cow->refs, 1);
+
+        size_t nchunks = cow_nchunks(cow->len);
+        memblock *result = MALLOC(sizeof(memblock));
+        result->blockLength = src->blockLength;
+        result->last_byte = src->last_byte;
+        result->capacity = cow->len;
+        result->growth = src->growth;
+        result->base = base;
+        result->cow = cow;
+        result->cow_dirty = MALLOC(nchunks / 8 + 1);
+
+        if (src->cow_dirty) {
+                /* the source is itself a copy: take over the chunks it modified */
+                for (size_t chunk = 0; chunk < nchunks; chunk++) {
+                        if (cow_is_dirty(src, chunk)) {
+                                size_t off = chunk * MEMBLOCK_COW_CHUNK;
+                                memcpy((char *) base + off, (char *) src->base + off,
+                                       JAK_MIN((size_t) MEMBLOCK_COW_CHUNK, cow->len - off));
+                        }
+                }
+                memcpy(result->cow_dirty, src->cow_dirty, nchunks / 8 + 1);
+                result->cow_ndirty = src->cow_ndirty;
+        }
+        return result;
+}
+
+bool memblock_cow_clone(memblock **dst, memblock *src)
+{
+        if (MEMBLOCK_IS_MAPPED(src) || src->blockLength < MEMBLOCK_COW_MIN_SIZE) {
+                MEMBLOCK_CPY(dst, src);
+                return true;
+        }
+
+        if (!MEMBLOCK_IS_SHARED(src) && !src->cow_copied) {
+                /* the first copy of a block: sharing pays off for copies of copies only */
+                MEMBLOCK_CPY(dst, src);
+                (*dst)->cow_copied = true;
+                return true;
+        }
+
+        memblock *result = NULL;
+        if (MEMBLOCK_IS_SHARED(src) && !MEMBLOCK_HAS_GAP(src) &&
+            !(src->cow_dirty && src->cow_ndirty > cow_nchunks(src->cow->len) / MEMBLOCK_COW_REBASE_RATIO)) {
+                result = cow_map(src);
+        }
+        if (!result) {
+                /* either the first copy, or the copy would share only a minor part with the shared memory object, or
+                 * the shared memory object cannot be mapped */
+                result = cow_share(src);
+        }
+        if (UNLIKELY(!result)) {
+                MEMBLOCK_CPY(dst, src);
+                (*dst)->cow_copied = true;
+                return true;
+        }
+        memblock_digest_cpy(result, src);
+
+        *dst = result;
+        return true;
+}
+
+bool memblock_cow_touch(memblock *block, offset_t off, offset_t nbytes)
+{
+        if (!block->cow_dirty) {
+                /* owner of the shared memory object, which must not be modified as long as copies map it */
+                return atomic_load(&block->cow->refs) > 1 ? memblock_cow_detach(block, block->capacity) : true;
+        } else if (nbytes > 0) {
+                size_t last = JAK_MIN(cow_nchunks(block->cow->len), (off + nbytes - 1) / MEMBLOCK_COW_CHUNK + 1);
+                for (size_t chunk = off / MEMBLOCK_COW_CHUNK; chunk < last; chunk++) {
+                        if (!cow_is_dirty(block, chunk)) {
+                                block->cow_dirty[chunk / 8] |= (u8) (1 << (chunk % 8));
+                                block->cow_ndirty++;
+                        }
+                }
+        }
+        return true;
+}
+
+bool memblock_cow_detach(memblock *block, offset_t capacity)
+{
+        offset_t used = block->blockLength + block->gap_len;
+        capacity = JAK_MAX(capacity, used);
+        void *base = malloc(capacity);
+        if (UNLIKELY(!base)) {
+                return ERROR(ERR_MALLOCERR, NULL);
+        }
+        memcpy(base, block->base, used);
+        cow_release(block);
+        block->base = base;
+        block->capacity = capacity;
+        block->cow_copied = true;
+        return true;
+}
+
+void memblock_cow_drop(memblock *block)
+{
+        cow_release(block);
+}
+
+/* cached chunk hashes of a block */
+typedef struct memblock_digest {
+        /* hash of each chunk as of the last digest */
+        hash64_t *hashes;
+        size_t num_chunks;
+        /* length of the block as of the last digest */
+        offset_t len;
+        /* one bit per chunk that is set if the chunk was modified since the last digest */
+        u8 *modified;
+} memblock_digest;
+
+static bool digest_is_modified(const memblock_digest *digest, size_t chunk)
+{
+        return (digest->modified[chunk / 8] >> (chunk % 8)) & 1;
+}
+
+bool memblock_digest_compute(u64 *hash, memblock *block)
+{
+        MEMBLOCK_CLOSE_GAP(block);
+
+        memblock_digest *digest = block->digest;
+        if (!digest) {
+                digest = block->digest = MALLOC(sizeof(memblock_digest));
+        }
+
+        offset_t len = block->blockLength;
+        size_t num_chunks = HASH64_NUM_CHUNKS(len);
+        /* chunks that are known to be unchanged unless modified; the last one of these might be partial */
+        size_t num_cached = JAK_MIN(digest->num_chunks, num_chunks);
+        if (digest->len != len && num_cached > 0) {
+                num_cached--;
+        }
+
+        if (num_chunks != digest->num_chunks) {
+                digest->hashes = realloc(digest->hashes, JAK_MAX(1u, num_chunks) * sizeof(hash64_t));
+        }
+        for (size_t chunk = 0; chunk < num_chunks; chunk++) {
+                if (chunk >= num_cached || digest_is_modified(digest, chunk)) {
+                        digest->hashes[chunk] = hash64_chunk(block->base, len, chunk);
+                }
+        }
+        *hash = hash64_chunks_combine(digest->hashes, num_chunks, len);
+
+        free(digest->modified);
+        digest->modified = MALLOC(num_chunks / 8 + 1);
+        digest->num_chunks = num_chunks;
+        digest->len = len;
+        return true;
+}
+
+void memblock_digest_touch(memblock *block, offset_t off, offset_t nbytes)
+{
+        memblock_digest *digest = block->digest;
+        if (nbytes > 0) {
+                /* chunks beyond the cached ones are rehashed anyway */
+                size_t last = JAK_MIN(digest->num_chunks, (off + nbytes - 1) / HASH64_CHUNK_SIZE + 1);
+                for (size_t chunk = off / HASH64_CHUNK_SIZE; chunk < last; chunk++) {
+                        digest->modified[chunk / 8] |= (u8) (1 << (chunk % 8));
+                }
+        }
+}
+
+void memblock_digest_cpy(memblock *dst, const memblock *src)
+{
+        memblock_digest *digest = src->digest;
+        if (digest) {
+                memblock_digest *result = MALLOC(sizeof(memblock_digest));
+                result->hashes = MALLOC(JAK_MAX(1u, digest->num_chunks) * sizeof(hash64_t));
+                memcpy(result->hashes, digest->hashes, digest->num_chunks * sizeof(hash64_t));
+                result->num_chunks = digest->num_chunks;
+                result->len = digest->len;
+                result->modified = MALLOC(digest->num_chunks / 8 + 1);
+                memcpy(result->modified, digest->modified, digest->num_chunks / 8 + 1);
+                dst->digest = result;
+                if (MEMBLOCK_HAS_GAP(src)) {
+                        /* modifications behind the gap were tracked at their physical positions in the source */
+                        memblock_digest_touch(dst, src->gap_off, src->blockLength - src->gap_off);
+                }
+        }
+}
+
+void memblock_digest_drop(memblock *block)
+{
+        if (block->digest) {
+                free(block->digest->hashes);
+                free(block->digest->modified);
+                free(block->digest);
+                block->digest = NULL;
+        }
+}
@@ -7,20 +7,301 @@
 #ifndef HAD_MEMBLOCK_H
 #define HAD_MEMBLOCK_H
 
+#include <sys/mman.h>
+
 #include <karbonit/stdinc.h>
 #include <karbonit/error.h>
+#include <karbonit/mem/alloc.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Policy that is applied to the reserved memory of a memory block in case the block must be enlarged. The exact policy
+ * reallocates to the (logical) size requested which is cheap in terms of memory but makes sequences of small
+ * enlargements (e.g., many inserts into a record) quadratic. The geometric policy (default) reserves memory ahead by
+ * a constant factor such that a sequence of enlargements has amortized constant costs. Independent of the policy, the
+ * (logical) size of a block, see MEMBLOCK_SIZE, is always the size requested. */
+typedef enum memblock_growth {
+        MEMBLOCK_GROWTH_EXACT,
+        MEMBLOCK_GROWTH_GEOMETRIC
+} memblock_growth_e;
+
+#define MEMBLOCK_GROWTH_FACTOR 1.7f
+
+struct memblock_cow;
+struct memblock_digest;
+
 typedef struct memblock {
     offset_t blockLength;
     offset_t last_byte;
+    offset_t capacity;
+    memblock_growth_e growth;
     void *base;
+    /* non-null if the block is a read-only view on a memory-mapped file, see MEMBLOCK_FROM_FILE_MAPPED */
+    void *mapped_base;
+    size_t mapped_len;
+    /* movable gap inside the reserved memory (gap editing mode only), see MEMBLOCK_SET_GAP_MODE */
+    bool gap_mode;
+    offset_t gap_off;
+    offset_t gap_len;
+    /* non-null if the blocks memory is shared copy-on-write with other blocks, see MEMBLOCK_CPY_SHARED */
+    struct memblock_cow *cow;
+    u8 *cow_dirty;
+    u32 cow_ndirty;
+    /* true if the block is a plain copy made by MEMBLOCK_CPY_SHARED, such that copies of it are shared */
+    bool cow_copied;
+    /* allocator for the blocks memory, or NULL for the standard C library allocator, see MEMBLOCK_CREATE_WITH */
+    allocator *alloc;
+    /* non-null if chunk hashes of the block are cached, see memblock_digest_compute */
+    struct memblock_digest *digest;
 } memblock;
 
-#define MEMBLOCK_CREATE(block, size)						                                                           \
+#define MEMBLOCK_IS_MAPPED(block)                                                                                      \
+        ((block)->mapped_base != NULL)
+
+#define MEMBLOCK_IS_SHARED(block)                                                                                      \
+        ((block)->cow != NULL)
+
+#define MEMBLOCK_SET_GROWTH(block, policy)                                                                             \
+{                                                                                                                      \
+        (block)->growth = (policy);                                                                                    \
+}
+
+#define MEMBLOCK_CAPACITY(block)                                                                                       \
+        ((block) ? (block)->capacity : 0)
+
+/* Reserves memory for at least <code>nbytes</code> bytes in the block without changing the blocks (logical) size.
+ * Use this to avoid reallocations if the (upper bound of the) final size is known in advance. */
+#define MEMBLOCK_RESERVE(block, nbytes)                                                                                \
+({                                                                                                                     \
+        bool memblock_reserve_status = true;                                                                           \
+        if (UNLIKELY(MEMBLOCK_IS_MAPPED((block)))) {                                                                   \
+                memblock_reserve_status = ERROR(ERR_WRITEPROT, "memory-mapped block cannot be resized");               \
+        } else if ((offset_t) (nbytes) > (block)->capacity && MEMBLOCK_IS_SHARED((block))) {                           \
+                memblock_reserve_status = memblock_cow_detach((block), (nbytes));                                      \
+        } else if ((offset_t) (nbytes) > (block)->capacity) {                                                          \
+                void *memblock_reserve_base = alloc_realloc((block)->alloc, (block)->base, (nbytes));                                        \
+                if (UNLIKELY(!memblock_reserve_base)) {                                                                \
+                        memblock_reserve_status = ERROR(ERR_REALLOCERR, NULL);                                         \
+                } else {                                                                                               \
+                        (block)->base = memblock_reserve_base;                                                         \
+                        (block)->capacity = (nbytes);                                                                  \
+                }                                                                                                      \
+        }                                                                                                              \
+        memblock_reserve_status;                                                                                       \
+})
+
+/* Ensures that at least <code>nbytes</code> are reserved according to the blocks growth policy */
+#define MEMBLOCK_GROW_CAPACITY(block, nbytes)                                                                          \
+({                                                                                                                     \
+        offset_t memblock_grow_required = (nbytes);                                                                    \
+        bool memblock_grow_status = true;                                                                              \
+        if (memblock_grow_required > (block)->capacity) {                                                              \
+                if ((block)->growth == MEMBLOCK_GROWTH_GEOMETRIC) {                                                    \
+                        offset_t memblock_grow_geometric = (block)->capacity * MEMBLOCK_GROWTH_FACTOR;                 \
+                        memblock_grow_required = JAK_MAX(memblock_grow_required, memblock_grow_geometric);             \
+                }                                                                                                      \
+                memblock_grow_status = MEMBLOCK_RESERVE((block), memblock_grow_required);                              \
+        }                                                                                                              \
+        memblock_grow_status;                                                                                          \
+})
+
+/* Copy-on-write sharing: the first copy of a block via MEMBLOCK_CPY_SHARED is a plain heap copy, since a shared
+ * memory object costs more than that copy to set up, and most blocks are copied once (e.g., a record revised once). A
+ * copy of such a copy (e.g., a revision of a revision) is copied into a shared memory object which is mapped by the
+ * copy (the owner), and privately by each further copy of the owner or of its copies. Such a further copy costs a
+ * mapping only, and reads of a copy are served by the pages of the shared object. Pages that a copy modifies are
+ * copied by the operating system on the first write; the copy tracks these modified chunks such that a copy of a
+ * copy only re-applies these chunks. The owner detaches from the shared object (i.e., it becomes a plain heap block)
+ * on its first modification as long as copies exist. The shared object (and its file descriptor) is kept as long as
+ * any block maps it, such that a chain of copies, each made from the previous one which is dropped afterwards, keeps
+ * sharing the same object. At most MEMBLOCK_COW_MAX_OBJECTS shared objects exist at a time, which bounds the number of
+ * file descriptors held. Blocks that are smaller than MEMBLOCK_COW_MIN_SIZE, memory-mapped blocks, and blocks for
+ * which no further shared object is available are deep copied instead.
+ *
+ * Copying never modifies the source block, which thus may be read concurrently. Any operation that writes to the
+ * block must announce the physical range written via MEMBLOCK_TOUCH beforehand; the blocks memory may move by doing
+ * so. If MEMBLOCK_TOUCH fails (i.e., an owner cannot detach from the copies that map it), the write must not happen,
+ * and the operation fails. */
+#define MEMBLOCK_COW_CHUNK              4096
+#define MEMBLOCK_COW_MIN_SIZE           (64 * 1024)
+#define MEMBLOCK_COW_MAX_OBJECTS        64
+
+/* a copy of a copy re-shares its contents once more than 1/MEMBLOCK_COW_REBASE_RATIO of its chunks are modified */
+#define MEMBLOCK_COW_REBASE_RATIO       4
+
+bool memblock_cow_clone(memblock **dst, memblock *src);
+bool memblock_cow_touch(memblock *block, offset_t off, offset_t nbytes);
+bool memblock_cow_detach(memblock *block, offset_t capacity);
+void memblock_cow_drop(memblock *block);
+
+/* Chunk digest: memblock_digest_compute hashes the blocks contents as hash64_chunked does, and caches the hash of each
+ * chunk in the block. Chunks that are modified afterwards are tracked via MEMBLOCK_TOUCH, and the next digest rehashes
+ * only these chunks. The cache is copied along with the block (see MEMBLOCK_CPY and MEMBLOCK_CPY_SHARED) such that a
+ * revision of a record rehashes only the chunks modified by the revision. */
+bool memblock_digest_compute(u64 *hash, memblock *block);
+void memblock_digest_touch(memblock *block, offset_t off, offset_t nbytes);
+void memblock_digest_cpy(memblock *dst, const memblock *src);
+void memblock_digest_drop(memblock *block);
+
+#define MEMBLOCK_TOUCH(block, off, nbytes)                                                                             \
+({                                                                                                                     \
+        bool memblock_touch_status = true;                                                                             \
+        if (UNLIKELY((block)->digest != NULL)) {                                                                       \
+                memblock_digest_touch((block), (off), (nbytes));                                                       \
+        }                                                                                                              \
+        if (UNLIKELY(MEMBLOCK_IS_SHARED((block)))) {                                                                   \
+                memblock_touch_status = memblock_cow_touch((block), (off), (nbytes));                                  \
+        }                                                                                                              \
+        memblock_touch_status;                                                                                         \
+})
+
+/* Gap editing mode: in this mode, a block keeps a movable gap of unused bytes at the position of the most recent
+ * structural change (see MEMBLOCK_MOVE_RIGHT and MEMBLOCK_MOVE_LEFT). Inserting at or removing from the gap does not
+ * move the remainder of the block but only resizes the gap, and moving the gap costs the distance moved. A sequence
+ * of localized edits therefore costs the size of edits rather than the size of the block for each single edit.
+ *
+ * Positions used with the block (and memfiles on top of it) are logical positions, i.e., the gap is invisible. Reads
+ * located after the gap are translated; reads that would touch the gap move the gap out of the way first. Any access
+ * to the raw data of the block (e.g., MEMBLOCK_RAW_DATA) materializes the block into its contiguous layout. Pointers
+ * obtained from a block in gap mode are valid until the next operation on that block. */
+#define MEMBLOCK_GAP_MIN        64
+
+/* number of bytes behind a peek position that are guaranteed to be located before the gap (e.g., to decode a variable
+ * length integer given only a pointer to its first byte) */
+#define MEMBLOCK_GAP_GUARD      16
+
+#define MEMBLOCK_HAS_GAP(block)                                                                                        \
+        ((block)->gap_len != 0)
+
+#define MEMBLOCK_PHYSICAL_POS(block, pos)                                                                              \
+        ((offset_t) (pos) + (MEMBLOCK_HAS_GAP((block)) && (offset_t) (pos) >= (block)->gap_off ? (block)->gap_len : 0))
+
+#define MEMBLOCK_MOVE_GAP(block, to)                                                                                   \
+({                                                                                                                     \
+        bool memblock_gap_status = true;                                                                               \
+        offset_t memblock_gap_to = (to);                                                                               \
+        if (memblock_gap_to < (block)->gap_off) {                                                                      \
+                memblock_gap_status = MEMBLOCK_TOUCH((block), memblock_gap_to,                                         \
+                                                     (block)->gap_off + (block)->gap_len - memblock_gap_to);           \
+        } else if (memblock_gap_to > (block)->gap_off) {                                                               \
+                memblock_gap_status = MEMBLOCK_TOUCH((block), (block)->gap_off,                                        \
+                                                     memblock_gap_to - (block)->gap_off + (block)->gap_len);           \
+        }                                                                                                              \
+        if (LIKELY(memblock_gap_status)) {                                                                             \
+                char *memblock_gap_base = (char *) (block)->base;                                                      \
+                if (memblock_gap_to < (block)->gap_off) {                                                              \
+                        memmove(memblock_gap_base + memblock_gap_to + (block)->gap_len,                                \
+                                memblock_gap_base + memblock_gap_to, (block)->gap_off - memblock_gap_to);              \
+                } else if (memblock_gap_to > (block)->gap_off) {                                                       \
+                        memmove(memblock_gap_base + (block)->gap_off,                                                  \
+                                memblock_gap_base + (block)->gap_off + (block)->gap_len,                               \
+                                memblock_gap_to - (block)->gap_off);                                                   \
+                }                                                                                                      \
+                (block)->gap_off = memblock_gap_to;                                                                    \
+        }                                                                                                              \
+        memblock_gap_status;                                                                                           \
+})
+
+/* Materializes the contiguous layout of the block; the gap becomes reserved memory at the end of the block. The gap
+ * stays in place if the block cannot be written (see MEMBLOCK_TOUCH). */
+#define MEMBLOCK_CLOSE_GAP(block)                                                                                      \
+{                                                                                                                      \
+        if (UNLIKELY(MEMBLOCK_HAS_GAP((block)))) {                                                                     \
+                if (LIKELY(MEMBLOCK_MOVE_GAP((block), (block)->blockLength))) {                                        \
+                        (block)->gap_off = (block)->gap_len = 0;                                                       \
+                }                                                                                                      \
+        }                                                                                                              \
+}
+
+/* Enlarges the gap to at least <code>nbytes</code> bytes and places it at <code>where</code>. To amortize the costs of
+ * moving the remainder of the block, the gap is enlarged proportional to the blocks size. Returns false if the block
+ * cannot grow or cannot be written, in which case the gap keeps its size. */
+#define MEMBLOCK_WIDEN_GAP(block, where, nbytes)                                                                       \
+({                                                                                                                     \
+        bool memblock_widen_status = true;                                                                             \
+        offset_t memblock_widen_len = JAK_MAX((offset_t) (nbytes),                                                     \
+                                              JAK_MAX((offset_t) MEMBLOCK_GAP_MIN, (block)->blockLength >> 3));        \
+        if (MEMBLOCK_HAS_GAP((block))) {                                                                               \
+                memblock_widen_status = MEMBLOCK_MOVE_GAP((block), (where));                                           \
+        } else {                                                                                                       \
+                (block)->gap_off = (where);                                                                            \
+        }                                                                                                              \
+        if (memblock_widen_status &&                                                                                   \
+            MEMBLOCK_GROW_CAPACITY((block), (block)->blockLength + memblock_widen_len) &&                              \
+            MEMBLOCK_TOUCH((block), (block)->gap_off,                                                                  \
+                           (block)->blockLength + memblock_widen_len - (block)->gap_off)) {                            \
+                memmove((char *) (block)->base + (block)->gap_off + memblock_widen_len,                                \
+                        (char *) (block)->base + (block)->gap_off + (block)->gap_len,                                  \
+                        (block)->blockLength - (block)->gap_off);                                                      \
+                (block)->gap_len = memblock_widen_len;                                                                 \
+        } else {                                                                                                       \
+                memblock_widen_status = false;                                                                         \
+        }                                                                                                              \
+        memblock_widen_status;                                                                                         \
+})
+
+/* Enables or disables the gap editing mode for the block. Disabling materializes the contiguous layout. */
+#define MEMBLOCK_SET_GAP_MODE(block, enabled)                                                                          \
+({                                                                                                                     \
+        bool memblock_gap_mode_status = true;                                                                          \
+        if (UNLIKELY(MEMBLOCK_IS_MAPPED((block)))) {                                                                   \
+                memblock_gap_mode_status = ERROR(ERR_WRITEPROT, "memory-mapped block cannot be edited");               \
+        } else {                                                                                                       \
+                if (!(enabled)) {                                                                                      \
+                        MEMBLOCK_CLOSE_GAP((block));                                                                   \
+                }                                                                                                      \
+                (block)->gap_mode = (enabled);                                                                         \
+        }                                                                                                              \
+        memblock_gap_mode_status;                                                                                      \
+})
+
+/* Returns a pointer to the byte at (logical) position <code>pos</code> such that at least <code>nbytes</code> bytes
+ * (plus a guard of MEMBLOCK_GAP_GUARD bytes) can be accessed without crossing the gap. */
+#define MEMBLOCK_PEEK_AT(block, pos, nbytes)                                                                           \
+({                                                                                                                     \
+        offset_t memblock_peek_pos = (pos);                                                                            \
+        if (UNLIKELY(MEMBLOCK_HAS_GAP((block))) && memblock_peek_pos < (block)->gap_off) {                             \
+                offset_t memblock_peek_end = memblock_peek_pos + (nbytes) + MEMBLOCK_GAP_GUARD;                        \
+                if (memblock_peek_end >= (block)->blockLength) {                                                       \
+                        MEMBLOCK_CLOSE_GAP((block));                                                                   \
+                } else if (memblock_peek_end > (block)->gap_off) {                                                     \
+                        MEMBLOCK_MOVE_GAP((block), memblock_peek_end);                                                 \
+                }                                                                                                      \
+        }                                                                                                              \
+        ((char *) (block)->base) + MEMBLOCK_PHYSICAL_POS((block), memblock_peek_pos);                                  \
+})
+
+/* Same as MEMBLOCK_PEEK_AT but for writing <code>nbytes</code> bytes to the position returned, or NULL if the block
+ * cannot be written (see MEMBLOCK_TOUCH) */
+#define MEMBLOCK_PEEK_MUT_AT(block, pos, nbytes)                                                                       \
+({                                                                                                                     \
+        char *memblock_peek_mut = MEMBLOCK_PEEK_AT((block), (pos), (nbytes));                                          \
+        if (UNLIKELY(MEMBLOCK_IS_SHARED((block)) || (block)->digest)) {                                                \
+                offset_t memblock_peek_mut_off = memblock_peek_mut - (char *) (block)->base;                           \
+                memblock_peek_mut = MEMBLOCK_TOUCH((block), memblock_peek_mut_off, (nbytes)) ?                         \
+                                    (char *) (block)->base + memblock_peek_mut_off : NULL;                             \
+        }                                                                                                              \
+        memblock_peek_mut;                                                                                             \
+})
+
+/* Returns a pointer to the byte at (logical) position <code>pos</code> such that the remainder of the block can be
+ * accessed without crossing the gap. */
+#define MEMBLOCK_RAW_DATA_AT(block, pos)                                                                               \
+({                                                                                                                     \
+        offset_t memblock_raw_pos = (pos);                                                                             \
+        if (UNLIKELY(MEMBLOCK_HAS_GAP((block))) && memblock_raw_pos < (block)->gap_off) {                              \
+                MEMBLOCK_CLOSE_GAP((block));                                                                           \
+        }                                                                                                              \
+        ((char *) (block)->base) + MEMBLOCK_PHYSICAL_POS((block), memblock_raw_pos);                                   \
+})
+
+#define MEMBLOCK_CREATE(block, size)                                                                                   \
+        MEMBLOCK_CREATE_WITH((block), (size), NULL)
+
+/* Same as MEMBLOCK_CREATE but the blocks memory is requested via <code>alloc</code> which must outlive the block */
+#define MEMBLOCK_CREATE_WITH(block, size, alloc_in)                                                                    \
 ({												                                                                       \
         bool memblock_create_status = true;                                                                                            \
         if (UNLIKELY(size == 0)) {							                                                           \
@@ -31,7 +312,10 @@ typedef struct memblock {
             ZERO_MEMORY(result, sizeof(memblock));			                                                           \
             result->blockLength = size;						                                                           \
             result->last_byte = 0;							                                                           \
-            result->base = MALLOC(size);					                                                           \
+            result->capacity = size;						                                                           \
+            result->growth = MEMBLOCK_GROWTH_GEOMETRIC;					                                                   \
+            result->alloc = (alloc_in);						                                                           \
+            result->base = alloc_malloc(result->alloc, size);					                                       \
             *(block) = result;								                                                           \
         }                                                                                                              \
         memblock_create_status;									                                                                       \
@@ -39,7 +323,14 @@ typedef struct memblock {
 
 #define MEMBLOCK_DROP(block)                                                                                           \
 {                                                                                                                      \
-    free((block)->base);                                                                                               \
+    if (MEMBLOCK_IS_MAPPED((block))) {                                                                                 \
+        munmap((block)->mapped_base, (block)->mapped_len);                                                             \
+    } else if (MEMBLOCK_IS_SHARED((block))) {                                                                          \
+        memblock_cow_drop((block));                                                                                    \
+    } else {                                                                                                           \
+        alloc_free((block)->alloc, (block)->base);                                                                     \
+    }                                                                                                                  \
+    memblock_digest_drop((block));                                                                                     \
     free((block));                                                                                                     \
 }
 
@@ -50,17 +341,59 @@ typedef struct memblock {
         ((size_t) numRead == (size_t) nbytes);												                           \
 })
 
+/* Constructs a read-only block of <code>nbytes</code> bytes that is backed by the contents of <code>file</code>
+ * starting at the current file position. The contents are not read but mapped into memory such that pages are only
+ * loaded when touched (and shared in the page cache among processes). <code>advice</code> is passed to
+ * <code>madvise</code> (e.g., <code>MADV_RANDOM</code> or <code>MADV_SEQUENTIAL</code>). A mapped block can be read
+ * with a memfile opened as <code>READ_ONLY</code>; any attempt to resize or modify the block fails. To modify its
+ * contents, copy the block via MEMBLOCK_CPY (which always results in a heap-allocated block). */
+#define MEMBLOCK_FROM_FILE_MAPPED(block, file, nbytes, advice)                                                         \
+({                                                                                                                     \
+        bool memblock_mapped_status = true;                                                                            \
+        long memblock_mapped_off = ftell((file));                                                                      \
+        size_t memblock_mapped_page = (size_t) sysconf(_SC_PAGESIZE);                                                  \
+        if (UNLIKELY(memblock_mapped_off < 0 || (nbytes) == 0)) {                                                      \
+                *(block) = NULL;                                                                                       \
+                memblock_mapped_status = ERROR(ERR_ILLEGALARG, NULL);                                                  \
+        } else {                                                                                                       \
+                size_t memblock_mapped_delta = (size_t) memblock_mapped_off % memblock_mapped_page;                    \
+                size_t memblock_mapped_len = memblock_mapped_delta + (nbytes);                                         \
+                void *memblock_mapped = mmap(NULL, memblock_mapped_len, PROT_READ, MAP_PRIVATE, fileno((file)),        \
+                                             memblock_mapped_off - memblock_mapped_delta);                             \
+                if (UNLIKELY(memblock_mapped == MAP_FAILED)) {                                                         \
+                        *(block) = NULL;                                                                               \
+                        memblock_mapped_status = ERROR(ERR_IO, "unable to map file into memory");                      \
+                } else {                                                                                               \
+                        madvise(memblock_mapped, memblock_mapped_len, (advice));                                       \
+                        struct memblock *result = (struct memblock *) MALLOC(sizeof(struct memblock));                 \
+                        result->blockLength = (nbytes);                                                                \
+                        result->last_byte = (nbytes);                                                                  \
+                        result->capacity = (nbytes);                                                                   \
+                        result->growth = MEMBLOCK_GROWTH_GEOMETRIC;                                                    \
+                        result->base = (char *) memblock_mapped + memblock_mapped_delta;                               \
+                        result->mapped_base = memblock_mapped;                                                         \
+                        result->mapped_len = memblock_mapped_len;                                                      \
+                        *(block) = result;                                                                             \
+                        fseek((file), (nbytes), SEEK_CUR);                                                             \
+                }                                                                                                      \
+        }                                                                                                              \
+        memblock_mapped_status;                                                                                        \
+})
+
 #define MEMBLOCK_FROM_RAW_DATA(block, data, nbytes)													                   \
 {																									                   \
         struct memblock *result = (struct memblock *) MALLOC(sizeof(struct memblock));				                   \
         result->blockLength = nbytes;																                   \
         result->last_byte = nbytes;																	                   \
+        result->capacity = nbytes;																	                   \
+        result->growth = MEMBLOCK_GROWTH_GEOMETRIC;															                   \
         result->base = MALLOC(nbytes);																                   \
         memcpy(result->base, data, nbytes);															                   \
+        *(block) = result;																	                   \
 }
 
 #define MEMBLOCK_RAW_DATA(block)									                                                   \
-        ((block) && (block)->base ? (block)->base : NULL)
+        ((block) && (block)->base ? ({ MEMBLOCK_CLOSE_GAP((block)); (block)->base; }) : NULL)
 
 #define MEMBLOCK_RAW_DATA_UNSAFE(block)									                                                   \
         (block->base)
@@ -68,10 +401,17 @@ typedef struct memblock {
 #define MEMBLOCK_WRITE(block, position, data, nbytes)										                           \
 ({										                                                                               \
         bool memblock_write_status;										                                                           \
-        if (LIKELY(position + nbytes < block->blockLength)) {										                   \
-                memcpy(((char *)block->base) + position, data, nbytes);										           \
-                block->last_byte = JAK_MAX(block->last_byte, position + nbytes);									   \
-                memblock_write_status = true;										                                                   \
+        if (UNLIKELY(MEMBLOCK_IS_MAPPED(block))) {										                                   \
+                memblock_write_status = ERROR(ERR_WRITEPROT, NULL);										               \
+        } else if (LIKELY(position + nbytes < block->blockLength)) {										                   \
+                char *memblock_write_dst = MEMBLOCK_PEEK_MUT_AT(block, position, nbytes);                              \
+                if (LIKELY(memblock_write_dst != NULL)) {                                                              \
+                        memcpy(memblock_write_dst, data, nbytes);                                                      \
+                        block->last_byte = JAK_MAX(block->last_byte, position + nbytes);                               \
+                        memblock_write_status = true;                                                                  \
+                } else {                                                                                               \
+                        memblock_write_status = false;                                                                 \
+                }                                                                                                      \
         } else {										                                                               \
                 memblock_write_status = false;										                                                   \
         }										                                                                       \
@@ -81,17 +421,35 @@ typedef struct memblock {
 #define MEMBLOCK_CPY(dst, src)										                                                   \
 {										                                                                               \
         MEMBLOCK_CREATE((dst), (src)->blockLength);										                               \
-        memcpy((*(dst))->base, (src)->base, (src)->blockLength);										               \
+        if (MEMBLOCK_HAS_GAP((src))) {										                                           \
+                memcpy((*(dst))->base, (src)->base, (src)->gap_off);										           \
+                memcpy((char *) (*(dst))->base + (src)->gap_off,										               \
+                       (char *) (src)->base + (src)->gap_off + (src)->gap_len, (src)->blockLength - (src)->gap_off);   \
+        } else {										                                                               \
+                memcpy((*(dst))->base, (src)->base, (src)->blockLength);										       \
+                assert(memcmp((*(dst))->base, (src)->base, (src)->blockLength) == 0);								   \
+        }										                                                                       \
         assert((*(dst))->base);										                                                   \
         assert((*(dst))->blockLength == (src)->blockLength);										                   \
-        assert(memcmp((*(dst))->base, (src)->base, (src)->blockLength) == 0);										   \
         (*(dst))->last_byte = (src)->last_byte;										                                   \
+        (*(dst))->growth = (src)->growth;										                                   \
+        memblock_digest_cpy(*(dst), (src));										                                   \
 }
 
+/* Copies <code>src</code> into <code>dst</code> sharing the memory of both blocks copy-on-write, see MEMBLOCK_COW_CHUNK */
+#define MEMBLOCK_CPY_SHARED(dst, src)                                                                                  \
+        memblock_cow_clone((dst), (src))
+
 #define MEMBLOCK_SHRINK(block)																		                   \
 {																		                                               \
-        (block)->blockLength = (block)->last_byte;																	   \
-        (block)->base = realloc((block)->base, (block)->blockLength);												   \
+        if (LIKELY(!MEMBLOCK_IS_MAPPED((block)))) {																   \
+                MEMBLOCK_CLOSE_GAP((block));															               \
+                (block)->blockLength = (block)->last_byte;															   \
+                if (!MEMBLOCK_IS_SHARED((block))) {															           \
+                        (block)->base = alloc_realloc((block)->alloc, (block)->base, (block)->blockLength);								   \
+                        (block)->capacity = (block)->blockLength;													   \
+                }															                                           \
+        }																		                                       \
 }
 
 #define MEMBLOCK_MOVE_RIGHT(block, where, nbytes)		                                                               \
@@ -100,11 +458,32 @@ typedef struct memblock {
 #define MEMBLOCK_MOVE_LEFT(block, where, nbytes)															           \
 ({															                                                           \
         bool status = true;															                                   \
-        if (UNLIKELY((where) + (nbytes) >= (block)->blockLength)) {													   \
+        if (UNLIKELY(MEMBLOCK_IS_MAPPED((block)))) {													               \
+            status = ERROR(ERR_WRITEPROT, NULL);															           \
+        } else if (UNLIKELY((where) + (nbytes) >= (block)->blockLength)) {											   \
             status = ERROR(ERR_OUTOFBOUNDS, NULL);															           \
+        } else if ((block)->gap_mode) {															                   \
+            if (MEMBLOCK_HAS_GAP((block))) {															               \
+                    status = MEMBLOCK_MOVE_GAP((block), (where));                                                      \
+            } else {															                                       \
+                    (block)->gap_off = (where);															               \
+            }															                                               \
+            if (UNLIKELY(!status ||                                                                                    \
+                         !MEMBLOCK_GROW_CAPACITY((block), (block)->blockLength + (block)->gap_len + (nbytes)) ||       \
+                         !MEMBLOCK_TOUCH((block), (block)->blockLength + (block)->gap_len, (nbytes)))) {               \
+                    status = false;                                                                                    \
+            } else {                                                                                                   \
+                    (block)->gap_len += (nbytes);                                                                      \
+                    ZERO_MEMORY((char *) (block)->base + (block)->blockLength + (block)->gap_len - (nbytes), (nbytes)) \
+                    assert((block)->last_byte >= (nbytes));                                                            \
+                    (block)->last_byte -= (nbytes);                                                                    \
+                    if ((block)->gap_len > JAK_MAX((offset_t) MEMBLOCK_GAP_MIN, (block)->blockLength)) {               \
+                            MEMBLOCK_CLOSE_GAP((block));                                                               \
+                    }                                                                                                  \
+            }                                                                                                          \
         } else {															                                           \
             size_t remainder = (block)->blockLength - (where) - (nbytes);											   \
-            if (remainder > 0) {															                           \
+            if (remainder > 0 && MEMBLOCK_TOUCH((block), (where), (block)->blockLength - (where))) {                   \
                     memmove((block)->base + (where), (block)->base + (where) + (nbytes), remainder);				   \
                     assert((block)->last_byte >= (nbytes));															   \
                     (block)->last_byte -= (nbytes);															           \
@@ -119,34 +498,68 @@ typedef struct memblock {
 #define MEMBLOCK_MOVE_EX(block, where, nbytes, zero_out)															   \
 ({																                                                       \
         bool status = true;																                               \
-        if (UNLIKELY(where >= (block)->blockLength)) {																   \
+        if (UNLIKELY(MEMBLOCK_IS_MAPPED((block)))) {																   \
+            status = ERROR(ERR_WRITEPROT, NULL);																       \
+        } else if (UNLIKELY(where >= (block)->blockLength)) {														   \
             ERROR(ERR_OUTOFBOUNDS, NULL);																               \
             status = false;																                               \
         } else {																                                       \
             if (UNLIKELY(nbytes == 0)) {																               \
                 ERROR(ERR_ILLEGALARG, NULL);																           \
                 status = false;																                           \
+            } else if ((block)->gap_mode) {																               \
+                offset_t memblock_move_len = JAK_MAX((block)->blockLength, (block)->last_byte + nbytes);			   \
+                if ((block)->gap_len < (offset_t) (nbytes)) {                                                          \
+                        status = MEMBLOCK_WIDEN_GAP((block), (where), (nbytes));                                       \
+                } else {                                                                                               \
+                        status = MEMBLOCK_MOVE_GAP((block), (where));                                                  \
+                }                                                                                                      \
+                if (LIKELY(status) && zero_out) {                                                                      \
+                        status = MEMBLOCK_TOUCH((block), (where), nbytes);                                             \
+                        if (LIKELY(status)) {                                                                          \
+                                ZERO_MEMORY((char *) (block)->base + (where), nbytes);                                 \
+                        }                                                                                              \
+                }                                                                                                      \
+                if (LIKELY(status)) {                                                                                  \
+                        (block)->gap_off += nbytes;                                                                    \
+                        (block)->gap_len -= nbytes;                                                                    \
+                        (block)->blockLength = memblock_move_len;                                                      \
+                        (block)->last_byte += nbytes;                                                                  \
+                }                                                                                                      \
             } else {																                                   \
-                if ((block)->last_byte + nbytes > (block)->blockLength) {											   \
-                        size_t new_length = ((block)->last_byte + nbytes);											   \
-                        (block)->base = realloc((block)->base, new_length);											   \
-                        if (zero_out) {																                   \
-                                ZERO_MEMORY((block)->base + (block)->blockLength, (new_length - (block)->blockLength));\
-                        }																                               \
-                        (block)->blockLength = new_length;															   \
-                }																                                       \
-                memmove((block)->base + where + nbytes, (block)->base + where, (block)->last_byte - where);			   \
-                if (zero_out) {																                           \
-                        ZERO_MEMORY((block)->base + where, nbytes);													   \
-                }																                                       \
-                (block)->last_byte += nbytes;																           \
-            }																                                           \
+                status = MEMBLOCK_TOUCH((block), (where),                                                              \
+                                        JAK_MAX((block)->blockLength, (block)->last_byte + nbytes) - (where));         \
+                if (LIKELY(status) && (block)->last_byte + nbytes > (block)->blockLength) {                            \
+                        size_t new_length = ((block)->last_byte + nbytes);                                             \
+                        if (UNLIKELY(!MEMBLOCK_GROW_CAPACITY((block), new_length))) {                                  \
+                                status = false;                                                                        \
+                        } else {                                                                                       \
+                                if (zero_out) {                                                                        \
+                                        ZERO_MEMORY((block)->base + (block)->blockLength,                              \
+                                                    (new_length - (block)->blockLength));                              \
+                                }                                                                                      \
+                                (block)->blockLength = new_length;                                                     \
+                        }                                                                                              \
+                }                                                                                                      \
+                if (LIKELY(status)) {                                                                                  \
+                        memmove((block)->base + where + nbytes, (block)->base + where, (block)->last_byte - where);    \
+                        if (zero_out) {                                                                                \
+                                ZERO_MEMORY((block)->base + where, nbytes);                                            \
+                        }                                                                                              \
+                        (block)->last_byte += nbytes;                                                                  \
+                }                                                                                                      \
+            }                                                                                                          \
         }																                                               \
         status;																                                           \
 })
 
 #define MEMBLOCK_ZERO_OUT(block)										                                               \
-        ZERO_MEMORY((block)->base, (block)->blockLength)
+{										                                                                               \
+        MEMBLOCK_CLOSE_GAP((block));										                                           \
+        if (LIKELY(MEMBLOCK_TOUCH((block), 0, (block)->blockLength))) {                                                \
+                ZERO_MEMORY((block)->base, (block)->blockLength)                                                       \
+        }                                                                                                              \
+}
 
 #define MEMBLOCK_SIZE(size, block)										                                               \
 {										                                                                               \
@@ -156,31 +569,70 @@ typedef struct memblock {
 #define MEMBLOCK_LAST_USED_BYTE(block)										                                           \
         ((block) ? (block)->last_byte : 0)
 
-#define MEMBLOCK_WRITE_TO_FILE(cfile, block)												                           \
-({												                                                                       \
-        size_t nwritten = fwrite((block)->base, (block)->blockLength, 1, (cfile));									   \
-        (nwritten == 1);												                                               \
+#define MEMBLOCK_WRITE_TO_FILE(cfile, block)                                                                           \
+({                                                                                                                     \
+        bool memblock_write_to_file_status;                                                                            \
+        if (MEMBLOCK_HAS_GAP((block))) {                                                                               \
+                offset_t memblock_tail_len = (block)->blockLength - (block)->gap_off;                                  \
+                memblock_write_to_file_status =                                                                        \
+                        fwrite((block)->base, 1, (block)->gap_off, (cfile)) == (block)->gap_off &&                     \
+                        fwrite((char *) (block)->base + (block)->gap_off + (block)->gap_len, 1, memblock_tail_len,     \
+                               (cfile)) == memblock_tail_len;                                                          \
+        } else {                                                                                                       \
+                size_t nwritten = fwrite((block)->base, (block)->blockLength, 1, (cfile));                             \
+                memblock_write_to_file_status = (nwritten == 1);                                                       \
+        }                                                                                                              \
+        memblock_write_to_file_status;                                                                                 \
 })
 
 #define MEMBLOCK_RESIZE(block, size)							                                                       \
 ({							                                                                                           \
-        bool memblock_resize_status = true;							                                                                   \
-        if (UNLIKELY((size) == 0)) {							                                                       \
-                memblock_resize_status = ERROR(ERR_ILLEGALARG, NULL);							                                       \
+        bool memblock_resize_status = true;							                                                       \
+        offset_t memblock_resize_size = (size);							                                               \
+        if (UNLIKELY(memblock_resize_size == 0)) {							                                               \
+                memblock_resize_status = ERROR(ERR_ILLEGALARG, NULL);							                           \
+        } else if (UNLIKELY(MEMBLOCK_IS_MAPPED((block)))) {							                                       \
+                memblock_resize_status = ERROR(ERR_WRITEPROT, "memory-mapped block cannot be resized");	               \
         } else {							                                                                           \
-            (block)->base = realloc((block)->base, (size));							                                   \
-            if ((size) > (block)->blockLength) {							                                           \
-                    ZERO_MEMORY(((char *)(block)->base) + (block)->blockLength, ((size) - (block)->blockLength));	   \
-            }							                                                                               \
-            (block)->blockLength = (size);							                                                   \
+            if (MEMBLOCK_HAS_GAP((block)) && memblock_resize_size <= (block)->gap_off) {                               \
+                    MEMBLOCK_CLOSE_GAP((block));                                                                       \
+            }                                                                                                          \
+            offset_t memblock_resize_phys = memblock_resize_size + (block)->gap_len;                                   \
+            offset_t memblock_resize_end = (block)->blockLength + (block)->gap_len;                                    \
+            if (memblock_resize_phys > (block)->capacity) {                                                            \
+                    memblock_resize_status = MEMBLOCK_GROW_CAPACITY((block), memblock_resize_phys);                    \
+            } else if ((block)->growth == MEMBLOCK_GROWTH_EXACT && !MEMBLOCK_IS_SHARED((block))) {                     \
+                    (block)->base = alloc_realloc((block)->alloc, (block)->base, memblock_resize_phys);                \
+                    (block)->capacity = memblock_resize_phys;                                                          \
+            }                                                                                                          \
+            if (memblock_resize_status && memblock_resize_phys > memblock_resize_end) {                                \
+                    memblock_resize_status = MEMBLOCK_TOUCH((block), memblock_resize_end,                              \
+                                                            memblock_resize_phys - memblock_resize_end);               \
+                    if (memblock_resize_status) {                                                                      \
+                            ZERO_MEMORY(((char *)(block)->base) + memblock_resize_end,                                 \
+                                        (memblock_resize_phys - memblock_resize_end));                                 \
+                    }                                                                                                  \
+            }                                                                                                          \
+            if (memblock_resize_status) {                                                                              \
+                    (block)->blockLength = memblock_resize_size;                                                       \
+            }                                                                                                          \
         }							                                                                                   \
-        memblock_resize_status;							                                                                               \
+        memblock_resize_status;							                                                                   \
 })
 
 #define MEMBLOCK_MOVE_CONTENTS_AND_DROP(block)					                                                       \
 ({					                                                                                                   \
+        MEMBLOCK_CLOSE_GAP((block));					                                                               \
+        if (MEMBLOCK_IS_SHARED((block)) || (block)->alloc) {					                                   \
+                /* the contents are handed out for being freed with free() */					                       \
+                void *memblock_contents = malloc((block)->blockLength);					                               \
+                memcpy(memblock_contents, (block)->base, (block)->blockLength);					                       \
+                MEMBLOCK_IS_SHARED((block)) ? memblock_cow_drop((block)) : alloc_free((block)->alloc, (block)->base);  \
+                (block)->base = memblock_contents;					                                                   \
+        }					                                                                                           \
         void *result = (block)->base;					                                                               \
         (block)->base = NULL;					                                                                       \
+        memblock_digest_drop((block));					                                                               \
         free((block));					                                                                               \
         result;					                                                                                       \
 })
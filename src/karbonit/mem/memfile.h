@@ -64,9 +64,11 @@ typedef struct memfile {
                                 memfile_write_status = false;																		   \
                         } else {	 																	               \
                                 (file)->pos += nbytes;																   \
+                                memfile_write_status = true;                                                           \
                         }                                                                                              \
-                }																		                               \
-                memfile_write_status = true;																		                   \
+                } else {                                                                                               \
+                        memfile_write_status = true;                                                                   \
+                }                                                                                                      \
         } else {																		                               \
                 ERROR(ERR_WRITEPROT, NULL);																		       \
                 memfile_write_status = false;																		                   \
@@ -151,8 +153,10 @@ typedef struct memfile {
 ({												                                                                       \
         u8 required_blocks = UINTVAR_STREAM_REQUIRED_BLOCKS((value));												   \
         signed_offset_t shift = MEMFILE_ENSURE_SPACE((file), required_blocks);										   \
-        uintvar_stream_t dst = (uintvar_stream_t) MEMFILE_PEEK((file), sizeof(char));								   \
-        uintvar_stream_write(dst, (value));												                               \
+        uintvar_stream_t dst = (uintvar_stream_t) MEMFILE_PEEK_MUT((file), required_blocks);						   \
+        if (LIKELY(dst != NULL)) {                                                                                     \
+                uintvar_stream_write(dst, (value));                                                                    \
+        }                                                                                                              \
         MEMFILE_SKIP((file), required_blocks);												                           \
         if ((nbytes_moved) != NULL) { signed_offset_t *assign = nbytes_moved; *assign = shift; }					   \
         required_blocks;												                                               \
@@ -170,8 +174,9 @@ typedef struct memfile {
                 u8 dec = bytes_used_now - bytes_used_then;															   \
                 MEMFILE_INPLACE_REMOVE((file), dec);															       \
         }															                                                   \
-        uintvar_stream_t dst = (uintvar_stream_t) MEMFILE_PEEK((file), sizeof(char));								   \
-        u8 required_blocks = uintvar_stream_write(dst, (value));													   \
+        uintvar_stream_t dst = (uintvar_stream_t) MEMFILE_PEEK_MUT((file), bytes_used_then);						   \
+        /** the block cannot be written if dst is NULL, see MEMBLOCK_TOUCH */                                          \
+        u8 required_blocks = LIKELY(dst != NULL) ? uintvar_stream_write(dst, (value)) : bytes_used_then;               \
         MEMFILE_SKIP((file), required_blocks);															               \
         (bytes_used_then - bytes_used_now);															                   \
 })
@@ -242,7 +247,7 @@ typedef struct memfile {
 #define MEMFILE_SIZE(file)							                                                                   \
 ({							                                                                                           \
         u64 ret;							                                                                           \
-        if (!(file) || !(file)->memblock) {							                                                   \
+        if (!(file)->memblock) {          							                                                   \
                 ret = 0;							                                                                   \
         } else {							                                                                           \
                 MEMBLOCK_SIZE(&ret, (file)->memblock);							                                       \
@@ -350,20 +355,24 @@ typedef struct memfile {
                         ERROR(ERR_READOUTOFBOUNDS, NULL);												                       \
                         result = NULL;												                                           \
                 } else {												                                                       \
-                                char *ptr = (char *) MEMBLOCK_RAW_DATA((file)->memblock);											   \
-                                if (ptr) {																				               \
-                                result = ptr + (file)->pos;												                           \
+                                if (MEMBLOCK_RAW_DATA_UNSAFE((file)->memblock)) {										               \
+                                result = MEMBLOCK_PEEK_AT((file)->memblock, (file)->pos, (nbytes));						           \
                                 }														                                               \
                 }												                                                               \
         }                                                                       \
         result;												                                                           \
 })
 
+/* pointer to the current position that is valid for the entire remainder of the file (e.g., for raw scans) */
 #define MEMFILE_RAW_DATA(file)                          \
-        ((u8 *)MEMFILE_PEEK__FAST(file))
+        ((u8 *) MEMBLOCK_RAW_DATA_AT((file)->memblock, (file)->pos))
+
+/* Same as MEMFILE_PEEK but for writing <code>nbytes</code> bytes at the current position */
+#define MEMFILE_PEEK_MUT(file, nbytes)                                                                                 \
+        MEMBLOCK_PEEK_MUT_AT((file)->memblock, (file)->pos, (nbytes))
 
 #define MEMFILE_PEEK__FAST(file)												                                       \
-                (((char *) MEMBLOCK_RAW_DATA_UNSAFE((file)->memblock)) + (file)->pos)
+                MEMBLOCK_PEEK_AT((file)->memblock, (file)->pos, sizeof(char))
 
 #define MEMFILE_WRITE_BYTE(file, data)							                                                       \
 {																                                                       \
@@ -486,6 +495,137 @@ static inline bool memfile_write_bit(memfile *file, bool flag)
         (file)->current_write_bit = (file)->bytes_completed = 0;											           \
 }
 
+/**
+ * Buffered bit stream on a memory file that writes (resp. reads) up to 64 bits per call. Bits are collected in a
+ * 64-bit accumulator, and transferred to the file in words rather than one read-modify-write per bit as in bit mode.
+ *
+ * The layout is the one of bit mode: the i-th bit of the stream is bit <code>i % 8</code> of the <code>i / 8</code>-th
+ * byte, and a stream of <code>n</code> bits occupies <code>max(1, ceil(n / 8))</code> bytes. Hence, streams written
+ * with <code>memfile_write_bit</code> can be read with <code>memfile_bits_read</code> and vice versa.
+ */
+typedef struct memfile_bits {
+        memfile *file;
+        /* pending bits; bit 0 is the next bit to be written (resp. read) */
+        u64 acc;
+        /* number of pending bits in the accumulator */
+        u32 nbits;
+        /* number of bytes transferred from (resp. to) the file */
+        size_t nbytes;
+} memfile_bits;
+
+static inline bool memfile_bits_begin_write(memfile_bits *stream, memfile *file)
+{
+        if (file->mode != READ_WRITE) {
+                return ERROR(ERR_WRITEPROT, NULL);
+        }
+        stream->file = file;
+        stream->acc = 0;
+        stream->nbits = 0;
+        stream->nbytes = 0;
+        return true;
+}
+
+static inline void memfile_bits_flush_bytes(memfile_bits *stream, u32 nbytes)
+{
+        u8 buffer[sizeof(u64)];
+        for (u32 i = 0; i < nbytes; i++) {
+                buffer[i] = (u8) (stream->acc >> (8 * i));
+        }
+        MEMFILE_WRITE(stream->file, buffer, nbytes);
+        stream->nbytes += nbytes;
+}
+
+/**
+ * Appends the <code>nbits</code> (at most 64) low-order bits of <code>value</code> to the stream, least significant
+ * bit first.
+ */
+static inline void memfile_bits_write(memfile_bits *stream, u64 value, u32 nbits)
+{
+        assert(nbits <= 64);
+        if (UNLIKELY(nbits == 0)) {
+                return;
+        }
+        value &= nbits < 64 ? (((u64) 1 << nbits) - 1) : ~(u64) 0;
+        stream->acc |= value << stream->nbits;
+        if (stream->nbits + nbits >= 64) {
+                memfile_bits_flush_bytes(stream, sizeof(u64));
+                stream->acc = stream->nbits ? value >> (64 - stream->nbits) : 0;
+                stream->nbits = stream->nbits + nbits - 64;
+        } else {
+                stream->nbits += nbits;
+        }
+}
+
+/**
+ * Writes the pending bits (padded with zeros to a full byte), and stores the number of bytes occupied by the stream
+ * in <code>num_bytes_written</code> (if non-null).
+ */
+static inline void memfile_bits_end_write(size_t *num_bytes_written, memfile_bits *stream)
+{
+        if (stream->nbits > 0 || stream->nbytes == 0) {
+                memfile_bits_flush_bytes(stream, JAK_MAX(1u, (stream->nbits + 7) / 8));
+        }
+        stream->acc = 0;
+        stream->nbits = 0;
+        if (num_bytes_written) {
+                *num_bytes_written = stream->nbytes;
+        }
+}
+
+static inline void memfile_bits_begin_read(memfile_bits *stream, memfile *file)
+{
+        stream->file = file;
+        stream->acc = 0;
+        stream->nbits = 0;
+        stream->nbytes = 0;
+}
+
+/**
+ * Reads the next <code>nbits</code> (at most 64) bits from the stream. The first bit read is the least significant
+ * bit of the result. Bits beyond the end of the file are read as zeros.
+ */
+static inline u64 memfile_bits_read(memfile_bits *stream, u32 nbits)
+{
+        assert(nbits <= 64);
+        if (nbits > 56) {
+                /* the accumulator is refilled bytewise, and might hold no more than 57 bits */
+                u64 low = memfile_bits_read(stream, 32);
+                return low | (memfile_bits_read(stream, nbits - 32) << 32);
+        }
+        if (stream->nbits < nbits) {
+                offset_t remain = MEMFILE_REMAIN_SIZE(stream->file);
+                u32 nload = (u32) JAK_MIN((offset_t) (64 - stream->nbits) / 8, remain);
+                const u8 *data = (const u8 *) MEMFILE_READ(stream->file, nload);
+                for (u32 i = 0; i < nload; i++) {
+                        stream->acc |= (u64) data[i] << stream->nbits;
+                        stream->nbits += 8;
+                }
+                stream->nbytes += nload;
+        }
+        u64 result = stream->acc & (nbits < 64 ? (((u64) 1 << nbits) - 1) : ~(u64) 0);
+        u32 consumed = JAK_MIN(nbits, stream->nbits);
+        stream->acc = consumed < 64 ? stream->acc >> consumed : 0;
+        stream->nbits -= consumed;
+        return result;
+}
+
+/**
+ * Positions the file right after the last byte from which bits were read, and stores the number of bytes consumed
+ * in <code>num_bytes_read</code> (if non-null).
+ */
+static inline void memfile_bits_end_read(size_t *num_bytes_read, memfile_bits *stream)
+{
+        /* whole bytes that were loaded into the accumulator but not consumed are given back to the file */
+        u32 unread = stream->nbits / 8;
+        stream->file->pos -= unread;
+        stream->nbytes -= unread;
+        stream->acc = 0;
+        stream->nbits = 0;
+        if (num_bytes_read) {
+                *num_bytes_read = stream->nbytes;
+        }
+}
+
 #define MEMFILE_CURRENT_POS(file, nbytes)																               \
 ({																                                                       \
 		void *data = NULL;																                               \
@@ -501,7 +641,7 @@ static inline bool memfile_write_bit(memfile *file, bool flag)
                                 data = NULL;																           \
                         }																                               \
                 }																                                       \
-                data = (void *) MEMFILE_PEEK((file), (nbytes));														   \
+                data = (void *) MEMFILE_PEEK_MUT((file), (nbytes));													   \
         }																                                               \
         data;																                                           \
 })
@@ -45,6 +45,8 @@ static bool internal_drop(rec *doc);
 
 static void carbon_header_init(rec *doc, key_e rec_key_type);
 
+static void carbon_header_skip(rec *doc);
+
 // ---------------------------------------------------------------------------------------------------------------------
 
 insert * rec_create_begin(rec_new *context, rec *doc,
@@ -118,33 +120,57 @@ void rec_create_empty_ex(rec *doc, list_type_e derivation, key_e type,
 bool rec_from_json(rec *doc, const char *json, key_e type,
                       const void *key)
 {
-        struct json data;
-        json_err status;
-        json_parser parser;
-
-        if (!(json_parse(&data, &status, &parser, json))) {
+        /* the record is built while tokenizing, without an intermediate AST */
+        if (!internal_from_json_stream(doc, json, type, key, OPTIMIZE)) {
                 ERROR(ERR_JSONPARSEERR, "parsing JSON file failed");
                 return false;
-        } else {
-                internal_from_json(doc, &data, type, key, OPTIMIZE);
-                json_drop(&data);
-                return true;
         }
+        return true;
 }
 
 bool rec_from_raw_data(rec *doc, const void *data, u64 len)
 {
         MEMBLOCK_FROM_RAW_DATA(&doc->block, data, len);
         MEMFILE_OPEN(&doc->file, doc->block, READ_WRITE);
+        carbon_header_skip(doc);
 
         return true;
 }
 
+bool rec_from_file(rec *doc, const char *file_path)
+{
+        FILE *file = fopen(file_path, "rb");
+        if (UNLIKELY(!file)) {
+                return ERROR(ERR_FOPEN_FAILED, file_path);
+        }
+
+        fseek(file, 0, SEEK_END);
+        long len = ftell(file);
+        fseek(file, 0, SEEK_SET);
+
+        bool status = len > 0 && MEMBLOCK_FROM_FILE_MAPPED(&doc->block, file, len, MADV_SEQUENTIAL);
+        fclose(file);
+
+        if (LIKELY(status)) {
+                MEMFILE_OPEN(&doc->file, doc->block, READ_ONLY);
+                carbon_header_skip(doc);
+                return true;
+        } else {
+                return ERROR(ERR_IO, "unable to map record file");
+        }
+}
+
 bool rec_drop(rec *doc)
 {
         return internal_drop(doc);
 }
 
+void rec_drop_and_free(void *ptr)
+{
+        rec_drop(ptr);
+        free(ptr);
+}
+
 const void *rec_raw_data(u64 *len, rec *doc)
 {
         if (len && doc) {
@@ -241,11 +267,18 @@ bool rec_has_key(key_e type)
 
 void rec_clone(rec *clone, rec *doc)
 {
-        MEMBLOCK_CPY(&clone->block, doc->block);
+        MEMBLOCK_CPY_SHARED(&clone->block, doc->block);
         MEMFILE_OPEN(&clone->file, clone->block, READ_WRITE);
         clone->data_off = doc->data_off;
 }
 
+void rec_view(rec *view, rec *doc)
+{
+        view->block = doc->block;
+        MEMFILE_OPEN(&view->file, view->block, READ_ONLY);
+        view->data_off = doc->data_off;
+}
+
 bool rec_commit_hash(u64 *hash, rec *doc)
 {
         *hash = internal_header_get_commit_hash(doc);
@@ -313,6 +346,18 @@ static bool internal_drop(rec *doc)
         return true;
 }
 
+static void carbon_header_skip(rec *doc)
+{
+        key_e rec_key_type;
+
+        MEMFILE_SEEK(&doc->file, 0);
+        key_skip(&rec_key_type, &doc->file);
+        if (rec_key_type != KEY_NOKEY) {
+                commit_skip(&doc->file);
+        }
+        doc->data_off = MEMFILE_TELL(&doc->file);
+}
+
 static void carbon_header_init(rec *doc, key_e rec_key_type)
 {
         assert(doc);
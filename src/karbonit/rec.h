@@ -38,6 +38,9 @@ typedef struct rec {
 typedef struct rev {
         rec *original;
         rec *revised;
+        /* path index of the original record, if any, which is valid for the revised record as long as it is not
+         * modified (see revise_begin_indexed) */
+        pindex *index;
 } rev;
 
 typedef struct rec_new {
@@ -72,8 +75,9 @@ typedef enum key {
 #define SORTED_MULTISET   0x08 /** annotate the record outer-most array as sorted multi set */
 #define UNSORTED_SET      0x10 /** annotate the record outer-most array as unsorted set */
 #define SORTED_SET        0x20 /** annotate the record outer-most array as sorted set */
+#define COLUMNAR          0x40 /** import arrays of numbers, resp. booleans, from JSON as columns of narrowest type */
 
-#define OPTIMIZE          (SHRINK | COMPACT | UNSORTED_MULTISET)
+#define OPTIMIZE          (SHRINK | COMPACT | UNSORTED_MULTISET | COLUMNAR)
 
 /**
  * Constructs a new context in which a new document can be created. The parameter <b>options</b> controls
@@ -118,6 +122,12 @@ typedef enum key {
  *  matches the semantics of a JSON array. Please note that this library does not provide any features to make
  *  deduplication and sorting work. Instead, the annotation stores the semantics of that particular container, which
  *  functionality must be effectively implemented at caller site.
+ *
+ * For records that are created from JSON, set <code>COLUMNAR</code> (which is part of <code>OPTIMIZE</code>) to
+ * store arrays that contain numbers, booleans, and nulls only as columns instead of arrays. The column type is the
+ * narrowest type that holds all values of the array, e.g., <code>[1, null, 300]</code> becomes a column of
+ * <code>u16</code>, and <code>[-1, 0.5]</code> a column of <code>float</code>. Arrays that mix booleans and numbers,
+ * or whose values do not fit into a single column type, remain arrays.
  */
 insert *rec_create_begin(rec_new *context, rec *doc, key_e type, int options);
 void rec_create_end(rec_new *context);
@@ -127,11 +137,31 @@ void rec_create_empty_ex(rec *doc, list_type_e derivation, key_e type, u64 doc_c
 bool rec_from_json(rec *doc, const char *json, key_e type, const void *key);
 bool rec_from_raw_data(rec *doc, const void *data, u64 len);
 
+/** Opens the record stored in file <code>file_path</code> (as written from <code>rec_raw_data</code>) without
+ * reading it. The file is memory-mapped read-only, which makes opening (even very large) records almost free and
+ * lets several processes share the same pages. The record can be read and revised (a revision is a heap copy) but not
+ * patched. The mapping is released with <code>rec_drop</code>. */
+bool rec_from_file(rec *doc, const char *file_path);
+
 bool rec_drop(rec *doc);
 
+/** Drops the heap-allocated record <code>ptr</code> and frees it. The signature matches reclamation callbacks, e.g.,
+ * for <code>epoch_retire</code>. */
+void rec_drop_and_free(void *ptr);
+
 const void *rec_raw_data(u64 *len, rec *doc);
 
+/** Copies <code>doc</code> into <code>clone</code>. Large records that are copies themselves (e.g., revisions) are
+ * shared copy-on-write (see MEMBLOCK_CPY_SHARED) such that the copy costs the parts modified in <code>clone</code>
+ * afterwards rather than the size of the record.
+ * Cloning does not modify <code>doc</code>, i.e., pointers into <code>doc</code> stay valid and <code>doc</code> may be
+ * read concurrently. Modifying <code>doc</code> afterwards may move its memory while it shares it with copies. */
 void rec_clone(rec *clone, rec *doc);
+
+/** Makes <code>view</code> a read-only view of <code>doc</code>, which shares the memory of <code>doc</code> but reads
+ * through a cursor of its own, such that several threads can read the same record through views of their own. A view
+ * is valid as long as <code>doc</code> is, and is not dropped. */
+void rec_view(rec *view, rec *doc);
 bool rec_commit_hash(u64 *hash, rec *doc);
 
 /** Checks if the records most-outer array is annotated as a multi set abstract type. Returns true if the record
@@ -0,0 +1,154 @@
+/**
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/std/epoch.h>
+
+bool epoch_create(epoch *epoch)
+{
+        atomic_init(&epoch->global, 1);
+        atomic_init(&epoch->readers, NULL);
+        spinlock_init(&epoch->lock);
+        vec_create(&epoch->retired, sizeof(epoch_retired), EPOCH_COLLECT_THRESHOLD);
+        return true;
+}
+
+bool epoch_drop(epoch *epoch)
+{
+        epoch_retired *retired = VEC_ALL(&epoch->retired, epoch_retired);
+        for (u32 i = 0; i < epoch->retired.num_elems; i++) {
+                retired[i].drop(retired[i].ptr);
+        }
+        vec_drop(&epoch->retired);
+        epoch_reader *reader = atomic_load_explicit(&epoch->readers, memory_order_acquire);
+        while (reader) {
+                epoch_reader *next = reader->next;
+                free(reader);
+                reader = next;
+        }
+        return true;
+}
+
+epoch_reader *epoch_register(epoch *epoch)
+{
+        epoch_reader *reader = atomic_load_explicit(&epoch->readers, memory_order_acquire);
+        for (; reader; reader = reader->next) {
+                bool registered = false;
+                if (atomic_compare_exchange_strong(&reader->registered, &registered, true)) {
+                        return reader;
+                }
+        }
+        reader = MALLOC(sizeof(epoch_reader));
+        atomic_init(&reader->state, EPOCH_QUIESCENT);
+        atomic_init(&reader->registered, true);
+        reader->epoch = epoch;
+        reader->next = atomic_load_explicit(&epoch->readers, memory_order_relaxed);
+        while (!atomic_compare_exchange_weak_explicit(&epoch->readers, &reader->next, reader, memory_order_release,
+                                                      memory_order_relaxed)) { }
+        return reader;
+}
+
+bool epoch_unregister(epoch_reader *reader)
+{
+        if (UNLIKELY(atomic_load_explicit(&reader->state, memory_order_relaxed) != EPOCH_QUIESCENT)) {
+                return ERROR(ERR_ILLEGALSTATE, "reader is still in a read-side critical section");
+        }
+        atomic_store_explicit(&reader->registered, false, memory_order_release);
+        return true;
+}
+
+void epoch_enter(epoch_reader *reader)
+{
+        u64 global = atomic_load_explicit(&reader->epoch->global, memory_order_relaxed);
+        atomic_store_explicit(&reader->state, (global << 1) | 1, memory_order_relaxed);
+        /* writers that do not see this reader in a critical section unlinked their objects before the reader loads any
+         * pointer; otherwise, the epoch does not advance past the one the reader entered in */
+        atomic_thread_fence(memory_order_seq_cst);
+}
+
+void epoch_leave(epoch_reader *reader)
+{
+        atomic_store_explicit(&reader->state, EPOCH_QUIESCENT, memory_order_release);
+}
+
+/* advances the global epoch if all readers in critical sections entered in the current epoch, and returns the
+ * global epoch; the caller holds the lock */
+static u64 try_advance(epoch *epoch)
+{
+        atomic_thread_fence(memory_order_seq_cst);
+        u64 global = atomic_load_explicit(&epoch->global, memory_order_relaxed);
+        epoch_reader *reader = atomic_load_explicit(&epoch->readers, memory_order_acquire);
+        for (; reader; reader = reader->next) {
+                u64 state = atomic_load_explicit(&reader->state, memory_order_acquire);
+                if (state != EPOCH_QUIESCENT && (state >> 1) != global) {
+                        return global;
+                }
+        }
+        atomic_store_explicit(&epoch->global, global + 1, memory_order_release);
+        return global + 1;
+}
+
+u64 epoch_collect(epoch *epoch)
+{
+        vec ofType(epoch_retired) due;
+        vec_create(&due, sizeof(epoch_retired), EPOCH_COLLECT_THRESHOLD);
+
+        spinlock_acquire(&epoch->lock);
+        u64 global = try_advance(epoch);
+        epoch_retired *retired = VEC_ALL(&epoch->retired, epoch_retired);
+        u32 num_kept = 0;
+        for (u32 i = 0; i < epoch->retired.num_elems; i++) {
+                /* readers that may access the object entered at latest in the epoch after it was retired */
+                if (retired[i].epoch + 2 <= global) {
+                        vec_push(&due, &retired[i], 1);
+                } else {
+                        retired[num_kept++] = retired[i];
+                }
+        }
+        epoch->retired.num_elems = num_kept;
+        spinlock_release(&epoch->lock);
+
+        /* objects are dropped outside the lock, such that dropping may retire further objects */
+        retired = VEC_ALL(&due, epoch_retired);
+        for (u32 i = 0; i < due.num_elems; i++) {
+                retired[i].drop(retired[i].ptr);
+        }
+        vec_drop(&due);
+        return num_kept;
+}
+
+bool epoch_retire(epoch *epoch, void *ptr, void (*drop)(void *ptr))
+{
+        /* the object was unlinked before the epoch in which it is retired is read */
+        atomic_thread_fence(memory_order_seq_cst);
+        epoch_retired retired = {
+                .epoch = atomic_load_explicit(&epoch->global, memory_order_relaxed),
+                .ptr = ptr,
+                .drop = drop
+        };
+        spinlock_acquire(&epoch->lock);
+        vec_push(&epoch->retired, &retired, 1);
+        bool collect = epoch->retired.num_elems % EPOCH_COLLECT_THRESHOLD == 0;
+        spinlock_release(&epoch->lock);
+        if (collect) {
+                epoch_collect(epoch);
+        }
+        return true;
+}
@@ -0,0 +1,124 @@
+/**
+ * Copyright 2019 Marcus Pinnecke
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of
+ * the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef EPOCH_H
+#define EPOCH_H
+
+// ---------------------------------------------------------------------------------------------------------------------
+//  includes
+// ---------------------------------------------------------------------------------------------------------------------
+
+#include <karbonit/stdinc.h>
+#include <karbonit/error.h>
+#include <karbonit/std/spinlock.h>
+#include <karbonit/std/vec.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* number of retired objects after which retiring another object tries to free retired objects */
+#define EPOCH_COLLECT_THRESHOLD         64
+
+/* state of a reader that is not in a read-side critical section */
+#define EPOCH_QUIESCENT                 0
+
+/**
+ * A reader of data structures whose objects are reclaimed by an epoch (see <code>epoch_create</code>). Readers are
+ * registered once per thread, and are reused by later registrations once unregistered.
+ */
+typedef struct epoch_reader {
+        /* epoch (shifted by one, with the lowest bit set) in which the reader entered its critical section, or
+         * EPOCH_QUIESCENT outside of critical sections */
+        _Atomic(u64) state;
+        _Atomic(bool) registered;
+        struct epoch *epoch;
+        struct epoch_reader *next;
+} epoch_reader;
+
+/* an object that is unreachable for new readers, and that is dropped once no reader may access it anymore */
+typedef struct epoch_retired {
+        u64 epoch;
+        void *ptr;
+        void (*drop)(void *ptr);
+} epoch_retired;
+
+/**
+ * Epoch-based reclamation of objects that are removed from a data structure while readers may still access them,
+ * e.g., superseded revisions of a record.
+ *
+ * Readers access the data structure only inside read-side critical sections (<code>epoch_enter</code> and
+ * <code>epoch_leave</code>), which neither block nor write to memory shared with other readers. A writer that
+ * unlinks an object from the data structure retires it (<code>epoch_retire</code>) instead of dropping it. A retired
+ * object is dropped once all readers that were in a critical section when it was retired have left their critical
+ * section, i.e., once the global epoch advanced twice after retiring the object. The global epoch advances only if
+ * all readers in critical sections observed the current epoch, such that a reader that stays in its critical section
+ * delays (but never prevents) the reclamation of objects.
+ */
+typedef struct epoch {
+        _Atomic(u64) global;
+        /* registered readers, which are never unlinked before the epoch is dropped */
+        _Atomic(epoch_reader *) readers;
+        /* guards retired objects */
+        spinlock lock;
+        vec ofType(epoch_retired) retired;
+} epoch;
+
+bool epoch_create(epoch *epoch);
+
+/**
+ * Drops all retired objects, and the epoch. No reader must be in a critical section.
+ */
+bool epoch_drop(epoch *epoch);
+
+/**
+ * Registers a reader for the calling thread, which is used by this thread only and released by
+ * <code>epoch_unregister</code>. Registration is lock-free, and can run concurrently to readers and writers.
+ */
+epoch_reader *epoch_register(epoch *epoch);
+bool epoch_unregister(epoch_reader *reader);
+
+/**
+ * Enters a read-side critical section, during which objects that are reachable by the reader at some point in the
+ * critical section are not dropped. Critical sections do not nest.
+ */
+void epoch_enter(epoch_reader *reader);
+
+/**
+ * Leaves the read-side critical section. Objects that the reader accessed must not be accessed anymore afterwards.
+ */
+void epoch_leave(epoch_reader *reader);
+
+/**
+ * Retires the object <code>ptr</code>, which the caller made unreachable for new readers, such that it is dropped by
+ * <code>drop</code> once no reader may access it anymore. Dropping happens during later calls to
+ * <code>epoch_retire</code> or <code>epoch_collect</code> (in the calling thread), or at latest by
+ * <code>epoch_drop</code>.
+ */
+bool epoch_retire(epoch *epoch, void *ptr, void (*drop)(void *ptr));
+
+/**
+ * Tries to advance the global epoch, and drops retired objects that no reader may access anymore. Returns the number
+ * of objects that remain retired.
+ */
+u64 epoch_collect(epoch *epoch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -210,6 +210,129 @@ typedef u64 hash64_t;
     hash;                                                                                                              \
 })
 
+/** implements: hash64_t hash64_xx(size_t key_size, const void *key); i.e., XXH64 with seed zero */
+#define HASH64_XX(key_size, key)             hash64_xx((key), (key_size), 0)
+
+#define HASH64_XX_PRIME1        0x9E3779B185EBCA87ULL
+#define HASH64_XX_PRIME2        0xC2B2AE3D27D4EB4FULL
+#define HASH64_XX_PRIME3        0x165667B19E3779F9ULL
+#define HASH64_XX_PRIME4        0x85EBCA77C2B2AE63ULL
+#define HASH64_XX_PRIME5        0x27D4EB2F165667C5ULL
+
+#define HASH64_ROTL(x, r)       (((x) << (r)) | ((x) >> (64 - (r))))
+
+static inline u64 hash64_xx_round(u64 acc, u64 input)
+{
+        acc += input * HASH64_XX_PRIME2;
+        acc = HASH64_ROTL(acc, 31);
+        return acc * HASH64_XX_PRIME1;
+}
+
+static inline u64 hash64_xx_merge(u64 acc, u64 val)
+{
+        acc ^= hash64_xx_round(0, val);
+        return acc * HASH64_XX_PRIME1 + HASH64_XX_PRIME4;
+}
+
+/**
+ * 64-bit hash (XXH64) that consumes the key a word at a time. Four independent lanes of 8 bytes each are processed
+ * per iteration, which makes the hash an order of magnitude faster than the bytewise hashes above for larger keys.
+ */
+static inline hash64_t hash64_xx(const void *key, size_t key_size, u64 seed)
+{
+        const u8 *p = (const u8 *) key;
+        const u8 *end = p + key_size;
+        u64 hash, word;
+        u32 half;
+
+        if (key_size >= 32) {
+                u64 v1 = seed + HASH64_XX_PRIME1 + HASH64_XX_PRIME2;
+                u64 v2 = seed + HASH64_XX_PRIME2;
+                u64 v3 = seed;
+                u64 v4 = seed - HASH64_XX_PRIME1;
+                do {
+                        memcpy(&word, p, sizeof(u64));
+                        v1 = hash64_xx_round(v1, word);
+                        memcpy(&word, p + 8, sizeof(u64));
+                        v2 = hash64_xx_round(v2, word);
+                        memcpy(&word, p + 16, sizeof(u64));
+                        v3 = hash64_xx_round(v3, word);
+                        memcpy(&word, p + 24, sizeof(u64));
+                        v4 = hash64_xx_round(v4, word);
+                        p += 32;
+                } while (p + 32 <= end);
+                hash = HASH64_ROTL(v1, 1) + HASH64_ROTL(v2, 7) + HASH64_ROTL(v3, 12) + HASH64_ROTL(v4, 18);
+                hash = hash64_xx_merge(hash, v1);
+                hash = hash64_xx_merge(hash, v2);
+                hash = hash64_xx_merge(hash, v3);
+                hash = hash64_xx_merge(hash, v4);
+        } else {
+                hash = seed + HASH64_XX_PRIME5;
+        }
+
+        hash += (u64) key_size;
+
+        for (; p + 8 <= end; p += 8) {
+                memcpy(&word, p, sizeof(u64));
+                hash ^= hash64_xx_round(0, word);
+                hash = HASH64_ROTL(hash, 27) * HASH64_XX_PRIME1 + HASH64_XX_PRIME4;
+        }
+        if (p + 4 <= end) {
+                memcpy(&half, p, sizeof(u32));
+                hash ^= (u64) half * HASH64_XX_PRIME1;
+                hash = HASH64_ROTL(hash, 23) * HASH64_XX_PRIME2 + HASH64_XX_PRIME3;
+                p += 4;
+        }
+        for (; p < end; p++) {
+                hash ^= (*p) * HASH64_XX_PRIME5;
+                hash = HASH64_ROTL(hash, 11) * HASH64_XX_PRIME1;
+        }
+
+        hash ^= hash >> 33;
+        hash *= HASH64_XX_PRIME2;
+        hash ^= hash >> 29;
+        hash *= HASH64_XX_PRIME3;
+        hash ^= hash >> 32;
+        return hash;
+}
+
+/**
+ * Chunked (two-level Merkle) hashing: the key is split into chunks of HASH64_CHUNK_SIZE bytes (the last chunk may be
+ * shorter), each chunk is hashed on its own, and the hash of the key is the hash of the sequence of chunk hashes. A
+ * key that changes in a few chunks only can therefore be rehashed by rehashing these chunks, and combining the
+ * (cached) hashes of all chunks with <code>hash64_chunks_combine</code>.
+ */
+#define HASH64_CHUNK_SIZE       4096
+
+#define HASH64_NUM_CHUNKS(key_size)                                                                                    \
+        (((key_size) + HASH64_CHUNK_SIZE - 1) / HASH64_CHUNK_SIZE)
+
+static inline hash64_t hash64_chunk(const void *key, size_t key_size, size_t chunk)
+{
+        size_t off = chunk * HASH64_CHUNK_SIZE;
+        return hash64_xx((const u8 *) key + off, JAK_MIN((size_t) HASH64_CHUNK_SIZE, key_size - off), 0);
+}
+
+static inline hash64_t hash64_chunks_combine(const hash64_t *chunk_hashes, size_t num_chunks, size_t key_size)
+{
+        return hash64_xx(chunk_hashes, num_chunks * sizeof(hash64_t), (u64) key_size);
+}
+
+static inline hash64_t hash64_chunked(const void *key, size_t key_size)
+{
+        size_t num_chunks = HASH64_NUM_CHUNKS(key_size);
+        hash64_t small[16];
+        hash64_t *chunk_hashes = num_chunks <= 16 ? small : (hash64_t *) malloc(num_chunks * sizeof(hash64_t));
+        for (size_t chunk = 0; chunk < num_chunks; chunk++) {
+                chunk_hashes[chunk] = hash64_chunk(key, key_size, chunk);
+        }
+        hash64_t hash = hash64_chunks_combine(chunk_hashes, num_chunks, key_size);
+        if (chunk_hashes != small) {
+                free(chunk_hashes);
+        }
+        return hash;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -25,10 +25,16 @@ bool str_buf_create(str_buf *buffer)
 }
 
 bool str_buf_create_ex(str_buf *buffer, size_t capacity)
+{
+        return str_buf_create_with(buffer, capacity, NULL);
+}
+
+bool str_buf_create_with(str_buf *buffer, size_t capacity, allocator *alloc)
 {
         buffer->cap = capacity;
         buffer->end = 0;
-        buffer->data = MALLOC(capacity);
+        buffer->alloc = alloc;
+        buffer->data = alloc_malloc(alloc, capacity);
         ERROR_IF_AND_RETURN(!buffer->data, ERR_MALLOCERR, false);
         ZERO_MEMORY(buffer->data, buffer->cap);
         return true;
@@ -46,7 +52,7 @@ bool str_buf_add_nchar(str_buf *buffer, const char *str, u64 strlen)
         if (strlen > 0) {
                 if (UNLIKELY(buffer->end + strlen >= buffer->cap)) {
                         size_t new_cap = (buffer->end + strlen) * 1.7f;
-                        buffer->data = realloc(buffer->data, new_cap);
+                        buffer->data = alloc_realloc(buffer->alloc, buffer->data, new_cap);
                         ERROR_IF_AND_RETURN(!buffer->data, ERR_REALLOCERR, false);
                         ZERO_MEMORY(buffer->data + buffer->cap, (new_cap - buffer->cap));
                         buffer->cap = new_cap;
@@ -183,7 +189,7 @@ bool str_buf_ensure_capacity(str_buf *buffer, u64 cap)
         /** resize if needed */
         if (UNLIKELY(cap > buffer->cap)) {
                 size_t new_cap = cap * 1.7f;
-                buffer->data = realloc(buffer->data, new_cap);
+                buffer->data = alloc_realloc(buffer->alloc, buffer->data, new_cap);
                 ERROR_IF_AND_RETURN(!buffer->data, ERR_REALLOCERR, false);
                 ZERO_MEMORY(buffer->data + buffer->cap, (new_cap - buffer->cap));
                 buffer->cap = new_cap;
@@ -223,7 +229,7 @@ bool str_buf_is_empty(str_buf *buffer)
 
 bool str_buf_drop(str_buf *buffer)
 {
-        free(buffer->data);
+        alloc_free(buffer->alloc, buffer->data);
         return true;
 }
 
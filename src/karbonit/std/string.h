@@ -24,6 +24,7 @@
 
 #include <karbonit/stdinc.h>
 #include <karbonit/error.h>
+#include <karbonit/mem/alloc.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -33,10 +34,14 @@ typedef struct str_buf {
         char *data;
         size_t cap;
         size_t end;
+        /* allocator for 'data', or NULL for the standard C library allocator */
+        allocator *alloc;
 } str_buf;
 
 bool str_buf_create(str_buf *buffer);
 bool str_buf_create_ex(str_buf *buffer, size_t capacity);
+/* requests memory via the allocator <code>alloc</code> which must outlive the buffer */
+bool str_buf_create_with(str_buf *buffer, size_t capacity, allocator *alloc);
 bool str_buf_drop(str_buf *buffer);
 
 bool str_buf_add(str_buf *buffer, const char *str);
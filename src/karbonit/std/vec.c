@@ -67,11 +67,17 @@ DEFINE_PRINTER_FUNCTION(size_t, "%zu")
 
 bool vec_create(vec *out, size_t elem_size, size_t cap_elems)
 {
-        out->base = MALLOC(cap_elems * elem_size);
+        return vec_create_with(out, elem_size, cap_elems, NULL);
+}
+
+bool vec_create_with(vec *out, size_t elem_size, size_t cap_elems, allocator *alloc)
+{
+        out->base = alloc_malloc(alloc, cap_elems * elem_size);
         out->num_elems = 0;
         out->cap_elems = cap_elems;
         out->elem_size = elem_size;
         out->grow_factor = 1.7f;
+        out->alloc = alloc;
         return true;
 }
 
@@ -113,6 +119,7 @@ bool vec_from_file(vec *vec, FILE *file)
         }
 
         vec->base = MALLOC(header.cap_elems * header.elem_size);
+        vec->alloc = NULL;
         vec->num_elems = header.num_elems;
         vec->cap_elems = header.cap_elems;
         vec->elem_size = header.elem_size;
@@ -151,7 +158,7 @@ bool vec_set_grow_factor(vec *vec, float factor)
 
 bool vec_drop(vec *vec)
 {
-        free(vec->base);
+        alloc_free(vec->alloc, vec->base);
         vec->base = NULL;
         return true;
 }
@@ -167,7 +174,7 @@ bool vec_push(vec *vec, const void *data, size_t num_elems)
         while (next_num > vec->cap_elems) {
                 size_t more = next_num - vec->cap_elems;
                 vec->cap_elems = (vec->cap_elems + more) * vec->grow_factor;
-                vec->base = realloc(vec->base, vec->cap_elems * vec->elem_size);
+                vec->base = alloc_realloc(vec->alloc, vec->base, vec->cap_elems * vec->elem_size);
         }
         memcpy(vec->base + vec->num_elems * vec->elem_size, data, num_elems * vec->elem_size);
         vec->num_elems += num_elems;
@@ -189,7 +196,7 @@ bool vec_repeated_push(vec *vec, const void *data, size_t how_often)
         while (next_num > vec->cap_elems) {
                 size_t more = next_num - vec->cap_elems;
                 vec->cap_elems = (vec->cap_elems + more) * vec->grow_factor;
-                vec->base = realloc(vec->base, vec->cap_elems * vec->elem_size);
+                vec->base = alloc_realloc(vec->alloc, vec->base, vec->cap_elems * vec->elem_size);
         }
         for (size_t i = 0; i < how_often; i++) {
                 memcpy(vec->base + (vec->num_elems + i) * vec->elem_size, data, vec->elem_size);
@@ -219,7 +226,7 @@ bool vec_shrink(vec *vec)
 {
         if (vec->num_elems < vec->cap_elems) {
                 vec->cap_elems = JAK_MAX(1, vec->num_elems);
-                vec->base = realloc(vec->base, vec->cap_elems * vec->elem_size);
+                vec->base = alloc_realloc(vec->alloc, vec->base, vec->cap_elems * vec->elem_size);
         }
         return true;
 }
@@ -229,7 +236,7 @@ bool vec_grow(size_t *numNewSlots, vec *vec)
         size_t freeSlotsBefore = vec->cap_elems - vec->num_elems;
 
         vec->cap_elems = (vec->cap_elems * vec->grow_factor) + 1;
-        vec->base = realloc(vec->base, vec->cap_elems * vec->elem_size);
+        vec->base = alloc_realloc(vec->alloc, vec->base, vec->cap_elems * vec->elem_size);
         size_t freeSlotsAfter = vec->cap_elems - vec->num_elems;
         if (LIKELY(numNewSlots != NULL)) {
                 *numNewSlots = freeSlotsAfter - freeSlotsBefore;
@@ -240,7 +247,7 @@ bool vec_grow(size_t *numNewSlots, vec *vec)
 bool vec_grow_to(vec *vec, size_t capacity)
 {
         vec->cap_elems = JAK_MAX(vec->cap_elems, capacity);
-        vec->base = realloc(vec->base, vec->cap_elems * vec->elem_size);
+        vec->base = alloc_realloc(vec->alloc, vec->base, vec->cap_elems * vec->elem_size);
         return true;
 }
 
@@ -293,7 +300,7 @@ bool vec_cpy(vec *dst, const vec *src)
 
 bool vec_cpy_to(vec *dst, vec *src)
 {
-        void *handle = realloc(dst->base, src->cap_elems * src->elem_size);
+        void *handle = alloc_realloc(dst->alloc, dst->base, src->cap_elems * src->elem_size);
         if (handle) {
                 dst->elem_size = src->elem_size;
                 dst->num_elems = src->num_elems;
@@ -12,6 +12,7 @@
 #include <sys/mman.h>
 
 #include <karbonit/stdinc.h>
+#include <karbonit/mem/alloc.h>
 #include <karbonit/mem/memfile.h>
 
 #ifdef __cplusplus
@@ -46,6 +47,11 @@ typedef struct vec {
          * A pointer to a memory address managed by 'allocator' that contains the user data
          */
         void *base;
+
+        /**
+         * The allocator for 'base', or <code>NULL</code> for the standard C library allocator
+         */
+        allocator *alloc;
 } vec;
 
 /**
@@ -65,6 +71,11 @@ typedef vec ofType(const char *) string_vec_t;
  */
 bool vec_create(vec *out, size_t elem_size, size_t cap_elems);
 
+/**
+ * Same as <code>vec_create</code> but requests memory via the allocator <code>alloc</code> which must outlive the vec
+ */
+bool vec_create_with(vec *out, size_t elem_size, size_t cap_elems, allocator *alloc);
+
 bool vec_to_file(FILE *file, vec *vec);
 
 bool vec_from_file(vec *vec, FILE *file);
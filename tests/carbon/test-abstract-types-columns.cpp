@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <printf.h>
+#include <vector>
 
 #include <karbonit/karbonit.h>
 
@@ -210,6 +211,368 @@ TEST(TestAbstractTypes, ColumnSetNestedAbstractType) {
         rec_drop(&doc5);
 }
 
+TEST(TestAbstractTypes, SortedColumnKeepsOrder) {
+        rec_new context;
+        insert *ins, *nested;
+        rec doc, doc2;
+        col_state s1;
+        arr_it it;
+        col_it col_it;
+        rev rev_context;
+        u32 num_values, pos;
+        const u32 input[] = { 5, 1, 9, 5, 3, 7, 1 };
+
+        ins = rec_create_begin(&context, &doc, KEY_NOKEY, OPTIMIZE);
+        nested = insert_column_list_begin(&s1, ins, LIST_SORTED_MULTISET, COLUMN_U32, 4);
+        for (u32 value : input) {
+                insert_u32(nested, value);
+        }
+        insert_null(nested);
+        insert_column_list_end(&s1);
+        nested = insert_column_list_begin(&s1, ins, LIST_SORTED_SET, COLUMN_U32, 4);
+        for (u32 value : input) {
+                insert_u32(nested, value);
+        }
+        insert_column_list_end(&s1);
+        nested = insert_column_list_begin(&s1, ins, LIST_UNSORTED_MULTISET, COLUMN_U32, 4);
+        for (u32 value : input) {
+                insert_u32(nested, value);
+        }
+        insert_column_list_end(&s1);
+        rec_create_end(&context);
+
+        rec_read(&it, &doc);
+
+        /* sorted multiset: values are in order, and nulls are last */
+        arr_it_next(&it);
+        ITEM_GET_COLUMN(&col_it, &(it.item));
+        const u32 *values = internal_col_it_u32_values(&num_values, &col_it);
+        const u32 sorted[] = { 1, 1, 3, 5, 5, 7, 9, U32_NULL };
+        ASSERT_EQ(num_values, 8u);
+        ASSERT_TRUE(memcmp(values, sorted, sizeof(sorted)) == 0);
+        ASSERT_TRUE(col_it_find_u32(&pos, &col_it, 5));
+        ASSERT_EQ(pos, 3u);
+        ASSERT_FALSE(col_it_find_u32(&pos, &col_it, 6));
+        ASSERT_EQ(pos, 5u);
+
+        /* sorted set: duplicates are not inserted */
+        arr_it_next(&it);
+        ITEM_GET_COLUMN(&col_it, &(it.item));
+        values = internal_col_it_u32_values(&num_values, &col_it);
+        const u32 sorted_set[] = { 1, 3, 5, 7, 9 };
+        ASSERT_EQ(num_values, 5u);
+        ASSERT_TRUE(memcmp(values, sorted_set, sizeof(sorted_set)) == 0);
+        ASSERT_TRUE(col_it_find_u32(&pos, &col_it, 9));
+        ASSERT_EQ(pos, 4u);
+
+        /* unsorted columns are scanned */
+        arr_it_next(&it);
+        ITEM_GET_COLUMN(&col_it, &(it.item));
+        ASSERT_TRUE(col_it_find_u32(&pos, &col_it, 3));
+        ASSERT_EQ(pos, 4u);
+        ASSERT_FALSE(col_it_find_u32(&pos, &col_it, 4));
+        ASSERT_EQ(pos, 7u);
+
+        /* sorting an unsorted column sorts its values, and updates keep the order */
+        revise_begin(&rev_context, &doc2, &doc);
+        revise_iterator_open(&it, &rev_context);
+        arr_it_next(&it);
+        ITEM_GET_COLUMN(&col_it, &(it.item));
+        col_it_update_set_null(&col_it, 0);
+        arr_it_next(&it);
+        arr_it_next(&it);
+        ITEM_GET_COLUMN(&col_it, &(it.item));
+        col_it_update_type(&col_it, LIST_SORTED_MULTISET);
+        revise_end(&rev_context);
+
+        rec_read(&it, &doc2);
+        arr_it_next(&it);
+        ITEM_GET_COLUMN(&col_it, &(it.item));
+        values = internal_col_it_u32_values(&num_values, &col_it);
+        const u32 sorted_null[] = { 1, 3, 5, 5, 7, 9, U32_NULL, U32_NULL };
+        ASSERT_TRUE(memcmp(values, sorted_null, sizeof(sorted_null)) == 0);
+        arr_it_next(&it);
+        arr_it_next(&it);
+        ITEM_GET_COLUMN(&col_it, &(it.item));
+        values = internal_col_it_u32_values(&num_values, &col_it);
+        ASSERT_TRUE(col_it_is_sorted(&col_it));
+        ASSERT_TRUE(memcmp(values, sorted, 7 * sizeof(u32)) == 0);
+
+        rec_drop(&doc);
+        rec_drop(&doc2);
+}
+
+TEST(TestAbstractTypes, SortedSetColumnDropsDuplicates) {
+        rec_new context;
+        insert *ins, *nested;
+        rec doc, doc2;
+        col_state s1;
+        arr_it it;
+        col_it col_it;
+        rev rev_context;
+        u32 num_values;
+        const u32 input[] = { 5, 1, 9, 5, 3, 7, 1 };
+
+        ins = rec_create_begin(&context, &doc, KEY_NOKEY, OPTIMIZE);
+        nested = insert_column_list_begin(&s1, ins, LIST_UNSORTED_MULTISET, COLUMN_U32, 4);
+        for (u32 value : input) {
+                insert_u32(nested, value);
+        }
+        insert_null(nested);
+        insert_null(nested);
+        insert_column_list_end(&s1);
+        nested = insert_column_list_begin(&s1, ins, LIST_SORTED_SET, COLUMN_U32, 4);
+        insert_u32(nested, 1);
+        insert_u32(nested, 3);
+        insert_null(nested);
+        insert_column_list_end(&s1);
+        nested = insert_column_list_begin(&s1, ins, LIST_SORTED_SET, COLUMN_BOOLEAN, 4);
+        insert_true(nested);
+        insert_false(nested);
+        insert_column_list_end(&s1);
+        rec_create_end(&context);
+
+        /* converting to a sorted set, and updates of a sorted set, drop repeated values */
+        revise_begin(&rev_context, &doc2, &doc);
+        revise_iterator_open(&it, &rev_context);
+        arr_it_next(&it);
+        ITEM_GET_COLUMN(&col_it, &(it.item));
+        col_it_update_type(&col_it, LIST_SORTED_SET);
+        arr_it_next(&it);
+        ITEM_GET_COLUMN(&col_it, &(it.item));
+        col_it_update_set_null(&col_it, 0);
+        arr_it_next(&it);
+        ITEM_GET_COLUMN(&col_it, &(it.item));
+        col_it_update_set_true(&col_it, 0);
+        revise_end(&rev_context);
+
+        rec_read(&it, &doc2);
+        arr_it_next(&it);
+        ITEM_GET_COLUMN(&col_it, &(it.item));
+        const u32 *values = internal_col_it_u32_values(&num_values, &col_it);
+        const u32 sorted_set[] = { 1, 3, 5, 7, 9, U32_NULL };
+        ASSERT_EQ(num_values, 6u);
+        ASSERT_TRUE(memcmp(values, sorted_set, sizeof(sorted_set)) == 0);
+
+        arr_it_next(&it);
+        ITEM_GET_COLUMN(&col_it, &(it.item));
+        values = internal_col_it_u32_values(&num_values, &col_it);
+        const u32 nulled[] = { 3, U32_NULL };
+        ASSERT_EQ(num_values, 2u);
+        ASSERT_TRUE(memcmp(values, nulled, sizeof(nulled)) == 0);
+
+        arr_it_next(&it);
+        ITEM_GET_COLUMN(&col_it, &(it.item));
+        const boolean *flags = internal_col_it_boolean_values(&num_values, &col_it);
+        ASSERT_EQ(num_values, 1u);
+        ASSERT_EQ(flags[0], CARBON_BOOLEAN_COLUMN_TRUE);
+
+        /* the dropped values do not show up in the record */
+        str_buf str;
+        str_buf_create(&str);
+        rec_to_json(&str, &doc2);
+        ASSERT_TRUE(strcmp(str_buf_cstr(&str), "[[1, 3, 5, 7, 9, null], [3, null], [true]]") == 0);
+        str_buf_drop(&str);
+
+        rec_drop(&doc);
+        rec_drop(&doc2);
+}
+
+TEST(TestAbstractTypes, ColumnKernels) {
+        rec_new context;
+        insert *ins, *nested;
+        rec doc;
+        col_state s1;
+        arr_it it;
+        col_it col_it;
+        u32 count;
+        u64 sum;
+        i64 signed_sum;
+        double float_sum;
+        u32 u32_value;
+        i64 i64_value;
+        float float_value;
+        u8 u8_value;
+        u64 sel[COL_KERNELS_SEL_WORDS(1000)];
+
+        /* long enough for vectorized kernels, and not a multiple of the vector width to have a scalar tail */
+        const u32 num = 1000;
+
+        ins = rec_create_begin(&context, &doc, KEY_NOKEY, OPTIMIZE);
+        nested = insert_column_begin(&s1, ins, COLUMN_U32, num);
+        for (u32 i = 0; i < num; i++) {
+                i % 10 == 3 ? insert_null(nested) : insert_u32(nested, i);
+        }
+        insert_column_end(&s1);
+        nested = insert_column_begin(&s1, ins, COLUMN_I64, num);
+        for (u32 i = 0; i < num; i++) {
+                i % 10 == 3 ? insert_null(nested) : insert_i64(nested, (i64) i - 500);
+        }
+        insert_column_end(&s1);
+        nested = insert_column_begin(&s1, ins, COLUMN_FLOAT, num);
+        for (u32 i = 0; i < num; i++) {
+                i % 10 == 3 ? insert_null(nested) : insert_float(nested, i / 2.0f);
+        }
+        insert_column_end(&s1);
+        nested = insert_column_begin(&s1, ins, COLUMN_U8, 4);
+        insert_u8(nested, 7);
+        insert_null(nested);
+        insert_u8(nested, 2);
+        insert_column_end(&s1);
+        nested = insert_column_begin(&s1, ins, COLUMN_I32, 4);
+        insert_null(nested);
+        insert_column_end(&s1);
+        rec_create_end(&context);
+
+        u64 expected_sum = 0;
+        u32 expected_count = 0, expected_range = 0;
+        for (u32 i = 0; i < num; i++) {
+                if (i % 10 != 3) {
+                        expected_sum += i;
+                        expected_count++;
+                        expected_range += i >= 100 && i <= 799;
+                }
+        }
+
+        rec_read(&it, &doc);
+
+        arr_it_next(&it);
+        ITEM_GET_COLUMN(&col_it, &(it.item));
+        ASSERT_TRUE(col_kernels_count(&count, &col_it));
+        ASSERT_EQ(count, num);
+        ASSERT_TRUE(col_kernels_count_non_null(&count, &col_it));
+        ASSERT_EQ(count, expected_count);
+        ASSERT_TRUE(col_kernels_sum_unsigned(&sum, &col_it));
+        ASSERT_EQ(sum, expected_sum);
+        ASSERT_TRUE(col_kernels_min(&u32_value, &col_it));
+        ASSERT_EQ(u32_value, 0u);
+        ASSERT_TRUE(col_kernels_max(&u32_value, &col_it));
+        ASSERT_EQ(u32_value, 999u);
+        ASSERT_TRUE(col_kernels_filter_range_u32(sel, &col_it, 100, 799));
+        ASSERT_EQ(col_kernels_sel_count(sel, num), expected_range);
+        ASSERT_TRUE(col_kernels_filter_eq_u32(sel, &col_it, 998));
+        ASSERT_EQ(col_kernels_sel_count(sel, num), 1u);
+        ASSERT_EQ(sel[998 / 64], 1ull << (998 % 64));
+        /* nulls are never selected */
+        ASSERT_TRUE(col_kernels_filter_range(sel, &col_it, NULL, NULL));
+        ASSERT_EQ(col_kernels_sel_count(sel, num), expected_count);
+        ASSERT_FALSE(sel[0] & (1ull << 3));
+
+        arr_it_next(&it);
+        ITEM_GET_COLUMN(&col_it, &(it.item));
+        ASSERT_TRUE(col_kernels_sum_signed(&signed_sum, &col_it));
+        ASSERT_EQ(signed_sum, (i64) expected_sum - 500 * (i64) expected_count);
+        ASSERT_TRUE(col_kernels_min(&i64_value, &col_it));
+        ASSERT_EQ(i64_value, -500);
+        ASSERT_TRUE(col_kernels_max(&i64_value, &col_it));
+        ASSERT_EQ(i64_value, 499);
+        ASSERT_TRUE(col_kernels_filter_range_i64(sel, &col_it, -400, 299));
+        ASSERT_EQ(col_kernels_sel_count(sel, num), expected_range);
+
+        arr_it_next(&it);
+        ITEM_GET_COLUMN(&col_it, &(it.item));
+        ASSERT_TRUE(col_kernels_count_non_null(&count, &col_it));
+        ASSERT_EQ(count, expected_count);
+        ASSERT_TRUE(col_kernels_sum_float(&float_sum, &col_it));
+        ASSERT_EQ(float_sum, expected_sum / 2.0);
+        ASSERT_TRUE(col_kernels_max(&float_value, &col_it));
+        ASSERT_EQ(float_value, 499.5f);
+        ASSERT_TRUE(col_kernels_filter_range_float(sel, &col_it, 50.0f, 399.5f));
+        ASSERT_EQ(col_kernels_sel_count(sel, num), expected_range);
+
+        arr_it_next(&it);
+        ITEM_GET_COLUMN(&col_it, &(it.item));
+        ASSERT_TRUE(col_kernels_sum_unsigned(&sum, &col_it));
+        ASSERT_EQ(sum, 9u);
+        ASSERT_TRUE(col_kernels_min(&u8_value, &col_it));
+        ASSERT_EQ(u8_value, 2);
+        ASSERT_TRUE(col_kernels_filter_eq_u8(sel, &col_it, 7));
+        ASSERT_EQ(sel[0], 1u);
+
+        /* a column of nulls has no least value */
+        arr_it_next(&it);
+        ITEM_GET_COLUMN(&col_it, &(it.item));
+        ASSERT_FALSE(col_kernels_min(&i64_value, &col_it));
+        ASSERT_TRUE(col_kernels_sum_signed(&signed_sum, &col_it));
+        ASSERT_EQ(signed_sum, 0);
+
+        rec_drop(&doc);
+}
+
+TEST(TestAbstractTypes, ColumnBulkInsert) {
+        rec_new context;
+        insert *ins, *nested;
+        rec doc;
+        col_state s1;
+        arr_it it;
+        col_it col_it;
+        u32 num_values;
+        const u32 num = 100000;
+        const u32 unsorted[] = { 5, 1, 9, 5 };
+        const boolean booleans[] = { CARBON_BOOLEAN_COLUMN_TRUE, CARBON_BOOLEAN_COLUMN_NULL };
+        const u8 small[] = { 7, U8_NULL };
+
+        std::vector<u32> input(num);
+        for (u32 i = 0; i < num; i++) {
+                input[i] = i * 7;
+        }
+
+        ins = rec_create_begin(&context, &doc, KEY_NOKEY, OPTIMIZE);
+        nested = insert_column_begin(&s1, ins, COLUMN_U32, 4);
+        insert_u32(nested, 42);
+        ASSERT_TRUE(insert_u32_values(nested, input.data(), num));
+        ASSERT_TRUE(insert_u32_values(nested, unsorted, 4));
+        /* values of another type are not inserted */
+        error_abort_disable();
+        ASSERT_FALSE(insert_u8_values(nested, small, 2));
+        error_abort_enable();
+        insert_column_end(&s1);
+        nested = insert_column_list_begin(&s1, ins, LIST_SORTED_SET, COLUMN_U32, 4);
+        ASSERT_TRUE(insert_u32_values(nested, unsorted, 4));
+        insert_column_end(&s1);
+        nested = insert_column_begin(&s1, ins, COLUMN_BOOLEAN, 1);
+        ASSERT_TRUE(insert_boolean_values(nested, booleans, 2));
+        insert_column_end(&s1);
+        ASSERT_TRUE(insert_u32_values(ins, unsorted, 2));
+        ASSERT_TRUE(insert_u8_values(ins, small, 2));
+        rec_create_end(&context);
+
+        rec_read(&it, &doc);
+        arr_it_next(&it);
+        ITEM_GET_COLUMN(&col_it, &(it.item));
+        const u32 *values = internal_col_it_u32_values(&num_values, &col_it);
+        ASSERT_EQ(num_values, num + 5);
+        ASSERT_EQ(values[0], 42u);
+        ASSERT_TRUE(memcmp(values + 1, input.data(), num * sizeof(u32)) == 0);
+        ASSERT_TRUE(memcmp(values + 1 + num, unsorted, sizeof(unsorted)) == 0);
+
+        arr_it_next(&it);
+        ITEM_GET_COLUMN(&col_it, &(it.item));
+        values = internal_col_it_u32_values(&num_values, &col_it);
+        const u32 sorted_set[] = { 1, 5, 9 };
+        ASSERT_EQ(num_values, 3u);
+        ASSERT_TRUE(memcmp(values, sorted_set, sizeof(sorted_set)) == 0);
+
+        arr_it_next(&it);
+        ITEM_GET_COLUMN(&col_it, &(it.item));
+        const boolean *bools = internal_col_it_boolean_values(&num_values, &col_it);
+        ASSERT_EQ(num_values, 2u);
+        ASSERT_TRUE(memcmp(bools, booleans, sizeof(booleans)) == 0);
+
+        /* into arrays, values are inserted as fields, and null values as null fields */
+        item *field = arr_it_next(&it);
+        ASSERT_EQ(ITEM_GET_NUMBER_UNSIGNED(field, 0), 5u);
+        field = arr_it_next(&it);
+        ASSERT_EQ(ITEM_GET_NUMBER_UNSIGNED(field, 0), 1u);
+        field = arr_it_next(&it);
+        ASSERT_EQ(ITEM_GET_NUMBER_UNSIGNED(field, 0), 7u);
+        field = arr_it_next(&it);
+        ASSERT_TRUE(ITEM_IS_NULL(field));
+        ASSERT_FALSE(arr_it_next(&it));
+
+        rec_drop(&doc);
+}
+
 int main(int argc, char **argv) {
         ::testing::InitGoogleTest(&argc, argv);
         return RUN_ALL_TESTS();
@@ -208,6 +208,126 @@ TEST(TestAbstractTypes, ObjectSetNestedAbstractType) {
         rec_drop(&doc5);
 }
 
+TEST(TestAbstractTypes, SortedMapKeepsOrder) {
+        rec_new context;
+        insert *ins, *nested, *inner;
+        rec doc, doc2, doc3;
+        obj_state s1, s2;
+        arr_it it;
+        obj_it obj_it;
+        find find;
+        rev revise;
+        str_buf str;
+        u64 value;
+        insert ins_existing;
+
+        ins = rec_create_begin(&context, &doc, KEY_NOKEY, KEEP);
+        nested = insert_object_map_begin(&s1, ins, MAP_SORTED_MULTIMAP, 16);
+        insert_prop_u8(nested, "c", 1);
+        insert_prop_u8(nested, "a", 2);
+        inner = insert_prop_object_begin(&s2, nested, "bb", 16);
+        insert_prop_u8(inner, "y", 3);
+        insert_prop_u8(inner, "x", 4);
+        insert_prop_object_end(&s2);
+        insert_prop_u8(nested, "b", 5);
+        insert_prop_u8(nested, "a", 6);
+        insert_object_map_end(&s1);
+        nested = insert_object_map_begin(&s1, ins, MAP_UNSORTED_MULTIMAP, 16);
+        insert_prop_u8(nested, "c", 1);
+        insert_prop_u8(nested, "a", 2);
+        insert_object_map_end(&s1);
+        rec_create_end(&context);
+
+        /* sorted maps keep their properties in order of their keys, and equal keys in order of insertion */
+        str_buf_create(&str);
+        ASSERT_STREQ(rec_to_json(&str, &doc),
+                     "[{\"a\":2, \"a\":6, \"b\":5, \"bb\":{\"y\":3, \"x\":4}, \"c\":1}, {\"c\":1, \"a\":2}]");
+
+        /* key lookups in sorted maps stop at the first greater key */
+        ASSERT_TRUE(find_from_string(&find, "0.bb.x", &doc));
+        ASSERT_TRUE(find_result_unsigned(&value, &find));
+        ASSERT_EQ(value, 4u);
+        ASSERT_TRUE(find_from_string(&find, "0.c", &doc));
+        ASSERT_FALSE(find_from_string(&find, "0.ba", &doc));
+        ASSERT_FALSE(find_from_string(&find, "0.d", &doc));
+
+        /* inserts into an existing sorted map keep the order */
+        revise_begin(&revise, &doc2, &doc);
+        revise_iterator_open(&it, &revise);
+        arr_it_next(&it);
+        ITEM_GET_OBJECT(&obj_it, &(it.item));
+        internal_obj_it_insert_begin(&ins_existing, &obj_it);
+        insert_prop_u8(&ins_existing, "aa", 7);
+        insert_prop_u8(&ins_existing, "d", 8);
+        internal_obj_it_insert_end(&ins_existing);
+        revise_end(&revise);
+        ASSERT_TRUE(strstr(rec_to_json(&str, &doc2),
+                           "[{\"a\":2, \"a\":6, \"aa\":7, \"b\":5, \"bb\":{\"y\":3, \"x\":4}, \"c\":1, \"d\":8}, "));
+
+        /* objects that become sorted have their properties reordered */
+        revise_begin(&revise, &doc3, &doc2);
+        revise_find_begin(&find, "0.bb", &revise);
+        find_update_object_type(&find, MAP_SORTED_MAP);
+        revise_find_begin(&find, "1", &revise);
+        find_update_object_type(&find, MAP_SORTED_MAP);
+        revise_end(&revise);
+        ASSERT_STREQ(rec_to_json(&str, &doc3),
+                     "[{\"a\":2, \"a\":6, \"aa\":7, \"b\":5, \"bb\":{\"x\":4, \"y\":3}, \"c\":1, \"d\":8}, "
+                     "{\"a\":2, \"c\":1}]");
+        ASSERT_TRUE(find_from_string(&find, "1.a", &doc3));
+        ASSERT_TRUE(find_result_unsigned(&value, &find));
+        ASSERT_EQ(value, 2u);
+
+        str_buf_drop(&str);
+        rec_drop(&doc);
+        rec_drop(&doc2);
+        rec_drop(&doc3);
+}
+
+TEST(TestAbstractTypes, SortedMapAppendsKeysInOrder) {
+        rec_new context;
+        insert *ins, *nested, *inner;
+        rec doc;
+        obj_state s1, s2;
+        str_buf str;
+        char key[16];
+        std::string expected = "{";
+
+        /* keys that are inserted in order are appended, other keys are inserted in between */
+        ins = rec_create_begin(&context, &doc, KEY_NOKEY, KEEP);
+        nested = insert_object_map_begin(&s1, ins, MAP_SORTED_MULTIMAP, 16);
+        for (u32 i = 0; i < 1000; i++) {
+                snprintf(key, sizeof(key), "k%04u", 2 * i);
+                if (i == 500) {
+                        inner = insert_prop_object_begin(&s2, nested, key, 16);
+                        insert_prop_u8(inner, "x", 1);
+                        insert_prop_object_end(&s2);
+                } else {
+                        insert_prop_u32(nested, key, 2 * i);
+                }
+        }
+        insert_prop_u32(nested, "k0001", 1);
+        insert_prop_u32(nested, "k1999", 1999);
+        insert_prop_u32(nested, "k1997", 1997);
+        insert_prop_u32(nested, "k0000", 0);
+        insert_object_map_end(&s1);
+        rec_create_end(&context);
+
+        for (u32 i = 0; i < 1000; i++) {
+                snprintf(key, sizeof(key), "k%04u", 2 * i);
+                expected += (i > 0 ? ", \"" : "\"") + std::string(key) + "\":";
+                expected += i == 500 ? "{\"x\":1}" : std::to_string(2 * i);
+                expected += i == 0 ? ", \"k0000\":0, \"k0001\":1" : i == 998 ? ", \"k1997\":1997" : "";
+        }
+        expected += ", \"k1999\":1999}";
+
+        str_buf_create(&str);
+        ASSERT_EQ(std::string(rec_to_json(&str, &doc)), expected);
+
+        str_buf_drop(&str);
+        rec_drop(&doc);
+}
+
 int main(int argc, char **argv) {
         ::testing::InitGoogleTest(&argc, argv);
         return RUN_ALL_TESTS();
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <thread>
+
+#include <karbonit/karbonit.h>
+
+TEST(TestAlloc, ArenaMallocIsZeroedAndAligned) {
+        allocator arena;
+        ASSERT_TRUE(alloc_create_arena(&arena, 1024));
+
+        for (size_t size = 1; size < 3000; size += 7) {
+                char *ptr = (char *) alloc_malloc(&arena, size);
+                ASSERT_TRUE(ptr != NULL);
+                ASSERT_EQ((uintptr_t) ptr % 16, 0u);
+                for (size_t i = 0; i < size; i++) {
+                        ASSERT_EQ(ptr[i], 0);
+                }
+                memset(ptr, 'x', size);
+        }
+
+        alloc_drop(&arena);
+}
+
+TEST(TestAlloc, ArenaReallocKeepsContents) {
+        allocator arena;
+        alloc_create_arena(&arena, 4096);
+
+        u32 *values = NULL;
+        for (u32 i = 0; i < 10000; i++) {
+                values = (u32 *) alloc_realloc(&arena, values, (i + 1) * sizeof(u32));
+                values[i] = i;
+        }
+        for (u32 i = 0; i < 10000; i++) {
+                ASSERT_EQ(values[i], i);
+        }
+
+        ASSERT_GT(alloc_arena_used(&arena), 0u);
+        alloc_arena_reset(&arena);
+        ASSERT_EQ(alloc_arena_used(&arena), 0u);
+
+        alloc_drop(&arena);
+}
+
+TEST(TestAlloc, PoolRecyclesObjects) {
+        allocator pool;
+        ASSERT_TRUE(alloc_create_pool(&pool, 24, 4));
+
+        void *first = alloc_malloc(&pool, 24);
+        alloc_free(&pool, first);
+        ASSERT_EQ(alloc_malloc(&pool, 16), first);
+
+        /* requests larger than the object size are served by the standard library */
+        char *large = (char *) alloc_malloc(&pool, 1000);
+        memset(large, 'x', 1000);
+        large = (char *) alloc_realloc(&pool, large, 2000);
+        ASSERT_EQ(large[999], 'x');
+        alloc_free(&pool, large);
+
+        alloc_drop(&pool);
+}
+
+TEST(TestAlloc, StructuresWithArena) {
+        allocator arena;
+        alloc_create_arena(&arena, 1024);
+
+        vec ofType(u64) values;
+        vec_create_with(&values, sizeof(u64), 2, &arena);
+        for (u64 i = 0; i < 1000; i++) {
+                vec_push(&values, &i, 1);
+        }
+        ASSERT_EQ(*VEC_GET(&values, 999, u64), 999u);
+
+        str_buf sb;
+        str_buf_create_with(&sb, 4, &arena);
+        for (int i = 0; i < 100; i++) {
+                str_buf_add(&sb, "abc");
+        }
+        ASSERT_EQ(string_len(&sb), 300u);
+
+        memblock *block;
+        memfile file;
+        MEMBLOCK_CREATE_WITH(&block, 16, &arena);
+        MEMFILE_OPEN(&file, block, READ_WRITE);
+        for (u32 i = 0; i < 1000; i++) {
+                MEMFILE_WRITE(&file, &i, sizeof(u32));
+        }
+        MEMFILE_SEEK(&file, 999 * sizeof(u32));
+        ASSERT_EQ(*MEMFILE_READ_TYPE(&file, u32), 999u);
+        MEMBLOCK_DROP(block);
+
+        alloc_drop(&arena);
+}
+
+TEST(TestAlloc, ThreadArenaPerThread) {
+        allocator *main_arena = alloc_thread_arena();
+        ASSERT_EQ(main_arena, alloc_thread_arena());
+
+        allocator *other_arena = NULL;
+        std::thread worker([&other_arena]() {
+                other_arena = alloc_thread_arena();
+                alloc_malloc(other_arena, 100);
+        });
+        worker.join();
+        ASSERT_NE(main_arena, other_arena);
+
+        alloc_malloc(main_arena, 100);
+        alloc_arena_reset(main_arena);
+        ASSERT_EQ(alloc_arena_used(main_arena), 0u);
+}
+
+int main(int argc, char **argv) {
+        ::testing::InitGoogleTest(&argc, argv);
+        return RUN_ALL_TESTS();
+}
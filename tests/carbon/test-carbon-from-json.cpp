@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <printf.h>
+#include <string>
 
 #include <karbonit/karbonit.h>
 
@@ -45,6 +46,188 @@ TEST(FromOtherFormatTest, FromEmptyArrayNestedInObjectTest)
         assert_json_out_eq_json_in("{\"_\":[]}", "{\"_\":[]}");
 }
 
+TEST(FromOtherFormatTest, FromJsonStreamEqualsFromJsonAst)
+{
+        const char *json_in = "{\"a\": [1, 2, null, 300], \"b\": [-1, 2], \"c\": [1.5, null], \"d\": [true, null, false], "
+                              "\"e\": [null, null], \"f\": [1, \"x\", [2, 3], {\"g\": []}], \"h\": \"text\", "
+                              "\"i\": {\"j\": -70000, \"k\": [[1, 2], [3.5]]}, \"l\": false}";
+        const char *roots[] = { json_in, "[1, 2, 3]", "[-1, 2]", "[true, null]", "[]", "[\"x\", {}]", "42", "null" };
+
+        for (size_t i = 0; i < sizeof(roots) / sizeof(roots[0]); i++) {
+                rec streamed, from_ast;
+                str_buf str_streamed, str_from_ast;
+                json data;
+                json_err status;
+                json_parser parser;
+
+                ASSERT_TRUE(internal_from_json_stream(&streamed, roots[i], KEY_NOKEY, NULL, OPTIMIZE));
+                ASSERT_TRUE(json_parse(&data, &status, &parser, roots[i]));
+                internal_from_json(&from_ast, &data, KEY_NOKEY, NULL, OPTIMIZE);
+
+                str_buf_create(&str_streamed);
+                str_buf_create(&str_from_ast);
+                ASSERT_STREQ(json_from_record(&str_streamed, &streamed), json_from_record(&str_from_ast, &from_ast));
+
+                str_buf_drop(&str_streamed);
+                str_buf_drop(&str_from_ast);
+                json_drop(&data);
+                rec_drop(&streamed);
+                rec_drop(&from_ast);
+        }
+}
+
+TEST(FromOtherFormatTest, FromJsonStreamRejectsMalformedInput)
+{
+        const char *inputs[] = { "", "{", "[1, 2", "{\"a\" 1}", "{\"a\": 1,}", "[1] [2]", "{1: 2}", "[1, 2]]",
+                                 "\"unterminated", "\"ab\\", "\"ab\\\"", "[\"a\", \"b", "{\"a\": 1, \"b" };
+
+        for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+                rec doc;
+                ASSERT_FALSE(internal_from_json_stream(&doc, inputs[i], KEY_NOKEY, NULL, OPTIMIZE)) << inputs[i];
+        }
+}
+
+TEST(FromOtherFormatTest, FromJsonStreamRejectsNullSentinels)
+{
+        const char *rejected[] = { "{\"a\":[18446744073709551615,1]}", "{\"a\":[-9223372036854775808,1]}",
+                                   "{\"a\":18446744073709551615}", "[1, -9223372036854775808]" };
+        int modes[] = { OPTIMIZE, OPTIMIZE & ~COLUMNAR };
+        rec doc;
+
+        error_abort_disable();
+        for (size_t i = 0; i < sizeof(rejected) / sizeof(rejected[0]); i++) {
+                for (size_t j = 0; j < sizeof(modes) / sizeof(modes[0]); j++) {
+                        ASSERT_FALSE(internal_from_json_stream(&doc, rejected[i], KEY_NOKEY, NULL, modes[j]))
+                                << rejected[i];
+                }
+        }
+        error_abort_enable();
+
+        /** the largest and least integers that are not reserved for null keep their values in arrays */
+        assert_json_out_eq_json_in("{\"a\": [18446744073709551614, \"x\"]}",
+                                   "{\"a\":[18446744073709551614, \"x\"]}");
+        assert_json_out_eq_json_in("{\"a\": [-9223372036854775807, \"x\"]}",
+                                   "{\"a\":[-9223372036854775807, \"x\"]}");
+        assert_json_out_eq_json_in("{\"a\": [4294967296, \"x\"]}", "{\"a\":[4294967296, \"x\"]}");
+}
+
+
+TEST(FromOtherFormatTest, FromNdjsonInParallel)
+{
+        std::string ndjson;
+        for (unsigned i = 0; i < 5000; i++) {
+                if (i % 500 == 7) {
+                        ndjson += "{\"broken\": \n";
+                } else if (i % 500 == 8) {
+                        ndjson += "  \r\n";
+                } else if (i % 500 == 9) {
+                        /* raises an error inside the converter, which must not abort a pool thread */
+                        ndjson += "{\"a\": 18446744073709551615}\n";
+                } else {
+                        ndjson += "{\"id\": " + std::to_string(i) + ", \"tags\": [\"a\", \"b\"], \"v\": [1, 2, 3]}\n";
+                }
+        }
+
+        thread_pool *pool = thread_pool_create(3, 0);
+        ndjson_batch sequential, parallel;
+        ASSERT_TRUE(ndjson_ingest(&sequential, ndjson.c_str(), ndjson.size(), KEY_NOKEY, NULL));
+        ASSERT_TRUE(ndjson_ingest(&parallel, ndjson.c_str(), ndjson.size(), KEY_NOKEY, pool));
+
+        for (ndjson_batch *batch : { &sequential, &parallel }) {
+                ASSERT_EQ(batch->records.num_elems, 5000u - 3 * 10);
+                ASSERT_EQ(batch->errors.num_elems, 2 * 10u);
+                for (u32 i = 0; i < batch->errors.num_elems; i++) {
+                        ASSERT_EQ(VEC_GET(&batch->errors, i, ndjson_err)->line, 500u * (i / 2) + (i % 2 ? 10 : 8));
+                }
+                for (u32 i = 0; i < batch->records.num_elems; i++) {
+                        u64 line = *VEC_GET(&batch->lines, i, u64);
+                        std::string expected = "{\"id\":" + std::to_string(line - 1) +
+                                               ", \"tags\":[\"a\", \"b\"], \"v\":[1, 2, 3]}";
+                        str_buf str;
+                        str_buf_create(&str);
+                        ASSERT_STREQ(json_from_record(&str, VEC_GET(&batch->records, i, rec)), expected.c_str());
+                        str_buf_drop(&str);
+                }
+        }
+
+        ndjson_batch_drop(&sequential);
+        ndjson_batch_drop(&parallel);
+        thread_pool_free(pool);
+}
+
+TEST(FromOtherFormatTest, FromJsonColumnsOfNarrowestType)
+{
+        const char *json_in = "{\"small\": [1, null, 254], \"medium\": [255, null], \"signed\": [200, -1], "
+                              "\"wider\": [70000, -1], \"widest\": [-5, 3000000000], \"f\": [1, 1.5], "
+                              "\"b\": [true, null], \"mixed\": [true, 1], \"wide\": [-1, 10000000000000000000]}";
+        struct { const char *path; field_e type; } expected[] = {
+                { "small", FIELD_COLUMN_U8_UNSORTED_MULTISET }, { "medium", FIELD_COLUMN_U16_UNSORTED_MULTISET },
+                { "signed", FIELD_COLUMN_I16_UNSORTED_MULTISET }, { "wider", FIELD_COLUMN_I32_UNSORTED_MULTISET },
+                { "widest", FIELD_COLUMN_I64_UNSORTED_MULTISET }, { "f", FIELD_COLUMN_FLOAT_UNSORTED_MULTISET },
+                { "b", FIELD_COLUMN_BOOLEAN_UNSORTED_MULTISET }, { "mixed", FIELD_ARRAY_UNSORTED_MULTISET },
+                { "wide", FIELD_ARRAY_UNSORTED_MULTISET }
+        };
+        rec columnar, plain;
+        str_buf str;
+        find f;
+        field_e type;
+
+        ASSERT_TRUE(internal_from_json_stream(&columnar, json_in, KEY_NOKEY, NULL, OPTIMIZE));
+        ASSERT_TRUE(internal_from_json_stream(&plain, json_in, KEY_NOKEY, NULL, OPTIMIZE & ~COLUMNAR));
+        for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+                ASSERT_TRUE(find_from_string(&f, expected[i].path, &columnar));
+                ASSERT_TRUE(find_result_type(&type, &f));
+                ASSERT_EQ(type, expected[i].type) << expected[i].path;
+
+                ASSERT_TRUE(find_from_string(&f, expected[i].path, &plain));
+                ASSERT_TRUE(find_result_is_array(&f)) << expected[i].path;
+        }
+
+        str_buf_create(&str);
+        ASSERT_STREQ(json_from_record(&str, &columnar), "{\"small\":[1, null, 254], \"medium\":[255, null], "
+                     "\"signed\":[200, -1], \"wider\":[70000, -1], \"widest\":[-5, 3000000000], \"f\":[1.00, 1.50], "
+                     "\"b\":[true, null], \"mixed\":[true, 1], \"wide\":[-1, 10000000000000000000]}");
+        str_buf_drop(&str);
+        rec_drop(&columnar);
+        rec_drop(&plain);
+
+        /** the greatest and least values of a type that are not its null value are stored in columns of that type */
+        const char *bounds_in = "{\"ubyte\": [254, null], \"ushort\": [255, null], \"byte\": [-127, null], "
+                                "\"short\": [-128, null], \"ulong\": [18446744073709551614, null, 1], "
+                                "\"long\": [-9223372036854775807, null, 1]}";
+        struct { const char *path; field_e type; } bounds[] = {
+                { "ubyte", FIELD_COLUMN_U8_UNSORTED_MULTISET }, { "ushort", FIELD_COLUMN_U16_UNSORTED_MULTISET },
+                { "byte", FIELD_COLUMN_I8_UNSORTED_MULTISET }, { "short", FIELD_COLUMN_I16_UNSORTED_MULTISET },
+                { "ulong", FIELD_COLUMN_U64_UNSORTED_MULTISET }, { "long", FIELD_COLUMN_I64_UNSORTED_MULTISET }
+        };
+        ASSERT_TRUE(internal_from_json_stream(&columnar, bounds_in, KEY_NOKEY, NULL, OPTIMIZE));
+        for (size_t i = 0; i < sizeof(bounds) / sizeof(bounds[0]); i++) {
+                ASSERT_TRUE(find_from_string(&f, bounds[i].path, &columnar));
+                ASSERT_TRUE(find_result_type(&type, &f));
+                ASSERT_EQ(type, bounds[i].type) << bounds[i].path;
+        }
+        str_buf_create(&str);
+        ASSERT_STREQ(json_from_record(&str, &columnar), "{\"ubyte\":[254, null], \"ushort\":[255, null], "
+                     "\"byte\":[-127, null], \"short\":[-128, null], \"ulong\":[18446744073709551614, null, 1], "
+                     "\"long\":[-9223372036854775807, null, 1]}");
+        str_buf_drop(&str);
+        rec_drop(&columnar);
+
+        /** a long array takes less space as column, since columns have no per-value type markers */
+        std::string long_array = "{\"values\": [0";
+        for (unsigned i = 1; i < 1000; i++) {
+                long_array += ", " + std::to_string(i % 100);
+        }
+        long_array += "]}";
+        u64 columnar_len, plain_len;
+        ASSERT_TRUE(internal_from_json_stream(&columnar, long_array.c_str(), KEY_NOKEY, NULL, OPTIMIZE));
+        ASSERT_TRUE(internal_from_json_stream(&plain, long_array.c_str(), KEY_NOKEY, NULL, OPTIMIZE & ~COLUMNAR));
+        rec_raw_data(&columnar_len, &columnar);
+        rec_raw_data(&plain_len, &plain);
+        ASSERT_LT(columnar_len, plain_len);
+        rec_drop(&columnar);
+        rec_drop(&plain);
+}
 
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
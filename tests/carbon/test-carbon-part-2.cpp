@@ -623,6 +623,47 @@ TEST(CarbonTest, CarbonDotNotationParsing) {
         str_buf_drop(&sb);
 }
 
+TEST(CarbonTest, CarbonDotPathCache) {
+        dot_cache cache;
+        str_buf sb;
+        str_buf_create(&sb);
+        dot_cache_create(&cache, 4);
+
+        const dot *path = dot_cache_get(&cache, "23.authors.3.name");
+        ASSERT_TRUE(path != NULL);
+        ASSERT_EQ(path, dot_cache_get(&cache, "23.authors.3.name"));
+        dot_to_str(&sb, (dot *) path);
+        ASSERT_STREQ(str_buf_cstr(&sb), "23.authors.3.name");
+
+        u32 len;
+        ASSERT_STREQ(dot_nkey_at(&len, 1, path), "authors");
+        ASSERT_EQ(len, 7u);
+
+        /* the cache is bounded; evicted paths are compiled again on their next use */
+        char path_str[32];
+        for (u32 i = 0; i < 100; i++) {
+                snprintf(path_str, sizeof(path_str), "key%c.%u", 'a' + i % 26, i);
+                path = dot_cache_get(&cache, path_str);
+                str_buf_clear(&sb);
+                dot_to_str(&sb, (dot *) path);
+                ASSERT_STREQ(str_buf_cstr(&sb), path_str);
+        }
+
+        /* without a cache, paths are compiled on each use */
+        path = dot_cache_get(NULL, "23.authors.3.name");
+        ASSERT_TRUE(path != NULL);
+        str_buf_clear(&sb);
+        dot_to_str(&sb, (dot *) path);
+        ASSERT_STREQ(str_buf_cstr(&sb), "23.authors.3.name");
+        path = dot_cache_get(NULL, "keya.0");
+        str_buf_clear(&sb);
+        dot_to_str(&sb, (dot *) path);
+        ASSERT_STREQ(str_buf_cstr(&sb), "keya.0");
+
+        dot_cache_drop(&cache);
+        str_buf_drop(&sb);
+}
+
 TEST(CarbonTest, CarbonFind) {
         rec doc, rev_doc;
         rev revise;
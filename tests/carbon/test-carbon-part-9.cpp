@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 #include <printf.h>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <vector>
 
 #include <karbonit/karbonit.h>
 
@@ -427,6 +431,913 @@ TEST(CarbonTest, CommitHashStr) {
         str_buf_drop(&s);
 }
 
+TEST(CarbonTest, ProjectionMatchesFind) {
+        const char *json_in[] = {
+                "{\"a\": 1, \"b\": {\"c\": \"x\", \"d\": [1, 2, {\"e\": true}]}, \"a\": 2, \"f\": null}",
+                "[{\"x\":\"y\"},{\"x\":[{\"z\":42}]}, [1, 2, 3], 7]",
+                "[1, 2, 3]",
+                "{}",
+                "[]"
+        };
+        const char *paths[] = {
+                "a", "b", "b.c", "b.d", "b.d.1", "b.d.2.e", "b.d.7", "b.c.x", "f", "g", "b.x", "a",
+                "0", "0.a", "0.b.d.0", "0.x", "1.x.0.z", "1.x.z", "2.1", "2.5", "2.1.3", "3", "4", "x"
+        };
+        u32 num_paths = sizeof(paths) / sizeof(paths[0]);
+
+        projection proj;
+        projection_create(&proj);
+        for (u32 i = 0; i < num_paths; i++) {
+                u32 pos;
+                ASSERT_TRUE(projection_add_string(&pos, &proj, paths[i]));
+                ASSERT_EQ(pos, i);
+        }
+        ASSERT_EQ(projection_len(&proj), num_paths);
+
+        find *results = (find *) malloc(num_paths * sizeof(find));
+        str_buf expected, actual;
+        str_buf_create(&expected);
+        str_buf_create(&actual);
+
+        for (u32 j = 0; j < sizeof(json_in) / sizeof(json_in[0]); j++) {
+                rec doc;
+                rec_from_json(&doc, json_in[j], KEY_NOKEY, NULL);
+                bool all_resolved = projection_exec(results, &proj, &doc);
+
+                bool any_unresolved = false;
+                for (u32 i = 0; i < num_paths; i++) {
+                        find find;
+                        find_from_string(&find, paths[i], &doc);
+                        ASSERT_EQ(find_has_result(&results[i]), find_has_result(&find)) << json_in[j] << " " << paths[i];
+                        ASSERT_EQ(results[i].eval.status, find.eval.status) << json_in[j] << " " << paths[i];
+                        str_buf_clear(&expected);
+                        str_buf_clear(&actual);
+                        ASSERT_STREQ(find_result_to_str(&actual, &results[i]), find_result_to_str(&expected, &find));
+                        any_unresolved |= !find_has_result(&find);
+                }
+                ASSERT_EQ(all_resolved, !any_unresolved);
+                rec_drop(&doc);
+        }
+
+        free(results);
+        str_buf_drop(&expected);
+        str_buf_drop(&actual);
+        projection_drop(&proj);
+}
+
+TEST(CarbonTest, PathIndexMatchesFind) {
+        const char *json_in[] = {
+                "{\"a\": 1, \"b\": {\"c\": \"x\", \"d\": [1, 2, {\"e\": true}]}, \"a\": 2, \"f\": null}",
+                "[{\"x\":\"y\"},{\"x\":[{\"z\":42}]}, [1, 2, 3], 7]",
+                "[1, 2, 3]",
+                "{\"g\": [1, 2, 3], \"h\": [true, false, null]}",
+                "{}",
+                "[]"
+        };
+        const char *paths[] = {
+                "a", "b", "b.c", "b.d", "b.d.1", "b.d.2.e", "b.d.7", "b.c.x", "f", "g", "g.2", "g.3", "h.2", "b.x",
+                "0", "0.a", "0.b.d.0", "0.x", "1.x.0.z", "1.x.z", "2.1", "2.5", "2.1.3", "3", "4", "x"
+        };
+
+        str_buf expected, actual;
+        str_buf_create(&expected);
+        str_buf_create(&actual);
+
+        for (u32 j = 0; j < sizeof(json_in) / sizeof(json_in[0]); j++) {
+                rec doc;
+                pindex index;
+                rec_from_json(&doc, json_in[j], KEY_AUTOKEY, NULL);
+                pindex_create(&index, &doc);
+
+                for (u32 i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+                        find indexed, plain;
+                        const dot *path = dot_cache_get(dot_thread_cache(), paths[i]);
+                        find_from_dot_pindexed(&indexed, path, &doc, &index);
+                        find_from_dot(&plain, path, &doc);
+                        ASSERT_EQ(indexed.eval.status, plain.eval.status) << json_in[j] << " " << paths[i];
+                        str_buf_clear(&expected);
+                        str_buf_clear(&actual);
+                        ASSERT_STREQ(find_result_to_str(&actual, &indexed), find_result_to_str(&expected, &plain))
+                                << json_in[j] << " " << paths[i];
+                }
+
+                pindex_drop(&index);
+                rec_drop(&doc);
+        }
+
+        str_buf_drop(&expected);
+        str_buf_drop(&actual);
+}
+
+TEST(CarbonTest, PathIndexIgnoresOtherRecords) {
+        const char *json_in[][2] = {
+                { "[1, 2, 3]", "[\"x\", 2, 3]" },
+                { "{\"a\": 1, \"b\": [1, 2]}", "{\"c\": \"y\"}" },
+                { "{\"a\": [1, {\"b\": 2}]}", "[[1], 2]" }
+        };
+        const char *paths[] = { "0", "1", "2", "a", "b", "b.1", "c", "a.1.b", "0.0" };
+        key_e key_types[] = { KEY_NOKEY, KEY_AUTOKEY };
+
+        str_buf expected, actual;
+        str_buf_create(&expected);
+        str_buf_create(&actual);
+
+        for (u32 k = 0; k < sizeof(key_types) / sizeof(key_types[0]); k++) {
+                for (u32 j = 0; j < sizeof(json_in) / sizeof(json_in[0]); j++) {
+                        rec indexed_doc, doc, same_doc;
+                        pindex index;
+                        pindex_it it;
+                        rec_from_json(&indexed_doc, json_in[j][0], key_types[k], NULL);
+                        rec_from_json(&doc, json_in[j][1], key_types[k], NULL);
+                        pindex_create(&index, &indexed_doc);
+
+                        ASSERT_TRUE(pindex_indexes_doc(&index, &indexed_doc));
+                        ASSERT_FALSE(pindex_indexes_doc(&index, &doc)) << json_in[j][1];
+                        error_abort_disable();
+                        ASSERT_FALSE(pindex_it_open(&it, &index, &doc));
+                        error_abort_enable();
+
+                        /** a keyless record with the same contents is indexed by the index, too */
+                        rec_from_json(&same_doc, json_in[j][0], key_types[k], NULL);
+                        ASSERT_EQ(pindex_indexes_doc(&index, &same_doc), key_types[k] == KEY_NOKEY);
+                        rec_drop(&same_doc);
+
+                        for (u32 i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+                                find indexed, plain;
+                                const dot *path = dot_cache_get(dot_thread_cache(), paths[i]);
+                                find_from_dot_pindexed(&indexed, path, &doc, &index);
+                                find_from_dot(&plain, path, &doc);
+                                ASSERT_EQ(indexed.eval.status, plain.eval.status) << json_in[j][1] << " " << paths[i];
+                                str_buf_clear(&expected);
+                                str_buf_clear(&actual);
+                                ASSERT_STREQ(find_result_to_str(&actual, &indexed),
+                                             find_result_to_str(&expected, &plain)) << json_in[j][1] << " " << paths[i];
+                        }
+
+                        pindex_drop(&index);
+                        rec_drop(&doc);
+                        rec_drop(&indexed_doc);
+                }
+        }
+
+        str_buf_drop(&expected);
+        str_buf_drop(&actual);
+}
+
+TEST(CarbonTest, PathIndexObjectLookup) {
+        rec doc, rev_doc;
+        pindex index;
+        pindex_it it;
+        field_e type;
+        u64 name_len;
+
+        rec_from_json(&doc, "{\"a\": 1, \"b\": {\"c\": [4, \"x\", 6]}, \"a\": 2}", KEY_AUTOKEY, NULL);
+        pindex_create(&index, &doc);
+
+        ASSERT_TRUE(pindex_it_open(&it, &index, &doc));
+        ASSERT_TRUE(pindex_it_list_goto(0, &it));
+        ASSERT_TRUE(pindex_it_list_enter(&it));
+        ASSERT_TRUE(pindex_it_obj_goto("a", &it));
+        ASSERT_EQ(it.pos, 0U);
+        ASSERT_TRUE(pindex_it_obj_goto("b", &it));
+        const char *name = pindex_it_key_name(&name_len, &it);
+        ASSERT_EQ(std::string(name, name_len), "b");
+        ASSERT_FALSE(pindex_it_obj_goto("d", &it));
+        ASSERT_TRUE(pindex_it_obj_goto("b", &it));
+        ASSERT_TRUE(pindex_it_obj_enter(&it));
+        ASSERT_TRUE(pindex_it_obj_goto("c", &it));
+        ASSERT_TRUE(pindex_it_obj_enter(&it));
+        ASSERT_FALSE(pindex_it_list_goto(3, &it));
+        ASSERT_TRUE(pindex_it_list_goto(1, &it));
+        ASSERT_TRUE(pindex_type(&type, &it));
+        ASSERT_EQ(type, FIELD_STRING);
+        ASSERT_FALSE(pindex_it_list_can_enter(&it));
+
+        /* the first update of the revision is resolved with the index, the second one by traversing the record */
+        rev revise;
+        revise_begin_indexed(&revise, &rev_doc, &doc, &index);
+        ASSERT_TRUE(update_set_u8(&revise, "b.c.2", 7));
+        ASSERT_TRUE(revise.index == NULL);
+        ASSERT_TRUE(update_set_u8(&revise, "b.c.0", 5));
+        revise_end(&revise);
+        ASSERT_TRUE(pindex_indexes_doc(&index, &doc));
+        ASSERT_FALSE(pindex_indexes_doc(&index, &rev_doc));
+
+        find find;
+        find_from_string(&find, "b.c", &rev_doc);
+        str_buf str;
+        str_buf_create(&str);
+        ASSERT_STREQ(find_result_to_str(&str, &find), "[5, \"x\", 7]");
+
+        str_buf_drop(&str);
+        pindex_drop(&index);
+        rec_drop(&rev_doc);
+        rec_drop(&doc);
+}
+
+TEST(CarbonTest, PathIndexFile) {
+        rec doc, rev_doc;
+        pindex index, mapped, outdated;
+        rev revise;
+        find indexed, plain;
+        str_buf expected, actual;
+        char path[] = "/tmp/test-pindex-XXXXXX";
+
+        rec_from_json(&doc, "{\"a\": [1, \"x\", {\"b\": null}], \"c\": {\"d\": true}}", KEY_AUTOKEY, NULL);
+        pindex_create(&index, &doc);
+
+        int fd = mkstemp(path);
+        ASSERT_NE(fd, -1);
+        close(fd);
+        ASSERT_TRUE(pindex_to_file(path, &index));
+        ASSERT_TRUE(pindex_from_file(&mapped, path, &doc));
+        ASSERT_TRUE(MEMBLOCK_IS_MAPPED(mapped.memblock));
+
+        u64 len, mapped_len;
+        const void *raw = pindex_raw_data(&len, &index);
+        const void *mapped_raw = pindex_raw_data(&mapped_len, &mapped);
+        ASSERT_EQ(len, mapped_len);
+        ASSERT_EQ(memcmp(raw, mapped_raw, len), 0);
+
+        str_buf_create(&expected);
+        str_buf_create(&actual);
+        const char *paths[] = { "a.2.b", "a.1", "c.d", "c.e" };
+        for (u32 i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+                const dot *dot = dot_cache_get(dot_thread_cache(), paths[i]);
+                find_from_dot_pindexed(&indexed, dot, &doc, &mapped);
+                find_from_dot(&plain, dot, &doc);
+                ASSERT_EQ(indexed.eval.status, plain.eval.status) << paths[i];
+                ASSERT_STREQ(find_result_to_str(&actual, &indexed), find_result_to_str(&expected, &plain)) << paths[i];
+        }
+
+        /* an index file is not opened for another revision of the record */
+        revise_begin(&revise, &rev_doc, &doc);
+        revise_remove("a.0", &revise);
+        revise_end(&revise);
+        error_abort_disable();
+        ASSERT_FALSE(pindex_from_file(&outdated, path, &rev_doc));
+        error_abort_enable();
+
+        /* an index file of a record without key is opened only for a record with the same contents */
+        rec keyless, same, other;
+        pindex keyless_index, keyless_mapped;
+        rec_from_json(&keyless, "[1, 2, 3]", KEY_NOKEY, NULL);
+        rec_from_json(&same, "[1, 2, 3]", KEY_NOKEY, NULL);
+        rec_from_json(&other, "[\"x\", 2, 3]", KEY_NOKEY, NULL);
+        pindex_create(&keyless_index, &keyless);
+        ASSERT_TRUE(pindex_to_file(path, &keyless_index));
+        ASSERT_TRUE(pindex_from_file(&keyless_mapped, path, &same));
+        error_abort_disable();
+        ASSERT_FALSE(pindex_from_file(&outdated, path, &other));
+        error_abort_enable();
+        pindex_drop(&keyless_mapped);
+        pindex_drop(&keyless_index);
+        rec_drop(&other);
+        rec_drop(&same);
+        rec_drop(&keyless);
+
+        unlink(path);
+        str_buf_drop(&expected);
+        str_buf_drop(&actual);
+        pindex_drop(&mapped);
+        pindex_drop(&index);
+        rec_drop(&rev_doc);
+        rec_drop(&doc);
+}
+
+TEST(CarbonTest, SkipIndexSeek) {
+        std::string json = "{\"items\": [";
+        for (int i = 0; i < 1000; i++) {
+                json += (i ? ", " : "") + (i % 3 ? std::to_string(i) : "{\"id\": " + std::to_string(i) + ", \"x\": [1, 2]}");
+        }
+        json += "], \"small\": [\"a\", {}, 3]}";
+
+        rec doc;
+        rec_from_json(&doc, json.c_str(), KEY_AUTOKEY, NULL);
+
+        skip_index index;
+        skip_index_create(&index, &doc, 16, 100);
+        ASSERT_TRUE(skip_index_indexes_doc(&index, &doc));
+
+        str_buf expected, actual;
+        str_buf_create(&expected);
+        str_buf_create(&actual);
+        dot path;
+        char path_str[32];
+        for (u32 i = 0; i < 1010; i += 7) {
+                snprintf(path_str, sizeof(path_str), "items.%u", i);
+                dot_from_string(&path, path_str);
+                find indexed, plain;
+                ASSERT_EQ(find_from_dot_indexed(&indexed, &path, &doc, &index), i < 1000);
+                find_from_dot(&plain, &path, &doc);
+                str_buf_clear(&expected);
+                str_buf_clear(&actual);
+                ASSERT_STREQ(find_result_to_str(&actual, &indexed), find_result_to_str(&expected, &plain));
+                dot_drop(&path);
+        }
+
+        /* seeking backwards and forwards within the same array */
+        find items;
+        find_from_string(&items, "items", &doc);
+        arr_it *it = find_result_array(&items);
+        const arr_skip *skip = skip_index_get(&index, it->begin);
+        ASSERT_TRUE(skip != NULL);
+        ASSERT_EQ(skip->len, 1000u);
+        ASSERT_TRUE(arr_it_seek(it, 997, skip) != NULL);
+        ASSERT_TRUE(arr_it_next(it) != NULL);
+        ASSERT_EQ(ITEM_GET_NUMBER_UNSIGNED(&it->item, 0), 998u);
+        ASSERT_TRUE(arr_it_seek(it, 17, skip) != NULL);
+        ASSERT_EQ(ITEM_GET_NUMBER_UNSIGNED(&it->item, 0), 17u);
+        ASSERT_TRUE(arr_it_seek(it, 1000, skip) == NULL);
+
+        /* arrays shorter than the minimum length are not indexed */
+        find_from_string(&items, "small", &doc);
+        ASSERT_TRUE(skip_index_get(&index, find_result_array(&items)->begin) == NULL);
+
+        /* an index does not apply to other revisions */
+        rec rev_doc;
+        rev revise;
+        revise_begin(&revise, &rev_doc, &doc);
+        revise_end(&revise);
+        ASSERT_FALSE(skip_index_indexes_doc(&index, &rev_doc));
+        skip_index_update(&index, &rev_doc);
+        ASSERT_TRUE(skip_index_indexes_doc(&index, &rev_doc));
+
+        str_buf_drop(&expected);
+        str_buf_drop(&actual);
+        skip_index_drop(&index);
+        rec_drop(&doc);
+        rec_drop(&rev_doc);
+}
+
+TEST(CarbonTest, SkipIndexIgnoresOtherKeylessRecords) {
+        std::string indexed_json = "[", other_json = "[";
+        for (int i = 0; i < 300; i++) {
+                indexed_json += (i ? ", \"a" : "\"a") + std::to_string(i) + "\"";
+                other_json += (i ? ", \"bbbbbbbbbbbbbbbbbbbb" : "\"bbbbbbbbbbbbbbbbbbbb") + std::to_string(i) + "\"";
+        }
+        indexed_json += "]";
+        other_json += "]";
+
+        rec indexed_doc, doc, rev_doc;
+        rec_from_json(&indexed_doc, indexed_json.c_str(), KEY_NOKEY, NULL);
+        rec_from_json(&doc, other_json.c_str(), KEY_NOKEY, NULL);
+
+        skip_index index;
+        skip_index_create(&index, &indexed_doc, 16, 100);
+        ASSERT_TRUE(skip_index_indexes_doc(&index, &indexed_doc));
+        ASSERT_FALSE(skip_index_indexes_doc(&index, &doc));
+
+        /* finds in another keyless record do not use the index */
+        str_buf expected, actual;
+        str_buf_create(&expected);
+        str_buf_create(&actual);
+        find indexed, plain;
+        const dot *path = dot_cache_get(dot_thread_cache(), "150");
+        ASSERT_TRUE(find_from_dot_indexed(&indexed, path, &doc, &index));
+        find_from_dot(&plain, path, &doc);
+        ASSERT_STREQ(find_result_to_str(&actual, &indexed), find_result_to_str(&expected, &plain));
+        ASSERT_STREQ(str_buf_cstr(&actual), "\"bbbbbbbbbbbbbbbbbbbb150\"");
+
+        /* a revised keyless record is indexed anew */
+        rev revise;
+        revise_begin(&revise, &rev_doc, &indexed_doc);
+        update_set_null(&revise, "0");
+        revise_end(&revise);
+        ASSERT_FALSE(skip_index_indexes_doc(&index, &rev_doc));
+        skip_index_update(&index, &rev_doc);
+        ASSERT_TRUE(skip_index_indexes_doc(&index, &rev_doc));
+        str_buf_clear(&expected);
+        str_buf_clear(&actual);
+        ASSERT_TRUE(find_from_dot_indexed(&indexed, path, &rev_doc, &index));
+        ASSERT_STREQ(find_result_to_str(&actual, &indexed), "\"a150\"");
+
+        str_buf_drop(&expected);
+        str_buf_drop(&actual);
+        skip_index_drop(&index);
+        rec_drop(&indexed_doc);
+        rec_drop(&doc);
+        rec_drop(&rev_doc);
+}
+
+TEST(CarbonTest, BatchUpdateMatchesSingleUpdates) {
+        rec doc, rev_batch, rev_single;
+        update_batch batch;
+        str_buf batch_str, single_str;
+        u64 hash, rev_hash;
+
+        rec_from_json(&doc, "[1, 300, true, null, [1, 2, \"x\"], {\"c\": [4, 5]}, 1.5]", KEY_AUTOKEY, NULL);
+
+        update_batch_create(&batch);
+        ASSERT_TRUE(update_batch_set_unsigned(&batch, "0", 7));
+        ASSERT_TRUE(update_batch_set_unsigned(&batch, "1", 70000));
+        ASSERT_TRUE(update_batch_set_false(&batch, "2"));
+        ASSERT_TRUE(update_batch_set_signed(&batch, "3", -5));
+        ASSERT_TRUE(update_batch_set_unsigned(&batch, "4.1", 8));
+        ASSERT_TRUE(update_batch_set_true(&batch, "4.2"));
+        ASSERT_TRUE(update_batch_set_null(&batch, "5.c.1"));
+        ASSERT_TRUE(update_batch_set_float(&batch, "6", 2.5));
+        ASSERT_TRUE(update_batch_set_unsigned(&batch, "4.1", 9));
+        ASSERT_EQ(update_batch_len(&batch), 9u);
+
+        ASSERT_TRUE(update_one_batch(&batch, &rev_batch, &doc));
+
+        rev revise;
+        revise_begin(&revise, &rev_single, &doc);
+        update_set_unsigned(&revise, "0", 7);
+        update_set_unsigned(&revise, "1", 70000);
+        update_set_false(&revise, "2");
+        update_set_signed(&revise, "3", -5);
+        update_set_unsigned(&revise, "4.1", 9);
+        update_set_true(&revise, "4.2");
+        update_set_null(&revise, "5.c.1");
+        update_set_float(&revise, "6", 2.5);
+        revise_end(&revise);
+
+        str_buf_create(&batch_str);
+        str_buf_create(&single_str);
+        ASSERT_STREQ(rec_to_json(&batch_str, &rev_batch), rec_to_json(&single_str, &rev_single));
+        ASSERT_TRUE(strstr(str_buf_cstr(&batch_str), "[7, 70000, false, -5, [1, 9, true], {\"c\":[4, null]}, 2.50]"));
+
+        /* the batch is committed once, and leaves the original record untouched */
+        rec_commit_hash(&hash, &doc);
+        rec_commit_hash(&rev_hash, &rev_batch);
+        ASSERT_NE(hash, rev_hash);
+        ASSERT_TRUE(strstr(rec_to_json(&batch_str, &doc), "[1, 300, true, null, [1, 2, \"x\"], {\"c\":[4, 5]}, 1.50]"));
+        update_batch_drop(&batch);
+        rec_drop(&doc);
+        rec_drop(&rev_batch);
+        rec_drop(&rev_single);
+
+        /* updates of sorted columns move values, such that they are not written in place */
+        rec_new context;
+        col_state column;
+        insert *ins = rec_create_begin(&context, &doc, KEY_AUTOKEY, KEEP);
+        insert *values = insert_column_list_begin(&column, ins, LIST_SORTED_SET, COLUMN_U32, 4);
+        for (u32 value : { 1, 3, 5, 7 }) {
+                insert_u32(values, value);
+        }
+        insert_column_list_end(&column);
+        rec_create_end(&context);
+
+        update_batch_create(&batch);
+        ASSERT_TRUE(update_batch_set_null(&batch, "0.0"));
+        ASSERT_TRUE(update_batch_set_null(&batch, "0.1"));
+        ASSERT_TRUE(update_batch_set_null(&batch, "0.2"));
+        ASSERT_TRUE(update_one_batch(&batch, &rev_batch, &doc));
+
+        revise_begin(&revise, &rev_single, &doc);
+        update_set_null(&revise, "0.0");
+        update_set_null(&revise, "0.1");
+        update_set_null(&revise, "0.2");
+        revise_end(&revise);
+
+        ASSERT_STREQ(rec_to_json(&batch_str, &rev_batch), rec_to_json(&single_str, &rev_single));
+        ASSERT_TRUE(strstr(str_buf_cstr(&batch_str), "[3, 7, null]"));
+
+        str_buf_drop(&batch_str);
+        str_buf_drop(&single_str);
+        update_batch_drop(&batch);
+        rec_drop(&doc);
+        rec_drop(&rev_batch);
+        rec_drop(&rev_single);
+}
+
+TEST(CarbonTest, BatchUpdateKeepsOrderOfOverlappingPaths) {
+        const char *json_in[] = { "[[true, 1], 2]", "[[false, \"x\"], 2]" };
+        str_buf batch_str, single_str;
+        str_buf_create(&batch_str);
+        str_buf_create(&single_str);
+
+        for (u32 i = 0; i < sizeof(json_in) / sizeof(json_in[0]); i++) {
+                rec doc, rev_batch, rev_single;
+                update_batch batch;
+                rev revise;
+                rec_from_json(&doc, json_in[i], KEY_AUTOKEY, NULL);
+
+                /* the element "0.0" no longer exists once "0" is null */
+                update_batch_create(&batch);
+                update_batch_set_unsigned(&batch, "1", 3);
+                update_batch_set_null(&batch, "0");
+                update_batch_set_false(&batch, "0.0");
+
+                error_abort_disable();
+                bool batch_status = update_one_batch(&batch, &rev_batch, &doc);
+                revise_begin(&revise, &rev_single, &doc);
+                bool single_status = update_set_unsigned(&revise, "1", 3);
+                single_status &= update_set_null(&revise, "0");
+                single_status &= update_set_false(&revise, "0.0");
+                revise_end(&revise);
+                error_abort_enable();
+
+                ASSERT_EQ(batch_status, single_status) << json_in[i];
+                ASSERT_STREQ(rec_to_json(&batch_str, &rev_batch), rec_to_json(&single_str, &rev_single));
+                ASSERT_TRUE(strstr(str_buf_cstr(&batch_str), "[null, 3]")) << str_buf_cstr(&batch_str);
+
+                update_batch_drop(&batch);
+                rec_drop(&doc);
+                rec_drop(&rev_batch);
+                rec_drop(&rev_single);
+        }
+
+        /* a boolean in a column is set to false as update_set_false does, rather than in place */
+        rec doc, rev_batch, rev_single;
+        update_batch batch;
+        rev revise;
+        rec_from_json(&doc, "{\"c\": [true, true]}", KEY_AUTOKEY, NULL);
+        update_batch_create(&batch);
+        update_batch_set_true(&batch, "c.1");
+        update_batch_set_false(&batch, "c.0");
+        error_abort_disable();
+        bool batch_status = update_one_batch(&batch, &rev_batch, &doc);
+        revise_begin(&revise, &rev_single, &doc);
+        bool single_status = update_set_true(&revise, "c.1");
+        single_status &= update_set_false(&revise, "c.0");
+        revise_end(&revise);
+        error_abort_enable();
+        ASSERT_EQ(batch_status, single_status);
+        ASSERT_STREQ(rec_to_json(&batch_str, &rev_batch), rec_to_json(&single_str, &rev_single));
+
+        update_batch_drop(&batch);
+        rec_drop(&doc);
+        rec_drop(&rev_batch);
+        rec_drop(&rev_single);
+        str_buf_drop(&batch_str);
+        str_buf_drop(&single_str);
+}
+
+TEST(CarbonTest, DeltaReproducesRevision) {
+        rec doc, rev_doc, applied, other;
+        vec ofType(u8) delta;
+        str_buf expected, actual;
+        u64 rev_len, applied_len, rev_hash, applied_hash;
+
+        std::string json = "[";
+        for (unsigned i = 0; i < 1000; i++) {
+                json += (i ? ", " : "") + std::to_string(i % 200);
+        }
+        json += ", {\"name\": \"text\", \"tags\": [1, 2, 3]}]";
+        rec_from_json(&doc, json.c_str(), KEY_AUTOKEY, NULL);
+
+        /* a field of the same width, and a field of larger width that moves all bytes behind it */
+        rev revise;
+        revise_begin(&revise, &rev_doc, &doc);
+        ASSERT_TRUE(update_set_unsigned(&revise, "10", 7));
+        ASSERT_TRUE(update_set_unsigned(&revise, "500", 70000));
+        revise_end(&revise);
+
+        ASSERT_TRUE(delta_create(&delta, &doc, &rev_doc));
+        rec_raw_data(&rev_len, &rev_doc);
+        ASSERT_LT(VEC_LENGTH(&delta) * 10, rev_len);
+
+        ASSERT_TRUE(delta_apply(&applied, &doc, vec_data(&delta), VEC_LENGTH(&delta)));
+        const void *applied_data = rec_raw_data(&applied_len, &applied);
+        ASSERT_EQ(applied_len, rev_len);
+        ASSERT_EQ(memcmp(applied_data, rec_raw_data(&rev_len, &rev_doc), rev_len), 0);
+        rec_commit_hash(&rev_hash, &rev_doc);
+        rec_commit_hash(&applied_hash, &applied);
+        ASSERT_EQ(applied_hash, rev_hash);
+        str_buf_create(&expected);
+        str_buf_create(&actual);
+        ASSERT_STREQ(rec_to_json(&actual, &applied), rec_to_json(&expected, &rev_doc));
+
+        /* a delta applies only to the record for which it was computed, and must not be corrupted */
+        rec_from_json(&other, "[1, 2, 3]", KEY_AUTOKEY, NULL);
+        error_abort_disable();
+        ASSERT_FALSE(delta_apply(&applied, &other, vec_data(&delta), VEC_LENGTH(&delta)));
+        ASSERT_FALSE(delta_apply(&applied, &doc, vec_data(&delta), VEC_LENGTH(&delta) - 1));
+        error_abort_enable();
+
+        /* a revised length that the operations of the delta do not produce is refused before anything is allocated */
+        vec ofType(u8) forged;
+        u8 huge_len[] = { 0x81, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00 };
+        vec_create(&forged, sizeof(u8), VEC_LENGTH(&delta));
+        vec_push(&forged, vec_data(&delta), 3 * sizeof(u64));
+        vec_push(&forged, huge_len, sizeof(huge_len));
+        error_abort_disable();
+        ASSERT_FALSE(delta_apply(&applied, &doc, vec_data(&forged), VEC_LENGTH(&forged)));
+        error_abort_enable();
+        vec_drop(&forged);
+
+        str_buf_drop(&expected);
+        str_buf_drop(&actual);
+        vec_drop(&delta);
+        rec_drop(&other);
+        rec_drop(&applied);
+        rec_drop(&rev_doc);
+        rec_drop(&doc);
+}
+
+static void epoch_test_drop(void *ptr)
+{
+        (*(int *) ptr)++;
+}
+
+TEST(CarbonTest, EpochDefersDropUntilReadersLeave) {
+        epoch reclaim;
+        int drops = 0;
+        epoch_create(&reclaim);
+        epoch_reader *reader = epoch_register(&reclaim);
+        epoch_reader *other = epoch_register(&reclaim);
+        ASSERT_NE(reader, other);
+
+        /* objects retired while a reader is in a critical section outlive the critical section */
+        epoch_enter(reader);
+        epoch_retire(&reclaim, &drops, epoch_test_drop);
+        for (int i = 0; i < 5; i++) {
+                ASSERT_EQ(epoch_collect(&reclaim), 1u);
+        }
+        ASSERT_EQ(drops, 0);
+        epoch_leave(reader);
+        epoch_collect(&reclaim);
+        ASSERT_EQ(epoch_collect(&reclaim), 0u);
+        ASSERT_EQ(drops, 1);
+
+        /* readers that enter later do not delay objects retired before */
+        epoch_retire(&reclaim, &drops, epoch_test_drop);
+        epoch_collect(&reclaim);
+        epoch_enter(other);
+        epoch_collect(&reclaim);
+        ASSERT_EQ(drops, 2);
+        epoch_leave(other);
+
+        /* unregistered readers are reused, and pending objects are dropped with the epoch */
+        epoch_unregister(other);
+        ASSERT_EQ(epoch_register(&reclaim), other);
+        epoch_retire(&reclaim, &drops, epoch_test_drop);
+        epoch_drop(&reclaim);
+        ASSERT_EQ(drops, 3);
+}
+
+static void store_test_record(rec *doc, key_e type, const void *key, const char *json)
+{
+        rec tmp;
+        rev revise;
+        rec_from_json(&tmp, json, type, NULL);
+        revise_begin(&revise, doc, &tmp);
+        if (type == KEY_SKEY) {
+                revise_key_set_string(&revise, (const char *) key);
+        } else {
+                revise_key_set_unsigned(&revise, *(const u64 *) key);
+        }
+        revise_end(&revise);
+        rec_drop(&tmp);
+}
+
+static std::string store_test_json(rec *view)
+{
+        str_buf buf;
+        str_buf_create(&buf);
+        std::string result = rec_to_json(&buf, view);
+        str_buf_drop(&buf);
+        return result;
+}
+
+TEST(CarbonTest, StoreLookupsScansAndRevisions) {
+        store records;
+        rec doc, view, old_view, revised;
+        store_it it;
+        u64 key;
+
+        ASSERT_TRUE(store_create(&records, KEY_UKEY));
+        for (u64 i = 0; i < 500; i++) {
+                store_test_record(&doc, KEY_UKEY, &i, ("[" + std::to_string(i) + ", \"v\"]").c_str());
+                ASSERT_TRUE(store_put(&records, &doc));
+        }
+        ASSERT_EQ(store_len(&records), 500u);
+        ASSERT_TRUE(store_get_unsigned(&view, &records, 42));
+        rec_key_unsigned_value(&key, &view);
+        ASSERT_EQ(key, 42u);
+        std::string expected = store_test_json(&view);
+        ASSERT_NE(expected.find("[42, "), std::string::npos);
+        ASSERT_FALSE(store_get_unsigned(&view, &records, 500));
+
+        /* a view stays valid after its record is replaced, until the reader leaves its critical section */
+        epoch_reader *self = epoch_register(&records.reclaim);
+        epoch_enter(self);
+        ASSERT_TRUE(store_get_unsigned(&old_view, &records, 42));
+        key = 42;
+        store_test_record(&doc, KEY_UKEY, &key, "[\"replaced\", \"v\"]");
+        ASSERT_TRUE(store_put(&records, &doc));
+        ASSERT_EQ(store_len(&records), 500u);
+        store_reclaim(&records);
+        store_reclaim(&records);
+        ASSERT_EQ(store_test_json(&old_view), expected);
+        epoch_leave(self);
+        ASSERT_TRUE(store_get_unsigned(&view, &records, 42));
+        ASSERT_NE(store_test_json(&view).find("replaced"), std::string::npos);
+
+        ASSERT_TRUE(store_remove_unsigned(&records, 50));
+        ASSERT_FALSE(store_remove_unsigned(&records, 50));
+        ASSERT_FALSE(store_get_unsigned(&view, &records, 50));
+        ASSERT_EQ(store_len(&records), 499u);
+        store_reclaim(&records);
+        ASSERT_EQ(store_reclaim(&records), 0u);
+
+        /* scans are ordered, inclusive, and skip removed keys */
+        std::vector<u64> keys;
+        store_scan_unsigned(&it, &records, 45, 55);
+        while (store_it_next(&view, &it)) {
+                rec_key_unsigned_value(&key, &view);
+                keys.push_back(key);
+        }
+        ASSERT_EQ(keys, std::vector<u64>({45, 46, 47, 48, 49, 51, 52, 53, 54, 55}));
+
+        /* a revision through the store replaces the record, and leaves the view of the original untouched */
+        rev revise;
+        ASSERT_TRUE(store_get_unsigned(&view, &records, 7));
+        store_revise_begin(&revise, &revised, &view);
+        ASSERT_TRUE(update_set_unsigned(&revise, "0", 700));
+        ASSERT_TRUE(store_revise_end(&records, &revise));
+        ASSERT_NE(store_test_json(&view).find("[7, "), std::string::npos);
+        ASSERT_TRUE(store_get_unsigned(&view, &records, 7));
+        ASSERT_NE(store_test_json(&view).find("[700, "), std::string::npos);
+
+        /* readers run concurrently to the writer, and always see complete records */
+        std::atomic<bool> done(false);
+        std::atomic<u64> reads(0), broken(0);
+        std::thread reader([&]() {
+                rec reader_view;
+                u64 reader_key;
+                epoch_reader *reader_self = epoch_register(&records.reclaim);
+                for (u64 i = 0; !done.load() || i < 1000; i++) {
+                        epoch_enter(reader_self);
+                        if (store_get_unsigned(&reader_view, &records, i % 500)) {
+                                rec_key_unsigned_value(&reader_key, &reader_view);
+                                bool complete = store_test_json(&reader_view).find("\"v\"]") != std::string::npos;
+                                (reader_key == i % 500 && complete ? reads : broken)++;
+                        }
+                        epoch_leave(reader_self);
+                }
+                epoch_unregister(reader_self);
+        });
+        for (u64 i = 500; i < 2000; i++) {
+                key = i % 700;
+                store_test_record(&doc, KEY_UKEY, &key, ("[" + std::to_string(i) + ", \"v\"]").c_str());
+                store_put(&records, &doc);
+                if (i % 3 == 0) {
+                        store_remove_unsigned(&records, (i * 7) % 700);
+                }
+        }
+        done = true;
+        reader.join();
+        ASSERT_GT(reads.load(), 0u);
+        ASSERT_EQ(broken.load(), 0u);
+        store_reclaim(&records);
+        ASSERT_EQ(store_reclaim(&records), 0u);
+        store_drop(&records);
+
+        /* string keys are ordered bytewise, and unbounded scans cover the whole store */
+        const char *names[] = { "carol", "alice", "bob", "dave" };
+        ASSERT_TRUE(store_create(&records, KEY_SKEY));
+        for (const char *name : names) {
+                store_test_record(&doc, KEY_SKEY, name, "[1, 2, 3]");
+                ASSERT_TRUE(store_put(&records, &doc));
+        }
+        std::vector<std::string> ordered;
+        store_scan_string(&it, &records, "b", NULL);
+        while (store_it_next(&view, &it)) {
+                u64 len;
+                const char *name = key_string_value(&len, &view);
+                ordered.push_back(std::string(name, len));
+        }
+        ASSERT_EQ(ordered, std::vector<std::string>({"bob", "carol", "dave"}));
+        ASSERT_TRUE(store_get_string(&view, &records, "alice"));
+
+        rec_from_json(&doc, "[1]", KEY_UKEY, NULL);
+        error_abort_disable();
+        ASSERT_FALSE(store_put(&records, &doc));
+        error_abort_enable();
+
+        /* a failed revision drops the revised record, and leaves the store unchanged */
+        store_revise_begin(&revise, &revised, &doc);
+        error_abort_disable();
+        ASSERT_FALSE(store_revise_end(&records, &revise));
+        error_abort_enable();
+        ASSERT_EQ(store_len(&records), 4u);
+        rec_drop(&doc);
+        store_drop(&records);
+}
+
+static u64 handle_test_counter(rec *view)
+{
+        find counter;
+        u64 value = 0;
+        find_from_string(&counter, "0", view);
+        find_result_unsigned(&value, &counter);
+        return value;
+}
+
+TEST(CarbonTest, HandlePublishesRevisionsAtomically) {
+        handle shared;
+        rec doc, snapshot, fresh, revised, stale;
+        rev revise, stale_revise;
+
+        u64 snapshot_hash, fresh_hash;
+
+        rec_from_json(&doc, "[0, \"counter\"]", KEY_AUTOKEY, NULL);
+        handle_create(&shared, &doc);
+        epoch_reader *self = epoch_register(&shared.reclaim);
+
+        /* a published revision replaces the record for new snapshots only, and conflicts with stale revisions */
+        epoch_enter(self);
+        handle_snapshot(&snapshot, &shared);
+        rec_commit_hash(&snapshot_hash, &snapshot);
+        revise_begin_copy(&revise, &revised, &snapshot);
+        revise_begin_copy(&stale_revise, &stale, &snapshot);
+        ASSERT_TRUE(update_set_unsigned(&revise, "0", 1));
+        ASSERT_TRUE(update_set_unsigned(&stale_revise, "0", 2));
+        ASSERT_TRUE(handle_revise_end(&shared, &revise));
+        revise_end(&stale_revise);
+        ASSERT_FALSE(handle_publish(&shared, &stale, snapshot_hash));
+        rec_drop(&stale);
+        handle_snapshot(&fresh, &shared);
+        rec_commit_hash(&fresh_hash, &fresh);
+        ASSERT_NE(fresh_hash, snapshot_hash);
+        ASSERT_EQ(handle_test_counter(&snapshot), 0u);
+        ASSERT_EQ(handle_test_counter(&fresh), 1u);
+        epoch_leave(self);
+
+        /* records without primary key have no commit hash to detect conflicts, so publishing them by hash is refused */
+        handle keyless;
+        rec keyless_doc;
+        rec_from_json(&keyless_doc, "[0, \"counter\"]", KEY_NOKEY, NULL);
+        handle_create(&keyless, &keyless_doc);
+        epoch_reader *keyless_self = epoch_register(&keyless.reclaim);
+        epoch_enter(keyless_self);
+        handle_snapshot(&snapshot, &keyless);
+        rec_commit_hash(&snapshot_hash, &snapshot);
+        revise_begin_copy(&revise, &revised, &snapshot);
+        revise_begin_copy(&stale_revise, &stale, &snapshot);
+        ASSERT_TRUE(update_set_unsigned(&revise, "0", 1));
+        ASSERT_TRUE(update_set_unsigned(&stale_revise, "0", 2));
+        ASSERT_TRUE(handle_revise_end(&keyless, &revise));
+        revise_end(&stale_revise);
+        error_abort_disable();
+        ASSERT_FALSE(handle_publish(&keyless, &stale, snapshot_hash));
+        error_abort_enable();
+        rec_drop(&stale);
+        handle_snapshot(&fresh, &keyless);
+        ASSERT_EQ(handle_test_counter(&fresh), 1u);
+        epoch_leave(keyless_self);
+        epoch_unregister(keyless_self);
+        handle_drop(&keyless);
+
+        /* concurrent writers retry on conflicts such that no increment is lost, while readers see increments only */
+        const u64 num_writers = 4, num_increments = 200;
+        std::atomic<bool> done(false);
+        std::atomic<u64> decreasing(0);
+        std::thread reader([&]() {
+                epoch_reader *reader_self = epoch_register(&shared.reclaim);
+                rec view;
+                u64 last = 0;
+                while (!done.load()) {
+                        epoch_enter(reader_self);
+                        handle_snapshot(&view, &shared);
+                        u64 value = handle_test_counter(&view);
+                        decreasing += value < last;
+                        last = value;
+                        epoch_leave(reader_self);
+                }
+                epoch_unregister(reader_self);
+        });
+        std::vector<std::thread> writers;
+        for (u64 i = 0; i < num_writers; i++) {
+                writers.emplace_back([&]() {
+                        epoch_reader *writer_self = epoch_register(&shared.reclaim);
+                        for (u64 j = 0; j < num_increments; j++) {
+                                bool published;
+                                do {
+                                        rec view, next;
+                                        rev context;
+                                        epoch_enter(writer_self);
+                                        handle_snapshot(&view, &shared);
+                                        revise_begin_copy(&context, &next, &view);
+                                        update_set_unsigned(&context, "0", handle_test_counter(&view) + 1);
+                                        published = handle_revise_end(&shared, &context);
+                                        if (!published) {
+                                                rec_drop(&next);
+                                        }
+                                        epoch_leave(writer_self);
+                                } while (!published);
+                        }
+                        epoch_unregister(writer_self);
+                });
+        }
+        for (auto &writer : writers) {
+                writer.join();
+        }
+        done = true;
+        reader.join();
+
+        epoch_enter(self);
+        handle_snapshot(&fresh, &shared);
+        ASSERT_EQ(handle_test_counter(&fresh), 1 + num_writers * num_increments);
+        epoch_leave(self);
+        ASSERT_EQ(decreasing.load(), 0u);
+        handle_drop(&shared);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
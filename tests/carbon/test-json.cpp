@@ -2,6 +2,7 @@
 #include <printf.h>
 #include <sys/stat.h>
 #include <fcntl.h>
+#include <string>
 
 #include <karbonit/karbonit.h>
 
@@ -914,6 +915,38 @@ TEST(JsonTest, ParseRandomJson)
         json_drop(&json);
 }
 
+TEST(JsonTest, TokenizeAcrossIndexBlocks)
+{
+        /* strings and blanks that span several of the blocks the tokenizer indexes at once */
+        std::string long_string(150, 'x');
+        std::string blanks(130, ' ');
+        std::string json_in = "{\"" + long_string + "\":" + blanks + "\"a\\\"b\\\\\",\t\v\f\r\n \"c\\\\\\\\\\\"d\", " +
+                              "\"e\\\\\\\\\" : [true, false, null]}";
+        struct {
+                json_token_e type;
+                unsigned line;
+                unsigned length;
+        } expected[] = {
+                { OBJECT_OPEN, 1, 1 }, { LITERAL_STRING, 1, 150 }, { ASSIGN, 1, 1 }, { LITERAL_STRING, 1, 6 },
+                { COMMA, 1, 1 }, { LITERAL_STRING, 2, 8 }, { COMMA, 2, 1 }, { LITERAL_STRING, 2, 5 }, { ASSIGN, 2, 1 },
+                { ARRAY_OPEN, 2, 1 }, { LITERAL_TRUE, 2, 4 }, { COMMA, 2, 1 }, { LITERAL_FALSE, 2, 5 },
+                { COMMA, 2, 1 }, { LITERAL_NULL, 2, 4 }, { ARRAY_CLOSE, 2, 1 }, { OBJECT_CLOSE, 2, 1 }
+        };
+
+        json_tokenizer tokenizer;
+        const json_token *token;
+        size_t num_tokens = 0;
+        json_tokenizer_init(&tokenizer, json_in.c_str());
+        while ((token = json_tokenizer_next(&tokenizer))) {
+                ASSERT_LT(num_tokens, sizeof(expected) / sizeof(expected[0]));
+                ASSERT_EQ(token->type, expected[num_tokens].type) << num_tokens;
+                ASSERT_EQ(token->line, expected[num_tokens].line) << num_tokens;
+                ASSERT_EQ(token->length, expected[num_tokens].length) << num_tokens;
+                num_tokens++;
+        }
+        ASSERT_EQ(num_tokens, sizeof(expected) / sizeof(expected[0]));
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,515 @@
+#include <gtest/gtest.h>
+#include <dirent.h>
+#include <string>
+
+#include <karbonit/karbonit.h>
+
+TEST(TestMemblock, GeometricGrowthKeepsLogicalSize) {
+        memblock *block;
+        MEMBLOCK_CREATE(&block, 16);
+
+        ASSERT_EQ(block->growth, MEMBLOCK_GROWTH_GEOMETRIC);
+        ASSERT_EQ(MEMBLOCK_CAPACITY(block), 16u);
+
+        MEMBLOCK_RESIZE(block, 17);
+
+        offset_t size;
+        MEMBLOCK_SIZE(&size, block);
+        ASSERT_EQ(size, 17u);
+        ASSERT_GE(MEMBLOCK_CAPACITY(block), (offset_t) (16 * MEMBLOCK_GROWTH_FACTOR));
+
+        /* enlargement within the reserved memory must not change the capacity */
+        offset_t cap = MEMBLOCK_CAPACITY(block);
+        MEMBLOCK_RESIZE(block, 20);
+        MEMBLOCK_SIZE(&size, block);
+        ASSERT_EQ(size, 20u);
+        ASSERT_EQ(MEMBLOCK_CAPACITY(block), cap);
+
+        MEMBLOCK_DROP(block);
+}
+
+TEST(TestMemblock, ExactGrowth) {
+        memblock *block;
+        MEMBLOCK_CREATE(&block, 16);
+        MEMBLOCK_SET_GROWTH(block, MEMBLOCK_GROWTH_EXACT);
+
+        MEMBLOCK_RESIZE(block, 17);
+        ASSERT_EQ(MEMBLOCK_CAPACITY(block), 17u);
+
+        MEMBLOCK_DROP(block);
+}
+
+TEST(TestMemblock, ReserveDoesNotChangeSize) {
+        memblock *block;
+        MEMBLOCK_CREATE(&block, 16);
+
+        ASSERT_TRUE(MEMBLOCK_RESERVE(block, 4096));
+        ASSERT_EQ(MEMBLOCK_CAPACITY(block), 4096u);
+
+        offset_t size;
+        MEMBLOCK_SIZE(&size, block);
+        ASSERT_EQ(size, 16u);
+
+        MEMBLOCK_DROP(block);
+}
+
+TEST(TestMemblock, ShrinkedRegionIsZeroedOnRegrow) {
+        memblock *block;
+        MEMBLOCK_CREATE(&block, 16);
+        memset(block->base, 'x', 16);
+
+        MEMBLOCK_RESIZE(block, 8);
+        MEMBLOCK_RESIZE(block, 16);
+
+        const char *data = (const char *) MEMBLOCK_RAW_DATA(block);
+        for (int i = 8; i < 16; i++) {
+                ASSERT_EQ(data[i], 0);
+        }
+
+        MEMBLOCK_DROP(block);
+}
+
+TEST(TestMemblock, InsertHeavyRecordConstruction) {
+        rec_new context;
+        rec doc;
+        obj_state state;
+        str_buf sb;
+        char key[32];
+
+        insert *ins = rec_create_begin(&context, &doc, KEY_NOKEY, KEEP);
+        insert *obj = insert_object_begin(&state, ins, 1);
+        for (u32 i = 0; i < 10000; i++) {
+                sprintf(key, "k%u", i);
+                insert_prop_u32(obj, key, i);
+        }
+        insert_object_end(&state);
+        rec_create_end(&context);
+
+        find find;
+        field_e type;
+        u64 value;
+        find_from_string(&find, "0.\"k9999\"", &doc);
+        ASSERT_TRUE(find_has_result(&find));
+        find_result_type(&type, &find);
+        ASSERT_EQ(type, FIELD_NUMBER_U32);
+        find_result_unsigned(&value, &find);
+        ASSERT_EQ(value, 9999u);
+
+        str_buf_create(&sb);
+        rec_to_json(&sb, &doc);
+        ASSERT_TRUE(strstr(str_buf_cstr(&sb), "\"k9999\":9999") != NULL);
+        str_buf_drop(&sb);
+
+        rec_drop(&doc);
+}
+
+TEST(TestMemblock, MappedRecordFile) {
+        rec doc, mapped, revised;
+        rev revise;
+        u64 len, mapped_len, hash, mapped_hash;
+        str_buf sb1, sb2;
+        char path[] = "/tmp/test-memblock-XXXXXX";
+
+        rec_from_json(&doc, "{\"a\": 1, \"b\": [true, \"x\"]}", KEY_AUTOKEY, NULL);
+        const void *raw = rec_raw_data(&len, &doc);
+
+        int fd = mkstemp(path);
+        ASSERT_NE(fd, -1);
+        ASSERT_EQ(write(fd, raw, len), (ssize_t) len);
+        close(fd);
+
+        ASSERT_TRUE(rec_from_file(&mapped, path));
+        ASSERT_TRUE(MEMBLOCK_IS_MAPPED(mapped.block));
+
+        const void *mapped_raw = rec_raw_data(&mapped_len, &mapped);
+        ASSERT_EQ(mapped_len, len);
+        ASSERT_EQ(memcmp(raw, mapped_raw, len), 0);
+
+        rec_commit_hash(&hash, &doc);
+        rec_commit_hash(&mapped_hash, &mapped);
+        ASSERT_EQ(hash, mapped_hash);
+
+        str_buf_create(&sb1);
+        str_buf_create(&sb2);
+        ASSERT_STREQ(rec_to_json(&sb1, &doc), rec_to_json(&sb2, &mapped));
+
+        /* revisions of a mapped record are heap copies */
+        revise_begin(&revise, &revised, &mapped);
+        ASSERT_FALSE(MEMBLOCK_IS_MAPPED(revised.block));
+        revise_remove("0.b.1", &revise);
+        revise_end(&revise);
+        ASSERT_STREQ(rec_to_json(&sb1, &revised), "{\"a\":1, \"b\":[true]}");
+
+        str_buf_drop(&sb1);
+        str_buf_drop(&sb2);
+        rec_drop(&revised);
+        rec_drop(&mapped);
+        rec_drop(&doc);
+        unlink(path);
+}
+
+TEST(TestMemblock, FromRawData) {
+        rec doc, copy;
+        u64 len;
+        str_buf sb1, sb2;
+
+        rec_from_json(&doc, "[1, 2, {\"x\": \"y\"}]", KEY_NOKEY, NULL);
+        const void *raw = rec_raw_data(&len, &doc);
+        rec_from_raw_data(&copy, raw, len);
+
+        str_buf_create(&sb1);
+        str_buf_create(&sb2);
+        ASSERT_STREQ(rec_to_json(&sb1, &doc), rec_to_json(&sb2, &copy));
+        str_buf_drop(&sb1);
+        str_buf_drop(&sb2);
+
+        rec_drop(&copy);
+        rec_drop(&doc);
+}
+
+static void revise_front(rec *revised, rec *doc, bool gap_mode)
+{
+        rev revise;
+        arr_it it;
+        insert in;
+
+        revise_begin(&revise, revised, doc);
+        ASSERT_TRUE(revise_set_gap_mode(&revise, gap_mode));
+
+        /* remove the first 100 elements, and insert 1000 elements at the front afterwards */
+        revise_iterator_open(&it, &revise);
+        for (u32 i = 0; i < 100; i++) {
+                arr_it_next(&it);
+                internal_arr_it_remove(&it);
+        }
+
+        revise_iterator_open(&it, &revise);
+        arr_it_insert_begin(&in, &it);
+        for (u32 i = 0; i < 1000; i++) {
+                insert_u32(&in, i);
+        }
+        arr_it_insert_end(&in);
+
+        revise_end(&revise);
+        ASSERT_FALSE(MEMBLOCK_HAS_GAP(revised->block));
+}
+
+TEST(TestMemblock, GapModeRevision) {
+        rec_new context;
+        rec doc, plain, gap;
+        u64 plain_len, gap_len;
+        str_buf sb1, sb2;
+
+        insert *ins = rec_create_begin(&context, &doc, KEY_AUTOKEY, KEEP);
+        for (u32 i = 0; i < 5000; i++) {
+                insert_u64(ins, i);
+        }
+        rec_create_end(&context);
+
+        revise_front(&plain, &doc, false);
+        revise_front(&gap, &doc, true);
+
+        /* revisions in gap mode materialize into exactly the same record */
+        const void *plain_raw = rec_raw_data(&plain_len, &plain);
+        const void *gap_raw = rec_raw_data(&gap_len, &gap);
+        ASSERT_EQ(plain_len, gap_len);
+        ASSERT_EQ(memcmp(plain_raw, gap_raw, plain_len), 0);
+
+        str_buf_create(&sb1);
+        str_buf_create(&sb2);
+        ASSERT_STREQ(rec_to_json(&sb1, &plain), rec_to_json(&sb2, &gap));
+        str_buf_drop(&sb1);
+        str_buf_drop(&sb2);
+
+        rec_drop(&plain);
+        rec_drop(&gap);
+        rec_drop(&doc);
+}
+
+static u64 value_at(rec *doc, const char *path)
+{
+        find find;
+        u64 value = 0;
+        find_from_string(&find, path, doc);
+        EXPECT_TRUE(find_has_result(&find));
+        find_result_unsigned(&value, &find);
+        return value;
+}
+
+TEST(TestMemblock, SharedRevisionChain) {
+        rec_new context;
+        rec doc, gen1, gen2, aborted;
+        rev revise;
+        str_buf sb1, sb2;
+
+        insert *ins = rec_create_begin(&context, &doc, KEY_NOKEY, KEEP);
+        for (u32 i = 0; i < 20000; i++) {
+                insert_u64(ins, i);
+        }
+        rec_create_end(&context);
+
+        str_buf_create(&sb1);
+        str_buf_create(&sb2);
+        std::string json = rec_to_json(&sb1, &doc);
+
+        /* the first revision is a plain copy, which a revision of it shares */
+        revise_begin(&revise, &gen1, &doc);
+        ASSERT_FALSE(MEMBLOCK_IS_SHARED(gen1.block));
+        update_set_u64(&revise, "100", 42);
+        revise_end(&revise);
+
+        revise_begin(&revise, &gen2, &gen1);
+        ASSERT_TRUE(MEMBLOCK_IS_SHARED(gen2.block));
+        update_set_u64(&revise, "19000", 23);
+        revise_remove("5", &revise);
+        revise_end(&revise);
+
+        revise_begin(&revise, &aborted, &gen2);
+        ASSERT_TRUE(MEMBLOCK_IS_SHARED(aborted.block));
+        ASSERT_EQ(aborted.block->cow, gen2.block->cow);
+        update_set_u64(&revise, "0", 1);
+        revise_abort(&revise);
+
+        ASSERT_EQ(value_at(&gen1, "100"), 42u);
+        ASSERT_EQ(value_at(&gen1, "19000"), 19000u);
+        ASSERT_EQ(value_at(&gen2, "99"), 42u);
+        ASSERT_EQ(value_at(&gen2, "18999"), 23u);
+        ASSERT_EQ(value_at(&gen2, "0"), 0u);
+        ASSERT_EQ(value_at(&gen2, "5"), 6u);
+
+        /* revisions never change the record they are derived from */
+        ASSERT_EQ(json, rec_to_json(&sb2, &doc));
+
+        str_buf_drop(&sb1);
+        str_buf_drop(&sb2);
+        rec_drop(&gen2);
+        rec_drop(&gen1);
+        rec_drop(&doc);
+}
+
+static u32 num_open_fds()
+{
+        u32 num = 0;
+        DIR *dir = opendir("/proc/self/fd");
+        if (dir) {
+                while (readdir(dir)) {
+                        num++;
+                }
+                closedir(dir);
+        }
+        return num;
+}
+
+TEST(TestMemblock, SharedCopyKeepsSource) {
+        memblock *block, *copy, *copy_of_copy, *third_copy;
+        memfile file;
+        MEMBLOCK_CREATE(&block, MEMBLOCK_COW_MIN_SIZE);
+        MEMFILE_OPEN(&file, block, READ_WRITE);
+        for (u32 i = 0; i < MEMBLOCK_COW_MIN_SIZE / sizeof(u32); i++) {
+                MEMFILE_WRITE(&file, &i, sizeof(u32));
+        }
+        const void *base = block->base;
+
+        /* the first copy is a plain heap copy */
+        MEMBLOCK_CPY_SHARED(&copy, block);
+        ASSERT_EQ(block->base, base);
+        ASSERT_FALSE(MEMBLOCK_IS_SHARED(block));
+        ASSERT_FALSE(MEMBLOCK_IS_SHARED(copy));
+        ASSERT_EQ(memcmp(copy->base, base, MEMBLOCK_COW_MIN_SIZE), 0);
+
+        /* a copy of the copy owns the shared memory object, and its source stays a plain heap block */
+        const void *copy_base = copy->base;
+        MEMBLOCK_CPY_SHARED(&copy_of_copy, copy);
+        ASSERT_EQ(copy->base, copy_base);
+        ASSERT_FALSE(MEMBLOCK_IS_SHARED(copy));
+        ASSERT_TRUE(MEMBLOCK_IS_SHARED(copy_of_copy));
+        ASSERT_EQ(memcmp(copy_of_copy->base, base, MEMBLOCK_COW_MIN_SIZE), 0);
+
+        MEMBLOCK_CPY_SHARED(&third_copy, copy_of_copy);
+        ASSERT_TRUE(MEMBLOCK_IS_SHARED(third_copy));
+        ASSERT_EQ(third_copy->cow, copy_of_copy->cow);
+        u32 value = 42;
+        MEMFILE_OPEN(&file, third_copy, READ_WRITE);
+        MEMFILE_WRITE(&file, &value, sizeof(u32));
+        ASSERT_EQ(*(u32 *) third_copy->base, 42u);
+        ASSERT_EQ(*(u32 *) copy_of_copy->base, 0u);
+        ASSERT_EQ(*(u32 *) copy->base, 0u);
+        ASSERT_EQ(*(u32 *) block->base, 0u);
+
+        MEMBLOCK_DROP(third_copy);
+        MEMBLOCK_DROP(copy_of_copy);
+        MEMBLOCK_DROP(copy);
+        MEMBLOCK_DROP(block);
+}
+
+TEST(TestMemblock, SharedCopiesReleaseDescriptors) {
+#ifdef __linux__
+        const u32 num_blocks = 2 * MEMBLOCK_COW_MAX_OBJECTS;
+        memblock *blocks[num_blocks], *copies[num_blocks], *shared[num_blocks];
+        u32 fds = num_open_fds();
+
+        /* first copies hold no descriptor, and the number of shared memory objects is bounded */
+        for (u32 i = 0; i < num_blocks; i++) {
+                MEMBLOCK_CREATE(&blocks[i], MEMBLOCK_COW_MIN_SIZE);
+                MEMBLOCK_CPY_SHARED(&copies[i], blocks[i]);
+                MEMBLOCK_CPY_SHARED(&shared[i], copies[i]);
+        }
+        ASSERT_EQ(num_open_fds(), fds + MEMBLOCK_COW_MAX_OBJECTS);
+        ASSERT_TRUE(MEMBLOCK_IS_SHARED(shared[0]));
+        ASSERT_FALSE(MEMBLOCK_IS_SHARED(shared[num_blocks - 1]));
+        for (u32 i = 0; i < num_blocks; i++) {
+                MEMBLOCK_DROP(shared[i]);
+        }
+        ASSERT_EQ(num_open_fds(), fds);
+
+        /* a copy of a copy that outlives its source keeps the descriptor of the shared memory object until dropped */
+        for (u32 i = 0; i < MEMBLOCK_COW_MAX_OBJECTS; i++) {
+                memblock *owner;
+                MEMBLOCK_CPY_SHARED(&owner, copies[i]);
+                MEMBLOCK_CPY_SHARED(&shared[i], owner);
+                MEMBLOCK_DROP(owner);
+        }
+        ASSERT_EQ(num_open_fds(), fds + MEMBLOCK_COW_MAX_OBJECTS);
+
+        for (u32 i = 0; i < num_blocks; i++) {
+                if (i < MEMBLOCK_COW_MAX_OBJECTS) {
+                        MEMBLOCK_DROP(shared[i]);
+                }
+                MEMBLOCK_DROP(copies[i]);
+                MEMBLOCK_DROP(blocks[i]);
+        }
+        ASSERT_EQ(num_open_fds(), fds);
+#endif
+}
+
+TEST(TestMemblock, SharedRevisionChainKeepsSharing) {
+        rec_new context;
+        rec doc, prev, next;
+        rev revise;
+        char path[16];
+
+        insert *ins = rec_create_begin(&context, &doc, KEY_NOKEY, KEEP);
+        for (u32 i = 0; i < 20000; i++) {
+                insert_u64(ins, i);
+        }
+        rec_create_end(&context);
+
+        /* each revision is made from the previous one, which is dropped afterwards; the first one is a plain copy */
+        revise_begin(&revise, &prev, &doc);
+        revise_end(&revise);
+        revise_begin(&revise, &next, &prev);
+        revise_end(&revise);
+        rec_drop(&prev);
+        prev = next;
+        const struct memblock_cow *cow = prev.block->cow;
+        ASSERT_TRUE(cow != NULL);
+        for (u32 i = 1; i <= 10; i++) {
+                revise_begin(&revise, &next, &prev);
+                ASSERT_TRUE(MEMBLOCK_IS_SHARED(next.block));
+                ASSERT_EQ(next.block->cow, cow) << "revision " << i << " does not share the object of its predecessor";
+                snprintf(path, sizeof(path), "%u", i * 1000);
+                update_set_u64(&revise, path, 42);
+                revise_end(&revise);
+                rec_drop(&prev);
+                prev = next;
+        }
+
+        for (u32 i = 1; i <= 10; i++) {
+                snprintf(path, sizeof(path), "%u", i * 1000);
+                ASSERT_EQ(value_at(&prev, path), 42u);
+                ASSERT_EQ(value_at(&doc, path), i * 1000u);
+        }
+        ASSERT_EQ(value_at(&prev, "1001"), 1001u);
+
+        rec_drop(&prev);
+        rec_drop(&doc);
+}
+
+TEST(TestMemblock, BitStreamMatchesBitMode) {
+        memblock *old_block, *new_block;
+        memfile old_file, new_file;
+        MEMBLOCK_CREATE(&old_block, 16);
+        MEMBLOCK_CREATE(&new_block, 16);
+        MEMFILE_OPEN(&old_file, old_block, READ_WRITE);
+        MEMFILE_OPEN(&new_file, new_block, READ_WRITE);
+
+        u64 values[500];
+        u32 widths[500];
+        u64 state = 42;
+        for (int i = 0; i < 500; i++) {
+                state = state * 6364136223846793005ull + 1442695040888963407ull;
+                values[i] = state;
+                widths[i] = (u32) (state >> 58) + 1;
+        }
+
+        MEMFILE_BEGIN_BIT_MODE(&old_file);
+        memfile_bits stream;
+        memfile_bits_begin_write(&stream, &new_file);
+        for (int i = 0; i < 500; i++) {
+                for (u32 bit = 0; bit < widths[i]; bit++) {
+                        memfile_write_bit(&old_file, (values[i] >> bit) & 1);
+                }
+                memfile_bits_write(&stream, values[i], widths[i]);
+        }
+        size_t old_nbytes, new_nbytes;
+        MEMFILE_END_BIT_MODE(&old_nbytes, &old_file);
+        memfile_bits_end_write(&new_nbytes, &stream);
+
+        ASSERT_EQ(old_nbytes, new_nbytes);
+        ASSERT_EQ(MEMFILE_TELL(&old_file), MEMFILE_TELL(&new_file));
+        ASSERT_EQ(memcmp(MEMBLOCK_RAW_DATA(old_block), MEMBLOCK_RAW_DATA(new_block), new_nbytes), 0);
+
+        MEMFILE_SEEK(&new_file, 0);
+        memfile_bits_begin_read(&stream, &new_file);
+        for (int i = 0; i < 500; i++) {
+                u64 mask = widths[i] < 64 ? ((u64) 1 << widths[i]) - 1 : ~(u64) 0;
+                ASSERT_EQ(memfile_bits_read(&stream, widths[i]), values[i] & mask);
+        }
+        size_t nbytes_read;
+        memfile_bits_end_read(&nbytes_read, &stream);
+        ASSERT_EQ(nbytes_read, new_nbytes);
+        ASSERT_EQ(MEMFILE_TELL(&new_file), new_nbytes);
+
+        MEMBLOCK_DROP(old_block);
+        MEMBLOCK_DROP(new_block);
+}
+
+TEST(TestMemblock, DigestRehashesModifiedChunks) {
+        ASSERT_EQ(HASH64_XX(0, ""), 0xEF46DB3751D8E999ULL);
+        ASSERT_EQ(HASH64_XX(3, "abc"), 0x44BC2CF5AD770999ULL);
+
+        memblock *block, *copy;
+        memfile file;
+        u64 digest;
+        MEMBLOCK_CREATE(&block, 100 * 1024);
+        MEMFILE_OPEN(&file, block, READ_WRITE);
+        for (u32 i = 0; i < 20000; i++) {
+                MEMFILE_WRITE(&file, &i, sizeof(u32));
+        }
+
+        memblock_digest_compute(&digest, block);
+        ASSERT_EQ(digest, hash64_chunked(block->base, block->blockLength));
+
+        u32 value = 42;
+        MEMFILE_SEEK(&file, 50000);
+        MEMFILE_WRITE(&file, &value, sizeof(u32));
+        MEMBLOCK_CPY(&copy, block);
+        memblock_digest_compute(&digest, block);
+        ASSERT_EQ(digest, hash64_chunked(block->base, block->blockLength));
+
+        /* the copy takes over the cached chunk hashes */
+        MEMFILE_OPEN(&file, copy, READ_WRITE);
+        MEMFILE_SEEK(&file, 90000);
+        MEMFILE_WRITE(&file, &value, sizeof(u32));
+        MEMBLOCK_RESIZE(copy, 120 * 1024);
+        memblock_digest_compute(&digest, copy);
+        ASSERT_EQ(digest, hash64_chunked(copy->base, copy->blockLength));
+
+        MEMBLOCK_DROP(copy);
+        MEMBLOCK_DROP(block);
+}
+
+int main(int argc, char **argv) {
+        ::testing::InitGoogleTest(&argc, argv);
+        return RUN_ALL_TESTS();
+}
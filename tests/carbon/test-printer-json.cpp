@@ -25,6 +25,34 @@ rec_from_json(&doc, "[2, 1]", KEY_NOKEY, NULL);
         rec_drop(&doc);
 }
 
+TEST(TestConverterFormatter, TestWriteRecordToFile) {
+
+        rec doc;
+        str_buf buf;
+        const char *json_in = "{\"a\": [1, 2, null, 300], \"b\": [-1, 2], \"c\": [1.5, -0.004, null], "
+                              "\"d\": [true, null, false], \"e\": {\"f\": \"text\", \"g\": -9223372036854775807}, "
+                              "\"h\": [1, \"x\", [], {}], \"i\": 18446744073709551614, \"j\": 2.125}";
+
+        rec_from_json(&doc, json_in, KEY_NOKEY, NULL);
+        str_buf_create(&buf);
+        json_from_record(&buf, &doc);
+        ASSERT_STREQ(str_buf_cstr(&buf), "{\"a\":[1, 2, null, 300], \"b\":[-1, 2], \"c\":[1.50, -0.00, null], "
+                                         "\"d\":[true, null, false], \"e\":{\"f\":\"text\", "
+                                         "\"g\":-9223372036854775807}, \"h\":[1, \"x\", [], {}], "
+                                         "\"i\":18446744073709551614, \"j\":2.12}");
+
+        FILE *file = tmpfile();
+        ASSERT_TRUE(json_write_record(fileno(file), &doc));
+        char written[1024] = { 0 };
+        rewind(file);
+        ASSERT_EQ(fread(written, 1, sizeof(written) - 1, file), strlen(str_buf_cstr(&buf)));
+        ASSERT_STREQ(written, str_buf_cstr(&buf));
+        fclose(file);
+
+        str_buf_drop(&buf);
+        rec_drop(&doc);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();